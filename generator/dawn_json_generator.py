@@ -60,11 +60,15 @@ class Type:
         self.dict_name = name
         self.name = Name(name, native=native)
         self.category = json_data['category']
+        # Whether the type has the same layout on the wire as in C, such that arrays of it can be
+        # used in place in the wire command buffers.
+        self.is_wire_transparent = False
 
 EnumValue = namedtuple('EnumValue', ['name', 'value', 'valid'])
 class EnumType(Type):
     def __init__(self, name, json_data):
         Type.__init__(self, name, json_data)
+        self.is_wire_transparent = True
         self.values = [EnumValue(Name(m['name']), m['value'], m.get('valid', True)) for m in self.json_data['values']]
 
         # Assert that all values are unique in enums
@@ -78,6 +82,7 @@ BitmaskValue = namedtuple('BitmaskValue', ['name', 'value'])
 class BitmaskType(Type):
     def __init__(self, name, json_data):
         Type.__init__(self, name, json_data)
+        self.is_wire_transparent = True
         self.values = [BitmaskValue(Name(m['name']), m['value']) for m in self.json_data['values']]
         self.full_mask = 0
         for value in self.values:
@@ -86,6 +91,7 @@ class BitmaskType(Type):
 class NativeType(Type):
     def __init__(self, name, json_data):
         Type.__init__(self, name, json_data, native=True)
+        self.is_wire_transparent = name != 'void'
 
 class NativelyDefined(Type):
     def __init__(self, name, json_data):
@@ -142,6 +148,14 @@ class StructureType(Record, Type):
         Type.__init__(self, name, json_data)
         self.extensible = json_data.get("extensible", False)
 
+    def update_metadata(self):
+        Record.update_metadata(self)
+        # Structures without pointers nor objects are transferred member by member in the same
+        # order, so their transfer structure has the same layout as the C structure.
+        self.is_wire_transparent = not self.extensible and all(
+            member.annotation == 'value' and member.type.is_wire_transparent
+            for member in self.members)
+
 class Command(Record):
     def __init__(self, name, members=None):
         Record.__init__(self, name)
@@ -430,6 +444,12 @@ def as_frontendType(typ):
     else:
         return as_cType(typ.name)
 
+# The frontend type qualified so that it can be used outside of the dawn_native namespace.
+def as_nativeType(typ):
+    if typ.category in ['object', 'structure']:
+        return 'dawn_native::' + as_frontendType(typ)
+    return as_frontendType(typ)
+
 def as_wireType(typ):
     if typ.category == 'object':
         return typ.name.CamelCase() + '*'
@@ -452,7 +472,7 @@ class MultiGeneratorFromDawnJSON(Generator):
         return 'Generates code for various target from Dawn.json.'
 
     def add_commandline_arguments(self, parser):
-        allowed_targets = ['dawn_headers', 'libdawn', 'mock_dawn', 'dawn_wire', "dawn_native_utils"]
+        allowed_targets = ['dawn_headers', 'libdawn', 'mock_dawn', 'dawn_wire', "dawn_native_utils", 'dawn_native_cpp']
 
         parser.add_argument('--dawn-json', required=True, type=str, help ='The DAWN JSON definition to use.')
         parser.add_argument('--wire-json', default=None, type=str, help='The DAWN WIRE JSON definition to use.')
@@ -499,7 +519,14 @@ class MultiGeneratorFromDawnJSON(Generator):
         if 'libdawn' in targets:
             additional_params = {'native_methods': lambda typ: cpp_native_methods(api_params['types'], typ)}
             renders.append(FileRender('api.c', 'dawn/dawn.c', [base_params, api_params, c_params]))
-            renders.append(FileRender('apicpp.cpp', 'dawn/dawncpp.cpp', [base_params, api_params, cpp_params]))
+            renders.append(FileRender('apicpp.cpp', 'dawn/dawncpp.cpp', [base_params, api_params, cpp_params, {'direct_dispatch': False}]))
+
+        if 'dawn_native_cpp' in targets:
+            direct_dispatch_params = {
+                'direct_dispatch': True,
+                'as_nativeType': as_nativeType,
+            }
+            renders.append(FileRender('apicpp.cpp', 'dawn_native/dawncpp_native.cpp', [base_params, api_params, cpp_params, direct_dispatch_params]))
 
         if 'mock_dawn' in targets:
             renders.append(FileRender('mock_api.h', 'mock/mock_dawn.h', [base_params, api_params, c_params]))
@@ -14,6 +14,19 @@
 
 #include "dawn/dawncpp.h"
 
+{% if direct_dispatch %}
+    //* In direct dispatch mode the methods call the dawn_native frontend directly instead of going
+    //* through the C API and the proc table. It is only usable when dawn_native is in the same
+    //* binary as the application.
+    #include "dawn_native/dawn_platform.h"
+
+    {% for type in by_category["object"] %}
+        {% if type.name.canonical_case() not in ["texture view"] %}
+            #include "dawn_native/{{type.name.CamelCase()}}.h"
+        {% endif %}
+    {% endfor %}
+
+{% endif %}
 namespace dawn {
 
     {% for type in by_category["enum"] + by_category["bitmask"] %}
@@ -90,9 +103,36 @@ namespace dawn {
             )
         {%- endmacro %}
 
+        {% macro render_cpp_to_frontend_method_call(type, method) -%}
+            reinterpret_cast<{{as_nativeType(type)}}>(Get())->{{method.name.CamelCase()}}(
+                {%- for arg in method.arguments -%}
+                    {%- if not loop.first %}, {% endif -%}
+                    {%- if arg.annotation == "value" -%}
+                        {%- if arg.type.category == "object" -%}
+                            reinterpret_cast<{{as_nativeType(arg.type)}}>({{as_varName(arg.name)}}.Get())
+                        {%- else -%}
+                            {{as_varName(arg.name)}}
+                        {%- endif -%}
+                    {%- else -%}
+                        reinterpret_cast<{{decorate("", as_nativeType(arg.type), arg)}}>({{as_varName(arg.name)}})
+                    {%- endif -%}
+                {%- endfor -%}
+            )
+        {%- endmacro %}
+
         {% for method in native_methods(type) %}
             {{render_cpp_method_declaration(type, method)}} {
-                {% if method.return_type.name.concatcase() == "void" %}
+                {% if direct_dispatch %}
+                    {% if method.return_type.name.concatcase() == "void" %}
+                        {{render_cpp_to_frontend_method_call(type, method)}};
+                    {% elif method.return_type.category == "object" %}
+                        auto result = {{render_cpp_to_frontend_method_call(type, method)}};
+                        return {{as_cppType(method.return_type.name)}}::Acquire(reinterpret_cast<{{as_cType(method.return_type.name)}}>(result));
+                    {% else %}
+                        auto result = {{render_cpp_to_frontend_method_call(type, method)}};
+                        return {{convert_cType_to_cppType(method.return_type, 'value', 'result') | indent(8)}};
+                    {% endif %}
+                {% elif method.return_type.name.concatcase() == "void" %}
                     {{render_cpp_to_c_method_call(type, method)}};
                 {% else %}
                     auto result = {{render_cpp_to_c_method_call(type, method)}};
@@ -102,12 +142,20 @@ namespace dawn {
         {% endfor %}
         void {{CppType}}::DawnReference({{CType}} handle) {
             if (handle != nullptr) {
-                {{as_cMethod(type.name, Name("reference"))}}(handle);
+                {% if direct_dispatch %}
+                    reinterpret_cast<{{as_nativeType(type)}}>(handle)->Reference();
+                {% else %}
+                    {{as_cMethod(type.name, Name("reference"))}}(handle);
+                {% endif %}
             }
         }
         void {{CppType}}::DawnRelease({{CType}} handle) {
             if (handle != nullptr) {
-                {{as_cMethod(type.name, Name("release"))}}(handle);
+                {% if direct_dispatch %}
+                    reinterpret_cast<{{as_nativeType(type)}}>(handle)->Release();
+                {% else %}
+                    {{as_cMethod(type.name, Name("release"))}}(handle);
+                {% endif %}
             }
         }
 
@@ -15,6 +15,7 @@
 #include "dawn_wire/WireCmd_autogen.h"
 
 #include "common/Assert.h"
+#include "common/Math.h"
 
 #include <cstring>
 #include <limits>
@@ -111,6 +112,19 @@
         {% endfor %}
     };
 
+    {% if not is_cmd and record.is_wire_transparent %}
+        //* Arrays of this structure are used in place, which relies on the layouts being the same.
+        static_assert(sizeof({{name}}Transfer) == sizeof({{name}}),
+                      "sizeof mismatch for {{name}}Transfer");
+        static_assert(alignof({{name}}Transfer) == alignof({{name}}),
+                      "alignof mismatch for {{name}}Transfer");
+        {% for member in members %}
+            {% set memberName = as_varName(member.name) %}
+            static_assert(offsetof({{name}}Transfer, {{memberName}}) == offsetof({{name}}, {{memberName}}),
+                          "offsetof mismatch for {{name}}Transfer::{{memberName}}");
+        {% endfor %}
+    {% endif %}
+
     //* Returns the required transfer size for `record` in addition to the transfer structure.
     DAWN_DECLARE_UNUSED size_t {{Return}}{{name}}GetExtraRequiredSize(const {{Return}}{{name}}{{Cmd}}& record) {
         DAWN_UNUSED(record);
@@ -118,8 +132,9 @@
         size_t result = 0;
 
         //* Special handling of const char* that have their length embedded directly in the command
+        //* The null terminator is serialized too so that the string can be used in place.
         {% for member in members if member.length == "strlen" %}
-            result += std::strlen(record.{{as_varName(member.name)}});
+            result += std::strlen(record.{{as_varName(member.name)}}) + 1;
         {% endfor %}
 
         //* Gather how much space will be needed for pointer members.
@@ -180,8 +195,8 @@
             {% set memberName = as_varName(member.name) %}
             transfer->{{memberName}}Strlen = std::strlen(record.{{memberName}});
 
-            memcpy(*buffer, record.{{memberName}}, transfer->{{memberName}}Strlen);
-            *buffer += transfer->{{memberName}}Strlen;
+            memcpy(*buffer, record.{{memberName}}, transfer->{{memberName}}Strlen + 1);
+            *buffer += transfer->{{memberName}}Strlen + 1;
         {% endfor %}
 
         //* Allocate space and write the non-value arguments in it.
@@ -195,12 +210,20 @@
             {% endif %}
             {
                 size_t memberLength = {{member_length(member, "record.")}};
-                auto memberBuffer = reinterpret_cast<{{member_transfer_type(member)}}*>(*buffer);
-                *buffer += memberLength * {{member_transfer_sizeof(member)}};
+                {% if member.annotation == "const*" and member.type.is_wire_transparent %}
+                    //* The wire layout is the C layout so the whole array is copied at once.
+                    if (memberLength > 0) {
+                        memcpy(*buffer, record.{{memberName}}, memberLength * {{member_transfer_sizeof(member)}});
+                        *buffer += memberLength * {{member_transfer_sizeof(member)}};
+                    }
+                {% else %}
+                    auto memberBuffer = reinterpret_cast<{{member_transfer_type(member)}}*>(*buffer);
+                    *buffer += memberLength * {{member_transfer_sizeof(member)}};
 
-                for (size_t i = 0; i < memberLength; ++i) {
-                    {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
-                }
+                    for (size_t i = 0; i < memberLength; ++i) {
+                        {{serialize_member(member, "record." + memberName + "[i]", "memberBuffer[i]" )}}
+                    }
+                {% endif %}
             }
         {% endfor %}
     }
@@ -242,14 +265,17 @@
             {% set memberName = as_varName(member.name) %}
             {
                 size_t stringLength = transfer->{{memberName}}Strlen;
-                const char* stringInBuffer = nullptr;
-                DESERIALIZE_TRY(GetPtrFromBuffer(buffer, size, stringLength, &stringInBuffer));
+                if (stringLength == std::numeric_limits<size_t>::max()) {
+                    return DeserializeResult::FatalError;
+                }
 
-                char* copiedString = nullptr;
-                DESERIALIZE_TRY(GetSpace(allocator, stringLength + 1, &copiedString));
-                memcpy(copiedString, stringInBuffer, stringLength);
-                copiedString[stringLength] = '\0';
-                record->{{memberName}} = copiedString;
+                //* The string is used in place so it must be null-terminated where the command says.
+                const char* stringInBuffer = nullptr;
+                DESERIALIZE_TRY(GetPtrFromBuffer(buffer, size, stringLength + 1, &stringInBuffer));
+                if (stringInBuffer[stringLength] != '\0') {
+                    return DeserializeResult::FatalError;
+                }
+                record->{{memberName}} = stringInBuffer;
             }
         {% endfor %}
 
@@ -262,6 +288,24 @@
                 record->{{memberName}} = nullptr;
                 if (has_{{memberName}})
             {% endif %}
+            {% if member.annotation == "const*" and member.type.is_wire_transparent %}
+            //* The C type is used on the wire so the record can point directly in the command buffer,
+            //* but only if the data happens to be aligned enough for the C type.
+            {
+                size_t memberLength = {{member_length(member, "record->")}};
+                const {{as_cType(member.type.name)}}* memberBuffer = nullptr;
+                DESERIALIZE_TRY(GetPtrFromBuffer(buffer, size, memberLength, &memberBuffer));
+
+                if (IsPtrAligned(memberBuffer, alignof({{as_cType(member.type.name)}}))) {
+                    record->{{memberName}} = memberBuffer;
+                } else {
+                    {{as_cType(member.type.name)}}* copiedMembers = nullptr;
+                    DESERIALIZE_TRY(GetSpace(allocator, memberLength, &copiedMembers));
+                    memcpy(copiedMembers, memberBuffer, memberLength * sizeof(*memberBuffer));
+                    record->{{memberName}} = copiedMembers;
+                }
+            }
+            {% else %}
             {
                 size_t memberLength = {{member_length(member, "record->")}};
                 auto memberBuffer = reinterpret_cast<const {{member_transfer_type(member)}}*>(buffer);
@@ -284,6 +328,7 @@
                     {{deserialize_member(member, "memberBuffer[i]", "copiedMembers[i]")}}
                 }
             }
+            {% endif %}
         {% endfor %}
 
         return DeserializeResult::Success;
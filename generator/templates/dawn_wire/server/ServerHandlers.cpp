@@ -15,6 +15,8 @@
 #include "common/Assert.h"
 #include "dawn_wire/server/Server.h"
 
+#include <limits>
+
 namespace dawn_wire { namespace server {
     {% for command in cmd_records["command"] %}
         {% set type = command.derived_object %}
@@ -49,11 +51,10 @@ namespace dawn_wire { namespace server {
                     {% set Type = member.handle_type.name.CamelCase() %}
                     {% set name = as_varName(member.name) %}
 
-                    auto* {{name}}Data = {{Type}}Objects().Allocate(cmd.{{name}}.id);
+                    auto* {{name}}Data = {{Type}}Objects().Allocate(cmd.{{name}}.id, cmd.{{name}}.serial);
                     if ({{name}}Data == nullptr) {
                         return false;
                     }
-                    {{name}}Data->serial = cmd.{{name}}.serial;
                 {% endfor %}
 
                 //* Do command
@@ -94,14 +95,28 @@ namespace dawn_wire { namespace server {
     const char* Server::HandleCommands(const char* commands, size_t size) {
         mProcs.deviceTick(DeviceObjects().Get(1)->handle);
 
-        while (size >= sizeof(WireCmd)) {
-            WireCmd cmdId = *reinterpret_cast<const WireCmd*>(commands);
+        if (!HandleCommandsWithBudget(&commands, &size, std::numeric_limits<size_t>::max())) {
+            return nullptr;
+        }
+        ASSERT(size == 0);
+
+        return commands;
+    }
+
+    bool Server::HandleCommandsWithBudget(const char** commands,
+                                          size_t* size,
+                                          size_t maxCommands) {
+        for (size_t handled = 0; *size != 0 && handled < maxCommands; ++handled) {
+            if (*size < sizeof(WireCmd)) {
+                return false;
+            }
+            WireCmd cmdId = *reinterpret_cast<const WireCmd*>(*commands);
 
             bool success = false;
             switch (cmdId) {
                 {% for command in cmd_records["command"] %}
                     case WireCmd::{{command.name.CamelCase()}}:
-                        success = Handle{{command.name.CamelCase()}}(&commands, &size);
+                        success = Handle{{command.name.CamelCase()}}(commands, size);
                         break;
                 {% endfor %}
                 default:
@@ -109,16 +124,12 @@ namespace dawn_wire { namespace server {
             }
 
             if (!success) {
-                return nullptr;
+                return false;
             }
             mAllocator.Reset();
         }
 
-        if (size != 0) {
-            return nullptr;
-        }
-
-        return commands;
+        return true;
     }
 
 }}  // namespace dawn_wire::server
@@ -95,6 +95,30 @@ void ProcTableAsClass::BufferMapWriteAsync(DawnBuffer self,
     OnBufferMapWriteAsyncCallback(self, callback, userdata);
 }
 
+void ProcTableAsClass::BufferMapReadRangeAsync(DawnBuffer self,
+                                               uint64_t offset,
+                                               uint64_t size,
+                                               DawnBufferMapReadCallback callback,
+                                               void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->mapReadCallback = callback;
+    object->userdata1 = userdata;
+
+    OnBufferMapReadRangeAsyncCallback(self, offset, size, callback, userdata);
+}
+
+void ProcTableAsClass::BufferMapWriteRangeAsync(DawnBuffer self,
+                                                uint64_t offset,
+                                                uint64_t size,
+                                                DawnBufferMapWriteCallback callback,
+                                                void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->mapWriteCallback = callback;
+    object->userdata1 = userdata;
+
+    OnBufferMapWriteRangeAsyncCallback(self, offset, size, callback, userdata);
+}
+
 void ProcTableAsClass::FenceOnCompletion(DawnFence self,
                                          uint64_t value,
                                          DawnFenceOnCompletionCallback callback,
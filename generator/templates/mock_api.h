@@ -65,6 +65,16 @@ class ProcTableAsClass {
         void BufferMapWriteAsync(DawnBuffer self,
                                  DawnBufferMapWriteCallback callback,
                                  void* userdata);
+        void BufferMapReadRangeAsync(DawnBuffer self,
+                                     uint64_t offset,
+                                     uint64_t size,
+                                     DawnBufferMapReadCallback callback,
+                                     void* userdata);
+        void BufferMapWriteRangeAsync(DawnBuffer self,
+                                      uint64_t offset,
+                                      uint64_t size,
+                                      DawnBufferMapWriteCallback callback,
+                                      void* userdata);
         void FenceOnCompletion(DawnFence self,
                                uint64_t value,
                                DawnFenceOnCompletionCallback callback,
@@ -87,6 +97,16 @@ class ProcTableAsClass {
         virtual void OnBufferMapWriteAsyncCallback(DawnBuffer buffer,
                                                    DawnBufferMapWriteCallback callback,
                                                    void* userdata) = 0;
+        virtual void OnBufferMapReadRangeAsyncCallback(DawnBuffer buffer,
+                                                       uint64_t offset,
+                                                       uint64_t size,
+                                                       DawnBufferMapReadCallback callback,
+                                                       void* userdata) = 0;
+        virtual void OnBufferMapWriteRangeAsyncCallback(DawnBuffer buffer,
+                                                        uint64_t offset,
+                                                        uint64_t size,
+                                                        DawnBufferMapWriteCallback callback,
+                                                        void* userdata) = 0;
         virtual void OnFenceOnCompletionCallback(DawnFence fence,
                                                  uint64_t value,
                                                  DawnFenceOnCompletionCallback callback,
@@ -142,6 +162,8 @@ class MockProcTable : public ProcTableAsClass {
         MOCK_METHOD4(OnDeviceCreateBufferMappedAsyncCallback, void(DawnDevice device, const DawnBufferDescriptor* descriptor, DawnBufferCreateMappedCallback callback, void* userdata));
         MOCK_METHOD3(OnBufferMapReadAsyncCallback, void(DawnBuffer buffer, DawnBufferMapReadCallback callback, void* userdata));
         MOCK_METHOD3(OnBufferMapWriteAsyncCallback, void(DawnBuffer buffer, DawnBufferMapWriteCallback callback, void* userdata));
+        MOCK_METHOD5(OnBufferMapReadRangeAsyncCallback, void(DawnBuffer buffer, uint64_t offset, uint64_t size, DawnBufferMapReadCallback callback, void* userdata));
+        MOCK_METHOD5(OnBufferMapWriteRangeAsyncCallback, void(DawnBuffer buffer, uint64_t offset, uint64_t size, DawnBufferMapWriteCallback callback, void* userdata));
         MOCK_METHOD4(OnFenceOnCompletionCallback,
                      void(DawnFence fence,
                           uint64_t value,
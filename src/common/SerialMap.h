@@ -17,7 +17,6 @@
 
 #include "common/SerialStorage.h"
 
-#include <map>
 #include <vector>
 
 template <typename T>
@@ -26,15 +25,14 @@ class SerialMap;
 template <typename T>
 struct SerialStorageTraits<SerialMap<T>> {
     using Value = T;
-    using Storage = std::map<Serial, std::vector<T>>;
-    using StorageIterator = typename Storage::iterator;
-    using ConstStorageIterator = typename Storage::const_iterator;
 };
 
 // SerialMap stores a map from Serial to T.
 // Unlike SerialQueue, items may be enqueued with Serials in any
 // arbitrary order. SerialMap provides useful iterators for iterating
-// through T items in order of increasing Serial.
+// through T items in order of increasing Serial. Enqueuing is constant
+// time when Serials are mostly increasing, like fence values, and
+// linear in the number of items with a bigger Serial otherwise.
 template <typename T>
 class SerialMap : public SerialStorage<SerialMap<T>> {
   public:
@@ -48,12 +46,12 @@ class SerialMap : public SerialStorage<SerialMap<T>> {
 
 template <typename T>
 void SerialMap<T>::Enqueue(const T& value, Serial serial) {
-    this->mStorage[serial].emplace_back(value);
+    this->EmplaceSorted(value, serial);
 }
 
 template <typename T>
 void SerialMap<T>::Enqueue(T&& value, Serial serial) {
-    this->mStorage[serial].emplace_back(value);
+    this->EmplaceSorted(std::move(value), serial);
 }
 
 template <typename T>
@@ -67,8 +65,8 @@ void SerialMap<T>::Enqueue(const std::vector<T>& values, Serial serial) {
 template <typename T>
 void SerialMap<T>::Enqueue(std::vector<T>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    for (const T& value : values) {
-        Enqueue(value, serial);
+    for (T& value : values) {
+        Enqueue(std::move(value), serial);
     }
 }
 
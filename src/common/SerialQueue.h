@@ -25,10 +25,6 @@ class SerialQueue;
 template <typename T>
 struct SerialStorageTraits<SerialQueue<T>> {
     using Value = T;
-    using SerialPair = std::pair<Serial, std::vector<T>>;
-    using Storage = std::vector<SerialPair>;
-    using StorageIterator = typename Storage::iterator;
-    using ConstStorageIterator = typename Storage::const_iterator;
 };
 
 // SerialQueue stores an associative list mapping a Serial to T.
@@ -38,8 +34,6 @@ struct SerialStorageTraits<SerialQueue<T>> {
 template <typename T>
 class SerialQueue : public SerialStorage<SerialQueue<T>> {
   public:
-    using SerialPair = typename SerialStorageTraits<SerialQueue<T>>::SerialPair;
-
     // The serial must be given in (not strictly) increasing order.
     void Enqueue(const T& value, Serial serial);
     void Enqueue(T&& value, Serial serial);
@@ -51,36 +45,30 @@ class SerialQueue : public SerialStorage<SerialQueue<T>> {
 
 template <typename T>
 void SerialQueue<T>::Enqueue(const T& value, Serial serial) {
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-
-    if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<T>{});
-    }
-    this->mStorage.back().second.push_back(value);
+    this->EmplaceBack(value, serial);
 }
 
 template <typename T>
 void SerialQueue<T>::Enqueue(T&& value, Serial serial) {
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-
-    if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<T>{});
-    }
-    this->mStorage.back().second.push_back(std::move(value));
+    this->EmplaceBack(std::move(value), serial);
 }
 
 template <typename T>
 void SerialQueue<T>::Enqueue(const std::vector<T>& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    this->Reserve(values.size());
+    for (const T& value : values) {
+        this->EmplaceBack(value, serial);
+    }
 }
 
 template <typename T>
 void SerialQueue<T>::Enqueue(std::vector<T>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+    this->Reserve(values.size());
+    for (T& value : values) {
+        this->EmplaceBack(std::move(value), serial);
+    }
 }
 
 #endif  // COMMON_SERIALQUEUE_H_
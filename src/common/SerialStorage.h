@@ -18,24 +18,35 @@
 #include "common/Assert.h"
 #include "common/Serial.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <new>
 #include <utility>
 
 template <typename T>
 struct SerialStorageTraits {};
 
+// SerialStorage stores the (Serial, T) entries of SerialQueue and SerialMap in a single ring
+// buffer, sorted by increasing Serial. Entries are appended at the back and cleared from the
+// front in amortized constant time without any per-Serial allocation: memory is only allocated
+// when the ring is full, in which case its capacity doubles.
 template <typename Derived>
 class SerialStorage {
   private:
     using Value = typename SerialStorageTraits<Derived>::Value;
-    using Storage = typename SerialStorageTraits<Derived>::Storage;
-    using StorageIterator = typename SerialStorageTraits<Derived>::StorageIterator;
-    using ConstStorageIterator = typename SerialStorageTraits<Derived>::ConstStorageIterator;
+
+    struct Entry {
+        Serial serial;
+        Value value;
+    };
 
   public:
+    // Iterators refer to entries by their index from the front of the storage so that values
+    // with a larger Serial can be enqueued while iterating, for example by callbacks.
     class Iterator {
       public:
-        Iterator(StorageIterator start);
+        Iterator(SerialStorage* storage, size_t index);
         Iterator& operator++();
 
         bool operator==(const Iterator& other) const;
@@ -43,16 +54,13 @@ class SerialStorage {
         Value& operator*() const;
 
       private:
-        StorageIterator mStorageIterator;
-        // Special case the mSerialIterator when it should be equal to mStorageIterator.begin()
-        // otherwise we could ask mStorageIterator.begin() when mStorageIterator is mStorage.end()
-        // which is invalid. mStorageIterator.begin() is tagged with a nullptr.
-        Value* mSerialIterator;
+        SerialStorage* mStorage;
+        size_t mIndex;
     };
 
     class ConstIterator {
       public:
-        ConstIterator(ConstStorageIterator start);
+        ConstIterator(const SerialStorage* storage, size_t index);
         ConstIterator& operator++();
 
         bool operator==(const ConstIterator& other) const;
@@ -60,41 +68,41 @@ class SerialStorage {
         const Value& operator*() const;
 
       private:
-        ConstStorageIterator mStorageIterator;
-        const Value* mSerialIterator;
+        const SerialStorage* mStorage;
+        size_t mIndex;
     };
 
     class BeginEnd {
       public:
-        BeginEnd(StorageIterator start, StorageIterator end);
+        BeginEnd(SerialStorage* storage, size_t start, size_t end);
 
         Iterator begin() const;
         Iterator end() const;
 
       private:
-        StorageIterator mStartIt;
-        StorageIterator mEndIt;
+        SerialStorage* mStorage;
+        size_t mStart;
+        size_t mEnd;
     };
 
     class ConstBeginEnd {
       public:
-        ConstBeginEnd(ConstStorageIterator start, ConstStorageIterator end);
+        ConstBeginEnd(const SerialStorage* storage, size_t start, size_t end);
 
         ConstIterator begin() const;
         ConstIterator end() const;
 
       private:
-        ConstStorageIterator mStartIt;
-        ConstStorageIterator mEndIt;
+        const SerialStorage* mStorage;
+        size_t mStart;
+        size_t mEnd;
     };
 
-    // Derived classes may specialize constraits for elements stored
-    // Ex.) SerialQueue enforces that the serial must be given in (not strictly)
-    //      increasing order
-    template <typename... Params>
-    void Enqueue(Params&&... args, Serial serial) {
-        Derived::Enqueue(std::forward<Params>(args)..., serial);
-    }
+    SerialStorage() = default;
+    ~SerialStorage();
+
+    SerialStorage(const SerialStorage&) = delete;
+    SerialStorage& operator=(const SerialStorage&) = delete;
 
     bool Empty() const;
 
@@ -113,128 +121,223 @@ class SerialStorage {
     Serial LastSerial() const;
 
   protected:
-    // Returns the first StorageIterator that a serial bigger than serial.
-    ConstStorageIterator FindUpTo(Serial serial) const;
-    StorageIterator FindUpTo(Serial serial);
-    Storage mStorage;
+    // Returns the number of entries with a serial smaller or equal to serial.
+    size_t FindUpTo(Serial serial) const;
+
+    // Makes room for |count| more entries so that they can be enqueued without growing.
+    void Reserve(size_t count);
+
+    // Adds the value at the back of the storage. The serial must be bigger or equal to the last
+    // serial of the storage.
+    template <typename V>
+    void EmplaceBack(V&& value, Serial serial);
+
+    // Adds the value after all the values with a serial smaller or equal to serial. This is
+    // constant time when the serial is bigger or equal to the last serial, and linear otherwise.
+    template <typename V>
+    void EmplaceSorted(V&& value, Serial serial);
+
+  private:
+    Entry& At(size_t index);
+    const Entry& At(size_t index) const;
+
+    Entry* mEntries = nullptr;
+    // The capacity is always a power of two so that indices wrap around with a mask.
+    size_t mCapacity = 0;
+    size_t mFront = 0;
+    size_t mSize = 0;
 };
 
 // SerialStorage
 
+template <typename Derived>
+SerialStorage<Derived>::~SerialStorage() {
+    Clear();
+    if (mEntries != nullptr) {
+        std::allocator<Entry>().deallocate(mEntries, mCapacity);
+    }
+}
+
 template <typename Derived>
 bool SerialStorage<Derived>::Empty() const {
-    return mStorage.empty();
+    return mSize == 0;
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstBeginEnd SerialStorage<Derived>::IterateAll() const {
-    return {mStorage.begin(), mStorage.end()};
+    return {this, 0, mSize};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstBeginEnd SerialStorage<Derived>::IterateUpTo(
     Serial serial) const {
-    return {mStorage.begin(), FindUpTo(serial)};
+    return {this, 0, FindUpTo(serial)};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::BeginEnd SerialStorage<Derived>::IterateAll() {
-    return {mStorage.begin(), mStorage.end()};
+    return {this, 0, mSize};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::BeginEnd SerialStorage<Derived>::IterateUpTo(Serial serial) {
-    return {mStorage.begin(), FindUpTo(serial)};
+    return {this, 0, FindUpTo(serial)};
 }
 
 template <typename Derived>
 void SerialStorage<Derived>::Clear() {
-    mStorage.clear();
+    for (size_t i = 0; i < mSize; ++i) {
+        At(i).~Entry();
+    }
+    mFront = 0;
+    mSize = 0;
 }
 
 template <typename Derived>
 void SerialStorage<Derived>::ClearUpTo(Serial serial) {
-    mStorage.erase(mStorage.begin(), FindUpTo(serial));
+    size_t count = FindUpTo(serial);
+    for (size_t i = 0; i < count; ++i) {
+        At(i).~Entry();
+    }
+    if (count > 0) {
+        mFront = (mFront + count) & (mCapacity - 1);
+        mSize -= count;
+    }
 }
 
 template <typename Derived>
 Serial SerialStorage<Derived>::FirstSerial() const {
     DAWN_ASSERT(!Empty());
-    return mStorage.begin()->first;
+    return At(0).serial;
 }
 
 template <typename Derived>
 Serial SerialStorage<Derived>::LastSerial() const {
     DAWN_ASSERT(!Empty());
-    return mStorage.back().first;
+    return At(mSize - 1).serial;
 }
 
 template <typename Derived>
-typename SerialStorage<Derived>::ConstStorageIterator SerialStorage<Derived>::FindUpTo(
-    Serial serial) const {
-    auto it = mStorage.begin();
-    while (it != mStorage.end() && it->first <= serial) {
-        it++;
+size_t SerialStorage<Derived>::FindUpTo(Serial serial) const {
+    // Binary search for the first entry with a serial bigger than serial.
+    size_t begin = 0;
+    size_t end = mSize;
+    while (begin < end) {
+        size_t middle = begin + (end - begin) / 2;
+        if (At(middle).serial <= serial) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return begin;
+}
+
+template <typename Derived>
+void SerialStorage<Derived>::Reserve(size_t count) {
+    size_t requiredCapacity = mSize + count;
+    if (requiredCapacity <= mCapacity) {
+        return;
+    }
+
+    size_t newCapacity = mCapacity == 0 ? 8 : mCapacity;
+    while (newCapacity < requiredCapacity) {
+        newCapacity *= 2;
+    }
+
+    // Move the entries to the start of the new ring.
+    Entry* newEntries = std::allocator<Entry>().allocate(newCapacity);
+    for (size_t i = 0; i < mSize; ++i) {
+        Entry& entry = At(i);
+        new (&newEntries[i]) Entry(std::move(entry));
+        entry.~Entry();
+    }
+
+    if (mEntries != nullptr) {
+        std::allocator<Entry>().deallocate(mEntries, mCapacity);
     }
-    return it;
+    mEntries = newEntries;
+    mCapacity = newCapacity;
+    mFront = 0;
 }
 
 template <typename Derived>
-typename SerialStorage<Derived>::StorageIterator SerialStorage<Derived>::FindUpTo(Serial serial) {
-    auto it = mStorage.begin();
-    while (it != mStorage.end() && it->first <= serial) {
-        it++;
+template <typename V>
+void SerialStorage<Derived>::EmplaceBack(V&& value, Serial serial) {
+    DAWN_ASSERT(Empty() || LastSerial() <= serial);
+
+    Reserve(1);
+    new (&At(mSize)) Entry{serial, std::forward<V>(value)};
+    mSize++;
+}
+
+template <typename Derived>
+template <typename V>
+void SerialStorage<Derived>::EmplaceSorted(V&& value, Serial serial) {
+    if (Empty() || LastSerial() <= serial) {
+        EmplaceBack(std::forward<V>(value), serial);
+        return;
     }
-    return it;
+
+    size_t position = FindUpTo(serial);
+    Reserve(1);
+
+    // Shift the entries after the position by one to make room for the new entry.
+    new (&At(mSize)) Entry(std::move(At(mSize - 1)));
+    for (size_t i = mSize - 1; i > position; --i) {
+        At(i) = std::move(At(i - 1));
+    }
+    At(position).serial = serial;
+    At(position).value = std::forward<V>(value);
+    mSize++;
+}
+
+template <typename Derived>
+typename SerialStorage<Derived>::Entry& SerialStorage<Derived>::At(size_t index) {
+    return mEntries[(mFront + index) & (mCapacity - 1)];
+}
+
+template <typename Derived>
+const typename SerialStorage<Derived>::Entry& SerialStorage<Derived>::At(size_t index) const {
+    return mEntries[(mFront + index) & (mCapacity - 1)];
 }
 
 // SerialStorage::BeginEnd
 
 template <typename Derived>
-SerialStorage<Derived>::BeginEnd::BeginEnd(typename SerialStorage<Derived>::StorageIterator start,
-                                           typename SerialStorage<Derived>::StorageIterator end)
-    : mStartIt(start), mEndIt(end) {
+SerialStorage<Derived>::BeginEnd::BeginEnd(SerialStorage<Derived>* storage,
+                                           size_t start,
+                                           size_t end)
+    : mStorage(storage), mStart(start), mEnd(end) {
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::Iterator SerialStorage<Derived>::BeginEnd::begin() const {
-    return {mStartIt};
+    return {mStorage, mStart};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::Iterator SerialStorage<Derived>::BeginEnd::end() const {
-    return {mEndIt};
+    return {mStorage, mEnd};
 }
 
 // SerialStorage::Iterator
 
 template <typename Derived>
-SerialStorage<Derived>::Iterator::Iterator(typename SerialStorage<Derived>::StorageIterator start)
-    : mStorageIterator(start), mSerialIterator(nullptr) {
+SerialStorage<Derived>::Iterator::Iterator(SerialStorage<Derived>* storage, size_t index)
+    : mStorage(storage), mIndex(index) {
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::Iterator& SerialStorage<Derived>::Iterator::operator++() {
-    Value* vectorData = mStorageIterator->second.data();
-
-    if (mSerialIterator == nullptr) {
-        mSerialIterator = vectorData + 1;
-    } else {
-        mSerialIterator++;
-    }
-
-    if (mSerialIterator >= vectorData + mStorageIterator->second.size()) {
-        mSerialIterator = nullptr;
-        mStorageIterator++;
-    }
-
+    mIndex++;
     return *this;
 }
 
 template <typename Derived>
 bool SerialStorage<Derived>::Iterator::operator==(
     const typename SerialStorage<Derived>::Iterator& other) const {
-    return other.mStorageIterator == mStorageIterator && other.mSerialIterator == mSerialIterator;
+    return other.mStorage == mStorage && other.mIndex == mIndex;
 }
 
 template <typename Derived>
@@ -245,63 +348,48 @@ bool SerialStorage<Derived>::Iterator::operator!=(
 
 template <typename Derived>
 typename SerialStorage<Derived>::Value& SerialStorage<Derived>::Iterator::operator*() const {
-    if (mSerialIterator == nullptr) {
-        return *mStorageIterator->second.begin();
-    }
-    return *mSerialIterator;
+    return mStorage->At(mIndex).value;
 }
 
 // SerialStorage::ConstBeginEnd
 
 template <typename Derived>
-SerialStorage<Derived>::ConstBeginEnd::ConstBeginEnd(
-    typename SerialStorage<Derived>::ConstStorageIterator start,
-    typename SerialStorage<Derived>::ConstStorageIterator end)
-    : mStartIt(start), mEndIt(end) {
+SerialStorage<Derived>::ConstBeginEnd::ConstBeginEnd(const SerialStorage<Derived>* storage,
+                                                     size_t start,
+                                                     size_t end)
+    : mStorage(storage), mStart(start), mEnd(end) {
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstIterator SerialStorage<Derived>::ConstBeginEnd::begin()
     const {
-    return {mStartIt};
+    return {mStorage, mStart};
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstIterator SerialStorage<Derived>::ConstBeginEnd::end() const {
-    return {mEndIt};
+    return {mStorage, mEnd};
 }
 
 // SerialStorage::ConstIterator
 
 template <typename Derived>
-SerialStorage<Derived>::ConstIterator::ConstIterator(
-    typename SerialStorage<Derived>::ConstStorageIterator start)
-    : mStorageIterator(start), mSerialIterator(nullptr) {
+SerialStorage<Derived>::ConstIterator::ConstIterator(const SerialStorage<Derived>* storage,
+                                                     size_t index)
+    : mStorage(storage), mIndex(index) {
 }
 
 template <typename Derived>
 typename SerialStorage<Derived>::ConstIterator& SerialStorage<Derived>::ConstIterator::
 operator++() {
-    const Value* vectorData = mStorageIterator->second.data();
-
-    if (mSerialIterator == nullptr) {
-        mSerialIterator = vectorData + 1;
-    } else {
-        mSerialIterator++;
-    }
-
-    if (mSerialIterator >= vectorData + mStorageIterator->second.size()) {
-        mSerialIterator = nullptr;
-        mStorageIterator++;
-    }
-
+    mIndex++;
     return *this;
 }
 
 template <typename Derived>
 bool SerialStorage<Derived>::ConstIterator::operator==(
     const typename SerialStorage<Derived>::ConstIterator& other) const {
-    return other.mStorageIterator == mStorageIterator && other.mSerialIterator == mSerialIterator;
+    return other.mStorage == mStorage && other.mIndex == mIndex;
 }
 
 template <typename Derived>
@@ -313,10 +401,7 @@ bool SerialStorage<Derived>::ConstIterator::operator!=(
 template <typename Derived>
 const typename SerialStorage<Derived>::Value& SerialStorage<Derived>::ConstIterator::operator*()
     const {
-    if (mSerialIterator == nullptr) {
-        return *mStorageIterator->second.begin();
-    }
-    return *mSerialIterator;
+    return mStorage->At(mIndex).value;
 }
 
 #endif  // COMMON_SERIALSTORAGE_H_
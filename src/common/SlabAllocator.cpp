@@ -0,0 +1,89 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/SlabAllocator.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+
+#include <algorithm>
+
+constexpr uint32_t SlabAllocator::kMinBlocksPerSlab;
+constexpr uint32_t SlabAllocator::kMaxBlocksPerSlab;
+
+SlabAllocator::SlabAllocator() {
+}
+
+SlabAllocator::~SlabAllocator() {
+    ASSERT(mAllocatedBlockCount == 0);
+    for (void* slab : mSlabs) {
+        ::operator delete(slab);
+    }
+}
+
+void* SlabAllocator::Allocate(size_t blockSize) {
+    // Slabs are aligned for any type, keep every block in them aligned too.
+    blockSize = Align(static_cast<uint32_t>(std::max(blockSize, sizeof(FreeBlock))),
+                      alignof(std::max_align_t));
+    ASSERT(mBlockSize == 0 || mBlockSize == blockSize);
+    mBlockSize = blockSize;
+
+    if (mFreeList == nullptr) {
+        AllocateSlab();
+    }
+
+    FreeBlock* block = mFreeList;
+    mFreeList = block->next;
+    mAllocatedBlockCount++;
+    return block;
+}
+
+void SlabAllocator::Deallocate(void* block) {
+    ASSERT(block != nullptr);
+    ASSERT(mAllocatedBlockCount > 0);
+
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = mFreeList;
+    mFreeList = freeBlock;
+    mAllocatedBlockCount--;
+}
+
+size_t SlabAllocator::GetBlockSize() const {
+    return mBlockSize;
+}
+
+size_t SlabAllocator::GetSlabCount() const {
+    return mSlabs.size();
+}
+
+size_t SlabAllocator::GetAllocatedBlockCount() const {
+    return mAllocatedBlockCount;
+}
+
+void SlabAllocator::AllocateSlab() {
+    ASSERT(mFreeList == nullptr);
+
+    uint32_t blockCount = mNextSlabBlockCount;
+    mNextSlabBlockCount = std::min(2 * mNextSlabBlockCount, kMaxBlocksPerSlab);
+
+    char* slab = static_cast<char*>(::operator new(blockCount * mBlockSize));
+    mSlabs.push_back(slab);
+
+    // Thread the blocks of the slab in the free list, in address order.
+    for (uint32_t i = blockCount; i > 0; --i) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * mBlockSize);
+        block->next = mFreeList;
+        mFreeList = block;
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_SLABALLOCATOR_H_
+#define COMMON_SLABALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+// SlabAllocator allocates blocks of a single size out of larger slabs of memory. Freed blocks are
+// kept in a free list and reused for the next allocations, so once an allocator has warmed up,
+// allocating and freeing objects at a high rate doesn't touch the system allocator. Slabs are
+// only returned to the system when the allocator is destroyed.
+//
+// The size of the blocks is set by the first allocation, which lets users hold an allocator for
+// objects whose size is only known later, for example the backend type of a frontend object.
+// The allocator isn't thread-safe.
+class SlabAllocator {
+  public:
+    SlabAllocator();
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    // All the allocations of an allocator must have the same size.
+    void* Allocate(size_t blockSize);
+    void Deallocate(void* block);
+
+    template <typename T, typename... Args>
+    T* New(Args&&... args) {
+        return new (Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+
+    size_t GetBlockSize() const;
+    size_t GetSlabCount() const;
+    size_t GetAllocatedBlockCount() const;
+
+  private:
+    // Slabs start small so that allocators used for a handful of objects stay cheap, and grow
+    // up to kMaxBlocksPerSlab blocks.
+    static constexpr uint32_t kMinBlocksPerSlab = 4;
+    static constexpr uint32_t kMaxBlocksPerSlab = 256;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void AllocateSlab();
+
+    size_t mBlockSize = 0;
+    uint32_t mNextSlabBlockCount = kMinBlocksPerSlab;
+    size_t mAllocatedBlockCount = 0;
+    FreeBlock* mFreeList = nullptr;
+    std::vector<void*> mSlabs;
+};
+
+#endif  // COMMON_SLABALLOCATOR_H_
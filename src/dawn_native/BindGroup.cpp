@@ -15,6 +15,8 @@
 #include "dawn_native/BindGroup.h"
 
 #include "common/Assert.h"
+#include "common/BitSetIterator.h"
+#include "common/HashUtils.h"
 #include "common/Math.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Buffer.h"
@@ -100,6 +102,10 @@ namespace dawn_native {
             return {};
         }
 
+        uint64_t GetBufferBindingSize(const BindGroupBinding& binding) {
+            return binding.size == dawn::kWholeSize ? binding.buffer->GetSize() : binding.size;
+        }
+
     }  // anonymous namespace
 
     MaybeError ValidateBindGroupDescriptor(DeviceBase* device,
@@ -173,35 +179,49 @@ namespace dawn_native {
     // BindGroup
 
     BindGroupBase::BindGroupBase(DeviceBase* device, const BindGroupDescriptor* descriptor)
-        : ObjectBase(device), mLayout(descriptor->layout) {
+        : BindGroupBase(this, device, descriptor) {
+    }
+
+    BindGroupBase::BindGroupBase(DeviceBase* device,
+                                 const BindGroupDescriptor* descriptor,
+                                 void* bindingDataStart)
+        : ObjectBase(device),
+          mLayout(descriptor->layout),
+          mBindingData(static_cast<BindingData*>(bindingDataStart)) {
+        ASSERT(IsPtrAligned(mBindingData, alignof(BindingData)));
+
+        uint32_t bindingCount = static_cast<uint32_t>(mLayout->GetBindingInfo().mask.count());
+        for (uint32_t i = 0; i < bindingCount; ++i) {
+            new (&mBindingData[i]) BindingData{nullptr, 0, 0};
+        }
+
         for (uint32_t i = 0; i < descriptor->bindingCount; ++i) {
             const BindGroupBinding& binding = descriptor->bindings[i];
 
             uint32_t bindingIndex = binding.binding;
             ASSERT(bindingIndex < kMaxBindingsPerGroup);
+            BindingData& data = GetBindingData(bindingIndex);
 
             // Only a single binding type should be set, so once we found it we can skip to the
             // next loop iteration.
 
             if (binding.buffer != nullptr) {
-                ASSERT(mBindings[bindingIndex].Get() == nullptr);
-                mBindings[bindingIndex] = binding.buffer;
-                mOffsets[bindingIndex] = binding.offset;
-                uint64_t bufferSize =
-                    (binding.size == dawn::kWholeSize) ? binding.buffer->GetSize() : binding.size;
-                mSizes[bindingIndex] = bufferSize;
+                ASSERT(data.object.Get() == nullptr);
+                data.object = binding.buffer;
+                data.offset = binding.offset;
+                data.size = GetBufferBindingSize(binding);
                 continue;
             }
 
             if (binding.textureView != nullptr) {
-                ASSERT(mBindings[bindingIndex].Get() == nullptr);
-                mBindings[bindingIndex] = binding.textureView;
+                ASSERT(data.object.Get() == nullptr);
+                data.object = binding.textureView;
                 continue;
             }
 
             if (binding.sampler != nullptr) {
-                ASSERT(mBindings[bindingIndex].Get() == nullptr);
-                mBindings[bindingIndex] = binding.sampler;
+                ASSERT(data.object.Get() == nullptr);
+                data.object = binding.sampler;
                 continue;
             }
         }
@@ -211,11 +231,43 @@ namespace dawn_native {
         : ObjectBase(device, tag) {
     }
 
+    BindGroupBase::~BindGroupBase() {
+        if (mBindingData == nullptr) {
+            return;
+        }
+
+        uint32_t bindingCount = static_cast<uint32_t>(mLayout->GetBindingInfo().mask.count());
+        for (uint32_t i = 0; i < bindingCount; ++i) {
+            mBindingData[i].~BindingData();
+        }
+    }
+
+    void BindGroupBase::DeleteThis() {
+        if (DeferDeletion()) {
+            return;
+        }
+        if (IsError()) {
+            ObjectBase::DeleteThis();
+            return;
+        }
+
+        // Destroying the bind group can release the last reference to the layout, keep it alive
+        // until the bind group's block is returned to its allocator.
+        Ref<BindGroupLayoutBase> layout = mLayout;
+        this->~BindGroupBase();
+        layout->GetBindGroupAllocator()->Deallocate(this);
+    }
+
     // static
     BindGroupBase* BindGroupBase::MakeError(DeviceBase* device) {
         return new BindGroupBase(device, ObjectBase::kError);
     }
 
+    // static
+    size_t BindGroupBase::GetBindingDataSize(const BindGroupLayoutBase* layout) {
+        return layout->GetBindingInfo().mask.count() * sizeof(BindingData);
+    }
+
     const BindGroupLayoutBase* BindGroupBase::GetLayout() const {
         ASSERT(!IsError());
         return mLayout.Get();
@@ -227,8 +279,9 @@ namespace dawn_native {
         ASSERT(mLayout->GetBindingInfo().mask[binding]);
         ASSERT(mLayout->GetBindingInfo().types[binding] == dawn::BindingType::UniformBuffer ||
                mLayout->GetBindingInfo().types[binding] == dawn::BindingType::StorageBuffer);
-        BufferBase* buffer = static_cast<BufferBase*>(mBindings[binding].Get());
-        return {buffer, mOffsets[binding], mSizes[binding]};
+        BindingData& data = GetBindingData(binding);
+        BufferBase* buffer = static_cast<BufferBase*>(data.object.Get());
+        return {buffer, data.offset, data.size};
     }
 
     SamplerBase* BindGroupBase::GetBindingAsSampler(size_t binding) {
@@ -236,7 +289,7 @@ namespace dawn_native {
         ASSERT(binding < kMaxBindingsPerGroup);
         ASSERT(mLayout->GetBindingInfo().mask[binding]);
         ASSERT(mLayout->GetBindingInfo().types[binding] == dawn::BindingType::Sampler);
-        return static_cast<SamplerBase*>(mBindings[binding].Get());
+        return static_cast<SamplerBase*>(GetBindingData(binding).object.Get());
     }
 
     TextureViewBase* BindGroupBase::GetBindingAsTextureView(size_t binding) {
@@ -244,7 +297,112 @@ namespace dawn_native {
         ASSERT(binding < kMaxBindingsPerGroup);
         ASSERT(mLayout->GetBindingInfo().mask[binding]);
         ASSERT(mLayout->GetBindingInfo().types[binding] == dawn::BindingType::SampledTexture);
-        return static_cast<TextureViewBase*>(mBindings[binding].Get());
+        return static_cast<TextureViewBase*>(GetBindingData(binding).object.Get());
+    }
+
+    // static
+    size_t BindGroupBase::ComputeContentHash(const BindGroupDescriptor* descriptor) {
+        // Gather the bindings by binding number so that the hash doesn't depend on the order in
+        // which they are listed in the descriptor. Validation guarantees that each binding of the
+        // layout is set exactly once.
+        std::array<const BindGroupBinding*, kMaxBindingsPerGroup> bindings;
+        for (uint32_t i = 0; i < descriptor->bindingCount; ++i) {
+            bindings[descriptor->bindings[i].binding] = &descriptor->bindings[i];
+        }
+
+        size_t hash = 0;
+        HashCombine(&hash, descriptor->layout);
+        for (uint32_t bindingIndex : IterateBitSet(descriptor->layout->GetBindingInfo().mask)) {
+            const BindGroupBinding& binding = *bindings[bindingIndex];
+            if (binding.buffer != nullptr) {
+                HashCombine(&hash, binding.buffer, binding.offset, GetBufferBindingSize(binding));
+            } else if (binding.textureView != nullptr) {
+                HashCombine(&hash, binding.textureView);
+            } else {
+                HashCombine(&hash, binding.sampler);
+            }
+        }
+        return hash;
+    }
+
+    bool BindGroupBase::IsEqualToDescriptor(const BindGroupDescriptor* descriptor) const {
+        ASSERT(!IsError());
+        if (mLayout.Get() != descriptor->layout) {
+            return false;
+        }
+
+        // Validation guarantees that the descriptor sets each binding of the layout once so it is
+        // enough to check the bindings of the descriptor.
+        for (uint32_t i = 0; i < descriptor->bindingCount; ++i) {
+            const BindGroupBinding& binding = descriptor->bindings[i];
+            const BindingData& data = GetBindingData(binding.binding);
+
+            if (binding.buffer != nullptr) {
+                if (data.object.Get() != binding.buffer || data.offset != binding.offset ||
+                    data.size != GetBufferBindingSize(binding)) {
+                    return false;
+                }
+            } else if (binding.textureView != nullptr) {
+                if (data.object.Get() != binding.textureView) {
+                    return false;
+                }
+            } else if (data.object.Get() != binding.sampler) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool BindGroupBase::UsesBuffer(const BufferBase* buffer) const {
+        ASSERT(!IsError());
+        const auto& layoutInfo = mLayout->GetBindingInfo();
+        for (uint32_t bindingIndex : IterateBitSet(layoutInfo.mask)) {
+            switch (layoutInfo.types[bindingIndex]) {
+                case dawn::BindingType::UniformBuffer:
+                case dawn::BindingType::StorageBuffer:
+                case dawn::BindingType::ReadonlyStorageBuffer:
+                    if (GetBindingData(bindingIndex).object.Get() == buffer) {
+                        return true;
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+        }
+        return false;
+    }
+
+    bool BindGroupBase::UsesTexture(const TextureBase* texture) const {
+        ASSERT(!IsError());
+        const auto& layoutInfo = mLayout->GetBindingInfo();
+        for (uint32_t bindingIndex : IterateBitSet(layoutInfo.mask)) {
+            switch (layoutInfo.types[bindingIndex]) {
+                case dawn::BindingType::SampledTexture:
+                case dawn::BindingType::StorageTexture: {
+                    const ObjectBase* object = GetBindingData(bindingIndex).object.Get();
+                    if (static_cast<const TextureViewBase*>(object)->GetTexture() == texture) {
+                        return true;
+                    }
+                } break;
+
+                default:
+                    break;
+            }
+        }
+        return false;
+    }
+
+    BindGroupBase::BindingData& BindGroupBase::GetBindingData(size_t binding) {
+        return const_cast<BindingData&>(
+            static_cast<const BindGroupBase*>(this)->GetBindingData(binding));
+    }
+
+    const BindGroupBase::BindingData& BindGroupBase::GetBindingData(size_t binding) const {
+        // The data is packed in binding order so its index is the number of bindings before it.
+        uint32_t bindingsBefore = static_cast<uint32_t>(
+            mLayout->GetBindingInfo().mask.to_ulong() & ((1ul << binding) - 1));
+        return mBindingData[std::bitset<kMaxBindingsPerGroup>(bindingsBefore).count()];
     }
 
 }  // namespace dawn_native
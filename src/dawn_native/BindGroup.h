@@ -23,7 +23,7 @@
 
 #include "dawn_native/dawn_platform.h"
 
-#include <array>
+#include <new>
 
 namespace dawn_native {
 
@@ -40,7 +40,10 @@ namespace dawn_native {
 
     class BindGroupBase : public ObjectBase {
       public:
+        // Used when BindGroupBase is the bind group type of the backend. Subclasses must use the
+        // constructor taking the derived object instead.
         BindGroupBase(DeviceBase* device, const BindGroupDescriptor* descriptor);
+        ~BindGroupBase() override;
 
         static BindGroupBase* MakeError(DeviceBase* device);
 
@@ -49,15 +52,63 @@ namespace dawn_native {
         SamplerBase* GetBindingAsSampler(size_t binding);
         TextureViewBase* GetBindingAsTextureView(size_t binding);
 
+        // Functions necessary for the deduplication cache in DeviceBase.
+        static size_t ComputeContentHash(const BindGroupDescriptor* descriptor);
+        bool IsEqualToDescriptor(const BindGroupDescriptor* descriptor) const;
+        bool UsesBuffer(const BufferBase* buffer) const;
+        bool UsesTexture(const TextureBase* texture) const;
+
+        // The data stored for each binding of the layout, in binding order.
+        struct BindingData {
+            Ref<ObjectBase> object;
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        // The offset of the per-binding data from the start of an object of type T.
+        template <typename T>
+        static constexpr size_t GetBindingDataOffset() {
+            return (sizeof(T) + alignof(BindingData) - 1) & ~(alignof(BindingData) - 1);
+        }
+        static size_t GetBindingDataSize(const BindGroupLayoutBase* layout);
+
+      protected:
+        template <typename Derived>
+        BindGroupBase(Derived* derived, DeviceBase* device, const BindGroupDescriptor* descriptor)
+            : BindGroupBase(device,
+                            descriptor,
+                            reinterpret_cast<char*>(derived) + GetBindingDataOffset<Derived>()) {
+        }
+
       private:
+        BindGroupBase(DeviceBase* device,
+                      const BindGroupDescriptor* descriptor,
+                      void* bindingDataStart);
         BindGroupBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        // Bind groups other than error ones are allocated by AllocateBindGroup in the slab
+        // allocator of their layout. Deleting them is deferred to the next tick with the
+        // defer_object_deletion toggle.
+        void DeleteThis() override;
+
+        BindingData& GetBindingData(size_t binding);
+        const BindingData& GetBindingData(size_t binding) const;
+
         Ref<BindGroupLayoutBase> mLayout;
-        std::array<Ref<ObjectBase>, kMaxBindingsPerGroup> mBindings;
-        std::array<uint32_t, kMaxBindingsPerGroup> mOffsets;
-        std::array<uint32_t, kMaxBindingsPerGroup> mSizes;
+        BindingData* mBindingData = nullptr;
     };
 
+    // Allocates a bind group of type T, which is BindGroupBase or a subclass of it, in a single
+    // block with the data for the bindings of the descriptor's layout. All the bind groups of a
+    // layout have the same size so the blocks come from a slab allocator owned by the layout.
+    template <typename T, typename DeviceType>
+    T* AllocateBindGroup(DeviceType* device, const BindGroupDescriptor* descriptor) {
+        size_t size = BindGroupBase::GetBindingDataOffset<T>() +
+                      BindGroupBase::GetBindingDataSize(descriptor->layout);
+        return new (descriptor->layout->GetBindGroupAllocator()->Allocate(size))
+            T(device, descriptor);
+    }
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_BINDGROUP_H_
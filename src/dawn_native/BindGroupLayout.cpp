@@ -106,70 +106,56 @@ namespace dawn_native {
             return hash;
         }
 
-        bool operator==(const BindGroupLayoutBase::LayoutBindingInfo& a,
-                        const BindGroupLayoutBase::LayoutBindingInfo& b) {
-            if (a.mask != b.mask || a.dynamic != b.dynamic || a.multisampled != b.multisampled) {
-                return false;
-            }
-
-            for (uint32_t binding : IterateBitSet(a.mask)) {
-                if ((a.visibilities[binding] != b.visibilities[binding]) ||
-                    (a.types[binding] != b.types[binding]) ||
-                    (a.textureComponentTypes[binding] != b.textureComponentTypes[binding])) {
-                    return false;
-                }
+        // The bindings of the descriptor can be in any order, gather them by binding number.
+        BindGroupLayoutBase::LayoutBindingInfo ComputeBindingInfo(
+            const BindGroupLayoutDescriptor* descriptor) {
+            BindGroupLayoutBase::LayoutBindingInfo info;
+            for (uint32_t i = 0; i < descriptor->bindingCount; ++i) {
+                const BindGroupLayoutBinding& binding = descriptor->bindings[i];
+
+                uint32_t index = binding.binding;
+                info.visibilities[index] = binding.visibility;
+                info.types[index] = binding.type;
+                info.textureComponentTypes[index] = binding.textureComponentType;
+                info.dynamic.set(index, binding.dynamic);
+                info.multisampled.set(index, binding.multisampled);
+
+                ASSERT(!info.mask[index]);
+                info.mask.set(index);
             }
-
-            return true;
+            return info;
         }
     }  // namespace
 
     // BindGroupLayoutBase
 
     BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device,
-                                             const BindGroupLayoutDescriptor* descriptor,
-                                             bool blueprint)
-        : ObjectBase(device), mIsBlueprint(blueprint) {
-        for (uint32_t i = 0; i < descriptor->bindingCount; ++i) {
-            auto& binding = descriptor->bindings[i];
-
-            uint32_t index = binding.binding;
-            mBindingInfo.visibilities[index] = binding.visibility;
-            mBindingInfo.types[index] = binding.type;
-            mBindingInfo.textureComponentTypes[index] = binding.textureComponentType;
-
-            if (binding.dynamic) {
-                mBindingInfo.dynamic.set(index);
-                switch (binding.type) {
-                    case dawn::BindingType::UniformBuffer:
-                        ++mDynamicUniformBufferCount;
-                        break;
-                    case dawn::BindingType::StorageBuffer:
-                        ++mDynamicStorageBufferCount;
-                        break;
-                    case dawn::BindingType::SampledTexture:
-                    case dawn::BindingType::Sampler:
-                    case dawn::BindingType::ReadonlyStorageBuffer:
-                    case dawn::BindingType::StorageTexture:
-                        UNREACHABLE();
-                        break;
-                }
+                                             const BindGroupLayoutDescriptor* descriptor)
+        : CachedObject(device), mBindingInfo(ComputeBindingInfo(descriptor)) {
+        for (uint32_t index : IterateBitSet(mBindingInfo.dynamic)) {
+            switch (mBindingInfo.types[index]) {
+                case dawn::BindingType::UniformBuffer:
+                    ++mDynamicUniformBufferCount;
+                    break;
+                case dawn::BindingType::StorageBuffer:
+                    ++mDynamicStorageBufferCount;
+                    break;
+                case dawn::BindingType::SampledTexture:
+                case dawn::BindingType::Sampler:
+                case dawn::BindingType::ReadonlyStorageBuffer:
+                case dawn::BindingType::StorageTexture:
+                    UNREACHABLE();
+                    break;
             }
-
-            mBindingInfo.multisampled.set(index, binding.multisampled);
-
-            ASSERT(!mBindingInfo.mask[index]);
-            mBindingInfo.mask.set(index);
         }
     }
 
     BindGroupLayoutBase::BindGroupLayoutBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ObjectBase(device, tag), mIsBlueprint(true) {
+        : CachedObject(device, tag) {
     }
 
     BindGroupLayoutBase::~BindGroupLayoutBase() {
-        // Do not uncache the actual cached object if we are a blueprint
-        if (!mIsBlueprint && !IsError()) {
+        if (IsCachedReference()) {
             GetDevice()->UncacheBindGroupLayout(this);
         }
     }
@@ -184,13 +170,34 @@ namespace dawn_native {
         return mBindingInfo;
     }
 
-    size_t BindGroupLayoutBase::HashFunc::operator()(const BindGroupLayoutBase* bgl) const {
-        return HashBindingInfo(bgl->mBindingInfo);
+    // static
+    size_t BindGroupLayoutBase::ComputeContentHash(const BindGroupLayoutDescriptor* descriptor) {
+        return HashBindingInfo(ComputeBindingInfo(descriptor));
     }
 
-    bool BindGroupLayoutBase::EqualityFunc::operator()(const BindGroupLayoutBase* a,
-                                                       const BindGroupLayoutBase* b) const {
-        return a->mBindingInfo == b->mBindingInfo;
+    bool BindGroupLayoutBase::IsEqualToDescriptor(
+        const BindGroupLayoutDescriptor* descriptor) const {
+        // The descriptor is validated so its bindings are all different, and it has the same
+        // bindings as this layout if it has as many and they are all in the layout.
+        if (descriptor->bindingCount != mBindingInfo.mask.count()) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < descriptor->bindingCount; ++i) {
+            const BindGroupLayoutBinding& binding = descriptor->bindings[i];
+
+            uint32_t index = binding.binding;
+            if (!mBindingInfo.mask[index] ||
+                mBindingInfo.visibilities[index] != binding.visibility ||
+                mBindingInfo.types[index] != binding.type ||
+                mBindingInfo.textureComponentTypes[index] != binding.textureComponentType ||
+                mBindingInfo.dynamic[index] != binding.dynamic ||
+                mBindingInfo.multisampled[index] != binding.multisampled) {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     uint32_t BindGroupLayoutBase::GetDynamicBufferCount() const {
@@ -205,4 +212,8 @@ namespace dawn_native {
         return mDynamicStorageBufferCount;
     }
 
+    SlabAllocator* BindGroupLayoutBase::GetBindGroupAllocator() {
+        return &mBindGroupAllocator;
+    }
+
 }  // namespace dawn_native
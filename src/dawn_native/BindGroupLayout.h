@@ -16,9 +16,10 @@
 #define DAWNNATIVE_BINDGROUPLAYOUT_H_
 
 #include "common/Constants.h"
+#include "common/SlabAllocator.h"
+#include "dawn_native/CachedObject.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
-#include "dawn_native/ObjectBase.h"
 
 #include "dawn_native/dawn_platform.h"
 
@@ -30,11 +31,9 @@ namespace dawn_native {
     MaybeError ValidateBindGroupLayoutDescriptor(DeviceBase*,
                                                  const BindGroupLayoutDescriptor* descriptor);
 
-    class BindGroupLayoutBase : public ObjectBase {
+    class BindGroupLayoutBase : public CachedObject {
       public:
-        BindGroupLayoutBase(DeviceBase* device,
-                            const BindGroupLayoutDescriptor* descriptor,
-                            bool blueprint = false);
+        BindGroupLayoutBase(DeviceBase* device, const BindGroupLayoutDescriptor* descriptor);
         ~BindGroupLayoutBase() override;
 
         static BindGroupLayoutBase* MakeError(DeviceBase* device);
@@ -49,23 +48,22 @@ namespace dawn_native {
         };
         const LayoutBindingInfo& GetBindingInfo() const;
 
-        // Functors necessary for the unordered_set<BGLBase*>-based cache.
-        struct HashFunc {
-            size_t operator()(const BindGroupLayoutBase* bgl) const;
-        };
-        struct EqualityFunc {
-            bool operator()(const BindGroupLayoutBase* a, const BindGroupLayoutBase* b) const;
-        };
+        // Functions necessary for the descriptor-keyed cache in DeviceBase.
+        static size_t ComputeContentHash(const BindGroupLayoutDescriptor* descriptor);
+        bool IsEqualToDescriptor(const BindGroupLayoutDescriptor* descriptor) const;
 
         uint32_t GetDynamicBufferCount() const;
         uint32_t GetDynamicUniformBufferCount() const;
         uint32_t GetDynamicStorageBufferCount() const;
 
+        // The allocator for the bind groups using this layout, see AllocateBindGroup.
+        SlabAllocator* GetBindGroupAllocator();
+
       private:
         BindGroupLayoutBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        SlabAllocator mBindGroupAllocator;
         LayoutBindingInfo mBindingInfo;
-        bool mIsBlueprint = false;
         uint32_t mDynamicUniformBufferCount = 0;
         uint32_t mDynamicStorageBufferCount = 0;
     };
@@ -21,6 +21,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <utility>
 
 namespace dawn_native {
@@ -64,11 +65,11 @@ namespace dawn_native {
                 UNREACHABLE();
                 return {};
             }
-            MaybeError MapReadAsyncImpl(uint32_t serial) override {
+            MaybeError MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override {
                 UNREACHABLE();
                 return {};
             }
-            MaybeError MapWriteAsyncImpl(uint32_t serial) override {
+            MaybeError MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override {
                 UNREACHABLE();
                 return {};
             }
@@ -129,6 +130,13 @@ namespace dawn_native {
         }
     }
 
+    void BufferBase::DeleteThis() {
+        if (DeferDeletion()) {
+            return;
+        }
+        ObjectBase::DeleteThis();
+    }
+
     // static
     BufferBase* BufferBase::MakeError(DeviceBase* device) {
         return new ErrorBuffer(device);
@@ -157,6 +165,9 @@ namespace dawn_native {
 
         mState = BufferState::Mapped;
 
+        // The application writes the initial content of the buffer through the mapped pointer.
+        SetIsDataInitialized();
+
         if (IsMapWritable()) {
             DAWN_TRY(MapAtCreationImpl(mappedPointer));
             ASSERT(*mappedPointer != nullptr);
@@ -190,6 +201,75 @@ namespace dawn_native {
         }
     }
 
+    bool BufferBase::IsDataInitialized() const {
+        ASSERT(!IsError());
+        return mIsDataInitialized;
+    }
+
+    void BufferBase::SetIsDataInitialized() {
+        ASSERT(!IsError());
+        mIsDataInitialized = true;
+    }
+
+    MaybeError BufferBase::EnsureDataInitialized() {
+        ASSERT(!IsError());
+        if (mIsDataInitialized) {
+            return {};
+        }
+
+        DAWN_TRY(ClearData());
+        mIsDataInitialized = true;
+        return {};
+    }
+
+    MaybeError BufferBase::EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size) {
+        ASSERT(!IsError());
+        if (mIsDataInitialized) {
+            return {};
+        }
+
+        // A write of the whole buffer initializes it without needing a clear.
+        if (offset == 0 && size == GetSize()) {
+            mIsDataInitialized = true;
+            return {};
+        }
+
+        return EnsureDataInitialized();
+    }
+
+    MaybeError BufferBase::ClearData() {
+        ASSERT(!IsError());
+        ASSERT(mState == BufferState::Unmapped);
+        GetDevice()->IncrementBufferLazyClearCountForTesting();
+
+        // The buffer hasn't been used yet, so buffers that can be mapped are cleared directly
+        // through their mapping. Upload heaps on D3D12 can't be the destination of copies.
+        if (IsMapWritable()) {
+            uint8_t* data = nullptr;
+            DAWN_TRY(MapAtCreationImpl(&data));
+            ASSERT(data != nullptr);
+            memset(data, 0, GetSize());
+            UnmapImpl();
+            return {};
+        }
+
+        if (GetSize() > std::numeric_limits<uint32_t>::max()) {
+            return DAWN_OUT_OF_MEMORY_ERROR("Buffer is too large to be cleared");
+        }
+
+        DynamicUploader* uploader = nullptr;
+        DAWN_TRY_ASSIGN(uploader, GetDevice()->GetDynamicUploader());
+
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, uploader->Allocate(static_cast<uint32_t>(GetSize())));
+        ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+        memset(uploadHandle.mappedBuffer, 0, GetSize());
+
+        return GetDevice()->CopyFromStagingToBuffer(uploadHandle.stagingBuffer,
+                                                    uploadHandle.startOffset, this, 0, GetSize());
+    }
+
     void BufferBase::CallMapReadCallback(uint32_t serial,
                                          DawnBufferMapAsyncStatus status,
                                          const void* pointer,
@@ -226,18 +306,37 @@ namespace dawn_native {
         }
         ASSERT(!IsError());
 
+        if (GetDevice()->ConsumedError(EnsureDataInitializedAsDestination(start, count))) {
+            return;
+        }
         if (GetDevice()->ConsumedError(SetSubDataImpl(start, count, data))) {
             return;
         }
     }
 
     void BufferBase::MapReadAsync(DawnBufferMapReadCallback callback, void* userdata) {
-        if (GetDevice()->ConsumedError(ValidateMap(dawn::BufferUsage::MapRead))) {
+        // mSize is used instead of GetSize() because the buffer may be an error buffer. This is
+        // caught by the validation in MapReadRangeAsync.
+        MapReadRangeAsync(0, mSize, callback, userdata);
+    }
+
+    void BufferBase::MapReadRangeAsync(uint64_t offset,
+                                       uint64_t size,
+                                       DawnBufferMapReadCallback callback,
+                                       void* userdata) {
+        if (GetDevice()->ConsumedError(ValidateMap(dawn::BufferUsage::MapRead, offset, size))) {
             callback(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0, userdata);
             return;
         }
         ASSERT(!IsError());
 
+        // Mapping exposes the content of the buffer, even for writing since the application
+        // might not write all of the mapped range.
+        if (GetDevice()->ConsumedError(EnsureDataInitialized())) {
+            callback(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0, userdata);
+            return;
+        }
+
         ASSERT(mMapWriteCallback == nullptr);
 
         // TODO(cwallez@chromium.org): what to do on wraparound? Could cause crashes.
@@ -246,7 +345,7 @@ namespace dawn_native {
         mMapUserdata = userdata;
         mState = BufferState::Mapped;
 
-        if (GetDevice()->ConsumedError(MapReadAsyncImpl(mMapSerial))) {
+        if (GetDevice()->ConsumedError(MapReadAsyncImpl(mMapSerial, offset, size))) {
             return;
         }
     }
@@ -268,12 +367,28 @@ namespace dawn_native {
     }
 
     void BufferBase::MapWriteAsync(DawnBufferMapWriteCallback callback, void* userdata) {
-        if (GetDevice()->ConsumedError(ValidateMap(dawn::BufferUsage::MapWrite))) {
+        // mSize is used instead of GetSize() because the buffer may be an error buffer. This is
+        // caught by the validation in MapWriteRangeAsync.
+        MapWriteRangeAsync(0, mSize, callback, userdata);
+    }
+
+    void BufferBase::MapWriteRangeAsync(uint64_t offset,
+                                        uint64_t size,
+                                        DawnBufferMapWriteCallback callback,
+                                        void* userdata) {
+        if (GetDevice()->ConsumedError(ValidateMap(dawn::BufferUsage::MapWrite, offset, size))) {
             callback(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0, userdata);
             return;
         }
         ASSERT(!IsError());
 
+        // Mapping exposes the content of the buffer, even for writing since the application
+        // might not write all of the mapped range.
+        if (GetDevice()->ConsumedError(EnsureDataInitialized())) {
+            callback(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0, userdata);
+            return;
+        }
+
         ASSERT(mMapReadCallback == nullptr);
 
         // TODO(cwallez@chromium.org): what to do on wraparound? Could cause crashes.
@@ -282,7 +397,7 @@ namespace dawn_native {
         mMapUserdata = userdata;
         mState = BufferState::Mapped;
 
-        if (GetDevice()->ConsumedError(MapWriteAsyncImpl(mMapSerial))) {
+        if (GetDevice()->ConsumedError(MapWriteAsyncImpl(mMapSerial, offset, size))) {
             return;
         }
     }
@@ -298,6 +413,8 @@ namespace dawn_native {
         }
         ASSERT(!IsError());
 
+        GetDevice()->EvictDeduplicatedObjectsUsing(this);
+
         if (mState == BufferState::Mapped) {
             if (mStagingBuffer == nullptr) {
                 Unmap();
@@ -384,7 +501,9 @@ namespace dawn_native {
         return {};
     }
 
-    MaybeError BufferBase::ValidateMap(dawn::BufferUsage requiredUsage) const {
+    MaybeError BufferBase::ValidateMap(dawn::BufferUsage requiredUsage,
+                                       uint64_t offset,
+                                       uint64_t size) const {
         DAWN_TRY(GetDevice()->ValidateObject(this));
 
         switch (mState) {
@@ -400,6 +519,15 @@ namespace dawn_native {
             return DAWN_VALIDATION_ERROR("Buffer needs the correct map usage bit");
         }
 
+        if (offset % 4 != 0) {
+            return DAWN_VALIDATION_ERROR("Map offset must be a multiple of 4 bytes");
+        }
+
+        // Note that no overflow can happen because we already checked for GetSize() >= size
+        if (size > GetSize() || offset > GetSize() - size) {
+            return DAWN_VALIDATION_ERROR("Map range out of bounds");
+        }
+
         return {};
     }
 
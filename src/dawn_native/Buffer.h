@@ -57,10 +57,25 @@ namespace dawn_native {
 
         MaybeError ValidateCanUseInSubmitNow() const;
 
+        // Buffers are zero-initialized lazily, like textures: the content is cleared before the
+        // first use that could observe it, unless that use overwrites the whole buffer.
+        bool IsDataInitialized() const;
+        void SetIsDataInitialized();
+        MaybeError EnsureDataInitialized();
+        MaybeError EnsureDataInitializedAsDestination(uint64_t offset, uint64_t size);
+
         // Dawn API
         void SetSubData(uint32_t start, uint32_t count, const void* data);
         void MapReadAsync(DawnBufferMapReadCallback callback, void* userdata);
         void MapWriteAsync(DawnBufferMapWriteCallback callback, void* userdata);
+        void MapReadRangeAsync(uint64_t offset,
+                               uint64_t size,
+                               DawnBufferMapReadCallback callback,
+                               void* userdata);
+        void MapWriteRangeAsync(uint64_t offset,
+                                uint64_t size,
+                                DawnBufferMapWriteCallback callback,
+                                void* userdata);
         void Unmap();
         void Destroy();
 
@@ -79,18 +94,26 @@ namespace dawn_native {
         void DestroyInternal();
 
       private:
+        // Deleting the buffer is deferred to the next tick with the defer_object_deletion toggle.
+        void DeleteThis() override;
+
         virtual MaybeError MapAtCreationImpl(uint8_t** mappedPointer) = 0;
         virtual MaybeError SetSubDataImpl(uint32_t start, uint32_t count, const void* data);
-        virtual MaybeError MapReadAsyncImpl(uint32_t serial) = 0;
-        virtual MaybeError MapWriteAsyncImpl(uint32_t serial) = 0;
+        // Map the [offset, offset + size) range of the buffer. The range has already been
+        // validated and the callback must be called with a pointer to the start of the range.
+        virtual MaybeError MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) = 0;
+        virtual MaybeError MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) = 0;
         virtual void UnmapImpl() = 0;
         virtual void DestroyImpl() = 0;
 
         virtual bool IsMapWritable() const = 0;
         MaybeError CopyFromStagingBuffer();
+        MaybeError ClearData();
 
         MaybeError ValidateSetSubData(uint32_t start, uint32_t count) const;
-        MaybeError ValidateMap(dawn::BufferUsage requiredUsage) const;
+        MaybeError ValidateMap(dawn::BufferUsage requiredUsage,
+                               uint64_t offset,
+                               uint64_t size) const;
         MaybeError ValidateUnmap() const;
         MaybeError ValidateDestroy() const;
 
@@ -105,6 +128,7 @@ namespace dawn_native {
         std::unique_ptr<StagingBufferBase> mStagingBuffer;
 
         BufferState mState;
+        bool mIsDataInitialized = false;
     };
 
 }  // namespace dawn_native
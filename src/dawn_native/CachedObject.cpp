@@ -0,0 +1,38 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/CachedObject.h"
+
+#include "common/Assert.h"
+
+namespace dawn_native {
+
+    size_t CachedObject::GetContentHash() const {
+        return mContentHash;
+    }
+
+    bool CachedObject::IsCachedReference() const {
+        return mIsCachedReference;
+    }
+
+    void CachedObject::SetContentHash(size_t contentHash) {
+        mContentHash = contentHash;
+    }
+
+    void CachedObject::SetIsCachedReference() {
+        ASSERT(!mIsCachedReference);
+        mIsCachedReference = true;
+    }
+
+}  // namespace dawn_native
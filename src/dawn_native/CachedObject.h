@@ -0,0 +1,46 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_CACHEDOBJECT_H_
+#define DAWNNATIVE_CACHEDOBJECT_H_
+
+#include "dawn_native/ObjectBase.h"
+
+#include <cstddef>
+
+namespace dawn_native {
+
+    // Some objects are cached so that two objects created with the same content are the same
+    // object, see DeviceBase::GetOrCreateBindGroupLayout for example. CachedObject stores the
+    // hash of the content, which is computed once from the descriptor, and whether the object
+    // is in the cache and must be removed from it when it is destroyed.
+    class CachedObject : public ObjectBase {
+      public:
+        using ObjectBase::ObjectBase;
+
+        size_t GetContentHash() const;
+        bool IsCachedReference() const;
+
+      private:
+        friend class DeviceBase;
+        void SetContentHash(size_t contentHash);
+        void SetIsCachedReference();
+
+        size_t mContentHash = 0;
+        bool mIsCachedReference = false;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_CACHEDOBJECT_H_
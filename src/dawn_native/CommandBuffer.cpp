@@ -15,6 +15,7 @@
 #include "dawn_native/CommandBuffer.h"
 
 #include "dawn_native/CommandEncoder.h"
+#include "dawn_native/Device.h"
 #include "dawn_native/Texture.h"
 
 namespace dawn_native {
@@ -33,6 +34,17 @@ namespace dawn_native {
         return new CommandBufferBase(device, ObjectBase::kError);
     }
 
+    void CommandBufferBase::DeleteThis() {
+        if (IsError()) {
+            ObjectBase::DeleteThis();
+            return;
+        }
+
+        DeviceBase* device = GetDevice();
+        this->~CommandBufferBase();
+        device->GetCommandBufferAllocator()->Deallocate(this);
+    }
+
     const CommandBufferResourceUsage& CommandBufferBase::GetResourceUsages() const {
         return mResourceUsages;
     }
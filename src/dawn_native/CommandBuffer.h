@@ -33,6 +33,10 @@ namespace dawn_native {
       private:
         CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        // Command buffers other than error ones are allocated in the command buffer allocator of
+        // their device.
+        void DeleteThis() override;
+
         CommandBufferResourceUsage mResourceUsages;
     };
     bool IsCompleteSubresourceCopiedTo(const TextureBase* texture,
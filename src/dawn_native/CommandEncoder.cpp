@@ -29,55 +29,13 @@
 #include "dawn_native/RenderPipeline.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
+#include <algorithm>
 #include <map>
 
 namespace dawn_native {
 
     namespace {
 
-        MaybeError ValidateCopySizeFitsInTexture(const TextureCopy& textureCopy,
-                                                 const Extent3D& copySize) {
-            const TextureBase* texture = textureCopy.texture.Get();
-            if (textureCopy.mipLevel >= texture->GetNumMipLevels()) {
-                return DAWN_VALIDATION_ERROR("Copy mipLevel out of range");
-            }
-
-            if (textureCopy.arrayLayer >= texture->GetArrayLayers()) {
-                return DAWN_VALIDATION_ERROR("Copy arrayLayer out of range");
-            }
-
-            Extent3D extent = texture->GetMipLevelPhysicalSize(textureCopy.mipLevel);
-
-            // All texture dimensions are in uint32_t so by doing checks in uint64_t we avoid
-            // overflows.
-            if (uint64_t(textureCopy.origin.x) + uint64_t(copySize.width) >
-                    static_cast<uint64_t>(extent.width) ||
-                uint64_t(textureCopy.origin.y) + uint64_t(copySize.height) >
-                    static_cast<uint64_t>(extent.height)) {
-                return DAWN_VALIDATION_ERROR("Copy would touch outside of the texture");
-            }
-
-            // TODO(cwallez@chromium.org): Check the depth bound differently for 2D arrays and 3D
-            // textures
-            if (textureCopy.origin.z != 0 || copySize.depth > 1) {
-                return DAWN_VALIDATION_ERROR("No support for z != 0 and depth > 1 for now");
-            }
-
-            return {};
-        }
-
-        MaybeError ValidateCopySizeFitsInBuffer(const Ref<BufferBase>& buffer,
-                                                uint64_t offset,
-                                                uint64_t size) {
-            uint64_t bufferSize = buffer->GetSize();
-            bool fitsInBuffer = offset <= bufferSize && (size <= (bufferSize - offset));
-            if (!fitsInBuffer) {
-                return DAWN_VALIDATION_ERROR("Copy would overflow the buffer");
-            }
-
-            return {};
-        }
-
         MaybeError ValidateCopySizeFitsInBuffer(const BufferCopy& bufferCopy, uint64_t dataSize) {
             return ValidateCopySizeFitsInBuffer(bufferCopy.buffer, bufferCopy.offset, dataSize);
         }
@@ -108,29 +66,6 @@ namespace dawn_native {
             return {};
         }
 
-        MaybeError ValidateImageHeight(const Format& format,
-                                       uint32_t imageHeight,
-                                       uint32_t copyHeight) {
-            if (imageHeight < copyHeight) {
-                return DAWN_VALIDATION_ERROR("Image height must not be less than the copy height.");
-            }
-
-            if (imageHeight % format.blockHeight != 0) {
-                return DAWN_VALIDATION_ERROR(
-                    "Image height must be a multiple of compressed texture format block width");
-            }
-
-            return {};
-        }
-
-        MaybeError ValidateTextureSampleCountInCopyCommands(const TextureBase* texture) {
-            if (texture->GetSampleCount() > 1) {
-                return DAWN_VALIDATION_ERROR("The sample count of textures must be 1");
-            }
-
-            return {};
-        }
-
         MaybeError ValidateEntireSubresourceCopied(const TextureCopy& src,
                                                    const TextureCopy& dst,
                                                    const Extent3D& copySize) {
@@ -176,90 +111,6 @@ namespace dawn_native {
             return {};
         }
 
-        MaybeError ComputeTextureCopyBufferSize(const Format& textureFormat,
-                                                const Extent3D& copySize,
-                                                uint32_t rowPitch,
-                                                uint32_t imageHeight,
-                                                uint32_t* bufferSize) {
-            ASSERT(imageHeight >= copySize.height);
-            uint32_t blockByteSize = textureFormat.blockByteSize;
-            uint32_t blockWidth = textureFormat.blockWidth;
-            uint32_t blockHeight = textureFormat.blockHeight;
-
-            // TODO(cwallez@chromium.org): check for overflows
-            uint32_t slicePitch = rowPitch * imageHeight / blockWidth;
-            uint32_t sliceSize = rowPitch * (copySize.height / blockHeight - 1) +
-                                 (copySize.width / blockWidth) * blockByteSize;
-            *bufferSize = (slicePitch * (copySize.depth - 1)) + sliceSize;
-
-            return {};
-        }
-
-        uint32_t ComputeDefaultRowPitch(const Format& format, uint32_t width) {
-            return width / format.blockWidth * format.blockByteSize;
-        }
-
-        MaybeError ValidateRowPitch(const Format& format,
-                                    const Extent3D& copySize,
-                                    uint32_t rowPitch) {
-            if (rowPitch % kTextureRowPitchAlignment != 0) {
-                return DAWN_VALIDATION_ERROR("Row pitch must be a multiple of 256");
-            }
-
-            if (rowPitch < copySize.width / format.blockWidth * format.blockByteSize) {
-                return DAWN_VALIDATION_ERROR(
-                    "Row pitch must not be less than the number of bytes per row");
-            }
-
-            return {};
-        }
-
-        MaybeError ValidateImageOrigin(const Format& format, const Origin3D& offset) {
-            if (offset.x % format.blockWidth != 0) {
-                return DAWN_VALIDATION_ERROR(
-                    "Offset.x must be a multiple of compressed texture format block width");
-            }
-
-            if (offset.y % format.blockHeight != 0) {
-                return DAWN_VALIDATION_ERROR(
-                    "Offset.y must be a multiple of compressed texture format block height");
-            }
-
-            return {};
-        }
-
-        MaybeError ValidateImageCopySize(const Format& format, const Extent3D& extent) {
-            if (extent.width % format.blockWidth != 0) {
-                return DAWN_VALIDATION_ERROR(
-                    "Extent.width must be a multiple of compressed texture format block width");
-            }
-
-            if (extent.height % format.blockHeight != 0) {
-                return DAWN_VALIDATION_ERROR(
-                    "Extent.height must be a multiple of compressed texture format block height");
-            }
-
-            return {};
-        }
-
-        MaybeError ValidateCanUseAs(BufferBase* buffer, dawn::BufferUsage usage) {
-            ASSERT(HasZeroOrOneBits(usage));
-            if (!(buffer->GetUsage() & usage)) {
-                return DAWN_VALIDATION_ERROR("buffer doesn't have the required usage.");
-            }
-
-            return {};
-        }
-
-        MaybeError ValidateCanUseAs(TextureBase* texture, dawn::TextureUsage usage) {
-            ASSERT(HasZeroOrOneBits(usage));
-            if (!(texture->GetUsage() & usage)) {
-                return DAWN_VALIDATION_ERROR("texture doesn't have the required usage.");
-            }
-
-            return {};
-        }
-
         MaybeError ValidateAttachmentArrayLayersAndLevelCount(const TextureViewBase* attachment) {
             // Currently we do not support layered rendering.
             if (attachment->GetLayerCount() > 1) {
@@ -455,12 +306,67 @@ namespace dawn_native {
             return {};
         }
 
+        // Returns whether |buffer| is used by the commands already tracked in |usages|.
+        bool IsBufferUsed(const CommandBufferResourceUsage& usages, BufferBase* buffer) {
+            if (usages.topLevelBuffers.count(buffer) != 0) {
+                return true;
+            }
+            for (const PassResourceUsage& passUsages : usages.perPass) {
+                if (std::find(passUsages.buffers.begin(), passUsages.buffers.end(), buffer) !=
+                    passUsages.buffers.end()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Tracks a copy writing |size| bytes at |offset| in |buffer|. A copy writing the whole
+        // buffer before any other use of it in the command buffer initializes its content.
+        void TrackCopyDestinationBuffer(CommandBufferResourceUsage* usages,
+                                        BufferBase* buffer,
+                                        uint64_t offset,
+                                        uint64_t size) {
+            if (offset == 0 && size == buffer->GetSize() && !IsBufferUsed(*usages, buffer)) {
+                usages->fullyOverwrittenBuffers.insert(buffer);
+            }
+            usages->topLevelBuffers.insert(buffer);
+        }
+
+        // Returns the number of bytes written by a texture to buffer copy, or 0 when there are
+        // gaps between the rows or the images that the copy doesn't write.
+        uint64_t ComputeContiguousCopySize(const Format& format,
+                                           const Extent3D& copySize,
+                                           uint32_t rowPitch,
+                                           uint32_t imageHeight) {
+            if (rowPitch != ComputeDefaultRowPitch(format, copySize.width) ||
+                (copySize.depth > 1 && imageHeight != copySize.height)) {
+                return 0;
+            }
+            return uint64_t(rowPitch) * (copySize.height / format.blockHeight) * copySize.depth;
+        }
+
+        void TrackTextureToBufferCopy(CommandBufferResourceUsage* usages,
+                                      CopyTextureToBufferCmd* copy) {
+            usages->topLevelTextures.insert(copy->source.texture.Get());
+            uint64_t writtenSize = ComputeContiguousCopySize(
+                copy->source.texture->GetFormat(), copy->copySize, copy->destination.rowPitch,
+                copy->destination.imageHeight);
+            TrackCopyDestinationBuffer(usages, copy->destination.buffer.Get(),
+                                       copy->destination.offset, writtenSize);
+        }
+
     }  // namespace
 
     CommandEncoderBase::CommandEncoderBase(DeviceBase* device, const CommandEncoderDescriptor*)
         : ObjectBase(device), mEncodingContext(device, this) {
     }
 
+    void CommandEncoderBase::DeleteThis() {
+        DeviceBase* device = GetDevice();
+        this->~CommandEncoderBase();
+        device->GetCommandEncoderAllocator()->Deallocate(this);
+    }
+
     CommandBufferResourceUsage CommandEncoderBase::AcquireResourceUsages() {
         ASSERT(!mWereResourceUsagesAcquired);
         mWereResourceUsagesAcquired = true;
@@ -479,7 +385,9 @@ namespace dawn_native {
 
         bool success =
             mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-                DAWN_TRY(ValidateComputePassDescriptor(device, descriptor));
+                if (device->IsValidationEnabled()) {
+                    DAWN_TRY(ValidateComputePassDescriptor(device, descriptor));
+                }
 
                 allocator->Allocate<BeginComputePassCmd>(Command::BeginComputePass);
 
@@ -488,7 +396,8 @@ namespace dawn_native {
 
         if (success) {
             ComputePassEncoderBase* passEncoder =
-                new ComputePassEncoderBase(device, this, &mEncodingContext);
+                device->GetComputePassEncoderAllocator()->New<ComputePassEncoderBase>(
+                    device, this, &mEncodingContext);
             mEncodingContext.EnterPass(passEncoder);
             return passEncoder;
         }
@@ -551,7 +460,8 @@ namespace dawn_native {
 
         if (success) {
             RenderPassEncoderBase* passEncoder =
-                new RenderPassEncoderBase(device, this, &mEncodingContext);
+                device->GetRenderPassEncoderAllocator()->New<RenderPassEncoderBase>(
+                    device, this, &mEncodingContext);
             mEncodingContext.EnterPass(passEncoder);
             return passEncoder;
         }
@@ -692,6 +602,11 @@ namespace dawn_native {
         CommandIterator* commands = mEncodingContext.GetIterator();
         commands->Reset();
 
+        if (!GetDevice()->IsValidationEnabled()) {
+            TrackResourceUsages(commands);
+            return {};
+        }
+
         Command type;
         while (commands->NextCommandId(&type)) {
             switch (type) {
@@ -719,7 +634,8 @@ namespace dawn_native {
                     DAWN_TRY(ValidateCanUseAs(copy->destination.Get(), dawn::BufferUsage::CopyDst));
 
                     mResourceUsages.topLevelBuffers.insert(copy->source.Get());
-                    mResourceUsages.topLevelBuffers.insert(copy->destination.Get());
+                    TrackCopyDestinationBuffer(&mResourceUsages, copy->destination.Get(),
+                                               copy->destinationOffset, copy->size);
                 } break;
 
                 case Command::CopyBufferToTexture: {
@@ -788,8 +704,7 @@ namespace dawn_native {
                     DAWN_TRY(ValidateCanUseAs(copy->destination.buffer.Get(),
                                               dawn::BufferUsage::CopyDst));
 
-                    mResourceUsages.topLevelTextures.insert(copy->source.texture.Get());
-                    mResourceUsages.topLevelBuffers.insert(copy->destination.buffer.Get());
+                    TrackTextureToBufferCopy(&mResourceUsages, copy);
                 } break;
 
                 case Command::CopyTextureToTexture: {
@@ -828,4 +743,50 @@ namespace dawn_native {
         return {};
     }
 
+    void CommandEncoderBase::TrackResourceUsages(CommandIterator* commands) {
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            switch (type) {
+                case Command::BeginComputePass: {
+                    commands->NextCommand<BeginComputePassCmd>();
+                    TrackComputePassResourceUsage(commands, &mResourceUsages.perPass);
+                } break;
+
+                case Command::BeginRenderPass: {
+                    BeginRenderPassCmd* cmd = commands->NextCommand<BeginRenderPassCmd>();
+                    TrackRenderPassResourceUsage(commands, cmd, &mResourceUsages.perPass);
+                } break;
+
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = commands->NextCommand<CopyBufferToBufferCmd>();
+                    mResourceUsages.topLevelBuffers.insert(copy->source.Get());
+                    TrackCopyDestinationBuffer(&mResourceUsages, copy->destination.Get(),
+                                               copy->destinationOffset, copy->size);
+                } break;
+
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* copy = commands->NextCommand<CopyBufferToTextureCmd>();
+                    mResourceUsages.topLevelBuffers.insert(copy->source.buffer.Get());
+                    mResourceUsages.topLevelTextures.insert(copy->destination.texture.Get());
+                } break;
+
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* copy = commands->NextCommand<CopyTextureToBufferCmd>();
+                    TrackTextureToBufferCopy(&mResourceUsages, copy);
+                } break;
+
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* copy =
+                        commands->NextCommand<CopyTextureToTextureCmd>();
+                    mResourceUsages.topLevelTextures.insert(copy->source.texture.Get());
+                    mResourceUsages.topLevelTextures.insert(copy->destination.texture.Get());
+                } break;
+
+                default:
+                    UNREACHABLE();
+                    break;
+            }
+        }
+    }
+
 }  // namespace dawn_native
@@ -55,7 +55,13 @@ namespace dawn_native {
         CommandBufferBase* Finish(const CommandBufferDescriptor* descriptor);
 
       private:
+        // Command encoders are allocated in the command encoder allocator of their device.
+        void DeleteThis() override;
+
         MaybeError ValidateFinish(const CommandBufferDescriptor* descriptor);
+        // Builds the resource usages without validating the commands, used instead of the checks
+        // by ValidateFinish when the skip_validation toggle is enabled.
+        void TrackResourceUsages(CommandIterator* commands);
 
         EncodingContext mEncodingContext;
 
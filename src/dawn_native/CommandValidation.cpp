@@ -16,11 +16,14 @@
 
 #include "common/BitSetIterator.h"
 #include "dawn_native/BindGroup.h"
+#include "dawn_native/Buffer.h"
 #include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/Format.h"
 #include "dawn_native/PassResourceUsageTracker.h"
 #include "dawn_native/RenderBundle.h"
 #include "dawn_native/RenderPipeline.h"
+#include "dawn_native/Texture.h"
 
 namespace dawn_native {
 
@@ -68,8 +71,8 @@ namespace dawn_native {
                     } break;
 
                     case dawn::BindingType::SampledTexture: {
-                        TextureBase* texture = group->GetBindingAsTextureView(i)->GetTexture();
-                        usageTracker->TextureUsedAs(texture, dawn::TextureUsage::Sampled);
+                        usageTracker->TextureViewUsedAs(group->GetBindingAsTextureView(i),
+                                                        dawn::TextureUsage::Sampled);
                     } break;
 
                     case dawn::BindingType::Sampler:
@@ -83,6 +86,100 @@ namespace dawn_native {
             }
         }
 
+        void TrackRenderPassAttachmentsResourceUsage(BeginRenderPassCmd* renderPass,
+                                                     PassResourceUsageTracker* usageTracker) {
+            for (uint32_t i :
+                 IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
+                RenderPassColorAttachmentInfo* colorAttachment = &renderPass->colorAttachments[i];
+                usageTracker->TextureViewUsedAs(colorAttachment->view.Get(),
+                                                dawn::TextureUsage::OutputAttachment);
+
+                TextureViewBase* resolveTarget = colorAttachment->resolveTarget.Get();
+                if (resolveTarget != nullptr) {
+                    usageTracker->TextureViewUsedAs(resolveTarget,
+                                                    dawn::TextureUsage::OutputAttachment);
+                }
+            }
+
+            if (renderPass->attachmentState->HasDepthStencilAttachment()) {
+                usageTracker->TextureViewUsedAs(renderPass->depthStencilAttachment.view.Get(),
+                                                dawn::TextureUsage::OutputAttachment);
+            }
+        }
+
+        void TrackExecutedBundleResourceUsage(RenderBundleBase* bundle,
+                                              PassResourceUsageTracker* usageTracker) {
+            const PassResourceUsage& usages = bundle->GetResourceUsage();
+            for (uint32_t i = 0; i < usages.buffers.size(); ++i) {
+                usageTracker->BufferUsedAs(usages.buffers[i], usages.bufferUsages[i]);
+            }
+
+            for (uint32_t i = 0; i < usages.textures.size(); ++i) {
+                usageTracker->AddTextureUsage(usages.textures[i], usages.textureUsages[i]);
+            }
+        }
+
+        // Records the resource usages of a command of a pass or a render bundle, without
+        // validating it. Commands that don't use resources are skipped.
+        void TrackCommandResourceUsage(CommandIterator* commands,
+                                       Command type,
+                                       PassResourceUsageTracker* usageTracker) {
+            switch (type) {
+                case Command::DispatchIndirect: {
+                    DispatchIndirectCmd* cmd = commands->NextCommand<DispatchIndirectCmd>();
+                    usageTracker->BufferUsedAs(cmd->indirectBuffer.Get(),
+                                               dawn::BufferUsage::Indirect);
+                } break;
+
+                case Command::DrawIndirect: {
+                    DrawIndirectCmd* cmd = commands->NextCommand<DrawIndirectCmd>();
+                    usageTracker->BufferUsedAs(cmd->indirectBuffer.Get(),
+                                               dawn::BufferUsage::Indirect);
+                } break;
+
+                case Command::DrawIndexedIndirect: {
+                    DrawIndexedIndirectCmd* cmd = commands->NextCommand<DrawIndexedIndirectCmd>();
+                    usageTracker->BufferUsedAs(cmd->indirectBuffer.Get(),
+                                               dawn::BufferUsage::Indirect);
+                } break;
+
+                case Command::ExecuteBundles: {
+                    ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+                    auto bundles = commands->NextData<Ref<RenderBundleBase>>(cmd->count);
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        TrackExecutedBundleResourceUsage(bundles[i].Get(), usageTracker);
+                    }
+                } break;
+
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                    if (cmd->dynamicOffsetCount > 0) {
+                        commands->NextData<uint64_t>(cmd->dynamicOffsetCount);
+                    }
+                    TrackBindGroupResourceUsage(cmd->group.Get(), usageTracker);
+                } break;
+
+                case Command::SetIndexBuffer: {
+                    SetIndexBufferCmd* cmd = commands->NextCommand<SetIndexBufferCmd>();
+                    usageTracker->BufferUsedAs(cmd->buffer.Get(), dawn::BufferUsage::Index);
+                } break;
+
+                case Command::SetVertexBuffers: {
+                    SetVertexBuffersCmd* cmd = commands->NextCommand<SetVertexBuffersCmd>();
+                    auto buffers = commands->NextData<Ref<BufferBase>>(cmd->count);
+                    commands->NextData<uint64_t>(cmd->count);
+
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        usageTracker->BufferUsedAs(buffers[i].Get(), dawn::BufferUsage::Vertex);
+                    }
+                } break;
+
+                default:
+                    SkipCommand(commands, type);
+                    break;
+            }
+        }
+
         inline MaybeError ValidateRenderBundleCommand(CommandIterator* commands,
                                                       Command type,
                                                       PassResourceUsageTracker* usageTracker,
@@ -208,22 +305,7 @@ namespace dawn_native {
         unsigned int debugGroupStackSize = 0;
 
         // Track usage of the render pass attachments
-        for (uint32_t i : IterateBitSet(renderPass->attachmentState->GetColorAttachmentsMask())) {
-            RenderPassColorAttachmentInfo* colorAttachment = &renderPass->colorAttachments[i];
-            TextureBase* texture = colorAttachment->view->GetTexture();
-            usageTracker.TextureUsedAs(texture, dawn::TextureUsage::OutputAttachment);
-
-            TextureViewBase* resolveTarget = colorAttachment->resolveTarget.Get();
-            if (resolveTarget != nullptr) {
-                usageTracker.TextureUsedAs(resolveTarget->GetTexture(),
-                                           dawn::TextureUsage::OutputAttachment);
-            }
-        }
-
-        if (renderPass->attachmentState->HasDepthStencilAttachment()) {
-            TextureBase* texture = renderPass->depthStencilAttachment.view->GetTexture();
-            usageTracker.TextureUsedAs(texture, dawn::TextureUsage::OutputAttachment);
-        }
+        TrackRenderPassAttachmentsResourceUsage(renderPass, &usageTracker);
 
         Command type;
         while (commands->NextCommandId(&type)) {
@@ -250,14 +332,7 @@ namespace dawn_native {
                                 "Render bundle is not compatible with render pass");
                         }
 
-                        const PassResourceUsage& usages = bundles[i]->GetResourceUsage();
-                        for (uint32_t i = 0; i < usages.buffers.size(); ++i) {
-                            usageTracker.BufferUsedAs(usages.buffers[i], usages.bufferUsages[i]);
-                        }
-
-                        for (uint32_t i = 0; i < usages.textures.size(); ++i) {
-                            usageTracker.TextureUsedAs(usages.textures[i], usages.textureUsages[i]);
-                        }
+                        TrackExecutedBundleResourceUsage(bundles[i].Get(), &usageTracker);
                     }
 
                     if (cmd->count > 0) {
@@ -368,4 +443,209 @@ namespace dawn_native {
         return DAWN_VALIDATION_ERROR("Unfinished compute pass");
     }
 
+    void TrackRenderBundleResourceUsage(CommandIterator* commands,
+                                        PassResourceUsage* resourceUsage) {
+        PassResourceUsageTracker usageTracker;
+
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            TrackCommandResourceUsage(commands, type, &usageTracker);
+        }
+
+        ASSERT(resourceUsage != nullptr);
+        *resourceUsage = usageTracker.AcquireResourceUsage();
+    }
+
+    void TrackRenderPassResourceUsage(CommandIterator* commands,
+                                      BeginRenderPassCmd* renderPass,
+                                      std::vector<PassResourceUsage>* perPassResourceUsages) {
+        PassResourceUsageTracker usageTracker;
+        TrackRenderPassAttachmentsResourceUsage(renderPass, &usageTracker);
+
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            if (type == Command::EndRenderPass) {
+                commands->NextCommand<EndRenderPassCmd>();
+                ASSERT(perPassResourceUsages != nullptr);
+                perPassResourceUsages->push_back(usageTracker.AcquireResourceUsage());
+                return;
+            }
+            TrackCommandResourceUsage(commands, type, &usageTracker);
+        }
+
+        UNREACHABLE();
+    }
+
+    void TrackComputePassResourceUsage(CommandIterator* commands,
+                                       std::vector<PassResourceUsage>* perPassResourceUsages) {
+        PassResourceUsageTracker usageTracker;
+
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            if (type == Command::EndComputePass) {
+                commands->NextCommand<EndComputePassCmd>();
+                ASSERT(perPassResourceUsages != nullptr);
+                perPassResourceUsages->push_back(usageTracker.AcquireResourceUsage());
+                return;
+            }
+            TrackCommandResourceUsage(commands, type, &usageTracker);
+        }
+
+        UNREACHABLE();
+    }
+
+    MaybeError ValidateCopySizeFitsInTexture(const TextureCopy& textureCopy,
+                                             const Extent3D& copySize) {
+        const TextureBase* texture = textureCopy.texture.Get();
+        if (textureCopy.mipLevel >= texture->GetNumMipLevels()) {
+            return DAWN_VALIDATION_ERROR("Copy mipLevel out of range");
+        }
+
+        if (textureCopy.arrayLayer >= texture->GetArrayLayers()) {
+            return DAWN_VALIDATION_ERROR("Copy arrayLayer out of range");
+        }
+
+        Extent3D extent = texture->GetMipLevelPhysicalSize(textureCopy.mipLevel);
+
+        // All texture dimensions are in uint32_t so by doing checks in uint64_t we avoid
+        // overflows.
+        if (uint64_t(textureCopy.origin.x) + uint64_t(copySize.width) >
+                static_cast<uint64_t>(extent.width) ||
+            uint64_t(textureCopy.origin.y) + uint64_t(copySize.height) >
+                static_cast<uint64_t>(extent.height)) {
+            return DAWN_VALIDATION_ERROR("Copy would touch outside of the texture");
+        }
+
+        // TODO(cwallez@chromium.org): Check the depth bound differently for 2D arrays and 3D
+        // textures
+        if (textureCopy.origin.z != 0 || copySize.depth > 1) {
+            return DAWN_VALIDATION_ERROR("No support for z != 0 and depth > 1 for now");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateCopySizeFitsInBuffer(const Ref<BufferBase>& buffer,
+                                            uint64_t offset,
+                                            uint64_t size) {
+        uint64_t bufferSize = buffer->GetSize();
+        bool fitsInBuffer = offset <= bufferSize && (size <= (bufferSize - offset));
+        if (!fitsInBuffer) {
+            return DAWN_VALIDATION_ERROR("Copy would overflow the buffer");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateImageHeight(const Format& format,
+                                   uint32_t imageHeight,
+                                   uint32_t copyHeight) {
+        if (imageHeight < copyHeight) {
+            return DAWN_VALIDATION_ERROR("Image height must not be less than the copy height.");
+        }
+
+        if (imageHeight % format.blockHeight != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Image height must be a multiple of compressed texture format block width");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateTextureSampleCountInCopyCommands(const TextureBase* texture) {
+        if (texture->GetSampleCount() > 1) {
+            return DAWN_VALIDATION_ERROR("The sample count of textures must be 1");
+        }
+
+        return {};
+    }
+
+    MaybeError ComputeTextureCopyBufferSize(const Format& textureFormat,
+                                            const Extent3D& copySize,
+                                            uint32_t rowPitch,
+                                            uint32_t imageHeight,
+                                            uint32_t* bufferSize) {
+        ASSERT(imageHeight >= copySize.height);
+        uint32_t blockByteSize = textureFormat.blockByteSize;
+        uint32_t blockWidth = textureFormat.blockWidth;
+        uint32_t blockHeight = textureFormat.blockHeight;
+
+        // TODO(cwallez@chromium.org): check for overflows
+        uint32_t slicePitch = rowPitch * imageHeight / blockWidth;
+        uint32_t sliceSize = rowPitch * (copySize.height / blockHeight - 1) +
+                             (copySize.width / blockWidth) * blockByteSize;
+        *bufferSize = (slicePitch * (copySize.depth - 1)) + sliceSize;
+
+        return {};
+    }
+
+    uint32_t ComputeDefaultRowPitch(const Format& format, uint32_t width) {
+        return width / format.blockWidth * format.blockByteSize;
+    }
+
+    MaybeError ValidateRowPitch(const Format& format,
+                                const Extent3D& copySize,
+                                uint32_t rowPitch) {
+        // The row pitch doesn't need to be aligned to kTextureRowPitchAlignment so that tightly
+        // packed data can be copied directly. The backends that require aligned row pitches
+        // repack the rows.
+        if (rowPitch % format.blockByteSize != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Row pitch must be a multiple of the texel or block size");
+        }
+
+        if (rowPitch < copySize.width / format.blockWidth * format.blockByteSize) {
+            return DAWN_VALIDATION_ERROR(
+                "Row pitch must not be less than the number of bytes per row");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateImageOrigin(const Format& format, const Origin3D& offset) {
+        if (offset.x % format.blockWidth != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Offset.x must be a multiple of compressed texture format block width");
+        }
+
+        if (offset.y % format.blockHeight != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Offset.y must be a multiple of compressed texture format block height");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateImageCopySize(const Format& format, const Extent3D& extent) {
+        if (extent.width % format.blockWidth != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Extent.width must be a multiple of compressed texture format block width");
+        }
+
+        if (extent.height % format.blockHeight != 0) {
+            return DAWN_VALIDATION_ERROR(
+                "Extent.height must be a multiple of compressed texture format block height");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateCanUseAs(BufferBase* buffer, dawn::BufferUsage usage) {
+        ASSERT(HasZeroOrOneBits(usage));
+        if (!(buffer->GetUsage() & usage)) {
+            return DAWN_VALIDATION_ERROR("buffer doesn't have the required usage.");
+        }
+
+        return {};
+    }
+
+    MaybeError ValidateCanUseAs(TextureBase* texture, dawn::TextureUsage usage) {
+        ASSERT(HasZeroOrOneBits(usage));
+        if (!(texture->GetUsage() & usage)) {
+            return DAWN_VALIDATION_ERROR("texture doesn't have the required usage.");
+        }
+
+        return {};
+    }
+
 }  // namespace dawn_native
@@ -17,14 +17,21 @@
 
 #include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Error.h"
+#include "dawn_native/RefCounted.h"
+
+#include "dawn_native/dawn_platform.h"
 
 #include <vector>
 
 namespace dawn_native {
 
     class AttachmentState;
+    class BufferBase;
+    class TextureBase;
     struct BeginRenderPassCmd;
+    struct Format;
     struct PassResourceUsage;
+    struct TextureCopy;
 
     MaybeError ValidateRenderBundle(CommandIterator* commands,
                                     const AttachmentState* attachmentState,
@@ -35,6 +42,37 @@ namespace dawn_native {
     MaybeError ValidateComputePass(CommandIterator* commands,
                                    std::vector<PassResourceUsage>* perPassResourceUsages);
 
+    // Record the resource usages of the commands like the validation functions above, but without
+    // validating them. Used when the skip_validation toggle is enabled.
+    void TrackRenderBundleResourceUsage(CommandIterator* commands,
+                                        PassResourceUsage* resourceUsage);
+    void TrackRenderPassResourceUsage(CommandIterator* commands,
+                                      BeginRenderPassCmd* renderPass,
+                                      std::vector<PassResourceUsage>* perPassResourceUsages);
+    void TrackComputePassResourceUsage(CommandIterator* commands,
+                                       std::vector<PassResourceUsage>* perPassResourceUsages);
+
+    // Validation of the copies between buffers, textures and client memory, shared by the copy
+    // commands and the queue write operations.
+    MaybeError ValidateCopySizeFitsInTexture(const TextureCopy& textureCopy,
+                                             const Extent3D& copySize);
+    MaybeError ValidateCopySizeFitsInBuffer(const Ref<BufferBase>& buffer,
+                                            uint64_t offset,
+                                            uint64_t size);
+    MaybeError ValidateImageHeight(const Format& format, uint32_t imageHeight, uint32_t copyHeight);
+    MaybeError ValidateTextureSampleCountInCopyCommands(const TextureBase* texture);
+    MaybeError ComputeTextureCopyBufferSize(const Format& textureFormat,
+                                            const Extent3D& copySize,
+                                            uint32_t rowPitch,
+                                            uint32_t imageHeight,
+                                            uint32_t* bufferSize);
+    uint32_t ComputeDefaultRowPitch(const Format& format, uint32_t width);
+    MaybeError ValidateRowPitch(const Format& format, const Extent3D& copySize, uint32_t rowPitch);
+    MaybeError ValidateImageOrigin(const Format& format, const Origin3D& offset);
+    MaybeError ValidateImageCopySize(const Format& format, const Extent3D& extent);
+    MaybeError ValidateCanUseAs(BufferBase* buffer, dawn::BufferUsage usage);
+    MaybeError ValidateCanUseAs(TextureBase* texture, dawn::TextureUsage usage);
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_COMMANDVALIDATION_H_
@@ -43,6 +43,17 @@ namespace dawn_native {
                                           ObjectBase::kError);
     }
 
+    void ComputePassEncoderBase::DeleteThis() {
+        if (IsError()) {
+            ProgrammablePassEncoder::DeleteThis();
+            return;
+        }
+
+        DeviceBase* device = GetDevice();
+        this->~ComputePassEncoderBase();
+        device->GetComputePassEncoderAllocator()->Deallocate(this);
+    }
+
     void ComputePassEncoderBase::EndPass() {
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
                 allocator->Allocate<EndComputePassCmd>(Command::EndComputePass);
@@ -67,11 +78,13 @@ namespace dawn_native {
     void ComputePassEncoderBase::DispatchIndirect(BufferBase* indirectBuffer,
                                                   uint64_t indirectOffset) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(GetDevice()->ValidateObject(indirectBuffer));
 
-            if (indirectOffset >= indirectBuffer->GetSize() ||
-                indirectOffset + kDispatchIndirectSize > indirectBuffer->GetSize()) {
-                return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                if (indirectOffset >= indirectBuffer->GetSize() ||
+                    indirectOffset + kDispatchIndirectSize > indirectBuffer->GetSize()) {
+                    return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
+                }
             }
 
             DispatchIndirectCmd* dispatch =
@@ -47,6 +47,10 @@ namespace dawn_native {
                                ErrorTag errorTag);
 
       private:
+        // Compute passes other than error ones are allocated in the compute pass encoder
+        // allocator of their device.
+        void DeleteThis() override;
+
         // For render and compute passes, the encoding context is borrowed from the command encoder.
         // Keep a reference to the encoder to make sure the context isn't freed.
         Ref<CommandEncoderBase> mCommandEncoder;
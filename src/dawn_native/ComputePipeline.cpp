@@ -34,12 +34,10 @@ namespace dawn_native {
     // ComputePipelineBase
 
     ComputePipelineBase::ComputePipelineBase(DeviceBase* device,
-                                             const ComputePipelineDescriptor* descriptor,
-                                             bool blueprint)
+                                             const ComputePipelineDescriptor* descriptor)
         : PipelineBase(device, descriptor->layout, dawn::ShaderStage::Compute),
           mModule(descriptor->computeStage.module),
-          mEntryPoint(descriptor->computeStage.entryPoint),
-          mIsBlueprint(blueprint) {
+          mEntryPoint(descriptor->computeStage.entryPoint) {
     }
 
     ComputePipelineBase::ComputePipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -47,8 +45,7 @@ namespace dawn_native {
     }
 
     ComputePipelineBase::~ComputePipelineBase() {
-        // Do not uncache the actual cached object if we are a blueprint
-        if (!mIsBlueprint && !IsError()) {
+        if (IsCachedReference()) {
             GetDevice()->UncacheComputePipeline(this);
         }
     }
@@ -58,16 +55,20 @@ namespace dawn_native {
         return new ComputePipelineBase(device, ObjectBase::kError);
     }
 
-    size_t ComputePipelineBase::HashFunc::operator()(const ComputePipelineBase* pipeline) const {
+    // static
+    size_t ComputePipelineBase::ComputeContentHash(const ComputePipelineDescriptor* descriptor) {
+        // The entry point isn't hashed so that lookups don't need to build a string from it, it
+        // is only compared when the hashes match.
         size_t hash = 0;
-        HashCombine(&hash, pipeline->mModule.Get(), pipeline->mEntryPoint, pipeline->GetLayout());
+        HashCombine(&hash, descriptor->computeStage.module, descriptor->layout);
         return hash;
     }
 
-    bool ComputePipelineBase::EqualityFunc::operator()(const ComputePipelineBase* a,
-                                                       const ComputePipelineBase* b) const {
-        return a->mModule.Get() == b->mModule.Get() && a->mEntryPoint == b->mEntryPoint &&
-               a->GetLayout() == b->GetLayout();
+    bool ComputePipelineBase::IsEqualToDescriptor(
+        const ComputePipelineDescriptor* descriptor) const {
+        return mModule.Get() == descriptor->computeStage.module &&
+               GetLayout() == descriptor->layout &&
+               mEntryPoint == descriptor->computeStage.entryPoint;
     }
 
 }  // namespace dawn_native
@@ -26,20 +26,14 @@ namespace dawn_native {
 
     class ComputePipelineBase : public PipelineBase {
       public:
-        ComputePipelineBase(DeviceBase* device,
-                            const ComputePipelineDescriptor* descriptor,
-                            bool blueprint = false);
+        ComputePipelineBase(DeviceBase* device, const ComputePipelineDescriptor* descriptor);
         ~ComputePipelineBase() override;
 
         static ComputePipelineBase* MakeError(DeviceBase* device);
 
-        // Functors necessary for the unordered_set<ComputePipelineBase*>-based cache.
-        struct HashFunc {
-            size_t operator()(const ComputePipelineBase* pipeline) const;
-        };
-        struct EqualityFunc {
-            bool operator()(const ComputePipelineBase* a, const ComputePipelineBase* b) const;
-        };
+        // Functions necessary for the descriptor-keyed cache in DeviceBase.
+        static size_t ComputeContentHash(const ComputePipelineDescriptor* descriptor);
+        bool IsEqualToDescriptor(const ComputePipelineDescriptor* descriptor) const;
 
       private:
         ComputePipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag);
@@ -47,7 +41,6 @@ namespace dawn_native {
         // TODO(cwallez@chromium.org): Store a crypto hash of the module instead.
         Ref<ShaderModuleBase> mModule;
         std::string mEntryPoint;
-        bool mIsBlueprint = false;
     };
 
 }  // namespace dawn_native
@@ -14,6 +14,7 @@
 
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/Fence.h"
 #include "dawn_native/Instance.h"
 #include "dawn_platform/DawnPlatform.h"
 
@@ -134,4 +135,18 @@ namespace dawn_native {
         return deviceBase->GetLazyClearCountForTesting();
     }
 
+    size_t GetBufferLazyClearCountForTesting(DawnDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetBufferLazyClearCountForTesting();
+    }
+
+    size_t GetRemovedCommandCountForTesting(DawnDevice device) {
+        dawn_native::DeviceBase* deviceBase = reinterpret_cast<dawn_native::DeviceBase*>(device);
+        return deviceBase->GetRemovedCommandCountForTesting();
+    }
+
+    bool WaitForFence(DawnFence fence, uint64_t value, uint64_t timeoutNs) {
+        return reinterpret_cast<FenceBase*>(fence)->Wait(value, timeoutNs);
+    }
+
 }  // namespace dawn_native
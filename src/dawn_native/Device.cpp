@@ -36,26 +36,127 @@
 #include "dawn_native/SwapChain.h"
 #include "dawn_native/Texture.h"
 
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace dawn_native {
 
     // DeviceBase::Caches
 
-    // The caches are unordered_sets of pointers with special hash and compare functions
-    // to compare the value of the objects, instead of the pointers.
+    // The caches of CachedObjects are keyed by the hash of the content of the objects so they can
+    // be looked up directly with a descriptor, the objects with the same hash are then compared
+    // with the descriptor. C++14 containers don't support looking up a key of a different type so
+    // this is a multimap instead of a set with special hash and compare functions.
     template <typename Object>
-    using ContentLessObjectCache =
-        std::unordered_set<Object*, typename Object::HashFunc, typename Object::EqualityFunc>;
+    class ContentLessObjectCache {
+      public:
+        template <typename Descriptor>
+        Object* Find(size_t hash, const Descriptor* descriptor) const {
+            auto range = mObjects.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second->IsEqualToDescriptor(descriptor)) {
+                    return it->second;
+                }
+            }
+            return nullptr;
+        }
+
+        void Insert(Object* object) {
+            mObjects.emplace(object->GetContentHash(), object);
+        }
+
+        size_t Erase(Object* object) {
+            auto range = mObjects.equal_range(object->GetContentHash());
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == object) {
+                    mObjects.erase(it);
+                    return 1;
+                }
+            }
+            return 0;
+        }
+
+        bool empty() const {
+            return mObjects.empty();
+        }
+
+      private:
+        std::unordered_multimap<size_t, Object*> mObjects;
+    };
+
+    // The deduplication caches hold a reference to their objects so that they stay alive even
+    // when the application doesn't have references to them. To bound the memory they keep alive,
+    // for example when the application releases buffers without destroying them, the caches are
+    // flushed when they grow too large.
+    static constexpr size_t kMaxDeduplicatedObjects = 4096;
+
+    template <typename Object>
+    class DeduplicationCache {
+      public:
+        template <typename... Key>
+        Object* Find(size_t hash, const Key*... key) {
+            auto range = mObjects.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second->IsEqualToDescriptor(key...)) {
+                    return it->second.Get();
+                }
+            }
+            return nullptr;
+        }
+
+        void Insert(size_t hash, Object* object) {
+            if (mObjects.size() >= kMaxDeduplicatedObjects) {
+                Clear();
+            }
+            mObjects.emplace(hash, object);
+        }
+
+        template <typename Predicate>
+        void EvictIf(Predicate predicate) {
+            for (auto it = mObjects.begin(); it != mObjects.end();) {
+                if (predicate(it->second.Get())) {
+                    it = mObjects.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void Clear() {
+            // Releasing an object can release the last reference to objects in other caches,
+            // never to objects of this cache, so the map can be cleared in place.
+            mObjects.clear();
+        }
+
+        bool empty() const {
+            return mObjects.empty();
+        }
+
+      private:
+        std::unordered_multimap<size_t, Ref<Object>> mObjects;
+    };
+
+    // Attachment states are cheap to build from descriptors so they are still looked up with a
+    // blueprint, in an unordered_set of pointers with special hash and compare functions to
+    // compare the value of the objects, instead of the pointers.
+    using AttachmentStateCache = std::unordered_set<AttachmentStateBlueprint*,
+                                                    AttachmentStateBlueprint::HashFunc,
+                                                    AttachmentStateBlueprint::EqualityFunc>;
 
     struct DeviceBase::Caches {
-        ContentLessObjectCache<AttachmentStateBlueprint> attachmentStates;
+        AttachmentStateCache attachmentStates;
         ContentLessObjectCache<BindGroupLayoutBase> bindGroupLayouts;
         ContentLessObjectCache<ComputePipelineBase> computePipelines;
         ContentLessObjectCache<PipelineLayoutBase> pipelineLayouts;
         ContentLessObjectCache<RenderPipelineBase> renderPipelines;
         ContentLessObjectCache<SamplerBase> samplers;
         ContentLessObjectCache<ShaderModuleBase> shaderModules;
+
+        DeduplicationCache<BindGroupBase> bindGroups;
+        DeduplicationCache<TextureViewBase> textureViews;
     };
 
     // DeviceBase
@@ -78,6 +179,7 @@ namespace dawn_native {
         // Devices must explicitly free the uploader
         ASSERT(mDynamicUploader == nullptr);
         ASSERT(mDeferredCreateBufferMappedAsyncResults.empty());
+        ASSERT(mDeferredDeletions.load() == nullptr);
 
         ASSERT(mCaches->attachmentStates.empty());
         ASSERT(mCaches->bindGroupLayouts.empty());
@@ -86,6 +188,8 @@ namespace dawn_native {
         ASSERT(mCaches->renderPipelines.empty());
         ASSERT(mCaches->samplers.empty());
         ASSERT(mCaches->shaderModules.empty());
+        ASSERT(mCaches->bindGroups.empty());
+        ASSERT(mCaches->textureViews.empty());
     }
 
     void DeviceBase::HandleError(dawn::ErrorType type, const char* message) {
@@ -111,6 +215,9 @@ namespace dawn_native {
     }
 
     MaybeError DeviceBase::ValidateObject(const ObjectBase* object) const {
+        if (!IsValidationEnabled()) {
+            return {};
+        }
         if (DAWN_UNLIKELY(object->GetDevice() != this)) {
             return DAWN_VALIDATION_ERROR("Object from a different device.");
         }
@@ -155,127 +262,139 @@ namespace dawn_native {
 
     ResultOrError<BindGroupLayoutBase*> DeviceBase::GetOrCreateBindGroupLayout(
         const BindGroupLayoutDescriptor* descriptor) {
-        BindGroupLayoutBase blueprint(this, descriptor, true);
+        size_t hash = BindGroupLayoutBase::ComputeContentHash(descriptor);
 
-        auto iter = mCaches->bindGroupLayouts.find(&blueprint);
-        if (iter != mCaches->bindGroupLayouts.end()) {
-            (*iter)->Reference();
-            return *iter;
+        BindGroupLayoutBase* cachedObj = mCaches->bindGroupLayouts.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
         }
 
         BindGroupLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateBindGroupLayoutImpl(descriptor));
-        mCaches->bindGroupLayouts.insert(backendObj);
+        backendObj->SetContentHash(hash);
+        backendObj->SetIsCachedReference();
+        mCaches->bindGroupLayouts.Insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncacheBindGroupLayout(BindGroupLayoutBase* obj) {
-        size_t removedCount = mCaches->bindGroupLayouts.erase(obj);
+        size_t removedCount = mCaches->bindGroupLayouts.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     ResultOrError<ComputePipelineBase*> DeviceBase::GetOrCreateComputePipeline(
         const ComputePipelineDescriptor* descriptor) {
-        ComputePipelineBase blueprint(this, descriptor, true);
+        size_t hash = ComputePipelineBase::ComputeContentHash(descriptor);
 
-        auto iter = mCaches->computePipelines.find(&blueprint);
-        if (iter != mCaches->computePipelines.end()) {
-            (*iter)->Reference();
-            return *iter;
+        ComputePipelineBase* cachedObj = mCaches->computePipelines.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
         }
 
         ComputePipelineBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateComputePipelineImpl(descriptor));
-        mCaches->computePipelines.insert(backendObj);
+        backendObj->SetContentHash(hash);
+        backendObj->SetIsCachedReference();
+        mCaches->computePipelines.Insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncacheComputePipeline(ComputePipelineBase* obj) {
-        size_t removedCount = mCaches->computePipelines.erase(obj);
+        size_t removedCount = mCaches->computePipelines.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     ResultOrError<PipelineLayoutBase*> DeviceBase::GetOrCreatePipelineLayout(
         const PipelineLayoutDescriptor* descriptor) {
-        PipelineLayoutBase blueprint(this, descriptor, true);
+        size_t hash = PipelineLayoutBase::ComputeContentHash(descriptor);
 
-        auto iter = mCaches->pipelineLayouts.find(&blueprint);
-        if (iter != mCaches->pipelineLayouts.end()) {
-            (*iter)->Reference();
-            return *iter;
+        PipelineLayoutBase* cachedObj = mCaches->pipelineLayouts.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
         }
 
         PipelineLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreatePipelineLayoutImpl(descriptor));
-        mCaches->pipelineLayouts.insert(backendObj);
+        backendObj->SetContentHash(hash);
+        backendObj->SetIsCachedReference();
+        mCaches->pipelineLayouts.Insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncachePipelineLayout(PipelineLayoutBase* obj) {
-        size_t removedCount = mCaches->pipelineLayouts.erase(obj);
+        size_t removedCount = mCaches->pipelineLayouts.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     ResultOrError<RenderPipelineBase*> DeviceBase::GetOrCreateRenderPipeline(
         const RenderPipelineDescriptor* descriptor) {
-        RenderPipelineBase blueprint(this, descriptor, true);
+        size_t hash = RenderPipelineBase::ComputeContentHash(descriptor);
 
-        auto iter = mCaches->renderPipelines.find(&blueprint);
-        if (iter != mCaches->renderPipelines.end()) {
-            (*iter)->Reference();
-            return *iter;
+        RenderPipelineBase* cachedObj = mCaches->renderPipelines.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
         }
 
         RenderPipelineBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateRenderPipelineImpl(descriptor));
-        mCaches->renderPipelines.insert(backendObj);
+        backendObj->SetContentHash(hash);
+        backendObj->SetIsCachedReference();
+        mCaches->renderPipelines.Insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncacheRenderPipeline(RenderPipelineBase* obj) {
-        size_t removedCount = mCaches->renderPipelines.erase(obj);
+        size_t removedCount = mCaches->renderPipelines.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     ResultOrError<SamplerBase*> DeviceBase::GetOrCreateSampler(
         const SamplerDescriptor* descriptor) {
-        SamplerBase blueprint(this, descriptor, true);
+        size_t hash = SamplerBase::ComputeContentHash(descriptor);
 
-        auto iter = mCaches->samplers.find(&blueprint);
-        if (iter != mCaches->samplers.end()) {
-            (*iter)->Reference();
-            return *iter;
+        SamplerBase* cachedObj = mCaches->samplers.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
         }
 
         SamplerBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateSamplerImpl(descriptor));
-        mCaches->samplers.insert(backendObj);
+        backendObj->SetContentHash(hash);
+        backendObj->SetIsCachedReference();
+        mCaches->samplers.Insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncacheSampler(SamplerBase* obj) {
-        size_t removedCount = mCaches->samplers.erase(obj);
+        size_t removedCount = mCaches->samplers.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
     ResultOrError<ShaderModuleBase*> DeviceBase::GetOrCreateShaderModule(
         const ShaderModuleDescriptor* descriptor) {
-        ShaderModuleBase blueprint(this, descriptor, true);
+        size_t hash = ShaderModuleBase::ComputeContentHash(descriptor);
 
-        auto iter = mCaches->shaderModules.find(&blueprint);
-        if (iter != mCaches->shaderModules.end()) {
-            (*iter)->Reference();
-            return *iter;
+        ShaderModuleBase* cachedObj = mCaches->shaderModules.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
         }
 
         ShaderModuleBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateShaderModuleImpl(descriptor));
-        mCaches->shaderModules.insert(backendObj);
+        backendObj->SetContentHash(hash);
+        backendObj->SetIsCachedReference();
+        mCaches->shaderModules.Insert(backendObj);
         return backendObj;
     }
 
     void DeviceBase::UncacheShaderModule(ShaderModuleBase* obj) {
-        size_t removedCount = mCaches->shaderModules.erase(obj);
+        size_t removedCount = mCaches->shaderModules.Erase(obj);
         ASSERT(removedCount == 1);
     }
 
@@ -315,6 +434,80 @@ namespace dawn_native {
         ASSERT(removedCount == 1);
     }
 
+    ResultOrError<BindGroupBase*> DeviceBase::GetOrCreateBindGroup(
+        const BindGroupDescriptor* descriptor) {
+        size_t hash = BindGroupBase::ComputeContentHash(descriptor);
+
+        BindGroupBase* cachedObj = mCaches->bindGroups.Find(hash, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
+        }
+
+        BindGroupBase* backendObj;
+        DAWN_TRY_ASSIGN(backendObj, CreateBindGroupImpl(descriptor));
+        mCaches->bindGroups.Insert(hash, backendObj);
+        return backendObj;
+    }
+
+    ResultOrError<TextureViewBase*> DeviceBase::GetOrCreateTextureView(
+        TextureBase* texture,
+        const TextureViewDescriptor* descriptor) {
+        size_t hash = TextureViewBase::ComputeContentHash(texture, descriptor);
+
+        TextureViewBase* cachedObj = mCaches->textureViews.Find(hash, texture, descriptor);
+        if (cachedObj != nullptr) {
+            cachedObj->Reference();
+            return cachedObj;
+        }
+
+        TextureViewBase* backendObj;
+        DAWN_TRY_ASSIGN(backendObj, CreateTextureViewImpl(texture, descriptor));
+        mCaches->textureViews.Insert(hash, backendObj);
+        return backendObj;
+    }
+
+    void DeviceBase::EvictDeduplicatedObjectsUsing(const BufferBase* buffer) {
+        mCaches->bindGroups.EvictIf(
+            [buffer](const BindGroupBase* bindGroup) { return bindGroup->UsesBuffer(buffer); });
+    }
+
+    void DeviceBase::EvictDeduplicatedObjectsUsing(const TextureBase* texture) {
+        // Bind groups are evicted first since they can hold the last references to the views.
+        mCaches->bindGroups.EvictIf(
+            [texture](const BindGroupBase* bindGroup) { return bindGroup->UsesTexture(texture); });
+        mCaches->textureViews.EvictIf(
+            [texture](const TextureViewBase* view) { return view->GetTexture() == texture; });
+    }
+
+    void DeviceBase::ClearDeduplicationCaches() {
+        // Bind groups are cleared first since they can hold the last references to the views.
+        mCaches->bindGroups.Clear();
+        mCaches->textureViews.Clear();
+    }
+
+    void DeviceBase::DeferDeletion(ObjectBase* object) {
+        ObjectBase* head = mDeferredDeletions.load(std::memory_order_relaxed);
+        do {
+            object->mNextDeferredDeletion = head;
+        } while (!mDeferredDeletions.compare_exchange_weak(head, object, std::memory_order_release,
+                                                           std::memory_order_relaxed));
+    }
+
+    void DeviceBase::DeleteDeferredObjects() {
+        // Deleting objects can release the last reference to other objects, for example the
+        // buffers of a bind group, so the list is taken again until it stays empty.
+        ObjectBase* object;
+        while ((object = mDeferredDeletions.exchange(nullptr, std::memory_order_acquire)) !=
+               nullptr) {
+            while (object != nullptr) {
+                ObjectBase* next = object->mNextDeferredDeletion;
+                object->DeleteThis();
+                object = next;
+            }
+        }
+    }
+
     // Object creation API methods
 
     BindGroupBase* DeviceBase::CreateBindGroup(const BindGroupDescriptor* descriptor) {
@@ -398,7 +591,7 @@ namespace dawn_native {
     }
     CommandEncoderBase* DeviceBase::CreateCommandEncoder(
         const CommandEncoderDescriptor* descriptor) {
-        return new CommandEncoderBase(this, descriptor);
+        return mCommandEncoderAllocator.New<CommandEncoderBase>(this, descriptor);
     }
     ComputePipelineBase* DeviceBase::CreateComputePipeline(
         const ComputePipelineDescriptor* descriptor) {
@@ -502,6 +695,7 @@ namespace dawn_native {
     // Other Device API methods
 
     void DeviceBase::Tick() {
+        DeleteDeferredObjects();
         TickImpl();
         {
             auto deferredResults = std::move(mDeferredCreateBufferMappedAsyncResults);
@@ -512,6 +706,34 @@ namespace dawn_native {
         mFenceSignalTracker->Tick(GetCompletedCommandSerial());
     }
 
+    bool DeviceBase::WaitForSerial(Serial serial, uint64_t timeoutNs) {
+        ASSERT(serial <= GetLastSubmittedCommandSerial());
+        if (GetCompletedCommandSerial() >= serial) {
+            return true;
+        }
+
+        // Clamp the timeout so that computing the deadline doesn't overflow.
+        constexpr uint64_t kMaxTimeoutNs = std::numeric_limits<int64_t>::max() / 2;
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() +
+            std::chrono::nanoseconds(std::min(timeoutNs, kMaxTimeoutNs));
+        return WaitForSerialImpl(serial, deadline);
+    }
+
+    bool DeviceBase::WaitForSerialImpl(Serial serial,
+                                       std::chrono::steady_clock::time_point deadline) {
+        while (true) {
+            TickImpl();
+            if (GetCompletedCommandSerial() >= serial) {
+                return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+
     void DeviceBase::Reference() {
         ASSERT(mRefCount != 0);
         mRefCount++;
@@ -566,6 +788,10 @@ namespace dawn_native {
         return mTogglesSet.IsEnabled(toggle);
     }
 
+    bool DeviceBase::IsValidationEnabled() const {
+        return !IsToggleEnabled(Toggle::SkipValidation);
+    }
+
     size_t DeviceBase::GetLazyClearCountForTesting() {
         return mLazyClearCountForTesting;
     }
@@ -574,6 +800,31 @@ namespace dawn_native {
         ++mLazyClearCountForTesting;
     }
 
+    size_t DeviceBase::GetBufferLazyClearCountForTesting() {
+        return mBufferLazyClearCountForTesting;
+    }
+
+    void DeviceBase::IncrementBufferLazyClearCountForTesting() {
+        ++mBufferLazyClearCountForTesting;
+    }
+
+    size_t DeviceBase::GetRemovedCommandCountForTesting() {
+        return mRemovedCommandCountForTesting;
+    }
+
+    void DeviceBase::IncrementRemovedCommandCountForTesting(size_t count) {
+        mRemovedCommandCountForTesting += count;
+    }
+
+    size_t DeviceBase::GetDeferredDeletionCountForTesting() const {
+        size_t count = 0;
+        for (ObjectBase* object = mDeferredDeletions.load(); object != nullptr;
+             object = object->mNextDeferredDeletion) {
+            count++;
+        }
+        return count;
+    }
+
     void DeviceBase::SetDefaultToggles() {
         // Sets the default-enabled toggles
         mTogglesSet.SetToggle(Toggle::LazyClearResourceOnFirstUse, true);
@@ -583,22 +834,32 @@ namespace dawn_native {
 
     MaybeError DeviceBase::CreateBindGroupInternal(BindGroupBase** result,
                                                    const BindGroupDescriptor* descriptor) {
-        DAWN_TRY(ValidateBindGroupDescriptor(this, descriptor));
-        DAWN_TRY_ASSIGN(*result, CreateBindGroupImpl(descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateBindGroupDescriptor(this, descriptor));
+        }
+        if (IsToggleEnabled(Toggle::DeduplicateBindGroupsAndTextureViews)) {
+            DAWN_TRY_ASSIGN(*result, GetOrCreateBindGroup(descriptor));
+        } else {
+            DAWN_TRY_ASSIGN(*result, CreateBindGroupImpl(descriptor));
+        }
         return {};
     }
 
     MaybeError DeviceBase::CreateBindGroupLayoutInternal(
         BindGroupLayoutBase** result,
         const BindGroupLayoutDescriptor* descriptor) {
-        DAWN_TRY(ValidateBindGroupLayoutDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateBindGroupLayoutDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, GetOrCreateBindGroupLayout(descriptor));
         return {};
     }
 
     MaybeError DeviceBase::CreateBufferInternal(BufferBase** result,
                                                 const BufferDescriptor* descriptor) {
-        DAWN_TRY(ValidateBufferDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateBufferDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, CreateBufferImpl(descriptor));
         return {};
     }
@@ -606,7 +867,9 @@ namespace dawn_native {
     MaybeError DeviceBase::CreateComputePipelineInternal(
         ComputePipelineBase** result,
         const ComputePipelineDescriptor* descriptor) {
-        DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, GetOrCreateComputePipeline(descriptor));
         return {};
     }
@@ -614,7 +877,9 @@ namespace dawn_native {
     MaybeError DeviceBase::CreatePipelineLayoutInternal(
         PipelineLayoutBase** result,
         const PipelineLayoutDescriptor* descriptor) {
-        DAWN_TRY(ValidatePipelineLayoutDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidatePipelineLayoutDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, GetOrCreatePipelineLayout(descriptor));
         return {};
     }
@@ -627,7 +892,9 @@ namespace dawn_native {
     MaybeError DeviceBase::CreateRenderBundleEncoderInternal(
         RenderBundleEncoderBase** result,
         const RenderBundleEncoderDescriptor* descriptor) {
-        DAWN_TRY(ValidateRenderBundleEncoderDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateRenderBundleEncoderDescriptor(this, descriptor));
+        }
         *result = new RenderBundleEncoderBase(this, descriptor);
         return {};
     }
@@ -635,35 +902,45 @@ namespace dawn_native {
     MaybeError DeviceBase::CreateRenderPipelineInternal(
         RenderPipelineBase** result,
         const RenderPipelineDescriptor* descriptor) {
-        DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, GetOrCreateRenderPipeline(descriptor));
         return {};
     }
 
     MaybeError DeviceBase::CreateSamplerInternal(SamplerBase** result,
                                                  const SamplerDescriptor* descriptor) {
-        DAWN_TRY(ValidateSamplerDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateSamplerDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, GetOrCreateSampler(descriptor));
         return {};
     }
 
     MaybeError DeviceBase::CreateShaderModuleInternal(ShaderModuleBase** result,
                                                       const ShaderModuleDescriptor* descriptor) {
-        DAWN_TRY(ValidateShaderModuleDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateShaderModuleDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, GetOrCreateShaderModule(descriptor));
         return {};
     }
 
     MaybeError DeviceBase::CreateSwapChainInternal(SwapChainBase** result,
                                                    const SwapChainDescriptor* descriptor) {
-        DAWN_TRY(ValidateSwapChainDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateSwapChainDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, CreateSwapChainImpl(descriptor));
         return {};
     }
 
     MaybeError DeviceBase::CreateTextureInternal(TextureBase** result,
                                                  const TextureDescriptor* descriptor) {
-        DAWN_TRY(ValidateTextureDescriptor(this, descriptor));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateTextureDescriptor(this, descriptor));
+        }
         DAWN_TRY_ASSIGN(*result, CreateTextureImpl(descriptor));
         return {};
     }
@@ -673,8 +950,14 @@ namespace dawn_native {
                                                      const TextureViewDescriptor* descriptor) {
         DAWN_TRY(ValidateObject(texture));
         TextureViewDescriptor desc = GetTextureViewDescriptorWithDefaults(texture, descriptor);
-        DAWN_TRY(ValidateTextureViewDescriptor(texture, &desc));
-        DAWN_TRY_ASSIGN(*result, CreateTextureViewImpl(texture, &desc));
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateTextureViewDescriptor(texture, &desc));
+        }
+        if (IsToggleEnabled(Toggle::DeduplicateBindGroupsAndTextureViews)) {
+            DAWN_TRY_ASSIGN(*result, GetOrCreateTextureView(texture, &desc));
+        } else {
+            DAWN_TRY_ASSIGN(*result, CreateTextureViewImpl(texture, &desc));
+        }
         return {};
     }
 
@@ -693,6 +976,26 @@ namespace dawn_native {
         return mDynamicUploader.get();
     }
 
+    SlabAllocator* DeviceBase::GetCommandBufferAllocator() {
+        return &mCommandBufferAllocator;
+    }
+
+    SlabAllocator* DeviceBase::GetCommandEncoderAllocator() {
+        return &mCommandEncoderAllocator;
+    }
+
+    SlabAllocator* DeviceBase::GetComputePassEncoderAllocator() {
+        return &mComputePassEncoderAllocator;
+    }
+
+    SlabAllocator* DeviceBase::GetRenderPassEncoderAllocator() {
+        return &mRenderPassEncoderAllocator;
+    }
+
+    SlabAllocator* DeviceBase::GetTextureViewAllocator() {
+        return &mTextureViewAllocator;
+    }
+
     void DeviceBase::SetToggle(Toggle toggle, bool isEnabled) {
         mTogglesSet.SetToggle(toggle, isEnabled);
     }
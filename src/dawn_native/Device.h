@@ -16,6 +16,7 @@
 #define DAWNNATIVE_DEVICE_H_
 
 #include "common/Serial.h"
+#include "common/SlabAllocator.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Extensions.h"
 #include "dawn_native/Format.h"
@@ -26,6 +27,8 @@
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 
 namespace dawn_native {
@@ -38,6 +41,7 @@ namespace dawn_native {
     class FenceSignalTracker;
     class DynamicUploader;
     class StagingBufferBase;
+    struct TextureCopy;
 
     class DeviceBase {
       public:
@@ -90,10 +94,10 @@ namespace dawn_native {
         // the client-server wire every creation will get a different proxy object, with a
         // different reference count.
         //
-        // When trying to create an object, we give both the descriptor and an example of what
-        // the created object will be, the "blueprint". The blueprint is just a FooBase object
-        // instead of a backend Foo object. If the blueprint doesn't match an object in the
-        // cache, then the descriptor is used to make a new object.
+        // When trying to create an object, the hash of its content is computed from the
+        // descriptor and used to find the objects of the cache that could match, which are then
+        // compared with the descriptor. If none of them match, then the descriptor is used to
+        // make a new object.
         ResultOrError<BindGroupLayoutBase*> GetOrCreateBindGroupLayout(
             const BindGroupLayoutDescriptor* descriptor);
         void UncacheBindGroupLayout(BindGroupLayoutBase* obj);
@@ -124,6 +128,17 @@ namespace dawn_native {
         Ref<AttachmentState> GetOrCreateAttachmentState(const RenderPassDescriptor* descriptor);
         void UncacheAttachmentState(AttachmentState* obj);
 
+        // When the DeduplicateBindGroupsAndTextureViews toggle is enabled, bind groups and texture
+        // views are deduplicated the same way. Applications often recreate the same bind groups
+        // every frame and release them in between, so the device keeps a reference to these
+        // objects. They are evicted when a buffer or texture they use is destroyed.
+        ResultOrError<BindGroupBase*> GetOrCreateBindGroup(const BindGroupDescriptor* descriptor);
+        ResultOrError<TextureViewBase*> GetOrCreateTextureView(
+            TextureBase* texture,
+            const TextureViewDescriptor* descriptor);
+        void EvictDeduplicatedObjectsUsing(const BufferBase* buffer);
+        void EvictDeduplicatedObjectsUsing(const TextureBase* texture);
+
         // Dawn API
         BindGroupBase* CreateBindGroup(const BindGroupDescriptor* descriptor);
         BindGroupLayoutBase* CreateBindGroupLayout(const BindGroupLayoutDescriptor* descriptor);
@@ -147,6 +162,14 @@ namespace dawn_native {
                                            const TextureViewDescriptor* descriptor);
 
         void Tick();
+        // Blocks until the commands submitted up to |serial| completed, or until |timeoutNs|
+        // nanoseconds passed. Returns whether they completed. The callbacks for the completed
+        // commands are only called at the next Tick.
+        bool WaitForSerial(Serial serial, uint64_t timeoutNs);
+
+        // Adds an object whose last reference was released to the objects deleted at the next
+        // Tick. It is lock-free and can be called from any thread.
+        void DeferDeletion(ObjectBase* object);
 
         void SetUncapturedErrorCallback(dawn::ErrorCallback callback, void* userdata);
         void PushErrorScope(dawn::ErrorFilter filter);
@@ -162,20 +185,53 @@ namespace dawn_native {
                                                    BufferBase* destination,
                                                    uint64_t destinationOffset,
                                                    uint64_t size) = 0;
+        // Copies the image at |source| in the staging buffer to |destination|. The offset and row
+        // pitch of |source| are aligned to kTextureRowPitchAlignment.
+        virtual MaybeError CopyFromStagingToTexture(StagingBufferBase* staging,
+                                                    const TextureDataLayout& source,
+                                                    TextureCopy* destination,
+                                                    const Extent3D& copySize) = 0;
 
         ResultOrError<DynamicUploader*> GetDynamicUploader() const;
 
+        // Allocators for the objects that are created and released at a high rate, usually
+        // several times per frame. Each one only holds objects of a single type, the backend type
+        // for objects that have one. Error objects aren't allocated from them.
+        SlabAllocator* GetCommandBufferAllocator();
+        SlabAllocator* GetCommandEncoderAllocator();
+        SlabAllocator* GetComputePassEncoderAllocator();
+        SlabAllocator* GetRenderPassEncoderAllocator();
+        SlabAllocator* GetTextureViewAllocator();
+
         std::vector<const char*> GetEnabledExtensions() const;
         std::vector<const char*> GetTogglesUsed() const;
         bool IsExtensionEnabled(Extension extension) const;
         bool IsToggleEnabled(Toggle toggle) const;
+        // Whether API calls are validated, false when the skip_validation toggle is enabled.
+        bool IsValidationEnabled() const;
         size_t GetLazyClearCountForTesting();
         void IncrementLazyClearCountForTesting();
+        size_t GetBufferLazyClearCountForTesting();
+        void IncrementBufferLazyClearCountForTesting();
+        size_t GetRemovedCommandCountForTesting();
+        void IncrementRemovedCommandCountForTesting(size_t count);
+        size_t GetDeferredDeletionCountForTesting() const;
 
       protected:
         void SetToggle(Toggle toggle, bool isEnabled);
         void ApplyToggleOverrides(const DeviceDescriptor* deviceDescriptor);
 
+        // Devices must release the deduplicated objects before they free their backend objects.
+        void ClearDeduplicationCaches();
+        // Devices must also delete the objects whose deletion was deferred before they free
+        // their backend objects, after clearing the deduplication caches.
+        void DeleteDeferredObjects();
+
+        // Backends that can block until their commands complete override this. The default
+        // implementation repeatedly checks whether the commands completed.
+        virtual bool WaitForSerialImpl(Serial serial,
+                                       std::chrono::steady_clock::time_point deadline);
+
         std::unique_ptr<DynamicUploader> mDynamicUploader;
 
       private:
@@ -235,6 +291,14 @@ namespace dawn_native {
 
         AdapterBase* mAdapter = nullptr;
 
+        // The object allocators are destroyed last because the backend devices can release
+        // objects allocated from them until they are destroyed.
+        SlabAllocator mCommandBufferAllocator;
+        SlabAllocator mCommandEncoderAllocator;
+        SlabAllocator mComputePassEncoderAllocator;
+        SlabAllocator mRenderPassEncoderAllocator;
+        SlabAllocator mTextureViewAllocator;
+
         // The object caches aren't exposed in the header as they would require a lot of
         // additional includes.
         struct Caches;
@@ -247,6 +311,10 @@ namespace dawn_native {
             void* userdata;
         };
 
+        // The head of the intrusive list of objects to delete at the next Tick, linked with
+        // ObjectBase::mNextDeferredDeletion.
+        std::atomic<ObjectBase*> mDeferredDeletions = {nullptr};
+
         std::unique_ptr<FenceSignalTracker> mFenceSignalTracker;
         std::vector<DeferredCreateBufferMappedAsync> mDeferredCreateBufferMappedAsyncResults;
 
@@ -258,6 +326,8 @@ namespace dawn_native {
 
         TogglesSet mTogglesSet;
         size_t mLazyClearCountForTesting = 0;
+        size_t mBufferLazyClearCountForTesting = 0;
+        size_t mRemovedCommandCountForTesting = 0;
 
         ExtensionsSet mEnabledExtensions;
     };
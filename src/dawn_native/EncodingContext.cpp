@@ -18,6 +18,7 @@
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ErrorData.h"
+#include "dawn_native/RedundantCommandElimination.h"
 
 namespace dawn_native {
 
@@ -34,6 +35,16 @@ namespace dawn_native {
     CommandIterator EncodingContext::AcquireCommands() {
         ASSERT(!mWereCommandsAcquired);
         mWereCommandsAcquired = true;
+
+        if (mDevice->IsToggleEnabled(Toggle::EliminateRedundantCommands)) {
+            size_t removedCommandCount = 0;
+            CommandIterator commands =
+                EliminateRedundantCommands(GetIterator(), &removedCommandCount);
+            FreeCommands(GetIterator());
+            mDevice->IncrementRemovedCommandCountForTesting(removedCommandCount);
+            return commands;
+        }
+
         return std::move(mIterator);
     }
 
@@ -83,6 +83,29 @@ namespace dawn_native {
         mRequests.Enqueue(std::move(request), value);
     }
 
+    bool FenceBase::Wait(uint64_t value, uint64_t timeoutNs) {
+        // Values that aren't signaled yet would never complete.
+        if (IsError() || value > mSignalValue) {
+            return false;
+        }
+        if (value <= mCompletedValue) {
+            return true;
+        }
+
+        // The fence was signaled with |value| at the latest when the last serial was submitted.
+        DeviceBase* device = GetDevice();
+        if (!device->WaitForSerial(device->GetLastSubmittedCommandSerial(), timeoutNs)) {
+            return false;
+        }
+
+        // Tick the device to update the fence and call the callbacks on this thread. The
+        // callbacks could release the last external reference to the fence.
+        Ref<FenceBase> self = this;
+        device->Tick();
+        ASSERT(value <= mCompletedValue);
+        return true;
+    }
+
     uint64_t FenceBase::GetSignaledValue() const {
         ASSERT(!IsError());
         return mSignalValue;
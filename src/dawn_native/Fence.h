@@ -42,6 +42,9 @@ namespace dawn_native {
         uint64_t GetCompletedValue() const;
         void OnCompletion(uint64_t value, dawn::FenceOnCompletionCallback callback, void* userdata);
 
+        // Used to implement dawn_native::WaitForFence.
+        bool Wait(uint64_t value, uint64_t timeoutNs);
+
       protected:
         friend class QueueBase;
         friend class FenceSignalTracker;
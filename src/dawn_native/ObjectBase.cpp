@@ -14,6 +14,8 @@
 
 #include "dawn_native/ObjectBase.h"
 
+#include "dawn_native/Device.h"
+
 namespace dawn_native {
 
     ObjectBase::ObjectBase(DeviceBase* device) : mDevice(device), mIsError(false) {
@@ -33,4 +35,18 @@ namespace dawn_native {
         return mIsError;
     }
 
+    bool ObjectBase::DeferDeletion() {
+        if (mIsError || !mDevice->IsToggleEnabled(Toggle::DeferObjectDeletion)) {
+            return false;
+        }
+
+        // The deletion is deferred only once, the device calling DeleteThis again deletes the
+        // object.
+        if (mIsDeletionDeferred.exchange(true)) {
+            return false;
+        }
+        mDevice->DeferDeletion(this);
+        return true;
+    }
+
 }  // namespace dawn_native
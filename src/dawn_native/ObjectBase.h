@@ -17,6 +17,8 @@
 
 #include "dawn_native/RefCounted.h"
 
+#include <atomic>
+
 namespace dawn_native {
 
     class DeviceBase;
@@ -33,12 +35,24 @@ namespace dawn_native {
         DeviceBase* GetDevice() const;
         bool IsError() const;
 
+      protected:
+        // Objects that can be expensive to delete call this at the start of DeleteThis. When the
+        // device defers object deletion, the object is added to the objects the device deletes at
+        // its next tick and this returns true. The device then calls DeleteThis again, in which
+        // case this returns false.
+        bool DeferDeletion();
+
       private:
+        friend class DeviceBase;
+
         DeviceBase* mDevice;
+        // The next object in the device's list of objects to delete at the next tick.
+        ObjectBase* mNextDeferredDeletion = nullptr;
         // TODO(cwallez@chromium.org): This most likely adds 4 bytes to most Dawn objects, see if
         // that bit can be hidden in the refcount once it is a single 64bit refcount.
         // See https://bugs.chromium.org/p/dawn/issues/detail?id=105
         bool mIsError;
+        std::atomic<bool> mIsDeletionDeferred = {false};
     };
 
 }  // namespace dawn_native
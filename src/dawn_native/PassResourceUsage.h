@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_PASSRESOURCEUSAGE_H
 #define DAWNNATIVE_PASSRESOURCEUSAGE_H
 
+#include "dawn_native/SubresourceStorage.h"
 #include "dawn_native/dawn_platform.h"
 
 #include <set>
@@ -25,6 +26,13 @@ namespace dawn_native {
     class BufferBase;
     class TextureBase;
 
+    // The usage of a texture in a pass, for each of its subresources. |usage| is the union of the
+    // usages of all the subresources.
+    struct PassTextureUsage {
+        dawn::TextureUsage usage;
+        SubresourceStorage<dawn::TextureUsage> subresourceUsages;
+    };
+
     // Which resources are used by pass and how they are used. The command buffer validation
     // pre-computes this information so that backends with explicit barriers don't have to
     // re-compute it.
@@ -33,13 +41,17 @@ namespace dawn_native {
         std::vector<dawn::BufferUsage> bufferUsages;
 
         std::vector<TextureBase*> textures;
-        std::vector<dawn::TextureUsage> textureUsages;
+        std::vector<PassTextureUsage> textureUsages;
     };
 
     struct CommandBufferResourceUsage {
         std::vector<PassResourceUsage> perPass;
         std::set<BufferBase*> topLevelBuffers;
         std::set<TextureBase*> topLevelTextures;
+
+        // Buffers whose first use in the command buffer is a copy writing all of their content.
+        // They don't need to be lazily cleared before the command buffer is executed.
+        std::set<BufferBase*> fullyOverwrittenBuffers;
     };
 
 }  // namespace dawn_native
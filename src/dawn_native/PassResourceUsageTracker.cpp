@@ -17,6 +17,8 @@
 #include "dawn_native/Buffer.h"
 #include "dawn_native/Texture.h"
 
+#include <utility>
+
 namespace dawn_native {
 
     void PassResourceUsageTracker::BufferUsedAs(BufferBase* buffer, dawn::BufferUsage usage) {
@@ -31,16 +33,51 @@ namespace dawn_native {
         storedUsage |= usage;
     }
 
-    void PassResourceUsageTracker::TextureUsedAs(TextureBase* texture, dawn::TextureUsage usage) {
-        // std::map's operator[] will create the key and return 0 if the key didn't exist
-        // before.
-        dawn::TextureUsage& storedUsage = mTextureUsages[texture];
+    void PassResourceUsageTracker::TextureViewUsedAs(TextureViewBase* view,
+                                                     dawn::TextureUsage usage) {
+        PassTextureUsage& textureUsage = GetTextureUsage(view->GetTexture());
+        textureUsage.usage |= usage;
+
+        textureUsage.subresourceUsages.Update(
+            view->GetSubresourceRange(),
+            [&](const SubresourceRange&, dawn::TextureUsage* storedUsage) {
+                if (usage == dawn::TextureUsage::Storage &&
+                    *storedUsage & dawn::TextureUsage::Storage) {
+                    mStorageUsedMultipleTimes = true;
+                }
+                *storedUsage |= usage;
+            });
+    }
 
-        if (usage == dawn::TextureUsage::Storage && storedUsage & dawn::TextureUsage::Storage) {
-            mStorageUsedMultipleTimes = true;
+    void PassResourceUsageTracker::AddTextureUsage(TextureBase* texture,
+                                                   const PassTextureUsage& addedUsage) {
+        PassTextureUsage& textureUsage = GetTextureUsage(texture);
+        textureUsage.usage |= addedUsage.usage;
+
+        textureUsage.subresourceUsages.Merge(
+            addedUsage.subresourceUsages,
+            [&](const SubresourceRange&, dawn::TextureUsage* storedUsage,
+                const dawn::TextureUsage& usage) {
+                if (usage & dawn::TextureUsage::Storage &&
+                    *storedUsage & dawn::TextureUsage::Storage) {
+                    mStorageUsedMultipleTimes = true;
+                }
+                *storedUsage |= usage;
+            });
+    }
+
+    PassTextureUsage& PassResourceUsageTracker::GetTextureUsage(TextureBase* texture) {
+        auto it = mTextureUsages.find(texture);
+        if (it != mTextureUsages.end()) {
+            return it->second;
         }
 
-        storedUsage |= usage;
+        PassTextureUsage textureUsage = {
+            dawn::TextureUsage::None,
+            SubresourceStorage<dawn::TextureUsage>(texture->GetNumMipLevels(),
+                                                   texture->GetArrayLayers(),
+                                                   dawn::TextureUsage::None)};
+        return mTextureUsages.emplace(texture, std::move(textureUsage)).first->second;
     }
 
     MaybeError PassResourceUsageTracker::ValidateComputePassUsages() const {
@@ -75,20 +112,25 @@ namespace dawn_native {
             }
         }
 
-        // Textures can only be used as single-write or multiple read.
-        // TODO(cwallez@chromium.org): implement per-subresource tracking
+        // Texture subresources can only be used as single-write or multiple read.
         for (auto& it : mTextureUsages) {
             TextureBase* texture = it.first;
-            dawn::TextureUsage usage = it.second;
+            const PassTextureUsage& textureUsage = it.second;
 
-            if (usage & ~texture->GetUsage()) {
+            if (textureUsage.usage & ~texture->GetUsage()) {
                 return DAWN_VALIDATION_ERROR("Texture missing usage for the pass");
             }
 
             // For textures the only read-only usage in a pass is Sampled, so checking the
             // usage constraint simplifies to checking a single usage bit is set.
-            if (!dawn::HasZeroOrOneBits(it.second)) {
-                return DAWN_VALIDATION_ERROR("Texture used with more than one usage in pass");
+            bool singleUse = true;
+            textureUsage.subresourceUsages.Iterate(
+                [&](const SubresourceRange&, const dawn::TextureUsage& usage) {
+                    singleUse &= dawn::HasZeroOrOneBits(usage);
+                });
+            if (!singleUse) {
+                return DAWN_VALIDATION_ERROR(
+                    "Texture subresource used with more than one usage in pass");
             }
         }
 
@@ -110,9 +152,11 @@ namespace dawn_native {
 
         for (auto& it : mTextureUsages) {
             result.textures.push_back(it.first);
-            result.textureUsages.push_back(it.second);
+            result.textureUsages.push_back(std::move(it.second));
         }
 
+        mBufferUsages.clear();
+        mTextureUsages.clear();
         return result;
     }
 
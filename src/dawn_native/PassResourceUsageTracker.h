@@ -26,6 +26,7 @@ namespace dawn_native {
 
     class BufferBase;
     class TextureBase;
+    class TextureViewBase;
 
     // Helper class to encapsulate the logic of tracking per-resource usage during the
     // validation of command buffer passes. It is used both to know if there are validation
@@ -34,7 +35,10 @@ namespace dawn_native {
     class PassResourceUsageTracker {
       public:
         void BufferUsedAs(BufferBase* buffer, dawn::BufferUsage usage);
-        void TextureUsedAs(TextureBase* texture, dawn::TextureUsage usage);
+        // Textures are tracked per subresource, so that different subresources of a texture can
+        // be used with different usages in the same pass.
+        void TextureViewUsedAs(TextureViewBase* view, dawn::TextureUsage usage);
+        void AddTextureUsage(TextureBase* texture, const PassTextureUsage& textureUsage);
 
         MaybeError ValidateComputePassUsages() const;
         MaybeError ValidateRenderPassUsages() const;
@@ -46,8 +50,11 @@ namespace dawn_native {
         // Performs the per-pass usage validation checks
         MaybeError ValidateUsages() const;
 
+        // Returns the usage of the texture, creating it with no usage if it didn't exist before.
+        PassTextureUsage& GetTextureUsage(TextureBase* texture);
+
         std::map<BufferBase*, dawn::BufferUsage> mBufferUsages;
-        std::map<TextureBase*, dawn::TextureUsage> mTextureUsages;
+        std::map<TextureBase*, PassTextureUsage> mTextureUsages;
         bool mStorageUsedMultipleTimes = false;
     };
 
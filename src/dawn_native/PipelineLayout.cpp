@@ -56,9 +56,8 @@ namespace dawn_native {
     // PipelineLayoutBase
 
     PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device,
-                                           const PipelineLayoutDescriptor* descriptor,
-                                           bool blueprint)
-        : ObjectBase(device), mIsBlueprint(blueprint) {
+                                           const PipelineLayoutDescriptor* descriptor)
+        : CachedObject(device) {
         ASSERT(descriptor->bindGroupLayoutCount <= kMaxBindGroups);
         for (uint32_t group = 0; group < descriptor->bindGroupLayoutCount; ++group) {
             mBindGroupLayouts[group] = descriptor->bindGroupLayouts[group];
@@ -67,12 +66,11 @@ namespace dawn_native {
     }
 
     PipelineLayoutBase::PipelineLayoutBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ObjectBase(device, tag) {
+        : CachedObject(device, tag) {
     }
 
     PipelineLayoutBase::~PipelineLayoutBase() {
-        // Do not uncache the actual cached object if we are a blueprint
-        if (!mIsBlueprint && !IsError()) {
+        if (IsCachedReference()) {
             GetDevice()->UncachePipelineLayout(this);
         }
     }
@@ -111,24 +109,25 @@ namespace dawn_native {
         return kMaxBindGroups;
     }
 
-    size_t PipelineLayoutBase::HashFunc::operator()(const PipelineLayoutBase* pl) const {
-        size_t hash = Hash(pl->mMask);
+    // static
+    size_t PipelineLayoutBase::ComputeContentHash(const PipelineLayoutDescriptor* descriptor) {
+        size_t hash = Hash(descriptor->bindGroupLayoutCount);
 
-        for (uint32_t group : IterateBitSet(pl->mMask)) {
-            HashCombine(&hash, pl->GetBindGroupLayout(group));
+        for (uint32_t group = 0; group < descriptor->bindGroupLayoutCount; ++group) {
+            HashCombine(&hash, descriptor->bindGroupLayouts[group]);
         }
 
         return hash;
     }
 
-    bool PipelineLayoutBase::EqualityFunc::operator()(const PipelineLayoutBase* a,
-                                                      const PipelineLayoutBase* b) const {
-        if (a->mMask != b->mMask) {
+    bool PipelineLayoutBase::IsEqualToDescriptor(
+        const PipelineLayoutDescriptor* descriptor) const {
+        if (descriptor->bindGroupLayoutCount != mMask.count()) {
             return false;
         }
 
-        for (uint32_t group : IterateBitSet(a->mMask)) {
-            if (a->GetBindGroupLayout(group) != b->GetBindGroupLayout(group)) {
+        for (uint32_t group = 0; group < descriptor->bindGroupLayoutCount; ++group) {
+            if (mBindGroupLayouts[group].Get() != descriptor->bindGroupLayouts[group]) {
                 return false;
             }
         }
@@ -75,35 +75,9 @@ namespace dawn_native {
                                                uint32_t dynamicOffsetCount,
                                                const uint64_t* dynamicOffsets) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
-            DAWN_TRY(GetDevice()->ValidateObject(group));
-
-            if (groupIndex >= kMaxBindGroups) {
-                return DAWN_VALIDATION_ERROR("Setting bind group over the max");
-            }
-
-            // Dynamic offsets count must match the number required by the layout perfectly.
-            const BindGroupLayoutBase* layout = group->GetLayout();
-            if (layout->GetDynamicBufferCount() != dynamicOffsetCount) {
-                return DAWN_VALIDATION_ERROR("dynamicOffset count mismatch");
-            }
-
-            for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
-                if (dynamicOffsets[i] % kMinDynamicBufferOffsetAlignment != 0) {
-                    return DAWN_VALIDATION_ERROR("Dynamic Buffer Offset need to be aligned");
-                }
-
-                BufferBinding bufferBinding = group->GetBindingAsBufferBinding(i);
-
-                // During BindGroup creation, validation ensures binding offset + binding size <=
-                // buffer size.
-                DAWN_ASSERT(bufferBinding.buffer->GetSize() >= bufferBinding.size);
-                DAWN_ASSERT(bufferBinding.buffer->GetSize() - bufferBinding.size >=
-                            bufferBinding.offset);
-
-                if ((dynamicOffsets[i] >
-                     bufferBinding.buffer->GetSize() - bufferBinding.offset - bufferBinding.size)) {
-                    return DAWN_VALIDATION_ERROR("dynamic offset out of bounds");
-                }
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateSetBindGroup(groupIndex, group, dynamicOffsetCount,
+                                              dynamicOffsets));
             }
 
             SetBindGroupCmd* cmd = allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
@@ -119,4 +93,42 @@ namespace dawn_native {
         });
     }
 
+    MaybeError ProgrammablePassEncoder::ValidateSetBindGroup(uint32_t groupIndex,
+                                                             BindGroupBase* group,
+                                                             uint32_t dynamicOffsetCount,
+                                                             const uint64_t* dynamicOffsets) const {
+        DAWN_TRY(GetDevice()->ValidateObject(group));
+
+        if (groupIndex >= kMaxBindGroups) {
+            return DAWN_VALIDATION_ERROR("Setting bind group over the max");
+        }
+
+        // Dynamic offsets count must match the number required by the layout perfectly.
+        const BindGroupLayoutBase* layout = group->GetLayout();
+        if (layout->GetDynamicBufferCount() != dynamicOffsetCount) {
+            return DAWN_VALIDATION_ERROR("dynamicOffset count mismatch");
+        }
+
+        for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
+            if (dynamicOffsets[i] % kMinDynamicBufferOffsetAlignment != 0) {
+                return DAWN_VALIDATION_ERROR("Dynamic Buffer Offset need to be aligned");
+            }
+
+            BufferBinding bufferBinding = group->GetBindingAsBufferBinding(i);
+
+            // During BindGroup creation, validation ensures binding offset + binding size <=
+            // buffer size.
+            DAWN_ASSERT(bufferBinding.buffer->GetSize() >= bufferBinding.size);
+            DAWN_ASSERT(bufferBinding.buffer->GetSize() - bufferBinding.size >=
+                        bufferBinding.offset);
+
+            if ((dynamicOffsets[i] >
+                 bufferBinding.buffer->GetSize() - bufferBinding.offset - bufferBinding.size)) {
+                return DAWN_VALIDATION_ERROR("dynamic offset out of bounds");
+            }
+        }
+
+        return {};
+    }
+
 }  // namespace dawn_native
@@ -47,6 +47,12 @@ namespace dawn_native {
                                 ErrorTag errorTag);
 
         EncodingContext* mEncodingContext = nullptr;
+
+      private:
+        MaybeError ValidateSetBindGroup(uint32_t groupIndex,
+                                        BindGroupBase* group,
+                                        uint32_t dynamicOffsetCount,
+                                        const uint64_t* dynamicOffsets) const;
     };
 
 }  // namespace dawn_native
@@ -14,16 +14,51 @@
 
 #include "dawn_native/Queue.h"
 
+#include "common/Constants.h"
+#include "common/Math.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandBuffer.h"
+#include "dawn_native/CommandValidation.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/Fence.h"
 #include "dawn_native/FenceSignalTracker.h"
 #include "dawn_native/Texture.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
+#include <cstring>
+#include <limits>
+
 namespace dawn_native {
 
+    namespace {
+
+        // Fills in the row pitch and image height of tightly packed data when they are 0.
+        TextureDataLayout ResolveTextureDataLayout(const Format& format,
+                                                   const TextureDataLayout& dataLayout,
+                                                   const Extent3D& writeSize) {
+            TextureDataLayout resolvedLayout = dataLayout;
+            if (resolvedLayout.rowPitch == 0) {
+                resolvedLayout.rowPitch = ComputeDefaultRowPitch(format, writeSize.width);
+            }
+            if (resolvedLayout.imageHeight == 0) {
+                resolvedLayout.imageHeight = writeSize.height;
+            }
+            return resolvedLayout;
+        }
+
+        TextureCopy MakeTextureCopy(const TextureCopyView& textureCopyView) {
+            TextureCopy textureCopy;
+            textureCopy.texture = textureCopyView.texture;
+            textureCopy.mipLevel = textureCopyView.mipLevel;
+            textureCopy.arrayLayer = textureCopyView.arrayLayer;
+            textureCopy.origin = textureCopyView.origin;
+            return textureCopy;
+        }
+
+    }  // anonymous namespace
+
     // QueueBase
 
     QueueBase::QueueBase(DeviceBase* device) : ObjectBase(device) {
@@ -32,11 +67,17 @@ namespace dawn_native {
     void QueueBase::Submit(uint32_t commandCount, CommandBufferBase* const* commands) {
         TRACE_EVENT0(GetDevice()->GetPlatform(), TRACE_DISABLED_BY_DEFAULT("gpu.dawn"),
                      "Queue::Submit");
-        if (GetDevice()->ConsumedError(ValidateSubmit(commandCount, commands))) {
+        DeviceBase* device = GetDevice();
+        if (device->IsValidationEnabled() &&
+            device->ConsumedError(ValidateSubmit(commandCount, commands))) {
             return;
         }
         ASSERT(!IsError());
 
+        if (device->ConsumedError(InitializeBuffersForSubmit(commandCount, commands))) {
+            return;
+        }
+
         SubmitImpl(commandCount, commands);
     }
 
@@ -58,6 +99,129 @@ namespace dawn_native {
         return new FenceBase(this, descriptor);
     }
 
+    void QueueBase::WriteBuffer(BufferBase* buffer,
+                                uint64_t bufferOffset,
+                                const void* data,
+                                uint64_t size) {
+        DeviceBase* device = GetDevice();
+        if (device->IsValidationEnabled() &&
+            device->ConsumedError(ValidateWriteBuffer(buffer, bufferOffset, size))) {
+            return;
+        }
+        ASSERT(!IsError());
+
+        if (size == 0) {
+            return;
+        }
+
+        if (device->ConsumedError(buffer->EnsureDataInitializedAsDestination(bufferOffset, size))) {
+            return;
+        }
+        if (device->ConsumedError(WriteBufferImpl(buffer, bufferOffset, data, size))) {
+            return;
+        }
+    }
+
+    void QueueBase::WriteTexture(const TextureCopyView* destination,
+                                 const void* data,
+                                 uint64_t dataSize,
+                                 const TextureDataLayout* dataLayout,
+                                 const Extent3D* writeSize) {
+        DeviceBase* device = GetDevice();
+        if (device->IsValidationEnabled() &&
+            device->ConsumedError(
+                ValidateWriteTexture(destination, dataSize, dataLayout, writeSize))) {
+            return;
+        }
+        ASSERT(!IsError());
+
+        if (writeSize->width == 0 || writeSize->height == 0 || writeSize->depth == 0) {
+            return;
+        }
+
+        TextureCopy textureCopy = MakeTextureCopy(*destination);
+        TextureDataLayout resolvedLayout =
+            ResolveTextureDataLayout(textureCopy.texture->GetFormat(), *dataLayout, *writeSize);
+        if (device->ConsumedError(
+                WriteTextureImpl(&textureCopy, data, resolvedLayout, *writeSize))) {
+            return;
+        }
+    }
+
+    MaybeError QueueBase::WriteBufferImpl(BufferBase* buffer,
+                                          uint64_t bufferOffset,
+                                          const void* data,
+                                          uint64_t size) {
+        if (size > std::numeric_limits<uint32_t>::max()) {
+            return DAWN_OUT_OF_MEMORY_ERROR("Write is too large for the upload buffers");
+        }
+
+        DynamicUploader* uploader = nullptr;
+        DAWN_TRY_ASSIGN(uploader, GetDevice()->GetDynamicUploader());
+
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, uploader->Allocate(static_cast<uint32_t>(size)));
+        ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+        memcpy(uploadHandle.mappedBuffer, data, size);
+
+        return GetDevice()->CopyFromStagingToBuffer(uploadHandle.stagingBuffer,
+                                                    uploadHandle.startOffset, buffer,
+                                                    bufferOffset, size);
+    }
+
+    MaybeError QueueBase::WriteTextureImpl(TextureCopy* destination,
+                                           const void* data,
+                                           const TextureDataLayout& dataLayout,
+                                           const Extent3D& writeSize) {
+        // Writes to more than one array layer are rejected by ValidateWriteTexture.
+        ASSERT(writeSize.depth == 1);
+
+        const Format& format = destination->texture->GetFormat();
+        uint32_t rowSize = writeSize.width / format.blockWidth * format.blockByteSize;
+        uint32_t rowCount = writeSize.height / format.blockHeight;
+
+        // The rows are repacked to an aligned row pitch while they are copied to the staging
+        // memory so that all the backends can copy them directly. The allocation has room to
+        // align its start offset and to hold the padding of the last row, which some copy APIs
+        // count as part of the copied range.
+        uint32_t alignedRowPitch = Align(rowSize, kTextureRowPitchAlignment);
+        uint64_t stagingSize =
+            uint64_t(alignedRowPitch) * rowCount + kTextureRowPitchAlignment - 1;
+        if (stagingSize > std::numeric_limits<uint32_t>::max()) {
+            return DAWN_OUT_OF_MEMORY_ERROR("Write is too large for the upload buffers");
+        }
+
+        DynamicUploader* uploader = nullptr;
+        DAWN_TRY_ASSIGN(uploader, GetDevice()->GetDynamicUploader());
+
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, uploader->Allocate(static_cast<uint32_t>(stagingSize)));
+        ASSERT(uploadHandle.mappedBuffer != nullptr);
+
+        uint64_t alignedOffset = (uploadHandle.startOffset + kTextureRowPitchAlignment - 1) /
+                                 kTextureRowPitchAlignment * kTextureRowPitchAlignment;
+        uint8_t* dst = uploadHandle.mappedBuffer + (alignedOffset - uploadHandle.startOffset);
+        const uint8_t* src = static_cast<const uint8_t*>(data) + dataLayout.offset;
+        if (dataLayout.rowPitch == alignedRowPitch) {
+            memcpy(dst, src, uint64_t(alignedRowPitch) * (rowCount - 1) + rowSize);
+        } else {
+            for (uint32_t row = 0; row < rowCount; ++row) {
+                memcpy(dst, src, rowSize);
+                dst += alignedRowPitch;
+                src += dataLayout.rowPitch;
+            }
+        }
+
+        TextureDataLayout stagingLayout;
+        stagingLayout.offset = alignedOffset;
+        stagingLayout.rowPitch = alignedRowPitch;
+        stagingLayout.imageHeight = writeSize.height;
+
+        return GetDevice()->CopyFromStagingToTexture(uploadHandle.stagingBuffer, stagingLayout,
+                                                     destination, writeSize);
+    }
+
     MaybeError QueueBase::ValidateSubmit(uint32_t commandCount,
                                          CommandBufferBase* const* commands) {
         DAWN_TRY(GetDevice()->ValidateObject(this));
@@ -87,6 +251,31 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError QueueBase::InitializeBuffersForSubmit(uint32_t commandCount,
+                                                     CommandBufferBase* const* commands) {
+        // The clears are recorded before the command buffers so they happen before all of the
+        // submitted commands. Command buffers are processed in order so that a buffer overwritten
+        // by a command buffer is still cleared if a previous one uses it.
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            const CommandBufferResourceUsage& usages = commands[i]->GetResourceUsages();
+
+            for (BufferBase* buffer : usages.fullyOverwrittenBuffers) {
+                buffer->SetIsDataInitialized();
+            }
+
+            for (const PassResourceUsage& passUsages : usages.perPass) {
+                for (BufferBase* buffer : passUsages.buffers) {
+                    DAWN_TRY(buffer->EnsureDataInitialized());
+                }
+            }
+            for (BufferBase* buffer : usages.topLevelBuffers) {
+                DAWN_TRY(buffer->EnsureDataInitialized());
+            }
+        }
+
+        return {};
+    }
+
     MaybeError QueueBase::ValidateSignal(const FenceBase* fence, uint64_t signalValue) {
         DAWN_TRY(GetDevice()->ValidateObject(this));
         DAWN_TRY(GetDevice()->ValidateObject(fence));
@@ -108,4 +297,68 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError QueueBase::ValidateWriteBuffer(BufferBase* buffer,
+                                              uint64_t bufferOffset,
+                                              uint64_t size) {
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+        DAWN_TRY(GetDevice()->ValidateObject(buffer));
+        DAWN_TRY(buffer->ValidateCanUseInSubmitNow());
+        DAWN_TRY(ValidateCanUseAs(buffer, dawn::BufferUsage::CopyDst));
+
+        // Same restrictions as buffer-to-buffer copies, which the write is implemented with.
+        if (bufferOffset % 4 != 0) {
+            return DAWN_VALIDATION_ERROR("Buffer offset must be a multiple of 4 bytes");
+        }
+        if (size % 4 != 0) {
+            return DAWN_VALIDATION_ERROR("Write size must be a multiple of 4 bytes");
+        }
+
+        DAWN_TRY(ValidateCopySizeFitsInBuffer(buffer, bufferOffset, size));
+
+        return {};
+    }
+
+    MaybeError QueueBase::ValidateWriteTexture(const TextureCopyView* destination,
+                                               uint64_t dataSize,
+                                               const TextureDataLayout* dataLayout,
+                                               const Extent3D* writeSize) {
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+        DAWN_TRY(GetDevice()->ValidateObject(destination->texture));
+
+        TextureBase* texture = destination->texture;
+        DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+        DAWN_TRY(ValidateCanUseAs(texture, dawn::TextureUsage::CopyDst));
+        DAWN_TRY(ValidateTextureSampleCountInCopyCommands(texture));
+
+        // Like the copies of command encoders, WriteTexture only supports writing to a single
+        // array layer. Writing several layers at once would need the copy validation to support
+        // depth > 1 first.
+        if (writeSize->depth > 1) {
+            return DAWN_VALIDATION_ERROR("WriteTexture only supports a depth of 1");
+        }
+
+        const Format& format = texture->GetFormat();
+        TextureDataLayout resolvedLayout =
+            ResolveTextureDataLayout(format, *dataLayout, *writeSize);
+
+        DAWN_TRY(ValidateImageHeight(format, resolvedLayout.imageHeight, writeSize->height));
+        DAWN_TRY(ValidateImageOrigin(format, destination->origin));
+        DAWN_TRY(ValidateImageCopySize(format, *writeSize));
+        DAWN_TRY(ValidateRowPitch(format, *writeSize, resolvedLayout.rowPitch));
+        DAWN_TRY(ValidateCopySizeFitsInTexture(MakeTextureCopy(*destination), *writeSize));
+
+        if (writeSize->width == 0 || writeSize->height == 0 || writeSize->depth == 0) {
+            return {};
+        }
+
+        uint32_t requiredSize = 0;
+        DAWN_TRY(ComputeTextureCopyBufferSize(format, *writeSize, resolvedLayout.rowPitch,
+                                              resolvedLayout.imageHeight, &requiredSize));
+        if (resolvedLayout.offset > dataSize || requiredSize > dataSize - resolvedLayout.offset) {
+            return DAWN_VALIDATION_ERROR("Write would read outside of the data");
+        }
+
+        return {};
+    }
+
 }  // namespace dawn_native
@@ -23,6 +23,8 @@
 
 namespace dawn_native {
 
+    struct TextureCopy;
+
     class QueueBase : public ObjectBase {
       public:
         QueueBase(DeviceBase* device);
@@ -31,13 +33,42 @@ namespace dawn_native {
         void Submit(uint32_t commandCount, CommandBufferBase* const* commands);
         void Signal(FenceBase* fence, uint64_t signalValue);
         FenceBase* CreateFence(const FenceDescriptor* descriptor);
+        void WriteBuffer(BufferBase* buffer,
+                         uint64_t bufferOffset,
+                         const void* data,
+                         uint64_t size);
+        void WriteTexture(const TextureCopyView* destination,
+                          const void* data,
+                          uint64_t dataSize,
+                          const TextureDataLayout* dataLayout,
+                          const Extent3D* writeSize);
 
       private:
         virtual void SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) = 0;
+        // The writes are uploaded through the DynamicUploader by default. The backends that don't
+        // support staging buffers override them.
+        virtual MaybeError WriteBufferImpl(BufferBase* buffer,
+                                           uint64_t bufferOffset,
+                                           const void* data,
+                                           uint64_t size);
+        // |dataLayout| has the default row pitch and image height resolved.
+        virtual MaybeError WriteTextureImpl(TextureCopy* destination,
+                                            const void* data,
+                                            const TextureDataLayout& dataLayout,
+                                            const Extent3D& writeSize);
 
         MaybeError ValidateSubmit(uint32_t commandCount, CommandBufferBase* const* commands);
+        MaybeError InitializeBuffersForSubmit(uint32_t commandCount,
+                                              CommandBufferBase* const* commands);
         MaybeError ValidateSignal(const FenceBase* fence, uint64_t signalValue);
         MaybeError ValidateCreateFence(const FenceDescriptor* descriptor);
+        MaybeError ValidateWriteBuffer(BufferBase* buffer,
+                                       uint64_t bufferOffset,
+                                       uint64_t size);
+        MaybeError ValidateWriteTexture(const TextureCopyView* destination,
+                                        uint64_t dataSize,
+                                        const TextureDataLayout* dataLayout,
+                                        const Extent3D* writeSize);
     };
 
 }  // namespace dawn_native
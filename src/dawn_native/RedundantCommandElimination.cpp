@@ -0,0 +1,405 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/RedundantCommandElimination.h"
+
+#include "common/Constants.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/ComputePipeline.h"
+#include "dawn_native/RenderBundle.h"
+#include "dawn_native/RenderPipeline.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+
+namespace dawn_native {
+
+    namespace {
+
+        template <typename T>
+        void AppendCommand(CommandAllocator* allocator, Command type, const T& command) {
+            *allocator->Allocate<T>(type) = command;
+        }
+
+        template <typename T>
+        void AppendData(CommandAllocator* allocator, const T* data, size_t count) {
+            std::copy(data, data + count, allocator->AllocateData<T>(count));
+        }
+
+        // The state set by the commands of a pass that is still current. Objects are only
+        // compared, the references held by the source commands keep them alive.
+        struct PassState {
+            const void* pipeline = nullptr;
+
+            std::bitset<kMaxBindGroups> bindGroupsSet;
+            std::array<const BindGroupBase*, kMaxBindGroups> bindGroups;
+            std::array<uint32_t, kMaxBindGroups> dynamicOffsetCounts;
+            std::array<std::array<uint64_t, kMaxBindingsPerGroup>, kMaxBindGroups> dynamicOffsets;
+
+            std::bitset<kMaxVertexBuffers> vertexBuffersSet;
+            std::array<const BufferBase*, kMaxVertexBuffers> vertexBuffers;
+            std::array<uint64_t, kMaxVertexBuffers> vertexBufferOffsets;
+
+            bool indexBufferSet = false;
+            const BufferBase* indexBuffer;
+            uint64_t indexBufferOffset;
+
+            bool viewportSet = false;
+            SetViewportCmd viewport;
+
+            bool scissorRectSet = false;
+            SetScissorRectCmd scissorRect;
+
+            bool blendColorSet = false;
+            Color blendColor;
+
+            bool stencilReferenceSet = false;
+            uint32_t stencilReference;
+        };
+
+        // Each of the following functions updates the state with a command and returns whether
+        // the command changed it.
+
+        bool SetPipeline(PassState* state, const void* pipeline) {
+            if (state->pipeline == pipeline) {
+                return false;
+            }
+            state->pipeline = pipeline;
+
+            // Some backends apply bind groups as soon as they are set, using the layout of the
+            // current pipeline, so the bind groups must be set again after a pipeline change.
+            state->bindGroupsSet.reset();
+            return true;
+        }
+
+        bool SetBindGroup(PassState* state,
+                          const SetBindGroupCmd* cmd,
+                          const uint64_t* dynamicOffsets) {
+            uint32_t index = cmd->index;
+            uint32_t count = cmd->dynamicOffsetCount;
+            if (index >= kMaxBindGroups || count > kMaxBindingsPerGroup) {
+                return true;
+            }
+
+            if (state->bindGroupsSet[index] && state->bindGroups[index] == cmd->group.Get() &&
+                state->dynamicOffsetCounts[index] == count &&
+                std::equal(dynamicOffsets, dynamicOffsets + count,
+                           state->dynamicOffsets[index].begin())) {
+                return false;
+            }
+
+            state->bindGroupsSet.set(index);
+            state->bindGroups[index] = cmd->group.Get();
+            state->dynamicOffsetCounts[index] = count;
+            std::copy(dynamicOffsets, dynamicOffsets + count, state->dynamicOffsets[index].begin());
+            return true;
+        }
+
+        bool SetVertexBuffers(PassState* state,
+                              const SetVertexBuffersCmd* cmd,
+                              const Ref<BufferBase>* buffers,
+                              const uint64_t* offsets) {
+            if (cmd->startSlot + cmd->count > kMaxVertexBuffers) {
+                return true;
+            }
+
+            bool changed = false;
+            for (uint32_t i = 0; i < cmd->count; ++i) {
+                uint32_t slot = cmd->startSlot + i;
+                if (!state->vertexBuffersSet[slot] ||
+                    state->vertexBuffers[slot] != buffers[i].Get() ||
+                    state->vertexBufferOffsets[slot] != offsets[i]) {
+                    state->vertexBuffersSet.set(slot);
+                    state->vertexBuffers[slot] = buffers[i].Get();
+                    state->vertexBufferOffsets[slot] = offsets[i];
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        bool SetIndexBuffer(PassState* state, const SetIndexBufferCmd* cmd) {
+            if (state->indexBufferSet && state->indexBuffer == cmd->buffer.Get() &&
+                state->indexBufferOffset == cmd->offset) {
+                return false;
+            }
+            state->indexBufferSet = true;
+            state->indexBuffer = cmd->buffer.Get();
+            state->indexBufferOffset = cmd->offset;
+            return true;
+        }
+
+        bool SetViewport(PassState* state, const SetViewportCmd* cmd) {
+            const SetViewportCmd& current = state->viewport;
+            if (state->viewportSet && current.x == cmd->x && current.y == cmd->y &&
+                current.width == cmd->width && current.height == cmd->height &&
+                current.minDepth == cmd->minDepth && current.maxDepth == cmd->maxDepth) {
+                return false;
+            }
+            state->viewportSet = true;
+            state->viewport = *cmd;
+            return true;
+        }
+
+        bool SetScissorRect(PassState* state, const SetScissorRectCmd* cmd) {
+            const SetScissorRectCmd& current = state->scissorRect;
+            if (state->scissorRectSet && current.x == cmd->x && current.y == cmd->y &&
+                current.width == cmd->width && current.height == cmd->height) {
+                return false;
+            }
+            state->scissorRectSet = true;
+            state->scissorRect = *cmd;
+            return true;
+        }
+
+        bool SetBlendColor(PassState* state, const SetBlendColorCmd* cmd) {
+            const Color& current = state->blendColor;
+            if (state->blendColorSet && current.r == cmd->color.r && current.g == cmd->color.g &&
+                current.b == cmd->color.b && current.a == cmd->color.a) {
+                return false;
+            }
+            state->blendColorSet = true;
+            state->blendColor = cmd->color;
+            return true;
+        }
+
+        bool SetStencilReference(PassState* state, const SetStencilReferenceCmd* cmd) {
+            if (state->stencilReferenceSet && state->stencilReference == cmd->reference) {
+                return false;
+            }
+            state->stencilReferenceSet = true;
+            state->stencilReference = cmd->reference;
+            return true;
+        }
+
+    }  // anonymous namespace
+
+    CommandIterator EliminateRedundantCommands(CommandIterator* commands,
+                                               size_t* removedCommandCount) {
+        CommandAllocator allocator;
+        PassState state;
+        size_t removedCount = 0;
+
+        commands->Reset();
+
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            switch (type) {
+                case Command::BeginComputePass: {
+                    BeginComputePassCmd* cmd = commands->NextCommand<BeginComputePassCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                    state = PassState{};
+                } break;
+
+                case Command::BeginRenderPass: {
+                    BeginRenderPassCmd* cmd = commands->NextCommand<BeginRenderPassCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                    state = PassState{};
+                } break;
+
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* cmd = commands->NextCommand<CopyBufferToBufferCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* cmd = commands->NextCommand<CopyBufferToTextureCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* cmd = commands->NextCommand<CopyTextureToBufferCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* cmd =
+                        commands->NextCommand<CopyTextureToTextureCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::Dispatch: {
+                    DispatchCmd* cmd = commands->NextCommand<DispatchCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::DispatchIndirect: {
+                    DispatchIndirectCmd* cmd = commands->NextCommand<DispatchIndirectCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::Draw: {
+                    DrawCmd* cmd = commands->NextCommand<DrawCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::DrawIndexed: {
+                    DrawIndexedCmd* cmd = commands->NextCommand<DrawIndexedCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::DrawIndirect: {
+                    DrawIndirectCmd* cmd = commands->NextCommand<DrawIndirectCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::DrawIndexedIndirect: {
+                    DrawIndexedIndirectCmd* cmd = commands->NextCommand<DrawIndexedIndirectCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::EndComputePass: {
+                    EndComputePassCmd* cmd = commands->NextCommand<EndComputePassCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::EndRenderPass: {
+                    EndRenderPassCmd* cmd = commands->NextCommand<EndRenderPassCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::ExecuteBundles: {
+                    ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+                    auto bundles = commands->NextData<Ref<RenderBundleBase>>(cmd->count);
+                    AppendCommand(&allocator, type, *cmd);
+                    AppendData(&allocator, bundles, cmd->count);
+
+                    if (cmd->count > 0) {
+                        state = PassState{};
+                    }
+                } break;
+
+                case Command::InsertDebugMarker: {
+                    InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
+                    const char* label = commands->NextData<char>(cmd->length + 1);
+                    AppendCommand(&allocator, type, *cmd);
+                    AppendData(&allocator, label, cmd->length + 1);
+                } break;
+
+                case Command::PopDebugGroup: {
+                    PopDebugGroupCmd* cmd = commands->NextCommand<PopDebugGroupCmd>();
+                    AppendCommand(&allocator, type, *cmd);
+                } break;
+
+                case Command::PushDebugGroup: {
+                    PushDebugGroupCmd* cmd = commands->NextCommand<PushDebugGroupCmd>();
+                    const char* label = commands->NextData<char>(cmd->length + 1);
+                    AppendCommand(&allocator, type, *cmd);
+                    AppendData(&allocator, label, cmd->length + 1);
+                } break;
+
+                case Command::SetComputePipeline: {
+                    SetComputePipelineCmd* cmd = commands->NextCommand<SetComputePipelineCmd>();
+                    if (SetPipeline(&state, cmd->pipeline.Get())) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetRenderPipeline: {
+                    SetRenderPipelineCmd* cmd = commands->NextCommand<SetRenderPipelineCmd>();
+                    if (SetPipeline(&state, cmd->pipeline.Get())) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetStencilReference: {
+                    SetStencilReferenceCmd* cmd = commands->NextCommand<SetStencilReferenceCmd>();
+                    if (SetStencilReference(&state, cmd)) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetViewport: {
+                    SetViewportCmd* cmd = commands->NextCommand<SetViewportCmd>();
+                    if (SetViewport(&state, cmd)) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetScissorRect: {
+                    SetScissorRectCmd* cmd = commands->NextCommand<SetScissorRectCmd>();
+                    if (SetScissorRect(&state, cmd)) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetBlendColor: {
+                    SetBlendColorCmd* cmd = commands->NextCommand<SetBlendColorCmd>();
+                    if (SetBlendColor(&state, cmd)) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                    const uint64_t* dynamicOffsets = nullptr;
+                    if (cmd->dynamicOffsetCount > 0) {
+                        dynamicOffsets = commands->NextData<uint64_t>(cmd->dynamicOffsetCount);
+                    }
+
+                    if (SetBindGroup(&state, cmd, dynamicOffsets)) {
+                        AppendCommand(&allocator, type, *cmd);
+                        if (cmd->dynamicOffsetCount > 0) {
+                            AppendData(&allocator, dynamicOffsets, cmd->dynamicOffsetCount);
+                        }
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetIndexBuffer: {
+                    SetIndexBufferCmd* cmd = commands->NextCommand<SetIndexBufferCmd>();
+                    if (SetIndexBuffer(&state, cmd)) {
+                        AppendCommand(&allocator, type, *cmd);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+
+                case Command::SetVertexBuffers: {
+                    SetVertexBuffersCmd* cmd = commands->NextCommand<SetVertexBuffersCmd>();
+                    auto buffers = commands->NextData<Ref<BufferBase>>(cmd->count);
+                    auto offsets = commands->NextData<uint64_t>(cmd->count);
+
+                    if (SetVertexBuffers(&state, cmd, buffers, offsets)) {
+                        AppendCommand(&allocator, type, *cmd);
+                        AppendData(&allocator, buffers, cmd->count);
+                        AppendData(&allocator, offsets, cmd->count);
+                    } else {
+                        removedCount++;
+                    }
+                } break;
+            }
+        }
+
+        *removedCommandCount = removedCount;
+        return CommandIterator(std::move(allocator));
+    }
+
+}  // namespace dawn_native
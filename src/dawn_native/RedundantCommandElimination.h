@@ -0,0 +1,34 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_REDUNDANTCOMMANDELIMINATION_H_
+#define DAWNNATIVE_REDUNDANTCOMMANDELIMINATION_H_
+
+#include "dawn_native/CommandAllocator.h"
+
+namespace dawn_native {
+
+    // Returns a copy of the validated commands without the state-setting commands that have no
+    // effect because they set the same state that is already current: pipelines, bind groups with
+    // the same dynamic offsets, vertex and index buffers, viewport, scissor, blend color and
+    // stencil reference. The state is forgotten at the start of passes and after render bundles
+    // are executed, since bundles reset it, and bind groups are forgotten when the pipeline
+    // changes. |commands| is left untouched and still needs to be freed, |removedCommandCount| is
+    // set to the number of commands that were dropped.
+    CommandIterator EliminateRedundantCommands(CommandIterator* commands,
+                                               size_t* removedCommandCount);
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_REDUNDANTCOMMANDELIMINATION_H_
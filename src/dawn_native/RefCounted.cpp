@@ -36,10 +36,15 @@ namespace dawn_native {
     void RefCounted::Release() {
         ASSERT(mRefCount != 0);
 
-        mRefCount--;
-        if (mRefCount == 0) {
-            delete this;
+        // The count must be read by the same atomic operation that decrements it, otherwise two
+        // threads releasing the last references concurrently can both see it reach zero.
+        if (mRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            DeleteThis();
         }
     }
 
+    void RefCounted::DeleteThis() {
+        delete this;
+    }
+
 }  // namespace dawn_native
@@ -32,6 +32,10 @@ namespace dawn_native {
         void Release();
 
       protected:
+        // Called when the last reference is released. Objects that aren't allocated with new
+        // override it to destroy themselves and return their memory where it came from.
+        virtual void DeleteThis();
+
         std::atomic_uint64_t mRefCount = {1};
     };
 
@@ -119,6 +119,11 @@ namespace dawn_native {
 
         CommandIterator* commands = mEncodingContext.GetIterator();
 
+        if (!GetDevice()->IsValidationEnabled()) {
+            TrackRenderBundleResourceUsage(commands, &mResourceUsage);
+            return {};
+        }
+
         DAWN_TRY(ValidateRenderBundle(commands, mAttachmentState.Get(), &mResourceUsage));
         return {};
     }
@@ -47,6 +47,17 @@ namespace dawn_native {
                                          ObjectBase::kError);
     }
 
+    void RenderPassEncoderBase::DeleteThis() {
+        if (IsError()) {
+            RenderEncoderBase::DeleteThis();
+            return;
+        }
+
+        DeviceBase* device = GetDevice();
+        this->~RenderPassEncoderBase();
+        device->GetRenderPassEncoderAllocator()->Deallocate(this);
+    }
+
     void RenderPassEncoderBase::EndPass() {
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
                 allocator->Allocate<EndRenderPassCmd>(Command::EndRenderPass);
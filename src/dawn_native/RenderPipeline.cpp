@@ -352,8 +352,7 @@ namespace dawn_native {
     // RenderPipelineBase
 
     RenderPipelineBase::RenderPipelineBase(DeviceBase* device,
-                                           const RenderPipelineDescriptor* descriptor,
-                                           bool blueprint)
+                                           const RenderPipelineDescriptor* descriptor)
         : PipelineBase(device,
                        descriptor->layout,
                        dawn::ShaderStage::Vertex | dawn::ShaderStage::Fragment),
@@ -364,8 +363,7 @@ namespace dawn_native {
           mVertexModule(descriptor->vertexStage.module),
           mVertexEntryPoint(descriptor->vertexStage.entryPoint),
           mFragmentModule(descriptor->fragmentStage->module),
-          mFragmentEntryPoint(descriptor->fragmentStage->entryPoint),
-          mIsBlueprint(blueprint) {
+          mFragmentEntryPoint(descriptor->fragmentStage->entryPoint) {
         if (descriptor->vertexInput != nullptr) {
             mVertexInput = *descriptor->vertexInput;
         } else {
@@ -437,8 +435,7 @@ namespace dawn_native {
     }
 
     RenderPipelineBase::~RenderPipelineBase() {
-        // Do not uncache the actual cached object if we are a blueprint
-        if (!mIsBlueprint && !IsError()) {
+        if (IsCachedReference()) {
             GetDevice()->UncacheRenderPipeline(this);
         }
     }
@@ -535,21 +532,23 @@ namespace dawn_native {
         return attributesUsingInput[slot];
     }
 
-    size_t RenderPipelineBase::HashFunc::operator()(const RenderPipelineBase* pipeline) const {
+    // static
+    size_t RenderPipelineBase::ComputeContentHash(const RenderPipelineDescriptor* descriptor) {
         size_t hash = 0;
 
-        // Hash modules and layout
-        HashCombine(&hash, pipeline->GetLayout());
-        HashCombine(&hash, pipeline->mVertexModule.Get(), pipeline->mFragmentEntryPoint);
-        HashCombine(&hash, pipeline->mFragmentModule.Get(), pipeline->mFragmentEntryPoint);
+        // Hash modules and layout. Entry points are only compared when the hashes match so that
+        // lookups don't need to build strings from them.
+        HashCombine(&hash, descriptor->layout);
+        HashCombine(&hash, descriptor->vertexStage.module, descriptor->fragmentStage->module);
 
         // Hierarchically hash the attachment state.
         // It contains the attachments set, texture formats, and sample count.
-        HashCombine(&hash, pipeline->mAttachmentState.Get());
+        AttachmentStateBlueprint attachmentState(descriptor);
+        HashCombine(&hash, AttachmentStateBlueprint::HashFunc()(&attachmentState));
 
         // Hash attachments
-        for (uint32_t i : IterateBitSet(pipeline->mAttachmentState->GetColorAttachmentsMask())) {
-            const ColorStateDescriptor& desc = *pipeline->GetColorStateDescriptor(i);
+        for (uint32_t i = 0; i < descriptor->colorStateCount; ++i) {
+            const ColorStateDescriptor& desc = *descriptor->colorStates[i];
             HashCombine(&hash, desc.writeMask);
             HashCombine(&hash, desc.colorBlend.operation, desc.colorBlend.srcFactor,
                         desc.colorBlend.dstFactor);
@@ -557,8 +556,8 @@ namespace dawn_native {
                         desc.alphaBlend.dstFactor);
         }
 
-        if (pipeline->mAttachmentState->HasDepthStencilAttachment()) {
-            const DepthStencilStateDescriptor& desc = pipeline->mDepthStencilState;
+        if (descriptor->depthStencilState != nullptr) {
+            const DepthStencilStateDescriptor& desc = *descriptor->depthStencilState;
             HashCombine(&hash, desc.depthWriteEnabled, desc.depthCompare);
             HashCombine(&hash, desc.stencilReadMask, desc.stencilWriteMask);
             HashCombine(&hash, desc.stencilFront.compare, desc.stencilFront.failOp,
@@ -567,54 +566,83 @@ namespace dawn_native {
                         desc.stencilBack.depthFailOp, desc.stencilBack.passOp);
         }
 
-        // Hash vertex input state
-        HashCombine(&hash, pipeline->mAttributesSetMask);
-        for (uint32_t i : IterateBitSet(pipeline->mAttributesSetMask)) {
-            const VertexAttributeInfo& desc = pipeline->GetAttribute(i);
+        // Hash vertex input state. Attributes are gathered by location first so that the hash
+        // doesn't depend on the order in which they are listed in the descriptor.
+        VertexInputDescriptor defaultVertexInput;
+        const VertexInputDescriptor* vertexInput = descriptor->vertexInput != nullptr
+                                                       ? descriptor->vertexInput
+                                                       : &defaultVertexInput;
+
+        std::bitset<kMaxVertexAttributes> attributesSetMask;
+        std::array<VertexAttributeInfo, kMaxVertexAttributes> attributeInfos;
+        std::bitset<kMaxVertexBuffers> inputsSetMask;
+        for (uint32_t slot = 0; slot < vertexInput->bufferCount; ++slot) {
+            const VertexBufferDescriptor& buffer = vertexInput->buffers[slot];
+            if (buffer.attributeCount == 0) {
+                continue;
+            }
+
+            inputsSetMask.set(slot);
+            for (uint32_t i = 0; i < buffer.attributeCount; ++i) {
+                const VertexAttributeDescriptor& attribute = buffer.attributes[i];
+                attributesSetMask.set(attribute.shaderLocation);
+                attributeInfos[attribute.shaderLocation] = {attribute.shaderLocation, slot,
+                                                            attribute.offset, attribute.format};
+            }
+        }
+
+        HashCombine(&hash, attributesSetMask);
+        for (uint32_t i : IterateBitSet(attributesSetMask)) {
+            const VertexAttributeInfo& desc = attributeInfos[i];
             HashCombine(&hash, desc.shaderLocation, desc.inputSlot, desc.offset, desc.format);
         }
 
-        HashCombine(&hash, pipeline->mInputsSetMask);
-        for (uint32_t i : IterateBitSet(pipeline->mInputsSetMask)) {
-            const VertexBufferInfo& desc = pipeline->GetInput(i);
+        HashCombine(&hash, inputsSetMask);
+        for (uint32_t i : IterateBitSet(inputsSetMask)) {
+            const VertexBufferDescriptor& desc = vertexInput->buffers[i];
             HashCombine(&hash, desc.stride, desc.stepMode);
         }
 
-        HashCombine(&hash, pipeline->mVertexInput.indexFormat);
+        HashCombine(&hash, vertexInput->indexFormat);
 
         // Hash rasterization state
         {
-            const RasterizationStateDescriptor& desc = pipeline->mRasterizationState;
+            RasterizationStateDescriptor defaultRasterizationState;
+            const RasterizationStateDescriptor& desc =
+                descriptor->rasterizationState != nullptr ? *descriptor->rasterizationState
+                                                          : defaultRasterizationState;
             HashCombine(&hash, desc.frontFace, desc.cullMode);
             HashCombine(&hash, desc.depthBias, desc.depthBiasSlopeScale, desc.depthBiasClamp);
         }
 
         // Hash other state
-        HashCombine(&hash, pipeline->mPrimitiveTopology, pipeline->mSampleMask,
-                    pipeline->mAlphaToCoverageEnabled);
+        HashCombine(&hash, descriptor->primitiveTopology, descriptor->sampleMask,
+                    descriptor->alphaToCoverageEnabled);
 
         return hash;
     }
 
-    bool RenderPipelineBase::EqualityFunc::operator()(const RenderPipelineBase* a,
-                                                      const RenderPipelineBase* b) const {
+    bool RenderPipelineBase::IsEqualToDescriptor(
+        const RenderPipelineDescriptor* descriptor) const {
         // Check modules and layout
-        if (a->GetLayout() != b->GetLayout() || a->mVertexModule.Get() != b->mVertexModule.Get() ||
-            a->mVertexEntryPoint != b->mVertexEntryPoint ||
-            a->mFragmentModule.Get() != b->mFragmentModule.Get() ||
-            a->mFragmentEntryPoint != b->mFragmentEntryPoint) {
+        if (GetLayout() != descriptor->layout ||
+            mVertexModule.Get() != descriptor->vertexStage.module ||
+            mVertexEntryPoint != descriptor->vertexStage.entryPoint ||
+            mFragmentModule.Get() != descriptor->fragmentStage->module ||
+            mFragmentEntryPoint != descriptor->fragmentStage->entryPoint) {
             return false;
         }
 
         // Check the attachment state.
         // It contains the attachments set, texture formats, and sample count.
-        if (a->mAttachmentState.Get() != b->mAttachmentState.Get()) {
+        AttachmentStateBlueprint attachmentState(descriptor);
+        if (!AttachmentStateBlueprint::EqualityFunc()(mAttachmentState.Get(), &attachmentState)) {
             return false;
         }
 
-        for (uint32_t i : IterateBitSet(a->mAttachmentState->GetColorAttachmentsMask())) {
-            const ColorStateDescriptor& descA = *a->GetColorStateDescriptor(i);
-            const ColorStateDescriptor& descB = *b->GetColorStateDescriptor(i);
+        for (uint32_t i = 0; i < descriptor->colorStateCount; ++i) {
+            const ColorStateDescriptor& descA = mColorStates[i];
+            const ColorStateDescriptor& descB = *descriptor->colorStates[i];
             if (descA.writeMask != descB.writeMask) {
                 return false;
             }
@@ -630,9 +658,9 @@ namespace dawn_native {
             }
         }
 
-        if (a->mAttachmentState->HasDepthStencilAttachment()) {
-            const DepthStencilStateDescriptor& descA = a->mDepthStencilState;
-            const DepthStencilStateDescriptor& descB = b->mDepthStencilState;
+        if (descriptor->depthStencilState != nullptr) {
+            const DepthStencilStateDescriptor& descA = mDepthStencilState;
+            const DepthStencilStateDescriptor& descB = *descriptor->depthStencilState;
             if (descA.depthWriteEnabled != descB.depthWriteEnabled ||
                 descA.depthCompare != descB.depthCompare) {
                 return false;
@@ -655,41 +683,57 @@ namespace dawn_native {
             }
         }
 
-        // Check vertex input state
-        if (a->mAttributesSetMask != b->mAttributesSetMask) {
+        // Check vertex input state. Validation guarantees that shader locations are unique so
+        // checking each attribute of the descriptor and the number of attributes is enough.
+        VertexInputDescriptor defaultVertexInput;
+        const VertexInputDescriptor* vertexInput = descriptor->vertexInput != nullptr
+                                                       ? descriptor->vertexInput
+                                                       : &defaultVertexInput;
+
+        if (mVertexInput.indexFormat != vertexInput->indexFormat) {
             return false;
         }
 
-        for (uint32_t i : IterateBitSet(a->mAttributesSetMask)) {
-            const VertexAttributeInfo& descA = a->GetAttribute(i);
-            const VertexAttributeInfo& descB = b->GetAttribute(i);
-            if (descA.shaderLocation != descB.shaderLocation ||
-                descA.inputSlot != descB.inputSlot || descA.offset != descB.offset ||
-                descA.format != descB.format) {
-                return false;
+        size_t inputCount = 0;
+        size_t attributeCount = 0;
+        for (uint32_t slot = 0; slot < vertexInput->bufferCount; ++slot) {
+            const VertexBufferDescriptor& buffer = vertexInput->buffers[slot];
+            if (buffer.attributeCount == 0) {
+                continue;
             }
-        }
 
-        if (a->mInputsSetMask != b->mInputsSetMask) {
-            return false;
-        }
-
-        for (uint32_t i : IterateBitSet(a->mInputsSetMask)) {
-            const VertexBufferInfo& descA = a->GetInput(i);
-            const VertexBufferInfo& descB = b->GetInput(i);
-            if (descA.stride != descB.stride || descA.stepMode != descB.stepMode) {
+            if (!mInputsSetMask[slot] || mInputInfos[slot].stride != buffer.stride ||
+                mInputInfos[slot].stepMode != buffer.stepMode) {
                 return false;
             }
+            inputCount++;
+
+            for (uint32_t i = 0; i < buffer.attributeCount; ++i) {
+                const VertexAttributeDescriptor& attribute = buffer.attributes[i];
+                if (!mAttributesSetMask[attribute.shaderLocation]) {
+                    return false;
+                }
+
+                const VertexAttributeInfo& info = mAttributeInfos[attribute.shaderLocation];
+                if (info.inputSlot != slot || info.offset != attribute.offset ||
+                    info.format != attribute.format) {
+                    return false;
+                }
+            }
+            attributeCount += buffer.attributeCount;
         }
 
-        if (a->mVertexInput.indexFormat != b->mVertexInput.indexFormat) {
+        if (inputCount != mInputsSetMask.count() || attributeCount != mAttributesSetMask.count()) {
             return false;
         }
 
         // Check rasterization state
         {
-            const RasterizationStateDescriptor& descA = a->mRasterizationState;
-            const RasterizationStateDescriptor& descB = b->mRasterizationState;
+            RasterizationStateDescriptor defaultRasterizationState;
+            const RasterizationStateDescriptor& descA = mRasterizationState;
+            const RasterizationStateDescriptor& descB =
+                descriptor->rasterizationState != nullptr ? *descriptor->rasterizationState
+                                                          : defaultRasterizationState;
             if (descA.frontFace != descB.frontFace || descA.cullMode != descB.cullMode) {
                 return false;
             }
@@ -701,8 +745,9 @@ namespace dawn_native {
         }
 
         // Check other state
-        if (a->mPrimitiveTopology != b->mPrimitiveTopology || a->mSampleMask != b->mSampleMask ||
-            a->mAlphaToCoverageEnabled != b->mAlphaToCoverageEnabled) {
+        if (mPrimitiveTopology != descriptor->primitiveTopology ||
+            mSampleMask != descriptor->sampleMask ||
+            mAlphaToCoverageEnabled != descriptor->alphaToCoverageEnabled) {
             return false;
         }
 
@@ -54,9 +54,7 @@ namespace dawn_native {
 
     class RenderPipelineBase : public PipelineBase {
       public:
-        RenderPipelineBase(DeviceBase* device,
-                           const RenderPipelineDescriptor* descriptor,
-                           bool blueprint = false);
+        RenderPipelineBase(DeviceBase* device, const RenderPipelineDescriptor* descriptor);
         ~RenderPipelineBase() override;
 
         static RenderPipelineBase* MakeError(DeviceBase* device);
@@ -84,13 +82,9 @@ namespace dawn_native {
         std::bitset<kMaxVertexAttributes> GetAttributesUsingInput(uint32_t slot) const;
         std::array<std::bitset<kMaxVertexAttributes>, kMaxVertexBuffers> attributesUsingInput;
 
-        // Functors necessary for the unordered_set<RenderPipelineBase*>-based cache.
-        struct HashFunc {
-            size_t operator()(const RenderPipelineBase* pipeline) const;
-        };
-        struct EqualityFunc {
-            bool operator()(const RenderPipelineBase* a, const RenderPipelineBase* b) const;
-        };
+        // Functions necessary for the descriptor-keyed cache in DeviceBase.
+        static size_t ComputeContentHash(const RenderPipelineDescriptor* descriptor);
+        bool IsEqualToDescriptor(const RenderPipelineDescriptor* descriptor) const;
 
       private:
         RenderPipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag);
@@ -119,8 +113,6 @@ namespace dawn_native {
         std::string mVertexEntryPoint;
         Ref<ShaderModuleBase> mFragmentModule;
         std::string mFragmentEntryPoint;
-
-        bool mIsBlueprint = false;
     };
 
 }  // namespace dawn_native
@@ -52,10 +52,8 @@ namespace dawn_native {
 
     // SamplerBase
 
-    SamplerBase::SamplerBase(DeviceBase* device,
-                             const SamplerDescriptor* descriptor,
-                             bool blueprint)
-        : ObjectBase(device),
+    SamplerBase::SamplerBase(DeviceBase* device, const SamplerDescriptor* descriptor)
+        : CachedObject(device),
           mAddressModeU(descriptor->addressModeU),
           mAddressModeV(descriptor->addressModeV),
           mAddressModeW(descriptor->addressModeW),
@@ -64,17 +62,15 @@ namespace dawn_native {
           mMipmapFilter(descriptor->mipmapFilter),
           mLodMinClamp(descriptor->lodMinClamp),
           mLodMaxClamp(descriptor->lodMaxClamp),
-          mCompareFunction(descriptor->compare),
-          mIsBlueprint(blueprint) {
+          mCompareFunction(descriptor->compare) {
     }
 
     SamplerBase::SamplerBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ObjectBase(device, tag) {
+        : CachedObject(device, tag) {
     }
 
     SamplerBase::~SamplerBase() {
-        // Do not uncache the actual cached object if we are a blueprint
-        if (!mIsBlueprint && !IsError()) {
+        if (IsCachedReference()) {
             GetDevice()->UncacheSampler(this);
         }
     }
@@ -84,37 +80,36 @@ namespace dawn_native {
         return new SamplerBase(device, ObjectBase::kError);
     }
 
-    size_t SamplerBase::HashFunc::operator()(const SamplerBase* module) const {
+    // static
+    size_t SamplerBase::ComputeContentHash(const SamplerDescriptor* descriptor) {
         size_t hash = 0;
 
-        HashCombine(&hash, module->mAddressModeU);
-        HashCombine(&hash, module->mAddressModeV);
-        HashCombine(&hash, module->mAddressModeW);
-        HashCombine(&hash, module->mMagFilter);
-        HashCombine(&hash, module->mMinFilter);
-        HashCombine(&hash, module->mMipmapFilter);
-        HashCombine(&hash, module->mLodMinClamp);
-        HashCombine(&hash, module->mLodMaxClamp);
-        HashCombine(&hash, module->mCompareFunction);
+        HashCombine(&hash, descriptor->addressModeU);
+        HashCombine(&hash, descriptor->addressModeV);
+        HashCombine(&hash, descriptor->addressModeW);
+        HashCombine(&hash, descriptor->magFilter);
+        HashCombine(&hash, descriptor->minFilter);
+        HashCombine(&hash, descriptor->mipmapFilter);
+        HashCombine(&hash, descriptor->lodMinClamp);
+        HashCombine(&hash, descriptor->lodMaxClamp);
+        HashCombine(&hash, descriptor->compare);
 
         return hash;
     }
 
-    bool SamplerBase::EqualityFunc::operator()(const SamplerBase* a, const SamplerBase* b) const {
-        if (a == b) {
-            return true;
-        }
-
-        ASSERT(std::isfinite(a->mLodMinClamp));
-        ASSERT(std::isfinite(b->mLodMinClamp));
-        ASSERT(std::isfinite(a->mLodMaxClamp));
-        ASSERT(std::isfinite(b->mLodMaxClamp));
-
-        return a->mAddressModeU == b->mAddressModeU && a->mAddressModeV == b->mAddressModeV &&
-               a->mAddressModeW == b->mAddressModeW && a->mMagFilter == b->mMagFilter &&
-               a->mMinFilter == b->mMinFilter && a->mMipmapFilter == b->mMipmapFilter &&
-               a->mLodMinClamp == b->mLodMinClamp && a->mLodMaxClamp == b->mLodMaxClamp &&
-               a->mCompareFunction == b->mCompareFunction;
+    bool SamplerBase::IsEqualToDescriptor(const SamplerDescriptor* descriptor) const {
+        ASSERT(std::isfinite(mLodMinClamp));
+        ASSERT(std::isfinite(descriptor->lodMinClamp));
+        ASSERT(std::isfinite(mLodMaxClamp));
+        ASSERT(std::isfinite(descriptor->lodMaxClamp));
+
+        return mAddressModeU == descriptor->addressModeU &&
+               mAddressModeV == descriptor->addressModeV &&
+               mAddressModeW == descriptor->addressModeW && mMagFilter == descriptor->magFilter &&
+               mMinFilter == descriptor->minFilter && mMipmapFilter == descriptor->mipmapFilter &&
+               mLodMinClamp == descriptor->lodMinClamp &&
+               mLodMaxClamp == descriptor->lodMaxClamp &&
+               mCompareFunction == descriptor->compare;
     }
 
 }  // namespace dawn_native
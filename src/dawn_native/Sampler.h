@@ -15,8 +15,8 @@
 #ifndef DAWNNATIVE_SAMPLER_H_
 #define DAWNNATIVE_SAMPLER_H_
 
+#include "dawn_native/CachedObject.h"
 #include "dawn_native/Error.h"
-#include "dawn_native/ObjectBase.h"
 
 #include "dawn_native/dawn_platform.h"
 
@@ -26,22 +26,16 @@ namespace dawn_native {
 
     MaybeError ValidateSamplerDescriptor(DeviceBase* device, const SamplerDescriptor* descriptor);
 
-    class SamplerBase : public ObjectBase {
+    class SamplerBase : public CachedObject {
       public:
-        SamplerBase(DeviceBase* device,
-                    const SamplerDescriptor* descriptor,
-                    bool blueprint = false);
+        SamplerBase(DeviceBase* device, const SamplerDescriptor* descriptor);
         ~SamplerBase() override;
 
         static SamplerBase* MakeError(DeviceBase* device);
 
-        // Functors necessary for the unordered_set<SamplerBase*>-based cache.
-        struct HashFunc {
-            size_t operator()(const SamplerBase* module) const;
-        };
-        struct EqualityFunc {
-            bool operator()(const SamplerBase* a, const SamplerBase* b) const;
-        };
+        // Functions necessary for the descriptor-keyed cache in DeviceBase.
+        static size_t ComputeContentHash(const SamplerDescriptor* descriptor);
+        bool IsEqualToDescriptor(const SamplerDescriptor* descriptor) const;
 
       private:
         SamplerBase(DeviceBase* device, ObjectBase::ErrorTag tag);
@@ -56,7 +50,6 @@ namespace dawn_native {
         float mLodMinClamp;
         float mLodMaxClamp;
         dawn::CompareFunction mCompareFunction;
-        bool mIsBlueprint = false;
     };
 
 }  // namespace dawn_native
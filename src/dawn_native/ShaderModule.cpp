@@ -23,6 +23,7 @@
 #include <spirv-tools/libspirv.hpp>
 #include <spirv_cross.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 namespace dawn_native {
@@ -69,20 +70,16 @@ namespace dawn_native {
     // ShaderModuleBase
 
     ShaderModuleBase::ShaderModuleBase(DeviceBase* device,
-                                       const ShaderModuleDescriptor* descriptor,
-                                       bool blueprint)
-        : ObjectBase(device),
-          mCode(descriptor->code, descriptor->code + descriptor->codeSize),
-          mIsBlueprint(blueprint) {
+                                       const ShaderModuleDescriptor* descriptor)
+        : CachedObject(device), mCode(descriptor->code, descriptor->code + descriptor->codeSize) {
     }
 
     ShaderModuleBase::ShaderModuleBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ObjectBase(device, tag) {
+        : CachedObject(device, tag) {
     }
 
     ShaderModuleBase::~ShaderModuleBase() {
-        // Do not uncache the actual cached object if we are a blueprint
-        if (!mIsBlueprint && !IsError()) {
+        if (IsCachedReference()) {
             GetDevice()->UncacheShaderModule(this);
         }
     }
@@ -208,6 +205,11 @@ namespace dawn_native {
         return mExecutionModel;
     }
 
+    const std::vector<uint32_t>& ShaderModuleBase::GetSpirv() const {
+        ASSERT(!IsError());
+        return mCode;
+    }
+
     bool ShaderModuleBase::IsCompatibleWithPipelineLayout(const PipelineLayoutBase* layout) {
         ASSERT(!IsError());
 
@@ -253,19 +255,20 @@ namespace dawn_native {
         return true;
     }
 
-    size_t ShaderModuleBase::HashFunc::operator()(const ShaderModuleBase* module) const {
+    // static
+    size_t ShaderModuleBase::ComputeContentHash(const ShaderModuleDescriptor* descriptor) {
         size_t hash = 0;
 
-        for (uint32_t word : module->mCode) {
-            HashCombine(&hash, word);
+        for (uint32_t i = 0; i < descriptor->codeSize; ++i) {
+            HashCombine(&hash, descriptor->code[i]);
         }
 
         return hash;
     }
 
-    bool ShaderModuleBase::EqualityFunc::operator()(const ShaderModuleBase* a,
-                                                    const ShaderModuleBase* b) const {
-        return a->mCode == b->mCode;
+    bool ShaderModuleBase::IsEqualToDescriptor(const ShaderModuleDescriptor* descriptor) const {
+        return mCode.size() == descriptor->codeSize &&
+               std::equal(mCode.begin(), mCode.end(), descriptor->code);
     }
 
 }  // namespace dawn_native
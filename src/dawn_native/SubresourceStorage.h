@@ -0,0 +1,359 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_SUBRESOURCESTORAGE_H_
+#define DAWNNATIVE_SUBRESOURCESTORAGE_H_
+
+#include "common/Assert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace dawn_native {
+
+    // A range of mip levels and array layers of a texture.
+    struct SubresourceRange {
+        uint32_t baseMipLevel;
+        uint32_t levelCount;
+        uint32_t baseArrayLayer;
+        uint32_t layerCount;
+
+        static SubresourceRange SingleSubresource(uint32_t mipLevel, uint32_t arrayLayer) {
+            return {mipLevel, 1, arrayLayer, 1};
+        }
+    };
+
+    // SubresourceStorage stores a value of type T for each subresource of a texture. The values
+    // are compressed so that the common cases don't have to loop over every subresource:
+    //  - When all the subresources have the same value, only that value is stored, and updating
+    //    or iterating over the whole texture touches it once.
+    //  - Otherwise each array layer whose mip levels all have the same value stores it once,
+    //    and only the other layers store a value per mip level.
+    // Operations decompress what they modify and recompress it afterwards, and their callbacks
+    // are called once per range of subresources that share a value.
+    //
+    // T must be copy-assignable and equality comparable.
+    template <typename T>
+    class SubresourceStorage {
+      public:
+        SubresourceStorage(uint32_t mipLevelCount, uint32_t arrayLayerCount, T initialValue = {});
+
+        // Calls |updateFunc(const SubresourceRange& range, T* data)| for ranges covering the
+        // subresources of |range| exactly once, letting it modify their value.
+        template <typename F>
+        void Update(const SubresourceRange& range, F&& updateFunc);
+
+        // Calls |mergeFunc(const SubresourceRange& range, T* data, const U& otherData)| for
+        // ranges covering all the subresources exactly once, with the value of |other| for the
+        // range. |other| must have the same number of mip levels and array layers.
+        template <typename U, typename F>
+        void Merge(const SubresourceStorage<U>& other, F&& mergeFunc);
+
+        // Calls |iterateFunc(const SubresourceRange& range, const T& data)| for ranges covering
+        // the subresources of |range|, or all the subresources, exactly once.
+        template <typename F>
+        void Iterate(const SubresourceRange& range, F&& iterateFunc) const;
+        template <typename F>
+        void Iterate(F&& iterateFunc) const;
+
+        const T& Get(uint32_t mipLevel, uint32_t arrayLayer) const;
+
+        uint32_t GetMipLevelCount() const;
+        uint32_t GetArrayLayerCount() const;
+        SubresourceRange GetAllSubresources() const;
+
+        bool IsUniformForTesting() const;
+        bool IsLayerUniformForTesting(uint32_t arrayLayer) const;
+
+      private:
+        template <typename U>
+        friend class SubresourceStorage;
+
+        bool CoversAllMipLevels(const SubresourceRange& range) const;
+
+        void DecompressAll();
+        void DecompressLayer(uint32_t arrayLayer);
+        void RecompressLayer(uint32_t arrayLayer);
+        void RecompressAllIfPossible();
+
+        // Updates the levels [baseMipLevel, baseMipLevel + levelCount) of one layer of a
+        // decompressed storage. Returns whether the layer is uniform afterwards.
+        template <typename F>
+        bool UpdateLayer(uint32_t arrayLayer,
+                         uint32_t baseMipLevel,
+                         uint32_t levelCount,
+                         F&& updateFunc);
+
+        size_t DataIndex(uint32_t mipLevel, uint32_t arrayLayer) const;
+
+        uint32_t mMipLevelCount;
+        uint32_t mArrayLayerCount;
+
+        bool mIsUniform = true;
+        T mUniformData;
+
+        // Allocated the first time the storage is decompressed. The value of a uniform layer is
+        // the one of its first mip level.
+        std::unique_ptr<bool[]> mLayerIsUniform;
+        std::unique_ptr<T[]> mData;
+    };
+
+    template <typename T>
+    SubresourceStorage<T>::SubresourceStorage(uint32_t mipLevelCount,
+                                              uint32_t arrayLayerCount,
+                                              T initialValue)
+        : mMipLevelCount(mipLevelCount),
+          mArrayLayerCount(arrayLayerCount),
+          mUniformData(initialValue) {
+    }
+
+    template <typename T>
+    template <typename F>
+    void SubresourceStorage<T>::Update(const SubresourceRange& range, F&& updateFunc) {
+        ASSERT(range.baseMipLevel + range.levelCount <= mMipLevelCount);
+        ASSERT(range.baseArrayLayer + range.layerCount <= mArrayLayerCount);
+
+        if (mIsUniform) {
+            if (CoversAllMipLevels(range) && range.baseArrayLayer == 0 &&
+                range.layerCount == mArrayLayerCount) {
+                updateFunc(range, &mUniformData);
+                return;
+            }
+            DecompressAll();
+        }
+
+        bool updatedLayersAreUniform = true;
+        for (uint32_t layer = range.baseArrayLayer;
+             layer < range.baseArrayLayer + range.layerCount; ++layer) {
+            updatedLayersAreUniform &=
+                UpdateLayer(layer, range.baseMipLevel, range.levelCount, updateFunc);
+        }
+
+        // The storage can only become uniform again if all the layers that changed are.
+        if (updatedLayersAreUniform) {
+            RecompressAllIfPossible();
+        }
+    }
+
+    template <typename T>
+    template <typename U, typename F>
+    void SubresourceStorage<T>::Merge(const SubresourceStorage<U>& other, F&& mergeFunc) {
+        ASSERT(mMipLevelCount == other.mMipLevelCount);
+        ASSERT(mArrayLayerCount == other.mArrayLayerCount);
+
+        if (other.mIsUniform) {
+            const U& otherData = other.mUniformData;
+            Update(GetAllSubresources(), [&](const SubresourceRange& range, T* data) {
+                mergeFunc(range, data, otherData);
+            });
+            return;
+        }
+
+        if (mIsUniform) {
+            DecompressAll();
+        }
+
+        bool allLayersAreUniform = true;
+        for (uint32_t layer = 0; layer < mArrayLayerCount; ++layer) {
+            if (other.mLayerIsUniform[layer]) {
+                const U& otherData = other.mData[other.DataIndex(0, layer)];
+                allLayersAreUniform &= UpdateLayer(
+                    layer, 0, mMipLevelCount, [&](const SubresourceRange& range, T* data) {
+                        mergeFunc(range, data, otherData);
+                    });
+                continue;
+            }
+
+            if (mLayerIsUniform[layer]) {
+                DecompressLayer(layer);
+            }
+            for (uint32_t level = 0; level < mMipLevelCount; ++level) {
+                mergeFunc(SubresourceRange::SingleSubresource(level, layer),
+                          &mData[DataIndex(level, layer)],
+                          other.mData[other.DataIndex(level, layer)]);
+            }
+            RecompressLayer(layer);
+            allLayersAreUniform &= mLayerIsUniform[layer];
+        }
+
+        if (allLayersAreUniform) {
+            RecompressAllIfPossible();
+        }
+    }
+
+    template <typename T>
+    template <typename F>
+    void SubresourceStorage<T>::Iterate(const SubresourceRange& range, F&& iterateFunc) const {
+        ASSERT(range.baseMipLevel + range.levelCount <= mMipLevelCount);
+        ASSERT(range.baseArrayLayer + range.layerCount <= mArrayLayerCount);
+
+        if (mIsUniform) {
+            iterateFunc(range, mUniformData);
+            return;
+        }
+
+        for (uint32_t layer = range.baseArrayLayer;
+             layer < range.baseArrayLayer + range.layerCount; ++layer) {
+            if (mLayerIsUniform[layer]) {
+                iterateFunc(SubresourceRange{range.baseMipLevel, range.levelCount, layer, 1},
+                            mData[DataIndex(0, layer)]);
+                continue;
+            }
+
+            for (uint32_t level = range.baseMipLevel;
+                 level < range.baseMipLevel + range.levelCount; ++level) {
+                iterateFunc(SubresourceRange::SingleSubresource(level, layer),
+                            mData[DataIndex(level, layer)]);
+            }
+        }
+    }
+
+    template <typename T>
+    template <typename F>
+    void SubresourceStorage<T>::Iterate(F&& iterateFunc) const {
+        Iterate(GetAllSubresources(), iterateFunc);
+    }
+
+    template <typename T>
+    const T& SubresourceStorage<T>::Get(uint32_t mipLevel, uint32_t arrayLayer) const {
+        ASSERT(mipLevel < mMipLevelCount);
+        ASSERT(arrayLayer < mArrayLayerCount);
+
+        if (mIsUniform) {
+            return mUniformData;
+        }
+        if (mLayerIsUniform[arrayLayer]) {
+            return mData[DataIndex(0, arrayLayer)];
+        }
+        return mData[DataIndex(mipLevel, arrayLayer)];
+    }
+
+    template <typename T>
+    uint32_t SubresourceStorage<T>::GetMipLevelCount() const {
+        return mMipLevelCount;
+    }
+
+    template <typename T>
+    uint32_t SubresourceStorage<T>::GetArrayLayerCount() const {
+        return mArrayLayerCount;
+    }
+
+    template <typename T>
+    SubresourceRange SubresourceStorage<T>::GetAllSubresources() const {
+        return {0, mMipLevelCount, 0, mArrayLayerCount};
+    }
+
+    template <typename T>
+    bool SubresourceStorage<T>::IsUniformForTesting() const {
+        return mIsUniform;
+    }
+
+    template <typename T>
+    bool SubresourceStorage<T>::IsLayerUniformForTesting(uint32_t arrayLayer) const {
+        return mIsUniform || mLayerIsUniform[arrayLayer];
+    }
+
+    template <typename T>
+    bool SubresourceStorage<T>::CoversAllMipLevels(const SubresourceRange& range) const {
+        return range.baseMipLevel == 0 && range.levelCount == mMipLevelCount;
+    }
+
+    template <typename T>
+    void SubresourceStorage<T>::DecompressAll() {
+        ASSERT(mIsUniform);
+
+        if (mData == nullptr) {
+            mLayerIsUniform.reset(new bool[mArrayLayerCount]);
+            mData.reset(new T[static_cast<size_t>(mArrayLayerCount) * mMipLevelCount]);
+        }
+
+        for (uint32_t layer = 0; layer < mArrayLayerCount; ++layer) {
+            mLayerIsUniform[layer] = true;
+            mData[DataIndex(0, layer)] = mUniformData;
+        }
+        mIsUniform = false;
+    }
+
+    template <typename T>
+    void SubresourceStorage<T>::DecompressLayer(uint32_t arrayLayer) {
+        ASSERT(!mIsUniform && mLayerIsUniform[arrayLayer]);
+
+        const T& layerData = mData[DataIndex(0, arrayLayer)];
+        for (uint32_t level = 1; level < mMipLevelCount; ++level) {
+            mData[DataIndex(level, arrayLayer)] = layerData;
+        }
+        mLayerIsUniform[arrayLayer] = false;
+    }
+
+    template <typename T>
+    void SubresourceStorage<T>::RecompressLayer(uint32_t arrayLayer) {
+        ASSERT(!mIsUniform && !mLayerIsUniform[arrayLayer]);
+
+        const T& layerData = mData[DataIndex(0, arrayLayer)];
+        for (uint32_t level = 1; level < mMipLevelCount; ++level) {
+            if (!(mData[DataIndex(level, arrayLayer)] == layerData)) {
+                return;
+            }
+        }
+        mLayerIsUniform[arrayLayer] = true;
+    }
+
+    template <typename T>
+    void SubresourceStorage<T>::RecompressAllIfPossible() {
+        ASSERT(!mIsUniform);
+
+        const T& firstLayerData = mData[DataIndex(0, 0)];
+        for (uint32_t layer = 0; layer < mArrayLayerCount; ++layer) {
+            if (!mLayerIsUniform[layer] || !(mData[DataIndex(0, layer)] == firstLayerData)) {
+                return;
+            }
+        }
+        mUniformData = firstLayerData;
+        mIsUniform = true;
+    }
+
+    template <typename T>
+    template <typename F>
+    bool SubresourceStorage<T>::UpdateLayer(uint32_t arrayLayer,
+                                            uint32_t baseMipLevel,
+                                            uint32_t levelCount,
+                                            F&& updateFunc) {
+        ASSERT(!mIsUniform);
+
+        if (mLayerIsUniform[arrayLayer]) {
+            if (baseMipLevel == 0 && levelCount == mMipLevelCount) {
+                updateFunc(SubresourceRange{0, mMipLevelCount, arrayLayer, 1},
+                           &mData[DataIndex(0, arrayLayer)]);
+                return true;
+            }
+            DecompressLayer(arrayLayer);
+        }
+
+        for (uint32_t level = baseMipLevel; level < baseMipLevel + levelCount; ++level) {
+            updateFunc(SubresourceRange::SingleSubresource(level, arrayLayer),
+                       &mData[DataIndex(level, arrayLayer)]);
+        }
+        RecompressLayer(arrayLayer);
+        return mLayerIsUniform[arrayLayer];
+    }
+
+    template <typename T>
+    size_t SubresourceStorage<T>::DataIndex(uint32_t mipLevel, uint32_t arrayLayer) const {
+        return static_cast<size_t>(arrayLayer) * mMipLevelCount + mipLevel;
+    }
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_SUBRESOURCESTORAGE_H_
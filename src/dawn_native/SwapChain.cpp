@@ -129,6 +129,9 @@ namespace dawn_native {
 
         OnBeforePresent(texture);
 
+        // Swap chain textures aren't used after being presented, don't keep them alive.
+        GetDevice()->EvictDeduplicatedObjectsUsing(texture);
+
         mImplementation.Present(mImplementation.userData);
     }
 
@@ -18,6 +18,7 @@
 
 #include "common/Assert.h"
 #include "common/Constants.h"
+#include "common/HashUtils.h"
 #include "common/Math.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ValidationUtils_autogen.h"
@@ -327,16 +328,16 @@ namespace dawn_native {
           mMipLevelCount(descriptor->mipLevelCount),
           mSampleCount(descriptor->sampleCount),
           mUsage(descriptor->usage),
-          mState(state) {
-        uint32_t subresourceCount =
-            GetSubresourceIndex(descriptor->mipLevelCount, descriptor->arrayLayerCount);
-        mIsSubresourceContentInitializedAtIndex = std::vector<bool>(subresourceCount, false);
+          mState(state),
+          mIsSubresourceContentInitialized(descriptor->mipLevelCount,
+                                           descriptor->arrayLayerCount,
+                                           false) {
     }
 
     static Format kUnusedFormat;
 
     TextureBase::TextureBase(DeviceBase* device, ObjectBase::ErrorTag tag)
-        : ObjectBase(device, tag), mFormat(kUnusedFormat) {
+        : ObjectBase(device, tag), mFormat(kUnusedFormat), mIsSubresourceContentInitialized(0, 0) {
     }
 
     // static
@@ -344,6 +345,13 @@ namespace dawn_native {
         return new TextureBase(device, ObjectBase::kError);
     }
 
+    void TextureBase::DeleteThis() {
+        if (DeferDeletion()) {
+            return;
+        }
+        ObjectBase::DeleteThis();
+    }
+
     dawn::TextureDimension TextureBase::GetDimension() const {
         ASSERT(!IsError());
         return mDimension;
@@ -389,22 +397,23 @@ namespace dawn_native {
         return GetNumMipLevels() * arraySlice + mipLevel;
     }
 
+    SubresourceRange TextureBase::GetAllSubresources() const {
+        ASSERT(!IsError());
+        return {0, mMipLevelCount, 0, mArrayLayerCount};
+    }
+
     bool TextureBase::IsSubresourceContentInitialized(uint32_t baseMipLevel,
                                                       uint32_t levelCount,
                                                       uint32_t baseArrayLayer,
                                                       uint32_t layerCount) const {
         ASSERT(!IsError());
-        for (uint32_t mipLevel = baseMipLevel; mipLevel < baseMipLevel + levelCount; ++mipLevel) {
-            for (uint32_t arrayLayer = baseArrayLayer; arrayLayer < baseArrayLayer + layerCount;
-                 ++arrayLayer) {
-                uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer);
-                ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                if (!mIsSubresourceContentInitializedAtIndex[subresourceIndex]) {
-                    return false;
-                }
-            }
-        }
-        return true;
+        bool isInitialized = true;
+        mIsSubresourceContentInitialized.Iterate(
+            {baseMipLevel, levelCount, baseArrayLayer, layerCount},
+            [&](const SubresourceRange&, bool isRangeInitialized) {
+                isInitialized &= isRangeInitialized;
+            });
+        return isInitialized;
     }
 
     void TextureBase::SetIsSubresourceContentInitialized(uint32_t baseMipLevel,
@@ -412,14 +421,9 @@ namespace dawn_native {
                                                          uint32_t baseArrayLayer,
                                                          uint32_t layerCount) {
         ASSERT(!IsError());
-        for (uint32_t mipLevel = baseMipLevel; mipLevel < baseMipLevel + levelCount; ++mipLevel) {
-            for (uint32_t arrayLayer = baseArrayLayer; arrayLayer < baseArrayLayer + layerCount;
-                 ++arrayLayer) {
-                uint32_t subresourceIndex = GetSubresourceIndex(mipLevel, arrayLayer);
-                ASSERT(subresourceIndex < mIsSubresourceContentInitializedAtIndex.size());
-                mIsSubresourceContentInitializedAtIndex[subresourceIndex] = true;
-            }
-        }
+        mIsSubresourceContentInitialized.Update(
+            {baseMipLevel, levelCount, baseArrayLayer, layerCount},
+            [](const SubresourceRange&, bool* isInitialized) { *isInitialized = true; });
     }
 
     MaybeError TextureBase::ValidateCanUseInSubmitNow() const {
@@ -468,6 +472,7 @@ namespace dawn_native {
             return;
         }
         ASSERT(!IsError());
+        GetDevice()->EvictDeduplicatedObjectsUsing(this);
         DestroyInternal();
     }
 
@@ -492,6 +497,7 @@ namespace dawn_native {
         : ObjectBase(texture->GetDevice()),
           mTexture(texture),
           mFormat(GetDevice()->GetValidInternalFormat(descriptor->format)),
+          mDimension(descriptor->dimension),
           mBaseMipLevel(descriptor->baseMipLevel),
           mMipLevelCount(descriptor->mipLevelCount),
           mBaseArrayLayer(descriptor->baseArrayLayer),
@@ -507,6 +513,17 @@ namespace dawn_native {
         return new TextureViewBase(device, ObjectBase::kError);
     }
 
+    void TextureViewBase::DeleteThis() {
+        if (IsError()) {
+            ObjectBase::DeleteThis();
+            return;
+        }
+
+        DeviceBase* device = GetDevice();
+        this->~TextureViewBase();
+        device->GetTextureViewAllocator()->Deallocate(this);
+    }
+
     const TextureBase* TextureViewBase::GetTexture() const {
         ASSERT(!IsError());
         return mTexture.Get();
@@ -522,6 +539,11 @@ namespace dawn_native {
         return mFormat;
     }
 
+    dawn::TextureViewDimension TextureViewBase::GetDimension() const {
+        ASSERT(!IsError());
+        return mDimension;
+    }
+
     uint32_t TextureViewBase::GetBaseMipLevel() const {
         ASSERT(!IsError());
         return mBaseMipLevel;
@@ -541,4 +563,30 @@ namespace dawn_native {
         ASSERT(!IsError());
         return mArrayLayerCount;
     }
+
+    SubresourceRange TextureViewBase::GetSubresourceRange() const {
+        ASSERT(!IsError());
+        return {mBaseMipLevel, mMipLevelCount, mBaseArrayLayer, mArrayLayerCount};
+    }
+
+    // static
+    size_t TextureViewBase::ComputeContentHash(const TextureBase* texture,
+                                               const TextureViewDescriptor* descriptor) {
+        size_t hash = 0;
+        HashCombine(&hash, texture, descriptor->format, descriptor->dimension);
+        HashCombine(&hash, descriptor->baseMipLevel, descriptor->mipLevelCount,
+                    descriptor->baseArrayLayer, descriptor->arrayLayerCount);
+        return hash;
+    }
+
+    bool TextureViewBase::IsEqualToDescriptor(const TextureBase* texture,
+                                              const TextureViewDescriptor* descriptor) const {
+        ASSERT(!IsError());
+        return mTexture.Get() == texture && mFormat.format == descriptor->format &&
+               mDimension == descriptor->dimension &&
+               mBaseMipLevel == descriptor->baseMipLevel &&
+               mMipLevelCount == descriptor->mipLevelCount &&
+               mBaseArrayLayer == descriptor->baseArrayLayer &&
+               mArrayLayerCount == descriptor->arrayLayerCount;
+    }
 }  // namespace dawn_native
@@ -18,11 +18,10 @@
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/SubresourceStorage.h"
 
 #include "dawn_native/dawn_platform.h"
 
-#include <vector>
-
 namespace dawn_native {
     MaybeError ValidateTextureDescriptor(const DeviceBase* device,
                                          const TextureDescriptor* descriptor);
@@ -58,6 +57,7 @@ namespace dawn_native {
         dawn::TextureUsage GetUsage() const;
         TextureState GetTextureState() const;
         uint32_t GetSubresourceIndex(uint32_t mipLevel, uint32_t arraySlice) const;
+        SubresourceRange GetAllSubresources() const;
         bool IsSubresourceContentInitialized(uint32_t baseMipLevel,
                                              uint32_t levelCount,
                                              uint32_t baseArrayLayer,
@@ -88,6 +88,11 @@ namespace dawn_native {
 
       private:
         TextureBase(DeviceBase* device, ObjectBase::ErrorTag tag);
+
+        // Deleting the texture is deferred to the next tick with the defer_object_deletion
+        // toggle.
+        void DeleteThis() override;
+
         virtual void DestroyImpl();
 
         MaybeError ValidateDestroy() const;
@@ -101,8 +106,7 @@ namespace dawn_native {
         dawn::TextureUsage mUsage = dawn::TextureUsage::None;
         TextureState mState;
 
-        // TODO(natlee@microsoft.com): Use a more optimized data structure to save space
-        std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+        SubresourceStorage<bool> mIsSubresourceContentInitialized;
     };
 
     class TextureViewBase : public ObjectBase {
@@ -115,18 +119,32 @@ namespace dawn_native {
         TextureBase* GetTexture();
 
         const Format& GetFormat() const;
+        dawn::TextureViewDimension GetDimension() const;
         uint32_t GetBaseMipLevel() const;
         uint32_t GetLevelCount() const;
         uint32_t GetBaseArrayLayer() const;
         uint32_t GetLayerCount() const;
+        SubresourceRange GetSubresourceRange() const;
+
+        // Functions necessary for the deduplication cache in DeviceBase. The descriptor must have
+        // its defaults filled in by GetTextureViewDescriptorWithDefaults.
+        static size_t ComputeContentHash(const TextureBase* texture,
+                                         const TextureViewDescriptor* descriptor);
+        bool IsEqualToDescriptor(const TextureBase* texture,
+                                 const TextureViewDescriptor* descriptor) const;
 
       private:
         TextureViewBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        // Texture views other than error ones are allocated in the texture view allocator of
+        // their device.
+        void DeleteThis() override;
+
         Ref<TextureBase> mTexture;
 
         // TODO(cwallez@chromium.org): This should be deduplicated in the Device
         const Format& mFormat;
+        dawn::TextureViewDimension mDimension;
         uint32_t mBaseMipLevel;
         uint32_t mMipLevelCount;
         uint32_t mBaseArrayLayer;
@@ -65,7 +65,40 @@ namespace dawn_native {
                "workaround is enabled by default on all Vulkan drivers to solve an issue in the "
                "Vulkan SPEC about the texture-to-texture copies with compressed formats. See #1005 "
                "(https://github.com/KhronosGroup/Vulkan-Docs/issues/1005) for more details.",
-               "https://bugs.chromium.org/p/dawn/issues/detail?id=42"}}}};
+               "https://bugs.chromium.org/p/dawn/issues/detail?id=42"}},
+             {Toggle::DeduplicateBindGroupsAndTextureViews,
+              {"deduplicate_bind_groups_and_texture_views",
+               "Returns the same object when a bind group or a texture view is created with the "
+               "same content as one created before. The device keeps a reference to these objects "
+               "so that applications recreating the same bind groups every frame reuse them. They "
+               "are evicted when a buffer or texture they use is destroyed.",
+               ""}},
+             {Toggle::SkipValidation,
+              {"skip_validation",
+               "Skips the validation of API calls. Only use it for applications that are known to "
+               "be correct, for example because they were tested with validation enabled, as "
+               "invalid calls lead to undefined behavior. Resource usages are still tracked.",
+               ""}},
+             {Toggle::EliminateRedundantCommands,
+              {"eliminate_redundant_commands",
+               "Removes the commands that set the same pipeline, bind group, vertex or index "
+               "buffer, viewport, scissor rect, blend color or stencil reference as the one "
+               "already set, before command buffers and render bundles are given to the backend.",
+               ""}},
+             {Toggle::UseProgressThread,
+              {"use_progress_thread",
+               "Completes the submitted commands on a thread owned by the device that wakes up the "
+               "threads waiting for them, instead of checking whether they completed each time the "
+               "device is ticked. Callbacks are still called on the thread ticking the device. "
+               "Only implemented on the null backend.",
+               ""}},
+             {Toggle::DeferObjectDeletion,
+              {"defer_object_deletion",
+               "Defers the deletion of buffers, textures and bind groups whose last reference is "
+               "released to the next time the device is ticked, where they are deleted in a batch. "
+               "Releasing the last reference then only adds the object to a lock-free list, which "
+               "can be done from any thread.",
+               ""}}}};
 
     }  // anonymous namespace
 
@@ -29,6 +29,11 @@ namespace dawn_native {
         AlwaysResolveIntoZeroLevelAndLayer,
         LazyClearResourceOnFirstUse,
         UseTemporaryBufferInCompressedTextureToTextureCopy,
+        DeduplicateBindGroupsAndTextureViews,
+        SkipValidation,
+        EliminateRedundantCommands,
+        UseProgressThread,
+        DeferObjectDeletion,
 
         EnumCount,
         InvalidEnum = EnumCount,
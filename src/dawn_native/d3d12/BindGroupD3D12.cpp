@@ -24,7 +24,7 @@
 namespace dawn_native { namespace d3d12 {
 
     BindGroup::BindGroup(Device* device, const BindGroupDescriptor* descriptor)
-        : BindGroupBase(device, descriptor) {
+        : BindGroupBase(this, device, descriptor) {
     }
 
     void BindGroup::AllocateDescriptors(const DescriptorHeapHandle& cbvUavSrvHeapStart,
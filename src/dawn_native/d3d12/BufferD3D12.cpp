@@ -201,11 +201,14 @@ namespace dawn_native { namespace d3d12 {
         return ToBackend(mResourceAllocation.GetResourceHeap())->GetGPUPointer();
     }
 
-    void Buffer::OnMapCommandSerialFinished(uint32_t mapSerial, void* data, bool isWrite) {
+    void Buffer::OnMapCommandSerialFinished(uint32_t mapSerial,
+                                            void* data,
+                                            uint64_t size,
+                                            bool isWrite) {
         if (isWrite) {
-            CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+            CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, size);
         } else {
-            CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+            CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, size);
         }
     }
 
@@ -221,27 +224,29 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
-    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial) {
+    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
         mWrittenMappedRange = {};
-        D3D12_RANGE readRange = {0, GetSize()};
+        // Only the mapped range needs to be made visible to the CPU. Map() still returns a
+        // pointer to the start of the resource.
+        D3D12_RANGE readRange = {offset, offset + size};
         char* data = nullptr;
         ASSERT_SUCCESS(GetD3D12Resource()->Map(0, &readRange, reinterpret_cast<void**>(&data)));
         // There is no need to transition the resource to a new state: D3D12 seems to make the GPU
         // writes available when the fence is passed.
         MapRequestTracker* tracker = ToBackend(GetDevice())->GetMapRequestTracker();
-        tracker->Track(this, serial, data, false);
+        tracker->Track(this, serial, data + offset, size, false);
         return {};
     }
 
-    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial) {
-        mWrittenMappedRange = {0, GetSize()};
+    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
+        mWrittenMappedRange = {offset, offset + size};
         char* data = nullptr;
         ASSERT_SUCCESS(
             GetD3D12Resource()->Map(0, &mWrittenMappedRange, reinterpret_cast<void**>(&data)));
         // There is no need to transition the resource to a new state: D3D12 seems to make the CPU
         // writes available on queue submission.
         MapRequestTracker* tracker = ToBackend(GetDevice())->GetMapRequestTracker();
-        tracker->Track(this, serial, data, true);
+        tracker->Track(this, serial, data + offset, size, true);
         return {};
     }
 
@@ -261,11 +266,16 @@ namespace dawn_native { namespace d3d12 {
         ASSERT(mInflightRequests.Empty());
     }
 
-    void MapRequestTracker::Track(Buffer* buffer, uint32_t mapSerial, void* data, bool isWrite) {
+    void MapRequestTracker::Track(Buffer* buffer,
+                                  uint32_t mapSerial,
+                                  void* data,
+                                  uint64_t size,
+                                  bool isWrite) {
         Request request;
         request.buffer = buffer;
         request.mapSerial = mapSerial;
         request.data = data;
+        request.size = size;
         request.isWrite = isWrite;
 
         mInflightRequests.Enqueue(std::move(request), mDevice->GetPendingCommandSerial());
@@ -274,7 +284,7 @@ namespace dawn_native { namespace d3d12 {
     void MapRequestTracker::Tick(Serial finishedSerial) {
         for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
             request.buffer->OnMapCommandSerialFinished(request.mapSerial, request.data,
-                                                       request.isWrite);
+                                                       request.size, request.isWrite);
         }
         mInflightRequests.ClearUpTo(finishedSerial);
     }
@@ -35,7 +35,10 @@ namespace dawn_native { namespace d3d12 {
         uint32_t GetD3D12Size() const;
         ComPtr<ID3D12Resource> GetD3D12Resource() const;
         D3D12_GPU_VIRTUAL_ADDRESS GetVA() const;
-        void OnMapCommandSerialFinished(uint32_t mapSerial, void* data, bool isWrite);
+        void OnMapCommandSerialFinished(uint32_t mapSerial,
+                                        void* data,
+                                        uint64_t size,
+                                        bool isWrite);
         bool TransitionUsageAndGetResourceBarrier(D3D12_RESOURCE_BARRIER* barrier,
                                                   dawn::BufferUsage newUsage);
         void TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
@@ -43,8 +46,8 @@ namespace dawn_native { namespace d3d12 {
 
       private:
         // Dawn API
-        MaybeError MapReadAsyncImpl(uint32_t serial) override;
-        MaybeError MapWriteAsyncImpl(uint32_t serial) override;
+        MaybeError MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
+        MaybeError MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
         void UnmapImpl() override;
         void DestroyImpl() override;
 
@@ -63,7 +66,7 @@ namespace dawn_native { namespace d3d12 {
         MapRequestTracker(Device* device);
         ~MapRequestTracker();
 
-        void Track(Buffer* buffer, uint32_t mapSerial, void* data, bool isWrite);
+        void Track(Buffer* buffer, uint32_t mapSerial, void* data, uint64_t size, bool isWrite);
         void Tick(Serial finishedSerial);
 
       private:
@@ -73,6 +76,7 @@ namespace dawn_native { namespace d3d12 {
             Ref<Buffer> buffer;
             uint32_t mapSerial;
             void* data;
+            uint64_t size;
             bool isWrite;
         };
         SerialQueue<Request> mInflightRequests;
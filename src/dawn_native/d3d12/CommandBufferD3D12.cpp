@@ -15,6 +15,7 @@
 #include "dawn_native/d3d12/CommandBufferD3D12.h"
 
 #include "common/Assert.h"
+#include "common/Math.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/RenderBundle.h"
@@ -63,6 +64,76 @@ namespace dawn_native { namespace d3d12 {
             return false;
         }
 
+        // D3D12 requires the row pitch of the buffer in buffer-to-texture and texture-to-buffer
+        // copies to be a multiple of D3D12_TEXTURE_DATA_PITCH_ALIGNMENT. Copies with other row
+        // pitches go through the device's copy scratch buffer with aligned rows, to or from which
+        // the rows are repacked with buffer-to-buffer copies. A copy of a single row of texels or
+        // blocks doesn't use the row pitch, so its row pitch is aligned in place instead and this
+        // returns false.
+        bool NeedsRowPitchRepacking(const Format& format,
+                                    const Extent3D& copySize,
+                                    BufferCopy* copy) {
+            if (copy->rowPitch % D3D12_TEXTURE_DATA_PITCH_ALIGNMENT == 0) {
+                return false;
+            }
+
+            if (copySize.height <= format.blockHeight && copySize.depth == 1) {
+                copy->rowPitch = Align(copySize.width / format.blockWidth * format.blockByteSize,
+                                       D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+                return false;
+            }
+
+            return true;
+        }
+
+        void UseScratchBufferForRepacking(Device* device,
+                                          const Format& format,
+                                          const Extent3D& copySize,
+                                          BufferCopy* repackedCopy) {
+            uint32_t rowPitch = Align(copySize.width / format.blockWidth * format.blockByteSize,
+                                      D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+            uint32_t rowsPerImage = copySize.height / format.blockHeight;
+
+            repackedCopy->buffer = device->GetCopyScratchBuffer(static_cast<uint64_t>(rowPitch) *
+                                                                rowsPerImage * copySize.depth);
+            repackedCopy->offset = 0;
+            repackedCopy->rowPitch = rowPitch;
+            repackedCopy->imageHeight = copySize.height;
+        }
+
+        // Copies the rows of |copySize| from |source| to |destination|, which have different row
+        // pitches, with one buffer-to-buffer copy per row of texels or blocks.
+        void RepackBufferRows(ComPtr<ID3D12GraphicsCommandList> commandList,
+                              const Format& format,
+                              const Extent3D& copySize,
+                              const BufferCopy& source,
+                              const BufferCopy& destination) {
+            Buffer* sourceBuffer = ToBackend(source.buffer.Get());
+            Buffer* destinationBuffer = ToBackend(destination.buffer.Get());
+            sourceBuffer->TransitionUsageNow(commandList, dawn::BufferUsage::CopySrc);
+            destinationBuffer->TransitionUsageNow(commandList, dawn::BufferUsage::CopyDst);
+
+            uint64_t rowSize = copySize.width / format.blockWidth * format.blockByteSize;
+            uint32_t rowCount = copySize.height / format.blockHeight;
+            uint64_t sourceImageSize =
+                static_cast<uint64_t>(source.rowPitch) * (source.imageHeight / format.blockHeight);
+            uint64_t destinationImageSize = static_cast<uint64_t>(destination.rowPitch) *
+                                            (destination.imageHeight / format.blockHeight);
+
+            for (uint32_t z = 0; z < copySize.depth; ++z) {
+                uint64_t sourceOffset = source.offset + z * sourceImageSize;
+                uint64_t destinationOffset = destination.offset + z * destinationImageSize;
+                for (uint32_t row = 0; row < rowCount; ++row) {
+                    commandList->CopyBufferRegion(destinationBuffer->GetD3D12Resource().Get(),
+                                                  destinationOffset,
+                                                  sourceBuffer->GetD3D12Resource().Get(),
+                                                  sourceOffset, rowSize);
+                    sourceOffset += source.rowPitch;
+                    destinationOffset += destination.rowPitch;
+                }
+            }
+        }
+
     }  // anonymous namespace
 
     class BindGroupStateTracker {
@@ -469,7 +540,8 @@ namespace dawn_native { namespace d3d12 {
 
                 // Transition the usages of the color attachment and resolve target.
                 colorTexture->TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_RESOLVE_SOURCE);
-                resolveTexture->TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_RESOLVE_DEST);
+                resolveTexture->TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_RESOLVE_DEST,
+                                                   resolveTarget->GetSubresourceRange());
 
                 // Do MSAA resolve with ResolveSubResource().
                 ID3D12Resource* colorTextureHandle = colorTexture->GetD3D12Resource();
@@ -526,21 +598,24 @@ namespace dawn_native { namespace d3d12 {
 
             for (size_t i = 0; i < usages.textures.size(); ++i) {
                 Texture* texture = ToBackend(usages.textures[i]);
-                // Clear textures that are not output attachments. Output attachments will be
+                // Clear subresources that are not output attachments. Output attachments will be
                 // cleared during record render pass if the texture subresource has not been
                 // initialized before the render pass.
-                if (!(usages.textureUsages[i] & dawn::TextureUsage::OutputAttachment)) {
-                    texture->EnsureSubresourceContentInitialized(
-                        commandList, 0, texture->GetNumMipLevels(), 0, texture->GetArrayLayers());
-                }
+                usages.textureUsages[i].subresourceUsages.Iterate(
+                    [&](const SubresourceRange& range, const dawn::TextureUsage& usage) {
+                        if (usage != dawn::TextureUsage::None &&
+                            !(usage & dawn::TextureUsage::OutputAttachment)) {
+                            texture->EnsureSubresourceContentInitialized(
+                                commandList, range.baseMipLevel, range.levelCount,
+                                range.baseArrayLayer, range.layerCount);
+                        }
+                    });
             }
 
             for (size_t i = 0; i < usages.textures.size(); ++i) {
-                D3D12_RESOURCE_BARRIER barrier;
-                if (ToBackend(usages.textures[i])
-                        ->TransitionUsageAndGetResourceBarrier(&barrier, usages.textureUsages[i])) {
-                    barriers.push_back(barrier);
-                }
+                ToBackend(usages.textures[i])
+                    ->TrackUsageAndGetResourceBarrierForPass(
+                        &barriers, usages.textureUsages[i].subresourceUsages);
             }
 
             if (barriers.size()) {
@@ -591,9 +666,17 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::CopyBufferToTexture: {
                     CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
-                    Buffer* buffer = ToBackend(copy->source.buffer.Get());
                     Texture* texture = ToBackend(copy->destination.texture.Get());
 
+                    BufferCopy source = copy->source;
+                    if (NeedsRowPitchRepacking(texture->GetFormat(), copy->copySize, &source)) {
+                        UseScratchBufferForRepacking(device, texture->GetFormat(), copy->copySize,
+                                                     &source);
+                        RepackBufferRows(commandList, texture->GetFormat(), copy->copySize,
+                                         copy->source, source);
+                    }
+                    Buffer* buffer = ToBackend(source.buffer.Get());
+
                     if (IsCompleteSubresourceCopiedTo(texture, copy->copySize,
                                                       copy->destination.mipLevel)) {
                         texture->SetIsSubresourceContentInitialized(
@@ -605,11 +688,14 @@ namespace dawn_native { namespace d3d12 {
                     }
 
                     buffer->TransitionUsageNow(commandList, dawn::BufferUsage::CopySrc);
-                    texture->TransitionUsageNow(commandList, dawn::TextureUsage::CopyDst);
+                    texture->TransitionUsageNow(
+                        commandList, dawn::TextureUsage::CopyDst,
+                        SubresourceRange::SingleSubresource(copy->destination.mipLevel,
+                                                            copy->destination.arrayLayer));
 
                     auto copySplit = ComputeTextureCopySplit(
                         copy->destination.origin, copy->copySize, texture->GetFormat(),
-                        copy->source.offset, copy->source.rowPitch, copy->source.imageHeight);
+                        source.offset, source.rowPitch, source.imageHeight);
 
                     D3D12_TEXTURE_COPY_LOCATION textureLocation =
                         ComputeTextureCopyLocationForTexture(texture, copy->destination.mipLevel,
@@ -621,7 +707,7 @@ namespace dawn_native { namespace d3d12 {
                         D3D12_TEXTURE_COPY_LOCATION bufferLocation =
                             ComputeBufferLocationForCopyTextureRegion(
                                 texture, buffer->GetD3D12Resource().Get(), info.bufferSize,
-                                copySplit.offset, copy->source.rowPitch);
+                                copySplit.offset, source.rowPitch);
                         D3D12_BOX sourceRegion =
                             ComputeD3D12BoxFromOffsetAndSize(info.bufferOffset, info.copySize);
 
@@ -634,18 +720,28 @@ namespace dawn_native { namespace d3d12 {
                 case Command::CopyTextureToBuffer: {
                     CopyTextureToBufferCmd* copy = mCommands.NextCommand<CopyTextureToBufferCmd>();
                     Texture* texture = ToBackend(copy->source.texture.Get());
-                    Buffer* buffer = ToBackend(copy->destination.buffer.Get());
+
+                    BufferCopy destination = copy->destination;
+                    bool needsRepacking =
+                        NeedsRowPitchRepacking(texture->GetFormat(), copy->copySize, &destination);
+                    if (needsRepacking) {
+                        UseScratchBufferForRepacking(device, texture->GetFormat(), copy->copySize,
+                                                     &destination);
+                    }
+                    Buffer* buffer = ToBackend(destination.buffer.Get());
 
                     texture->EnsureSubresourceContentInitialized(commandList, copy->source.mipLevel,
                                                                  1, copy->source.arrayLayer, 1);
 
-                    texture->TransitionUsageNow(commandList, dawn::TextureUsage::CopySrc);
+                    texture->TransitionUsageNow(
+                        commandList, dawn::TextureUsage::CopySrc,
+                        SubresourceRange::SingleSubresource(copy->source.mipLevel,
+                                                            copy->source.arrayLayer));
                     buffer->TransitionUsageNow(commandList, dawn::BufferUsage::CopyDst);
 
                     TextureCopySplit copySplit = ComputeTextureCopySplit(
                         copy->source.origin, copy->copySize, texture->GetFormat(),
-                        copy->destination.offset, copy->destination.rowPitch,
-                        copy->destination.imageHeight);
+                        destination.offset, destination.rowPitch, destination.imageHeight);
 
                     D3D12_TEXTURE_COPY_LOCATION textureLocation =
                         ComputeTextureCopyLocationForTexture(texture, copy->source.mipLevel,
@@ -657,7 +753,7 @@ namespace dawn_native { namespace d3d12 {
                         D3D12_TEXTURE_COPY_LOCATION bufferLocation =
                             ComputeBufferLocationForCopyTextureRegion(
                                 texture, buffer->GetD3D12Resource().Get(), info.bufferSize,
-                                copySplit.offset, copy->destination.rowPitch);
+                                copySplit.offset, destination.rowPitch);
 
                         D3D12_BOX sourceRegion =
                             ComputeD3D12BoxFromOffsetAndSize(info.textureOffset, info.copySize);
@@ -666,6 +762,11 @@ namespace dawn_native { namespace d3d12 {
                                                        info.bufferOffset.y, info.bufferOffset.z,
                                                        &textureLocation, &sourceRegion);
                     }
+
+                    if (needsRepacking) {
+                        RepackBufferRows(commandList, texture->GetFormat(), copy->copySize,
+                                         destination, copy->destination);
+                    }
                 } break;
 
                 case Command::CopyTextureToTexture: {
@@ -15,7 +15,9 @@
 #include "dawn_native/d3d12/DeviceD3D12.h"
 
 #include "common/Assert.h"
+#include "common/Math.h"
 #include "dawn_native/BackendConnection.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/d3d12/AdapterD3D12.h"
 #include "dawn_native/d3d12/BackendD3D12.h"
@@ -36,7 +38,9 @@
 #include "dawn_native/d3d12/ShaderModuleD3D12.h"
 #include "dawn_native/d3d12/StagingBufferD3D12.h"
 #include "dawn_native/d3d12/SwapChainD3D12.h"
+#include "dawn_native/d3d12/TextureCopySplitter.h"
 #include "dawn_native/d3d12/TextureD3D12.h"
+#include "dawn_native/d3d12/UtilsD3D12.h"
 
 namespace dawn_native { namespace d3d12 {
 
@@ -103,6 +107,12 @@ namespace dawn_native { namespace d3d12 {
     }
 
     Device::~Device() {
+        // Release the copy scratch buffer and the deduplicated objects and delete the objects
+        // whose deletion was deferred so that their D3D12 objects are deleted below.
+        mCopyScratchBuffer = nullptr;
+        ClearDeduplicationCaches();
+        DeleteDeferredObjects();
+
         // Immediately forget about all pending commands
         if (mPendingCommands.open) {
             mPendingCommands.commandList->Close();
@@ -176,6 +186,22 @@ namespace dawn_native { namespace d3d12 {
         return mResourceAllocator.get();
     }
 
+    Buffer* Device::GetCopyScratchBuffer(uint64_t size) {
+        if (mCopyScratchBuffer.Get() == nullptr || mCopyScratchBuffer->GetSize() < size) {
+            // The resource of the previous buffer is kept alive until the commands using it
+            // completed when the buffer is destroyed.
+            BufferDescriptor descriptor;
+            descriptor.size = NextPowerOfTwo(size);
+            descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst;
+            mCopyScratchBuffer = ToBackend(CreateBuffer(&descriptor));
+            // CreateBuffer returns a buffer with a ref count of 1 that is now also referenced by
+            // the Ref<>, so the extra reference is released for the buffer to be destroyed with
+            // the Ref<>.
+            mCopyScratchBuffer->Release();
+        }
+        return mCopyScratchBuffer.Get();
+    }
+
     void Device::OpenCommandList(ComPtr<ID3D12GraphicsCommandList>* commandList) {
         ComPtr<ID3D12GraphicsCommandList>& cmdList = *commandList;
         if (!cmdList) {
@@ -265,7 +291,7 @@ namespace dawn_native { namespace d3d12 {
 
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
-        return new BindGroup(this, descriptor);
+        return AllocateBindGroup<BindGroup>(this, descriptor);
     }
     ResultOrError<BindGroupLayoutBase*> Device::CreateBindGroupLayoutImpl(
         const BindGroupLayoutDescriptor* descriptor) {
@@ -278,7 +304,7 @@ namespace dawn_native { namespace d3d12 {
     }
     CommandBufferBase* Device::CreateCommandBuffer(CommandEncoderBase* encoder,
                                                    const CommandBufferDescriptor* descriptor) {
-        return new CommandBuffer(encoder, descriptor);
+        return GetCommandBufferAllocator()->New<CommandBuffer>(encoder, descriptor);
     }
     ResultOrError<ComputePipelineBase*> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -312,7 +338,7 @@ namespace dawn_native { namespace d3d12 {
     ResultOrError<TextureViewBase*> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return new TextureView(texture, descriptor);
+        return GetTextureViewAllocator()->New<TextureView>(texture, descriptor);
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
@@ -336,6 +362,49 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* staging,
+                                                const TextureDataLayout& source,
+                                                TextureCopy* destination,
+                                                const Extent3D& copySize) {
+        ComPtr<ID3D12GraphicsCommandList> commandList = GetPendingCommandList();
+        Texture* texture = ToBackend(destination->texture.Get());
+
+        if (IsCompleteSubresourceCopiedTo(texture, copySize, destination->mipLevel)) {
+            texture->SetIsSubresourceContentInitialized(destination->mipLevel, 1,
+                                                        destination->arrayLayer, 1);
+        } else {
+            texture->EnsureSubresourceContentInitialized(commandList, destination->mipLevel, 1,
+                                                         destination->arrayLayer, 1);
+        }
+
+        texture->TransitionUsageNow(
+            commandList, dawn::TextureUsage::CopyDst,
+            SubresourceRange::SingleSubresource(destination->mipLevel, destination->arrayLayer));
+
+        TextureCopySplit copySplit =
+            ComputeTextureCopySplit(destination->origin, copySize, texture->GetFormat(),
+                                    source.offset, source.rowPitch, source.imageHeight);
+
+        D3D12_TEXTURE_COPY_LOCATION textureLocation = ComputeTextureCopyLocationForTexture(
+            texture, destination->mipLevel, destination->arrayLayer);
+
+        for (uint32_t i = 0; i < copySplit.count; ++i) {
+            TextureCopySplit::CopyInfo& info = copySplit.copies[i];
+
+            D3D12_TEXTURE_COPY_LOCATION bufferLocation = ComputeBufferLocationForCopyTextureRegion(
+                texture, ToBackend(staging)->GetResource(), info.bufferSize, copySplit.offset,
+                source.rowPitch);
+            D3D12_BOX sourceRegion =
+                ComputeD3D12BoxFromOffsetAndSize(info.bufferOffset, info.copySize);
+
+            commandList->CopyTextureRegion(&textureLocation, info.textureOffset.x,
+                                           info.textureOffset.y, info.textureOffset.z,
+                                           &bufferLocation, &sourceRegion);
+        }
+
+        return {};
+    }
+
     size_t Device::GetD3D12HeapTypeToIndex(D3D12_HEAP_TYPE heapType) const {
         ASSERT(heapType > 0);
         ASSERT(static_cast<uint32_t>(heapType) <= kNumHeapTypes);
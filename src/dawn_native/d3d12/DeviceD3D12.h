@@ -61,6 +61,11 @@ namespace dawn_native { namespace d3d12 {
         MapRequestTracker* GetMapRequestTracker() const;
         ResourceAllocator* GetResourceAllocator() const;
 
+        // Returns a buffer of at least |size| bytes that copies use as temporary storage, like the
+        // repacking of buffer-texture copies. All the copies reuse the same buffer, ordered by the
+        // transitions of its usage, and a larger one replaces it when needed.
+        Buffer* GetCopyScratchBuffer(uint64_t size);
+
         const PlatformFunctions* GetFunctions() const;
         ComPtr<IDXGIFactory4> GetFactory() const;
 
@@ -81,6 +86,10 @@ namespace dawn_native { namespace d3d12 {
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
+        MaybeError CopyFromStagingToTexture(StagingBufferBase* staging,
+                                            const TextureDataLayout& source,
+                                            TextureCopy* destination,
+                                            const Extent3D& copySize) override;
 
         ResultOrError<ResourceMemoryAllocation> AllocateMemory(
             D3D12_HEAP_TYPE heapType,
@@ -141,6 +150,8 @@ namespace dawn_native { namespace d3d12 {
         std::unique_ptr<MapRequestTracker> mMapRequestTracker;
         std::unique_ptr<ResourceAllocator> mResourceAllocator;
 
+        Ref<Buffer> mCopyScratchBuffer;
+
         static constexpr uint32_t kNumHeapTypes = 4u;  // Number of D3D12_HEAP_TYPE
 
         static_assert(D3D12_HEAP_TYPE_READBACK <= kNumHeapTypes,
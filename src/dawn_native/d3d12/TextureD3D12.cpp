@@ -271,7 +271,10 @@ namespace dawn_native { namespace d3d12 {
     }
 
     Texture::Texture(Device* device, const TextureDescriptor* descriptor)
-        : TextureBase(device, descriptor, TextureState::OwnedInternal) {
+        : TextureBase(device, descriptor, TextureState::OwnedInternal),
+          mSubresourceStateAndDecay(descriptor->mipLevelCount,
+                                    descriptor->arrayLayerCount,
+                                    {D3D12_RESOURCE_STATE_COMMON, UINT64_MAX, false}) {
         D3D12_RESOURCE_DESC resourceDescriptor;
         resourceDescriptor.Dimension = D3D12TextureDimension(GetDimension());
         resourceDescriptor.Alignment = 0;
@@ -306,7 +309,11 @@ namespace dawn_native { namespace d3d12 {
     Texture::Texture(Device* device,
                      const TextureDescriptor* descriptor,
                      ID3D12Resource* nativeTexture)
-        : TextureBase(device, descriptor, TextureState::OwnedExternal), mResource(nativeTexture) {
+        : TextureBase(device, descriptor, TextureState::OwnedExternal),
+          mResource(nativeTexture),
+          mSubresourceStateAndDecay(descriptor->mipLevelCount,
+                                    descriptor->arrayLayerCount,
+                                    {D3D12_RESOURCE_STATE_COMMON, UINT64_MAX, false}) {
         SetIsSubresourceContentInitialized(0, descriptor->mipLevelCount, 0,
                                            descriptor->arrayLayerCount);
     }
@@ -338,27 +345,59 @@ namespace dawn_native { namespace d3d12 {
         }
     }
 
-    // When true is returned, a D3D12_RESOURCE_BARRIER has been created and must be used in a
-    // ResourceBarrier call. Failing to do so will cause the tracked state to become invalid and can
-    // cause subsequent errors.
-    bool Texture::TransitionUsageAndGetResourceBarrier(D3D12_RESOURCE_BARRIER* barrier,
-                                                       dawn::TextureUsage newUsage) {
-        return TransitionUsageAndGetResourceBarrier(barrier,
-                                                    D3D12TextureUsage(newUsage, GetFormat()));
+    bool Texture::StateAndDecay::operator==(const Texture::StateAndDecay& other) const {
+        return lastState == other.lastState && lastDecaySerial == other.lastDecaySerial &&
+               isValidToDecay == other.isValidToDecay;
     }
 
-    // When true is returned, a D3D12_RESOURCE_BARRIER has been created and must be used in a
-    // ResourceBarrier call. Failing to do so will cause the tracked state to become invalid and can
-    // cause subsequent errors.
-    bool Texture::TransitionUsageAndGetResourceBarrier(D3D12_RESOURCE_BARRIER* barrier,
-                                                       D3D12_RESOURCE_STATES newState) {
+    // The barriers added to |barriers| must be used in a ResourceBarrier call. Failing to do so
+    // will cause the tracked state to become invalid and can cause subsequent errors.
+    void Texture::TrackUsageAndGetResourceBarrierForPass(
+        std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+        const SubresourceStorage<dawn::TextureUsage>& passUsages) {
+        const Serial pendingCommandSerial = ToBackend(GetDevice())->GetPendingCommandSerial();
+        const Format& format = GetFormat();
+
+        mSubresourceStateAndDecay.Merge(
+            passUsages, [&](const SubresourceRange& range, StateAndDecay* state,
+                            const dawn::TextureUsage& usage) {
+                // Subresources that aren't used by the pass keep their state.
+                if (usage == dawn::TextureUsage::None) {
+                    return;
+                }
+                TransitionSubresourceRange(barriers, range, state,
+                                           D3D12TextureUsage(usage, format),
+                                           pendingCommandSerial);
+            });
+    }
+
+    // The barriers added to |barriers| must be used in a ResourceBarrier call. Failing to do so
+    // will cause the tracked state to become invalid and can cause subsequent errors.
+    void Texture::TransitionUsageAndGetResourceBarrier(
+        std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+        D3D12_RESOURCE_STATES newState,
+        const SubresourceRange& range) {
+        const Serial pendingCommandSerial = ToBackend(GetDevice())->GetPendingCommandSerial();
+
+        mSubresourceStateAndDecay.Update(
+            range, [&](const SubresourceRange& updatedRange, StateAndDecay* state) {
+                TransitionSubresourceRange(barriers, updatedRange, state, newState,
+                                           pendingCommandSerial);
+            });
+    }
+
+    void Texture::TransitionSubresourceRange(std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+                                             const SubresourceRange& range,
+                                             StateAndDecay* state,
+                                             D3D12_RESOURCE_STATES newState,
+                                             Serial pendingCommandSerial) {
         // Avoid transitioning the texture when it isn't needed.
         // TODO(cwallez@chromium.org): Need some form of UAV barriers at some point.
-        if (mLastState == newState) {
-            return false;
+        if (state->lastState == newState) {
+            return;
         }
 
-        D3D12_RESOURCE_STATES lastState = mLastState;
+        D3D12_RESOURCE_STATES lastState = state->lastState;
 
         // The COMMON state represents a state where no write operations can be pending, and where
         // all pixels are uncompressed. This makes it possible to transition to and from some states
@@ -374,13 +413,12 @@ namespace dawn_native { namespace d3d12 {
         // occur. When that texture is used again, the previously recorded serial must be compared
         // to the last completed serial to determine if the texture has implicity decayed to the
         // common state.
-        const Serial pendingCommandSerial = ToBackend(GetDevice())->GetPendingCommandSerial();
-        if (mValidToDecay && pendingCommandSerial > mLastUsedSerial) {
+        if (state->isValidToDecay && pendingCommandSerial > state->lastDecaySerial) {
             lastState = D3D12_RESOURCE_STATE_COMMON;
         }
 
         // Update the tracked state.
-        mLastState = newState;
+        state->lastState = newState;
 
         // Destination states that qualify for an implicit promotion for a non-simultaneous-access
         // texture: NON_PIXEL_SHADER_RESOURCE, PIXEL_SHADER_RESOURCE, COPY_SRC, COPY_DEST.
@@ -392,42 +430,71 @@ namespace dawn_native { namespace d3d12 {
             if (lastState == D3D12_RESOURCE_STATE_COMMON) {
                 if (newState == (newState & kD3D12TextureReadOnlyStates)) {
                     // Implicit texture state decays can only occur when the texture was implicitly
-                    // transitioned to a read-only state. mValidToDecay is needed to differentiate
+                    // transitioned to a read-only state. isValidToDecay is needed to differentiate
                     // between resources that were implictly or explicitly transitioned to a
                     // read-only state.
-                    mValidToDecay = true;
-                    mLastUsedSerial = pendingCommandSerial;
-                    return false;
+                    state->isValidToDecay = true;
+                    state->lastDecaySerial = pendingCommandSerial;
+                    return;
                 } else if (newState == D3D12_RESOURCE_STATE_COPY_DEST) {
-                    mValidToDecay = false;
-                    return false;
+                    state->isValidToDecay = false;
+                    return;
                 }
             }
         }
 
-        barrier->Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier->Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier->Transition.pResource = mResource.Get();
-        barrier->Transition.StateBefore = lastState;
-        barrier->Transition.StateAfter = newState;
-        barrier->Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        state->isValidToDecay = false;
 
-        mValidToDecay = false;
+        D3D12_RESOURCE_BARRIER barrier;
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Transition.pResource = mResource.Get();
+        barrier.Transition.StateBefore = lastState;
+        barrier.Transition.StateAfter = newState;
+
+        // Use a single barrier when the whole texture is transitioned, and a barrier per
+        // subresource otherwise.
+        if (range.baseMipLevel == 0 && range.levelCount == GetNumMipLevels() &&
+            range.baseArrayLayer == 0 && range.layerCount == GetArrayLayers()) {
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            barriers->push_back(barrier);
+            return;
+        }
 
-        return true;
+        for (uint32_t arrayLayer = range.baseArrayLayer;
+             arrayLayer < range.baseArrayLayer + range.layerCount; ++arrayLayer) {
+            for (uint32_t mipLevel = range.baseMipLevel;
+                 mipLevel < range.baseMipLevel + range.levelCount; ++mipLevel) {
+                barrier.Transition.Subresource = GetSubresourceIndex(mipLevel, arrayLayer);
+                barriers->push_back(barrier);
+            }
+        }
     }
 
     void Texture::TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
                                      dawn::TextureUsage usage) {
-        TransitionUsageNow(commandList, D3D12TextureUsage(usage, GetFormat()));
+        TransitionUsageNow(commandList, D3D12TextureUsage(usage, GetFormat()),
+                           GetAllSubresources());
     }
 
     void Texture::TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
                                      D3D12_RESOURCE_STATES newState) {
-        D3D12_RESOURCE_BARRIER barrier;
+        TransitionUsageNow(commandList, newState, GetAllSubresources());
+    }
 
-        if (TransitionUsageAndGetResourceBarrier(&barrier, newState)) {
-            commandList->ResourceBarrier(1, &barrier);
+    void Texture::TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
+                                     dawn::TextureUsage usage,
+                                     const SubresourceRange& range) {
+        TransitionUsageNow(commandList, D3D12TextureUsage(usage, GetFormat()), range);
+    }
+
+    void Texture::TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
+                                     D3D12_RESOURCE_STATES newState,
+                                     const SubresourceRange& range) {
+        std::vector<D3D12_RESOURCE_BARRIER> barriers;
+        TransitionUsageAndGetResourceBarrier(&barriers, newState, range);
+        if (barriers.size()) {
+            commandList->ResourceBarrier(barriers.size(), barriers.data());
         }
     }
 
@@ -490,10 +557,11 @@ namespace dawn_native { namespace d3d12 {
 
         Device* device = ToBackend(GetDevice());
         DescriptorHeapAllocator* descriptorHeapAllocator = device->GetDescriptorHeapAllocator();
+        const SubresourceRange range = {baseMipLevel, levelCount, baseArrayLayer, layerCount};
         uint8_t clearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0 : 1;
         if (GetFormat().isRenderable) {
             if (GetFormat().HasDepthOrStencil()) {
-                TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+                TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_DEPTH_WRITE, range);
                 DescriptorHeapHandle dsvHeap =
                     descriptorHeapAllocator->AllocateCPUHeap(D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1);
                 D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = dsvHeap.GetCPUHandle(0);
@@ -512,7 +580,7 @@ namespace dawn_native { namespace d3d12 {
                 commandList->ClearDepthStencilView(dsvHandle, clearFlags, clearColor, clearColor, 0,
                                                    nullptr);
             } else {
-                TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_RENDER_TARGET);
+                TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_RENDER_TARGET, range);
                 DescriptorHeapHandle rtvHeap =
                     descriptorHeapAllocator->AllocateCPUHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1);
                 D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = rtvHeap.GetCPUHandle(0);
@@ -546,7 +614,7 @@ namespace dawn_native { namespace d3d12 {
                       reinterpret_cast<uint32_t*>(uploadHandle.mappedBuffer + bufferSize),
                       clearColor);
 
-            TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_COPY_DEST);
+            TransitionUsageNow(commandList, D3D12_RESOURCE_STATE_COPY_DEST, range);
 
             // compute d3d12 texture copy locations for texture and buffer
             Extent3D copySize = {GetSize().width, GetSize().height, 1};
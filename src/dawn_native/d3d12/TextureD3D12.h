@@ -20,6 +20,8 @@
 
 #include "dawn_native/d3d12/d3d12_platform.h"
 
+#include <vector>
+
 namespace dawn_native { namespace d3d12 {
 
     class Device;
@@ -37,12 +39,22 @@ namespace dawn_native { namespace d3d12 {
 
         DXGI_FORMAT GetD3D12Format() const;
         ID3D12Resource* GetD3D12Resource() const;
-        bool TransitionUsageAndGetResourceBarrier(D3D12_RESOURCE_BARRIER* barrier,
-                                                  dawn::TextureUsage newUsage);
+
+        // The state of the texture is tracked per subresource. Transitions of the whole texture
+        // use a single barrier when all its subresources are in the same state.
+        void TrackUsageAndGetResourceBarrierForPass(
+            std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+            const SubresourceStorage<dawn::TextureUsage>& passUsages);
         void TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
                                 dawn::TextureUsage usage);
         void TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
                                 D3D12_RESOURCE_STATES newState);
+        void TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
+                                dawn::TextureUsage usage,
+                                const SubresourceRange& range);
+        void TransitionUsageNow(ComPtr<ID3D12GraphicsCommandList> commandList,
+                                D3D12_RESOURCE_STATES newState,
+                                const SubresourceRange& range);
 
         D3D12_RENDER_TARGET_VIEW_DESC GetRTVDescriptor(uint32_t baseMipLevel,
                                                        uint32_t baseArrayLayer,
@@ -66,14 +78,25 @@ namespace dawn_native { namespace d3d12 {
 
         UINT16 GetDepthOrArraySize();
 
-        bool TransitionUsageAndGetResourceBarrier(D3D12_RESOURCE_BARRIER* barrier,
-                                                  D3D12_RESOURCE_STATES newState);
+        struct StateAndDecay {
+            D3D12_RESOURCE_STATES lastState;
+            Serial lastDecaySerial;
+            bool isValidToDecay;
 
-        ComPtr<ID3D12Resource> mResource;
-        D3D12_RESOURCE_STATES mLastState = D3D12_RESOURCE_STATES::D3D12_RESOURCE_STATE_COMMON;
+            bool operator==(const StateAndDecay& other) const;
+        };
+
+        void TransitionUsageAndGetResourceBarrier(std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+                                                  D3D12_RESOURCE_STATES newState,
+                                                  const SubresourceRange& range);
+        void TransitionSubresourceRange(std::vector<D3D12_RESOURCE_BARRIER>* barriers,
+                                        const SubresourceRange& range,
+                                        StateAndDecay* state,
+                                        D3D12_RESOURCE_STATES newState,
+                                        Serial pendingCommandSerial);
 
-        Serial mLastUsedSerial = UINT64_MAX;
-        bool mValidToDecay = false;
+        ComPtr<ID3D12Resource> mResource;
+        SubresourceStorage<StateAndDecay> mSubresourceStateAndDecay;
     };
 
     class TextureView : public TextureViewBase {
@@ -31,12 +31,15 @@ namespace dawn_native { namespace metal {
 
         id<MTLBuffer> GetMTLBuffer() const;
 
-        void OnMapCommandSerialFinished(uint32_t mapSerial, bool isWrite);
+        void OnMapCommandSerialFinished(uint32_t mapSerial,
+                                        uint64_t offset,
+                                        uint64_t size,
+                                        bool isWrite);
 
       private:
         // Dawn API
-        MaybeError MapReadAsyncImpl(uint32_t serial) override;
-        MaybeError MapWriteAsyncImpl(uint32_t serial) override;
+        MaybeError MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
+        MaybeError MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
         void UnmapImpl() override;
         void DestroyImpl() override;
 
@@ -51,7 +54,11 @@ namespace dawn_native { namespace metal {
         MapRequestTracker(Device* device);
         ~MapRequestTracker();
 
-        void Track(Buffer* buffer, uint32_t mapSerial, bool isWrite);
+        void Track(Buffer* buffer,
+                   uint32_t mapSerial,
+                   uint64_t offset,
+                   uint64_t size,
+                   bool isWrite);
         void Tick(Serial finishedSerial);
 
       private:
@@ -60,6 +67,8 @@ namespace dawn_native { namespace metal {
         struct Request {
             Ref<Buffer> buffer;
             uint32_t mapSerial;
+            uint64_t offset;
+            uint64_t size;
             bool isWrite;
         };
         SerialQueue<Request> mInflightRequests;
@@ -50,12 +50,15 @@ namespace dawn_native { namespace metal {
         return mMtlBuffer;
     }
 
-    void Buffer::OnMapCommandSerialFinished(uint32_t mapSerial, bool isWrite) {
-        char* data = reinterpret_cast<char*>([mMtlBuffer contents]);
+    void Buffer::OnMapCommandSerialFinished(uint32_t mapSerial,
+                                            uint64_t offset,
+                                            uint64_t size,
+                                            bool isWrite) {
+        char* data = reinterpret_cast<char*>([mMtlBuffer contents]) + offset;
         if (isWrite) {
-            CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+            CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, size);
         } else {
-            CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+            CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, size);
         }
     }
 
@@ -69,15 +72,15 @@ namespace dawn_native { namespace metal {
         return {};
     }
 
-    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial) {
+    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
         MapRequestTracker* tracker = ToBackend(GetDevice())->GetMapTracker();
-        tracker->Track(this, serial, false);
+        tracker->Track(this, serial, offset, size, false);
         return {};
     }
 
-    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial) {
+    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
         MapRequestTracker* tracker = ToBackend(GetDevice())->GetMapTracker();
-        tracker->Track(this, serial, true);
+        tracker->Track(this, serial, offset, size, true);
         return {};
     }
 
@@ -99,10 +102,14 @@ namespace dawn_native { namespace metal {
 
     void MapRequestTracker::Track(Buffer* buffer,
                                   uint32_t mapSerial,
+                                  uint64_t offset,
+                                  uint64_t size,
                                   bool isWrite) {
         Request request;
         request.buffer = buffer;
         request.mapSerial = mapSerial;
+        request.offset = offset;
+        request.size = size;
         request.isWrite = isWrite;
 
         mInflightRequests.Enqueue(std::move(request), mDevice->GetPendingCommandSerial());
@@ -110,7 +117,8 @@ namespace dawn_native { namespace metal {
 
     void MapRequestTracker::Tick(Serial finishedSerial) {
         for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
-            request.buffer->OnMapCommandSerialFinished(request.mapSerial, request.isWrite);
+            request.buffer->OnMapCommandSerialFinished(request.mapSerial, request.offset,
+                                                       request.size, request.isWrite);
         }
         mInflightRequests.ClearUpTo(finishedSerial);
     }
@@ -17,6 +17,7 @@
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/metal/BufferMTL.h"
 #include "dawn_native/metal/CommandBufferMTL.h"
@@ -31,6 +32,7 @@
 #include "dawn_native/metal/TextureMTL.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace dawn_native { namespace metal {
@@ -52,6 +54,9 @@ namespace dawn_native { namespace metal {
     }
 
     Device::~Device() {
+        ClearDeduplicationCaches();
+        DeleteDeferredObjects();
+
         // Wait for all commands to be finished so we can free resources SubmitPendingCommandBuffer
         // may not increment the pendingCommandSerial if there are no pending commands, so we can't
         // store the pendingSerial before SubmitPendingCommandBuffer then wait for it to be passed.
@@ -87,7 +92,7 @@ namespace dawn_native { namespace metal {
 
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
-        return new BindGroup(this, descriptor);
+        return AllocateBindGroup<BindGroup>(this, descriptor);
     }
     ResultOrError<BindGroupLayoutBase*> Device::CreateBindGroupLayoutImpl(
         const BindGroupLayoutDescriptor* descriptor) {
@@ -98,7 +103,7 @@ namespace dawn_native { namespace metal {
     }
     CommandBufferBase* Device::CreateCommandBuffer(CommandEncoderBase* encoder,
                                                    const CommandBufferDescriptor* descriptor) {
-        return new CommandBuffer(encoder, descriptor);
+        return GetCommandBufferAllocator()->New<CommandBuffer>(encoder, descriptor);
     }
     ResultOrError<ComputePipelineBase*> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -132,7 +137,7 @@ namespace dawn_native { namespace metal {
     ResultOrError<TextureViewBase*> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return new TextureView(texture, descriptor);
+        return GetTextureViewAllocator()->New<TextureView>(texture, descriptor);
     }
 
     Serial Device::GetCompletedCommandSerial() const {
@@ -258,6 +263,35 @@ namespace dawn_native { namespace metal {
         return {};
     }
 
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* staging,
+                                                const TextureDataLayout& source,
+                                                TextureCopy* destination,
+                                                const Extent3D& copySize) {
+        Texture* texture = ToBackend(destination->texture.Get());
+        const Format& format = texture->GetFormat();
+
+        // The blocks on the edge of the mip level must be clamped to its virtual size.
+        Extent3D virtualSize = texture->GetMipLevelVirtualSize(destination->mipLevel);
+        const Origin3D& origin = destination->origin;
+        uint32_t width = std::min(copySize.width, virtualSize.width - origin.x);
+        uint32_t height = std::min(copySize.height, virtualSize.height - origin.y);
+
+        id<MTLCommandBuffer> commandBuffer = GetPendingCommandBuffer();
+        id<MTLBlitCommandEncoder> encoder = [commandBuffer blitCommandEncoder];
+        [encoder copyFromBuffer:ToBackend(staging)->GetBufferHandle()
+                   sourceOffset:source.offset
+              sourceBytesPerRow:source.rowPitch
+            sourceBytesPerImage:source.rowPitch * (source.imageHeight / format.blockHeight)
+                     sourceSize:MTLSizeMake(width, height, 1)
+                      toTexture:texture->GetMTLTexture()
+               destinationSlice:destination->arrayLayer
+               destinationLevel:destination->mipLevel
+              destinationOrigin:MTLOriginMake(origin.x, origin.y, origin.z)];
+        [encoder endEncoding];
+
+        return {};
+    }
+
     TextureBase* Device::CreateTextureWrappingIOSurface(const TextureDescriptor* descriptor,
                                                         IOSurfaceRef ioSurface,
                                                         uint32_t plane) {
@@ -0,0 +1,3720 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/null/ComputeProgramNull.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+
+#include <spirv.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace dawn_native { namespace null {
+
+    enum class ComputeProgram::Op : uint16_t {
+        // Component-wise operations on the 32-bit words of the operands.
+        IAdd,
+        ISub,
+        IMul,
+        UDiv,
+        SDiv,
+        UMod,
+        SRem,
+        SMod,
+        ShiftLeftLogical,
+        ShiftRightLogical,
+        ShiftRightArithmetic,
+        BitwiseAnd,
+        BitwiseOr,
+        BitwiseXor,
+        Not,
+        SNegate,
+        BitCount,
+        BitReverse,
+        FAdd,
+        FSub,
+        FMul,
+        FDiv,
+        FRem,
+        FMod,
+        FNegate,
+        IEqual,
+        INotEqual,
+        UGreaterThan,
+        SGreaterThan,
+        UGreaterThanEqual,
+        SGreaterThanEqual,
+        ULessThan,
+        SLessThan,
+        ULessThanEqual,
+        SLessThanEqual,
+        FOrdEqual,
+        FUnordEqual,
+        FOrdNotEqual,
+        FUnordNotEqual,
+        FOrdLessThan,
+        FUnordLessThan,
+        FOrdGreaterThan,
+        FUnordGreaterThan,
+        FOrdLessThanEqual,
+        FUnordLessThanEqual,
+        FOrdGreaterThanEqual,
+        FUnordGreaterThanEqual,
+        LogicalEqual,
+        LogicalNotEqual,
+        LogicalOr,
+        LogicalAnd,
+        LogicalNot,
+        IsNan,
+        IsInf,
+        ConvertFToU,
+        ConvertFToS,
+        ConvertSToF,
+        ConvertUToF,
+        Select,
+        ExtInst,
+
+        // Operations on vectors and matrices.
+        Any,
+        All,
+        Dot,
+        VectorTimesScalar,
+        MatrixTimesVector,
+        VectorTimesMatrix,
+        MatrixTimesMatrix,
+
+        // Copies of words between registers.
+        Gather,
+        VectorExtractDynamic,
+        VectorInsertDynamic,
+        Phi,
+
+        // Memory operations, on pointers made of a memory region and an offset in it.
+        AccessChain,
+        ArrayLength,
+        Load,
+        Store,
+        AtomicLoad,
+        AtomicStore,
+        AtomicExchange,
+        AtomicCompareExchange,
+        AtomicIIncrement,
+        AtomicIDecrement,
+        AtomicIAdd,
+        AtomicISub,
+        AtomicSMin,
+        AtomicUMin,
+        AtomicSMax,
+        AtomicUMax,
+        AtomicAnd,
+        AtomicOr,
+        AtomicXor,
+
+        // Operations changing the program counter of the lanes.
+        Branch,
+        BranchConditional,
+        Switch,
+        FunctionCall,
+        Return,
+        Barrier,
+        Kill,
+    };
+
+    namespace {
+
+        constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+        // The offset of pointers that are out of the bounds of any memory region.
+        constexpr uint32_t kOutOfBounds = std::numeric_limits<uint32_t>::max();
+        // Variables are aligned like vec4s in the private and workgroup memory.
+        constexpr uint32_t kVariableAlignment = 16;
+        // The maximum number of invocations of a workgroup, like in Vulkan.
+        constexpr uint32_t kMaxInvocationCount = 1024;
+        // Dispatches only use worker threads when each of them runs at least this many
+        // invocations, since starting a thread is slower than running small workgroups.
+        constexpr uint64_t kMinInvocationsPerWorker = 4096;
+
+        constexpr uint32_t kGlslStd450Round = 1;
+        constexpr uint32_t kGlslStd450RoundEven = 2;
+        constexpr uint32_t kGlslStd450Trunc = 3;
+        constexpr uint32_t kGlslStd450FAbs = 4;
+        constexpr uint32_t kGlslStd450SAbs = 5;
+        constexpr uint32_t kGlslStd450FSign = 6;
+        constexpr uint32_t kGlslStd450SSign = 7;
+        constexpr uint32_t kGlslStd450Floor = 8;
+        constexpr uint32_t kGlslStd450Ceil = 9;
+        constexpr uint32_t kGlslStd450Fract = 10;
+        constexpr uint32_t kGlslStd450Sin = 13;
+        constexpr uint32_t kGlslStd450Cos = 14;
+        constexpr uint32_t kGlslStd450Tan = 15;
+        constexpr uint32_t kGlslStd450Asin = 16;
+        constexpr uint32_t kGlslStd450Acos = 17;
+        constexpr uint32_t kGlslStd450Atan = 18;
+        constexpr uint32_t kGlslStd450Atan2 = 25;
+        constexpr uint32_t kGlslStd450Pow = 26;
+        constexpr uint32_t kGlslStd450Exp = 27;
+        constexpr uint32_t kGlslStd450Log = 28;
+        constexpr uint32_t kGlslStd450Exp2 = 29;
+        constexpr uint32_t kGlslStd450Log2 = 30;
+        constexpr uint32_t kGlslStd450Sqrt = 31;
+        constexpr uint32_t kGlslStd450InverseSqrt = 32;
+        constexpr uint32_t kGlslStd450FMin = 37;
+        constexpr uint32_t kGlslStd450UMin = 38;
+        constexpr uint32_t kGlslStd450SMin = 39;
+        constexpr uint32_t kGlslStd450FMax = 40;
+        constexpr uint32_t kGlslStd450UMax = 41;
+        constexpr uint32_t kGlslStd450SMax = 42;
+        constexpr uint32_t kGlslStd450FClamp = 43;
+        constexpr uint32_t kGlslStd450UClamp = 44;
+        constexpr uint32_t kGlslStd450SClamp = 45;
+        constexpr uint32_t kGlslStd450FMix = 46;
+        constexpr uint32_t kGlslStd450Step = 48;
+        constexpr uint32_t kGlslStd450SmoothStep = 49;
+        constexpr uint32_t kGlslStd450Fma = 50;
+        constexpr uint32_t kGlslStd450Length = 66;
+        constexpr uint32_t kGlslStd450Distance = 67;
+        constexpr uint32_t kGlslStd450Cross = 68;
+        constexpr uint32_t kGlslStd450Normalize = 69;
+        constexpr uint32_t kGlslStd450FindILsb = 73;
+        constexpr uint32_t kGlslStd450FindSMsb = 74;
+        constexpr uint32_t kGlslStd450FindUMsb = 75;
+        constexpr uint32_t kGlslStd450NMin = 79;
+        constexpr uint32_t kGlslStd450NMax = 80;
+        constexpr uint32_t kGlslStd450NClamp = 81;
+
+        float AsFloat(uint32_t word) {
+            return BitCast<float>(word);
+        }
+
+        int32_t AsInt(uint32_t word) {
+            return BitCast<int32_t>(word);
+        }
+
+        uint32_t ToWord(uint32_t value) {
+            return value;
+        }
+
+        uint32_t ToWord(int32_t value) {
+            return BitCast<uint32_t>(value);
+        }
+
+        uint32_t ToWord(float value) {
+            return BitCast<uint32_t>(value);
+        }
+
+        uint32_t ToWord(bool value) {
+            return value ? 1u : 0u;
+        }
+
+        uint32_t LoadWord(const uint8_t* data) {
+            uint32_t word;
+            memcpy(&word, data, sizeof(word));
+            return word;
+        }
+
+        void StoreWord(uint8_t* data, uint32_t word) {
+            memcpy(data, &word, sizeof(word));
+        }
+
+        // Conversions from floats to integers saturate instead of being undefined.
+        uint32_t FloatToUint(float value) {
+            if (!(value > 0.0f)) {
+                return 0;
+            }
+            if (value >= 4294967296.0f) {
+                return std::numeric_limits<uint32_t>::max();
+            }
+            return static_cast<uint32_t>(value);
+        }
+
+        int32_t FloatToInt(float value) {
+            if (std::isnan(value)) {
+                return 0;
+            }
+            if (value <= -2147483648.0f) {
+                return std::numeric_limits<int32_t>::min();
+            }
+            if (value >= 2147483648.0f) {
+                return std::numeric_limits<int32_t>::max();
+            }
+            return static_cast<int32_t>(value);
+        }
+
+        // Integer divisions by zero and overflowing divisions are undefined in SPIR-V, they
+        // return zero instead of trapping.
+        int32_t SafeSDiv(int32_t a, int32_t b) {
+            if (b == 0 || (a == std::numeric_limits<int32_t>::min() && b == -1)) {
+                return 0;
+            }
+            return a / b;
+        }
+
+        int32_t SafeSRem(int32_t a, int32_t b) {
+            if (b == 0 || b == -1) {
+                return 0;
+            }
+            return a % b;
+        }
+
+        int32_t SafeSMod(int32_t a, int32_t b) {
+            int32_t remainder = SafeSRem(a, b);
+            if (remainder != 0 && ((remainder < 0) != (b < 0))) {
+                remainder += b;
+            }
+            return remainder;
+        }
+
+        uint32_t BitReverse(uint32_t value) {
+            uint32_t result = 0;
+            for (uint32_t i = 0; i < 32; ++i) {
+                result = (result << 1) | ((value >> i) & 1);
+            }
+            return result;
+        }
+
+        uint32_t BitCount(uint32_t value) {
+            uint32_t count = 0;
+            for (; value != 0; value &= value - 1) {
+                ++count;
+            }
+            return count;
+        }
+
+        int32_t FindMsb(uint32_t value) {
+            int32_t msb = -1;
+            for (; value != 0; value >>= 1) {
+                ++msb;
+            }
+            return msb;
+        }
+
+        struct MemoryRegion {
+            uint8_t* data;
+            uint32_t size;
+        };
+
+    }  // anonymous namespace
+
+    // Compiler
+
+    // Lowers the SPIR-V of the module to the instructions of the program. Values are allocated
+    // registers once, since SPIR-V doesn't allow recursion each function has a single frame.
+    class ComputeProgram::Compiler {
+      public:
+        Compiler(ComputeProgram* program,
+                 const std::vector<uint32_t>& spirv,
+                 const std::string& entryPoint)
+            : mProgram(program), mSpirv(spirv), mEntryPointName(entryPoint) {
+        }
+
+        bool Compile();
+
+      private:
+        enum class TypeKind {
+            None,
+            Void,
+            Bool,
+            Int,
+            Float,
+            Vector,
+            Matrix,
+            Array,
+            RuntimeArray,
+            Struct,
+            Pointer,
+            Function,
+        };
+
+        struct Type {
+            TypeKind kind = TypeKind::None;
+            // The component, column, element or pointee type.
+            uint32_t element = 0;
+            // The number of components, columns or elements.
+            uint32_t count = 0;
+            uint32_t storageClass = 0;
+            std::vector<uint32_t> members;
+            // The number of words of a value of this type in the registers.
+            uint32_t wordCount = 0;
+        };
+
+        struct MemberDecoration {
+            uint32_t offset = kNone;
+            uint32_t matrixStride = 0;
+            bool rowMajor = false;
+        };
+
+        struct Decoration {
+            uint32_t builtIn = kNone;
+            uint32_t group = kNone;
+            uint32_t binding = kNone;
+            uint32_t arrayStride = 0;
+            std::vector<MemberDecoration> members;
+        };
+
+        struct Value {
+            uint32_t type = 0;
+            uint32_t reg = kNone;
+            bool isConstant = false;
+            std::vector<uint32_t> constantWords;
+            // The matrix stride of the matrices a pointer points to, if it isn't their natural
+            // stride.
+            uint32_t matrixStride = 0;
+        };
+
+        struct Function {
+            uint32_t index = 0;
+            uint32_t entryPc = kNone;
+            std::vector<uint32_t> parameters;
+        };
+
+        bool ProcessInstruction(spv::Op opcode, const uint32_t* words, uint32_t wordCount);
+        bool ProcessType(spv::Op opcode, const uint32_t* words, uint32_t wordCount);
+        bool ProcessConstant(spv::Op opcode, const uint32_t* words, uint32_t wordCount);
+        bool ProcessVariable(const uint32_t* words, uint32_t wordCount);
+        bool ProcessFunctionInstruction(spv::Op opcode, const uint32_t* words, uint32_t wordCount);
+        bool ProcessExtInst(const uint32_t* words, uint32_t wordCount);
+        bool ProcessAtomic(spv::Op opcode, const uint32_t* words, uint32_t wordCount);
+        bool ResolveFixups();
+
+        bool IsValidId(uint32_t id) const;
+        Type* GetType(uint32_t id);
+        Type* GetValueType(uint32_t id);
+        bool IsScalarOrVectorOf(uint32_t typeId, TypeKind kind);
+        uint32_t GetRegister(uint32_t id);
+        uint32_t AllocateValue(uint32_t id, uint32_t typeId);
+        bool AllocateConstant(uint32_t id, uint32_t typeId, std::vector<uint32_t> words);
+        uint32_t GetZeroRegister();
+
+        // The memory layout of the types, using the Offset, ArrayStride and MatrixStride
+        // decorations when present and a tightly packed layout otherwise.
+        bool GetMemorySize(uint32_t typeId, uint32_t matrixStride, uint32_t* size);
+        bool GetArrayStride(uint32_t typeId, uint32_t matrixStride, uint32_t* stride);
+        bool GetMemberOffset(uint32_t structId, uint32_t member, uint32_t* offset);
+        bool AppendWordOffsets(uint32_t typeId,
+                               uint32_t matrixStride,
+                               uint32_t baseOffset,
+                               std::vector<uint32_t>* offsets);
+        bool AllocateMemory(uint32_t typeId, uint32_t* memorySize, uint32_t* offset);
+
+        void AddInstruction(Op op,
+                            uint32_t count,
+                            uint32_t result,
+                            std::array<uint32_t, 4> operands = {{0, 0, 0, 0}},
+                            const std::vector<uint32_t>& extra = {});
+
+        ComputeProgram* mProgram;
+        const std::vector<uint32_t>& mSpirv;
+        std::string mEntryPointName;
+
+        uint32_t mBound = 0;
+        std::vector<Type> mTypes;
+        std::vector<Decoration> mDecorations;
+        std::vector<Value> mValues;
+        std::vector<Function> mFunctions;
+        std::vector<uint32_t> mLabelPcs;
+        uint32_t mGlslStd450 = kNone;
+        uint32_t mEntryFunction = kNone;
+        uint32_t mZeroRegister = kNone;
+
+        Function* mCurrentFunction = nullptr;
+        uint32_t mCurrentFunctionId = kNone;
+        uint32_t mCurrentLabel = kNone;
+        // The Phi instruction that the following OpPhi are merged into, so that all the phis of
+        // a block read the values of the predecessor before any of them is written.
+        uint32_t mPhiInstruction = kNone;
+    };
+
+    bool ComputeProgram::Compiler::Compile() {
+        if (mSpirv.size() < 5 || mSpirv[0] != spv::MagicNumber) {
+            return false;
+        }
+        mBound = mSpirv[3];
+        // Ids are used to index arrays, avoid allocating huge ones for corrupted modules.
+        if (mBound > (1u << 22)) {
+            return false;
+        }
+        mTypes.resize(mBound);
+        mDecorations.resize(mBound);
+        mValues.resize(mBound);
+        mFunctions.resize(mBound);
+        mLabelPcs.resize(mBound, kNone);
+
+        size_t offset = 5;
+        while (offset < mSpirv.size()) {
+            uint32_t wordCount = mSpirv[offset] >> spv::WordCountShift;
+            spv::Op opcode = static_cast<spv::Op>(mSpirv[offset] & spv::OpCodeMask);
+            if (wordCount == 0 || offset + wordCount > mSpirv.size()) {
+                return false;
+            }
+            if (!ProcessInstruction(opcode, &mSpirv[offset], wordCount)) {
+                return false;
+            }
+            offset += wordCount;
+        }
+
+        if (mEntryFunction == kNone || mFunctions[mEntryFunction].entryPc == kNone) {
+            return false;
+        }
+        mProgram->mEntryPoint = mFunctions[mEntryFunction].entryPc;
+        return ResolveFixups();
+    }
+
+    bool ComputeProgram::Compiler::ProcessInstruction(spv::Op opcode,
+                                                      const uint32_t* words,
+                                                      uint32_t wordCount) {
+        switch (opcode) {
+            case spv::OpNop:
+            case spv::OpSource:
+            case spv::OpSourceContinued:
+            case spv::OpSourceExtension:
+            case spv::OpName:
+            case spv::OpMemberName:
+            case spv::OpString:
+            case spv::OpLine:
+            case spv::OpNoLine:
+            case spv::OpModuleProcessed:
+            case spv::OpCapability:
+            case spv::OpExtension:
+                return true;
+
+            case spv::OpExtInstImport: {
+                if (wordCount < 3 || !IsValidId(words[1])) {
+                    return false;
+                }
+                const char* name = reinterpret_cast<const char*>(&words[2]);
+                if (strncmp(name, "GLSL.std.450", (wordCount - 2) * sizeof(uint32_t)) == 0) {
+                    mGlslStd450 = words[1];
+                }
+                return true;
+            }
+
+            case spv::OpMemoryModel:
+                return wordCount >= 3 && words[1] == spv::AddressingModelLogical;
+
+            case spv::OpEntryPoint: {
+                if (wordCount < 4 || !IsValidId(words[2])) {
+                    return false;
+                }
+                const char* name = reinterpret_cast<const char*>(&words[3]);
+                size_t maxLength = (wordCount - 3) * sizeof(uint32_t);
+                if (words[1] == spv::ExecutionModelGLCompute &&
+                    strnlen(name, maxLength) == mEntryPointName.size() &&
+                    strncmp(name, mEntryPointName.c_str(), maxLength) == 0) {
+                    mEntryFunction = words[2];
+                }
+                return true;
+            }
+
+            case spv::OpExecutionMode:
+                if (wordCount >= 6 && words[1] == mEntryFunction &&
+                    words[2] == spv::ExecutionModeLocalSize) {
+                    mProgram->mWorkgroupSize = {{words[3], words[4], words[5]}};
+                }
+                return true;
+
+            case spv::OpDecorate: {
+                if (wordCount < 3 || !IsValidId(words[1])) {
+                    return false;
+                }
+                Decoration& decoration = mDecorations[words[1]];
+                uint32_t literal = wordCount >= 4 ? words[3] : 0;
+                switch (words[2]) {
+                    case spv::DecorationBuiltIn:
+                        decoration.builtIn = literal;
+                        break;
+                    case spv::DecorationDescriptorSet:
+                        decoration.group = literal;
+                        break;
+                    case spv::DecorationBinding:
+                        decoration.binding = literal;
+                        break;
+                    case spv::DecorationArrayStride:
+                        decoration.arrayStride = literal;
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            case spv::OpMemberDecorate: {
+                if (wordCount < 4 || !IsValidId(words[1]) || words[2] >= 0x10000) {
+                    return false;
+                }
+                std::vector<MemberDecoration>& members = mDecorations[words[1]].members;
+                if (members.size() <= words[2]) {
+                    members.resize(words[2] + 1);
+                }
+                MemberDecoration& decoration = members[words[2]];
+                uint32_t literal = wordCount >= 5 ? words[4] : 0;
+                switch (words[3]) {
+                    case spv::DecorationOffset:
+                        decoration.offset = literal;
+                        break;
+                    case spv::DecorationMatrixStride:
+                        decoration.matrixStride = literal;
+                        break;
+                    case spv::DecorationRowMajor:
+                        decoration.rowMajor = true;
+                        break;
+                    default:
+                        break;
+                }
+                return true;
+            }
+
+            case spv::OpTypeVoid:
+            case spv::OpTypeBool:
+            case spv::OpTypeInt:
+            case spv::OpTypeFloat:
+            case spv::OpTypeVector:
+            case spv::OpTypeMatrix:
+            case spv::OpTypeArray:
+            case spv::OpTypeRuntimeArray:
+            case spv::OpTypeStruct:
+            case spv::OpTypePointer:
+            case spv::OpTypeFunction:
+                return ProcessType(opcode, words, wordCount);
+
+            case spv::OpConstantTrue:
+            case spv::OpConstantFalse:
+            case spv::OpConstant:
+            case spv::OpConstantComposite:
+            case spv::OpConstantNull:
+            case spv::OpSpecConstantTrue:
+            case spv::OpSpecConstantFalse:
+            case spv::OpSpecConstant:
+            case spv::OpSpecConstantComposite:
+                return ProcessConstant(opcode, words, wordCount);
+
+            case spv::OpVariable:
+                if (mCurrentFunction == nullptr) {
+                    return ProcessVariable(words, wordCount);
+                }
+                return ProcessFunctionInstruction(opcode, words, wordCount);
+
+            case spv::OpUndef:
+                if (wordCount < 3 || GetType(words[1]) == nullptr) {
+                    return false;
+                }
+                return AllocateConstant(words[2], words[1],
+                                        std::vector<uint32_t>(GetType(words[1])->wordCount, 0));
+
+            case spv::OpFunction: {
+                if (wordCount < 5 || mCurrentFunction != nullptr || !IsValidId(words[2])) {
+                    return false;
+                }
+                mCurrentFunctionId = words[2];
+                mCurrentFunction = &mFunctions[mCurrentFunctionId];
+                mCurrentFunction->index = mProgram->mFunctionCount++;
+                return true;
+            }
+
+            case spv::OpFunctionParameter: {
+                if (wordCount < 3 || mCurrentFunction == nullptr ||
+                    mCurrentFunction->entryPc != kNone) {
+                    return false;
+                }
+                if (AllocateValue(words[2], words[1]) == kNone) {
+                    return false;
+                }
+                mCurrentFunction->parameters.push_back(words[2]);
+                return true;
+            }
+
+            case spv::OpFunctionEnd:
+                if (mCurrentFunction == nullptr) {
+                    return false;
+                }
+                mCurrentFunction = nullptr;
+                mCurrentFunctionId = kNone;
+                mCurrentLabel = kNone;
+                return true;
+
+            case spv::OpLabel: {
+                if (wordCount < 2 || mCurrentFunction == nullptr || !IsValidId(words[1])) {
+                    return false;
+                }
+                uint32_t pc = static_cast<uint32_t>(mProgram->mInstructions.size());
+                if (mCurrentFunction->entryPc == kNone) {
+                    mCurrentFunction->entryPc = pc;
+                }
+                mLabelPcs[words[1]] = pc;
+                mCurrentLabel = words[1];
+                mPhiInstruction = kNone;
+                return true;
+            }
+
+            case spv::OpSelectionMerge:
+            case spv::OpLoopMerge:
+                return true;
+
+            default:
+                if (mCurrentLabel == kNone) {
+                    return false;
+                }
+                return ProcessFunctionInstruction(opcode, words, wordCount);
+        }
+    }
+
+    bool ComputeProgram::Compiler::ProcessType(spv::Op opcode,
+                                               const uint32_t* words,
+                                               uint32_t wordCount) {
+        if (wordCount < 2 || !IsValidId(words[1])) {
+            return false;
+        }
+        Type& type = mTypes[words[1]];
+
+        switch (opcode) {
+            case spv::OpTypeVoid:
+                type.kind = TypeKind::Void;
+                type.wordCount = 0;
+                break;
+
+            case spv::OpTypeBool:
+                type.kind = TypeKind::Bool;
+                type.wordCount = 1;
+                break;
+
+            case spv::OpTypeInt:
+            case spv::OpTypeFloat:
+                if (wordCount < 3 || words[2] != 32) {
+                    return false;
+                }
+                type.kind = opcode == spv::OpTypeInt ? TypeKind::Int : TypeKind::Float;
+                type.wordCount = 1;
+                break;
+
+            case spv::OpTypeVector:
+            case spv::OpTypeMatrix:
+            case spv::OpTypeArray: {
+                if (wordCount < 4) {
+                    return false;
+                }
+                Type* element = GetType(words[2]);
+                if (element == nullptr) {
+                    return false;
+                }
+
+                uint32_t count = words[3];
+                if (opcode == spv::OpTypeArray) {
+                    // The length of arrays is a constant id.
+                    if (!IsValidId(words[3]) || !mValues[words[3]].isConstant ||
+                        mValues[words[3]].constantWords.size() != 1) {
+                        return false;
+                    }
+                    count = mValues[words[3]].constantWords[0];
+                }
+                if (count == 0 || count > (1u << 20) ||
+                    static_cast<uint64_t>(count) * element->wordCount > (1u << 20)) {
+                    return false;
+                }
+
+                type.kind = opcode == spv::OpTypeVector
+                                ? TypeKind::Vector
+                                : opcode == spv::OpTypeMatrix ? TypeKind::Matrix : TypeKind::Array;
+                type.element = words[2];
+                type.count = count;
+                type.wordCount = count * element->wordCount;
+                break;
+            }
+
+            case spv::OpTypeRuntimeArray:
+                if (wordCount < 3 || GetType(words[2]) == nullptr) {
+                    return false;
+                }
+                type.kind = TypeKind::RuntimeArray;
+                type.element = words[2];
+                type.wordCount = 0;
+                break;
+
+            case spv::OpTypeStruct:
+                type.kind = TypeKind::Struct;
+                type.wordCount = 0;
+                for (uint32_t i = 2; i < wordCount; ++i) {
+                    Type* member = GetType(words[i]);
+                    if (member == nullptr) {
+                        return false;
+                    }
+                    type.members.push_back(words[i]);
+                    type.wordCount += member->wordCount;
+                }
+                if (type.wordCount > (1u << 20)) {
+                    return false;
+                }
+                break;
+
+            case spv::OpTypePointer:
+                // The pointee can be a forward reference.
+                if (wordCount < 4 || !IsValidId(words[3])) {
+                    return false;
+                }
+                type.kind = TypeKind::Pointer;
+                type.storageClass = words[2];
+                type.element = words[3];
+                type.wordCount = 2;
+                break;
+
+            case spv::OpTypeFunction:
+                type.kind = TypeKind::Function;
+                type.wordCount = 0;
+                break;
+
+            default:
+                UNREACHABLE();
+                return false;
+        }
+        return true;
+    }
+
+    bool ComputeProgram::Compiler::ProcessConstant(spv::Op opcode,
+                                                   const uint32_t* words,
+                                                   uint32_t wordCount) {
+        if (wordCount < 3) {
+            return false;
+        }
+        uint32_t typeId = words[1];
+        uint32_t id = words[2];
+        Type* type = GetType(typeId);
+        if (type == nullptr) {
+            return false;
+        }
+
+        std::vector<uint32_t> constantWords;
+        switch (opcode) {
+            case spv::OpConstantTrue:
+            case spv::OpSpecConstantTrue:
+                constantWords.push_back(1);
+                break;
+
+            case spv::OpConstantFalse:
+            case spv::OpSpecConstantFalse:
+                constantWords.push_back(0);
+                break;
+
+            case spv::OpConstant:
+            case spv::OpSpecConstant:
+                if (wordCount != 4) {
+                    return false;
+                }
+                constantWords.push_back(words[3]);
+                break;
+
+            case spv::OpConstantComposite:
+            case spv::OpSpecConstantComposite:
+                for (uint32_t i = 3; i < wordCount; ++i) {
+                    if (!IsValidId(words[i]) || !mValues[words[i]].isConstant) {
+                        return false;
+                    }
+                    const std::vector<uint32_t>& component = mValues[words[i]].constantWords;
+                    constantWords.insert(constantWords.end(), component.begin(), component.end());
+                }
+                break;
+
+            case spv::OpConstantNull:
+                constantWords.resize(type->wordCount, 0);
+                break;
+
+            default:
+                UNREACHABLE();
+                return false;
+        }
+
+        if (constantWords.size() != type->wordCount) {
+            return false;
+        }
+
+        // The WorkgroupSize built-in overrides the LocalSize execution mode.
+        if (IsValidId(id) && mDecorations[id].builtIn == spv::BuiltInWorkgroupSize) {
+            if (constantWords.size() != 3) {
+                return false;
+            }
+            mProgram->mWorkgroupSize = {{constantWords[0], constantWords[1], constantWords[2]}};
+        }
+
+        return AllocateConstant(id, typeId, std::move(constantWords));
+    }
+
+    bool ComputeProgram::Compiler::ProcessVariable(const uint32_t* words, uint32_t wordCount) {
+        if (wordCount < 4) {
+            return false;
+        }
+        uint32_t typeId = words[1];
+        uint32_t id = words[2];
+        uint32_t storageClass = words[3];
+        Type* type = GetType(typeId);
+        if (type == nullptr || type->kind != TypeKind::Pointer || !IsValidId(id)) {
+            return false;
+        }
+
+        uint32_t region = 0;
+        uint32_t offset = 0;
+        switch (storageClass) {
+            case spv::StorageClassInput: {
+                uint32_t builtIn = mDecorations[id].builtIn;
+                if (builtIn != spv::BuiltInNumWorkgroups && builtIn != spv::BuiltInWorkgroupId &&
+                    builtIn != spv::BuiltInLocalInvocationId &&
+                    builtIn != spv::BuiltInGlobalInvocationId &&
+                    builtIn != spv::BuiltInLocalInvocationIndex) {
+                    return false;
+                }
+                region = kPrivateRegion;
+                if (!AllocateMemory(type->element, &mProgram->mPrivateMemorySize, &offset)) {
+                    return false;
+                }
+                mProgram->mBuiltIns.push_back({builtIn, offset});
+                break;
+            }
+
+            case spv::StorageClassPrivate: {
+                region = kPrivateRegion;
+                if (!AllocateMemory(type->element, &mProgram->mPrivateMemorySize, &offset)) {
+                    return false;
+                }
+                if (wordCount >= 5) {
+                    if (!IsValidId(words[4]) || !mValues[words[4]].isConstant) {
+                        return false;
+                    }
+                    std::vector<uint32_t> wordOffsets;
+                    if (!AppendWordOffsets(type->element, 0, offset, &wordOffsets)) {
+                        return false;
+                    }
+                    const std::vector<uint32_t>& value = mValues[words[4]].constantWords;
+                    for (size_t i = 0; i < wordOffsets.size(); ++i) {
+                        mProgram->mPrivateInitializers.push_back({wordOffsets[i], value[i]});
+                    }
+                }
+                break;
+            }
+
+            case spv::StorageClassWorkgroup:
+                region = kWorkgroupRegion;
+                if (!AllocateMemory(type->element, &mProgram->mWorkgroupMemorySize, &offset)) {
+                    return false;
+                }
+                break;
+
+            case spv::StorageClassUniform:
+            case spv::StorageClassStorageBuffer: {
+                const Decoration& decoration = mDecorations[id];
+                if (decoration.group >= kMaxBindGroups ||
+                    decoration.binding >= kMaxBindingsPerGroup) {
+                    return false;
+                }
+                region = kFirstBufferRegion + static_cast<uint32_t>(mProgram->mBuffers.size());
+                mProgram->mBuffers.push_back({decoration.group, decoration.binding});
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        return AllocateConstant(id, typeId, {region, offset});
+    }
+
+    bool ComputeProgram::Compiler::ProcessFunctionInstruction(spv::Op opcode,
+                                                              const uint32_t* words,
+                                                              uint32_t wordCount) {
+        // Operations with a result type, a result and operands that are component-wise on their
+        // 32-bit words.
+        Op componentWiseOp;
+        uint32_t componentWiseOperands = 2;
+        switch (opcode) {
+            case spv::OpIAdd:
+                componentWiseOp = Op::IAdd;
+                break;
+            case spv::OpISub:
+                componentWiseOp = Op::ISub;
+                break;
+            case spv::OpIMul:
+                componentWiseOp = Op::IMul;
+                break;
+            case spv::OpUDiv:
+                componentWiseOp = Op::UDiv;
+                break;
+            case spv::OpSDiv:
+                componentWiseOp = Op::SDiv;
+                break;
+            case spv::OpUMod:
+                componentWiseOp = Op::UMod;
+                break;
+            case spv::OpSRem:
+                componentWiseOp = Op::SRem;
+                break;
+            case spv::OpSMod:
+                componentWiseOp = Op::SMod;
+                break;
+            case spv::OpShiftLeftLogical:
+                componentWiseOp = Op::ShiftLeftLogical;
+                break;
+            case spv::OpShiftRightLogical:
+                componentWiseOp = Op::ShiftRightLogical;
+                break;
+            case spv::OpShiftRightArithmetic:
+                componentWiseOp = Op::ShiftRightArithmetic;
+                break;
+            case spv::OpBitwiseAnd:
+                componentWiseOp = Op::BitwiseAnd;
+                break;
+            case spv::OpBitwiseOr:
+                componentWiseOp = Op::BitwiseOr;
+                break;
+            case spv::OpBitwiseXor:
+                componentWiseOp = Op::BitwiseXor;
+                break;
+            case spv::OpFAdd:
+                componentWiseOp = Op::FAdd;
+                break;
+            case spv::OpFSub:
+                componentWiseOp = Op::FSub;
+                break;
+            case spv::OpFMul:
+                componentWiseOp = Op::FMul;
+                break;
+            case spv::OpFDiv:
+                componentWiseOp = Op::FDiv;
+                break;
+            case spv::OpFRem:
+                componentWiseOp = Op::FRem;
+                break;
+            case spv::OpFMod:
+                componentWiseOp = Op::FMod;
+                break;
+            case spv::OpIEqual:
+                componentWiseOp = Op::IEqual;
+                break;
+            case spv::OpINotEqual:
+                componentWiseOp = Op::INotEqual;
+                break;
+            case spv::OpUGreaterThan:
+                componentWiseOp = Op::UGreaterThan;
+                break;
+            case spv::OpSGreaterThan:
+                componentWiseOp = Op::SGreaterThan;
+                break;
+            case spv::OpUGreaterThanEqual:
+                componentWiseOp = Op::UGreaterThanEqual;
+                break;
+            case spv::OpSGreaterThanEqual:
+                componentWiseOp = Op::SGreaterThanEqual;
+                break;
+            case spv::OpULessThan:
+                componentWiseOp = Op::ULessThan;
+                break;
+            case spv::OpSLessThan:
+                componentWiseOp = Op::SLessThan;
+                break;
+            case spv::OpULessThanEqual:
+                componentWiseOp = Op::ULessThanEqual;
+                break;
+            case spv::OpSLessThanEqual:
+                componentWiseOp = Op::SLessThanEqual;
+                break;
+            case spv::OpFOrdEqual:
+                componentWiseOp = Op::FOrdEqual;
+                break;
+            case spv::OpFUnordEqual:
+                componentWiseOp = Op::FUnordEqual;
+                break;
+            case spv::OpFOrdNotEqual:
+                componentWiseOp = Op::FOrdNotEqual;
+                break;
+            case spv::OpFUnordNotEqual:
+                componentWiseOp = Op::FUnordNotEqual;
+                break;
+            case spv::OpFOrdLessThan:
+                componentWiseOp = Op::FOrdLessThan;
+                break;
+            case spv::OpFUnordLessThan:
+                componentWiseOp = Op::FUnordLessThan;
+                break;
+            case spv::OpFOrdGreaterThan:
+                componentWiseOp = Op::FOrdGreaterThan;
+                break;
+            case spv::OpFUnordGreaterThan:
+                componentWiseOp = Op::FUnordGreaterThan;
+                break;
+            case spv::OpFOrdLessThanEqual:
+                componentWiseOp = Op::FOrdLessThanEqual;
+                break;
+            case spv::OpFUnordLessThanEqual:
+                componentWiseOp = Op::FUnordLessThanEqual;
+                break;
+            case spv::OpFOrdGreaterThanEqual:
+                componentWiseOp = Op::FOrdGreaterThanEqual;
+                break;
+            case spv::OpFUnordGreaterThanEqual:
+                componentWiseOp = Op::FUnordGreaterThanEqual;
+                break;
+            case spv::OpLogicalEqual:
+                componentWiseOp = Op::LogicalEqual;
+                break;
+            case spv::OpLogicalNotEqual:
+                componentWiseOp = Op::LogicalNotEqual;
+                break;
+            case spv::OpLogicalOr:
+                componentWiseOp = Op::LogicalOr;
+                break;
+            case spv::OpLogicalAnd:
+                componentWiseOp = Op::LogicalAnd;
+                break;
+
+            case spv::OpNot:
+                componentWiseOp = Op::Not;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpSNegate:
+                componentWiseOp = Op::SNegate;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpBitCount:
+                componentWiseOp = Op::BitCount;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpBitReverse:
+                componentWiseOp = Op::BitReverse;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpFNegate:
+                componentWiseOp = Op::FNegate;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpLogicalNot:
+                componentWiseOp = Op::LogicalNot;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpIsNan:
+                componentWiseOp = Op::IsNan;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpIsInf:
+                componentWiseOp = Op::IsInf;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpConvertFToU:
+                componentWiseOp = Op::ConvertFToU;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpConvertFToS:
+                componentWiseOp = Op::ConvertFToS;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpConvertSToF:
+                componentWiseOp = Op::ConvertSToF;
+                componentWiseOperands = 1;
+                break;
+            case spv::OpConvertUToF:
+                componentWiseOp = Op::ConvertUToF;
+                componentWiseOperands = 1;
+                break;
+
+            default:
+                componentWiseOperands = 0;
+                break;
+        }
+
+        if (componentWiseOperands != 0) {
+            if (wordCount != 3 + componentWiseOperands) {
+                return false;
+            }
+            Type* type = GetType(words[1]);
+            if (type == nullptr || type->wordCount == 0) {
+                return false;
+            }
+            std::array<uint32_t, 4> operands = {{0, 0, 0, 0}};
+            for (uint32_t i = 0; i < componentWiseOperands; ++i) {
+                operands[i] = GetRegister(words[3 + i]);
+                Type* operandType = GetValueType(words[3 + i]);
+                if (operands[i] == kNone || operandType->wordCount != type->wordCount) {
+                    return false;
+                }
+            }
+            uint32_t result = AllocateValue(words[2], words[1]);
+            if (result == kNone) {
+                return false;
+            }
+            AddInstruction(componentWiseOp, type->wordCount, result, operands);
+            return true;
+        }
+
+        switch (opcode) {
+            case spv::OpVariable: {
+                // Function variables have a single location in the private memory since there is
+                // a single frame per function.
+                if (wordCount < 4 || words[3] != spv::StorageClassFunction) {
+                    return false;
+                }
+                Type* type = GetType(words[1]);
+                if (type == nullptr || type->kind != TypeKind::Pointer) {
+                    return false;
+                }
+                uint32_t offset;
+                if (!AllocateMemory(type->element, &mProgram->mPrivateMemorySize, &offset) ||
+                    !AllocateConstant(words[2], words[1], {kPrivateRegion, offset})) {
+                    return false;
+                }
+
+                // Initializers are stored each time the function is called.
+                if (wordCount >= 5) {
+                    std::vector<uint32_t> wordOffsets;
+                    uint32_t value = GetRegister(words[4]);
+                    if (value == kNone || !AppendWordOffsets(type->element, 0, 0, &wordOffsets)) {
+                        return false;
+                    }
+                    uint32_t size;
+                    if (!GetMemorySize(type->element, 0, &size)) {
+                        return false;
+                    }
+                    AddInstruction(Op::Store, static_cast<uint32_t>(wordOffsets.size()), 0,
+                                   {{mValues[words[2]].reg, value, size, 0}}, wordOffsets);
+                }
+                return true;
+            }
+
+            case spv::OpLoad: {
+                if (wordCount < 4) {
+                    return false;
+                }
+                Type* pointerType = GetValueType(words[3]);
+                uint32_t pointer = GetRegister(words[3]);
+                if (pointer == kNone || pointerType->kind != TypeKind::Pointer ||
+                    pointerType->element != words[1]) {
+                    return false;
+                }
+                uint32_t matrixStride = mValues[words[3]].matrixStride;
+                std::vector<uint32_t> wordOffsets;
+                uint32_t size;
+                if (!AppendWordOffsets(words[1], matrixStride, 0, &wordOffsets) ||
+                    !GetMemorySize(words[1], matrixStride, &size)) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::Load, static_cast<uint32_t>(wordOffsets.size()), result,
+                               {{pointer, size, 0, 0}}, wordOffsets);
+                return true;
+            }
+
+            case spv::OpStore: {
+                if (wordCount < 3) {
+                    return false;
+                }
+                Type* pointerType = GetValueType(words[1]);
+                uint32_t pointer = GetRegister(words[1]);
+                uint32_t value = GetRegister(words[2]);
+                if (pointer == kNone || value == kNone ||
+                    pointerType->kind != TypeKind::Pointer) {
+                    return false;
+                }
+                uint32_t matrixStride = mValues[words[1]].matrixStride;
+                std::vector<uint32_t> wordOffsets;
+                uint32_t size;
+                if (!AppendWordOffsets(pointerType->element, matrixStride, 0, &wordOffsets) ||
+                    !GetMemorySize(pointerType->element, matrixStride, &size)) {
+                    return false;
+                }
+                AddInstruction(Op::Store, static_cast<uint32_t>(wordOffsets.size()), 0,
+                               {{pointer, value, size, 0}}, wordOffsets);
+                return true;
+            }
+
+            case spv::OpCopyMemory: {
+                // Copies are lowered to a load in temporary registers followed by a store.
+                if (wordCount < 3) {
+                    return false;
+                }
+                Type* targetType = GetValueType(words[1]);
+                Type* sourceType = GetValueType(words[2]);
+                uint32_t target = GetRegister(words[1]);
+                uint32_t source = GetRegister(words[2]);
+                if (target == kNone || source == kNone || targetType->kind != TypeKind::Pointer ||
+                    sourceType->kind != TypeKind::Pointer ||
+                    targetType->element != sourceType->element) {
+                    return false;
+                }
+                uint32_t typeId = targetType->element;
+                std::vector<uint32_t> loadOffsets;
+                std::vector<uint32_t> storeOffsets;
+                uint32_t loadSize;
+                uint32_t storeSize;
+                if (!AppendWordOffsets(typeId, mValues[words[2]].matrixStride, 0, &loadOffsets) ||
+                    !AppendWordOffsets(typeId, mValues[words[1]].matrixStride, 0,
+                                       &storeOffsets) ||
+                    !GetMemorySize(typeId, mValues[words[2]].matrixStride, &loadSize) ||
+                    !GetMemorySize(typeId, mValues[words[1]].matrixStride, &storeSize)) {
+                    return false;
+                }
+                uint32_t temporary = mProgram->mRegisterCount;
+                mProgram->mRegisterCount += static_cast<uint32_t>(loadOffsets.size());
+                AddInstruction(Op::Load, static_cast<uint32_t>(loadOffsets.size()), temporary,
+                               {{source, loadSize, 0, 0}}, loadOffsets);
+                AddInstruction(Op::Store, static_cast<uint32_t>(storeOffsets.size()), 0,
+                               {{target, temporary, storeSize, 0}}, storeOffsets);
+                return true;
+            }
+
+            case spv::OpAccessChain:
+            case spv::OpInBoundsAccessChain: {
+                if (wordCount < 4) {
+                    return false;
+                }
+                Type* baseType = GetValueType(words[3]);
+                uint32_t base = GetRegister(words[3]);
+                if (base == kNone || baseType->kind != TypeKind::Pointer) {
+                    return false;
+                }
+
+                // Constant indices are folded in a single offset, the dynamic ones are kept as
+                // pairs of index register and stride.
+                uint32_t typeId = baseType->element;
+                uint32_t matrixStride = mValues[words[3]].matrixStride;
+                int64_t constantOffset = 0;
+                std::vector<uint32_t> dynamicIndices;
+                for (uint32_t i = 4; i < wordCount; ++i) {
+                    Type* type = GetType(typeId);
+                    uint32_t index = words[i];
+                    if (type == nullptr || !IsValidId(index)) {
+                        return false;
+                    }
+                    const Value& indexValue = mValues[index];
+                    bool isConstant = indexValue.isConstant && indexValue.constantWords.size() == 1;
+
+                    uint32_t stride;
+                    uint32_t elementType;
+                    switch (type->kind) {
+                        case TypeKind::Struct: {
+                            if (!isConstant) {
+                                return false;
+                            }
+                            uint32_t member = indexValue.constantWords[0];
+                            if (member >= type->members.size()) {
+                                return false;
+                            }
+                            uint32_t memberOffset;
+                            if (!GetMemberOffset(typeId, member, &memberOffset)) {
+                                return false;
+                            }
+                            constantOffset += memberOffset;
+                            matrixStride = 0;
+                            const Decoration& decoration = mDecorations[typeId];
+                            if (member < decoration.members.size()) {
+                                if (decoration.members[member].rowMajor) {
+                                    return false;
+                                }
+                                matrixStride = decoration.members[member].matrixStride;
+                            }
+                            typeId = type->members[member];
+                            continue;
+                        }
+
+                        case TypeKind::Array:
+                        case TypeKind::RuntimeArray:
+                            if (!GetArrayStride(typeId, matrixStride, &stride)) {
+                                return false;
+                            }
+                            elementType = type->element;
+                            break;
+
+                        case TypeKind::Matrix:
+                            if (!GetMemorySize(type->element, 0, &stride)) {
+                                return false;
+                            }
+                            if (matrixStride != 0) {
+                                stride = matrixStride;
+                            }
+                            elementType = type->element;
+                            break;
+
+                        case TypeKind::Vector:
+                            stride = sizeof(uint32_t);
+                            elementType = type->element;
+                            break;
+
+                        default:
+                            return false;
+                    }
+
+                    if (isConstant) {
+                        constantOffset += static_cast<int64_t>(AsInt(indexValue.constantWords[0])) *
+                                          static_cast<int64_t>(stride);
+                    } else {
+                        uint32_t indexRegister = GetRegister(index);
+                        if (indexRegister == kNone ||
+                            !IsScalarOrVectorOf(indexValue.type, TypeKind::Int) ||
+                            GetType(indexValue.type)->wordCount != 1) {
+                            return false;
+                        }
+                        dynamicIndices.push_back(indexRegister);
+                        dynamicIndices.push_back(stride);
+                    }
+                    typeId = elementType;
+                }
+
+                Type* resultType = GetType(words[1]);
+                if (resultType == nullptr || resultType->kind != TypeKind::Pointer ||
+                    resultType->element != typeId) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                mValues[words[2]].matrixStride = matrixStride;
+
+                uint32_t offset = kOutOfBounds;
+                if (constantOffset >= 0 && constantOffset < kOutOfBounds) {
+                    offset = static_cast<uint32_t>(constantOffset);
+                }
+                AddInstruction(Op::AccessChain, 0, result, {{base, offset, 0, 0}},
+                               dynamicIndices);
+                return true;
+            }
+
+            case spv::OpArrayLength: {
+                if (wordCount < 5) {
+                    return false;
+                }
+                Type* pointerType = GetValueType(words[3]);
+                uint32_t pointer = GetRegister(words[3]);
+                if (pointer == kNone || pointerType->kind != TypeKind::Pointer) {
+                    return false;
+                }
+                uint32_t structId = pointerType->element;
+                Type* structType = GetType(structId);
+                if (structType == nullptr || structType->kind != TypeKind::Struct ||
+                    words[4] >= structType->members.size()) {
+                    return false;
+                }
+                uint32_t memberOffset;
+                uint32_t stride;
+                if (!GetMemberOffset(structId, words[4], &memberOffset) ||
+                    !GetArrayStride(structType->members[words[4]], 0, &stride) || stride == 0) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::ArrayLength, 1, result, {{pointer, memberOffset, stride, 0}});
+                return true;
+            }
+
+            case spv::OpCopyObject:
+            case spv::OpBitcast:
+            case spv::OpUConvert:
+            case spv::OpSConvert:
+            case spv::OpFConvert: {
+                // All the types are 32-bit so these are copies.
+                if (wordCount < 4) {
+                    return false;
+                }
+                Type* type = GetType(words[1]);
+                uint32_t source = GetRegister(words[3]);
+                if (type == nullptr || source == kNone ||
+                    GetValueType(words[3])->wordCount != type->wordCount ||
+                    type->kind == TypeKind::Pointer) {
+                    return false;
+                }
+                std::vector<uint32_t> sources;
+                for (uint32_t i = 0; i < type->wordCount; ++i) {
+                    sources.push_back(source + i);
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::Gather, type->wordCount, result, {{0, 0, 0, 0}}, sources);
+                return true;
+            }
+
+            case spv::OpCompositeConstruct: {
+                Type* type = GetType(words[1]);
+                if (type == nullptr) {
+                    return false;
+                }
+                std::vector<uint32_t> sources;
+                for (uint32_t i = 3; i < wordCount; ++i) {
+                    uint32_t source = GetRegister(words[i]);
+                    if (source == kNone) {
+                        return false;
+                    }
+                    for (uint32_t j = 0; j < GetValueType(words[i])->wordCount; ++j) {
+                        sources.push_back(source + j);
+                    }
+                }
+                if (sources.size() != type->wordCount) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::Gather, type->wordCount, result, {{0, 0, 0, 0}}, sources);
+                return true;
+            }
+
+            case spv::OpCompositeExtract:
+            case spv::OpCompositeInsert: {
+                bool isInsert = opcode == spv::OpCompositeInsert;
+                uint32_t firstIndex = isInsert ? 5 : 4;
+                uint32_t compositeId = words[isInsert ? 4 : 3];
+                if (wordCount < firstIndex) {
+                    return false;
+                }
+                uint32_t composite = GetRegister(compositeId);
+                if (composite == kNone) {
+                    return false;
+                }
+
+                // Find the words of the element in the flattened composite.
+                uint32_t typeId = mValues[compositeId].type;
+                uint32_t wordOffset = 0;
+                for (uint32_t i = firstIndex; i < wordCount; ++i) {
+                    Type* type = GetType(typeId);
+                    uint32_t index = words[i];
+                    switch (type->kind) {
+                        case TypeKind::Struct:
+                            if (index >= type->members.size()) {
+                                return false;
+                            }
+                            for (uint32_t member = 0; member < index; ++member) {
+                                wordOffset += GetType(type->members[member])->wordCount;
+                            }
+                            typeId = type->members[index];
+                            break;
+
+                        case TypeKind::Array:
+                        case TypeKind::Matrix:
+                        case TypeKind::Vector:
+                            if (index >= type->count) {
+                                return false;
+                            }
+                            wordOffset += index * GetType(type->element)->wordCount;
+                            typeId = type->element;
+                            break;
+
+                        default:
+                            return false;
+                    }
+                }
+                uint32_t elementWordCount = GetType(typeId)->wordCount;
+
+                std::vector<uint32_t> sources;
+                if (isInsert) {
+                    uint32_t object = GetRegister(words[3]);
+                    if (object == kNone || GetValueType(words[3])->wordCount != elementWordCount) {
+                        return false;
+                    }
+                    for (uint32_t i = 0; i < GetValueType(compositeId)->wordCount; ++i) {
+                        if (i >= wordOffset && i < wordOffset + elementWordCount) {
+                            sources.push_back(object + i - wordOffset);
+                        } else {
+                            sources.push_back(composite + i);
+                        }
+                    }
+                } else {
+                    for (uint32_t i = 0; i < elementWordCount; ++i) {
+                        sources.push_back(composite + wordOffset + i);
+                    }
+                }
+
+                Type* resultType = GetType(words[1]);
+                if (resultType == nullptr || resultType->wordCount != sources.size()) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::Gather, resultType->wordCount, result, {{0, 0, 0, 0}},
+                               sources);
+                return true;
+            }
+
+            case spv::OpVectorShuffle: {
+                if (wordCount < 5) {
+                    return false;
+                }
+                uint32_t first = GetRegister(words[3]);
+                uint32_t second = GetRegister(words[4]);
+                Type* type = GetType(words[1]);
+                if (first == kNone || second == kNone || type == nullptr ||
+                    type->wordCount != wordCount - 5) {
+                    return false;
+                }
+                uint32_t firstCount = GetValueType(words[3])->wordCount;
+                uint32_t secondCount = GetValueType(words[4])->wordCount;
+                std::vector<uint32_t> sources;
+                for (uint32_t i = 5; i < wordCount; ++i) {
+                    uint32_t component = words[i];
+                    if (component == 0xFFFFFFFF) {
+                        sources.push_back(GetZeroRegister());
+                    } else if (component < firstCount) {
+                        sources.push_back(first + component);
+                    } else if (component < firstCount + secondCount) {
+                        sources.push_back(second + component - firstCount);
+                    } else {
+                        return false;
+                    }
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::Gather, type->wordCount, result, {{0, 0, 0, 0}}, sources);
+                return true;
+            }
+
+            case spv::OpVectorExtractDynamic: {
+                if (wordCount < 5) {
+                    return false;
+                }
+                uint32_t vector = GetRegister(words[3]);
+                uint32_t index = GetRegister(words[4]);
+                if (vector == kNone || index == kNone) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::VectorExtractDynamic, 1, result,
+                               {{vector, index, GetValueType(words[3])->wordCount, 0}});
+                return true;
+            }
+
+            case spv::OpVectorInsertDynamic: {
+                if (wordCount < 6) {
+                    return false;
+                }
+                uint32_t vector = GetRegister(words[3]);
+                uint32_t component = GetRegister(words[4]);
+                uint32_t index = GetRegister(words[5]);
+                if (vector == kNone || component == kNone || index == kNone) {
+                    return false;
+                }
+                uint32_t count = GetValueType(words[3])->wordCount;
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::VectorInsertDynamic, count, result,
+                               {{vector, component, index, 0}});
+                return true;
+            }
+
+            case spv::OpSelect: {
+                if (wordCount < 6) {
+                    return false;
+                }
+                Type* type = GetType(words[1]);
+                uint32_t condition = GetRegister(words[3]);
+                uint32_t accept = GetRegister(words[4]);
+                uint32_t reject = GetRegister(words[5]);
+                if (type == nullptr || condition == kNone || accept == kNone || reject == kNone ||
+                    type->kind == TypeKind::Pointer) {
+                    return false;
+                }
+                // The condition is either a scalar or has one component per component.
+                uint32_t conditionCount = GetValueType(words[3])->wordCount;
+                if (conditionCount != 1 && conditionCount != type->wordCount) {
+                    return false;
+                }
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::Select, type->wordCount, result,
+                               {{condition, accept, reject, conditionCount == 1 ? 0u : 1u}});
+                return true;
+            }
+
+            case spv::OpAny:
+            case spv::OpAll:
+            case spv::OpDot:
+            case spv::OpVectorTimesScalar:
+            case spv::OpMatrixTimesScalar:
+            case spv::OpMatrixTimesVector:
+            case spv::OpVectorTimesMatrix:
+            case spv::OpMatrixTimesMatrix: {
+                uint32_t operandCount = opcode == spv::OpAny || opcode == spv::OpAll ? 1 : 2;
+                if (wordCount < 3 + operandCount) {
+                    return false;
+                }
+                uint32_t first = GetRegister(words[3]);
+                uint32_t second = operandCount == 2 ? GetRegister(words[4]) : 0;
+                Type* resultType = GetType(words[1]);
+                if (first == kNone || second == kNone || resultType == nullptr) {
+                    return false;
+                }
+                Type* firstType = GetValueType(words[3]);
+                Type* secondType = operandCount == 2 ? GetValueType(words[4]) : nullptr;
+
+                Op op;
+                uint32_t count = resultType->wordCount;
+                std::array<uint32_t, 4> operands = {{first, second, 0, 0}};
+                switch (opcode) {
+                    case spv::OpAny:
+                    case spv::OpAll:
+                        op = opcode == spv::OpAny ? Op::Any : Op::All;
+                        count = firstType->wordCount;
+                        break;
+                    case spv::OpDot:
+                        op = Op::Dot;
+                        count = firstType->wordCount;
+                        break;
+                    case spv::OpVectorTimesScalar:
+                    case spv::OpMatrixTimesScalar:
+                        op = Op::VectorTimesScalar;
+                        break;
+                    case spv::OpMatrixTimesVector:
+                        // count is the number of rows, operands[2] the number of columns.
+                        op = Op::MatrixTimesVector;
+                        operands[2] = firstType->count;
+                        break;
+                    case spv::OpVectorTimesMatrix:
+                        // count is the number of columns, operands[2] the number of rows.
+                        op = Op::VectorTimesMatrix;
+                        operands[2] = secondType->wordCount / secondType->count;
+                        break;
+                    case spv::OpMatrixTimesMatrix:
+                        // operands[2] is the number of rows and operands[3] the number of
+                        // columns of the first matrix.
+                        op = Op::MatrixTimesMatrix;
+                        operands[2] = firstType->wordCount / firstType->count;
+                        operands[3] = firstType->count;
+                        break;
+                    default:
+                        UNREACHABLE();
+                        return false;
+                }
+
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                AddInstruction(op, count, result, operands);
+                return true;
+            }
+
+            case spv::OpExtInst:
+                return ProcessExtInst(words, wordCount);
+
+            case spv::OpAtomicLoad:
+            case spv::OpAtomicStore:
+            case spv::OpAtomicExchange:
+            case spv::OpAtomicCompareExchange:
+            case spv::OpAtomicIIncrement:
+            case spv::OpAtomicIDecrement:
+            case spv::OpAtomicIAdd:
+            case spv::OpAtomicISub:
+            case spv::OpAtomicSMin:
+            case spv::OpAtomicUMin:
+            case spv::OpAtomicSMax:
+            case spv::OpAtomicUMax:
+            case spv::OpAtomicAnd:
+            case spv::OpAtomicOr:
+            case spv::OpAtomicXor:
+                return ProcessAtomic(opcode, words, wordCount);
+
+            case spv::OpPhi: {
+                // Each phi is stored as its result, its number of words, its number of
+                // predecessors and pairs of predecessor label and value register.
+                if (wordCount < 5 || (wordCount - 3) % 2 != 0) {
+                    return false;
+                }
+                std::vector<uint32_t> extra;
+                uint32_t result = AllocateValue(words[2], words[1]);
+                if (result == kNone) {
+                    return false;
+                }
+                extra.push_back(result);
+                extra.push_back(GetType(words[1])->wordCount);
+                extra.push_back((wordCount - 3) / 2);
+                for (uint32_t i = 3; i < wordCount; i += 2) {
+                    // The values of back edges are defined later in the function.
+                    if (!IsValidId(words[i]) || !IsValidId(words[i + 1])) {
+                        return false;
+                    }
+                    uint32_t value = mValues[words[i]].reg;
+                    if (value == kNone) {
+                        value = AllocateValue(words[i], words[1]);
+                    }
+                    if (value == kNone || mValues[words[i]].type != words[1]) {
+                        return false;
+                    }
+                    extra.push_back(words[i + 1]);
+                    extra.push_back(value);
+                }
+
+                if (mPhiInstruction != kNone) {
+                    Instruction& phi = mProgram->mInstructions[mPhiInstruction];
+                    ASSERT(phi.extraBegin + phi.extraCount == mProgram->mExtraOperands.size());
+                    mProgram->mExtraOperands.insert(mProgram->mExtraOperands.end(),
+                                                    extra.begin(), extra.end());
+                    phi.extraCount += static_cast<uint32_t>(extra.size());
+                    phi.count++;
+                } else {
+                    AddInstruction(Op::Phi, 1, 0, {{0, 0, 0, 0}}, extra);
+                    mPhiInstruction = static_cast<uint32_t>(mProgram->mInstructions.size() - 1);
+                }
+                return true;
+            }
+
+            case spv::OpBranch:
+                if (wordCount < 2 || !IsValidId(words[1])) {
+                    return false;
+                }
+                AddInstruction(Op::Branch, 0, 0, {{words[1], 0, 0, mCurrentLabel}});
+                return true;
+
+            case spv::OpBranchConditional: {
+                if (wordCount < 4 || !IsValidId(words[2]) || !IsValidId(words[3])) {
+                    return false;
+                }
+                uint32_t condition = GetRegister(words[1]);
+                if (condition == kNone) {
+                    return false;
+                }
+                AddInstruction(Op::BranchConditional, 0, 0,
+                               {{condition, words[2], words[3], mCurrentLabel}});
+                return true;
+            }
+
+            case spv::OpSwitch: {
+                // The targets are stored as the default label followed by pairs of literal and
+                // label.
+                if (wordCount < 3 || (wordCount - 3) % 2 != 0 || !IsValidId(words[2])) {
+                    return false;
+                }
+                uint32_t selector = GetRegister(words[1]);
+                if (selector == kNone || GetValueType(words[1])->wordCount != 1) {
+                    return false;
+                }
+                std::vector<uint32_t> targets = {words[2]};
+                for (uint32_t i = 3; i < wordCount; i += 2) {
+                    if (!IsValidId(words[i + 1])) {
+                        return false;
+                    }
+                    targets.push_back(words[i]);
+                    targets.push_back(words[i + 1]);
+                }
+                AddInstruction(Op::Switch, 0, 0, {{selector, 0, 0, mCurrentLabel}}, targets);
+                return true;
+            }
+
+            case spv::OpFunctionCall: {
+                // The arguments are stored as pairs of argument register and number of words,
+                // followed by the parameter registers once all the functions are known.
+                if (wordCount < 4 || !IsValidId(words[3])) {
+                    return false;
+                }
+                std::vector<uint32_t> arguments;
+                for (uint32_t i = 4; i < wordCount; ++i) {
+                    uint32_t argument = GetRegister(words[i]);
+                    if (argument == kNone) {
+                        return false;
+                    }
+                    arguments.push_back(argument);
+                    arguments.push_back(GetValueType(words[i])->wordCount);
+                }
+                Type* type = GetType(words[1]);
+                if (type == nullptr) {
+                    return false;
+                }
+                uint32_t result = 0;
+                if (type->kind != TypeKind::Void) {
+                    result = AllocateValue(words[2], words[1]);
+                    if (result == kNone) {
+                        return false;
+                    }
+                }
+                AddInstruction(Op::FunctionCall, type->wordCount, result,
+                               {{words[3], 0, 0, 0}}, arguments);
+                return true;
+            }
+
+            case spv::OpReturn:
+            case spv::OpReturnValue: {
+                uint32_t value = 0;
+                uint32_t count = 0;
+                if (opcode == spv::OpReturnValue) {
+                    if (wordCount < 2) {
+                        return false;
+                    }
+                    value = GetRegister(words[1]);
+                    if (value == kNone) {
+                        return false;
+                    }
+                    count = GetValueType(words[1])->wordCount;
+                }
+                bool isEntryPoint = mCurrentFunctionId == mEntryFunction;
+                AddInstruction(Op::Return, count, 0,
+                               {{mCurrentFunction->index, value, isEntryPoint ? 1u : 0u, 0}});
+                return true;
+            }
+
+            case spv::OpKill:
+            case spv::OpUnreachable:
+                AddInstruction(Op::Kill, 0, 0);
+                return true;
+
+            case spv::OpControlBarrier:
+                AddInstruction(Op::Barrier, 0, 0);
+                return true;
+
+            case spv::OpMemoryBarrier:
+                // The lanes of a workgroup run on a single thread so their memory accesses are
+                // always visible to each other.
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    bool ComputeProgram::Compiler::ProcessExtInst(const uint32_t* words, uint32_t wordCount) {
+        if (wordCount < 5 || words[3] != mGlslStd450) {
+            return false;
+        }
+        uint32_t extOp = words[4];
+        uint32_t operandCount = wordCount - 5;
+
+        uint32_t expectedOperandCount;
+        switch (extOp) {
+            case kGlslStd450Round:
+            case kGlslStd450RoundEven:
+            case kGlslStd450Trunc:
+            case kGlslStd450FAbs:
+            case kGlslStd450SAbs:
+            case kGlslStd450FSign:
+            case kGlslStd450SSign:
+            case kGlslStd450Floor:
+            case kGlslStd450Ceil:
+            case kGlslStd450Fract:
+            case kGlslStd450Sin:
+            case kGlslStd450Cos:
+            case kGlslStd450Tan:
+            case kGlslStd450Asin:
+            case kGlslStd450Acos:
+            case kGlslStd450Atan:
+            case kGlslStd450Exp:
+            case kGlslStd450Log:
+            case kGlslStd450Exp2:
+            case kGlslStd450Log2:
+            case kGlslStd450Sqrt:
+            case kGlslStd450InverseSqrt:
+            case kGlslStd450Length:
+            case kGlslStd450Normalize:
+            case kGlslStd450FindILsb:
+            case kGlslStd450FindSMsb:
+            case kGlslStd450FindUMsb:
+                expectedOperandCount = 1;
+                break;
+
+            case kGlslStd450Atan2:
+            case kGlslStd450Pow:
+            case kGlslStd450FMin:
+            case kGlslStd450UMin:
+            case kGlslStd450SMin:
+            case kGlslStd450FMax:
+            case kGlslStd450UMax:
+            case kGlslStd450SMax:
+            case kGlslStd450Step:
+            case kGlslStd450Distance:
+            case kGlslStd450Cross:
+            case kGlslStd450NMin:
+            case kGlslStd450NMax:
+                expectedOperandCount = 2;
+                break;
+
+            case kGlslStd450FClamp:
+            case kGlslStd450UClamp:
+            case kGlslStd450SClamp:
+            case kGlslStd450FMix:
+            case kGlslStd450SmoothStep:
+            case kGlslStd450Fma:
+            case kGlslStd450NClamp:
+                expectedOperandCount = 3;
+                break;
+
+            default:
+                return false;
+        }
+        if (operandCount != expectedOperandCount) {
+            return false;
+        }
+
+        Type* type = GetType(words[1]);
+        if (type == nullptr) {
+            return false;
+        }
+        // Length and Distance reduce their operands so the count is the one of the operands.
+        uint32_t count = type->wordCount;
+        std::array<uint32_t, 4> operands = {{0, 0, 0, 0}};
+        for (uint32_t i = 0; i < operandCount; ++i) {
+            operands[i] = GetRegister(words[5 + i]);
+            if (operands[i] == kNone) {
+                return false;
+            }
+            uint32_t operandWordCount = GetValueType(words[5 + i])->wordCount;
+            if (extOp == kGlslStd450Length || extOp == kGlslStd450Distance) {
+                count = operandWordCount;
+            } else if (operandWordCount != count) {
+                return false;
+            }
+        }
+        if (extOp == kGlslStd450Cross && count != 3) {
+            return false;
+        }
+
+        uint32_t result = AllocateValue(words[2], words[1]);
+        if (result == kNone) {
+            return false;
+        }
+        AddInstruction(Op::ExtInst, count, result, operands);
+        mProgram->mInstructions.back().extOp = static_cast<uint16_t>(extOp);
+        return true;
+    }
+
+    bool ComputeProgram::Compiler::ProcessAtomic(spv::Op opcode,
+                                                 const uint32_t* words,
+                                                 uint32_t wordCount) {
+        // AtomicStore doesn't have a result type and result.
+        bool isStore = opcode == spv::OpAtomicStore;
+        uint32_t pointerId = isStore ? words[1] : words[3];
+        uint32_t minWordCount = 6;
+        switch (opcode) {
+            case spv::OpAtomicLoad:
+            case spv::OpAtomicIIncrement:
+            case spv::OpAtomicIDecrement:
+                minWordCount = 6;
+                break;
+            case spv::OpAtomicStore:
+                minWordCount = 5;
+                break;
+            case spv::OpAtomicCompareExchange:
+                minWordCount = 9;
+                break;
+            default:
+                minWordCount = 7;
+                break;
+        }
+        if (wordCount < minWordCount) {
+            return false;
+        }
+
+        uint32_t pointer = GetRegister(pointerId);
+        if (pointer == kNone || GetValueType(pointerId)->kind != TypeKind::Pointer) {
+            return false;
+        }
+
+        Op op;
+        uint32_t value = 0;
+        uint32_t comparator = 0;
+        switch (opcode) {
+            case spv::OpAtomicLoad:
+                op = Op::AtomicLoad;
+                break;
+            case spv::OpAtomicStore:
+                op = Op::AtomicStore;
+                value = GetRegister(words[4]);
+                break;
+            case spv::OpAtomicExchange:
+                op = Op::AtomicExchange;
+                break;
+            case spv::OpAtomicCompareExchange:
+                op = Op::AtomicCompareExchange;
+                value = GetRegister(words[7]);
+                comparator = GetRegister(words[8]);
+                break;
+            case spv::OpAtomicIIncrement:
+                op = Op::AtomicIIncrement;
+                break;
+            case spv::OpAtomicIDecrement:
+                op = Op::AtomicIDecrement;
+                break;
+            case spv::OpAtomicIAdd:
+                op = Op::AtomicIAdd;
+                break;
+            case spv::OpAtomicISub:
+                op = Op::AtomicISub;
+                break;
+            case spv::OpAtomicSMin:
+                op = Op::AtomicSMin;
+                break;
+            case spv::OpAtomicUMin:
+                op = Op::AtomicUMin;
+                break;
+            case spv::OpAtomicSMax:
+                op = Op::AtomicSMax;
+                break;
+            case spv::OpAtomicUMax:
+                op = Op::AtomicUMax;
+                break;
+            case spv::OpAtomicAnd:
+                op = Op::AtomicAnd;
+                break;
+            case spv::OpAtomicOr:
+                op = Op::AtomicOr;
+                break;
+            case spv::OpAtomicXor:
+                op = Op::AtomicXor;
+                break;
+            default:
+                UNREACHABLE();
+                return false;
+        }
+        if (minWordCount == 7 && op != Op::AtomicCompareExchange) {
+            value = GetRegister(words[6]);
+        }
+        if (value == kNone || comparator == kNone) {
+            return false;
+        }
+
+        uint32_t result = 0;
+        if (!isStore) {
+            result = AllocateValue(words[2], words[1]);
+            if (result == kNone) {
+                return false;
+            }
+        }
+        AddInstruction(op, 1, result, {{pointer, value, comparator, 0}});
+        return true;
+    }
+
+    bool ComputeProgram::Compiler::ResolveFixups() {
+        std::vector<Instruction>& instructions = mProgram->mInstructions;
+        std::vector<uint32_t>& extra = mProgram->mExtraOperands;
+
+        auto ResolveLabel = [this](uint32_t* label) -> bool {
+            if (!IsValidId(*label) || mLabelPcs[*label] == kNone) {
+                return false;
+            }
+            *label = mLabelPcs[*label];
+            return true;
+        };
+
+        for (Instruction& instruction : instructions) {
+            switch (instruction.op) {
+                case Op::Branch:
+                    if (!ResolveLabel(&instruction.operands[0])) {
+                        return false;
+                    }
+                    break;
+
+                case Op::BranchConditional:
+                    if (!ResolveLabel(&instruction.operands[1]) ||
+                        !ResolveLabel(&instruction.operands[2])) {
+                        return false;
+                    }
+                    break;
+
+                case Op::Switch:
+                    if (!ResolveLabel(&extra[instruction.extraBegin])) {
+                        return false;
+                    }
+                    for (uint32_t i = 2; i < instruction.extraCount; i += 2) {
+                        if (!ResolveLabel(&extra[instruction.extraBegin + i])) {
+                            return false;
+                        }
+                    }
+                    break;
+
+                case Op::FunctionCall: {
+                    // Replace the function id by its entry point and the pairs of argument and
+                    // word count by triples of parameter, argument and word count.
+                    uint32_t functionId = instruction.operands[0];
+                    const Function& function = mFunctions[functionId];
+                    if (function.entryPc == kNone ||
+                        function.parameters.size() * 2 != instruction.extraCount) {
+                        return false;
+                    }
+                    instruction.operands[0] = function.entryPc;
+                    instruction.operands[1] = function.index;
+
+                    std::vector<uint32_t> arguments;
+                    for (size_t i = 0; i < function.parameters.size(); ++i) {
+                        uint32_t parameter = function.parameters[i];
+                        uint32_t argument = extra[instruction.extraBegin + 2 * i];
+                        uint32_t count = extra[instruction.extraBegin + 2 * i + 1];
+                        if (GetType(mValues[parameter].type)->wordCount != count) {
+                            return false;
+                        }
+                        arguments.push_back(mValues[parameter].reg);
+                        arguments.push_back(argument);
+                        arguments.push_back(count);
+                    }
+                    instruction.extraBegin = static_cast<uint32_t>(extra.size());
+                    instruction.extraCount = static_cast<uint32_t>(arguments.size());
+                    extra.insert(extra.end(), arguments.begin(), arguments.end());
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        const std::array<uint32_t, 3>& size = mProgram->mWorkgroupSize;
+        uint64_t invocationCount = static_cast<uint64_t>(size[0]) * size[1] * size[2];
+        if (invocationCount == 0 || invocationCount > kMaxInvocationCount) {
+            return false;
+        }
+        mProgram->mInvocationCount = static_cast<uint32_t>(invocationCount);
+        return true;
+    }
+
+    bool ComputeProgram::Compiler::IsValidId(uint32_t id) const {
+        return id != 0 && id < mBound;
+    }
+
+    ComputeProgram::Compiler::Type* ComputeProgram::Compiler::GetType(uint32_t id) {
+        if (!IsValidId(id) || mTypes[id].kind == TypeKind::None) {
+            return nullptr;
+        }
+        return &mTypes[id];
+    }
+
+    // Must only be called for values that have been allocated.
+    ComputeProgram::Compiler::Type* ComputeProgram::Compiler::GetValueType(uint32_t id) {
+        ASSERT(IsValidId(id) && mValues[id].reg != kNone);
+        return &mTypes[mValues[id].type];
+    }
+
+    bool ComputeProgram::Compiler::IsScalarOrVectorOf(uint32_t typeId, TypeKind kind) {
+        Type* type = GetType(typeId);
+        if (type != nullptr && type->kind == TypeKind::Vector) {
+            type = GetType(type->element);
+        }
+        return type != nullptr && type->kind == kind;
+    }
+
+    uint32_t ComputeProgram::Compiler::GetRegister(uint32_t id) {
+        if (!IsValidId(id)) {
+            return kNone;
+        }
+        return mValues[id].reg;
+    }
+
+    uint32_t ComputeProgram::Compiler::AllocateValue(uint32_t id, uint32_t typeId) {
+        Type* type = GetType(typeId);
+        if (!IsValidId(id) || type == nullptr || type->kind == TypeKind::Void ||
+            type->kind == TypeKind::Function) {
+            return kNone;
+        }
+
+        Value& value = mValues[id];
+        if (value.reg != kNone) {
+            // Values used by phis before their definition are already allocated.
+            return value.type == typeId && !value.isConstant ? value.reg : kNone;
+        }
+        if (type->wordCount > (1u << 20) || mProgram->mRegisterCount > (1u << 24)) {
+            return kNone;
+        }
+        value.type = typeId;
+        value.reg = mProgram->mRegisterCount;
+        mProgram->mRegisterCount += type->wordCount;
+        return value.reg;
+    }
+
+    bool ComputeProgram::Compiler::AllocateConstant(uint32_t id,
+                                                    uint32_t typeId,
+                                                    std::vector<uint32_t> words) {
+        uint32_t reg = AllocateValue(id, typeId);
+        if (reg == kNone) {
+            return false;
+        }
+        Value& value = mValues[id];
+        ASSERT(words.size() == mTypes[typeId].wordCount);
+        for (uint32_t i = 0; i < words.size(); ++i) {
+            mProgram->mConstants.push_back({reg + i, words[i]});
+        }
+        value.isConstant = true;
+        value.constantWords = std::move(words);
+        return true;
+    }
+
+    uint32_t ComputeProgram::Compiler::GetZeroRegister() {
+        if (mZeroRegister == kNone) {
+            mZeroRegister = mProgram->mRegisterCount++;
+            mProgram->mConstants.push_back({mZeroRegister, 0});
+        }
+        return mZeroRegister;
+    }
+
+    bool ComputeProgram::Compiler::GetMemorySize(uint32_t typeId,
+                                                 uint32_t matrixStride,
+                                                 uint32_t* size) {
+        Type* type = GetType(typeId);
+        if (type == nullptr) {
+            return false;
+        }
+
+        uint64_t result;
+        switch (type->kind) {
+            case TypeKind::Bool:
+            case TypeKind::Int:
+            case TypeKind::Float:
+                result = sizeof(uint32_t);
+                break;
+
+            case TypeKind::Vector:
+                result = type->count * sizeof(uint32_t);
+                break;
+
+            case TypeKind::Matrix: {
+                uint32_t columnSize;
+                if (!GetMemorySize(type->element, 0, &columnSize)) {
+                    return false;
+                }
+                result = static_cast<uint64_t>(type->count) *
+                         (matrixStride != 0 ? matrixStride : columnSize);
+                break;
+            }
+
+            case TypeKind::Array: {
+                uint32_t stride;
+                if (!GetArrayStride(typeId, matrixStride, &stride)) {
+                    return false;
+                }
+                result = static_cast<uint64_t>(type->count) * stride;
+                break;
+            }
+
+            case TypeKind::RuntimeArray:
+                result = 0;
+                break;
+
+            case TypeKind::Struct: {
+                result = 0;
+                for (uint32_t member = 0; member < type->members.size(); ++member) {
+                    uint32_t offset;
+                    uint32_t memberSize;
+                    uint32_t memberMatrixStride = 0;
+                    const Decoration& decoration = mDecorations[typeId];
+                    if (member < decoration.members.size()) {
+                        memberMatrixStride = decoration.members[member].matrixStride;
+                    }
+                    if (!GetMemberOffset(typeId, member, &offset) ||
+                        !GetMemorySize(type->members[member], memberMatrixStride, &memberSize)) {
+                        return false;
+                    }
+                    result = std::max(result, static_cast<uint64_t>(offset) + memberSize);
+                }
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        if (result >= kOutOfBounds) {
+            return false;
+        }
+        *size = static_cast<uint32_t>(result);
+        return true;
+    }
+
+    bool ComputeProgram::Compiler::GetArrayStride(uint32_t typeId,
+                                                  uint32_t matrixStride,
+                                                  uint32_t* stride) {
+        Type* type = GetType(typeId);
+        if (type == nullptr ||
+            (type->kind != TypeKind::Array && type->kind != TypeKind::RuntimeArray)) {
+            return false;
+        }
+        if (mDecorations[typeId].arrayStride != 0) {
+            *stride = mDecorations[typeId].arrayStride;
+            return true;
+        }
+        return GetMemorySize(type->element, matrixStride, stride);
+    }
+
+    bool ComputeProgram::Compiler::GetMemberOffset(uint32_t structId,
+                                                   uint32_t member,
+                                                   uint32_t* offset) {
+        Type* type = GetType(structId);
+        ASSERT(type != nullptr && type->kind == TypeKind::Struct);
+        const Decoration& decoration = mDecorations[structId];
+        if (member < decoration.members.size() && decoration.members[member].offset != kNone) {
+            *offset = decoration.members[member].offset;
+            return true;
+        }
+
+        // Members without an Offset are tightly packed.
+        uint64_t result = 0;
+        for (uint32_t i = 0; i < member; ++i) {
+            uint32_t memberSize;
+            if (!GetMemorySize(type->members[i], 0, &memberSize)) {
+                return false;
+            }
+            result += memberSize;
+        }
+        if (result >= kOutOfBounds) {
+            return false;
+        }
+        *offset = static_cast<uint32_t>(result);
+        return true;
+    }
+
+    bool ComputeProgram::Compiler::AppendWordOffsets(uint32_t typeId,
+                                                     uint32_t matrixStride,
+                                                     uint32_t baseOffset,
+                                                     std::vector<uint32_t>* offsets) {
+        Type* type = GetType(typeId);
+        if (type == nullptr) {
+            return false;
+        }
+
+        switch (type->kind) {
+            case TypeKind::Bool:
+            case TypeKind::Int:
+            case TypeKind::Float:
+                offsets->push_back(baseOffset);
+                return true;
+
+            case TypeKind::Vector:
+                for (uint32_t i = 0; i < type->count; ++i) {
+                    offsets->push_back(baseOffset + i * static_cast<uint32_t>(sizeof(uint32_t)));
+                }
+                return true;
+
+            case TypeKind::Matrix:
+            case TypeKind::Array: {
+                uint32_t stride;
+                if (type->kind == TypeKind::Matrix) {
+                    if (!GetMemorySize(type->element, 0, &stride)) {
+                        return false;
+                    }
+                    if (matrixStride != 0) {
+                        stride = matrixStride;
+                    }
+                } else if (!GetArrayStride(typeId, matrixStride, &stride)) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < type->count; ++i) {
+                    if (!AppendWordOffsets(type->element, matrixStride, baseOffset + i * stride,
+                                           offsets)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            case TypeKind::Struct:
+                for (uint32_t member = 0; member < type->members.size(); ++member) {
+                    uint32_t offset;
+                    uint32_t memberMatrixStride = 0;
+                    const Decoration& decoration = mDecorations[typeId];
+                    if (member < decoration.members.size()) {
+                        if (decoration.members[member].rowMajor) {
+                            return false;
+                        }
+                        memberMatrixStride = decoration.members[member].matrixStride;
+                    }
+                    if (!GetMemberOffset(typeId, member, &offset) ||
+                        !AppendWordOffsets(type->members[member], memberMatrixStride,
+                                           baseOffset + offset, offsets)) {
+                        return false;
+                    }
+                }
+                return true;
+
+            default:
+                // Runtime arrays and pointers can't be loaded or stored.
+                return false;
+        }
+    }
+
+    bool ComputeProgram::Compiler::AllocateMemory(uint32_t typeId,
+                                                  uint32_t* memorySize,
+                                                  uint32_t* offset) {
+        uint32_t size;
+        if (!GetMemorySize(typeId, 0, &size)) {
+            return false;
+        }
+        uint64_t end = static_cast<uint64_t>(*memorySize) + size;
+        if (end > (1u << 24)) {
+            return false;
+        }
+        *offset = *memorySize;
+        *memorySize = Align(static_cast<uint32_t>(end), kVariableAlignment);
+        return true;
+    }
+
+    void ComputeProgram::Compiler::AddInstruction(Op op,
+                                                  uint32_t count,
+                                                  uint32_t result,
+                                                  std::array<uint32_t, 4> operands,
+                                                  const std::vector<uint32_t>& extra) {
+        Instruction instruction;
+        instruction.op = op;
+        instruction.extOp = 0;
+        instruction.count = count;
+        instruction.result = result;
+        instruction.operands = operands;
+        instruction.extraBegin = static_cast<uint32_t>(mProgram->mExtraOperands.size());
+        instruction.extraCount = static_cast<uint32_t>(extra.size());
+        mProgram->mExtraOperands.insert(mProgram->mExtraOperands.end(), extra.begin(),
+                                        extra.end());
+        mProgram->mInstructions.push_back(instruction);
+
+        if (op != Op::Phi) {
+            mPhiInstruction = kNone;
+        }
+    }
+
+    // Executor
+
+    // Runs workgroups of a dispatch. Each worker thread has its own executor, and the registers
+    // of a lane are at the index of the lane in blocks of words with one word per lane.
+    class ComputeProgram::Executor {
+      public:
+        Executor(const ComputeProgram* program,
+                 const std::vector<MemoryRegion>& bufferRegions,
+                 const std::array<uint32_t, 3>& groupCount,
+                 std::mutex* atomicMutex);
+
+        void RunWorkgroup(uint32_t x, uint32_t y, uint32_t z);
+
+      private:
+        enum class LaneState : uint8_t {
+            Running,
+            AtBarrier,
+            Done,
+        };
+
+        // Returned by Step when the lanes must be selected again.
+        static constexpr uint32_t kSelectLanes = kNone;
+
+        bool SelectLanes(uint32_t* pc);
+        uint32_t Step(const Instruction& instruction, uint32_t pc);
+        // Moves each active lane to the pc returned by |GetTarget| and returns the next pc if
+        // the lanes can continue together.
+        template <typename F>
+        uint32_t Jump(F&& GetTarget);
+
+        template <typename F>
+        void ForEachLane(F&& f) const;
+        template <typename T, typename F>
+        void ComponentWise1(const Instruction& instruction, F&& f);
+        template <typename T, typename F>
+        void ComponentWise2(const Instruction& instruction, F&& f);
+        template <typename T, typename F>
+        void ComponentWise3(const Instruction& instruction, F&& f);
+        void ExecuteExtInst(const Instruction& instruction);
+        void ExecuteAtomic(const Instruction& instruction);
+
+        uint32_t* GetRegister(uint32_t reg) {
+            return &mRegisters[static_cast<size_t>(reg) * mLaneCount];
+        }
+        const uint32_t* GetExtra(const Instruction& instruction) const {
+            return &mProgram->mExtraOperands[instruction.extraBegin];
+        }
+        // Returns a pointer to |size| bytes at |offset| in the region, or nullptr if they aren't
+        // in the bounds of the region.
+        uint8_t* GetMemory(uint32_t lane, uint32_t region, uint64_t offset, uint32_t size);
+
+        const ComputeProgram* mProgram;
+        std::array<uint32_t, 3> mGroupCount;
+        std::mutex* mAtomicMutex;
+        uint32_t mLaneCount;
+
+        std::vector<uint32_t> mRegisters;
+        std::vector<uint8_t> mPrivateMemory;
+        std::vector<uint8_t> mWorkgroupMemory;
+        std::vector<MemoryRegion> mRegions;
+
+        std::vector<uint32_t> mPcs;
+        std::vector<uint32_t> mPreviousLabels;
+        std::vector<LaneState> mLaneStates;
+        // The call site of each function for each lane.
+        std::vector<uint32_t> mCallSites;
+        // The lanes executing the current instructions, all the lanes if mAllLanesActive.
+        std::vector<uint32_t> mActiveLanes;
+        bool mAllLanesActive = false;
+        // Whether all the running lanes are active and can continue without being selected
+        // again.
+        bool mAllRunningLanesActive = false;
+        std::vector<uint32_t> mPhiValues;
+    };
+
+    ComputeProgram::Executor::Executor(const ComputeProgram* program,
+                                       const std::vector<MemoryRegion>& bufferRegions,
+                                       const std::array<uint32_t, 3>& groupCount,
+                                       std::mutex* atomicMutex)
+        : mProgram(program),
+          mGroupCount(groupCount),
+          mAtomicMutex(atomicMutex),
+          mLaneCount(program->mInvocationCount) {
+        mRegisters.resize(static_cast<size_t>(program->mRegisterCount) * mLaneCount);
+        for (const RegisterValue& constant : program->mConstants) {
+            uint32_t* reg = GetRegister(constant.reg);
+            std::fill(reg, reg + mLaneCount, constant.value);
+        }
+
+        mPrivateMemory.resize(static_cast<size_t>(program->mPrivateMemorySize) * mLaneCount);
+        mWorkgroupMemory.resize(program->mWorkgroupMemorySize);
+
+        // The private region is different for each lane so it is handled in GetMemory.
+        mRegions.push_back({nullptr, 0});
+        mRegions.push_back({mWorkgroupMemory.data(), program->mWorkgroupMemorySize});
+        mRegions.insert(mRegions.end(), bufferRegions.begin(), bufferRegions.end());
+
+        mPcs.resize(mLaneCount);
+        mPreviousLabels.resize(mLaneCount);
+        mLaneStates.resize(mLaneCount);
+        mCallSites.resize(static_cast<size_t>(program->mFunctionCount) * mLaneCount);
+        mActiveLanes.reserve(mLaneCount);
+    }
+
+    void ComputeProgram::Executor::RunWorkgroup(uint32_t x, uint32_t y, uint32_t z) {
+        const ComputeProgram* program = mProgram;
+        const std::array<uint32_t, 3>& size = program->mWorkgroupSize;
+
+        std::fill(mPrivateMemory.begin(), mPrivateMemory.end(), 0);
+        std::fill(mWorkgroupMemory.begin(), mWorkgroupMemory.end(), 0);
+        for (uint32_t lane = 0; lane < mLaneCount; ++lane) {
+            uint8_t* privateMemory =
+                &mPrivateMemory[static_cast<size_t>(lane) * program->mPrivateMemorySize];
+            for (const MemoryValue& initializer : program->mPrivateInitializers) {
+                StoreWord(privateMemory + initializer.offset, initializer.value);
+            }
+
+            std::array<uint32_t, 3> localId = {
+                {lane % size[0], (lane / size[0]) % size[1], lane / (size[0] * size[1])}};
+            std::array<uint32_t, 3> groupId = {{x, y, z}};
+            for (const BuiltInVariable& builtIn : program->mBuiltIns) {
+                std::array<uint32_t, 3> value = {{0, 0, 0}};
+                uint32_t count = 3;
+                switch (builtIn.builtIn) {
+                    case spv::BuiltInNumWorkgroups:
+                        value = mGroupCount;
+                        break;
+                    case spv::BuiltInWorkgroupId:
+                        value = groupId;
+                        break;
+                    case spv::BuiltInLocalInvocationId:
+                        value = localId;
+                        break;
+                    case spv::BuiltInGlobalInvocationId:
+                        for (uint32_t i = 0; i < 3; ++i) {
+                            value[i] = groupId[i] * size[i] + localId[i];
+                        }
+                        break;
+                    case spv::BuiltInLocalInvocationIndex:
+                        value[0] = lane;
+                        count = 1;
+                        break;
+                    default:
+                        UNREACHABLE();
+                        break;
+                }
+                memcpy(privateMemory + builtIn.offset, value.data(), count * sizeof(uint32_t));
+            }
+
+            mPcs[lane] = program->mEntryPoint;
+            mPreviousLabels[lane] = 0;
+            mLaneStates[lane] = LaneState::Running;
+        }
+
+        uint32_t pc;
+        while (SelectLanes(&pc)) {
+            // Run the selected lanes until they need to be selected again.
+            while (pc != kSelectLanes) {
+                pc = Step(program->mInstructions[pc], pc);
+            }
+        }
+    }
+
+    // Selects the running lanes with the smallest pc. Lanes jump forward to the merge blocks of
+    // their constructs, so the lanes that took a shorter path wait for the other ones there and
+    // the lanes reconverge. When all the lanes are waiting at barriers, they are released.
+    bool ComputeProgram::Executor::SelectLanes(uint32_t* pc) {
+        while (true) {
+            uint32_t minPc = kNone;
+            uint32_t runningCount = 0;
+            bool hasLanesAtBarrier = false;
+            for (uint32_t lane = 0; lane < mLaneCount; ++lane) {
+                if (mLaneStates[lane] == LaneState::Running) {
+                    minPc = std::min(minPc, mPcs[lane]);
+                    runningCount++;
+                } else if (mLaneStates[lane] == LaneState::AtBarrier) {
+                    hasLanesAtBarrier = true;
+                }
+            }
+
+            if (runningCount == 0) {
+                if (!hasLanesAtBarrier) {
+                    return false;
+                }
+                for (uint32_t lane = 0; lane < mLaneCount; ++lane) {
+                    if (mLaneStates[lane] == LaneState::AtBarrier) {
+                        mLaneStates[lane] = LaneState::Running;
+                        mPcs[lane]++;
+                    }
+                }
+                continue;
+            }
+
+            mActiveLanes.clear();
+            for (uint32_t lane = 0; lane < mLaneCount; ++lane) {
+                if (mLaneStates[lane] == LaneState::Running && mPcs[lane] == minPc) {
+                    mActiveLanes.push_back(lane);
+                }
+            }
+            mAllLanesActive = mActiveLanes.size() == mLaneCount;
+            mAllRunningLanesActive = mActiveLanes.size() == runningCount;
+            *pc = minPc;
+            return true;
+        }
+    }
+
+    template <typename F>
+    void ComputeProgram::Executor::ForEachLane(F&& f) const {
+        if (mAllLanesActive) {
+            for (uint32_t lane = 0; lane < mLaneCount; ++lane) {
+                f(lane);
+            }
+        } else {
+            for (uint32_t lane : mActiveLanes) {
+                f(lane);
+            }
+        }
+    }
+
+    template <typename F>
+    uint32_t ComputeProgram::Executor::Jump(F&& GetTarget) {
+        uint32_t commonTarget = kNone;
+        bool isUniform = true;
+        ForEachLane([&](uint32_t lane) {
+            uint32_t target = GetTarget(lane);
+            mPcs[lane] = target;
+            if (commonTarget == kNone) {
+                commonTarget = target;
+            } else if (target != commonTarget) {
+                isUniform = false;
+            }
+        });
+
+        // Lanes still running elsewhere could be waiting at the target, select the lanes again
+        // so that they reconverge.
+        if (isUniform && mAllRunningLanesActive) {
+            return commonTarget;
+        }
+        return kSelectLanes;
+    }
+
+    template <typename T, typename F>
+    void ComputeProgram::Executor::ComponentWise1(const Instruction& instruction, F&& f) {
+        for (uint32_t c = 0; c < instruction.count; ++c) {
+            uint32_t* result = GetRegister(instruction.result + c);
+            const uint32_t* a = GetRegister(instruction.operands[0] + c);
+            ForEachLane([&](uint32_t lane) { result[lane] = ToWord(f(BitCast<T>(a[lane]))); });
+        }
+    }
+
+    template <typename T, typename F>
+    void ComputeProgram::Executor::ComponentWise2(const Instruction& instruction, F&& f) {
+        for (uint32_t c = 0; c < instruction.count; ++c) {
+            uint32_t* result = GetRegister(instruction.result + c);
+            const uint32_t* a = GetRegister(instruction.operands[0] + c);
+            const uint32_t* b = GetRegister(instruction.operands[1] + c);
+            ForEachLane([&](uint32_t lane) {
+                result[lane] = ToWord(f(BitCast<T>(a[lane]), BitCast<T>(b[lane])));
+            });
+        }
+    }
+
+    template <typename T, typename F>
+    void ComputeProgram::Executor::ComponentWise3(const Instruction& instruction, F&& f) {
+        for (uint32_t c = 0; c < instruction.count; ++c) {
+            uint32_t* result = GetRegister(instruction.result + c);
+            const uint32_t* a = GetRegister(instruction.operands[0] + c);
+            const uint32_t* b = GetRegister(instruction.operands[1] + c);
+            const uint32_t* d = GetRegister(instruction.operands[2] + c);
+            ForEachLane([&](uint32_t lane) {
+                result[lane] = ToWord(
+                    f(BitCast<T>(a[lane]), BitCast<T>(b[lane]), BitCast<T>(d[lane])));
+            });
+        }
+    }
+
+    uint8_t* ComputeProgram::Executor::GetMemory(uint32_t lane,
+                                                 uint32_t region,
+                                                 uint64_t offset,
+                                                 uint32_t size) {
+        ASSERT(region < mRegions.size());
+        MemoryRegion memory = mRegions[region];
+        if (region == kPrivateRegion) {
+            memory.size = mProgram->mPrivateMemorySize;
+            memory.data = &mPrivateMemory[static_cast<size_t>(lane) * memory.size];
+        }
+        if (offset + size > memory.size) {
+            return nullptr;
+        }
+        return memory.data + offset;
+    }
+
+    uint32_t ComputeProgram::Executor::Step(const Instruction& instruction, uint32_t pc) {
+        switch (instruction.op) {
+            case Op::IAdd:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a + b; });
+                break;
+            case Op::ISub:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a - b; });
+                break;
+            case Op::IMul:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a * b; });
+                break;
+            case Op::UDiv:
+                ComponentWise2<uint32_t>(
+                    instruction, [](uint32_t a, uint32_t b) { return b == 0 ? 0 : a / b; });
+                break;
+            case Op::SDiv:
+                ComponentWise2<int32_t>(instruction, SafeSDiv);
+                break;
+            case Op::UMod:
+                ComponentWise2<uint32_t>(
+                    instruction, [](uint32_t a, uint32_t b) { return b == 0 ? 0 : a % b; });
+                break;
+            case Op::SRem:
+                ComponentWise2<int32_t>(instruction, SafeSRem);
+                break;
+            case Op::SMod:
+                ComponentWise2<int32_t>(instruction, SafeSMod);
+                break;
+            case Op::ShiftLeftLogical:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a << (b & 31); });
+                break;
+            case Op::ShiftRightLogical:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a >> (b & 31); });
+                break;
+            case Op::ShiftRightArithmetic:
+                ComponentWise2<int32_t>(instruction,
+                                        [](int32_t a, int32_t b) { return a >> (b & 31); });
+                break;
+            case Op::BitwiseAnd:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a & b; });
+                break;
+            case Op::BitwiseOr:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a | b; });
+                break;
+            case Op::BitwiseXor:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a ^ b; });
+                break;
+            case Op::Not:
+                ComponentWise1<uint32_t>(instruction, [](uint32_t a) { return ~a; });
+                break;
+            case Op::SNegate:
+                ComponentWise1<uint32_t>(instruction, [](uint32_t a) { return 0u - a; });
+                break;
+            case Op::BitCount:
+                ComponentWise1<uint32_t>(instruction, BitCount);
+                break;
+            case Op::BitReverse:
+                ComponentWise1<uint32_t>(instruction, BitReverse);
+                break;
+
+            case Op::FAdd:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a + b; });
+                break;
+            case Op::FSub:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a - b; });
+                break;
+            case Op::FMul:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a * b; });
+                break;
+            case Op::FDiv:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a / b; });
+                break;
+            case Op::FRem:
+                ComponentWise2<float>(instruction,
+                                      [](float a, float b) { return std::fmod(a, b); });
+                break;
+            case Op::FMod:
+                ComponentWise2<float>(
+                    instruction, [](float a, float b) { return a - b * std::floor(a / b); });
+                break;
+            case Op::FNegate:
+                ComponentWise1<float>(instruction, [](float a) { return -a; });
+                break;
+
+            case Op::IEqual:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a == b; });
+                break;
+            case Op::INotEqual:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a != b; });
+                break;
+            case Op::UGreaterThan:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a > b; });
+                break;
+            case Op::SGreaterThan:
+                ComponentWise2<int32_t>(instruction, [](int32_t a, int32_t b) { return a > b; });
+                break;
+            case Op::UGreaterThanEqual:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a >= b; });
+                break;
+            case Op::SGreaterThanEqual:
+                ComponentWise2<int32_t>(instruction,
+                                        [](int32_t a, int32_t b) { return a >= b; });
+                break;
+            case Op::ULessThan:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a < b; });
+                break;
+            case Op::SLessThan:
+                ComponentWise2<int32_t>(instruction, [](int32_t a, int32_t b) { return a < b; });
+                break;
+            case Op::ULessThanEqual:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a <= b; });
+                break;
+            case Op::SLessThanEqual:
+                ComponentWise2<int32_t>(instruction,
+                                        [](int32_t a, int32_t b) { return a <= b; });
+                break;
+            case Op::FOrdEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a == b; });
+                break;
+            case Op::FUnordEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return !(a != b); });
+                break;
+            case Op::FOrdNotEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) {
+                    return a < b || a > b;
+                });
+                break;
+            case Op::FUnordNotEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a != b; });
+                break;
+            case Op::FOrdLessThan:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a < b; });
+                break;
+            case Op::FUnordLessThan:
+                ComponentWise2<float>(instruction, [](float a, float b) { return !(a >= b); });
+                break;
+            case Op::FOrdGreaterThan:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a > b; });
+                break;
+            case Op::FUnordGreaterThan:
+                ComponentWise2<float>(instruction, [](float a, float b) { return !(a <= b); });
+                break;
+            case Op::FOrdLessThanEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a <= b; });
+                break;
+            case Op::FUnordLessThanEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return !(a > b); });
+                break;
+            case Op::FOrdGreaterThanEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return a >= b; });
+                break;
+            case Op::FUnordGreaterThanEqual:
+                ComponentWise2<float>(instruction, [](float a, float b) { return !(a < b); });
+                break;
+            case Op::LogicalEqual:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a == b; });
+                break;
+            case Op::LogicalNotEqual:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a != b; });
+                break;
+            case Op::LogicalOr:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a | b; });
+                break;
+            case Op::LogicalAnd:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return a & b; });
+                break;
+            case Op::LogicalNot:
+                ComponentWise1<uint32_t>(instruction, [](uint32_t a) { return a ^ 1u; });
+                break;
+            case Op::IsNan:
+                ComponentWise1<float>(instruction, [](float a) { return std::isnan(a); });
+                break;
+            case Op::IsInf:
+                ComponentWise1<float>(instruction, [](float a) { return std::isinf(a); });
+                break;
+
+            case Op::ConvertFToU:
+                ComponentWise1<float>(instruction, FloatToUint);
+                break;
+            case Op::ConvertFToS:
+                ComponentWise1<float>(instruction, FloatToInt);
+                break;
+            case Op::ConvertSToF:
+                ComponentWise1<int32_t>(instruction,
+                                        [](int32_t a) { return static_cast<float>(a); });
+                break;
+            case Op::ConvertUToF:
+                ComponentWise1<uint32_t>(instruction,
+                                         [](uint32_t a) { return static_cast<float>(a); });
+                break;
+
+            case Op::Select: {
+                bool isComponentWise = instruction.operands[3] != 0;
+                for (uint32_t c = 0; c < instruction.count; ++c) {
+                    uint32_t* result = GetRegister(instruction.result + c);
+                    const uint32_t* condition =
+                        GetRegister(instruction.operands[0] + (isComponentWise ? c : 0));
+                    const uint32_t* accept = GetRegister(instruction.operands[1] + c);
+                    const uint32_t* reject = GetRegister(instruction.operands[2] + c);
+                    ForEachLane([&](uint32_t lane) {
+                        result[lane] = condition[lane] != 0 ? accept[lane] : reject[lane];
+                    });
+                }
+            } break;
+
+            case Op::ExtInst:
+                ExecuteExtInst(instruction);
+                break;
+
+            case Op::Any:
+            case Op::All: {
+                bool isAll = instruction.op == Op::All;
+                uint32_t* result = GetRegister(instruction.result);
+                ForEachLane([&](uint32_t lane) { result[lane] = isAll ? 1 : 0; });
+                for (uint32_t c = 0; c < instruction.count; ++c) {
+                    const uint32_t* a = GetRegister(instruction.operands[0] + c);
+                    if (isAll) {
+                        ForEachLane([&](uint32_t lane) { result[lane] &= a[lane]; });
+                    } else {
+                        ForEachLane([&](uint32_t lane) { result[lane] |= a[lane]; });
+                    }
+                }
+            } break;
+
+            case Op::Dot: {
+                uint32_t* result = GetRegister(instruction.result);
+                ForEachLane([&](uint32_t lane) {
+                    float sum = 0.0f;
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        sum += AsFloat(GetRegister(instruction.operands[0] + c)[lane]) *
+                               AsFloat(GetRegister(instruction.operands[1] + c)[lane]);
+                    }
+                    result[lane] = ToWord(sum);
+                });
+            } break;
+
+            case Op::VectorTimesScalar: {
+                const uint32_t* scalar = GetRegister(instruction.operands[1]);
+                for (uint32_t c = 0; c < instruction.count; ++c) {
+                    uint32_t* result = GetRegister(instruction.result + c);
+                    const uint32_t* a = GetRegister(instruction.operands[0] + c);
+                    ForEachLane([&](uint32_t lane) {
+                        result[lane] = ToWord(AsFloat(a[lane]) * AsFloat(scalar[lane]));
+                    });
+                }
+            } break;
+
+            case Op::MatrixTimesVector: {
+                uint32_t rows = instruction.count;
+                uint32_t columns = instruction.operands[2];
+                for (uint32_t row = 0; row < rows; ++row) {
+                    uint32_t* result = GetRegister(instruction.result + row);
+                    ForEachLane([&](uint32_t lane) {
+                        float sum = 0.0f;
+                        for (uint32_t column = 0; column < columns; ++column) {
+                            sum += AsFloat(GetRegister(instruction.operands[0] + column * rows +
+                                                       row)[lane]) *
+                                   AsFloat(GetRegister(instruction.operands[1] + column)[lane]);
+                        }
+                        result[lane] = ToWord(sum);
+                    });
+                }
+            } break;
+
+            case Op::VectorTimesMatrix: {
+                uint32_t columns = instruction.count;
+                uint32_t rows = instruction.operands[2];
+                for (uint32_t column = 0; column < columns; ++column) {
+                    uint32_t* result = GetRegister(instruction.result + column);
+                    ForEachLane([&](uint32_t lane) {
+                        float sum = 0.0f;
+                        for (uint32_t row = 0; row < rows; ++row) {
+                            sum += AsFloat(GetRegister(instruction.operands[0] + row)[lane]) *
+                                   AsFloat(GetRegister(instruction.operands[1] + column * rows +
+                                                       row)[lane]);
+                        }
+                        result[lane] = ToWord(sum);
+                    });
+                }
+            } break;
+
+            case Op::MatrixTimesMatrix: {
+                uint32_t rows = instruction.operands[2];
+                uint32_t inner = instruction.operands[3];
+                uint32_t columns = instruction.count / rows;
+                for (uint32_t column = 0; column < columns; ++column) {
+                    for (uint32_t row = 0; row < rows; ++row) {
+                        uint32_t* result = GetRegister(instruction.result + column * rows + row);
+                        ForEachLane([&](uint32_t lane) {
+                            float sum = 0.0f;
+                            for (uint32_t k = 0; k < inner; ++k) {
+                                sum += AsFloat(GetRegister(instruction.operands[0] + k * rows +
+                                                           row)[lane]) *
+                                       AsFloat(GetRegister(instruction.operands[1] +
+                                                           column * inner + k)[lane]);
+                            }
+                            result[lane] = ToWord(sum);
+                        });
+                    }
+                }
+            } break;
+
+            case Op::Gather: {
+                const uint32_t* sources = GetExtra(instruction);
+                for (uint32_t c = 0; c < instruction.count; ++c) {
+                    uint32_t* result = GetRegister(instruction.result + c);
+                    const uint32_t* source = GetRegister(sources[c]);
+                    ForEachLane([&](uint32_t lane) { result[lane] = source[lane]; });
+                }
+            } break;
+
+            case Op::VectorExtractDynamic: {
+                uint32_t* result = GetRegister(instruction.result);
+                const uint32_t* index = GetRegister(instruction.operands[1]);
+                uint32_t count = instruction.operands[2];
+                ForEachLane([&](uint32_t lane) {
+                    result[lane] = index[lane] < count
+                                       ? GetRegister(instruction.operands[0] + index[lane])[lane]
+                                       : 0;
+                });
+            } break;
+
+            case Op::VectorInsertDynamic: {
+                const uint32_t* component = GetRegister(instruction.operands[1]);
+                const uint32_t* index = GetRegister(instruction.operands[2]);
+                for (uint32_t c = 0; c < instruction.count; ++c) {
+                    uint32_t* result = GetRegister(instruction.result + c);
+                    const uint32_t* vector = GetRegister(instruction.operands[0] + c);
+                    ForEachLane([&](uint32_t lane) {
+                        result[lane] = index[lane] == c ? component[lane] : vector[lane];
+                    });
+                }
+            } break;
+
+            case Op::Phi: {
+                // All the values are read before any result is written.
+                const uint32_t* extra = GetExtra(instruction);
+                const uint32_t* end = extra + instruction.extraCount;
+                ForEachLane([&](uint32_t lane) {
+                    mPhiValues.clear();
+                    for (const uint32_t* phi = extra; phi != end; phi += 3 + 2 * phi[2]) {
+                        uint32_t source = kNone;
+                        for (uint32_t i = 0; i < phi[2]; ++i) {
+                            if (phi[3 + 2 * i] == mPreviousLabels[lane]) {
+                                source = phi[4 + 2 * i];
+                            }
+                        }
+                        for (uint32_t c = 0; c < phi[1]; ++c) {
+                            mPhiValues.push_back(source == kNone ? 0
+                                                                 : GetRegister(source + c)[lane]);
+                        }
+                    }
+                    size_t value = 0;
+                    for (const uint32_t* phi = extra; phi != end; phi += 3 + 2 * phi[2]) {
+                        for (uint32_t c = 0; c < phi[1]; ++c) {
+                            GetRegister(phi[0] + c)[lane] = mPhiValues[value++];
+                        }
+                    }
+                });
+            } break;
+
+            case Op::AccessChain: {
+                // Offsets out of bounds of the 32-bit range are set to kOutOfBounds so that
+                // accesses through the pointer fail.
+                const uint32_t* baseRegion = GetRegister(instruction.operands[0]);
+                const uint32_t* baseOffset = GetRegister(instruction.operands[0] + 1);
+                uint32_t* resultRegion = GetRegister(instruction.result);
+                uint32_t* resultOffset = GetRegister(instruction.result + 1);
+                const uint32_t* indices = GetExtra(instruction);
+                uint32_t constantOffset = instruction.operands[1];
+                ForEachLane([&](uint32_t lane) {
+                    resultRegion[lane] = baseRegion[lane];
+                    if (baseOffset[lane] == kOutOfBounds || constantOffset == kOutOfBounds) {
+                        resultOffset[lane] = kOutOfBounds;
+                        return;
+                    }
+                    int64_t offset = static_cast<int64_t>(baseOffset[lane]) + constantOffset;
+                    for (uint32_t i = 0; i < instruction.extraCount; i += 2) {
+                        int32_t index = AsInt(GetRegister(indices[i])[lane]);
+                        offset += static_cast<int64_t>(index) * indices[i + 1];
+                    }
+                    resultOffset[lane] = offset >= 0 && offset < kOutOfBounds
+                                             ? static_cast<uint32_t>(offset)
+                                             : kOutOfBounds;
+                });
+            } break;
+
+            case Op::ArrayLength: {
+                uint32_t* result = GetRegister(instruction.result);
+                const uint32_t* region = GetRegister(instruction.operands[0]);
+                const uint32_t* offset = GetRegister(instruction.operands[0] + 1);
+                ForEachLane([&](uint32_t lane) {
+                    uint64_t start = static_cast<uint64_t>(offset[lane]) + instruction.operands[1];
+                    uint64_t size = mRegions[region[lane]].size;
+                    result[lane] = start < size
+                                       ? static_cast<uint32_t>((size - start) /
+                                                               instruction.operands[2])
+                                       : 0;
+                });
+            } break;
+
+            case Op::Load: {
+                const uint32_t* region = GetRegister(instruction.operands[0]);
+                const uint32_t* offset = GetRegister(instruction.operands[0] + 1);
+                const uint32_t* wordOffsets = GetExtra(instruction);
+                uint32_t size = instruction.operands[1];
+                ForEachLane([&](uint32_t lane) {
+                    const uint8_t* data = GetMemory(lane, region[lane], offset[lane], size);
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        uint32_t value = 0;
+                        if (data != nullptr) {
+                            value = LoadWord(data + wordOffsets[c]);
+                        } else {
+                            // Only the words out of bounds read zero.
+                            const uint8_t* word =
+                                GetMemory(lane, region[lane],
+                                          static_cast<uint64_t>(offset[lane]) + wordOffsets[c],
+                                          sizeof(uint32_t));
+                            value = word != nullptr ? LoadWord(word) : 0;
+                        }
+                        GetRegister(instruction.result + c)[lane] = value;
+                    }
+                });
+            } break;
+
+            case Op::Store: {
+                const uint32_t* region = GetRegister(instruction.operands[0]);
+                const uint32_t* offset = GetRegister(instruction.operands[0] + 1);
+                const uint32_t* wordOffsets = GetExtra(instruction);
+                uint32_t size = instruction.operands[2];
+                ForEachLane([&](uint32_t lane) {
+                    uint8_t* data = GetMemory(lane, region[lane], offset[lane], size);
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        uint32_t value = GetRegister(instruction.operands[1] + c)[lane];
+                        if (data != nullptr) {
+                            StoreWord(data + wordOffsets[c], value);
+                        } else {
+                            uint8_t* word =
+                                GetMemory(lane, region[lane],
+                                          static_cast<uint64_t>(offset[lane]) + wordOffsets[c],
+                                          sizeof(uint32_t));
+                            if (word != nullptr) {
+                                StoreWord(word, value);
+                            }
+                        }
+                    }
+                });
+            } break;
+
+            case Op::AtomicLoad:
+            case Op::AtomicStore:
+            case Op::AtomicExchange:
+            case Op::AtomicCompareExchange:
+            case Op::AtomicIIncrement:
+            case Op::AtomicIDecrement:
+            case Op::AtomicIAdd:
+            case Op::AtomicISub:
+            case Op::AtomicSMin:
+            case Op::AtomicUMin:
+            case Op::AtomicSMax:
+            case Op::AtomicUMax:
+            case Op::AtomicAnd:
+            case Op::AtomicOr:
+            case Op::AtomicXor:
+                ExecuteAtomic(instruction);
+                break;
+
+            case Op::Branch:
+                return Jump([&](uint32_t lane) {
+                    mPreviousLabels[lane] = instruction.operands[3];
+                    return instruction.operands[0];
+                });
+
+            case Op::BranchConditional: {
+                const uint32_t* condition = GetRegister(instruction.operands[0]);
+                return Jump([&](uint32_t lane) {
+                    mPreviousLabels[lane] = instruction.operands[3];
+                    return condition[lane] != 0 ? instruction.operands[1]
+                                                : instruction.operands[2];
+                });
+            }
+
+            case Op::Switch: {
+                const uint32_t* selector = GetRegister(instruction.operands[0]);
+                const uint32_t* targets = GetExtra(instruction);
+                return Jump([&](uint32_t lane) {
+                    mPreviousLabels[lane] = instruction.operands[3];
+                    for (uint32_t i = 1; i < instruction.extraCount; i += 2) {
+                        if (targets[i] == selector[lane]) {
+                            return targets[i + 1];
+                        }
+                    }
+                    return targets[0];
+                });
+            }
+
+            case Op::FunctionCall: {
+                const uint32_t* arguments = GetExtra(instruction);
+                uint32_t* callSites =
+                    &mCallSites[static_cast<size_t>(instruction.operands[1]) * mLaneCount];
+                for (uint32_t i = 0; i < instruction.extraCount; i += 3) {
+                    for (uint32_t c = 0; c < arguments[i + 2]; ++c) {
+                        uint32_t* parameter = GetRegister(arguments[i] + c);
+                        const uint32_t* argument = GetRegister(arguments[i + 1] + c);
+                        ForEachLane([&](uint32_t lane) { parameter[lane] = argument[lane]; });
+                    }
+                }
+                ForEachLane([&](uint32_t lane) { callSites[lane] = pc; });
+                // The lanes stay together since they all jump to the entry of the function.
+                return instruction.operands[0];
+            }
+
+            case Op::Return: {
+                if (instruction.operands[2] != 0) {
+                    ForEachLane([&](uint32_t lane) { mLaneStates[lane] = LaneState::Done; });
+                    return kSelectLanes;
+                }
+                const uint32_t* callSites =
+                    &mCallSites[static_cast<size_t>(instruction.operands[0]) * mLaneCount];
+                return Jump([&](uint32_t lane) {
+                    const Instruction& call = mProgram->mInstructions[callSites[lane]];
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        GetRegister(call.result + c)[lane] =
+                            GetRegister(instruction.operands[1] + c)[lane];
+                    }
+                    return callSites[lane] + 1;
+                });
+            }
+
+            case Op::Barrier:
+                ForEachLane([&](uint32_t lane) {
+                    mPcs[lane] = pc;
+                    mLaneStates[lane] = LaneState::AtBarrier;
+                });
+                return kSelectLanes;
+
+            case Op::Kill:
+                ForEachLane([&](uint32_t lane) { mLaneStates[lane] = LaneState::Done; });
+                return kSelectLanes;
+
+            default:
+                UNREACHABLE();
+                break;
+        }
+        return pc + 1;
+    }
+
+    void ComputeProgram::Executor::ExecuteExtInst(const Instruction& instruction) {
+        switch (instruction.extOp) {
+            case kGlslStd450Round:
+                ComponentWise1<float>(instruction, [](float a) { return std::round(a); });
+                break;
+            case kGlslStd450RoundEven:
+                ComponentWise1<float>(instruction, [](float a) { return std::nearbyint(a); });
+                break;
+            case kGlslStd450Trunc:
+                ComponentWise1<float>(instruction, [](float a) { return std::trunc(a); });
+                break;
+            case kGlslStd450FAbs:
+                ComponentWise1<float>(instruction, [](float a) { return std::fabs(a); });
+                break;
+            case kGlslStd450SAbs:
+                ComponentWise1<int32_t>(instruction, [](int32_t a) {
+                    return a < 0 ? static_cast<int32_t>(0u - static_cast<uint32_t>(a)) : a;
+                });
+                break;
+            case kGlslStd450FSign:
+                ComponentWise1<float>(instruction, [](float a) {
+                    return a > 0.0f ? 1.0f : a < 0.0f ? -1.0f : 0.0f;
+                });
+                break;
+            case kGlslStd450SSign:
+                ComponentWise1<int32_t>(instruction,
+                                        [](int32_t a) { return a > 0 ? 1 : a < 0 ? -1 : 0; });
+                break;
+            case kGlslStd450Floor:
+                ComponentWise1<float>(instruction, [](float a) { return std::floor(a); });
+                break;
+            case kGlslStd450Ceil:
+                ComponentWise1<float>(instruction, [](float a) { return std::ceil(a); });
+                break;
+            case kGlslStd450Fract:
+                ComponentWise1<float>(instruction, [](float a) { return a - std::floor(a); });
+                break;
+            case kGlslStd450Sin:
+                ComponentWise1<float>(instruction, [](float a) { return std::sin(a); });
+                break;
+            case kGlslStd450Cos:
+                ComponentWise1<float>(instruction, [](float a) { return std::cos(a); });
+                break;
+            case kGlslStd450Tan:
+                ComponentWise1<float>(instruction, [](float a) { return std::tan(a); });
+                break;
+            case kGlslStd450Asin:
+                ComponentWise1<float>(instruction, [](float a) { return std::asin(a); });
+                break;
+            case kGlslStd450Acos:
+                ComponentWise1<float>(instruction, [](float a) { return std::acos(a); });
+                break;
+            case kGlslStd450Atan:
+                ComponentWise1<float>(instruction, [](float a) { return std::atan(a); });
+                break;
+            case kGlslStd450Exp:
+                ComponentWise1<float>(instruction, [](float a) { return std::exp(a); });
+                break;
+            case kGlslStd450Log:
+                ComponentWise1<float>(instruction, [](float a) { return std::log(a); });
+                break;
+            case kGlslStd450Exp2:
+                ComponentWise1<float>(instruction, [](float a) { return std::exp2(a); });
+                break;
+            case kGlslStd450Log2:
+                ComponentWise1<float>(instruction, [](float a) { return std::log2(a); });
+                break;
+            case kGlslStd450Sqrt:
+                ComponentWise1<float>(instruction, [](float a) { return std::sqrt(a); });
+                break;
+            case kGlslStd450InverseSqrt:
+                ComponentWise1<float>(instruction, [](float a) { return 1.0f / std::sqrt(a); });
+                break;
+            case kGlslStd450FindILsb:
+                ComponentWise1<uint32_t>(instruction, [](uint32_t a) {
+                    return a == 0 ? -1 : FindMsb(a & (0u - a));
+                });
+                break;
+            case kGlslStd450FindSMsb:
+                ComponentWise1<int32_t>(instruction, [](int32_t a) {
+                    return FindMsb(static_cast<uint32_t>(a < 0 ? ~a : a));
+                });
+                break;
+            case kGlslStd450FindUMsb:
+                ComponentWise1<uint32_t>(instruction, FindMsb);
+                break;
+
+            case kGlslStd450Atan2:
+                ComponentWise2<float>(instruction,
+                                      [](float a, float b) { return std::atan2(a, b); });
+                break;
+            case kGlslStd450Pow:
+                ComponentWise2<float>(instruction,
+                                      [](float a, float b) { return std::pow(a, b); });
+                break;
+            case kGlslStd450FMin:
+            case kGlslStd450NMin:
+                ComponentWise2<float>(instruction,
+                                      [](float a, float b) { return std::fmin(a, b); });
+                break;
+            case kGlslStd450UMin:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return std::min(a, b); });
+                break;
+            case kGlslStd450SMin:
+                ComponentWise2<int32_t>(instruction,
+                                        [](int32_t a, int32_t b) { return std::min(a, b); });
+                break;
+            case kGlslStd450FMax:
+            case kGlslStd450NMax:
+                ComponentWise2<float>(instruction,
+                                      [](float a, float b) { return std::fmax(a, b); });
+                break;
+            case kGlslStd450UMax:
+                ComponentWise2<uint32_t>(instruction,
+                                         [](uint32_t a, uint32_t b) { return std::max(a, b); });
+                break;
+            case kGlslStd450SMax:
+                ComponentWise2<int32_t>(instruction,
+                                        [](int32_t a, int32_t b) { return std::max(a, b); });
+                break;
+            case kGlslStd450Step:
+                ComponentWise2<float>(instruction,
+                                      [](float edge, float x) { return x < edge ? 0.0f : 1.0f; });
+                break;
+
+            case kGlslStd450FClamp:
+            case kGlslStd450NClamp:
+                ComponentWise3<float>(instruction, [](float x, float low, float high) {
+                    return std::fmin(std::fmax(x, low), high);
+                });
+                break;
+            case kGlslStd450UClamp:
+                ComponentWise3<uint32_t>(instruction, [](uint32_t x, uint32_t low, uint32_t high) {
+                    return std::min(std::max(x, low), high);
+                });
+                break;
+            case kGlslStd450SClamp:
+                ComponentWise3<int32_t>(instruction, [](int32_t x, int32_t low, int32_t high) {
+                    return std::min(std::max(x, low), high);
+                });
+                break;
+            case kGlslStd450FMix:
+                ComponentWise3<float>(instruction,
+                                      [](float x, float y, float a) { return x + (y - x) * a; });
+                break;
+            case kGlslStd450SmoothStep:
+                ComponentWise3<float>(instruction, [](float edge0, float edge1, float x) {
+                    float t = std::fmin(std::fmax((x - edge0) / (edge1 - edge0), 0.0f), 1.0f);
+                    return t * t * (3.0f - 2.0f * t);
+                });
+                break;
+            case kGlslStd450Fma:
+                ComponentWise3<float>(instruction,
+                                      [](float a, float b, float c) { return std::fma(a, b, c); });
+                break;
+
+            case kGlslStd450Length:
+            case kGlslStd450Distance: {
+                bool isDistance = instruction.extOp == kGlslStd450Distance;
+                uint32_t* result = GetRegister(instruction.result);
+                ForEachLane([&](uint32_t lane) {
+                    float sum = 0.0f;
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        float value = AsFloat(GetRegister(instruction.operands[0] + c)[lane]);
+                        if (isDistance) {
+                            value -= AsFloat(GetRegister(instruction.operands[1] + c)[lane]);
+                        }
+                        sum += value * value;
+                    }
+                    result[lane] = ToWord(std::sqrt(sum));
+                });
+            } break;
+
+            case kGlslStd450Normalize:
+                ForEachLane([&](uint32_t lane) {
+                    float sum = 0.0f;
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        float value = AsFloat(GetRegister(instruction.operands[0] + c)[lane]);
+                        sum += value * value;
+                    }
+                    float scale = 1.0f / std::sqrt(sum);
+                    for (uint32_t c = 0; c < instruction.count; ++c) {
+                        float value = AsFloat(GetRegister(instruction.operands[0] + c)[lane]);
+                        GetRegister(instruction.result + c)[lane] = ToWord(value * scale);
+                    }
+                });
+                break;
+
+            case kGlslStd450Cross:
+                ForEachLane([&](uint32_t lane) {
+                    std::array<float, 3> a;
+                    std::array<float, 3> b;
+                    for (uint32_t c = 0; c < 3; ++c) {
+                        a[c] = AsFloat(GetRegister(instruction.operands[0] + c)[lane]);
+                        b[c] = AsFloat(GetRegister(instruction.operands[1] + c)[lane]);
+                    }
+                    GetRegister(instruction.result)[lane] = ToWord(a[1] * b[2] - b[1] * a[2]);
+                    GetRegister(instruction.result + 1)[lane] = ToWord(a[2] * b[0] - b[2] * a[0]);
+                    GetRegister(instruction.result + 2)[lane] = ToWord(a[0] * b[1] - b[0] * a[1]);
+                });
+                break;
+
+            default:
+                UNREACHABLE();
+                break;
+        }
+    }
+
+    void ComputeProgram::Executor::ExecuteAtomic(const Instruction& instruction) {
+        const uint32_t* region = GetRegister(instruction.operands[0]);
+        const uint32_t* offset = GetRegister(instruction.operands[0] + 1);
+        const uint32_t* value = GetRegister(instruction.operands[1]);
+        const uint32_t* comparator = GetRegister(instruction.operands[2]);
+        uint32_t* result = GetRegister(instruction.result);
+
+        ForEachLane([&](uint32_t lane) {
+            uint8_t* data = GetMemory(lane, region[lane], offset[lane], sizeof(uint32_t));
+            if (data == nullptr) {
+                if (instruction.op != Op::AtomicStore) {
+                    result[lane] = 0;
+                }
+                return;
+            }
+
+            // Only buffers are shared between the worker threads.
+            std::unique_lock<std::mutex> lock;
+            if (region[lane] >= kFirstBufferRegion && mAtomicMutex != nullptr) {
+                lock = std::unique_lock<std::mutex>(*mAtomicMutex);
+            }
+
+            uint32_t original = LoadWord(data);
+            uint32_t operand = value[lane];
+            uint32_t updated = original;
+            switch (instruction.op) {
+                case Op::AtomicLoad:
+                    break;
+                case Op::AtomicStore:
+                case Op::AtomicExchange:
+                    updated = operand;
+                    break;
+                case Op::AtomicCompareExchange:
+                    if (original == comparator[lane]) {
+                        updated = operand;
+                    }
+                    break;
+                case Op::AtomicIIncrement:
+                    updated = original + 1;
+                    break;
+                case Op::AtomicIDecrement:
+                    updated = original - 1;
+                    break;
+                case Op::AtomicIAdd:
+                    updated = original + operand;
+                    break;
+                case Op::AtomicISub:
+                    updated = original - operand;
+                    break;
+                case Op::AtomicSMin:
+                    updated = ToWord(std::min(AsInt(original), AsInt(operand)));
+                    break;
+                case Op::AtomicUMin:
+                    updated = std::min(original, operand);
+                    break;
+                case Op::AtomicSMax:
+                    updated = ToWord(std::max(AsInt(original), AsInt(operand)));
+                    break;
+                case Op::AtomicUMax:
+                    updated = std::max(original, operand);
+                    break;
+                case Op::AtomicAnd:
+                    updated = original & operand;
+                    break;
+                case Op::AtomicOr:
+                    updated = original | operand;
+                    break;
+                case Op::AtomicXor:
+                    updated = original ^ operand;
+                    break;
+                default:
+                    UNREACHABLE();
+                    break;
+            }
+            StoreWord(data, updated);
+            if (instruction.op != Op::AtomicStore) {
+                result[lane] = original;
+            }
+        });
+    }
+
+    // ComputeProgram
+
+    // static
+    std::unique_ptr<ComputeProgram> ComputeProgram::Create(const std::vector<uint32_t>& spirv,
+                                                           const std::string& entryPoint) {
+        std::unique_ptr<ComputeProgram> program(new ComputeProgram());
+        Compiler compiler(program.get(), spirv, entryPoint);
+        if (!compiler.Compile()) {
+            return nullptr;
+        }
+        return program;
+    }
+
+    ComputeProgram::ComputeProgram() = default;
+
+    ComputeProgram::~ComputeProgram() = default;
+
+    void ComputeProgram::Dispatch(const ComputeBindings& bindings,
+                                  uint32_t x,
+                                  uint32_t y,
+                                  uint32_t z) const {
+        // Dispatches with more invocations than 64-bit counts can hold would never complete, so
+        // they are skipped instead of overflowing the counts.
+        uint64_t groupCount = static_cast<uint64_t>(x) * y;
+        if (groupCount == 0 || z == 0) {
+            return;
+        }
+        if (groupCount > std::numeric_limits<uint64_t>::max() / z) {
+            return;
+        }
+        groupCount *= z;
+        if (groupCount > std::numeric_limits<uint64_t>::max() / mInvocationCount) {
+            return;
+        }
+        uint64_t invocationCount = groupCount * mInvocationCount;
+
+        // Buffers that aren't bound, or are larger than what 32-bit offsets can address, only
+        // expose the part that can be addressed.
+        std::vector<MemoryRegion> bufferRegions;
+        for (const BufferVariable& buffer : mBuffers) {
+            const ComputeBufferBinding& binding = bindings[buffer.group][buffer.binding];
+            uint32_t size = static_cast<uint32_t>(
+                std::min(binding.size, static_cast<uint64_t>(kOutOfBounds - 1)));
+            bufferRegions.push_back({binding.data, binding.data != nullptr ? size : 0});
+        }
+
+        uint64_t workerCount =
+            std::min<uint64_t>(groupCount, invocationCount / kMinInvocationsPerWorker);
+        workerCount = std::min<uint64_t>(workerCount, std::thread::hardware_concurrency());
+        std::array<uint32_t, 3> groupCounts = {{x, y, z}};
+
+        if (workerCount <= 1) {
+            Executor executor(this, bufferRegions, groupCounts, nullptr);
+            for (uint32_t groupZ = 0; groupZ < z; ++groupZ) {
+                for (uint32_t groupY = 0; groupY < y; ++groupY) {
+                    for (uint32_t groupX = 0; groupX < x; ++groupX) {
+                        executor.RunWorkgroup(groupX, groupY, groupZ);
+                    }
+                }
+            }
+            return;
+        }
+
+        std::mutex atomicMutex;
+        std::atomic<uint64_t> nextGroup(0);
+        auto RunWorker = [&]() {
+            Executor executor(this, bufferRegions, groupCounts, &atomicMutex);
+            uint64_t sliceSize = static_cast<uint64_t>(x) * y;
+            for (uint64_t group = nextGroup++; group < groupCount; group = nextGroup++) {
+                executor.RunWorkgroup(static_cast<uint32_t>(group % x),
+                                      static_cast<uint32_t>((group / x) % y),
+                                      static_cast<uint32_t>(group / sliceSize));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (uint64_t i = 1; i < workerCount; ++i) {
+            workers.emplace_back(RunWorker);
+        }
+        RunWorker();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+}}  // namespace dawn_native::null
@@ -0,0 +1,132 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_NULL_COMPUTEPROGRAMNULL_H_
+#define DAWNNATIVE_NULL_COMPUTEPROGRAMNULL_H_
+
+#include "common/Constants.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dawn_native { namespace null {
+
+    // The memory of a buffer binding, as seen by a dispatch.
+    struct ComputeBufferBinding {
+        uint8_t* data = nullptr;
+        uint64_t size = 0;
+    };
+
+    using ComputeBindings =
+        std::array<std::array<ComputeBufferBinding, kMaxBindingsPerGroup>, kMaxBindGroups>;
+
+    // Runs the GLCompute entry point of a SPIR-V module on the CPU.
+    //
+    // The module is lowered once to a flat list of instructions whose operands are offsets in a
+    // register file where composites are flattened to 32-bit words. The invocations of a
+    // workgroup are then interpreted as the lanes of a SIMD machine: each instruction is decoded
+    // once and executed for all the lanes at the same program counter, with the registers stored
+    // lane by lane so that the loops over the lanes vectorize. Lanes that diverge are reconverged
+    // by always running the lanes with the smallest program counter first, and lanes reaching a
+    // barrier wait for all the other lanes of the workgroup. The workgroups of large dispatches
+    // are spread over worker threads.
+    //
+    // Memory accesses are bounds checked against the variable or binding they point into: loads
+    // out of bounds return zero and stores out of bounds are discarded.
+    class ComputeProgram {
+      public:
+        // Returns nullptr if the module uses a feature the interpreter doesn't support, like
+        // textures or types that aren't 32-bit.
+        static std::unique_ptr<ComputeProgram> Create(const std::vector<uint32_t>& spirv,
+                                                      const std::string& entryPoint);
+        ~ComputeProgram();
+
+        // Runs x * y * z workgroups. Dispatches whose number of invocations doesn't fit in 64 bits
+        // are skipped.
+        void Dispatch(const ComputeBindings& bindings, uint32_t x, uint32_t y, uint32_t z) const;
+
+      private:
+        class Compiler;
+        class Executor;
+
+        enum class Op : uint16_t;
+
+        struct Instruction {
+            Op op;
+            // The GLSL.std.450 instruction of ExtInst operations.
+            uint16_t extOp;
+            // The number of components of the result, or of the operands for operations that
+            // reduce them.
+            uint32_t count;
+            uint32_t result;
+            std::array<uint32_t, 4> operands;
+            // The additional operands are stored in mExtraOperands.
+            uint32_t extraBegin;
+            uint32_t extraCount;
+        };
+
+        // A storage or uniform buffer variable, accessed through the memory region at index
+        // kFirstBufferRegion plus its index.
+        struct BufferVariable {
+            uint32_t group;
+            uint32_t binding;
+        };
+
+        // A built-in input variable, stored in the private memory of each invocation.
+        struct BuiltInVariable {
+            uint32_t builtIn;
+            uint32_t offset;
+        };
+
+        struct RegisterValue {
+            uint32_t reg;
+            uint32_t value;
+        };
+
+        struct MemoryValue {
+            uint32_t offset;
+            uint32_t value;
+        };
+
+        static constexpr uint32_t kPrivateRegion = 0;
+        static constexpr uint32_t kWorkgroupRegion = 1;
+        static constexpr uint32_t kFirstBufferRegion = 2;
+
+        ComputeProgram();
+
+        std::vector<Instruction> mInstructions;
+        std::vector<uint32_t> mExtraOperands;
+        uint32_t mEntryPoint = 0;
+        uint32_t mFunctionCount = 0;
+
+        uint32_t mRegisterCount = 0;
+        // Constants, including the pointers to the variables of the module, are written once in
+        // the registers of each worker.
+        std::vector<RegisterValue> mConstants;
+
+        std::array<uint32_t, 3> mWorkgroupSize = {{1, 1, 1}};
+        uint32_t mInvocationCount = 1;
+        uint32_t mPrivateMemorySize = 0;
+        uint32_t mWorkgroupMemorySize = 0;
+        std::vector<MemoryValue> mPrivateInitializers;
+        std::vector<BuiltInVariable> mBuiltIns;
+        std::vector<BufferVariable> mBuffers;
+    };
+
+}}  // namespace dawn_native::null
+
+#endif  // DAWNNATIVE_NULL_COMPUTEPROGRAMNULL_H_
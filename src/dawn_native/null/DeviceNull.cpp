@@ -14,6 +14,7 @@
 
 #include "dawn_native/null/DeviceNull.h"
 
+#include "common/BitSetIterator.h"
 #include "dawn_native/BackendConnection.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/DynamicUploader.h"
@@ -21,6 +22,8 @@
 
 #include <spirv_cross.hpp>
 
+#include <algorithm>
+
 namespace dawn_native { namespace null {
 
     // Implementation of pre-Device objects: the null adapter, null backend connection and Connect()
@@ -67,6 +70,10 @@ namespace dawn_native { namespace null {
             destination->CopyFromStaging(staging, sourceOffset, destinationOffset, size);
         }
 
+        uint64_t GetByteCount() const override {
+            return size;
+        }
+
         StagingBufferBase* staging;
         Ref<Buffer> destination;
         uint64_t sourceOffset;
@@ -74,26 +81,64 @@ namespace dawn_native { namespace null {
         uint64_t size;
     };
 
+    struct CopyFromStagingToTextureOperation : PendingOperation {
+        void Execute() override;
+
+        uint64_t GetByteCount() const override;
+
+        StagingBufferBase* staging;
+        TextureDataLayout source;
+        TextureCopy destination;
+        Extent3D copySize;
+    };
+
+    struct FreeTextureStorageOperation : PendingOperation {
+        void Execute() override {
+            texture->FreeStorage();
+        }
+
+        Ref<Texture> texture;
+    };
+
     // Device
 
     Device::Device(Adapter* adapter, const DeviceDescriptor* descriptor)
-        : DeviceBase(adapter, descriptor) {
+        : DeviceBase(adapter, descriptor), mCompletedSerial(0) {
         // Apply toggle overrides if necessary for test
         if (descriptor != nullptr) {
             ApplyToggleOverrides(descriptor);
         }
+
+        if (IsToggleEnabled(Toggle::UseProgressThread)) {
+            mProgressThread = std::thread([this]() { ProgressThreadMain(); });
+        }
     }
 
     Device::~Device() {
-        mDynamicUploader = nullptr;
+        if (mProgressThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mSerialMutex);
+                mStopProgressThread = true;
+            }
+            mSerialCondition.notify_all();
+            mProgressThread.join();
+        }
 
+        // The operations are cleared first since the objects they reference can be deferred for
+        // deletion when they are released.
         mPendingOperations.clear();
+        mInFlightOperations.Clear();
+        mSerialCompletionTimes.Clear();
+
+        ClearDeduplicationCaches();
+        DeleteDeferredObjects();
+        mDynamicUploader = nullptr;
         ASSERT(mMemoryUsage == 0);
     }
 
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
-        return new BindGroup(this, descriptor);
+        return AllocateBindGroup<BindGroup>(this, descriptor);
     }
     ResultOrError<BindGroupLayoutBase*> Device::CreateBindGroupLayoutImpl(
         const BindGroupLayoutDescriptor* descriptor) {
@@ -105,7 +150,7 @@ namespace dawn_native { namespace null {
     }
     CommandBufferBase* Device::CreateCommandBuffer(CommandEncoderBase* encoder,
                                                    const CommandBufferDescriptor* descriptor) {
-        return new CommandBuffer(encoder, descriptor);
+        return GetCommandBufferAllocator()->New<CommandBuffer>(encoder, descriptor);
     }
     ResultOrError<ComputePipelineBase*> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -139,12 +184,15 @@ namespace dawn_native { namespace null {
         return new SwapChain(this, descriptor);
     }
     ResultOrError<TextureBase*> Device::CreateTextureImpl(const TextureDescriptor* descriptor) {
-        return new Texture(this, descriptor, TextureBase::TextureState::OwnedInternal);
+        std::unique_ptr<Texture> texture =
+            std::make_unique<Texture>(this, descriptor, TextureBase::TextureState::OwnedInternal);
+        DAWN_TRY(texture->Initialize());
+        return texture.release();
     }
     ResultOrError<TextureViewBase*> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return new TextureView(texture, descriptor);
+        return GetTextureViewAllocator()->New<TextureView>(texture, descriptor);
     }
 
     ResultOrError<std::unique_ptr<StagingBufferBase>> Device::CreateStagingBuffer(size_t size) {
@@ -170,6 +218,21 @@ namespace dawn_native { namespace null {
         return {};
     }
 
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* staging,
+                                                const TextureDataLayout& source,
+                                                TextureCopy* destination,
+                                                const Extent3D& copySize) {
+        auto operation = std::make_unique<CopyFromStagingToTextureOperation>();
+        operation->staging = staging;
+        operation->source = source;
+        operation->destination = *destination;
+        operation->copySize = copySize;
+
+        AddPendingOperation(std::move(operation));
+
+        return {};
+    }
+
     MaybeError Device::IncrementMemoryUsage(size_t bytes) {
         static_assert(kMaxMemoryUsage <= std::numeric_limits<size_t>::max() / 2, "");
         if (bytes > kMaxMemoryUsage || mMemoryUsage + bytes > kMaxMemoryUsage) {
@@ -198,12 +261,49 @@ namespace dawn_native { namespace null {
 
     void Device::TickImpl() {
         SubmitPendingOperations();
+
+        // The completed serial is only read once since the progress thread can update it, and
+        // the staging buffers must stay alive until the operations using them are executed.
+        Serial completedSerial = GetCompletedCommandSerial();
+        if (mProgressThread.joinable()) {
+            ExecuteCompletedOperations(completedSerial);
+        }
+        mDynamicUploader->Tick(completedSerial);
     }
 
     void Device::AddPendingOperation(std::unique_ptr<PendingOperation> operation) {
         mPendingOperations.emplace_back(std::move(operation));
     }
     void Device::SubmitPendingOperations() {
+        if (mProgressThread.joinable()) {
+            uint64_t byteCount = 0;
+            for (const auto& operation : mPendingOperations) {
+                byteCount += operation->GetByteCount();
+            }
+
+            // The simulated GPU starts executing the serial once it finished the previous ones
+            // and the latency elapsed.
+            std::chrono::nanoseconds executionTime(mGpuTimelineModel.costPerSubmitNs);
+            if (mGpuTimelineModel.bytesPerSecond != 0) {
+                executionTime += std::chrono::nanoseconds(static_cast<uint64_t>(
+                    static_cast<double>(byteCount) * 1e9 / mGpuTimelineModel.bytesPerSecond));
+            }
+            std::chrono::steady_clock::time_point startTime =
+                std::chrono::steady_clock::now() +
+                std::chrono::nanoseconds(mGpuTimelineModel.latencyNs);
+            mGpuIdleTime = std::max(startTime, mGpuIdleTime) + executionTime;
+
+            std::lock_guard<std::mutex> lock(mSerialMutex);
+            mLastSubmittedSerial++;
+            if (!mPendingOperations.empty()) {
+                mInFlightOperations.Enqueue(std::move(mPendingOperations), mLastSubmittedSerial);
+                mPendingOperations.clear();
+            }
+            mSerialCompletionTimes.Enqueue(mGpuIdleTime, mLastSubmittedSerial);
+            mSerialCondition.notify_all();
+            return;
+        }
+
         for (auto& operation : mPendingOperations) {
             operation->Execute();
         }
@@ -213,15 +313,74 @@ namespace dawn_native { namespace null {
         mLastSubmittedSerial++;
     }
 
+    void Device::ExecuteCompletedOperations(Serial completedSerial) {
+        // Take the operations out of the queue first since they can call callbacks that submit
+        // more operations.
+        std::vector<std::unique_ptr<PendingOperation>> completedOperations;
+        for (auto& operation : mInFlightOperations.IterateUpTo(completedSerial)) {
+            completedOperations.push_back(std::move(operation));
+        }
+        mInFlightOperations.ClearUpTo(completedSerial);
+
+        for (auto& operation : completedOperations) {
+            operation->Execute();
+        }
+    }
+
+    bool Device::WaitForSerialImpl(Serial serial,
+                                   std::chrono::steady_clock::time_point deadline) {
+        if (!mProgressThread.joinable()) {
+            return DeviceBase::WaitForSerialImpl(serial, deadline);
+        }
+
+        std::unique_lock<std::mutex> lock(mSerialMutex);
+        return mSerialCondition.wait_until(lock, deadline,
+                                           [this, serial]() { return mCompletedSerial >= serial; });
+    }
+
+    void Device::ProgressThreadMain() {
+        std::unique_lock<std::mutex> lock(mSerialMutex);
+        while (true) {
+            mSerialCondition.wait(
+                lock, [this]() { return mStopProgressThread || !mSerialCompletionTimes.Empty(); });
+            if (mStopProgressThread) {
+                return;
+            }
+
+            // The serials complete in order, so only the oldest one needs to be waited on. New
+            // submits can't make it complete earlier.
+            Serial serial = mSerialCompletionTimes.FirstSerial();
+            std::chrono::steady_clock::time_point completionTime =
+                *mSerialCompletionTimes.IterateAll().begin();
+            if (mSerialCondition.wait_until(lock, completionTime,
+                                            [this]() { return mStopProgressThread; })) {
+                return;
+            }
+
+            mSerialCompletionTimes.ClearUpTo(serial);
+            mCompletedSerial = serial;
+            mSerialCondition.notify_all();
+        }
+    }
+
+    void Device::SetGpuTimelineModel(const GpuTimelineModel& model) {
+        mGpuTimelineModel = model;
+    }
+
     // Buffer
 
     struct BufferMapOperation : PendingOperation {
         virtual void Execute() {
-            buffer->MapOperationCompleted(serial, ptr, isWrite);
+            buffer->MapOperationCompleted(serial, ptr, size, isWrite);
+        }
+
+        uint64_t GetByteCount() const override {
+            return size;
         }
 
         Ref<Buffer> buffer;
         void* ptr;
+        uint64_t size;
         uint32_t serial;
         bool isWrite;
     };
@@ -236,6 +395,10 @@ namespace dawn_native { namespace null {
         ToBackend(GetDevice())->DecrementMemoryUsage(GetSize());
     }
 
+    uint8_t* Buffer::GetBackingData() {
+        return mBackingData.get();
+    }
+
     bool Buffer::IsMapWritable() const {
         // Only return true for mappable buffers so we can test cases that need / don't need a
         // staging buffer.
@@ -247,11 +410,11 @@ namespace dawn_native { namespace null {
         return {};
     }
 
-    void Buffer::MapOperationCompleted(uint32_t serial, void* ptr, bool isWrite) {
+    void Buffer::MapOperationCompleted(uint32_t serial, void* ptr, uint64_t size, bool isWrite) {
         if (isWrite) {
-            CallMapWriteCallback(serial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, ptr, GetSize());
+            CallMapWriteCallback(serial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, ptr, size);
         } else {
-            CallMapReadCallback(serial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, ptr, GetSize());
+            CallMapReadCallback(serial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, ptr, size);
         }
     }
 
@@ -263,29 +426,23 @@ namespace dawn_native { namespace null {
         memcpy(mBackingData.get() + destinationOffset, ptr + sourceOffset, size);
     }
 
-    MaybeError Buffer::SetSubDataImpl(uint32_t start, uint32_t count, const void* data) {
-        ASSERT(start + count <= GetSize());
-        ASSERT(mBackingData);
-        memcpy(mBackingData.get() + start, data, count);
-        return {};
-    }
-
-    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial) {
-        MapAsyncImplCommon(serial, false);
+    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
+        MapAsyncImplCommon(serial, offset, size, false);
         return {};
     }
 
-    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial) {
-        MapAsyncImplCommon(serial, true);
+    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
+        MapAsyncImplCommon(serial, offset, size, true);
         return {};
     }
 
-    void Buffer::MapAsyncImplCommon(uint32_t serial, bool isWrite) {
+    void Buffer::MapAsyncImplCommon(uint32_t serial, uint64_t offset, uint64_t size, bool isWrite) {
         ASSERT(mBackingData);
 
         auto operation = std::make_unique<BufferMapOperation>();
         operation->buffer = this;
-        operation->ptr = mBackingData.get();
+        operation->ptr = mBackingData.get() + offset;
+        operation->size = size;
         operation->serial = serial;
         operation->isWrite = isWrite;
 
@@ -300,6 +457,129 @@ namespace dawn_native { namespace null {
 
     // CommandBuffer
 
+    namespace {
+
+        // Copies |rowCount| rows of |rowSize| bytes. Rows that are tightly packed in both the
+        // source and the destination are copied at once. memmove is used since the validation
+        // doesn't prevent copies within a buffer or a subresource.
+        void CopyRows(uint8_t* destination,
+                      uint64_t destinationRowPitch,
+                      const uint8_t* source,
+                      uint64_t sourceRowPitch,
+                      uint64_t rowSize,
+                      uint32_t rowCount) {
+            if (rowSize == sourceRowPitch && rowSize == destinationRowPitch) {
+                memmove(destination, source, rowSize * rowCount);
+                return;
+            }
+            for (uint32_t row = 0; row < rowCount; ++row) {
+                memmove(destination, source, rowSize);
+                destination += destinationRowPitch;
+                source += sourceRowPitch;
+            }
+        }
+
+        // The location of a copy in a texture subresource, in bytes.
+        struct TextureCopyLocation {
+            uint8_t* data;
+            uint32_t rowPitch;
+        };
+
+        TextureCopyLocation GetTextureCopyLocation(TextureCopy& copy, uint32_t layerOffset) {
+            Texture* texture = ToBackend(copy.texture.Get());
+            const Format& format = texture->GetFormat();
+
+            TextureCopyLocation location;
+            location.rowPitch = texture->GetRowPitch(copy.mipLevel);
+            location.data = texture->GetSubresourceData(copy.mipLevel,
+                                                        copy.arrayLayer + layerOffset) +
+                            (copy.origin.y / format.blockHeight) * location.rowPitch +
+                            (copy.origin.x / format.blockWidth) * format.blockByteSize;
+            return location;
+        }
+
+        // The storage and uniform buffers bound for a dispatch. The dynamic offsets of a group
+        // apply to its dynamic bindings in increasing binding order.
+        ComputeBindings GetComputeBindings(
+            const PipelineLayoutBase* layout,
+            const std::array<BindGroupBase*, kMaxBindGroups>& bindGroups,
+            const std::array<std::array<uint64_t, kMaxBindingsPerGroup>, kMaxBindGroups>&
+                dynamicOffsets) {
+            ComputeBindings bindings = {};
+            for (uint32_t group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
+                BindGroupBase* bindGroup = bindGroups[group];
+                const BindGroupLayoutBase::LayoutBindingInfo& info =
+                    bindGroup->GetLayout()->GetBindingInfo();
+
+                uint32_t dynamicIndex = 0;
+                for (uint32_t binding : IterateBitSet(info.mask)) {
+                    switch (info.types[binding]) {
+                        case dawn::BindingType::UniformBuffer:
+                        case dawn::BindingType::StorageBuffer:
+                        case dawn::BindingType::ReadonlyStorageBuffer: {
+                            BufferBinding bufferBinding =
+                                bindGroup->GetBindingAsBufferBinding(binding);
+                            uint64_t offset = bufferBinding.offset;
+                            if (info.dynamic[binding]) {
+                                offset += dynamicOffsets[group][dynamicIndex++];
+                            }
+                            bindings[group][binding].data =
+                                ToBackend(bufferBinding.buffer)->GetBackingData() + offset;
+                            bindings[group][binding].size = bufferBinding.size;
+                        } break;
+
+                        default:
+                            break;
+                    }
+                }
+            }
+            return bindings;
+        }
+
+        uint8_t* GetBufferCopyData(BufferCopy& copy,
+                                   const Format& format,
+                                   uint32_t layerOffset) {
+            uint64_t imageSize =
+                static_cast<uint64_t>(copy.rowPitch) * (copy.imageHeight / format.blockHeight);
+            return ToBackend(copy.buffer.Get())->GetBackingData() + copy.offset +
+                   layerOffset * imageSize;
+        }
+
+        uint64_t GetTextureCopyByteCount(const Extent3D& copySize, const Format& format) {
+            return static_cast<uint64_t>(copySize.width / format.blockWidth) *
+                   (copySize.height / format.blockHeight) * copySize.depth * format.blockByteSize;
+        }
+
+    }  // anonymous namespace
+
+    void CopyFromStagingToTextureOperation::Execute() {
+        const Format& format = destination.texture->GetFormat();
+        uint64_t rowSize = (copySize.width / format.blockWidth) * format.blockByteSize;
+        uint32_t rowCount = copySize.height / format.blockHeight;
+
+        TextureCopyLocation location = GetTextureCopyLocation(destination, 0);
+        CopyRows(location.data, location.rowPitch,
+                 static_cast<uint8_t*>(staging->GetMappedPointer()) + source.offset,
+                 source.rowPitch, rowSize, rowCount);
+    }
+
+    uint64_t CopyFromStagingToTextureOperation::GetByteCount() const {
+        return GetTextureCopyByteCount(copySize, destination.texture->GetFormat());
+    }
+
+    struct ExecuteCommandBufferOperation : PendingOperation {
+        virtual void Execute() {
+            commandBuffer->Execute();
+        }
+
+        uint64_t GetByteCount() const override {
+            return byteCount;
+        }
+
+        Ref<CommandBuffer> commandBuffer;
+        uint64_t byteCount;
+    };
+
     CommandBuffer::CommandBuffer(CommandEncoderBase* encoder,
                                  const CommandBufferDescriptor* descriptor)
         : CommandBufferBase(encoder, descriptor), mCommands(encoder->AcquireCommands()) {
@@ -309,6 +589,266 @@ namespace dawn_native { namespace null {
         FreeCommands(&mCommands);
     }
 
+    void CommandBuffer::Execute() {
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
+                    memmove(ToBackend(copy->destination)->GetBackingData() +
+                               copy->destinationOffset,
+                           ToBackend(copy->source)->GetBackingData() + copy->sourceOffset,
+                           copy->size);
+                } break;
+
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
+                    const Format& format = copy->destination.texture->GetFormat();
+                    uint64_t rowSize =
+                        (copy->copySize.width / format.blockWidth) * format.blockByteSize;
+                    uint32_t rowCount = copy->copySize.height / format.blockHeight;
+
+                    for (uint32_t layer = 0; layer < copy->copySize.depth; ++layer) {
+                        TextureCopyLocation destination =
+                            GetTextureCopyLocation(copy->destination, layer);
+                        CopyRows(destination.data, destination.rowPitch,
+                                 GetBufferCopyData(copy->source, format, layer),
+                                 copy->source.rowPitch, rowSize, rowCount);
+                    }
+                } break;
+
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* copy = mCommands.NextCommand<CopyTextureToBufferCmd>();
+                    const Format& format = copy->source.texture->GetFormat();
+                    uint64_t rowSize =
+                        (copy->copySize.width / format.blockWidth) * format.blockByteSize;
+                    uint32_t rowCount = copy->copySize.height / format.blockHeight;
+
+                    for (uint32_t layer = 0; layer < copy->copySize.depth; ++layer) {
+                        TextureCopyLocation source = GetTextureCopyLocation(copy->source, layer);
+                        CopyRows(GetBufferCopyData(copy->destination, format, layer),
+                                 copy->destination.rowPitch, source.data, source.rowPitch,
+                                 rowSize, rowCount);
+                    }
+                } break;
+
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* copy =
+                        mCommands.NextCommand<CopyTextureToTextureCmd>();
+                    const Format& format = copy->source.texture->GetFormat();
+                    uint64_t rowSize =
+                        (copy->copySize.width / format.blockWidth) * format.blockByteSize;
+                    uint32_t rowCount = copy->copySize.height / format.blockHeight;
+
+                    for (uint32_t layer = 0; layer < copy->copySize.depth; ++layer) {
+                        TextureCopyLocation source = GetTextureCopyLocation(copy->source, layer);
+                        TextureCopyLocation destination =
+                            GetTextureCopyLocation(copy->destination, layer);
+                        CopyRows(destination.data, destination.rowPitch, source.data,
+                                 source.rowPitch, rowSize, rowCount);
+                    }
+                } break;
+
+                case Command::BeginComputePass: {
+                    mCommands.NextCommand<BeginComputePassCmd>();
+                    ExecuteComputePass();
+                } break;
+
+                default:
+                    SkipCommand(&mCommands, type);
+                    break;
+            }
+        }
+    }
+
+    uint64_t CommandBuffer::GetCopiedByteCount() {
+        uint64_t byteCount = 0;
+
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::CopyBufferToBuffer: {
+                    CopyBufferToBufferCmd* copy = mCommands.NextCommand<CopyBufferToBufferCmd>();
+                    byteCount += copy->size;
+                } break;
+
+                case Command::CopyBufferToTexture: {
+                    CopyBufferToTextureCmd* copy = mCommands.NextCommand<CopyBufferToTextureCmd>();
+                    byteCount += GetTextureCopyByteCount(
+                        copy->copySize, copy->destination.texture->GetFormat());
+                } break;
+
+                case Command::CopyTextureToBuffer: {
+                    CopyTextureToBufferCmd* copy = mCommands.NextCommand<CopyTextureToBufferCmd>();
+                    byteCount +=
+                        GetTextureCopyByteCount(copy->copySize, copy->source.texture->GetFormat());
+                } break;
+
+                case Command::CopyTextureToTexture: {
+                    CopyTextureToTextureCmd* copy =
+                        mCommands.NextCommand<CopyTextureToTextureCmd>();
+                    byteCount +=
+                        GetTextureCopyByteCount(copy->copySize, copy->source.texture->GetFormat());
+                } break;
+
+                default:
+                    SkipCommand(&mCommands, type);
+                    break;
+            }
+        }
+
+        // The iteration reached the end of the commands so the iterator was reset for Execute.
+        return byteCount;
+    }
+
+    void CommandBuffer::ExecuteComputePass() {
+        ComputePipeline* lastPipeline = nullptr;
+        std::array<BindGroupBase*, kMaxBindGroups> bindGroups = {};
+        std::array<std::array<uint64_t, kMaxBindingsPerGroup>, kMaxBindGroups> dynamicOffsets = {};
+
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::EndComputePass: {
+                    mCommands.NextCommand<EndComputePassCmd>();
+                    return;
+                } break;
+
+                case Command::Dispatch: {
+                    DispatchCmd* dispatch = mCommands.NextCommand<DispatchCmd>();
+                    const ComputeProgram* program = lastPipeline->GetProgram();
+                    if (program != nullptr) {
+                        program->Dispatch(
+                            GetComputeBindings(lastPipeline->GetLayout(), bindGroups,
+                                               dynamicOffsets),
+                            dispatch->x, dispatch->y, dispatch->z);
+                    }
+                } break;
+
+                case Command::DispatchIndirect: {
+                    DispatchIndirectCmd* dispatch = mCommands.NextCommand<DispatchIndirectCmd>();
+                    const ComputeProgram* program = lastPipeline->GetProgram();
+                    if (program != nullptr) {
+                        uint32_t groupCounts[3];
+                        memcpy(groupCounts,
+                               ToBackend(dispatch->indirectBuffer)->GetBackingData() +
+                                   dispatch->indirectOffset,
+                               sizeof(groupCounts));
+                        program->Dispatch(
+                            GetComputeBindings(lastPipeline->GetLayout(), bindGroups,
+                                               dynamicOffsets),
+                            groupCounts[0], groupCounts[1], groupCounts[2]);
+                    }
+                } break;
+
+                case Command::SetComputePipeline: {
+                    SetComputePipelineCmd* cmd = mCommands.NextCommand<SetComputePipelineCmd>();
+                    lastPipeline = ToBackend(cmd->pipeline).Get();
+                } break;
+
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
+                    bindGroups[cmd->index] = cmd->group.Get();
+                    if (cmd->dynamicOffsetCount > 0) {
+                        uint64_t* offsets = mCommands.NextData<uint64_t>(cmd->dynamicOffsetCount);
+                        std::copy(offsets, offsets + cmd->dynamicOffsetCount,
+                                  dynamicOffsets[cmd->index].begin());
+                    }
+                } break;
+
+                default:
+                    SkipCommand(&mCommands, type);
+                    break;
+            }
+        }
+
+        // EndComputePass should have been called
+        UNREACHABLE();
+    }
+
+    // ComputePipeline
+
+    ComputePipeline::ComputePipeline(Device* device, const ComputePipelineDescriptor* descriptor)
+        : ComputePipelineBase(device, descriptor),
+          mProgram(ComputeProgram::Create(descriptor->computeStage.module->GetSpirv(),
+                                          descriptor->computeStage.entryPoint)) {
+    }
+
+    ComputePipeline::~ComputePipeline() {
+    }
+
+    const ComputeProgram* ComputePipeline::GetProgram() const {
+        return mProgram.get();
+    }
+
+    // Texture
+
+    Texture::Texture(Device* device, const TextureDescriptor* descriptor, TextureState state)
+        : TextureBase(device, descriptor, state) {
+    }
+
+    Texture::~Texture() {
+        // The operations using the texture hold a reference to it so none of them is left.
+        FreeStorage();
+        DestroyInternal();
+    }
+
+    MaybeError Texture::Initialize() {
+        if (GetSampleCount() > 1) {
+            return {};
+        }
+
+        const Format& format = GetFormat();
+        mSubresourceOffsets.resize(GetNumMipLevels() * GetArrayLayers());
+        uint64_t offset = 0;
+        for (uint32_t layer = 0; layer < GetArrayLayers(); ++layer) {
+            for (uint32_t level = 0; level < GetNumMipLevels(); ++level) {
+                mSubresourceOffsets[GetSubresourceIndex(level, layer)] = offset;
+                uint32_t blockRowCount = GetMipLevelPhysicalSize(level).height / format.blockHeight;
+                offset += static_cast<uint64_t>(GetRowPitch(level)) * blockRowCount;
+            }
+        }
+
+        if (offset > std::numeric_limits<size_t>::max()) {
+            return DAWN_DEVICE_LOST_ERROR("Out of memory.");
+        }
+        DAWN_TRY(ToBackend(GetDevice())->IncrementMemoryUsage(static_cast<size_t>(offset)));
+        mStorageSize = offset;
+        // The storage starts zeroed, which is the content of uninitialized textures.
+        mStorage = std::make_unique<uint8_t[]>(static_cast<size_t>(mStorageSize));
+        return {};
+    }
+
+    uint8_t* Texture::GetSubresourceData(uint32_t mipLevel, uint32_t arrayLayer) {
+        ASSERT(mStorage != nullptr);
+        return mStorage.get() + mSubresourceOffsets[GetSubresourceIndex(mipLevel, arrayLayer)];
+    }
+
+    uint32_t Texture::GetRowPitch(uint32_t mipLevel) const {
+        const Format& format = GetFormat();
+        return GetMipLevelPhysicalSize(mipLevel).width / format.blockWidth * format.blockByteSize;
+    }
+
+    void Texture::DestroyImpl() {
+        if (mStorage == nullptr) {
+            return;
+        }
+
+        // The operations submitted before the texture is destroyed can still copy to or from it
+        // when they are executed by the progress thread, so the storage is freed by an operation
+        // of the next serial.
+        auto operation = std::make_unique<FreeTextureStorageOperation>();
+        operation->texture = this;
+        ToBackend(GetDevice())->AddPendingOperation(std::move(operation));
+    }
+
+    void Texture::FreeStorage() {
+        if (mStorage != nullptr) {
+            mStorage = nullptr;
+            ToBackend(GetDevice())->DecrementMemoryUsage(static_cast<size_t>(mStorageSize));
+        }
+    }
+
     // Queue
 
     Queue::Queue(Device* device) : QueueBase(device) {
@@ -317,8 +857,18 @@ namespace dawn_native { namespace null {
     Queue::~Queue() {
     }
 
-    void Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
-        ToBackend(GetDevice())->SubmitPendingOperations();
+    void Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
+        Device* device = ToBackend(GetDevice());
+
+        // The command buffers are executed with the other operations of the submit, after the
+        // operations that were added before it like buffer uploads.
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            auto operation = std::make_unique<ExecuteCommandBufferOperation>();
+            operation->commandBuffer = ToBackend(commands[i]);
+            operation->byteCount = operation->commandBuffer->GetCopiedByteCount();
+            device->AddPendingOperation(std::move(operation));
+        }
+        device->SubmitPendingOperations();
     }
 
     // SwapChain
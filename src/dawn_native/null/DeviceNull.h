@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_NULL_DEVICENULL_H_
 #define DAWNNATIVE_NULL_DEVICENULL_H_
 
+#include "common/SerialQueue.h"
 #include "dawn_native/Adapter.h"
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
@@ -23,6 +24,7 @@
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/ComputePipeline.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/NullBackend.h"
 #include "dawn_native/PipelineLayout.h"
 #include "dawn_native/Queue.h"
 #include "dawn_native/RenderPipeline.h"
@@ -34,6 +36,13 @@
 #include "dawn_native/Texture.h"
 #include "dawn_native/ToBackend.h"
 #include "dawn_native/dawn_platform.h"
+#include "dawn_native/null/ComputeProgramNull.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace dawn_native { namespace null {
 
@@ -42,7 +51,7 @@ namespace dawn_native { namespace null {
     using BindGroupLayout = BindGroupLayoutBase;
     class Buffer;
     class CommandBuffer;
-    using ComputePipeline = ComputePipelineBase;
+    class ComputePipeline;
     class Device;
     using PipelineLayout = PipelineLayoutBase;
     class Queue;
@@ -50,7 +59,7 @@ namespace dawn_native { namespace null {
     using Sampler = SamplerBase;
     using ShaderModule = ShaderModuleBase;
     class SwapChain;
-    using Texture = TextureBase;
+    class Texture;
     using TextureView = TextureViewBase;
 
     struct NullBackendTraits {
@@ -79,6 +88,11 @@ namespace dawn_native { namespace null {
     struct PendingOperation {
         virtual ~PendingOperation() = default;
         virtual void Execute() = 0;
+
+        // The number of bytes the operation transfers, used by the GPU timeline model.
+        virtual uint64_t GetByteCount() const {
+            return 0;
+        }
     };
 
     class Device : public DeviceBase {
@@ -103,10 +117,16 @@ namespace dawn_native { namespace null {
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
+        MaybeError CopyFromStagingToTexture(StagingBufferBase* staging,
+                                            const TextureDataLayout& source,
+                                            TextureCopy* destination,
+                                            const Extent3D& copySize) override;
 
         MaybeError IncrementMemoryUsage(size_t bytes);
         void DecrementMemoryUsage(size_t bytes);
 
+        void SetGpuTimelineModel(const GpuTimelineModel& model);
+
       private:
         ResultOrError<BindGroupBase*> CreateBindGroupImpl(
             const BindGroupDescriptor* descriptor) override;
@@ -129,10 +149,30 @@ namespace dawn_native { namespace null {
         ResultOrError<TextureViewBase*> CreateTextureViewImpl(
             TextureBase* texture,
             const TextureViewDescriptor* descriptor) override;
+        bool WaitForSerialImpl(Serial serial,
+                               std::chrono::steady_clock::time_point deadline) override;
+
+        void ExecuteCompletedOperations(Serial completedSerial);
+        void ProgressThreadMain();
 
-        Serial mCompletedSerial = 0;
+        // With the use_progress_thread toggle, the progress thread acts as the GPU and completes
+        // the submitted serials at the times computed from mGpuTimelineModel. The pending
+        // operations are then executed in TickImpl once their serial completed, so that the
+        // callbacks are called on the thread ticking the device.
+        std::atomic<Serial> mCompletedSerial;
         Serial mLastSubmittedSerial = 0;
         std::vector<std::unique_ptr<PendingOperation>> mPendingOperations;
+        SerialQueue<std::unique_ptr<PendingOperation>> mInFlightOperations;
+
+        GpuTimelineModel mGpuTimelineModel;
+        // The time at which the simulated GPU finishes executing the last submitted serial.
+        std::chrono::steady_clock::time_point mGpuIdleTime;
+        SerialQueue<std::chrono::steady_clock::time_point> mSerialCompletionTimes;
+
+        std::thread mProgressThread;
+        std::mutex mSerialMutex;
+        std::condition_variable mSerialCondition;
+        bool mStopProgressThread = false;
 
         static constexpr size_t kMaxMemoryUsage = 256 * 1024 * 1024;
         size_t mMemoryUsage = 0;
@@ -155,7 +195,9 @@ namespace dawn_native { namespace null {
         Buffer(Device* device, const BufferDescriptor* descriptor);
         ~Buffer();
 
-        void MapOperationCompleted(uint32_t serial, void* ptr, bool isWrite);
+        uint8_t* GetBackingData();
+
+        void MapOperationCompleted(uint32_t serial, void* ptr, uint64_t size, bool isWrite);
         void CopyFromStaging(StagingBufferBase* staging,
                              uint64_t sourceOffset,
                              uint64_t destinationOffset,
@@ -163,15 +205,14 @@ namespace dawn_native { namespace null {
 
       private:
         // Dawn API
-        MaybeError SetSubDataImpl(uint32_t start, uint32_t count, const void* data) override;
-        MaybeError MapReadAsyncImpl(uint32_t serial) override;
-        MaybeError MapWriteAsyncImpl(uint32_t serial) override;
+        MaybeError MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
+        MaybeError MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
         void UnmapImpl() override;
         void DestroyImpl() override;
 
         bool IsMapWritable() const override;
         MaybeError MapAtCreationImpl(uint8_t** mappedPointer) override;
-        void MapAsyncImplCommon(uint32_t serial, bool isWrite);
+        void MapAsyncImplCommon(uint32_t serial, uint64_t offset, uint64_t size, bool isWrite);
 
         std::unique_ptr<uint8_t[]> mBackingData;
     };
@@ -181,10 +222,57 @@ namespace dawn_native { namespace null {
         CommandBuffer(CommandEncoderBase* encoder, const CommandBufferDescriptor* descriptor);
         ~CommandBuffer();
 
+        // Executes the copy and compute commands on the CPU. The other commands are ignored.
+        void Execute();
+
+        // Returns the number of bytes written by the copy commands.
+        uint64_t GetCopiedByteCount();
+
       private:
+        void ExecuteComputePass();
+
         CommandIterator mCommands;
     };
 
+    class ComputePipeline : public ComputePipelineBase {
+      public:
+        ComputePipeline(Device* device, const ComputePipelineDescriptor* descriptor);
+        ~ComputePipeline();
+
+        // Returns nullptr if the shader uses features the null backend can't execute, in which
+        // case dispatches are skipped.
+        const ComputeProgram* GetProgram() const;
+
+      private:
+        std::unique_ptr<ComputeProgram> mProgram;
+    };
+
+    class Texture : public TextureBase {
+      public:
+        Texture(Device* device, const TextureDescriptor* descriptor, TextureState state);
+        ~Texture();
+
+        // Allocates the storage of the texture. Multisampled textures can't be copied so they
+        // don't have storage.
+        MaybeError Initialize();
+
+        // The subresources are stored one after the other and the rows of texel blocks of each
+        // subresource are tightly packed.
+        uint8_t* GetSubresourceData(uint32_t mipLevel, uint32_t arrayLayer);
+        uint32_t GetRowPitch(uint32_t mipLevel) const;
+
+        // Frees the storage once no operation can use it anymore.
+        void FreeStorage();
+
+      private:
+        void DestroyImpl() override;
+
+        std::unique_ptr<uint8_t[]> mStorage;
+        uint64_t mStorageSize = 0;
+        // The offsets of the subresources in the storage, indexed by GetSubresourceIndex.
+        std::vector<uint64_t> mSubresourceOffsets;
+    };
+
     class Queue : public QueueBase {
       public:
         Queue(Device* device);
@@ -29,4 +29,9 @@ namespace dawn_native { namespace null {
         return impl;
     }
 
+    void SetGpuTimelineModel(DawnDevice device, const GpuTimelineModel& model) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        backendDevice->SetGpuTimelineModel(model);
+    }
+
 }}  // namespace dawn_native::null
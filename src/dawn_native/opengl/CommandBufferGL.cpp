@@ -391,14 +391,22 @@ namespace dawn_native { namespace opengl {
         auto TransitionForPass = [](const PassResourceUsage& usages) {
             for (size_t i = 0; i < usages.textures.size(); i++) {
                 Texture* texture = ToBackend(usages.textures[i]);
-                // We count the lazy clears for non output attachment textures and depth stencil
-                // textures in order to match the backdoor lazy clear counts in Vulkan and D3D12.
-                bool isLazyClear =
-                    ((!(usages.textureUsages[i] & dawn::TextureUsage::OutputAttachment) &&
-                      texture->GetFormat().IsColor()) ||
-                     texture->GetFormat().HasDepthOrStencil());
-                texture->EnsureSubresourceContentInitialized(
-                    0, texture->GetNumMipLevels(), 0, texture->GetArrayLayers(), isLazyClear);
+                // Only the subresources used by the pass are initialized.
+                usages.textureUsages[i].subresourceUsages.Iterate(
+                    [&](const SubresourceRange& range, const dawn::TextureUsage& usage) {
+                        if (usage == dawn::TextureUsage::None) {
+                            return;
+                        }
+                        // We count the lazy clears for non output attachment textures and depth
+                        // stencil textures in order to match the backdoor lazy clear counts in
+                        // Vulkan and D3D12.
+                        bool isLazyClear = ((!(usage & dawn::TextureUsage::OutputAttachment) &&
+                                             texture->GetFormat().IsColor()) ||
+                                            texture->GetFormat().HasDepthOrStencil());
+                        texture->EnsureSubresourceContentInitialized(
+                            range.baseMipLevel, range.levelCount, range.baseArrayLayer,
+                            range.layerCount, isLazyClear);
+                    });
             }
         };
 
@@ -463,6 +471,9 @@ namespace dawn_native { namespace opengl {
                         GL_UNPACK_ROW_LENGTH,
                         src.rowPitch / texture->GetFormat().blockByteSize * formatInfo.blockWidth);
                     gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, src.imageHeight);
+                    // The row pitch is only a multiple of the texel size, so the rows must not be
+                    // aligned to the default 4 bytes.
+                    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
                     if (texture->GetFormat().isCompressed) {
                         gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_SIZE, formatInfo.blockByteSize);
@@ -514,6 +525,7 @@ namespace dawn_native { namespace opengl {
 
                     gl.PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
                     gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+                    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
                     gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
                 } break;
@@ -564,12 +576,14 @@ namespace dawn_native { namespace opengl {
                     gl.PixelStorei(GL_PACK_ROW_LENGTH,
                                    dst.rowPitch / texture->GetFormat().blockByteSize);
                     gl.PixelStorei(GL_PACK_IMAGE_HEIGHT, dst.imageHeight);
+                    gl.PixelStorei(GL_PACK_ALIGNMENT, 1);
                     ASSERT(copySize.depth == 1 && src.origin.z == 0);
                     void* offset = reinterpret_cast<void*>(static_cast<uintptr_t>(dst.offset));
                     gl.ReadPixels(src.origin.x, src.origin.y, copySize.width, copySize.height,
                                   format.format, format.type, offset);
                     gl.PixelStorei(GL_PACK_ROW_LENGTH, 0);
                     gl.PixelStorei(GL_PACK_IMAGE_HEIGHT, 0);
+                    gl.PixelStorei(GL_PACK_ALIGNMENT, 4);
 
                     gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
                     gl.DeleteFramebuffers(1, &readFBO);
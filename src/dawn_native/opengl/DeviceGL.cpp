@@ -42,6 +42,9 @@ namespace dawn_native { namespace opengl {
     }
 
     Device::~Device() {
+        ClearDeduplicationCaches();
+        DeleteDeferredObjects();
+
         CheckPassedFences();
         ASSERT(mFencesInFlight.empty());
 
@@ -66,7 +69,7 @@ namespace dawn_native { namespace opengl {
 
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
-        return new BindGroup(this, descriptor);
+        return AllocateBindGroup<BindGroup>(this, descriptor);
     }
     ResultOrError<BindGroupLayoutBase*> Device::CreateBindGroupLayoutImpl(
         const BindGroupLayoutDescriptor* descriptor) {
@@ -77,7 +80,7 @@ namespace dawn_native { namespace opengl {
     }
     CommandBufferBase* Device::CreateCommandBuffer(CommandEncoderBase* encoder,
                                                    const CommandBufferDescriptor* descriptor) {
-        return new CommandBuffer(encoder, descriptor);
+        return GetCommandBufferAllocator()->New<CommandBuffer>(encoder, descriptor);
     }
     ResultOrError<ComputePipelineBase*> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -111,7 +114,7 @@ namespace dawn_native { namespace opengl {
     ResultOrError<TextureViewBase*> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return new TextureView(texture, descriptor);
+        return GetTextureViewAllocator()->New<TextureView>(texture, descriptor);
     }
 
     void Device::SubmitFenceSync() {
@@ -169,4 +172,11 @@ namespace dawn_native { namespace opengl {
         return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer.");
     }
 
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* staging,
+                                                const TextureDataLayout& source,
+                                                TextureCopy* destination,
+                                                const Extent3D& copySize) {
+        return DAWN_UNIMPLEMENTED_ERROR("Device unable to copy from staging buffer.");
+    }
+
 }}  // namespace dawn_native::opengl
@@ -61,6 +61,10 @@ namespace dawn_native { namespace opengl {
                                            BufferBase* destination,
                                            uint64_t destinationOffset,
                                            uint64_t size) override;
+        MaybeError CopyFromStagingToTexture(StagingBufferBase* staging,
+                                            const TextureDataLayout& source,
+                                            TextureCopy* destination,
+                                            const Extent3D& copySize) override;
 
       private:
         ResultOrError<BindGroupBase*> CreateBindGroupImpl(
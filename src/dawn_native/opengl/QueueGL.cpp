@@ -14,8 +14,13 @@
 
 #include "dawn_native/opengl/QueueGL.h"
 
+#include "dawn_native/Commands.h"
+#include "dawn_native/opengl/BufferGL.h"
 #include "dawn_native/opengl/CommandBufferGL.h"
 #include "dawn_native/opengl/DeviceGL.h"
+#include "dawn_native/opengl/TextureGL.h"
+
+#include <algorithm>
 
 namespace dawn_native { namespace opengl {
 
@@ -32,4 +37,88 @@ namespace dawn_native { namespace opengl {
         device->SubmitFenceSync();
     }
 
+    MaybeError Queue::WriteBufferImpl(BufferBase* buffer,
+                                      uint64_t bufferOffset,
+                                      const void* data,
+                                      uint64_t size) {
+        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+
+        gl.BindBuffer(GL_ARRAY_BUFFER, ToBackend(buffer)->GetHandle());
+        gl.BufferSubData(GL_ARRAY_BUFFER, bufferOffset, size, data);
+        return {};
+    }
+
+    MaybeError Queue::WriteTextureImpl(TextureCopy* destination,
+                                       const void* data,
+                                       const TextureDataLayout& dataLayout,
+                                       const Extent3D& writeSize) {
+        const OpenGLFunctions& gl = ToBackend(GetDevice())->gl;
+        Texture* texture = ToBackend(destination->texture.Get());
+        GLenum target = texture->GetGLTarget();
+        const GLFormat& format = texture->GetGLFormat();
+        const Format& formatInfo = texture->GetFormat();
+        const Origin3D& origin = destination->origin;
+
+        if (IsCompleteSubresourceCopiedTo(texture, writeSize, destination->mipLevel)) {
+            texture->SetIsSubresourceContentInitialized(destination->mipLevel, 1,
+                                                        destination->arrayLayer, 1);
+        } else {
+            texture->EnsureSubresourceContentInitialized(destination->mipLevel, 1,
+                                                         destination->arrayLayer, 1);
+        }
+
+        gl.ActiveTexture(GL_TEXTURE0);
+        gl.BindTexture(target, texture->GetHandle());
+
+        // Same unpack parameters as buffer-to-texture copies, but without a pixel unpack buffer
+        // bound the pixels are read from client memory.
+        const uint8_t* pixels = static_cast<const uint8_t*>(data) + dataLayout.offset;
+        gl.PixelStorei(GL_UNPACK_ROW_LENGTH,
+                       dataLayout.rowPitch / formatInfo.blockByteSize * formatInfo.blockWidth);
+        gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, dataLayout.imageHeight);
+        gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        ASSERT(texture->GetDimension() == dawn::TextureDimension::e2D);
+        if (formatInfo.isCompressed) {
+            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_SIZE, formatInfo.blockByteSize);
+            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_WIDTH, formatInfo.blockWidth);
+            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_HEIGHT, formatInfo.blockHeight);
+            gl.PixelStorei(GL_UNPACK_COMPRESSED_BLOCK_DEPTH, 1);
+
+            uint64_t writeDataSize = (writeSize.width / formatInfo.blockWidth) *
+                                     (writeSize.height / formatInfo.blockHeight) *
+                                     formatInfo.blockByteSize;
+            // The blocks on the edge of the mip level only cover its virtual size.
+            Extent3D virtualSize = texture->GetMipLevelVirtualSize(destination->mipLevel);
+            uint32_t width = std::min(writeSize.width, virtualSize.width - origin.x);
+            uint32_t height = std::min(writeSize.height, virtualSize.height - origin.y);
+
+            if (texture->GetArrayLayers() > 1) {
+                gl.CompressedTexSubImage3D(target, destination->mipLevel, origin.x, origin.y,
+                                           destination->arrayLayer, width, height, 1,
+                                           format.internalFormat, writeDataSize, pixels);
+            } else {
+                gl.CompressedTexSubImage2D(target, destination->mipLevel, origin.x, origin.y,
+                                           width, height, format.internalFormat, writeDataSize,
+                                           pixels);
+            }
+        } else {
+            if (texture->GetArrayLayers() > 1) {
+                gl.TexSubImage3D(target, destination->mipLevel, origin.x, origin.y,
+                                 destination->arrayLayer, writeSize.width, writeSize.height, 1,
+                                 format.format, format.type, pixels);
+            } else {
+                gl.TexSubImage2D(target, destination->mipLevel, origin.x, origin.y,
+                                 writeSize.width, writeSize.height, format.format, format.type,
+                                 pixels);
+            }
+        }
+
+        gl.PixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        gl.PixelStorei(GL_UNPACK_IMAGE_HEIGHT, 0);
+        gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        return {};
+    }
+
 }}  // namespace dawn_native::opengl
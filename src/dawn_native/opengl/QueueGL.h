@@ -28,6 +28,15 @@ namespace dawn_native { namespace opengl {
 
       private:
         void SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) override;
+        // OpenGL doesn't have staging buffers so the data is uploaded directly from client memory.
+        MaybeError WriteBufferImpl(BufferBase* buffer,
+                                   uint64_t bufferOffset,
+                                   const void* data,
+                                   uint64_t size) override;
+        MaybeError WriteTextureImpl(TextureCopy* destination,
+                                    const void* data,
+                                    const TextureDataLayout& dataLayout,
+                                    const Extent3D& writeSize) override;
     };
 
 }}  // namespace dawn_native::opengl
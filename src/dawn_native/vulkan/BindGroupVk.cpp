@@ -26,7 +26,7 @@
 namespace dawn_native { namespace vulkan {
 
     BindGroup::BindGroup(Device* device, const BindGroupDescriptor* descriptor)
-        : BindGroupBase(device, descriptor) {
+        : BindGroupBase(this, device, descriptor) {
         // Create a pool to hold our descriptor set.
         // TODO(cwallez@chromium.org): This horribly inefficient, find a way to be better, for
         // example by having one pool per bind group layout instead.
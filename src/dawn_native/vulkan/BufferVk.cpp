@@ -27,14 +27,13 @@ namespace dawn_native { namespace vulkan {
     namespace {
 
         VkBufferUsageFlags VulkanBufferUsage(dawn::BufferUsage usage) {
-            VkBufferUsageFlags flags = 0;
+            // All buffers can be the destination of copies even without CopyDst, for the
+            // initialization of non-mappable buffers in CreateBufferMapped and for lazy clears.
+            VkBufferUsageFlags flags = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
             if (usage & dawn::BufferUsage::CopySrc) {
                 flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
             }
-            if (usage & dawn::BufferUsage::CopyDst) {
-                flags |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-            }
             if (usage & dawn::BufferUsage::Index) {
                 flags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
             }
@@ -124,9 +123,7 @@ namespace dawn_native { namespace vulkan {
         createInfo.pNext = nullptr;
         createInfo.flags = 0;
         createInfo.size = GetSize();
-        // Add CopyDst for non-mappable buffer initialization in CreateBufferMapped
-        // and robust resource initialization.
-        createInfo.usage = VulkanBufferUsage(GetUsage() | dawn::BufferUsage::CopyDst);
+        createInfo.usage = VulkanBufferUsage(GetUsage());
         createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         createInfo.queueFamilyIndexCount = 0;
         createInfo.pQueueFamilyIndices = 0;
@@ -156,12 +153,14 @@ namespace dawn_native { namespace vulkan {
         DestroyInternal();
     }
 
-    void Buffer::OnMapReadCommandSerialFinished(uint32_t mapSerial, const void* data) {
-        CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+    void Buffer::OnMapReadCommandSerialFinished(uint32_t mapSerial,
+                                                const void* data,
+                                                uint64_t size) {
+        CallMapReadCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, size);
     }
 
-    void Buffer::OnMapWriteCommandSerialFinished(uint32_t mapSerial, void* data) {
-        CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, GetSize());
+    void Buffer::OnMapWriteCommandSerialFinished(uint32_t mapSerial, void* data, uint64_t size) {
+        CallMapWriteCallback(mapSerial, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, data, size);
     }
 
     VkBuffer Buffer::GetHandle() const {
@@ -215,7 +214,7 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
-    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial) {
+    MaybeError Buffer::MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
         Device* device = ToBackend(GetDevice());
 
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
@@ -225,11 +224,11 @@ namespace dawn_native { namespace vulkan {
         ASSERT(memory != nullptr);
 
         MapRequestTracker* tracker = device->GetMapRequestTracker();
-        tracker->Track(this, serial, memory, false);
+        tracker->Track(this, serial, memory + offset, size, false);
         return {};
     }
 
-    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial) {
+    MaybeError Buffer::MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) {
         Device* device = ToBackend(GetDevice());
 
         CommandRecordingContext* recordingContext = device->GetPendingRecordingContext();
@@ -239,7 +238,7 @@ namespace dawn_native { namespace vulkan {
         ASSERT(memory != nullptr);
 
         MapRequestTracker* tracker = device->GetMapRequestTracker();
-        tracker->Track(this, serial, memory, true);
+        tracker->Track(this, serial, memory + offset, size, true);
         return {};
     }
 
@@ -265,11 +264,16 @@ namespace dawn_native { namespace vulkan {
         ASSERT(mInflightRequests.Empty());
     }
 
-    void MapRequestTracker::Track(Buffer* buffer, uint32_t mapSerial, void* data, bool isWrite) {
+    void MapRequestTracker::Track(Buffer* buffer,
+                                  uint32_t mapSerial,
+                                  void* data,
+                                  uint64_t size,
+                                  bool isWrite) {
         Request request;
         request.buffer = buffer;
         request.mapSerial = mapSerial;
         request.data = data;
+        request.size = size;
         request.isWrite = isWrite;
 
         mInflightRequests.Enqueue(std::move(request), mDevice->GetPendingCommandSerial());
@@ -278,9 +282,11 @@ namespace dawn_native { namespace vulkan {
     void MapRequestTracker::Tick(Serial finishedSerial) {
         for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
             if (request.isWrite) {
-                request.buffer->OnMapWriteCommandSerialFinished(request.mapSerial, request.data);
+                request.buffer->OnMapWriteCommandSerialFinished(request.mapSerial, request.data,
+                                                                request.size);
             } else {
-                request.buffer->OnMapReadCommandSerialFinished(request.mapSerial, request.data);
+                request.buffer->OnMapReadCommandSerialFinished(request.mapSerial, request.data,
+                                                               request.size);
             }
         }
         mInflightRequests.ClearUpTo(finishedSerial);
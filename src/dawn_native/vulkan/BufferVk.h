@@ -34,8 +34,8 @@ namespace dawn_native { namespace vulkan {
 
         MaybeError Initialize();
 
-        void OnMapReadCommandSerialFinished(uint32_t mapSerial, const void* data);
-        void OnMapWriteCommandSerialFinished(uint32_t mapSerial, void* data);
+        void OnMapReadCommandSerialFinished(uint32_t mapSerial, const void* data, uint64_t size);
+        void OnMapWriteCommandSerialFinished(uint32_t mapSerial, void* data, uint64_t size);
 
         VkBuffer GetHandle() const;
 
@@ -46,8 +46,8 @@ namespace dawn_native { namespace vulkan {
 
       private:
         // Dawn API
-        MaybeError MapReadAsyncImpl(uint32_t serial) override;
-        MaybeError MapWriteAsyncImpl(uint32_t serial) override;
+        MaybeError MapReadAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
+        MaybeError MapWriteAsyncImpl(uint32_t serial, uint64_t offset, uint64_t size) override;
         void UnmapImpl() override;
         void DestroyImpl() override;
 
@@ -65,7 +65,7 @@ namespace dawn_native { namespace vulkan {
         MapRequestTracker(Device* device);
         ~MapRequestTracker();
 
-        void Track(Buffer* buffer, uint32_t mapSerial, void* data, bool isWrite);
+        void Track(Buffer* buffer, uint32_t mapSerial, void* data, uint64_t size, bool isWrite);
         void Tick(Serial finishedSerial);
 
       private:
@@ -75,6 +75,7 @@ namespace dawn_native { namespace vulkan {
             Ref<Buffer> buffer;
             uint32_t mapSerial;
             void* data;
+            uint64_t size;
             bool isWrite;
         };
         SerialQueue<Request> mInflightRequests;
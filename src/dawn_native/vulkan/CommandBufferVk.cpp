@@ -381,15 +381,21 @@ namespace dawn_native { namespace vulkan {
             }
             for (size_t i = 0; i < usages.textures.size(); ++i) {
                 Texture* texture = ToBackend(usages.textures[i]);
-                // Clear textures that are not output attachments. Output attachments will be
+                // Clear subresources that are not output attachments. Output attachments will be
                 // cleared in RecordBeginRenderPass by setting the loadop to clear when the
                 // texture subresource has not been initialized before the render pass.
-                if (!(usages.textureUsages[i] & dawn::TextureUsage::OutputAttachment)) {
-                    texture->EnsureSubresourceContentInitialized(recordingContext, 0,
-                                                                 texture->GetNumMipLevels(), 0,
-                                                                 texture->GetArrayLayers());
-                }
-                texture->TransitionUsageNow(recordingContext, usages.textureUsages[i]);
+                const SubresourceStorage<dawn::TextureUsage>& subresourceUsages =
+                    usages.textureUsages[i].subresourceUsages;
+                subresourceUsages.Iterate(
+                    [&](const SubresourceRange& range, const dawn::TextureUsage& usage) {
+                        if (usage != dawn::TextureUsage::None &&
+                            !(usage & dawn::TextureUsage::OutputAttachment)) {
+                            texture->EnsureSubresourceContentInitialized(
+                                recordingContext, range.baseMipLevel, range.levelCount,
+                                range.baseArrayLayer, range.layerCount);
+                        }
+                    });
+                texture->TransitionUsageForPass(recordingContext, subresourceUsages);
             }
         };
         const std::vector<PassResourceUsage>& passResourceUsages = GetResourceUsages().perPass;
@@ -439,7 +445,9 @@ namespace dawn_native { namespace vulkan {
                     ToBackend(src.buffer)
                         ->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopySrc);
                     ToBackend(dst.texture)
-                        ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst);
+                        ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst,
+                                             SubresourceRange::SingleSubresource(
+                                                 subresource.mipLevel, subresource.baseArrayLayer));
                     VkBuffer srcBuffer = ToBackend(src.buffer)->GetHandle();
                     VkImage dstImage = ToBackend(dst.texture)->GetHandle();
 
@@ -465,7 +473,9 @@ namespace dawn_native { namespace vulkan {
                                                               subresource.baseArrayLayer, 1);
 
                     ToBackend(src.texture)
-                        ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopySrc);
+                        ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopySrc,
+                                             SubresourceRange::SingleSubresource(
+                                                 subresource.mipLevel, subresource.baseArrayLayer));
                     ToBackend(dst.buffer)
                         ->TransitionUsageNow(recordingContext, dawn::BufferUsage::CopyDst);
 
@@ -497,9 +507,13 @@ namespace dawn_native { namespace vulkan {
                     }
 
                     ToBackend(src.texture)
-                        ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopySrc);
+                        ->TransitionUsageNow(
+                            recordingContext, dawn::TextureUsage::CopySrc,
+                            SubresourceRange::SingleSubresource(src.mipLevel, src.arrayLayer));
                     ToBackend(dst.texture)
-                        ->TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst);
+                        ->TransitionUsageNow(
+                            recordingContext, dawn::TextureUsage::CopyDst,
+                            SubresourceRange::SingleSubresource(dst.mipLevel, dst.arrayLayer));
 
                     // In some situations we cannot do texture-to-texture copies with vkCmdCopyImage
                     // because as Vulkan SPEC always validates image copies with the virtual size of
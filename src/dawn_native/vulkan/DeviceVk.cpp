@@ -38,6 +38,7 @@
 #include "dawn_native/vulkan/StagingBufferVk.h"
 #include "dawn_native/vulkan/SwapChainVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
+#include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
 namespace dawn_native { namespace vulkan {
@@ -79,6 +80,11 @@ namespace dawn_native { namespace vulkan {
     }
 
     Device::~Device() {
+        // Release the deduplicated objects and delete the objects whose deletion was deferred so
+        // that their Vulkan objects are deleted below.
+        ClearDeduplicationCaches();
+        DeleteDeferredObjects();
+
         // Immediately forget about all pending commands so we don't try to submit them in Tick
         FreeCommands(&mPendingCommands);
 
@@ -147,7 +153,7 @@ namespace dawn_native { namespace vulkan {
 
     ResultOrError<BindGroupBase*> Device::CreateBindGroupImpl(
         const BindGroupDescriptor* descriptor) {
-        return new BindGroup(this, descriptor);
+        return AllocateBindGroup<BindGroup>(this, descriptor);
     }
     ResultOrError<BindGroupLayoutBase*> Device::CreateBindGroupLayoutImpl(
         const BindGroupLayoutDescriptor* descriptor) {
@@ -160,7 +166,7 @@ namespace dawn_native { namespace vulkan {
     }
     CommandBufferBase* Device::CreateCommandBuffer(CommandEncoderBase* encoder,
                                                    const CommandBufferDescriptor* descriptor) {
-        return new CommandBuffer(encoder, descriptor);
+        return GetCommandBufferAllocator()->New<CommandBuffer>(encoder, descriptor);
     }
     ResultOrError<ComputePipelineBase*> Device::CreateComputePipelineImpl(
         const ComputePipelineDescriptor* descriptor) {
@@ -194,7 +200,7 @@ namespace dawn_native { namespace vulkan {
     ResultOrError<TextureViewBase*> Device::CreateTextureViewImpl(
         TextureBase* texture,
         const TextureViewDescriptor* descriptor) {
-        return new TextureView(texture, descriptor);
+        return GetTextureViewAllocator()->New<TextureView>(texture, descriptor);
     }
 
     Serial Device::GetCompletedCommandSerial() const {
@@ -584,6 +590,35 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    MaybeError Device::CopyFromStagingToTexture(StagingBufferBase* staging,
+                                                const TextureDataLayout& source,
+                                                TextureCopy* destination,
+                                                const Extent3D& copySize) {
+        CommandRecordingContext* recordingContext = GetPendingRecordingContext();
+        Texture* texture = ToBackend(destination->texture.Get());
+
+        VkBufferImageCopy region = ComputeBufferImageCopyRegion(source, *destination, copySize);
+        VkImageSubresourceLayers subresource = region.imageSubresource;
+
+        if (IsCompleteSubresourceCopiedTo(texture, copySize, subresource.mipLevel)) {
+            texture->SetIsSubresourceContentInitialized(subresource.mipLevel, 1,
+                                                        subresource.baseArrayLayer, 1);
+        } else {
+            texture->EnsureSubresourceContentInitialized(recordingContext, subresource.mipLevel, 1,
+                                                         subresource.baseArrayLayer, 1);
+        }
+        texture->TransitionUsageNow(
+            recordingContext, dawn::TextureUsage::CopyDst,
+            SubresourceRange::SingleSubresource(subresource.mipLevel, subresource.baseArrayLayer));
+
+        // Dawn guarantees the image is in the TRANSFER_DST_OPTIMAL layout after the copy command.
+        this->fn.CmdCopyBufferToImage(GetPendingCommandBuffer(),
+                                      ToBackend(staging)->GetBufferHandle(), texture->GetHandle(),
+                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        return {};
+    }
+
     MaybeError Device::ImportExternalImage(const ExternalImageDescriptor* descriptor,
                                            ExternalMemoryHandle memoryHandle,
                                            const std::vector<ExternalSemaphoreHandle>& waitHandles,
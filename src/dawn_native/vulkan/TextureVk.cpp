@@ -396,7 +396,10 @@ namespace dawn_native { namespace vulkan {
     }
 
     Texture::Texture(Device* device, const TextureDescriptor* descriptor)
-        : TextureBase(device, descriptor, TextureState::OwnedInternal) {
+        : TextureBase(device, descriptor, TextureState::OwnedInternal),
+          mSubresourceLastUsages(descriptor->mipLevelCount,
+                                 descriptor->arrayLayerCount,
+                                 dawn::TextureUsage::None) {
         // Create the Vulkan image "container". We don't need to check that the format supports the
         // combination of sample, usage etc. because validation should have been done in the Dawn
         // frontend already based on the minimum supported formats in the Vulkan spec
@@ -455,7 +458,11 @@ namespace dawn_native { namespace vulkan {
 
     // With this constructor, the lifetime of the resource is externally managed.
     Texture::Texture(Device* device, const TextureDescriptor* descriptor, VkImage nativeImage)
-        : TextureBase(device, descriptor, TextureState::OwnedExternal), mHandle(nativeImage) {
+        : TextureBase(device, descriptor, TextureState::OwnedExternal),
+          mHandle(nativeImage),
+          mSubresourceLastUsages(descriptor->mipLevelCount,
+                                 descriptor->arrayLayerCount,
+                                 dawn::TextureUsage::None) {
     }
 
     // Internally managed, but imported from file descriptor
@@ -469,7 +476,10 @@ namespace dawn_native { namespace vulkan {
           mExternalAllocation(externalMemoryAllocation),
           mExternalState(ExternalState::PendingAcquire),
           mSignalSemaphore(signalSemaphore),
-          mWaitRequirements(std::move(waitSemaphores)) {
+          mWaitRequirements(std::move(waitSemaphores)),
+          mSubresourceLastUsages(textureDescriptor->mipLevelCount,
+                                 textureDescriptor->arrayLayerCount,
+                                 dawn::TextureUsage::None) {
         VkImageCreateInfo createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
         createInfo.pNext = nullptr;
@@ -586,49 +596,110 @@ namespace dawn_native { namespace vulkan {
 
     void Texture::TransitionUsageNow(CommandRecordingContext* recordingContext,
                                      dawn::TextureUsage usage) {
+        TransitionUsageNow(recordingContext, usage, GetAllSubresources());
+    }
+
+    void Texture::TransitionUsageNow(CommandRecordingContext* recordingContext,
+                                     dawn::TextureUsage usage,
+                                     const SubresourceRange& range) {
+        std::vector<VkImageMemoryBarrier> barriers;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+
+        mSubresourceLastUsages.Update(
+            range, [&](const SubresourceRange& updatedRange, dawn::TextureUsage* lastUsage) {
+                TransitionSubresourceRange(updatedRange, lastUsage, usage, &barriers, &srcStages,
+                                           &dstStages);
+            });
+
+        RecordBarriers(recordingContext, &barriers, srcStages, dstStages);
+    }
+
+    void Texture::TransitionUsageForPass(CommandRecordingContext* recordingContext,
+                                         const SubresourceStorage<dawn::TextureUsage>& passUsages) {
+        std::vector<VkImageMemoryBarrier> barriers;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+
+        mSubresourceLastUsages.Merge(
+            passUsages, [&](const SubresourceRange& range, dawn::TextureUsage* lastUsage,
+                            const dawn::TextureUsage& usage) {
+                // Subresources that aren't used by the pass keep their usage and layout.
+                if (usage == dawn::TextureUsage::None) {
+                    return;
+                }
+                TransitionSubresourceRange(range, lastUsage, usage, &barriers, &srcStages,
+                                           &dstStages);
+            });
+
+        RecordBarriers(recordingContext, &barriers, srcStages, dstStages);
+    }
+
+    void Texture::TransitionSubresourceRange(const SubresourceRange& range,
+                                             dawn::TextureUsage* lastUsage,
+                                             dawn::TextureUsage usage,
+                                             std::vector<VkImageMemoryBarrier>* barriers,
+                                             VkPipelineStageFlags* srcStages,
+                                             VkPipelineStageFlags* dstStages) const {
         // Avoid encoding barriers when it isn't needed.
-        bool lastReadOnly = (mLastUsage & kReadOnlyTextureUsages) == mLastUsage;
-        if (lastReadOnly && mLastUsage == usage && mLastExternalState == mExternalState) {
+        bool lastReadOnly = (*lastUsage & kReadOnlyTextureUsages) == *lastUsage;
+        if (lastReadOnly && *lastUsage == usage && mLastExternalState == mExternalState) {
             return;
         }
 
         const Format& format = GetFormat();
 
-        VkPipelineStageFlags srcStages = VulkanPipelineStage(mLastUsage, format);
-        VkPipelineStageFlags dstStages = VulkanPipelineStage(usage, format);
+        *srcStages |= VulkanPipelineStage(*lastUsage, format);
+        *dstStages |= VulkanPipelineStage(usage, format);
 
         VkImageMemoryBarrier barrier;
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
         barrier.pNext = nullptr;
-        barrier.srcAccessMask = VulkanAccessFlags(mLastUsage, format);
+        barrier.srcAccessMask = VulkanAccessFlags(*lastUsage, format);
         barrier.dstAccessMask = VulkanAccessFlags(usage, format);
-        barrier.oldLayout = VulkanImageLayout(mLastUsage, format);
+        barrier.oldLayout = VulkanImageLayout(*lastUsage, format);
         barrier.newLayout = VulkanImageLayout(usage, format);
         barrier.image = mHandle;
-        // This transitions the whole resource but assumes it is a 2D texture
+        // This transitions the subresources but assumes it is a 2D texture
         ASSERT(GetDimension() == dawn::TextureDimension::e2D);
         barrier.subresourceRange.aspectMask = VulkanAspectMask(format);
-        barrier.subresourceRange.baseMipLevel = 0;
-        barrier.subresourceRange.levelCount = GetNumMipLevels();
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.subresourceRange.layerCount = GetArrayLayers();
+        barrier.subresourceRange.baseMipLevel = range.baseMipLevel;
+        barrier.subresourceRange.levelCount = range.levelCount;
+        barrier.subresourceRange.baseArrayLayer = range.baseArrayLayer;
+        barrier.subresourceRange.layerCount = range.layerCount;
 
         barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
+        barriers->push_back(barrier);
+        *lastUsage = usage;
+    }
+
+    void Texture::RecordBarriers(CommandRecordingContext* recordingContext,
+                                 std::vector<VkImageMemoryBarrier>* barriers,
+                                 VkPipelineStageFlags srcStages,
+                                 VkPipelineStageFlags dstStages) {
+        if (barriers->empty()) {
+            return;
+        }
+
         if (mExternalState == ExternalState::PendingAcquire) {
             // Transfer texture from external queue to graphics queue
-            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL_KHR;
-            barrier.dstQueueFamilyIndex = ToBackend(GetDevice())->GetGraphicsQueueFamily();
-            // Don't override oldLayout to leave it as VK_IMAGE_LAYOUT_UNDEFINED
-            // TODO(http://crbug.com/dawn/200)
+            for (VkImageMemoryBarrier& barrier : *barriers) {
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL_KHR;
+                barrier.dstQueueFamilyIndex = ToBackend(GetDevice())->GetGraphicsQueueFamily();
+                // Don't override oldLayout to leave it as VK_IMAGE_LAYOUT_UNDEFINED
+                // TODO(http://crbug.com/dawn/200)
+            }
             mExternalState = ExternalState::Acquired;
 
         } else if (mExternalState == ExternalState::PendingRelease) {
             // Transfer texture from graphics queue to external queue
-            barrier.srcQueueFamilyIndex = ToBackend(GetDevice())->GetGraphicsQueueFamily();
-            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL_KHR;
-            barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            for (VkImageMemoryBarrier& barrier : *barriers) {
+                barrier.srcQueueFamilyIndex = ToBackend(GetDevice())->GetGraphicsQueueFamily();
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL_KHR;
+                barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            }
             mExternalState = ExternalState::Released;
         }
 
@@ -639,9 +710,9 @@ namespace dawn_native { namespace vulkan {
 
         ToBackend(GetDevice())
             ->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages, dstStages, 0, 0,
-                                    nullptr, 0, nullptr, 1, &barrier);
+                                    nullptr, 0, nullptr, static_cast<uint32_t>(barriers->size()),
+                                    barriers->data());
 
-        mLastUsage = usage;
         mLastExternalState = mExternalState;
     }
 
@@ -660,7 +731,8 @@ namespace dawn_native { namespace vulkan {
         range.layerCount = layerCount;
         uint8_t clearColor = (clearValue == TextureBase::ClearValue::Zero) ? 0 : 1;
 
-        TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst);
+        TransitionUsageNow(recordingContext, dawn::TextureUsage::CopyDst,
+                           {baseMipLevel, levelCount, baseArrayLayer, layerCount});
         if (GetFormat().isRenderable) {
             if (GetFormat().HasDepthOrStencil()) {
                 VkClearDepthStencilValue clearDepthStencilValue[1];
@@ -56,11 +56,18 @@ namespace dawn_native { namespace vulkan {
         VkImage GetHandle() const;
         VkImageAspectFlags GetVkAspectMask() const;
 
-        // Transitions the texture to be used as `usage`, recording any necessary barrier in
-        // `commands`.
+        // Transitions the texture, or |range| of its subresources, to be used as `usage`,
+        // recording any necessary barrier in `commands`. The usage and layout of the texture are
+        // tracked per subresource.
         // TODO(cwallez@chromium.org): coalesce barriers and do them early when possible.
         void TransitionUsageNow(CommandRecordingContext* recordingContext,
                                 dawn::TextureUsage usage);
+        void TransitionUsageNow(CommandRecordingContext* recordingContext,
+                                dawn::TextureUsage usage,
+                                const SubresourceRange& range);
+        // Transitions the subresources used by a pass to their usage in the pass.
+        void TransitionUsageForPass(CommandRecordingContext* recordingContext,
+                                    const SubresourceStorage<dawn::TextureUsage>& passUsages);
         void EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
                                                  uint32_t baseMipLevel,
                                                  uint32_t levelCount,
@@ -78,6 +85,19 @@ namespace dawn_native { namespace vulkan {
                                 uint32_t layerCount,
                                 TextureBase::ClearValue);
 
+        // Adds to |barriers| the barrier transitioning |range| from |*lastUsage| to |usage|, if
+        // one is needed, and updates |*lastUsage|.
+        void TransitionSubresourceRange(const SubresourceRange& range,
+                                        dawn::TextureUsage* lastUsage,
+                                        dawn::TextureUsage usage,
+                                        std::vector<VkImageMemoryBarrier>* barriers,
+                                        VkPipelineStageFlags* srcStages,
+                                        VkPipelineStageFlags* dstStages) const;
+        void RecordBarriers(CommandRecordingContext* recordingContext,
+                            std::vector<VkImageMemoryBarrier>* barriers,
+                            VkPipelineStageFlags srcStages,
+                            VkPipelineStageFlags dstStages);
+
         VkImage mHandle = VK_NULL_HANDLE;
         DeviceMemoryAllocation mMemoryAllocation;
         VkDeviceMemory mExternalAllocation = VK_NULL_HANDLE;
@@ -89,7 +109,7 @@ namespace dawn_native { namespace vulkan {
 
         // A usage of none will make sure the texture is transitioned before its first use as
         // required by the spec.
-        dawn::TextureUsage mLastUsage = dawn::TextureUsage::None;
+        SubresourceStorage<dawn::TextureUsage> mSubresourceLastUsages;
     };
 
     class TextureView : public TextureViewBase {
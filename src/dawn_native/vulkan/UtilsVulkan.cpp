@@ -68,16 +68,27 @@ namespace dawn_native { namespace vulkan {
     VkBufferImageCopy ComputeBufferImageCopyRegion(const BufferCopy& bufferCopy,
                                                    const TextureCopy& textureCopy,
                                                    const Extent3D& copySize) {
+        TextureDataLayout dataLayout;
+        dataLayout.offset = bufferCopy.offset;
+        dataLayout.rowPitch = bufferCopy.rowPitch;
+        dataLayout.imageHeight = bufferCopy.imageHeight;
+
+        return ComputeBufferImageCopyRegion(dataLayout, textureCopy, copySize);
+    }
+
+    VkBufferImageCopy ComputeBufferImageCopyRegion(const TextureDataLayout& dataLayout,
+                                                   const TextureCopy& textureCopy,
+                                                   const Extent3D& copySize) {
         const Texture* texture = ToBackend(textureCopy.texture.Get());
 
         VkBufferImageCopy region;
 
-        region.bufferOffset = bufferCopy.offset;
+        region.bufferOffset = dataLayout.offset;
         // In Vulkan the row length is in texels while it is in bytes for Dawn
         const Format& format = texture->GetFormat();
-        ASSERT(bufferCopy.rowPitch % format.blockByteSize == 0);
-        region.bufferRowLength = bufferCopy.rowPitch / format.blockByteSize * format.blockWidth;
-        region.bufferImageHeight = bufferCopy.imageHeight;
+        ASSERT(dataLayout.rowPitch % format.blockByteSize == 0);
+        region.bufferRowLength = dataLayout.rowPitch / format.blockByteSize * format.blockWidth;
+        region.bufferImageHeight = dataLayout.imageHeight;
 
         region.imageSubresource.aspectMask = texture->GetVkAspectMask();
         region.imageSubresource.mipLevel = textureCopy.mipLevel;
@@ -0,0 +1,81 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_OBJECTIDBITSET_H_
+#define DAWNWIRE_OBJECTIDBITSET_H_
+
+#include "common/Math.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace dawn_wire {
+
+    // A growable bit set indexed by object ID. It is used to track which IDs are allocated or
+    // free with one bit per ID, so that queries and scans don't touch the per-object storage.
+    class ObjectIdBitSet {
+      public:
+        bool Test(uint32_t id) const {
+            size_t word = id / kBitsPerWord;
+            return word < mWords.size() && (mWords[word] & Bit(id)) != 0;
+        }
+
+        void Set(uint32_t id) {
+            size_t word = id / kBitsPerWord;
+            if (word >= mWords.size()) {
+                mWords.resize(word + 1, 0);
+            }
+            mWords[word] |= Bit(id);
+        }
+
+        void Reset(uint32_t id) {
+            size_t word = id / kBitsPerWord;
+            if (word < mWords.size()) {
+                mWords[word] &= ~Bit(id);
+            }
+        }
+
+        // Finds the smallest ID >= |start| in the set. Returns false if there is none.
+        bool FindFirst(uint32_t start, uint32_t* id) const {
+            size_t word = start / kBitsPerWord;
+            if (word >= mWords.size()) {
+                return false;
+            }
+
+            // Mask out the bits before |start| in the first word.
+            uint32_t bits = mWords[word] & ~(Bit(start) - 1);
+            while (bits == 0) {
+                if (++word >= mWords.size()) {
+                    return false;
+                }
+                bits = mWords[word];
+            }
+
+            *id = static_cast<uint32_t>(word * kBitsPerWord) + ScanForward(bits);
+            return true;
+        }
+
+      private:
+        static constexpr uint32_t kBitsPerWord = 32;
+
+        static uint32_t Bit(uint32_t id) {
+            return 1u << (id % kBitsPerWord);
+        }
+
+        std::vector<uint32_t> mWords;
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_OBJECTIDBITSET_H_
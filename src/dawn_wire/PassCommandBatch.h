@@ -0,0 +1,64 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_PASSCOMMANDBATCH_H_
+#define DAWNWIRE_PASSCOMMANDBATCH_H_
+
+#include "dawn_wire/WireCmd_autogen.h"
+
+#include <cstdint>
+
+namespace dawn_wire {
+
+    // The hot render pass encoder commands can be recorded by the client into a compact batch
+    // that is sent as a single RenderPassEncoderExecuteBatch command, instead of one wire command
+    // per API call. The batch is a tightly packed sequence of records, each made of a
+    // BatchedPassCommand followed by the matching Batched*Cmd structure. Records are not aligned
+    // so they must be read with memcpy.
+    enum class BatchedPassCommand : uint32_t {
+        SetPipeline,
+        SetBindGroup,
+        Draw,
+        DrawIndexed,
+    };
+
+    struct BatchedSetPipelineCmd {
+        ObjectId pipelineId;
+    };
+
+    // Followed by dynamicOffsetCount uint64_t offsets.
+    struct BatchedSetBindGroupCmd {
+        uint32_t groupIndex;
+        ObjectId groupId;
+        uint32_t dynamicOffsetCount;
+    };
+
+    struct BatchedDrawCmd {
+        uint32_t vertexCount;
+        uint32_t instanceCount;
+        uint32_t firstVertex;
+        uint32_t firstInstance;
+    };
+
+    struct BatchedDrawIndexedCmd {
+        uint32_t indexCount;
+        uint32_t instanceCount;
+        uint32_t firstIndex;
+        int32_t baseVertex;
+        uint32_t firstInstance;
+    };
+
+}  // namespace dawn_wire
+
+#endif  // DAWNWIRE_PASSCOMMANDBATCH_H_
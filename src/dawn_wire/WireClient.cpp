@@ -18,7 +18,10 @@
 namespace dawn_wire {
 
     WireClient::WireClient(const WireClientDescriptor& descriptor)
-        : mImpl(new client::Client(descriptor.serializer, descriptor.memoryTransferService)) {
+        : mImpl(new client::Client(descriptor.serializer,
+                                   descriptor.memoryTransferService,
+                                   descriptor.batchRenderPassCommands,
+                                   descriptor.maxRetainedDeserializationSize)) {
     }
 
     WireClient::~WireClient() {
@@ -41,6 +44,10 @@ namespace dawn_wire {
         return mImpl->ReserveTexture(device);
     }
 
+    size_t WireClient::GetDeserializationHighWaterMark() const {
+        return mImpl->GetDeserializationHighWaterMark();
+    }
+
     namespace client {
         MemoryTransferService::~MemoryTransferService() = default;
 
@@ -17,12 +17,17 @@
 #include <algorithm>
 
 namespace dawn_wire {
-    WireDeserializeAllocator::WireDeserializeAllocator() {
+    // static
+    constexpr size_t WireDeserializeAllocator::kDefaultMaxRetainedSize;
+
+    WireDeserializeAllocator::WireDeserializeAllocator(size_t maxRetainedSize)
+        : mMaxRetainedSize(maxRetainedSize) {
         Reset();
     }
 
     WireDeserializeAllocator::~WireDeserializeAllocator() {
         Reset();
+        free(mRetainedChunk.data);
     }
 
     void* WireDeserializeAllocator::GetSpace(size_t size) {
@@ -31,30 +36,66 @@ namespace dawn_wire {
             char* buffer = mCurrentBuffer;
             mCurrentBuffer += size;
             mRemainingSize -= size;
+
+            mUsedSize += size;
+            mHighWaterMark = std::max(mHighWaterMark, mUsedSize);
             return buffer;
         }
 
-        // Otherwise allocate a new buffer and try again.
-        size_t allocationSize = std::max(size, size_t(2048));
+        // Then use the retained chunk if it has enough space.
+        if (!mRetainedChunkInUse && mRetainedChunk.size >= size) {
+            mRetainedChunkInUse = true;
+            mCurrentBuffer = mRetainedChunk.data;
+            mRemainingSize = mRetainedChunk.size;
+            return GetSpace(size);
+        }
+
+        // Otherwise allocate a new buffer twice as large as the previous one and try again.
+        size_t previousSize = sizeof(mStaticBuffer);
+        if (!mAllocations.empty()) {
+            previousSize = mAllocations.back().size;
+        } else if (mRetainedChunkInUse) {
+            previousSize = mRetainedChunk.size;
+        }
+        size_t allocationSize = std::max(size, 2 * previousSize);
         char* allocation = static_cast<char*>(malloc(allocationSize));
         if (allocation == nullptr) {
             return nullptr;
         }
 
-        mAllocations.push_back(allocation);
+        mAllocations.push_back({allocation, allocationSize});
         mCurrentBuffer = allocation;
         mRemainingSize = allocationSize;
         return GetSpace(size);
     }
 
     void WireDeserializeAllocator::Reset() {
-        for (auto allocation : mAllocations) {
-            free(allocation);
+        // Chunks grow so the last one is the largest. Keep it if it is larger than the retained
+        // chunk so the next commands can use it without allocating.
+        if (!mAllocations.empty()) {
+            Chunk& largest = mAllocations.back();
+            if (largest.size > mRetainedChunk.size && largest.size <= mMaxRetainedSize) {
+                std::swap(largest, mRetainedChunk);
+            }
+        }
+
+        for (const Chunk& allocation : mAllocations) {
+            free(allocation.data);
         }
         mAllocations.clear();
 
         // The initial buffer is the inline buffer so that some allocations can be skipped
         mCurrentBuffer = mStaticBuffer;
         mRemainingSize = sizeof(mStaticBuffer);
+        mRetainedChunkInUse = false;
+        mUsedSize = 0;
+    }
+
+    size_t WireDeserializeAllocator::GetRetainedSize() const {
+        return mRetainedChunk.size;
+    }
+
+    size_t WireDeserializeAllocator::GetHighWaterMark() const {
+        return mHighWaterMark;
     }
 }  // namespace dawn_wire
@@ -20,23 +20,48 @@
 #include <vector>
 
 namespace dawn_wire {
-    // A really really simple implementation of the DeserializeAllocator. It's main feature
-    // is that it has some inline storage so as to avoid allocations for the majority of
-    // commands.
+    // A simple arena implementation of the DeserializeAllocator. It has some inline storage so as
+    // to avoid allocations for the majority of commands, then allocates chunks of growing size.
+    // The largest chunk is kept across Resets so that streams of large commands stop allocating
+    // after the first few commands.
     class WireDeserializeAllocator : public DeserializeAllocator {
       public:
-        WireDeserializeAllocator();
+        static constexpr size_t kDefaultMaxRetainedSize = 1024 * 1024;
+
+        // Chunks larger than |maxRetainedSize| are freed on Reset.
+        WireDeserializeAllocator(size_t maxRetainedSize = kDefaultMaxRetainedSize);
         virtual ~WireDeserializeAllocator();
 
         void* GetSpace(size_t size) override;
 
+        // Frees all the space, keeping the largest chunk if it isn't larger than the maximum
+        // retained size.
         void Reset();
 
+        // The size of the chunk kept across Resets, zero if there is none.
+        size_t GetRetainedSize() const;
+
+        // The largest amount of space requested between two Resets.
+        size_t GetHighWaterMark() const;
+
       private:
+        struct Chunk {
+            char* data;
+            size_t size;
+        };
+
         size_t mRemainingSize = 0;
         char* mCurrentBuffer = nullptr;
         char mStaticBuffer[2048];
-        std::vector<char*> mAllocations;
+
+        // The chunk kept from before the last Reset, used once the inline storage is full.
+        Chunk mRetainedChunk = {nullptr, 0};
+        bool mRetainedChunkInUse = false;
+        std::vector<Chunk> mAllocations;
+        size_t mMaxRetainedSize;
+
+        size_t mUsedSize = 0;
+        size_t mHighWaterMark = 0;
     };
 }  // namespace dawn_wire
 
@@ -13,15 +13,27 @@
 // limitations under the License.
 
 #include "dawn_wire/WireServer.h"
+#include "common/Assert.h"
 #include "dawn_wire/server/Server.h"
+#include "dawn_wire/server/ServerPool.h"
 
 namespace dawn_wire {
 
+    // static
+    constexpr uint32_t WireServer::kDefaultClientId;
+
     WireServer::WireServer(const WireServerDescriptor& descriptor)
-        : mImpl(new server::Server(descriptor.device,
-                                   *descriptor.procs,
-                                   descriptor.serializer,
-                                   descriptor.memoryTransferService)) {
+        : mImpl(new server::ServerPool(*descriptor.procs, descriptor.maxCommandsPerTurn)) {
+        if (descriptor.device != nullptr) {
+            WireServerClientDescriptor clientDesc = {};
+            clientDesc.device = descriptor.device;
+            clientDesc.serializer = descriptor.serializer;
+            clientDesc.memoryTransferService = descriptor.memoryTransferService;
+            clientDesc.maxRetainedDeserializationSize = descriptor.maxRetainedDeserializationSize;
+
+            uint32_t clientId = mImpl->AddClient(clientDesc);
+            ASSERT(clientId == kDefaultClientId);
+        }
     }
 
     WireServer::~WireServer() {
@@ -29,11 +41,50 @@ namespace dawn_wire {
     }
 
     const char* WireServer::HandleCommands(const char* commands, size_t size) {
-        return mImpl->HandleCommands(commands, size);
+        return mImpl->HandleCommands(kDefaultClientId, commands, size);
     }
 
     bool WireServer::InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation) {
-        return mImpl->InjectTexture(texture, id, generation);
+        return mImpl->InjectTexture(kDefaultClientId, texture, id, generation);
+    }
+
+    uint32_t WireServer::AddClient(const WireServerClientDescriptor& descriptor) {
+        return mImpl->AddClient(descriptor);
+    }
+
+    void WireServer::RemoveClient(uint32_t clientId) {
+        mImpl->RemoveClient(clientId);
+    }
+
+    const char* WireServer::HandleCommands(uint32_t clientId, const char* commands, size_t size) {
+        return mImpl->HandleCommands(clientId, commands, size);
+    }
+
+    bool WireServer::InjectTexture(uint32_t clientId,
+                                   DawnTexture texture,
+                                   uint32_t id,
+                                   uint32_t generation) {
+        return mImpl->InjectTexture(clientId, texture, id, generation);
+    }
+
+    void WireServer::QueueCommands(uint32_t clientId, const char* commands, size_t size) {
+        mImpl->QueueCommands(clientId, commands, size);
+    }
+
+    bool WireServer::ProcessQueuedCommands() {
+        return mImpl->ProcessQueuedCommands();
+    }
+
+    bool WireServer::IsClientLost(uint32_t clientId) const {
+        return mImpl->IsClientLost(clientId);
+    }
+
+    size_t WireServer::GetDeserializationHighWaterMark() const {
+        return mImpl->GetDeserializationHighWaterMark(kDefaultClientId);
+    }
+
+    size_t WireServer::GetDeserializationHighWaterMark(uint32_t clientId) const {
+        return mImpl->GetDeserializationHighWaterMark(clientId);
     }
 
     namespace server {
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "dawn_wire/PassCommandBatch.h"
 #include "dawn_wire/client/ApiObjects.h"
 #include "dawn_wire/client/ApiProcs_autogen.h"
 #include "dawn_wire/client/Client.h"
@@ -20,7 +21,12 @@ namespace dawn_wire { namespace client {
 
     namespace {
         template <typename Handle>
-        void SerializeBufferMapAsync(const Buffer* buffer, uint32_t serial, Handle* handle) {
+        void SerializeBufferMapAsync(const Buffer* buffer,
+                                     uint32_t serial,
+                                     bool isRange,
+                                     uint64_t offset,
+                                     uint64_t size,
+                                     Handle* handle) {
             // TODO(enga): Remove the template when Read/Write handles are combined in a tagged
             // pointer.
             constexpr bool isWrite =
@@ -33,6 +39,9 @@ namespace dawn_wire { namespace client {
             cmd.bufferId = buffer->id;
             cmd.requestSerial = serial;
             cmd.isWrite = isWrite;
+            cmd.isRange = isRange;
+            cmd.offset = offset;
+            cmd.size = size;
             cmd.handleCreateInfoLength = handleCreateInfoLength;
             cmd.handleCreateInfo = nullptr;
 
@@ -44,67 +53,136 @@ namespace dawn_wire { namespace client {
             // Serialize the handle into the space after the command.
             handle->SerializeCreate(allocatedBuffer + commandSize);
         }
-    }  // namespace
 
-    void ClientBufferMapReadAsync(DawnBuffer cBuffer,
-                                  DawnBufferMapReadCallback callback,
-                                  void* userdata) {
-        Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+        // Appends a record for |command| to the pass batch of |encoder| and returns a pointer to
+        // the |extraSize| bytes following it.
+        template <typename BatchedCmd>
+        char* AppendBatchedPassCommand(RenderPassEncoder* encoder,
+                                       BatchedPassCommand command,
+                                       const BatchedCmd& record,
+                                       size_t extraSize = 0) {
+            char* space = encoder->device->GetClient()->GetPassBatchSpace(
+                encoder->id, sizeof(BatchedPassCommand) + sizeof(BatchedCmd) + extraSize);
+            memcpy(space, &command, sizeof(BatchedPassCommand));
+            space += sizeof(BatchedPassCommand);
+            memcpy(space, &record, sizeof(BatchedCmd));
+            return space + sizeof(BatchedCmd);
+        }
 
-        uint32_t serial = buffer->requestSerial++;
-        ASSERT(buffer->requests.find(serial) == buffer->requests.end());
+        template <typename Cmd>
+        void SerializeRenderPassEncoderCmd(RenderPassEncoder* encoder, const Cmd& cmd) {
+            Client* wireClient = encoder->device->GetClient();
+            size_t requiredSize = cmd.GetRequiredSize();
+            char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+            cmd.Serialize(allocatedBuffer, *wireClient);
+        }
 
-        // Create a ReadHandle for the map request. This is the client's intent to read GPU
-        // memory.
-        MemoryTransferService::ReadHandle* readHandle =
-            buffer->device->GetClient()->GetMemoryTransferService()->CreateReadHandle(buffer->size);
-        if (readHandle == nullptr) {
-            callback(DAWN_BUFFER_MAP_ASYNC_STATUS_DEVICE_LOST, nullptr, 0, userdata);
-            return;
+        // Returns the size of the MemoryTransferService handle to create for mapping the
+        // [offset, offset + size) range of |buffer|. Validation of the range is deferred to the
+        // server, but out-of-bounds ranges get an empty handle so that an invalid size doesn't
+        // cause a large allocation.
+        size_t GetMapHandleSize(const Buffer* buffer, uint64_t offset, uint64_t size) {
+            if (size > buffer->size || offset > buffer->size - size) {
+                return 0;
+            }
+            return static_cast<size_t>(size);
         }
 
-        Buffer::MapRequestData request = {};
-        request.readCallback = callback;
-        request.userdata = userdata;
-        // The handle is owned by the MapRequest until the callback returns.
-        request.readHandle = std::unique_ptr<MemoryTransferService::ReadHandle>(readHandle);
+        void BufferMapReadAsync(Buffer* buffer,
+                                bool isRange,
+                                uint64_t offset,
+                                uint64_t size,
+                                DawnBufferMapReadCallback callback,
+                                void* userdata) {
+            uint32_t serial = buffer->requestSerial++;
+            ASSERT(buffer->requests.find(serial) == buffer->requests.end());
+
+            // Create a ReadHandle for the map request. This is the client's intent to read GPU
+            // memory. It only needs to be as large as the range being mapped.
+            MemoryTransferService::ReadHandle* readHandle =
+                buffer->device->GetClient()->GetMemoryTransferService()->CreateReadHandle(
+                    GetMapHandleSize(buffer, offset, size));
+            if (readHandle == nullptr) {
+                callback(DAWN_BUFFER_MAP_ASYNC_STATUS_DEVICE_LOST, nullptr, 0, userdata);
+                return;
+            }
+
+            Buffer::MapRequestData request = {};
+            request.readCallback = callback;
+            request.userdata = userdata;
+            // The handle is owned by the MapRequest until the callback returns.
+            request.readHandle = std::unique_ptr<MemoryTransferService::ReadHandle>(readHandle);
+
+            // Store a mapping from serial -> MapRequest. The client can map/unmap before the map
+            // operations are returned by the server so multiple requests may be in flight.
+            buffer->requests[serial] = std::move(request);
+
+            SerializeBufferMapAsync(buffer, serial, isRange, offset, size, readHandle);
+        }
 
-        // Store a mapping from serial -> MapRequest. The client can map/unmap before the map
-        // operations are returned by the server so multiple requests may be in flight.
-        buffer->requests[serial] = std::move(request);
+        void BufferMapWriteAsync(Buffer* buffer,
+                                 bool isRange,
+                                 uint64_t offset,
+                                 uint64_t size,
+                                 DawnBufferMapWriteCallback callback,
+                                 void* userdata) {
+            uint32_t serial = buffer->requestSerial++;
+            ASSERT(buffer->requests.find(serial) == buffer->requests.end());
+
+            // Create a WriteHandle for the map request. This is the client's intent to write GPU
+            // memory. It only needs to be as large as the range being mapped.
+            MemoryTransferService::WriteHandle* writeHandle =
+                buffer->device->GetClient()->GetMemoryTransferService()->CreateWriteHandle(
+                    GetMapHandleSize(buffer, offset, size));
+            if (writeHandle == nullptr) {
+                callback(DAWN_BUFFER_MAP_ASYNC_STATUS_DEVICE_LOST, nullptr, 0, userdata);
+                return;
+            }
+
+            Buffer::MapRequestData request = {};
+            request.writeCallback = callback;
+            request.userdata = userdata;
+            // The handle is owned by the MapRequest until the callback returns.
+            request.writeHandle = std::unique_ptr<MemoryTransferService::WriteHandle>(writeHandle);
+
+            // Store a mapping from serial -> MapRequest. The client can map/unmap before the map
+            // operations are returned by the server so multiple requests may be in flight.
+            buffer->requests[serial] = std::move(request);
+
+            SerializeBufferMapAsync(buffer, serial, isRange, offset, size, writeHandle);
+        }
+    }  // namespace
 
-        SerializeBufferMapAsync(buffer, serial, readHandle);
+    void ClientBufferMapReadAsync(DawnBuffer cBuffer,
+                                  DawnBufferMapReadCallback callback,
+                                  void* userdata) {
+        Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+        BufferMapReadAsync(buffer, false, 0, buffer->size, callback, userdata);
     }
 
     void ClientBufferMapWriteAsync(DawnBuffer cBuffer,
                                    DawnBufferMapWriteCallback callback,
                                    void* userdata) {
         Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+        BufferMapWriteAsync(buffer, false, 0, buffer->size, callback, userdata);
+    }
 
-        uint32_t serial = buffer->requestSerial++;
-        ASSERT(buffer->requests.find(serial) == buffer->requests.end());
-
-        // Create a WriteHandle for the map request. This is the client's intent to write GPU
-        // memory.
-        MemoryTransferService::WriteHandle* writeHandle =
-            buffer->device->GetClient()->GetMemoryTransferService()->CreateWriteHandle(
-                buffer->size);
-        if (writeHandle == nullptr) {
-            callback(DAWN_BUFFER_MAP_ASYNC_STATUS_DEVICE_LOST, nullptr, 0, userdata);
-            return;
-        }
-
-        Buffer::MapRequestData request = {};
-        request.writeCallback = callback;
-        request.userdata = userdata;
-        // The handle is owned by the MapRequest until the callback returns.
-        request.writeHandle = std::unique_ptr<MemoryTransferService::WriteHandle>(writeHandle);
-
-        // Store a mapping from serial -> MapRequest. The client can map/unmap before the map
-        // operations are returned by the server so multiple requests may be in flight.
-        buffer->requests[serial] = std::move(request);
+    void ClientBufferMapReadRangeAsync(DawnBuffer cBuffer,
+                                       uint64_t offset,
+                                       uint64_t size,
+                                       DawnBufferMapReadCallback callback,
+                                       void* userdata) {
+        Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+        BufferMapReadAsync(buffer, true, offset, size, callback, userdata);
+    }
 
-        SerializeBufferMapAsync(buffer, serial, writeHandle);
+    void ClientBufferMapWriteRangeAsync(DawnBuffer cBuffer,
+                                        uint64_t offset,
+                                        uint64_t size,
+                                        DawnBufferMapWriteCallback callback,
+                                        void* userdata) {
+        Buffer* buffer = reinterpret_cast<Buffer*>(cBuffer);
+        BufferMapWriteAsync(buffer, true, offset, size, callback, userdata);
     }
 
     DawnBuffer ClientDeviceCreateBuffer(DawnDevice cDevice,
@@ -417,6 +495,152 @@ namespace dawn_wire { namespace client {
         cmd.Serialize(allocatedBuffer, *fence->device->GetClient());
     }
 
+    void ClientQueueWriteBuffer(DawnQueue cQueue,
+                                DawnBuffer cBuffer,
+                                uint64_t bufferOffset,
+                                const void* data,
+                                uint64_t size) {
+        Queue* queue = reinterpret_cast<Queue*>(cQueue);
+
+        QueueWriteBufferInternalCmd cmd;
+        cmd.queue = cQueue;
+        cmd.buffer = cBuffer;
+        cmd.bufferOffset = bufferOffset;
+        cmd.size = size;
+        cmd.data = static_cast<const uint8_t*>(data);
+
+        Client* wireClient = queue->device->GetClient();
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *wireClient);
+    }
+
+    void ClientQueueWriteTexture(DawnQueue cQueue,
+                                 const DawnTextureCopyView* destination,
+                                 const void* data,
+                                 uint64_t dataSize,
+                                 const DawnTextureDataLayout* dataLayout,
+                                 const DawnExtent3D* writeSize) {
+        Queue* queue = reinterpret_cast<Queue*>(cQueue);
+
+        QueueWriteTextureInternalCmd cmd;
+        cmd.queue = cQueue;
+        cmd.destination = destination;
+        cmd.dataSize = dataSize;
+        cmd.data = static_cast<const uint8_t*>(data);
+        cmd.dataLayout = dataLayout;
+        cmd.writeSize = writeSize;
+
+        Client* wireClient = queue->device->GetClient();
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *wireClient);
+    }
+
+    void ClientRenderPassEncoderSetPipeline(DawnRenderPassEncoder cSelf,
+                                            DawnRenderPipeline pipeline) {
+        RenderPassEncoder* encoder = reinterpret_cast<RenderPassEncoder*>(cSelf);
+
+        if (encoder->device->GetClient()->IsBatchingRenderPassCommands()) {
+            BatchedSetPipelineCmd record;
+            record.pipelineId =
+                pipeline == nullptr ? 0 : reinterpret_cast<RenderPipeline*>(pipeline)->id;
+            AppendBatchedPassCommand(encoder, BatchedPassCommand::SetPipeline, record);
+            return;
+        }
+
+        RenderPassEncoderSetPipelineCmd cmd;
+        cmd.self = cSelf;
+        cmd.pipeline = pipeline;
+        SerializeRenderPassEncoderCmd(encoder, cmd);
+    }
+
+    void ClientRenderPassEncoderSetBindGroup(DawnRenderPassEncoder cSelf,
+                                             uint32_t groupIndex,
+                                             DawnBindGroup group,
+                                             uint32_t dynamicOffsetCount,
+                                             const uint64_t* dynamicOffsets) {
+        RenderPassEncoder* encoder = reinterpret_cast<RenderPassEncoder*>(cSelf);
+
+        if (encoder->device->GetClient()->IsBatchingRenderPassCommands()) {
+            BatchedSetBindGroupCmd record;
+            record.groupIndex = groupIndex;
+            record.groupId = group == nullptr ? 0 : reinterpret_cast<BindGroup*>(group)->id;
+            record.dynamicOffsetCount = dynamicOffsetCount;
+
+            size_t offsetsSize = dynamicOffsetCount * sizeof(uint64_t);
+            char* offsets = AppendBatchedPassCommand(encoder, BatchedPassCommand::SetBindGroup,
+                                                     record, offsetsSize);
+            if (offsetsSize > 0) {
+                memcpy(offsets, dynamicOffsets, offsetsSize);
+            }
+            return;
+        }
+
+        RenderPassEncoderSetBindGroupCmd cmd;
+        cmd.self = cSelf;
+        cmd.groupIndex = groupIndex;
+        cmd.group = group;
+        cmd.dynamicOffsetCount = dynamicOffsetCount;
+        cmd.dynamicOffsets = dynamicOffsets;
+        SerializeRenderPassEncoderCmd(encoder, cmd);
+    }
+
+    void ClientRenderPassEncoderDraw(DawnRenderPassEncoder cSelf,
+                                     uint32_t vertexCount,
+                                     uint32_t instanceCount,
+                                     uint32_t firstVertex,
+                                     uint32_t firstInstance) {
+        RenderPassEncoder* encoder = reinterpret_cast<RenderPassEncoder*>(cSelf);
+
+        if (encoder->device->GetClient()->IsBatchingRenderPassCommands()) {
+            BatchedDrawCmd record;
+            record.vertexCount = vertexCount;
+            record.instanceCount = instanceCount;
+            record.firstVertex = firstVertex;
+            record.firstInstance = firstInstance;
+            AppendBatchedPassCommand(encoder, BatchedPassCommand::Draw, record);
+            return;
+        }
+
+        RenderPassEncoderDrawCmd cmd;
+        cmd.self = cSelf;
+        cmd.vertexCount = vertexCount;
+        cmd.instanceCount = instanceCount;
+        cmd.firstVertex = firstVertex;
+        cmd.firstInstance = firstInstance;
+        SerializeRenderPassEncoderCmd(encoder, cmd);
+    }
+
+    void ClientRenderPassEncoderDrawIndexed(DawnRenderPassEncoder cSelf,
+                                            uint32_t indexCount,
+                                            uint32_t instanceCount,
+                                            uint32_t firstIndex,
+                                            int32_t baseVertex,
+                                            uint32_t firstInstance) {
+        RenderPassEncoder* encoder = reinterpret_cast<RenderPassEncoder*>(cSelf);
+
+        if (encoder->device->GetClient()->IsBatchingRenderPassCommands()) {
+            BatchedDrawIndexedCmd record;
+            record.indexCount = indexCount;
+            record.instanceCount = instanceCount;
+            record.firstIndex = firstIndex;
+            record.baseVertex = baseVertex;
+            record.firstInstance = firstInstance;
+            AppendBatchedPassCommand(encoder, BatchedPassCommand::DrawIndexed, record);
+            return;
+        }
+
+        RenderPassEncoderDrawIndexedCmd cmd;
+        cmd.self = cSelf;
+        cmd.indexCount = indexCount;
+        cmd.instanceCount = instanceCount;
+        cmd.firstIndex = firstIndex;
+        cmd.baseVertex = baseVertex;
+        cmd.firstInstance = firstInstance;
+        SerializeRenderPassEncoderCmd(encoder, cmd);
+    }
+
     void ClientDeviceReference(DawnDevice) {
     }
 
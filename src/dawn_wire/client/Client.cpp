@@ -13,15 +13,22 @@
 // limitations under the License.
 
 #include "dawn_wire/client/Client.h"
+
+#include "common/Assert.h"
 #include "dawn_wire/client/Device.h"
 
 namespace dawn_wire { namespace client {
 
-    Client::Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService)
+    Client::Client(CommandSerializer* serializer,
+                   MemoryTransferService* memoryTransferService,
+                   bool batchRenderPassCommands,
+                   size_t maxRetainedDeserializationSize)
         : ClientBase(),
           mDevice(DeviceAllocator().New(this)->object.get()),
           mSerializer(serializer),
-          mMemoryTransferService(memoryTransferService) {
+          mAllocator(maxRetainedDeserializationSize),
+          mMemoryTransferService(memoryTransferService),
+          mBatchRenderPassCommands(batchRenderPassCommands) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fall back to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
@@ -44,4 +51,33 @@ namespace dawn_wire { namespace client {
         return result;
     }
 
+    char* Client::GetPassBatchSpace(ObjectId encoderId, size_t size) {
+        ASSERT(mBatchRenderPassCommands);
+        if (!mPassBatch.empty() && mPassBatchEncoderId != encoderId) {
+            FlushPassBatch();
+        }
+        mPassBatchEncoderId = encoderId;
+
+        size_t offset = mPassBatch.size();
+        mPassBatch.resize(offset + size);
+        return mPassBatch.data() + offset;
+    }
+
+    void Client::FlushPassBatch() {
+        ASSERT(!mPassBatch.empty());
+
+        RenderPassEncoderExecuteBatchCmd cmd;
+        cmd.renderPassEncoderId = mPassBatchEncoderId;
+        cmd.batchSize = mPassBatch.size();
+        cmd.batch = reinterpret_cast<const uint8_t*>(mPassBatch.data());
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(mSerializer->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+
+        // Keep the capacity around so that recording the next pass doesn't reallocate.
+        mPassBatch.clear();
+        mPassBatchEncoderId = 0;
+    }
+
 }}  // namespace dawn_wire::client
@@ -23,6 +23,8 @@
 #include "dawn_wire/WireDeserializeAllocator.h"
 #include "dawn_wire/client/ClientBase_autogen.h"
 
+#include <vector>
+
 namespace dawn_wire { namespace client {
 
     class Device;
@@ -30,16 +32,32 @@ namespace dawn_wire { namespace client {
 
     class Client : public ClientBase {
       public:
-        Client(CommandSerializer* serializer, MemoryTransferService* memoryTransferService);
+        Client(CommandSerializer* serializer,
+               MemoryTransferService* memoryTransferService,
+               bool batchRenderPassCommands = false,
+               size_t maxRetainedDeserializationSize =
+                   WireDeserializeAllocator::kDefaultMaxRetainedSize);
         ~Client();
 
         const char* HandleCommands(const char* commands, size_t size);
         ReservedTexture ReserveTexture(DawnDevice device);
 
         void* GetCmdSpace(size_t size) {
+            // Batched pass commands must reach the server before any command recorded after them.
+            if (!mPassBatch.empty()) {
+                FlushPassBatch();
+            }
             return mSerializer->GetCmdSpace(size);
         }
 
+        bool IsBatchingRenderPassCommands() const {
+            return mBatchRenderPassCommands;
+        }
+
+        // Returns |size| bytes at the end of the pending batch of commands for |encoderId|,
+        // flushing the batch of any other encoder first.
+        char* GetPassBatchSpace(ObjectId encoderId, size_t size);
+
         DawnDevice GetDevice() const {
             return reinterpret_cast<DawnDeviceImpl*>(mDevice);
         }
@@ -48,14 +66,24 @@ namespace dawn_wire { namespace client {
             return mMemoryTransferService;
         }
 
+        size_t GetDeserializationHighWaterMark() const {
+            return mAllocator.GetHighWaterMark();
+        }
+
       private:
 #include "dawn_wire/client/ClientPrototypes_autogen.inc"
 
+        void FlushPassBatch();
+
         Device* mDevice = nullptr;
         CommandSerializer* mSerializer = nullptr;
         WireDeserializeAllocator mAllocator;
         MemoryTransferService* mMemoryTransferService = nullptr;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
+
+        bool mBatchRenderPassCommands = false;
+        ObjectId mPassBatchEncoderId = 0;
+        std::vector<char> mPassBatch;
     };
 
     DawnProcTable GetProcs();
@@ -16,7 +16,10 @@
 #define DAWNWIRE_CLIENT_OBJECTALLOCATOR_H_
 
 #include "common/Assert.h"
+#include "dawn_wire/ObjectIdBitSet.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -54,8 +57,8 @@ namespace dawn_wire { namespace client {
                 mObjects.emplace_back(std::move(object), 0);
             } else {
                 ASSERT(mObjects[id].object == nullptr);
-                // TODO(cwallez@chromium.org): investigate if overflows could cause bad things to
-                // happen
+                // IDs are retired before their serial overflows, see Free.
+                ASSERT(mObjects[id].serial < std::numeric_limits<uint32_t>::max());
                 mObjects[id].serial++;
                 mObjects[id].object = std::move(object);
             }
@@ -83,20 +86,32 @@ namespace dawn_wire { namespace client {
 
       private:
         uint32_t GetNewId() {
-            if (mFreeIds.empty()) {
-                return mCurrentId++;
+            // Reuse the smallest free ID so that the IDs in use stay packed at the start of
+            // mObjects and of the server's KnownObjects.
+            uint32_t id;
+            if (mFreeIds.FindFirst(mFirstFreeIdCandidate, &id)) {
+                mFreeIds.Reset(id);
+                mFirstFreeIdCandidate = id + 1;
+                return id;
             }
-            uint32_t id = mFreeIds.back();
-            mFreeIds.pop_back();
-            return id;
+            mFirstFreeIdCandidate = mCurrentId + 1;
+            return mCurrentId++;
         }
         void FreeId(uint32_t id) {
-            mFreeIds.push_back(id);
+            // The server requires the serial to grow each time an ID is reused so an ID whose
+            // serial would overflow is never reused.
+            if (mObjects[id].serial == std::numeric_limits<uint32_t>::max()) {
+                return;
+            }
+            mFreeIds.Set(id);
+            mFirstFreeIdCandidate = std::min(mFirstFreeIdCandidate, id);
         }
 
         // 0 is an ID reserved to represent nullptr
         uint32_t mCurrentId = 1;
-        std::vector<uint32_t> mFreeIds;
+        // There are no free IDs smaller than mFirstFreeIdCandidate.
+        uint32_t mFirstFreeIdCandidate = 1;
+        ObjectIdBitSet mFreeIds;
         std::vector<ObjectAndSerial> mObjects;
         Device* mDevice;
     };
@@ -15,6 +15,8 @@
 #ifndef DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 #define DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 
+#include "common/Assert.h"
+#include "dawn_wire/ObjectIdBitSet.h"
 #include "dawn_wire/WireCmd_autogen.h"
 #include "dawn_wire/WireServer.h"
 
@@ -28,10 +30,6 @@ namespace dawn_wire { namespace server {
         // The backend-provided handle and serial to this object.
         T handle;
         uint32_t serial = 0;
-
-        // Whether this object has been allocated, used by the KnownObjects queries
-        // TODO(cwallez@chromium.org): make this an internal bit vector in KnownObjects.
-        bool allocated;
     };
 
     // Stores what the backend knows about the type.
@@ -60,78 +58,70 @@ namespace dawn_wire { namespace server {
             // KnownObjects for ID 0.
             Data reservation;
             reservation.handle = nullptr;
-            reservation.allocated = false;
             mKnown.push_back(std::move(reservation));
         }
 
         // Get a backend objects for a given client ID.
         // Returns nullptr if the ID hasn't previously been allocated.
         const Data* Get(uint32_t id) const {
-            if (id >= mKnown.size()) {
+            if (!mAllocated.Test(id)) {
                 return nullptr;
             }
-
-            const Data* data = &mKnown[id];
-
-            if (!data->allocated) {
-                return nullptr;
-            }
-
-            return data;
+            return &mKnown[id];
         }
         Data* Get(uint32_t id) {
-            if (id >= mKnown.size()) {
+            if (!mAllocated.Test(id)) {
                 return nullptr;
             }
-
-            Data* data = &mKnown[id];
-
-            if (!data->allocated) {
-                return nullptr;
-            }
-
-            return data;
+            return &mKnown[id];
         }
 
-        // Allocates the data for a given ID and returns it.
-        // Returns nullptr if the ID is already allocated, or too far ahead.
+        // Allocates the data for a given ID and serial and returns it.
+        // Returns nullptr if the ID is already allocated, or too far ahead. The client increments
+        // the serial every time it reuses an ID so a reused ID must have a larger serial than the
+        // previous object with that ID.
         // Invalidates all the Data*
-        Data* Allocate(uint32_t id) {
+        Data* Allocate(uint32_t id, uint32_t serial) {
             if (id > mKnown.size()) {
                 return nullptr;
             }
 
             Data data;
-            data.allocated = true;
             data.handle = nullptr;
+            data.serial = serial;
 
-            if (id >= mKnown.size()) {
+            if (id == mKnown.size()) {
                 mKnown.push_back(std::move(data));
+                mAllocated.Set(id);
                 return &mKnown.back();
             }
 
-            if (mKnown[id].allocated) {
+            if (id == 0 || mAllocated.Test(id) || serial <= mKnown[id].serial) {
                 return nullptr;
             }
 
             mKnown[id] = std::move(data);
+            mAllocated.Set(id);
             return &mKnown[id];
         }
 
-        // Marks an ID as deallocated
+        // Marks an ID as deallocated. The serial is kept to check the next allocation of the ID.
         void Free(uint32_t id) {
-            ASSERT(id < mKnown.size());
-            mKnown[id].allocated = false;
+            ASSERT(mAllocated.Test(id));
+            mAllocated.Reset(id);
         }
 
         std::vector<T> AcquireAllHandles() {
             std::vector<T> objects;
-            for (Data& data : mKnown) {
-                if (data.allocated && data.handle != nullptr) {
+            uint32_t id = 0;
+            while (mAllocated.FindFirst(id, &id)) {
+                Data& data = mKnown[id];
+                if (data.handle != nullptr) {
                     objects.push_back(data.handle);
-                    data.allocated = false;
                     data.handle = nullptr;
                 }
+                mAllocated.Reset(id);
+                id++;
             }
 
             return objects;
@@ -139,6 +129,7 @@ namespace dawn_wire { namespace server {
 
       private:
         std::vector<Data> mKnown;
+        ObjectIdBitSet mAllocated;
     };
 
     // ObjectIds are lost in deserialization. Store the ids of deserialized
@@ -20,18 +20,20 @@ namespace dawn_wire { namespace server {
     Server::Server(DawnDevice device,
                    const DawnProcTable& procs,
                    CommandSerializer* serializer,
-                   MemoryTransferService* memoryTransferService)
-        : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
+                   MemoryTransferService* memoryTransferService,
+                   size_t maxRetainedDeserializationSize)
+        : mSerializer(serializer),
+          mAllocator(maxRetainedDeserializationSize),
+          mProcs(procs),
+          mMemoryTransferService(memoryTransferService) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fallback to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
             mMemoryTransferService = mOwnedMemoryTransferService.get();
         }
         // The client-server knowledge is bootstrapped with device 1.
-        auto* deviceData = DeviceObjects().Allocate(1);
+        auto* deviceData = DeviceObjects().Allocate(1, 0);
         deviceData->handle = device;
-
-        mProcs.deviceSetUncapturedErrorCallback(device, ForwardUncapturedError, this);
     }
 
     Server::~Server() {
@@ -43,14 +45,12 @@ namespace dawn_wire { namespace server {
     }
 
     bool Server::InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation) {
-        ObjectData<DawnTexture>* data = TextureObjects().Allocate(id);
+        ObjectData<DawnTexture>* data = TextureObjects().Allocate(id, generation);
         if (data == nullptr) {
             return false;
         }
 
         data->handle = texture;
-        data->serial = generation;
-        data->allocated = true;
 
         // The texture is externally owned so it shouldn't be destroyed when we receive a destroy
         // message from the client. Add a reference to counterbalance the eventual release.
@@ -59,4 +59,8 @@ namespace dawn_wire { namespace server {
         return true;
     }
 
+    size_t Server::GetDeserializationHighWaterMark() const {
+        return mAllocator.GetHighWaterMark();
+    }
+
 }}  // namespace dawn_wire::server
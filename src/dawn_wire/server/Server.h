@@ -50,18 +50,29 @@ namespace dawn_wire { namespace server {
         Server(DawnDevice device,
                const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService);
+               MemoryTransferService* memoryTransferService,
+               size_t maxRetainedDeserializationSize =
+                   WireDeserializeAllocator::kDefaultMaxRetainedSize);
         ~Server();
 
         const char* HandleCommands(const char* commands, size_t size);
 
+        // Handles at most |maxCommands| commands, advancing |commands| and |size| past them.
+        // Returns false on a fatal error. Unlike HandleCommands, this doesn't tick the device.
+        bool HandleCommandsWithBudget(const char** commands, size_t* size, size_t maxCommands);
+
         bool InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation);
 
+        size_t GetDeserializationHighWaterMark() const;
+
+        // The device's uncaptured error callback is owned by the ServerPool since the device can
+        // be shared between several clients.
+        void OnUncapturedError(DawnErrorType type, const char* message);
+
       private:
         void* GetCmdSpace(size_t size);
 
         // Forwarding callbacks
-        static void ForwardUncapturedError(DawnErrorType type, const char* message, void* userdata);
         static void ForwardPopErrorScope(DawnErrorType type, const char* message, void* userdata);
         static void ForwardBufferMapReadAsync(DawnBufferMapAsyncStatus status,
                                               const void* ptr,
@@ -74,7 +85,6 @@ namespace dawn_wire { namespace server {
         static void ForwardFenceCompletedValue(DawnFenceCompletionStatus status, void* userdata);
 
         // Error callbacks
-        void OnUncapturedError(DawnErrorType type, const char* message);
         void OnDevicePopErrorScope(DawnErrorType type,
                                    const char* message,
                                    ErrorScopeUserdata* userdata);
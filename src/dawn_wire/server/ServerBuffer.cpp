@@ -34,6 +34,9 @@ namespace dawn_wire { namespace server {
     bool Server::DoBufferMapAsync(ObjectId bufferId,
                                   uint32_t requestSerial,
                                   bool isWrite,
+                                  bool isRange,
+                                  uint64_t offset,
+                                  uint64_t size,
                                   uint64_t handleCreateInfoLength,
                                   const uint8_t* handleCreateInfo) {
         // These requests are just forwarded to the buffer, with userdata containing what the
@@ -73,8 +76,13 @@ namespace dawn_wire { namespace server {
 
             userdata->writeHandle =
                 std::unique_ptr<MemoryTransferService::WriteHandle>(writeHandle);
-            mProcs.bufferMapWriteAsync(buffer->handle, ForwardBufferMapWriteAsync,
-                                       userdata.release());
+            if (isRange) {
+                mProcs.bufferMapWriteRangeAsync(buffer->handle, offset, size,
+                                                ForwardBufferMapWriteAsync, userdata.release());
+            } else {
+                mProcs.bufferMapWriteAsync(buffer->handle, ForwardBufferMapWriteAsync,
+                                           userdata.release());
+            }
         } else {
             // Deserialize metadata produced from the client to create a companion server handle.
             MemoryTransferService::ReadHandle* readHandle = nullptr;
@@ -85,8 +93,13 @@ namespace dawn_wire { namespace server {
             ASSERT(readHandle != nullptr);
 
             userdata->readHandle = std::unique_ptr<MemoryTransferService::ReadHandle>(readHandle);
-            mProcs.bufferMapReadAsync(buffer->handle, ForwardBufferMapReadAsync,
-                                      userdata.release());
+            if (isRange) {
+                mProcs.bufferMapReadRangeAsync(buffer->handle, offset, size,
+                                               ForwardBufferMapReadAsync, userdata.release());
+            } else {
+                mProcs.bufferMapReadAsync(buffer->handle, ForwardBufferMapReadAsync,
+                                          userdata.release());
+            }
         }
 
         return true;
@@ -103,11 +116,10 @@ namespace dawn_wire { namespace server {
             return false;
         }
 
-        auto* resultData = BufferObjects().Allocate(bufferResult.id);
+        auto* resultData = BufferObjects().Allocate(bufferResult.id, bufferResult.serial);
         if (resultData == nullptr) {
             return false;
         }
-        resultData->serial = bufferResult.serial;
 
         DawnCreateBufferMappedResult result = mProcs.deviceCreateBufferMapped(device, descriptor);
         ASSERT(result.buffer != nullptr);
@@ -16,11 +16,6 @@
 
 namespace dawn_wire { namespace server {
 
-    void Server::ForwardUncapturedError(DawnErrorType type, const char* message, void* userdata) {
-        auto server = static_cast<Server*>(userdata);
-        server->OnUncapturedError(type, message);
-    }
-
     void Server::OnUncapturedError(DawnErrorType type, const char* message) {
         ReturnDeviceUncapturedErrorCallbackCmd cmd;
         cmd.type = type;
@@ -0,0 +1,215 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/server/ServerPool.h"
+
+#include "common/Assert.h"
+#include "dawn_wire/server/Server.h"
+
+#include <algorithm>
+
+namespace dawn_wire { namespace server {
+
+    ServerPool::ServerPool(const DawnProcTable& procs, uint32_t maxCommandsPerTurn)
+        : mProcs(procs), mMaxCommandsPerTurn(maxCommandsPerTurn) {
+        ASSERT(mMaxCommandsPerTurn > 0);
+    }
+
+    ServerPool::~ServerPool() {
+        // Destroy the servers before the device fan-out they are registered in.
+        mConnections.clear();
+    }
+
+    uint32_t ServerPool::AddClient(const WireServerClientDescriptor& descriptor) {
+        std::unique_ptr<Connection> connection(new Connection);
+        connection->device = descriptor.device;
+        connection->server.reset(new Server(descriptor.device, mProcs, descriptor.serializer,
+                                            descriptor.memoryTransferService,
+                                            descriptor.maxRetainedDeserializationSize));
+
+        std::unique_ptr<DeviceClients>& deviceClients = mDeviceClients[descriptor.device];
+        if (deviceClients == nullptr) {
+            deviceClients.reset(new DeviceClients);
+            mProcs.deviceSetUncapturedErrorCallback(descriptor.device, ForwardUncapturedError,
+                                                    deviceClients.get());
+        }
+        deviceClients->servers.push_back(connection->server.get());
+
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+        uint32_t clientId = mNextClientId++;
+        mConnections[clientId] = std::move(connection);
+        return clientId;
+    }
+
+    void ServerPool::RemoveClient(uint32_t clientId) {
+        std::unique_ptr<Connection> connection;
+        {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            auto it = mConnections.find(clientId);
+            if (it == mConnections.end()) {
+                return;
+            }
+            connection = std::move(it->second);
+            mConnections.erase(it);
+        }
+
+        auto deviceIt = mDeviceClients.find(connection->device);
+        ASSERT(deviceIt != mDeviceClients.end());
+        std::vector<Server*>& servers = deviceIt->second->servers;
+        servers.erase(std::find(servers.begin(), servers.end(), connection->server.get()));
+
+        // Don't leave a dangling callback on a device that outlives all of its clients.
+        if (servers.empty()) {
+            mProcs.deviceSetUncapturedErrorCallback(connection->device, nullptr, nullptr);
+            mDeviceClients.erase(deviceIt);
+        }
+    }
+
+    const char* ServerPool::HandleCommands(uint32_t clientId, const char* commands, size_t size) {
+        Connection* connection = GetConnection(clientId);
+        if (connection == nullptr || connection->lost) {
+            return nullptr;
+        }
+
+        const char* result = connection->server->HandleCommands(commands, size);
+        if (result == nullptr) {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            connection->lost = true;
+        }
+        return result;
+    }
+
+    bool ServerPool::InjectTexture(uint32_t clientId,
+                                   DawnTexture texture,
+                                   uint32_t id,
+                                   uint32_t generation) {
+        Connection* connection = GetConnection(clientId);
+        if (connection == nullptr) {
+            return false;
+        }
+        return connection->server->InjectTexture(texture, id, generation);
+    }
+
+    void ServerPool::QueueCommands(uint32_t clientId, const char* commands, size_t size) {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+
+        auto it = mConnections.find(clientId);
+        if (it == mConnections.end() || it->second->lost) {
+            return;
+        }
+
+        // Commands don't carry their size so chunks can be concatenated and still be parsed.
+        std::vector<char>& queued = it->second->queued;
+        queued.insert(queued.end(), commands, commands + size);
+    }
+
+    bool ServerPool::ProcessQueuedCommands() {
+        // Only handle what was queued before this call so that a client that keeps queueing
+        // commands can't keep us here forever.
+        std::vector<Connection*> pending;
+        {
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            for (auto& it : mConnections) {
+                Connection* connection = it.second.get();
+                if (connection->queued.empty()) {
+                    continue;
+                }
+
+                ASSERT(connection->processing.empty());
+                connection->processing.swap(connection->queued);
+                connection->processingOffset = 0;
+                pending.push_back(connection);
+            }
+        }
+
+        // Tick every device once, including the ones of clients that didn't send commands, so
+        // that their callbacks still complete.
+        for (auto& it : mDeviceClients) {
+            mProcs.deviceTick(it.first);
+        }
+
+        // Round-robin between the clients, each getting at most |mMaxCommandsPerTurn| commands
+        // per turn so a client with a large backlog doesn't starve the others.
+        bool success = true;
+        while (!pending.empty()) {
+            size_t remaining = 0;
+            for (Connection* connection : pending) {
+                if (!HandleTurn(connection)) {
+                    success = false;
+                    continue;
+                }
+                if (connection->processingOffset < connection->processing.size()) {
+                    pending[remaining++] = connection;
+                } else {
+                    connection->processing.clear();
+                }
+            }
+            pending.resize(remaining);
+        }
+
+        return success;
+    }
+
+    bool ServerPool::IsClientLost(uint32_t clientId) const {
+        std::lock_guard<std::mutex> lock(mQueueMutex);
+
+        auto it = mConnections.find(clientId);
+        return it == mConnections.end() || it->second->lost;
+    }
+
+    size_t ServerPool::GetDeserializationHighWaterMark(uint32_t clientId) const {
+        Connection* connection = GetConnection(clientId);
+        if (connection == nullptr) {
+            return 0;
+        }
+        return connection->server->GetDeserializationHighWaterMark();
+    }
+
+    // static
+    void ServerPool::ForwardUncapturedError(DawnErrorType type,
+                                            const char* message,
+                                            void* userdata) {
+        auto* deviceClients = static_cast<DeviceClients*>(userdata);
+        for (Server* server : deviceClients->servers) {
+            server->OnUncapturedError(type, message);
+        }
+    }
+
+    ServerPool::Connection* ServerPool::GetConnection(uint32_t clientId) const {
+        auto it = mConnections.find(clientId);
+        if (it == mConnections.end()) {
+            return nullptr;
+        }
+        return it->second.get();
+    }
+
+    bool ServerPool::HandleTurn(Connection* connection) {
+        const char* commands = connection->processing.data() + connection->processingOffset;
+        size_t size = connection->processing.size() - connection->processingOffset;
+        if (!connection->server->HandleCommandsWithBudget(&commands, &size, mMaxCommandsPerTurn)) {
+            connection->processing.clear();
+            connection->processingOffset = 0;
+
+            // The client is in an unknown state, drop anything else it sent.
+            std::lock_guard<std::mutex> lock(mQueueMutex);
+            connection->lost = true;
+            connection->queued.clear();
+            return false;
+        }
+
+        connection->processingOffset = connection->processing.size() - size;
+        return true;
+    }
+
+}}  // namespace dawn_wire::server
@@ -0,0 +1,84 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNWIRE_SERVER_SERVERPOOL_H_
+#define DAWNWIRE_SERVER_SERVERPOOL_H_
+
+#include "dawn_wire/WireServer.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dawn_wire { namespace server {
+
+    class Server;
+
+    // Hosts one Server per client connection. Each Server has its own KnownObjects so clients
+    // can't name each other's objects, but clients may share a device and its caches.
+    // Everything except QueueCommands must be called on the thread handling the commands.
+    class ServerPool {
+      public:
+        ServerPool(const DawnProcTable& procs, uint32_t maxCommandsPerTurn);
+        ~ServerPool();
+
+        uint32_t AddClient(const WireServerClientDescriptor& descriptor);
+        void RemoveClient(uint32_t clientId);
+
+        const char* HandleCommands(uint32_t clientId, const char* commands, size_t size);
+        bool InjectTexture(uint32_t clientId,
+                           DawnTexture texture,
+                           uint32_t id,
+                           uint32_t generation);
+
+        void QueueCommands(uint32_t clientId, const char* commands, size_t size);
+        bool ProcessQueuedCommands();
+        bool IsClientLost(uint32_t clientId) const;
+        size_t GetDeserializationHighWaterMark(uint32_t clientId) const;
+
+      private:
+        struct Connection {
+            DawnDevice device;
+            std::unique_ptr<Server> server;
+            bool lost = false;
+
+            // Commands queued by QueueCommands, guarded by mQueueMutex.
+            std::vector<char> queued;
+            // Commands taken from |queued| by the current ProcessQueuedCommands.
+            std::vector<char> processing;
+            size_t processingOffset = 0;
+        };
+
+        // Uncaptured errors are per-device so they are broadcast to every client of the device.
+        struct DeviceClients {
+            std::vector<Server*> servers;
+        };
+        static void ForwardUncapturedError(DawnErrorType type, const char* message, void* userdata);
+
+        Connection* GetConnection(uint32_t clientId) const;
+        bool HandleTurn(Connection* connection);
+
+        DawnProcTable mProcs;
+        uint32_t mMaxCommandsPerTurn;
+        uint32_t mNextClientId = 0;
+
+        std::map<uint32_t, std::unique_ptr<Connection>> mConnections;
+        std::map<DawnDevice, std::unique_ptr<DeviceClients>> mDeviceClients;
+        mutable std::mutex mQueueMutex;
+    };
+
+}}  // namespace dawn_wire::server
+
+#endif  // DAWNWIRE_SERVER_SERVERPOOL_H_
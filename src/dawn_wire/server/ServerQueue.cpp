@@ -38,4 +38,33 @@ namespace dawn_wire { namespace server {
         return true;
     }
 
+    bool Server::DoQueueWriteBufferInternal(DawnQueue queue,
+                                            DawnBuffer buffer,
+                                            uint64_t bufferOffset,
+                                            uint64_t size,
+                                            const uint8_t* data) {
+        // The null object isn't valid as `self`
+        if (queue == nullptr) {
+            return false;
+        }
+
+        mProcs.queueWriteBuffer(queue, buffer, bufferOffset, data, size);
+        return true;
+    }
+
+    bool Server::DoQueueWriteTextureInternal(DawnQueue queue,
+                                             const DawnTextureCopyView* destination,
+                                             uint64_t dataSize,
+                                             const uint8_t* data,
+                                             const DawnTextureDataLayout* dataLayout,
+                                             const DawnExtent3D* writeSize) {
+        // The null object isn't valid as `self`
+        if (queue == nullptr) {
+            return false;
+        }
+
+        mProcs.queueWriteTexture(queue, destination, data, dataSize, dataLayout, writeSize);
+        return true;
+    }
+
 }}  // namespace dawn_wire::server
@@ -0,0 +1,147 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Constants.h"
+#include "dawn_wire/PassCommandBatch.h"
+#include "dawn_wire/server/Server.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace dawn_wire { namespace server {
+
+    namespace {
+
+        // Consumes a T from the batch. Returns false if there isn't enough data left.
+        template <typename T>
+        bool ReadBatchRecord(const uint8_t** batch, size_t* size, T* out) {
+            if (*size < sizeof(T)) {
+                return false;
+            }
+            memcpy(out, *batch, sizeof(T));
+            *batch += sizeof(T);
+            *size -= sizeof(T);
+            return true;
+        }
+
+    }  // anonymous namespace
+
+    bool Server::DoRenderPassEncoderExecuteBatch(ObjectId renderPassEncoderId,
+                                                 uint64_t batchSize,
+                                                 const uint8_t* batch) {
+        auto* encoder = RenderPassEncoderObjects().Get(renderPassEncoderId);
+        if (encoder == nullptr) {
+            return false;
+        }
+
+        if (batchSize > std::numeric_limits<size_t>::max()) {
+            // This is the size of data deserialized from the command stream, which must be
+            // CPU-addressable.
+            return false;
+        }
+        size_t size = static_cast<size_t>(batchSize);
+
+        // Dynamic offsets are copied out of the batch because the records aren't aligned. Valid
+        // calls never have more than kMaxBindingsPerGroup offsets so only larger, invalid, calls
+        // need to go through the heap before being rejected by the backend.
+        std::array<uint64_t, kMaxBindingsPerGroup> dynamicOffsets;
+        std::vector<uint64_t> largeDynamicOffsets;
+
+        // Objects are resolved like the generated handlers do for the unbatched commands so that
+        // batching doesn't change which ids are fatal errors.
+        const ObjectIdResolver& resolver = *this;
+
+        while (size > 0) {
+            BatchedPassCommand command;
+            if (!ReadBatchRecord(&batch, &size, &command)) {
+                return false;
+            }
+
+            switch (command) {
+                case BatchedPassCommand::SetPipeline: {
+                    BatchedSetPipelineCmd cmd;
+                    if (!ReadBatchRecord(&batch, &size, &cmd)) {
+                        return false;
+                    }
+
+                    DawnRenderPipeline pipeline;
+                    if (resolver.GetFromId(cmd.pipelineId, &pipeline) !=
+                        DeserializeResult::Success) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderSetPipeline(encoder->handle, pipeline);
+                } break;
+
+                case BatchedPassCommand::SetBindGroup: {
+                    BatchedSetBindGroupCmd cmd;
+                    if (!ReadBatchRecord(&batch, &size, &cmd)) {
+                        return false;
+                    }
+
+                    DawnBindGroup group;
+                    if (resolver.GetFromId(cmd.groupId, &group) != DeserializeResult::Success) {
+                        return false;
+                    }
+
+                    size_t offsetsSize = size_t(cmd.dynamicOffsetCount) * sizeof(uint64_t);
+                    if (offsetsSize > size) {
+                        return false;
+                    }
+
+                    uint64_t* offsets = dynamicOffsets.data();
+                    if (cmd.dynamicOffsetCount > dynamicOffsets.size()) {
+                        largeDynamicOffsets.resize(cmd.dynamicOffsetCount);
+                        offsets = largeDynamicOffsets.data();
+                    }
+                    if (offsetsSize > 0) {
+                        memcpy(offsets, batch, offsetsSize);
+                    }
+                    batch += offsetsSize;
+                    size -= offsetsSize;
+
+                    mProcs.renderPassEncoderSetBindGroup(encoder->handle, cmd.groupIndex, group,
+                                                         cmd.dynamicOffsetCount, offsets);
+                } break;
+
+                case BatchedPassCommand::Draw: {
+                    BatchedDrawCmd cmd;
+                    if (!ReadBatchRecord(&batch, &size, &cmd)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderDraw(encoder->handle, cmd.vertexCount,
+                                                 cmd.instanceCount, cmd.firstVertex,
+                                                 cmd.firstInstance);
+                } break;
+
+                case BatchedPassCommand::DrawIndexed: {
+                    BatchedDrawIndexedCmd cmd;
+                    if (!ReadBatchRecord(&batch, &size, &cmd)) {
+                        return false;
+                    }
+                    mProcs.renderPassEncoderDrawIndexed(encoder->handle, cmd.indexCount,
+                                                        cmd.instanceCount, cmd.firstIndex,
+                                                        cmd.baseVertex, cmd.firstInstance);
+                } break;
+
+                default:
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+}}  // namespace dawn_wire::server
@@ -159,6 +159,18 @@ namespace dawn_native {
 
     // Backdoor to get the number of lazy clears for testing
     DAWN_NATIVE_EXPORT size_t GetLazyClearCountForTesting(DawnDevice device);
+
+    // Backdoor to get the number of lazy clears of buffers for testing
+    DAWN_NATIVE_EXPORT size_t GetBufferLazyClearCountForTesting(DawnDevice device);
+
+    // Backdoor to get the number of commands removed by the eliminate_redundant_commands toggle
+    DAWN_NATIVE_EXPORT size_t GetRemovedCommandCountForTesting(DawnDevice device);
+
+    // Blocks until |fence| completes |value| or until |timeoutNs| nanoseconds passed, and returns
+    // whether it completed. The device of the fence is ticked when the value completes so that
+    // the OnCompletion callbacks are called before this returns. Returns false immediately for
+    // values that aren't signaled yet.
+    DAWN_NATIVE_EXPORT bool WaitForFence(DawnFence fence, uint64_t value, uint64_t timeoutNs);
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_DAWNNATIVE_H_
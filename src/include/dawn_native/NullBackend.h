@@ -18,8 +18,28 @@
 #include <dawn/dawn_wsi.h>
 #include <dawn_native/DawnNative.h>
 
+#include <cstdint>
+
 namespace dawn_native { namespace null {
+
+    // The model of the time the simulated GPU of a null device takes to complete the serials it
+    // is submitted. Each submit is executed after the ones before it, and no earlier than
+    // |latencyNs| after it was submitted. Its execution takes |costPerSubmitNs| plus the time to
+    // transfer the bytes of its uploads, copies and map operations at |bytesPerSecond|, where 0
+    // means the transfers are instantaneous.
+    struct GpuTimelineModel {
+        uint64_t latencyNs = 0;
+        uint64_t costPerSubmitNs = 0;
+        uint64_t bytesPerSecond = 0;
+    };
+
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl();
+
+    // Sets the model used for the serials submitted after this call. It only has an effect on
+    // devices with the use_progress_thread toggle, for which the progress thread completes the
+    // serials at the times computed from the model.
+    DAWN_NATIVE_EXPORT void SetGpuTimelineModel(DawnDevice device, const GpuTimelineModel& model);
+
 }}  // namespace dawn_native::null
 
 #endif  // DAWNNATIVE_NULLBACKEND_H_
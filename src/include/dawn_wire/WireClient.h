@@ -35,6 +35,13 @@ namespace dawn_wire {
     struct DAWN_WIRE_EXPORT WireClientDescriptor {
         CommandSerializer* serializer;
         client::MemoryTransferService* memoryTransferService = nullptr;
+        // When true, SetPipeline, SetBindGroup, Draw and DrawIndexed on render pass encoders are
+        // recorded client-side and sent in a single batch command when any other command is
+        // serialized (at the latest on EndPass).
+        bool batchRenderPassCommands = false;
+        // The largest chunk of the memory used to deserialize commands that is kept between
+        // commands instead of being freed.
+        size_t maxRetainedDeserializationSize = 1024 * 1024;
     };
 
     class DAWN_WIRE_EXPORT WireClient : public CommandHandler {
@@ -48,6 +55,9 @@ namespace dawn_wire {
 
         ReservedTexture ReserveTexture(DawnDevice device);
 
+        // The largest amount of memory used to deserialize a single command from the server.
+        size_t GetDeserializationHighWaterMark() const;
+
       private:
         std::unique_ptr<client::Client> mImpl;
     };
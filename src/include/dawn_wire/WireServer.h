@@ -22,15 +22,33 @@
 namespace dawn_wire {
 
     namespace server {
-        class Server;
+        class ServerPool;
         class MemoryTransferService;
     }
 
     struct DAWN_WIRE_EXPORT WireServerDescriptor {
+        // If |device| is null, no default client is created and clients must be added with
+        // WireServer::AddClient.
         DawnDevice device;
         const DawnProcTable* procs;
         CommandSerializer* serializer;
         server::MemoryTransferService* memoryTransferService = nullptr;
+        // The largest chunk of the memory used to deserialize commands that is kept between
+        // commands instead of being freed, for the default client.
+        size_t maxRetainedDeserializationSize = 1024 * 1024;
+        // The maximum number of commands handled for a client before moving on to the next one
+        // in WireServer::ProcessQueuedCommands.
+        uint32_t maxCommandsPerTurn = 256;
+    };
+
+    struct DAWN_WIRE_EXPORT WireServerClientDescriptor {
+        // Clients may share a device, in which case uncaptured errors are sent to all of them.
+        DawnDevice device;
+        CommandSerializer* serializer;
+        server::MemoryTransferService* memoryTransferService = nullptr;
+        // The largest chunk of the memory used to deserialize commands that is kept between
+        // commands instead of being freed.
+        size_t maxRetainedDeserializationSize = 1024 * 1024;
     };
 
     class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -38,12 +56,39 @@ namespace dawn_wire {
         WireServer(const WireServerDescriptor& descriptor);
         ~WireServer();
 
+        // The client created for WireServerDescriptor::device.
+        static constexpr uint32_t kDefaultClientId = 0;
+
         const char* HandleCommands(const char* commands, size_t size) override final;
 
         bool InjectTexture(DawnTexture texture, uint32_t id, uint32_t generation);
 
+        // Each client has its own object namespace and can't access objects of other clients.
+        uint32_t AddClient(const WireServerClientDescriptor& descriptor);
+        void RemoveClient(uint32_t clientId);
+
+        const char* HandleCommands(uint32_t clientId, const char* commands, size_t size);
+        bool InjectTexture(uint32_t clientId,
+                           DawnTexture texture,
+                           uint32_t id,
+                           uint32_t generation);
+
+        // Queue commands to be handled by the next ProcessQueuedCommands. This is the only method
+        // that can be called from other threads.
+        void QueueCommands(uint32_t clientId, const char* commands, size_t size);
+        // Handles the queued commands of all clients in a round-robin fashion. Returns false if
+        // handling the commands of a client failed, after which that client is lost.
+        bool ProcessQueuedCommands();
+        bool IsClientLost(uint32_t clientId) const;
+
+        // The largest amount of memory used to deserialize a single command of the client, which
+        // can be used to choose the maximum retained deserialization size. Returns 0 for clients
+        // that don't exist.
+        size_t GetDeserializationHighWaterMark() const;
+        size_t GetDeserializationHighWaterMark(uint32_t clientId) const;
+
       private:
-        std::unique_ptr<server::Server> mImpl;
+        std::unique_ptr<server::ServerPool> mImpl;
     };
 
     namespace server {
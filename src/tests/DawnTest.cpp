@@ -81,6 +81,7 @@ namespace {
 
 const DawnTestParam D3D12Backend(dawn_native::BackendType::D3D12);
 const DawnTestParam MetalBackend(dawn_native::BackendType::Metal);
+const DawnTestParam NullBackend(dawn_native::BackendType::Null);
 const DawnTestParam OpenGLBackend(dawn_native::BackendType::OpenGL);
 const DawnTestParam VulkanBackend(dawn_native::BackendType::Vulkan);
 
@@ -167,6 +168,7 @@ void DawnTestEnvironment::SetUp() {
     static constexpr dawn_native::BackendType kWindowlessBackends[] = {
         dawn_native::BackendType::D3D12,
         dawn_native::BackendType::Metal,
+        dawn_native::BackendType::Null,
         dawn_native::BackendType::Vulkan,
     };
     for (dawn_native::BackendType backend : kWindowlessBackends) {
@@ -283,6 +285,10 @@ bool DawnTestBase::IsMetal() const {
     return mParam.backendType == dawn_native::BackendType::Metal;
 }
 
+bool DawnTestBase::IsNull() const {
+    return mParam.backendType == dawn_native::BackendType::Null;
+}
+
 bool DawnTestBase::IsOpenGL() const {
     return mParam.backendType == dawn_native::BackendType::OpenGL;
 }
@@ -359,6 +365,10 @@ std::vector<const char*> DawnTestBase::GetRequiredExtensions() {
     return {};
 }
 
+bool DawnTestBase::BatchRenderPassCommandsOverWire() {
+    return false;
+}
+
 // This function can only be called after SetUp() because it requires mBackendAdapter to be
 // initialized.
 bool DawnTestBase::SupportsExtensions(const std::vector<const char*>& extensions) {
@@ -445,6 +455,7 @@ void DawnTestBase::SetUp() {
 
         dawn_wire::WireClientDescriptor clientDesc = {};
         clientDesc.serializer = mC2sBuf.get();
+        clientDesc.batchRenderPassCommands = BatchRenderPassCommandsOverWire();
 
         mWireClient.reset(new dawn_wire::WireClient(clientDesc));
         DawnDevice clientDevice = mWireClient->GetDevice();
@@ -704,6 +715,9 @@ namespace detail {
 #if defined(DAWN_ENABLE_BACKEND_METAL)
             case dawn_native::BackendType::Metal:
 #endif
+#if defined(DAWN_ENABLE_BACKEND_NULL)
+            case dawn_native::BackendType::Null:
+#endif
 #if defined(DAWN_ENABLE_BACKEND_OPENGL)
             case dawn_native::BackendType::OpenGL:
 #endif
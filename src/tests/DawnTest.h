@@ -56,6 +56,16 @@
         EXPECT_EQ(N, lazyClearsAfter - lazyClearsBefore);                                 \
     }
 
+#define EXPECT_BUFFER_LAZY_CLEAR(N, statement)                                                  \
+    if (UsesWire()) {                                                                           \
+        statement;                                                                              \
+    } else {                                                                                    \
+        size_t lazyClearsBefore = dawn_native::GetBufferLazyClearCountForTesting(device.Get()); \
+        statement;                                                                              \
+        size_t lazyClearsAfter = dawn_native::GetBufferLazyClearCountForTesting(device.Get());  \
+        EXPECT_EQ(N, lazyClearsAfter - lazyClearsBefore);                                       \
+    }
+
 // Should only be used to test validation of function that can't be tested by regular validation
 // tests;
 #define ASSERT_DEVICE_ERROR(statement) \
@@ -91,6 +101,7 @@ std::ostream& operator<<(std::ostream& os, const DawnTestParam& param);
 // Shorthands for backend types used in the DAWN_INSTANTIATE_TEST
 extern const DawnTestParam D3D12Backend;
 extern const DawnTestParam MetalBackend;
+extern const DawnTestParam NullBackend;
 extern const DawnTestParam OpenGLBackend;
 extern const DawnTestParam VulkanBackend;
 
@@ -151,6 +162,7 @@ class DawnTestBase {
 
     bool IsD3D12() const;
     bool IsMetal() const;
+    bool IsNull() const;
     bool IsOpenGL() const;
     bool IsVulkan() const;
 
@@ -211,6 +223,10 @@ class DawnTestBase {
     // code path to handle the situation when not all extensions are supported.
     virtual std::vector<const char*> GetRequiredExtensions();
 
+    // Called in SetUp() when running through the wire to choose whether the wire client batches
+    // render pass encoder commands.
+    virtual bool BatchRenderPassCommandsOverWire();
+
   private:
     DawnTestParam mParam;
 
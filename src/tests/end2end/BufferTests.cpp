@@ -38,6 +38,18 @@ class BufferMapReadTests : public DawnTest {
           return mappedData;
       }
 
+      const void* MapReadRangeAsyncAndWait(const dawn::Buffer& buffer,
+                                           uint64_t offset,
+                                           uint64_t size) {
+          buffer.MapReadRangeAsync(offset, size, MapReadCallback, this);
+
+          while (mappedData == nullptr) {
+              WaitABit();
+          }
+
+          return mappedData;
+      }
+
     private:
         const void* mappedData = nullptr;
 };
@@ -79,7 +91,36 @@ TEST_P(BufferMapReadTests, LargeRead) {
     buffer.Unmap();
 }
 
-DAWN_INSTANTIATE_TEST(BufferMapReadTests, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+// Test mapping a range in the middle of a large buffer for reading.
+TEST_P(BufferMapReadTests, ReadRange) {
+    constexpr uint32_t kDataSize = 1000 * 1000;
+    std::vector<uint32_t> myData;
+    for (uint32_t i = 0; i < kDataSize; ++i) {
+        myData.push_back(i);
+    }
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = static_cast<uint32_t>(kDataSize * sizeof(uint32_t));
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst;
+    dawn::Buffer buffer = device.CreateBuffer(&descriptor);
+
+    buffer.SetSubData(0, kDataSize * sizeof(uint32_t), myData.data());
+
+    constexpr uint32_t kRangeStart = 1234;
+    constexpr uint32_t kRangeSize = 16;
+    const void* mappedData = MapReadRangeAsyncAndWait(buffer, kRangeStart * sizeof(uint32_t),
+                                                      kRangeSize * sizeof(uint32_t));
+    ASSERT_EQ(0, memcmp(mappedData, myData.data() + kRangeStart, kRangeSize * sizeof(uint32_t)));
+
+    buffer.Unmap();
+}
+
+DAWN_INSTANTIATE_TEST(BufferMapReadTests,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
 
 class BufferMapWriteTests : public DawnTest {
     protected:
@@ -107,6 +148,22 @@ class BufferMapWriteTests : public DawnTest {
           return resultPointer;
       }
 
+      void* MapWriteRangeAsyncAndWait(const dawn::Buffer& buffer,
+                                      uint64_t offset,
+                                      uint64_t size) {
+          buffer.MapWriteRangeAsync(offset, size, MapWriteCallback, this);
+
+          while (mappedData == nullptr) {
+              WaitABit();
+          }
+
+          // Ensure the prior write's status is updated.
+          void* resultPointer = mappedData;
+          mappedData = nullptr;
+
+          return resultPointer;
+      }
+
     private:
         void* mappedData = nullptr;
 };
@@ -146,6 +203,21 @@ TEST_P(BufferMapWriteTests, LargeWrite) {
     EXPECT_BUFFER_U32_RANGE_EQ(myData.data(), buffer, 0, kDataSize);
 }
 
+// Test mapping a range in the middle of a buffer for writing.
+TEST_P(BufferMapWriteTests, WriteRange) {
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 16;
+    descriptor.usage = dawn::BufferUsage::MapWrite | dawn::BufferUsage::CopySrc;
+    dawn::Buffer buffer = device.CreateBuffer(&descriptor);
+
+    uint32_t myData = 2934875;
+    void* mappedData = MapWriteRangeAsyncAndWait(buffer, 8, sizeof(myData));
+    memcpy(mappedData, &myData, sizeof(myData));
+    buffer.Unmap();
+
+    EXPECT_BUFFER_U32_EQ(myData, buffer, 8);
+}
+
 // Stress test mapping many buffers.
 TEST_P(BufferMapWriteTests, ManyWrites) {
     constexpr uint32_t kDataSize = 1000;
@@ -175,7 +247,12 @@ TEST_P(BufferMapWriteTests, ManyWrites) {
     }
 }
 
-DAWN_INSTANTIATE_TEST(BufferMapWriteTests, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+DAWN_INSTANTIATE_TEST(BufferMapWriteTests,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
 
 class BufferSetSubDataTests : public DawnTest {
 };
@@ -254,10 +331,11 @@ TEST_P(BufferSetSubDataTests, LargeSetSubData) {
 }
 
 DAWN_INSTANTIATE_TEST(BufferSetSubDataTests,
-                     D3D12Backend,
-                     MetalBackend,
-                     OpenGLBackend,
-                     VulkanBackend);
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
 
 // TODO(enga): These tests should use the testing toggle to initialize resources to 1.
 class CreateBufferMappedTests : public DawnTest {
@@ -630,5 +708,6 @@ TEST_P(CreateBufferMappedTests, CreateThenMapBeforeUnmapFailureAsync) {
 DAWN_INSTANTIATE_TEST(CreateBufferMappedTests,
                       D3D12Backend,
                       MetalBackend,
+                      NullBackend,
                       OpenGLBackend,
                       VulkanBackend);
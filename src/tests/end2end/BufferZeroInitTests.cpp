@@ -0,0 +1,349 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "utils/DawnHelpers.h"
+
+#include <vector>
+
+class BufferZeroInitTest : public DawnTest {
+  protected:
+    dawn::Buffer CreateBuffer(uint64_t size,
+                              dawn::BufferUsage usage = dawn::BufferUsage::CopySrc |
+                                                        dawn::BufferUsage::CopyDst) {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    dawn::Texture CreateTexture(uint32_t width, uint32_t height) {
+        dawn::TextureDescriptor descriptor;
+        descriptor.size = {width, height, 1};
+        descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+        descriptor.usage = dawn::TextureUsage::CopySrc | dawn::TextureUsage::CopyDst;
+        return device.CreateTexture(&descriptor);
+    }
+
+    static std::vector<uint32_t> GetData(uint32_t count, uint32_t firstValue = 1) {
+        std::vector<uint32_t> data(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            data[i] = firstValue + i;
+        }
+        return data;
+    }
+
+    static void MapCallback(DawnBufferMapAsyncStatus status,
+                            const void* data,
+                            uint64_t,
+                            void* userdata) {
+        ASSERT_EQ(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, status);
+        ASSERT_NE(nullptr, data);
+        *static_cast<const void**>(userdata) = data;
+    }
+
+    static void MapWriteCallback(DawnBufferMapAsyncStatus status,
+                                 void* data,
+                                 uint64_t dataLength,
+                                 void* userdata) {
+        MapCallback(status, data, dataLength, userdata);
+    }
+
+    const void* WaitForMappedData(const void* const* mappedData) {
+        while (*mappedData == nullptr) {
+            WaitABit();
+        }
+        return *mappedData;
+    }
+};
+
+// Test that a SetSubData of the whole buffer doesn't clear it.
+TEST_P(BufferZeroInitTest, SetSubDataWholeBuffer) {
+    constexpr uint32_t kCount = 16;
+    dawn::Buffer buffer = CreateBuffer(kCount * sizeof(uint32_t));
+
+    std::vector<uint32_t> data = GetData(kCount);
+    EXPECT_BUFFER_LAZY_CLEAR(0u, buffer.SetSubData(0, kCount * sizeof(uint32_t), data.data()));
+
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), buffer, 0, kCount);
+}
+
+// Test that a partial SetSubData clears the buffer once, and that the rest of the buffer is zero.
+TEST_P(BufferZeroInitTest, SetSubDataPartial) {
+    dawn::Buffer buffer = CreateBuffer(16);
+
+    uint32_t value = 42;
+    EXPECT_BUFFER_LAZY_CLEAR(1u, buffer.SetSubData(4, sizeof(value), &value));
+    EXPECT_BUFFER_LAZY_CLEAR(0u, buffer.SetSubData(12, sizeof(value), &value));
+
+    uint32_t expected[4] = {0, 42, 0, 42};
+    EXPECT_BUFFER_U32_RANGE_EQ(expected, buffer, 0, 4);
+}
+
+// Test that Queue::WriteBuffer only clears the buffer when it doesn't write all of it.
+TEST_P(BufferZeroInitTest, QueueWriteBuffer) {
+    dawn::Queue queue = device.CreateQueue();
+    std::vector<uint32_t> data = GetData(4);
+
+    dawn::Buffer wholeBuffer = CreateBuffer(16);
+    EXPECT_BUFFER_LAZY_CLEAR(0u, queue.WriteBuffer(wholeBuffer, 0, data.data(), 16));
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), wholeBuffer, 0, 4);
+
+    dawn::Buffer partialBuffer = CreateBuffer(16);
+    EXPECT_BUFFER_LAZY_CLEAR(1u, queue.WriteBuffer(partialBuffer, 8, data.data(), 8));
+    uint32_t expected[4] = {0, 0, 1, 2};
+    EXPECT_BUFFER_U32_RANGE_EQ(expected, partialBuffer, 0, 4);
+}
+
+// Test that CreateBufferMapped doesn't clear the buffer.
+TEST_P(BufferZeroInitTest, CreateBufferMapped) {
+    constexpr uint32_t kCount = 16;
+    std::vector<uint32_t> data = GetData(kCount);
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = kCount * sizeof(uint32_t);
+    descriptor.usage = dawn::BufferUsage::CopySrc;
+
+    dawn::Buffer buffer;
+    EXPECT_BUFFER_LAZY_CLEAR(0u, {
+        dawn::CreateBufferMappedResult result = device.CreateBufferMapped(&descriptor);
+        memcpy(result.data, data.data(), kCount * sizeof(uint32_t));
+        result.buffer.Unmap();
+        buffer = result.buffer;
+    });
+
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), buffer, 0, kCount);
+}
+
+// Test that a buffer to buffer copy only clears the destination when it doesn't write all of it.
+TEST_P(BufferZeroInitTest, CopyBufferToBuffer) {
+    std::vector<uint32_t> data = GetData(4);
+    dawn::Buffer source = CreateBuffer(16);
+    source.SetSubData(0, 16, data.data());
+
+    {
+        dawn::Buffer destination = CreateBuffer(16);
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(source, 0, destination, 0, 16);
+        dawn::CommandBuffer commands = encoder.Finish();
+        EXPECT_BUFFER_LAZY_CLEAR(0u, queue.Submit(1, &commands));
+
+        EXPECT_BUFFER_U32_RANGE_EQ(data.data(), destination, 0, 4);
+    }
+
+    {
+        dawn::Buffer destination = CreateBuffer(16);
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(source, 0, destination, 4, 8);
+        dawn::CommandBuffer commands = encoder.Finish();
+        EXPECT_BUFFER_LAZY_CLEAR(1u, queue.Submit(1, &commands));
+
+        uint32_t expected[4] = {0, 1, 2, 0};
+        EXPECT_BUFFER_U32_RANGE_EQ(expected, destination, 0, 4);
+    }
+}
+
+// Test that an uninitialized buffer used as the source of a copy is cleared.
+TEST_P(BufferZeroInitTest, CopyFromUninitializedBuffer) {
+    dawn::Buffer source = CreateBuffer(16);
+    dawn::Buffer destination = CreateBuffer(16);
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 16);
+    dawn::CommandBuffer commands = encoder.Finish();
+    EXPECT_BUFFER_LAZY_CLEAR(1u, queue.Submit(1, &commands));
+
+    uint32_t expected[4] = {0, 0, 0, 0};
+    EXPECT_BUFFER_U32_RANGE_EQ(expected, destination, 0, 4);
+}
+
+// Test that a buffer used before being overwritten in the same command buffer is cleared.
+TEST_P(BufferZeroInitTest, UseBeforeOverwrite) {
+    std::vector<uint32_t> data = GetData(4);
+    dawn::Buffer source = CreateBuffer(16);
+    source.SetSubData(0, 16, data.data());
+
+    dawn::Buffer buffer = CreateBuffer(16);
+    dawn::Buffer readback = CreateBuffer(16);
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(buffer, 0, readback, 0, 16);
+    encoder.CopyBufferToBuffer(source, 0, buffer, 0, 16);
+    dawn::CommandBuffer commands = encoder.Finish();
+    EXPECT_BUFFER_LAZY_CLEAR(1u, queue.Submit(1, &commands));
+
+    uint32_t expected[4] = {0, 0, 0, 0};
+    EXPECT_BUFFER_U32_RANGE_EQ(expected, readback, 0, 4);
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), buffer, 0, 4);
+}
+
+// Test that a texture to buffer copy only clears the destination when it doesn't write all of it.
+TEST_P(BufferZeroInitTest, CopyTextureToBuffer) {
+    constexpr uint32_t kWidth = 4;
+    constexpr uint32_t kHeight = 3;
+    dawn::Texture texture = CreateTexture(kWidth, kHeight);
+
+    std::vector<uint32_t> data = GetData(kWidth * kHeight);
+    dawn::Buffer source = CreateBuffer(kWidth * kHeight * sizeof(uint32_t));
+    source.SetSubData(0, kWidth * kHeight * sizeof(uint32_t), data.data());
+    {
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::BufferCopyView bufferCopyView = utils::CreateBufferCopyView(source, 0, 0, 0);
+        dawn::TextureCopyView textureCopyView =
+            utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+        dawn::Extent3D copySize = {kWidth, kHeight, 1};
+        encoder.CopyBufferToTexture(&bufferCopyView, &textureCopyView, &copySize);
+        dawn::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    // Tightly packed rows write all of the buffer.
+    {
+        dawn::Buffer destination = CreateBuffer(kWidth * kHeight * sizeof(uint32_t));
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::TextureCopyView textureCopyView =
+            utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+        dawn::BufferCopyView bufferCopyView = utils::CreateBufferCopyView(destination, 0, 0, 0);
+        dawn::Extent3D copySize = {kWidth, kHeight, 1};
+        encoder.CopyTextureToBuffer(&textureCopyView, &bufferCopyView, &copySize);
+        dawn::CommandBuffer commands = encoder.Finish();
+        EXPECT_BUFFER_LAZY_CLEAR(0u, queue.Submit(1, &commands));
+
+        EXPECT_BUFFER_U32_RANGE_EQ(data.data(), destination, 0, kWidth * kHeight);
+    }
+
+    // Padded rows leave gaps that must be zero.
+    {
+        constexpr uint32_t kRowPitch = (kWidth + 2) * sizeof(uint32_t);
+        dawn::Buffer destination = CreateBuffer(kRowPitch * kHeight);
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::TextureCopyView textureCopyView =
+            utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+        dawn::BufferCopyView bufferCopyView =
+            utils::CreateBufferCopyView(destination, 0, kRowPitch, 0);
+        dawn::Extent3D copySize = {kWidth, kHeight, 1};
+        encoder.CopyTextureToBuffer(&textureCopyView, &bufferCopyView, &copySize);
+        dawn::CommandBuffer commands = encoder.Finish();
+        EXPECT_BUFFER_LAZY_CLEAR(1u, queue.Submit(1, &commands));
+
+        std::vector<uint32_t> expected((kWidth + 2) * kHeight, 0);
+        for (uint32_t y = 0; y < kHeight; ++y) {
+            for (uint32_t x = 0; x < kWidth; ++x) {
+                expected[y * (kWidth + 2) + x] = data[y * kWidth + x];
+            }
+        }
+        EXPECT_BUFFER_U32_RANGE_EQ(expected.data(), destination, 0, expected.size());
+    }
+}
+
+// Test that mapping an uninitialized buffer clears it.
+TEST_P(BufferZeroInitTest, MapUninitializedBuffer) {
+    {
+        dawn::Buffer buffer =
+            CreateBuffer(16, dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst);
+        const void* mappedData = nullptr;
+        EXPECT_BUFFER_LAZY_CLEAR(1u, buffer.MapReadAsync(MapCallback, &mappedData));
+
+        const uint32_t* data = static_cast<const uint32_t*>(WaitForMappedData(&mappedData));
+        for (uint32_t i = 0; i < 4; ++i) {
+            EXPECT_EQ(0u, data[i]);
+        }
+        buffer.Unmap();
+    }
+
+    {
+        dawn::Buffer buffer =
+            CreateBuffer(16, dawn::BufferUsage::MapWrite | dawn::BufferUsage::CopySrc);
+        const void* mappedData = nullptr;
+        EXPECT_BUFFER_LAZY_CLEAR(1u, buffer.MapWriteAsync(MapWriteCallback, &mappedData));
+
+        uint32_t* data =
+            static_cast<uint32_t*>(const_cast<void*>(WaitForMappedData(&mappedData)));
+        data[1] = 42;
+        buffer.Unmap();
+
+        uint32_t expected[4] = {0, 42, 0, 0};
+        EXPECT_BUFFER_U32_RANGE_EQ(expected, buffer, 0, 4);
+    }
+}
+
+// Test that buffers without the CopyDst usage are cleared when they are used in a compute pass.
+TEST_P(BufferZeroInitTest, StorageBufferWithoutCopyDst) {
+    dawn::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {
+                    {0, dawn::ShaderStage::Compute, dawn::BindingType::StorageBuffer},
+                    {1, dawn::ShaderStage::Compute, dawn::BindingType::StorageBuffer},
+                });
+
+    dawn::ShaderModule module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+        #version 450
+        layout(local_size_x = 4) in;
+        layout(std430, set = 0, binding = 0) buffer Src { uint src[4]; };
+        layout(std430, set = 0, binding = 1) buffer Dst { uint dst[4]; };
+        void main() {
+            dst[gl_LocalInvocationID.x] = src[gl_LocalInvocationID.x] + 1u;
+        })");
+
+    dawn::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.layout = utils::MakeBasicPipelineLayout(device, &bgl);
+    pipelineDescriptor.computeStage.module = module;
+    pipelineDescriptor.computeStage.entryPoint = "main";
+    dawn::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    dawn::Buffer source = CreateBuffer(16, dawn::BufferUsage::Storage);
+    dawn::Buffer destination =
+        CreateBuffer(16, dawn::BufferUsage::Storage | dawn::BufferUsage::CopySrc);
+    dawn::BindGroup bindGroup =
+        utils::MakeBindGroup(device, bgl, {{0, source, 0, 16}, {1, destination, 0, 16}});
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    dawn::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup, 0, nullptr);
+    pass.Dispatch(1, 1, 1);
+    pass.EndPass();
+    dawn::CommandBuffer commands = encoder.Finish();
+    EXPECT_BUFFER_LAZY_CLEAR(2u, queue.Submit(1, &commands));
+
+    uint32_t expected[4] = {1, 1, 1, 1};
+    EXPECT_BUFFER_U32_RANGE_EQ(expected, destination, 0, 4);
+}
+
+// Test that large buffers that are completely overwritten are never cleared.
+TEST_P(BufferZeroInitTest, LargeOverwritesAreNotCleared) {
+    // Small enough for the SetSubData to fit in the command buffer of the wire tests.
+    constexpr uint32_t kCount = 1024 * 1024;
+    constexpr uint64_t kSize = kCount * sizeof(uint32_t);
+    std::vector<uint32_t> data = GetData(kCount);
+
+    dawn::Buffer source = CreateBuffer(kSize);
+    EXPECT_BUFFER_LAZY_CLEAR(0u, source.SetSubData(0, kSize, data.data()));
+
+    dawn::Buffer destination = CreateBuffer(kSize);
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, kSize);
+    dawn::CommandBuffer commands = encoder.Finish();
+    EXPECT_BUFFER_LAZY_CLEAR(0u, queue.Submit(1, &commands));
+
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), destination, 0, kCount);
+}
+
+DAWN_INSTANTIATE_TEST(BufferZeroInitTest,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
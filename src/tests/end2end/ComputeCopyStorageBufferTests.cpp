@@ -186,5 +186,6 @@ TEST_P(ComputeCopyStorageBufferTests, DISABLED_UnsizedDescriptorArray) {
 DAWN_INSTANTIATE_TEST(ComputeCopyStorageBufferTests,
                      D3D12Backend,
                      MetalBackend,
+                     NullBackend,
                      OpenGLBackend,
                      VulkanBackend);
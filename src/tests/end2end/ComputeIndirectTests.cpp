@@ -116,5 +116,6 @@ TEST_P(ComputeIndirectTests, IndirectOffset) {
 DAWN_INSTANTIATE_TEST(ComputeIndirectTests,
                       D3D12Backend,
                       MetalBackend,
+                      NullBackend,
                       OpenGLBackend,
                       VulkanBackend);
@@ -106,5 +106,6 @@ TEST_P(ComputeSharedMemoryTests, Basic) {
 DAWN_INSTANTIATE_TEST(ComputeSharedMemoryTests,
                      D3D12Backend,
                      MetalBackend,
+                     NullBackend,
                      OpenGLBackend,
                      VulkanBackend);
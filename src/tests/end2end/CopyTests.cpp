@@ -522,6 +522,18 @@ TEST_P(CopyTests_T2B, RowPitchUnaligned) {
     }
 }
 
+// Test that copying with a tightly packed row pitch that is not 256-byte aligned works
+TEST_P(CopyTests_T2B, RowPitchTightlyPacked) {
+    constexpr uint32_t kWidth = 259;
+    constexpr uint32_t kHeight = 127;
+    constexpr uint32_t kRowPitch = kWidth * kBytesPerTexel;
+    DoTest({kWidth, kHeight, 0, 0, kWidth, kHeight, 0}, {kRowPitch * kHeight, 0, kRowPitch});
+
+    // The row pitch can also be a multiple of the texel size larger than the row
+    DoTest({kWidth, kHeight, 0, 0, kWidth, kHeight, 0},
+           {(kRowPitch + kBytesPerTexel) * kHeight, kBytesPerTexel, kRowPitch + kBytesPerTexel});
+}
+
 // Test that copying regions of each texture 2D array layer works
 TEST_P(CopyTests_T2B, Texture2DArrayRegion) {
     constexpr uint32_t kWidth = 256;
@@ -540,7 +552,12 @@ TEST_P(CopyTests_T2B, Texture2DArrayMip) {
     }
 }
 
-DAWN_INSTANTIATE_TEST(CopyTests_T2B, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+DAWN_INSTANTIATE_TEST(CopyTests_T2B,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
 
 // Test that copying an entire texture with 256-byte aligned dimensions works
 TEST_P(CopyTests_B2T, FullTextureAligned) {
@@ -683,7 +700,24 @@ TEST_P(CopyTests_B2T, RowPitchUnaligned) {
     }
 }
 
-DAWN_INSTANTIATE_TEST(CopyTests_B2T, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+// Test that copying with a tightly packed row pitch that is not 256-byte aligned works
+TEST_P(CopyTests_B2T, RowPitchTightlyPacked) {
+    constexpr uint32_t kWidth = 259;
+    constexpr uint32_t kHeight = 127;
+    constexpr uint32_t kRowPitch = kWidth * kBytesPerTexel;
+    DoTest({kWidth, kHeight, 0, 0, kWidth, kHeight, 0}, {kRowPitch * kHeight, 0, kRowPitch});
+
+    // The row pitch can also be a multiple of the texel size larger than the row
+    DoTest({kWidth, kHeight, 0, 0, kWidth, kHeight, 0},
+           {(kRowPitch + kBytesPerTexel) * kHeight, kBytesPerTexel, kRowPitch + kBytesPerTexel});
+}
+
+DAWN_INSTANTIATE_TEST(CopyTests_B2T,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
 
 TEST_P(CopyTests_T2T, Texture) {
     constexpr uint32_t kWidth = 256;
@@ -731,4 +765,9 @@ TEST_P(CopyTests_T2T, TextureMip) {
 
 // TODO(brandon1.jones@intel.com) Add test for ensuring blitCommandEncoder on Metal.
 
-DAWN_INSTANTIATE_TEST(CopyTests_T2T, D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend);
+DAWN_INSTANTIATE_TEST(CopyTests_T2T,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
@@ -320,6 +320,45 @@ TEST_P(ObjectCachingTest, RenderPipelineDeduplicationOnFragmentModule) {
     EXPECT_EQ(pipeline.Get() == samePipeline.Get(), !UsesWire());
 }
 
+// Test that RenderPipelines are correctly deduplicated wrt. their vertex input, regardless of the
+// order in which the attributes are listed.
+TEST_P(ObjectCachingTest, RenderPipelineDeduplicationOnVertexInput) {
+    utils::ComboRenderPipelineDescriptor desc(device);
+    desc.vertexStage.module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            layout(location = 0) in vec4 a;
+            layout(location = 1) in vec4 b;
+            void main() {
+                gl_Position = a + b;
+            })");
+    desc.cFragmentStage.module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            void main() {
+            })");
+
+    desc.cVertexInput.bufferCount = 1;
+    desc.cVertexInput.cBuffers[0].stride = 8 * sizeof(float);
+    desc.cVertexInput.cBuffers[0].attributeCount = 2;
+    desc.cVertexInput.cAttributes[0].shaderLocation = 0;
+    desc.cVertexInput.cAttributes[0].offset = 0;
+    desc.cVertexInput.cAttributes[0].format = dawn::VertexFormat::Float4;
+    desc.cVertexInput.cAttributes[1].shaderLocation = 1;
+    desc.cVertexInput.cAttributes[1].offset = 4 * sizeof(float);
+    desc.cVertexInput.cAttributes[1].format = dawn::VertexFormat::Float4;
+    dawn::RenderPipeline pipeline = device.CreateRenderPipeline(&desc);
+
+    std::swap(desc.cVertexInput.cAttributes[0], desc.cVertexInput.cAttributes[1]);
+    dawn::RenderPipeline samePipeline = device.CreateRenderPipeline(&desc);
+
+    desc.cVertexInput.cAttributes[0].offset = 2 * sizeof(float);
+    dawn::RenderPipeline otherPipeline = device.CreateRenderPipeline(&desc);
+
+    EXPECT_NE(pipeline.Get(), otherPipeline.Get());
+    EXPECT_EQ(pipeline.Get() == samePipeline.Get(), !UsesWire());
+}
+
 // Test that Samplers are correctly deduplicated.
 TEST_P(ObjectCachingTest, SamplerDeduplication) {
     dawn::SamplerDescriptor samplerDesc = utils::GetDefaultSamplerDescriptor();
@@ -0,0 +1,176 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "utils/DawnHelpers.h"
+
+#include <vector>
+
+class QueueWriteBufferTests : public DawnTest {
+  protected:
+    dawn::Buffer CreateBuffer(uint64_t size) {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst;
+        return device.CreateBuffer(&descriptor);
+    }
+};
+
+// Test the simplest WriteBuffer setting one u32 at offset 0.
+TEST_P(QueueWriteBufferTests, SmallDataAtZero) {
+    dawn::Buffer buffer = CreateBuffer(4);
+
+    uint32_t value = 0x01020304;
+    queue.WriteBuffer(buffer, 0, &value, sizeof(value));
+
+    EXPECT_BUFFER_U32_EQ(value, buffer, 0);
+}
+
+// Test WriteBuffer at an offset, and that consecutive writes are applied in order.
+TEST_P(QueueWriteBufferTests, ConsecutiveWritesAtOffset) {
+    dawn::Buffer buffer = CreateBuffer(16);
+
+    uint32_t data[4] = {1, 2, 3, 4};
+    queue.WriteBuffer(buffer, 0, data, sizeof(data));
+
+    uint32_t value = 42;
+    queue.WriteBuffer(buffer, 8, &value, sizeof(value));
+
+    uint32_t expected[4] = {1, 2, 42, 4};
+    EXPECT_BUFFER_U32_RANGE_EQ(expected, buffer, 0, 4);
+}
+
+// Test a WriteBuffer larger than the default size of the upload buffers.
+TEST_P(QueueWriteBufferTests, LargeWrite) {
+    constexpr uint32_t kElements = 256 * 1024;
+    dawn::Buffer buffer = CreateBuffer(kElements * sizeof(uint32_t));
+
+    std::vector<uint32_t> data(kElements);
+    for (uint32_t i = 0; i < kElements; ++i) {
+        data[i] = i;
+    }
+    queue.WriteBuffer(buffer, 0, data.data(), kElements * sizeof(uint32_t));
+
+    EXPECT_BUFFER_U32_RANGE_EQ(data.data(), buffer, 0, kElements);
+}
+
+// Test that a WriteBuffer is visible to the command buffers submitted after it.
+TEST_P(QueueWriteBufferTests, VisibleToLaterSubmits) {
+    dawn::Buffer source = CreateBuffer(4);
+    dawn::Buffer destination = CreateBuffer(4);
+
+    uint32_t value = 0x01020304;
+    queue.WriteBuffer(source, 0, &value, sizeof(value));
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 4);
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_BUFFER_U32_EQ(value, destination, 0);
+}
+
+DAWN_INSTANTIATE_TEST(QueueWriteBufferTests,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
+
+class QueueWriteTextureTests : public DawnTest {
+  protected:
+    static constexpr dawn::TextureFormat kFormat = dawn::TextureFormat::RGBA8Unorm;
+
+    dawn::Texture CreateTexture(uint32_t width, uint32_t height) {
+        dawn::TextureDescriptor descriptor;
+        descriptor.size = {width, height, 1};
+        descriptor.format = kFormat;
+        descriptor.usage = dawn::TextureUsage::CopyDst | dawn::TextureUsage::CopySrc;
+        return device.CreateTexture(&descriptor);
+    }
+
+    // Returns |rowCount| rows of |width| texels whose values are all different.
+    static std::vector<RGBA8> GetRows(uint32_t width, uint32_t rowCount, uint32_t rowPitch) {
+        std::vector<RGBA8> rows(width * rowCount);
+        for (uint32_t y = 0; y < rowCount; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                uint32_t i = x + y * width;
+                rows[i] = RGBA8(static_cast<uint8_t>(i), static_cast<uint8_t>(i / 256),
+                                static_cast<uint8_t>(rowPitch), 255);
+            }
+        }
+        return rows;
+    }
+
+    // Returns the rows at |rowPitch| bytes from each other, after |offset| bytes of padding.
+    static std::vector<uint8_t> PackRows(const std::vector<RGBA8>& rows,
+                                         uint32_t width,
+                                         uint32_t rowCount,
+                                         uint32_t rowPitch,
+                                         uint64_t offset) {
+        std::vector<uint8_t> data(offset + rowPitch * (rowCount - 1) + width * sizeof(RGBA8));
+        for (uint32_t y = 0; y < rowCount; ++y) {
+            memcpy(&data[offset + y * rowPitch], &rows[y * width], width * sizeof(RGBA8));
+        }
+        return data;
+    }
+
+    void DoTest(uint32_t textureWidth,
+                uint32_t textureHeight,
+                dawn::Origin3D origin,
+                dawn::Extent3D writeSize,
+                uint32_t rowPitch,
+                uint64_t offset) {
+        dawn::Texture texture = CreateTexture(textureWidth, textureHeight);
+
+        uint32_t actualRowPitch =
+            rowPitch == 0 ? writeSize.width * static_cast<uint32_t>(sizeof(RGBA8)) : rowPitch;
+        std::vector<RGBA8> expected = GetRows(writeSize.width, writeSize.height, actualRowPitch);
+        std::vector<uint8_t> data =
+            PackRows(expected, writeSize.width, writeSize.height, actualRowPitch, offset);
+
+        dawn::TextureCopyView textureCopyView =
+            utils::CreateTextureCopyView(texture, 0, 0, origin);
+        dawn::TextureDataLayout dataLayout;
+        dataLayout.offset = offset;
+        dataLayout.rowPitch = rowPitch;
+        queue.WriteTexture(&textureCopyView, data.data(), data.size(), &dataLayout, &writeSize);
+
+        EXPECT_TEXTURE_RGBA8_EQ(expected.data(), texture, origin.x, origin.y, writeSize.width,
+                                writeSize.height, 0, 0);
+    }
+};
+
+// Test writing a whole texture with the default, tightly packed row pitch.
+TEST_P(QueueWriteTextureTests, FullTextureTightlyPacked) {
+    DoTest(259, 127, {0, 0, 0}, {259, 127, 1}, 0, 0);
+}
+
+// Test writing part of a texture with padded rows and an offset in the data.
+TEST_P(QueueWriteTextureTests, PartialWithRowPitchAndOffset) {
+    DoTest(64, 64, {5, 7, 0}, {33, 21, 1}, 33 * 4 + 12, 6);
+}
+
+// Test writing a texture with a row pitch that is already 256-byte aligned.
+TEST_P(QueueWriteTextureTests, AlignedRowPitch) {
+    DoTest(64, 32, {0, 0, 0}, {64, 32, 1}, 256, 0);
+}
+
+DAWN_INSTANTIATE_TEST(QueueWriteTextureTests,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
@@ -213,6 +213,45 @@ TEST_P(TextureZeroInitTest, CopyBufferToTextureHalf) {
     EXPECT_TEXTURE_RGBA8_EQ(expectedZeros.data(), texture, kSize / 2, 0, kSize / 2, kSize, 0, 0);
 }
 
+// This tests WriteTexture fully overwrites the subresource so lazy init is not needed.
+TEST_P(TextureZeroInitTest, WriteTexture) {
+    dawn::TextureDescriptor descriptor = CreateTextureDescriptor(
+        1, 1, dawn::TextureUsage::CopyDst | dawn::TextureUsage::CopySrc, kColorFormat);
+    dawn::Texture texture = device.CreateTexture(&descriptor);
+
+    std::vector<uint8_t> data(4 * kSize * kSize, 100);
+    dawn::TextureCopyView textureCopyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    dawn::TextureDataLayout dataLayout;
+    dawn::Extent3D writeSize = {kSize, kSize, 1};
+    EXPECT_LAZY_CLEAR(0u, queue.WriteTexture(&textureCopyView, data.data(), data.size(),
+                                             &dataLayout, &writeSize));
+
+    std::vector<RGBA8> expected(kSize * kSize, {100, 100, 100, 100});
+    EXPECT_TEXTURE_RGBA8_EQ(expected.data(), texture, 0, 0, kSize, kSize, 0, 0);
+}
+
+// Test for a write only to a subset of the subresource, lazy init is necessary to clear the other
+// half.
+TEST_P(TextureZeroInitTest, WriteTextureHalf) {
+    dawn::TextureDescriptor descriptor = CreateTextureDescriptor(
+        1, 1, dawn::TextureUsage::CopyDst | dawn::TextureUsage::CopySrc, kColorFormat);
+    dawn::Texture texture = device.CreateTexture(&descriptor);
+
+    std::vector<uint8_t> data(4 * kSize * kSize, 100);
+    dawn::TextureCopyView textureCopyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    dawn::TextureDataLayout dataLayout;
+    dawn::Extent3D writeSize = {kSize / 2, kSize, 1};
+    EXPECT_LAZY_CLEAR(1u, queue.WriteTexture(&textureCopyView, data.data(), data.size(),
+                                             &dataLayout, &writeSize));
+
+    std::vector<RGBA8> expected100((kSize / 2) * kSize, {100, 100, 100, 100});
+    std::vector<RGBA8> expectedZeros((kSize / 2) * kSize, {0, 0, 0, 0});
+    // first half filled with 100, by the written data
+    EXPECT_TEXTURE_RGBA8_EQ(expected100.data(), texture, 0, 0, kSize / 2, kSize, 0, 0);
+    // second half should be cleared
+    EXPECT_TEXTURE_RGBA8_EQ(expectedZeros.data(), texture, kSize / 2, 0, kSize / 2, kSize, 0, 0);
+}
+
 // This tests CopyTextureToTexture fully overwrites copy so lazy init is not needed.
 TEST_P(TextureZeroInitTest, CopyTextureToTexture) {
     dawn::TextureDescriptor srcDescriptor = CreateTextureDescriptor(
@@ -0,0 +1,96 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1000;
+    constexpr uint32_t kTextureSize = 4;
+
+}  // namespace
+
+// Test recreating the same texture view and bind group every iteration, like applications that
+// don't keep track of their bind groups across frames. With the
+// deduplicate_bind_groups_and_texture_views toggle the objects are found in the device's caches
+// so no backend objects (for example descriptor sets on Vulkan) are created, and heap_allocations
+// shows the allocations avoided.
+class BindGroupRecreationPerf : public DawnPerfTest {
+  public:
+    BindGroupRecreationPerf() : DawnPerfTest(kNumIterations) {
+    }
+    ~BindGroupRecreationPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    dawn::Texture mTexture;
+    dawn::Buffer mUniformBuffer;
+    dawn::Sampler mSampler;
+    dawn::BindGroupLayout mBindGroupLayout;
+};
+
+void BindGroupRecreationPerf::SetUp() {
+    DawnPerfTest::SetUp();
+
+    dawn::TextureDescriptor textureDesc;
+    textureDesc.dimension = dawn::TextureDimension::e2D;
+    textureDesc.size = {kTextureSize, kTextureSize, 1};
+    textureDesc.arrayLayerCount = 1;
+    textureDesc.sampleCount = 1;
+    textureDesc.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = dawn::TextureUsage::Sampled;
+    mTexture = device.CreateTexture(&textureDesc);
+
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = 256;
+    bufferDesc.usage = dawn::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+    dawn::SamplerDescriptor samplerDesc = utils::GetDefaultSamplerDescriptor();
+    mSampler = device.CreateSampler(&samplerDesc);
+
+    mBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Fragment, dawn::BindingType::UniformBuffer},
+                 {1, dawn::ShaderStage::Fragment, dawn::BindingType::Sampler},
+                 {2, dawn::ShaderStage::Fragment, dawn::BindingType::SampledTexture}});
+}
+
+void BindGroupRecreationPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        dawn::TextureView view = mTexture.CreateView();
+        dawn::BindGroup bindGroup = utils::MakeBindGroup(
+            device, mBindGroupLayout, {{0, mUniformBuffer, 0, 16}, {1, mSampler}, {2, view}});
+    }
+}
+
+TEST_P(BindGroupRecreationPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(BindGroupRecreationPerf,
+                      NullBackend,
+                      ForceWorkarounds(NullBackend, {"deduplicate_bind_groups_and_texture_views"}),
+                      D3D12Backend,
+                      ForceWorkarounds(D3D12Backend, {"deduplicate_bind_groups_and_texture_views"}),
+                      MetalBackend,
+                      OpenGLBackend,
+                      VulkanBackend,
+                      ForceWorkarounds(VulkanBackend,
+                                       {"deduplicate_bind_groups_and_texture_views"}));
@@ -0,0 +1,120 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 50;
+    constexpr uint64_t kBufferSize = 64 * 1024 * 1024;
+    constexpr uint64_t kCounterOffset = kBufferSize / 2;
+
+    enum class ReadbackMethod {
+        MapWholeBuffer,
+        MapRange,
+    };
+
+    struct BufferReadbackParams : DawnTestParam {
+        BufferReadbackParams(const DawnTestParam& param, ReadbackMethod readbackMethod)
+            : DawnTestParam(param), readbackMethod(readbackMethod) {
+        }
+
+        ReadbackMethod readbackMethod;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const BufferReadbackParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.readbackMethod) {
+            case ReadbackMethod::MapWholeBuffer:
+                ostream << "_MapWholeBuffer";
+                break;
+            case ReadbackMethod::MapRange:
+                ostream << "_MapRange";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test reading back a 4-byte counter from a |kBufferSize| buffer |kNumIterations| times.
+class BufferReadbackPerf : public DawnPerfTestWithParams<BufferReadbackParams> {
+  public:
+    BufferReadbackPerf() : DawnPerfTestWithParams(kNumIterations) {
+    }
+    ~BufferReadbackPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    static void MapReadCallback(DawnBufferMapAsyncStatus status,
+                                const void* data,
+                                uint64_t,
+                                void* userdata) {
+        ASSERT_EQ(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, status);
+        ASSERT_NE(nullptr, data);
+
+        static_cast<BufferReadbackPerf*>(userdata)->mappedData = data;
+    }
+
+    dawn::Buffer buffer;
+    const void* mappedData = nullptr;
+};
+
+void BufferReadbackPerf::SetUp() {
+    DawnPerfTestWithParams<BufferReadbackParams>::SetUp();
+
+    dawn::BufferDescriptor desc = {};
+    desc.size = kBufferSize;
+    desc.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst;
+
+    buffer = device.CreateBuffer(&desc);
+
+    uint32_t counter = 42;
+    buffer.SetSubData(kCounterOffset, sizeof(counter), &counter);
+}
+
+void BufferReadbackPerf::Step() {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        mappedData = nullptr;
+
+        switch (GetParam().readbackMethod) {
+            case ReadbackMethod::MapWholeBuffer:
+                buffer.MapReadAsync(MapReadCallback, this);
+                break;
+            case ReadbackMethod::MapRange:
+                buffer.MapReadRangeAsync(kCounterOffset, sizeof(uint32_t), MapReadCallback, this);
+                break;
+        }
+
+        while (mappedData == nullptr) {
+            WaitABit();
+        }
+
+        buffer.Unmap();
+    }
+}
+
+TEST_P(BufferReadbackPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(BufferReadbackPerf,
+                                   {D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend},
+                                   {ReadbackMethod::MapWholeBuffer, ReadbackMethod::MapRange});
@@ -25,6 +25,7 @@ namespace {
     enum class UploadMethod {
         SetSubData,
         CreateBufferMapped,
+        WriteBuffer,
     };
 
     struct BufferUploadParams : DawnTestParam {
@@ -45,6 +46,9 @@ namespace {
             case UploadMethod::CreateBufferMapped:
                 ostream << "_CreateBufferMapped";
                 break;
+            case UploadMethod::WriteBuffer:
+                ostream << "_WriteBuffer";
+                break;
         }
         return ostream;
     }
@@ -104,6 +108,14 @@ void BufferUploadPerf::Step() {
             dawn::CommandBuffer commands = encoder.Finish();
             queue.Submit(1, &commands);
         } break;
+
+        case UploadMethod::WriteBuffer: {
+            for (unsigned int i = 0; i < kNumIterations; ++i) {
+                queue.WriteBuffer(dst, 0, data.data(), kBufferSize);
+            }
+            // Make sure all WriteBuffer's are flushed.
+            queue.Submit(0, nullptr);
+        } break;
     }
 
     // Wait for the GPU in this batch of iterations.
@@ -119,4 +131,5 @@ TEST_P(BufferUploadPerf, Run) {
 
 DAWN_INSTANTIATE_PERF_TEST_SUITE_P(BufferUploadPerf,
                                    {D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend},
-                                   {UploadMethod::SetSubData, UploadMethod::CreateBufferMapped});
+                                   {UploadMethod::SetSubData, UploadMethod::CreateBufferMapped,
+                                    UploadMethod::WriteBuffer});
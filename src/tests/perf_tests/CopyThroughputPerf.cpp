@@ -0,0 +1,175 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumCopies = 10;
+    constexpr uint32_t kTextureSize = 1024;
+    constexpr uint32_t kBytesPerTexel = 4;
+    constexpr uint32_t kRowPitch = kTextureSize * kBytesPerTexel;
+    constexpr uint64_t kCopySize = static_cast<uint64_t>(kRowPitch) * kTextureSize;
+
+    enum class CopyType {
+        BufferToBuffer,
+        BufferToTexture,
+        TextureToBuffer,
+        TextureToTexture,
+    };
+
+    struct CopyThroughputParams : DawnTestParam {
+        CopyThroughputParams(const DawnTestParam& param, CopyType copyType)
+            : DawnTestParam(param), copyType(copyType) {
+        }
+
+        CopyType copyType;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const CopyThroughputParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.copyType) {
+            case CopyType::BufferToBuffer:
+                ostream << "_BufferToBuffer";
+                break;
+            case CopyType::BufferToTexture:
+                ostream << "_BufferToTexture";
+                break;
+            case CopyType::TextureToBuffer:
+                ostream << "_TextureToBuffer";
+                break;
+            case CopyType::TextureToTexture:
+                ostream << "_TextureToTexture";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test copying a |kTextureSize| x |kTextureSize| RGBA8 texture, or a buffer of the same size,
+// |kNumCopies| times. On the null backend this measures the copies executed on the CPU.
+class CopyThroughputPerf : public DawnPerfTestWithParams<CopyThroughputParams> {
+  public:
+    CopyThroughputPerf() : DawnPerfTestWithParams(kNumCopies) {
+    }
+    ~CopyThroughputPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    dawn::Buffer CreateBuffer();
+    dawn::Texture CreateTexture();
+
+    dawn::Buffer mSourceBuffer;
+    dawn::Buffer mDestinationBuffer;
+    dawn::Texture mSourceTexture;
+    dawn::Texture mDestinationTexture;
+};
+
+dawn::Buffer CopyThroughputPerf::CreateBuffer() {
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = kCopySize;
+    descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst;
+    return device.CreateBuffer(&descriptor);
+}
+
+dawn::Texture CopyThroughputPerf::CreateTexture() {
+    dawn::TextureDescriptor descriptor;
+    descriptor.dimension = dawn::TextureDimension::e2D;
+    descriptor.size = {kTextureSize, kTextureSize, 1};
+    descriptor.arrayLayerCount = 1;
+    descriptor.sampleCount = 1;
+    descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+    descriptor.mipLevelCount = 1;
+    descriptor.usage = dawn::TextureUsage::CopySrc | dawn::TextureUsage::CopyDst;
+    return device.CreateTexture(&descriptor);
+}
+
+void CopyThroughputPerf::SetUp() {
+    DawnPerfTestWithParams<CopyThroughputParams>::SetUp();
+
+    mSourceBuffer = CreateBuffer();
+    mDestinationBuffer = CreateBuffer();
+    mSourceTexture = CreateTexture();
+    mDestinationTexture = CreateTexture();
+
+    // Initialize the sources so that the copies don't read uninitialized data.
+    std::vector<uint8_t> data(kCopySize, 0x42);
+    mSourceBuffer.SetSubData(0, kCopySize, data.data());
+
+    dawn::BufferCopyView bufferCopyView = utils::CreateBufferCopyView(mSourceBuffer, 0, 0, 0);
+    dawn::TextureCopyView textureCopyView =
+        utils::CreateTextureCopyView(mSourceTexture, 0, 0, {0, 0, 0});
+    dawn::Extent3D copySize = {kTextureSize, kTextureSize, 1};
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToTexture(&bufferCopyView, &textureCopyView, &copySize);
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+void CopyThroughputPerf::Step() {
+    dawn::BufferCopyView sourceBufferView =
+        utils::CreateBufferCopyView(mSourceBuffer, 0, kRowPitch, 0);
+    dawn::BufferCopyView destinationBufferView =
+        utils::CreateBufferCopyView(mDestinationBuffer, 0, kRowPitch, 0);
+    dawn::TextureCopyView sourceTextureView =
+        utils::CreateTextureCopyView(mSourceTexture, 0, 0, {0, 0, 0});
+    dawn::TextureCopyView destinationTextureView =
+        utils::CreateTextureCopyView(mDestinationTexture, 0, 0, {0, 0, 0});
+    dawn::Extent3D copySize = {kTextureSize, kTextureSize, 1};
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    for (unsigned int i = 0; i < kNumCopies; ++i) {
+        switch (GetParam().copyType) {
+            case CopyType::BufferToBuffer:
+                encoder.CopyBufferToBuffer(mSourceBuffer, 0, mDestinationBuffer, 0, kCopySize);
+                break;
+            case CopyType::BufferToTexture:
+                encoder.CopyBufferToTexture(&sourceBufferView, &destinationTextureView,
+                                            &copySize);
+                break;
+            case CopyType::TextureToBuffer:
+                encoder.CopyTextureToBuffer(&sourceTextureView, &destinationBufferView,
+                                            &copySize);
+                break;
+            case CopyType::TextureToTexture:
+                encoder.CopyTextureToTexture(&sourceTextureView, &destinationTextureView,
+                                             &copySize);
+                break;
+        }
+    }
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Wait for the GPU so that the copies are part of the measured time.
+    WaitForGPU();
+}
+
+TEST_P(CopyThroughputPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
+    CopyThroughputPerf,
+    {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend, VulkanBackend},
+    {CopyType::BufferToBuffer, CopyType::BufferToTexture, CopyType::TextureToBuffer,
+     CopyType::TextureToTexture});
@@ -14,8 +14,27 @@
 
 #include "tests/perf_tests/DawnPerfTest.h"
 
+#include "common/Assert.h"
+#include "common/Platform.h"
 #include "utils/Timer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+#if defined(DAWN_PLATFORM_WINDOWS)
+#    include "common/windows_with_undefs.h"
+
+#    include <psapi.h>
+#elif defined(DAWN_PLATFORM_POSIX)
+#    include <sys/resource.h>
+#endif
+
 namespace {
 
     DawnPerfTestEnvironment* gTestEnv = nullptr;
@@ -23,8 +42,96 @@ namespace {
     constexpr double kMicroSecondsPerSecond = 1e6;
     constexpr double kNanoSecondsPerSecond = 1e9;
 
+    // The number of heap allocations made by the process, counted by the replacement of the
+    // global operator new below. It includes allocations made by other threads, for example by
+    // the driver, and only covers the shared libraries on platforms where they use the operator
+    // new of the executable.
+    std::atomic<uint64_t> gHeapAllocationCount(0);
+
+    // The user and system CPU time of all the threads of the process.
+    double GetProcessCPUTimeSeconds() {
+#if defined(DAWN_PLATFORM_WINDOWS)
+        FILETIME creationTime, exitTime, kernelTime, userTime;
+        if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime,
+                             &userTime)) {
+            return 0.0;
+        }
+        auto ToSeconds = [](const FILETIME& time) -> double {
+            uint64_t ticks = (uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+            return ticks * 100e-9;
+        };
+        return ToSeconds(kernelTime) + ToSeconds(userTime);
+#elif defined(DAWN_PLATFORM_POSIX)
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0.0;
+        }
+        auto ToSeconds = [](const timeval& time) -> double {
+            return time.tv_sec + time.tv_usec * 1e-6;
+        };
+        return ToSeconds(usage.ru_utime) + ToSeconds(usage.ru_stime);
+#else
+        return 0.0;
+#endif
+    }
+
+    // The largest resident set size of the process since its start, including previous tests.
+    uint64_t GetPeakResidentSetSizeKB() {
+#if defined(DAWN_PLATFORM_WINDOWS)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+        return counters.PeakWorkingSetSize / 1024;
+#elif defined(DAWN_PLATFORM_POSIX)
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#    if defined(DAWN_PLATFORM_APPLE)
+        // ru_maxrss is in bytes on Apple platforms and in kilobytes elsewhere.
+        return usage.ru_maxrss / 1024;
+#    else
+        return usage.ru_maxrss;
+#    endif
+#else
+        return 0;
+#endif
+    }
+
+    // Returns the value below which `percentile` percent of the sorted values are.
+    double GetPercentile(const std::vector<double>& sortedValues, double percentile) {
+        ASSERT(!sortedValues.empty());
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedValues.size()));
+        return sortedValues[std::max(rank, size_t(1)) - 1];
+    }
+
+    std::string EscapeJsonString(const std::string& value) {
+        std::string result;
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result;
+    }
+
 }  // namespace
 
+void* operator new(size_t size) {
+    gHeapAllocationCount++;
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
 void InitDawnPerfTestEnvironment(int argc, char** argv) {
     gTestEnv = new DawnPerfTestEnvironment(argc, argv);
     DawnTestEnvironment::SetEnvironment(gTestEnv);
@@ -47,12 +154,33 @@ DawnPerfTestEnvironment::DawnPerfTestEnvironment(int argc, char** argv)
             continue;
         }
 
+        if (strstr(argv[i], "--json=") == argv[i]) {
+            mJsonFile = strchr(argv[i], '=') + 1;
+            continue;
+        }
+
+        if (strstr(argv[i], "--baseline=") == argv[i]) {
+            mBaselineFile = strchr(argv[i], '=') + 1;
+            continue;
+        }
+
+        if (strstr(argv[i], "--regression-threshold=") == argv[i]) {
+            mRegressionThreshold = strtod(strchr(argv[i], '=') + 1, nullptr) / 100.0;
+            continue;
+        }
+
         if (strcmp("-h", argv[i]) == 0 || strcmp("--help", argv[i]) == 0) {
             std::cout << "Additional flags:"
-                      << " [--calibration] [--override-steps=x]\n"
+                      << " [--calibration] [--override-steps=x] [--json=file] [--baseline=file]"
+                         " [--regression-threshold=percent]\n"
                       << "  --calibration: Only run calibration. Calibration allows the perf test"
                          " runner script to save some time.\n"
                       << " --override-steps: Set a fixed number of steps to run for each test\n"
+                      << " --json: Write the statistics of each test to a JSON file\n"
+                      << " --baseline: Fail the tests whose median wall time regressed compared"
+                         " to a JSON file written by a previous run\n"
+                      << " --regression-threshold: The regression, in percent, above which tests"
+                         " fail with --baseline (defaults to 10)\n"
                       << std::endl;
             continue;
         }
@@ -63,6 +191,103 @@ DawnPerfTestEnvironment::~DawnPerfTestEnvironment() = default;
 
 void DawnPerfTestEnvironment::SetUp() {
     DawnTestEnvironment::SetUp();
+
+    if (!mBaselineFile.empty()) {
+        ASSERT_TRUE(LoadBaseline()) << "Couldn't read the baseline " << mBaselineFile;
+    }
+}
+
+void DawnPerfTestEnvironment::TearDown() {
+    if (!mJsonFile.empty()) {
+        ASSERT_TRUE(WriteJsonResults()) << "Couldn't write the results to " << mJsonFile;
+    }
+
+    DawnTestEnvironment::TearDown();
+}
+
+void DawnPerfTestEnvironment::AddResult(const DawnPerfTestResult& result) {
+    mResults.push_back(result);
+}
+
+bool DawnPerfTestEnvironment::GetBaselineMedianWallTimeNs(const std::string& testName,
+                                                          double* median) const {
+    auto it = mBaselineMedianWallTimesNs.find(testName);
+    if (it == mBaselineMedianWallTimesNs.end()) {
+        return false;
+    }
+    *median = it->second;
+    return true;
+}
+
+double DawnPerfTestEnvironment::GetRegressionThreshold() const {
+    return mRegressionThreshold;
+}
+
+// The results are written with one test per line so that LoadBaseline can read them back without
+// a full JSON parser.
+bool DawnPerfTestEnvironment::WriteJsonResults() const {
+    std::ofstream file(mJsonFile);
+    if (!file) {
+        return false;
+    }
+
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << "{\"tests\": [\n";
+    for (size_t i = 0; i < mResults.size(); ++i) {
+        const DawnPerfTestResult& result = mResults[i];
+        file << "{\"name\": \"" << EscapeJsonString(result.name) << "\""
+             << ", \"iterations_per_step\": " << result.iterationsPerStep
+             << ", \"steps\": " << result.stepCount
+             << ", \"wall_time_ns\": {\"mean\": " << result.meanWallTimeNs
+             << ", \"median\": " << result.medianWallTimeNs
+             << ", \"p90\": " << result.p90WallTimeNs << ", \"p99\": " << result.p99WallTimeNs
+             << ", \"stddev\": " << result.stddevWallTimeNs << "}"
+             << ", \"cpu_time_ns\": " << result.cpuTimeNs
+             << ", \"heap_allocations\": " << result.heapAllocations
+             << ", \"peak_rss_kb\": " << result.peakResidentSetSizeKB << "}"
+             << (i + 1 < mResults.size() ? "," : "") << "\n";
+    }
+    file << "]}\n";
+
+    return file.good();
+}
+
+bool DawnPerfTestEnvironment::LoadBaseline() {
+    std::ifstream file(mBaselineFile);
+    if (!file) {
+        return false;
+    }
+
+    constexpr char kNameKey[] = "{\"name\": \"";
+    constexpr char kMedianKey[] = "\"median\": ";
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, sizeof(kNameKey) - 1, kNameKey) != 0) {
+            continue;
+        }
+
+        std::string name;
+        size_t i = sizeof(kNameKey) - 1;
+        for (; i < line.size() && line[i] != '"'; ++i) {
+            if (line[i] == '\\' && i + 1 < line.size()) {
+                ++i;
+            }
+            name += line[i];
+        }
+
+        size_t medianPosition = line.find(kMedianKey, i);
+        if (medianPosition == std::string::npos) {
+            return false;
+        }
+        std::istringstream median(line.substr(medianPosition + sizeof(kMedianKey) - 1));
+        median >> mBaselineMedianWallTimesNs[name];
+        if (median.fail()) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 bool DawnPerfTestEnvironment::IsCalibrating() const {
@@ -98,6 +323,11 @@ void DawnPerfTestBase::WaitForGPU() {
                        },
                        &done);
 
+    // Block until the fence completes instead of polling it when the device is in process.
+    if (!mTest->UsesWire()) {
+        dawn_native::WaitForFence(fence.Get(), 1, std::numeric_limits<uint64_t>::max());
+    }
+
     while (!done) {
         mTest->WaitABit();
     }
@@ -128,21 +358,38 @@ void DawnPerfTestBase::RunTest() {
     // Do another warmup run. Seems to consistently improve results.
     DoRunLoop(kMaximumRunTimeSeconds);
 
+    // Reserve the space for the step times up front so that the trials don't allocate them.
+    mStepTimes.clear();
+    mStepTimes.reserve(kNumTrials * static_cast<size_t>(mStepsToRun));
+    mRecordStepTimes = true;
+
+    uint64_t heapAllocationCount = 0;
+    double cpuTimeAtStart = GetProcessCPUTimeSeconds();
     for (unsigned int trial = 0; trial < kNumTrials; ++trial) {
         DoRunLoop(kMaximumRunTimeSeconds);
+        heapAllocationCount += mHeapAllocationCount;
         PrintResults();
     }
+    double cpuTimeSeconds = GetProcessCPUTimeSeconds() - cpuTimeAtStart;
+
+    mRecordStepTimes = false;
+    PrintStatistics(cpuTimeSeconds, heapAllocationCount);
 }
 
 void DawnPerfTestBase::DoRunLoop(double maxRunTime) {
     mNumStepsPerformed = 0;
     mRunning = true;
+    uint64_t heapAllocationCountAtStart = gHeapAllocationCount;
     mTimer->Start();
 
     // This loop can be canceled by calling AbortTest().
     while (mRunning) {
+        double stepStart = mRecordStepTimes ? mTimer->GetAbsoluteTime() : 0.0;
         Step();
         if (mRunning) {
+            if (mRecordStepTimes) {
+                mStepTimes.push_back(mTimer->GetAbsoluteTime() - stepStart);
+            }
             ++mNumStepsPerformed;
             if (mTimer->GetElapsedTime() > maxRunTime) {
                 mRunning = false;
@@ -153,34 +400,79 @@ void DawnPerfTestBase::DoRunLoop(double maxRunTime) {
     }
 
     mTimer->Stop();
+    mHeapAllocationCount = gHeapAllocationCount - heapAllocationCountAtStart;
 }
 
 void DawnPerfTestBase::PrintResults() {
-    double elapsedTimeSeconds[2] = {
-        mTimer->GetElapsedTime(),
-        mGPUTimeNs * 1e-9,
-    };
-
-    const char* clockNames[2] = {
-        "wall_time",
-        "gpu_time",
-    };
-
-    // If measured gpu time is non-zero, print that too.
-    unsigned int clocksToOutput = mGPUTimeNs > 0 ? 2 : 1;
-
-    for (unsigned int i = 0; i < clocksToOutput; ++i) {
-        double secondsPerStep = elapsedTimeSeconds[i] / static_cast<double>(mNumStepsPerformed);
-        double secondsPerIteration = secondsPerStep / static_cast<double>(mIterationsPerStep);
-
-        // Give the result a different name to ensure separate graphs if we transition.
-        if (secondsPerIteration > 1e-3) {
-            double microSecondsPerIteration = secondsPerIteration * kMicroSecondsPerSecond;
-            PrintResult(clockNames[i], microSecondsPerIteration, "us", true);
-        } else {
-            double nanoSecPerIteration = secondsPerIteration * kNanoSecondsPerSecond;
-            PrintResult(clockNames[i], nanoSecPerIteration, "ns", true);
-        }
+    double secondsPerStep = mTimer->GetElapsedTime() / static_cast<double>(mNumStepsPerformed);
+    double secondsPerIteration = secondsPerStep / static_cast<double>(mIterationsPerStep);
+
+    // Give the result a different name to ensure separate graphs if we transition.
+    if (secondsPerIteration > 1e-3) {
+        double microSecondsPerIteration = secondsPerIteration * kMicroSecondsPerSecond;
+        PrintResult("wall_time", microSecondsPerIteration, "us", true);
+    } else {
+        double nanoSecPerIteration = secondsPerIteration * kNanoSecondsPerSecond;
+        PrintResult("wall_time", nanoSecPerIteration, "ns", true);
+    }
+
+    double heapAllocationsPerIteration =
+        static_cast<double>(mHeapAllocationCount) /
+        (static_cast<double>(mNumStepsPerformed) * static_cast<double>(mIterationsPerStep));
+    PrintResult("heap_allocations", heapAllocationsPerIteration, "count", false);
+}
+
+void DawnPerfTestBase::PrintStatistics(double cpuTimeSeconds, uint64_t heapAllocationCount) {
+    if (mStepTimes.empty()) {
+        return;
+    }
+
+    // The statistics are computed on the time per iteration of each step.
+    std::vector<double> times(mStepTimes.size());
+    for (size_t i = 0; i < mStepTimes.size(); ++i) {
+        times[i] = mStepTimes[i] * kNanoSecondsPerSecond / mIterationsPerStep;
+    }
+    std::sort(times.begin(), times.end());
+
+    double iterationCount = static_cast<double>(times.size()) * mIterationsPerStep;
+    double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    double sumOfSquareDeviations = 0.0;
+    for (double time : times) {
+        sumOfSquareDeviations += (time - mean) * (time - mean);
+    }
+
+    const ::testing::TestInfo* const testInfo =
+        ::testing::UnitTest::GetInstance()->current_test_info();
+
+    DawnPerfTestResult result;
+    result.name = std::string(testInfo->test_suite_name()) + "." + testInfo->name();
+    result.iterationsPerStep = mIterationsPerStep;
+    result.stepCount = times.size();
+    result.meanWallTimeNs = mean;
+    result.medianWallTimeNs = GetPercentile(times, 50);
+    result.p90WallTimeNs = GetPercentile(times, 90);
+    result.p99WallTimeNs = GetPercentile(times, 99);
+    result.stddevWallTimeNs = std::sqrt(sumOfSquareDeviations / times.size());
+    result.cpuTimeNs = cpuTimeSeconds * kNanoSecondsPerSecond / iterationCount;
+    result.heapAllocations = heapAllocationCount / iterationCount;
+    result.peakResidentSetSizeKB = GetPeakResidentSetSizeKB();
+
+    PrintResult("wall_time_median", result.medianWallTimeNs, "ns", false);
+    PrintResult("wall_time_p90", result.p90WallTimeNs, "ns", false);
+    PrintResult("wall_time_p99", result.p99WallTimeNs, "ns", false);
+    PrintResult("wall_time_stddev", result.stddevWallTimeNs, "ns", false);
+    PrintResult("cpu_time", result.cpuTimeNs, "ns", false);
+    PrintResult("peak_rss", static_cast<double>(result.peakResidentSetSizeKB), "KB", false);
+
+    gTestEnv->AddResult(result);
+
+    double baselineMedian = 0.0;
+    if (gTestEnv->GetBaselineMedianWallTimeNs(result.name, &baselineMedian)) {
+        double regression = result.medianWallTimeNs / baselineMedian - 1.0;
+        PrintResult("wall_time_median_vs_baseline", regression * 100.0, "%", false);
+        EXPECT_LE(regression, gTestEnv->GetRegressionThreshold())
+            << "The median wall time regressed from " << baselineMedian << " ns to "
+            << result.medianWallTimeNs << " ns";
     }
 }
 
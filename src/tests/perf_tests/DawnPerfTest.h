@@ -17,28 +17,68 @@
 
 #include "tests/DawnTest.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace utils {
     class Timer;
 }
 
 void InitDawnPerfTestEnvironment(int argc, char** argv);
 
+// The statistics of the measured trials of a test. The times are per iteration.
+struct DawnPerfTestResult {
+    std::string name;
+    unsigned int iterationsPerStep;
+    size_t stepCount;
+    double meanWallTimeNs;
+    double medianWallTimeNs;
+    double p90WallTimeNs;
+    double p99WallTimeNs;
+    double stddevWallTimeNs;
+    double cpuTimeNs;
+    double heapAllocations;
+    uint64_t peakResidentSetSizeKB;
+};
+
 class DawnPerfTestEnvironment : public DawnTestEnvironment {
   public:
     DawnPerfTestEnvironment(int argc, char** argv);
     ~DawnPerfTestEnvironment();
 
     void SetUp() override;
+    void TearDown() override;
 
     bool IsCalibrating() const;
     unsigned int OverrideStepsToRun() const;
 
+    // Records the result to be written in the JSON output file, if any.
+    void AddResult(const DawnPerfTestResult& result);
+
+    // Returns false if there is no baseline for the test.
+    bool GetBaselineMedianWallTimeNs(const std::string& testName, double* median) const;
+    double GetRegressionThreshold() const;
+
   private:
+    bool LoadBaseline();
+    bool WriteJsonResults() const;
+
     // Only run calibration which allows the perf test runner to save time.
     bool mIsCalibrating = false;
 
     // If non-zero, overrides the number of steps.
     unsigned int mOverrideStepsToRun = 0;
+
+    // The results are written to mJsonFile in TearDown if it isn't empty.
+    std::string mJsonFile;
+    std::vector<DawnPerfTestResult> mResults;
+
+    // The median wall times of a previous run written with --json, by test name. Tests more than
+    // mRegressionThreshold slower than their baseline fail.
+    std::string mBaselineFile;
+    std::map<std::string, double> mBaselineMedianWallTimesNs;
+    double mRegressionThreshold = 0.1;
 };
 
 // Dawn Perf Tests calls Step() of a derived class to measure its execution
@@ -48,6 +88,11 @@ class DawnPerfTestEnvironment : public DawnTestEnvironment {
 // |kMaximumRunTimeSeconds| is exceeded. |kNumTrials| are performed and the
 // results and averages per iteration** are printed.
 //
+// The time of each step of the trials is recorded, and the median, tail
+// percentiles and standard deviation of the time per iteration are printed
+// after the trials, along with the CPU time of the process and its peak
+// resident set size.
+//
 // The results are printed according to the format specified at
 // [chromium]//build/scripts/slave/performance_log_processor.py
 //
@@ -82,6 +127,7 @@ class DawnPerfTestBase {
   private:
     void DoRunLoop(double maxRunTime);
     void PrintResults();
+    void PrintStatistics(double cpuTimeSeconds, uint64_t heapAllocationCount);
 
     virtual void Step() = 0;
 
@@ -90,7 +136,10 @@ class DawnPerfTestBase {
     unsigned int mIterationsPerStep;
     unsigned int mStepsToRun = 0;
     unsigned int mNumStepsPerformed = 0;
-    uint64_t mGPUTimeNs = 0;  // TODO(enga): Measure GPU time with timing queries.
+    uint64_t mHeapAllocationCount = 0;
+    // The duration of each step of the trials, in seconds.
+    bool mRecordStepTimes = false;
+    std::vector<double> mStepTimes;
     std::unique_ptr<utils::Timer> mTimer;
 };
 
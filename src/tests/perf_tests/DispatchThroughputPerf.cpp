@@ -0,0 +1,160 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumDispatches = 10;
+    constexpr uint32_t kWorkgroupSize = 64;
+    constexpr uint32_t kMaxWorkgroupCount = 4096;
+    constexpr uint64_t kBufferSize =
+        static_cast<uint64_t>(kMaxWorkgroupCount) * kWorkgroupSize * sizeof(uint32_t);
+
+    // Each invocation reads a word, runs a few iterations of a linear congruential generator on
+    // it and writes the result.
+    constexpr char kComputeShader[] = R"(
+        #version 450
+        layout(local_size_x = 64) in;
+        layout(std430, set = 0, binding = 0) buffer Src { uint src[]; };
+        layout(std430, set = 0, binding = 1) buffer Dst { uint dst[]; };
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            uint value = src[index];
+            for (uint i = 0; i < 16; ++i) {
+                value = value * 1664525u + 1013904223u;
+            }
+            dst[index] = value;
+        })";
+
+    enum class DispatchSize {
+        // A single workgroup, which measures the overhead of each dispatch.
+        Small,
+        // kMaxWorkgroupCount workgroups, which measures the execution of the invocations.
+        Large,
+    };
+
+    struct DispatchThroughputParams : DawnTestParam {
+        DispatchThroughputParams(const DawnTestParam& param, DispatchSize dispatchSize)
+            : DawnTestParam(param), dispatchSize(dispatchSize) {
+        }
+
+        DispatchSize dispatchSize;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const DispatchThroughputParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.dispatchSize) {
+            case DispatchSize::Small:
+                ostream << "_Small";
+                break;
+            case DispatchSize::Large:
+                ostream << "_Large";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test recording |kNumDispatches| dispatches of a simple compute shader in a pass and waiting
+// for them. On the null backend this measures the compute shaders executed on the CPU.
+class DispatchThroughputPerf : public DawnPerfTestWithParams<DispatchThroughputParams> {
+  public:
+    DispatchThroughputPerf() : DawnPerfTestWithParams(kNumDispatches) {
+    }
+    ~DispatchThroughputPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    dawn::ComputePipeline mPipeline;
+    dawn::BindGroup mBindGroup;
+};
+
+void DispatchThroughputPerf::SetUp() {
+    DawnPerfTestWithParams<DispatchThroughputParams>::SetUp();
+
+    dawn::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {
+                    {0, dawn::ShaderStage::Compute, dawn::BindingType::StorageBuffer},
+                    {1, dawn::ShaderStage::Compute, dawn::BindingType::StorageBuffer},
+                });
+
+    dawn::ComputePipelineDescriptor csDesc;
+    csDesc.layout = utils::MakeBasicPipelineLayout(device, &bgl);
+    csDesc.computeStage.module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, kComputeShader);
+    csDesc.computeStage.entryPoint = "main";
+    mPipeline = device.CreateComputePipeline(&csDesc);
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = kBufferSize;
+    descriptor.usage = dawn::BufferUsage::Storage | dawn::BufferUsage::CopyDst;
+    dawn::Buffer source = device.CreateBuffer(&descriptor);
+    dawn::Buffer destination = device.CreateBuffer(&descriptor);
+
+    std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t));
+    for (uint32_t i = 0; i < data.size(); ++i) {
+        data[i] = i;
+    }
+    source.SetSubData(0, kBufferSize, data.data());
+
+    mBindGroup = utils::MakeBindGroup(device, bgl,
+                                      {
+                                          {0, source, 0, kBufferSize},
+                                          {1, destination, 0, kBufferSize},
+                                      });
+}
+
+void DispatchThroughputPerf::Step() {
+    uint32_t workgroupCount = 1;
+    switch (GetParam().dispatchSize) {
+        case DispatchSize::Small:
+            workgroupCount = 1;
+            break;
+        case DispatchSize::Large:
+            workgroupCount = kMaxWorkgroupCount;
+            break;
+    }
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    dawn::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(mPipeline);
+    pass.SetBindGroup(0, mBindGroup, 0, nullptr);
+    for (unsigned int i = 0; i < kNumDispatches; ++i) {
+        pass.Dispatch(workgroupCount, 1, 1);
+    }
+    pass.EndPass();
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Wait for the GPU so that the dispatches are part of the measured time.
+    WaitForGPU();
+}
+
+TEST_P(DispatchThroughputPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
+    DispatchThroughputPerf,
+    {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend, VulkanBackend},
+    {DispatchSize::Small, DispatchSize::Large});
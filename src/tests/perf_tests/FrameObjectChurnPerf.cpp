@@ -0,0 +1,102 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumFrames = 1000;
+    constexpr uint32_t kRenderTargetSize = 4;
+
+}  // namespace
+
+// Test creating and releasing the objects that are typically made every frame: a texture view,
+// a bind group, a command encoder, a compute and a render pass, and a command buffer. On the
+// null backend this measures the cost of the frontend objects alone, and heap_allocations shows
+// how many allocations are left per frame.
+class FrameObjectChurnPerf : public DawnPerfTest {
+  public:
+    FrameObjectChurnPerf() : DawnPerfTest(kNumFrames) {
+    }
+    ~FrameObjectChurnPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    dawn::Texture mRenderTarget;
+    dawn::Buffer mUniformBuffer;
+    dawn::BindGroupLayout mBindGroupLayout;
+};
+
+void FrameObjectChurnPerf::SetUp() {
+    DawnPerfTest::SetUp();
+
+    dawn::TextureDescriptor textureDesc;
+    textureDesc.dimension = dawn::TextureDimension::e2D;
+    textureDesc.size = {kRenderTargetSize, kRenderTargetSize, 1};
+    textureDesc.arrayLayerCount = 1;
+    textureDesc.sampleCount = 1;
+    textureDesc.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = dawn::TextureUsage::OutputAttachment;
+    mRenderTarget = device.CreateTexture(&textureDesc);
+
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = 256;
+    bufferDesc.usage = dawn::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+    mBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Compute, dawn::BindingType::UniformBuffer}});
+}
+
+void FrameObjectChurnPerf::Step() {
+    for (unsigned int i = 0; i < kNumFrames; ++i) {
+        dawn::TextureView renderTargetView = mRenderTarget.CreateView();
+        dawn::BindGroup bindGroup =
+            utils::MakeBindGroup(device, mBindGroupLayout, {{0, mUniformBuffer, 0, 16}});
+
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        {
+            dawn::ComputePassEncoder pass = encoder.BeginComputePass();
+            pass.SetBindGroup(0, bindGroup, 0, nullptr);
+            pass.EndPass();
+        }
+        {
+            utils::ComboRenderPassDescriptor renderPass({renderTargetView});
+            dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+            pass.EndPass();
+        }
+        dawn::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    // Wait for the GPU so the command buffers are released before the next step.
+    WaitForGPU();
+}
+
+TEST_P(FrameObjectChurnPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(FrameObjectChurnPerf,
+                      NullBackend,
+                      D3D12Backend,
+                      MetalBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
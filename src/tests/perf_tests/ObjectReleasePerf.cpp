@@ -0,0 +1,176 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/DawnHelpers.h"
+
+#include <array>
+#include <chrono>
+#include <string>
+
+namespace {
+
+    constexpr unsigned int kNumObjects = 100;
+    constexpr size_t kBufferSize = 256;
+
+    // Histogram of durations with one bucket per power of two nanoseconds.
+    class LatencyHistogram {
+      public:
+        void Add(uint64_t nanoseconds) {
+            size_t bucket = 0;
+            while (bucket + 1 < kBucketCount && (uint64_t(2) << bucket) <= nanoseconds) {
+                bucket++;
+            }
+            mBuckets[bucket]++;
+            mCount++;
+            mMax = std::max(mMax, nanoseconds);
+        }
+
+        // Returns the upper bound of the bucket containing the given percentile.
+        uint64_t GetPercentileUpperBound(double percentile) const {
+            uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * mCount);
+            uint64_t count = 0;
+            for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+                count += mBuckets[bucket];
+                if (count > rank) {
+                    return uint64_t(2) << bucket;
+                }
+            }
+            return mMax;
+        }
+
+        uint64_t GetBucketCount(size_t bucket) const {
+            return mBuckets[bucket];
+        }
+        uint64_t GetMax() const {
+            return mMax;
+        }
+
+        static constexpr size_t kBucketCount = 32;
+
+      private:
+        std::array<uint64_t, kBucketCount> mBuckets = {};
+        uint64_t mCount = 0;
+        uint64_t mMax = 0;
+    };
+
+}  // namespace
+
+// Test the latency of releasing the last reference to buffers, textures and bind groups, like an
+// engine does on its render thread. Without the defer_object_deletion toggle the objects are
+// deleted in Release(). With it they are deleted at the next tick, which is part of the wall
+// time but not of the release latency. Each Release() is timed and the latencies are reported as
+// percentiles and as a histogram of power of two buckets in nanoseconds.
+class ObjectReleasePerf : public DawnPerfTest {
+  public:
+    ObjectReleasePerf() : DawnPerfTest(kNumObjects) {
+    }
+    ~ObjectReleasePerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    void PrintLatencies() const;
+
+  private:
+    void Step() override;
+
+    template <typename CType>
+    void TimeRelease(CType object, void (*release)(CType));
+
+    dawn::BindGroupLayout mBindGroupLayout;
+    LatencyHistogram mLatencies;
+};
+
+void ObjectReleasePerf::SetUp() {
+    DawnPerfTest::SetUp();
+
+    mBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Compute, dawn::BindingType::UniformBuffer}});
+}
+
+template <typename CType>
+void ObjectReleasePerf::TimeRelease(CType object, void (*release)(CType)) {
+    auto start = std::chrono::steady_clock::now();
+    release(object);
+    auto end = std::chrono::steady_clock::now();
+
+    mLatencies.Add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+void ObjectReleasePerf::Step() {
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = kBufferSize;
+    bufferDesc.usage = dawn::BufferUsage::Uniform;
+
+    dawn::TextureDescriptor textureDesc;
+    textureDesc.dimension = dawn::TextureDimension::e2D;
+    textureDesc.size = {4, 4, 1};
+    textureDesc.arrayLayerCount = 1;
+    textureDesc.sampleCount = 1;
+    textureDesc.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDesc.mipLevelCount = 1;
+    textureDesc.usage = dawn::TextureUsage::Sampled;
+
+    for (unsigned int i = 0; i < kNumObjects; ++i) {
+        dawn::Buffer buffer = device.CreateBuffer(&bufferDesc);
+        dawn::Texture texture = device.CreateTexture(&textureDesc);
+        dawn::BindGroup bindGroup =
+            utils::MakeBindGroup(device, mBindGroupLayout, {{0, buffer, 0, kBufferSize}});
+
+        TimeRelease(texture.Release(), dawnTextureRelease);
+        TimeRelease(buffer.Release(), dawnBufferRelease);
+        // The bind group holds the last reference to the buffer.
+        TimeRelease(bindGroup.Release(), dawnBindGroupRelease);
+    }
+
+    // The deferred objects are deleted when the device is ticked.
+    device.Tick();
+}
+
+void ObjectReleasePerf::PrintLatencies() const {
+    PrintResult("release_p50", static_cast<double>(mLatencies.GetPercentileUpperBound(50)), "ns",
+                false);
+    PrintResult("release_p99", static_cast<double>(mLatencies.GetPercentileUpperBound(99)), "ns",
+                false);
+    PrintResult("release_p99.9", static_cast<double>(mLatencies.GetPercentileUpperBound(99.9)),
+                "ns", false);
+    PrintResult("release_max", static_cast<double>(mLatencies.GetMax()), "ns", false);
+
+    for (size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+        uint64_t count = mLatencies.GetBucketCount(bucket);
+        if (count != 0) {
+            std::string trace = "release_histogram_lt_" + std::to_string(uint64_t(2) << bucket);
+            PrintResult(trace, static_cast<double>(count), "count", false);
+        }
+    }
+}
+
+TEST_P(ObjectReleasePerf, Run) {
+    RunTest();
+    PrintLatencies();
+}
+
+DAWN_INSTANTIATE_TEST(ObjectReleasePerf,
+                      NullBackend,
+                      ForceWorkarounds(NullBackend, {"defer_object_deletion"}),
+                      D3D12Backend,
+                      ForceWorkarounds(D3D12Backend, {"defer_object_deletion"}),
+                      MetalBackend,
+                      ForceWorkarounds(MetalBackend, {"defer_object_deletion"}),
+                      OpenGLBackend,
+                      ForceWorkarounds(OpenGLBackend, {"defer_object_deletion"}),
+                      VulkanBackend,
+                      ForceWorkarounds(VulkanBackend, {"defer_object_deletion"}));
@@ -0,0 +1,156 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumDraws = 1000;
+    constexpr unsigned int kNumMaterials = 4;
+    constexpr uint32_t kRenderTargetSize = 4;
+
+}  // namespace
+
+// Test recording draws like engines that set all the state of each draw, even when most of it is
+// the same as for the previous draw: only the material bind group changes every few draws. With
+// the eliminate_redundant_commands toggle the backend receives the compacted commands, and
+// commands_removed reports how many commands were removed per draw.
+class RedundantCommandsPerf : public DawnPerfTest {
+  public:
+    RedundantCommandsPerf() : DawnPerfTest(kNumDraws) {
+    }
+    ~RedundantCommandsPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    double mRemovedCommandsPerDraw = 0;
+
+  private:
+    void Step() override;
+
+    utils::BasicRenderPass mRenderPass;
+    dawn::RenderPipeline mPipeline;
+    dawn::Buffer mVertexBuffer;
+    dawn::BindGroup mFrameBindGroup;
+    dawn::BindGroup mMaterialBindGroups[kNumMaterials];
+};
+
+void RedundantCommandsPerf::SetUp() {
+    DawnPerfTest::SetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kRenderTargetSize, kRenderTargetSize);
+
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = 256;
+    bufferDesc.usage = dawn::BufferUsage::Uniform | dawn::BufferUsage::Vertex;
+    mVertexBuffer = device.CreateBuffer(&bufferDesc);
+
+    dawn::BindGroupLayout frameLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer}});
+    dawn::BindGroupLayout materialLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Fragment, dawn::BindingType::UniformBuffer}});
+
+    mFrameBindGroup = utils::MakeBindGroup(device, frameLayout, {{0, mVertexBuffer, 0, 16}});
+    for (unsigned int i = 0; i < kNumMaterials; ++i) {
+        mMaterialBindGroups[i] =
+            utils::MakeBindGroup(device, materialLayout, {{0, mVertexBuffer, 0, 16}});
+    }
+
+    dawn::ShaderModule vsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+        #version 450
+        layout(location = 0) in vec4 pos;
+        layout(set = 0, binding = 0) uniform Frame {
+            vec4 offset;
+        };
+        void main() {
+            gl_Position = pos + offset;
+        })");
+
+    dawn::ShaderModule fsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+        #version 450
+        layout(set = 1, binding = 0) uniform Material {
+            vec4 color;
+        };
+        layout(location = 0) out vec4 fragColor;
+        void main() {
+            fragColor = color;
+        })");
+
+    dawn::BindGroupLayout layouts[2] = {frameLayout, materialLayout};
+    dawn::PipelineLayoutDescriptor pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayoutCount = 2;
+    pipelineLayoutDesc.bindGroupLayouts = layouts;
+
+    utils::ComboRenderPipelineDescriptor descriptor(device);
+    descriptor.layout = device.CreatePipelineLayout(&pipelineLayoutDesc);
+    descriptor.vertexStage.module = vsModule;
+    descriptor.cFragmentStage.module = fsModule;
+    descriptor.cVertexInput.bufferCount = 1;
+    descriptor.cVertexInput.cBuffers[0].stride = 4 * sizeof(float);
+    descriptor.cVertexInput.cBuffers[0].attributeCount = 1;
+    descriptor.cVertexInput.cAttributes[0].format = dawn::VertexFormat::Float4;
+    descriptor.cColorStates[0]->format = mRenderPass.colorFormat;
+    mPipeline = device.CreateRenderPipeline(&descriptor);
+}
+
+void RedundantCommandsPerf::Step() {
+    size_t removedCountBefore = dawn_native::GetRemovedCommandCountForTesting(backendDevice);
+
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+    uint64_t zeroOffset = 0;
+    for (unsigned int i = 0; i < kNumDraws; ++i) {
+        pass.SetPipeline(mPipeline);
+        pass.SetBindGroup(0, mFrameBindGroup, 0, nullptr);
+        pass.SetBindGroup(1, mMaterialBindGroups[(i / 8) % kNumMaterials], 0, nullptr);
+        pass.SetVertexBuffers(0, 1, &mVertexBuffer, &zeroOffset);
+        pass.SetViewport(0, 0, kRenderTargetSize, kRenderTargetSize, 0, 1);
+        pass.SetScissorRect(0, 0, kRenderTargetSize, kRenderTargetSize);
+        pass.Draw(3, 1, 0, 0);
+    }
+    pass.EndPass();
+
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Wait for the GPU so the command buffers are released before the next step.
+    WaitForGPU();
+
+    size_t removedCount =
+        dawn_native::GetRemovedCommandCountForTesting(backendDevice) - removedCountBefore;
+    mRemovedCommandsPerDraw = static_cast<double>(removedCount) / kNumDraws;
+}
+
+TEST_P(RedundantCommandsPerf, Run) {
+    RunTest();
+    PrintResult("commands_removed", mRemovedCommandsPerDraw, "count", false);
+}
+
+DAWN_INSTANTIATE_TEST(RedundantCommandsPerf,
+                      NullBackend,
+                      ForceWorkarounds(NullBackend, {"eliminate_redundant_commands"}),
+                      D3D12Backend,
+                      ForceWorkarounds(D3D12Backend, {"eliminate_redundant_commands"}),
+                      MetalBackend,
+                      ForceWorkarounds(MetalBackend, {"eliminate_redundant_commands"}),
+                      OpenGLBackend,
+                      ForceWorkarounds(OpenGLBackend, {"eliminate_redundant_commands"}),
+                      VulkanBackend,
+                      ForceWorkarounds(VulkanBackend, {"eliminate_redundant_commands"}));
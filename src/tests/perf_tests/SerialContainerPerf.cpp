@@ -0,0 +1,109 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/SerialMap.h"
+#include "common/SerialQueue.h"
+
+namespace {
+
+    constexpr unsigned int kSerialsPerStep = 1000;
+    constexpr Serial kSerialsInFlight = 3;
+
+}  // namespace
+
+// Test the typical usage of SerialQueue: a few values are enqueued for each serial and cleared a
+// couple serials later when the GPU completes them. The time is per value. The containers don't
+// use the device so the test only runs on the null backend.
+class SerialQueuePerf : public DawnPerfTest {
+  public:
+    static constexpr unsigned int kValuesPerSerial = 8;
+
+    SerialQueuePerf() : DawnPerfTest(kSerialsPerStep * kValuesPerSerial) {
+    }
+    ~SerialQueuePerf() override = default;
+
+  private:
+    void Step() override;
+
+    SerialQueue<int> mQueue;
+    Serial mNextSerial = 0;
+    int mSum = 0;
+};
+
+void SerialQueuePerf::Step() {
+    for (unsigned int i = 0; i < kSerialsPerStep; ++i) {
+        Serial serial = mNextSerial++;
+        for (unsigned int j = 0; j < kValuesPerSerial; ++j) {
+            mQueue.Enqueue(static_cast<int>(j), serial);
+        }
+        if (serial >= kSerialsInFlight) {
+            for (int value : mQueue.IterateUpTo(serial - kSerialsInFlight)) {
+                mSum += value;
+            }
+            mQueue.ClearUpTo(serial - kSerialsInFlight);
+        }
+    }
+}
+
+TEST_P(SerialQueuePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(SerialQueuePerf, NullBackend);
+
+// Test the typical usage of SerialMap: fence values are mostly enqueued in increasing order and
+// cleared when the fence completes them. The time is per value.
+class SerialMapPerf : public DawnPerfTest {
+  public:
+    SerialMapPerf() : DawnPerfTest(kSerialsPerStep) {
+    }
+    ~SerialMapPerf() override = default;
+
+  private:
+    void Step() override;
+
+    SerialMap<int> mMap;
+    Serial mNextSerial = 0;
+    int mCount = 0;
+};
+
+void SerialMapPerf::Step() {
+    for (unsigned int i = 0; i < kSerialsPerStep; i += 2) {
+        Serial serial = mNextSerial;
+        mNextSerial += 2;
+
+        // Every other pair of values is enqueued out of order.
+        if (serial % 4 == 0) {
+            mMap.Enqueue(1, serial + 1);
+            mMap.Enqueue(0, serial);
+        } else {
+            mMap.Enqueue(0, serial);
+            mMap.Enqueue(1, serial + 1);
+        }
+        if (serial >= kSerialsInFlight) {
+            for (int value : mMap.IterateUpTo(serial - kSerialsInFlight)) {
+                mCount += value;
+            }
+            mMap.ClearUpTo(serial - kSerialsInFlight);
+        }
+    }
+}
+
+TEST_P(SerialMapPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(SerialMapPerf, NullBackend);
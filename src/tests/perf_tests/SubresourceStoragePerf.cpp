@@ -0,0 +1,77 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/SubresourceStorage.h"
+
+namespace {
+
+    constexpr uint32_t kMipLevelCount = 12;
+    constexpr uint32_t kArrayLayerCount = 2048;
+    constexpr uint32_t kUniformCheckCount = 10000;
+
+    // Each subresource is updated once, the whole texture is checked after each layer and then
+    // a number of times once it is initialized.
+    constexpr unsigned int kOperationsPerStep =
+        kMipLevelCount * kArrayLayerCount + kArrayLayerCount + kUniformCheckCount;
+
+}  // namespace
+
+// Test the lazy clear tracking of a large texture array: each layer is initialized one
+// subresource at a time while the whole texture is checked, which would loop over every
+// subresource without compression. The time is per update or check. The storage doesn't use the
+// device so the test only runs on the null backend.
+class SubresourceStoragePerf : public DawnPerfTest {
+  public:
+    SubresourceStoragePerf() : DawnPerfTest(kOperationsPerStep) {
+    }
+    ~SubresourceStoragePerf() override = default;
+
+  private:
+    void Step() override;
+
+    uint32_t mInitializedCount = 0;
+};
+
+void SubresourceStoragePerf::Step() {
+    dawn_native::SubresourceStorage<bool> storage(kMipLevelCount, kArrayLayerCount, false);
+    for (uint32_t layer = 0; layer < kArrayLayerCount; ++layer) {
+        for (uint32_t level = 0; level < kMipLevelCount; ++level) {
+            storage.Update(dawn_native::SubresourceRange::SingleSubresource(level, layer),
+                           [](const dawn_native::SubresourceRange&, bool* data) { *data = true; });
+        }
+
+        bool isInitialized = true;
+        storage.Iterate([&](const dawn_native::SubresourceRange&, const bool& data) {
+            isInitialized &= data;
+        });
+        mInitializedCount += isInitialized;
+    }
+
+    // Once initialized, the whole texture is a single value.
+    for (uint32_t i = 0; i < kUniformCheckCount; ++i) {
+        bool isInitialized = true;
+        storage.Iterate([&](const dawn_native::SubresourceRange&, const bool& data) {
+            isInitialized &= data;
+        });
+        mInitializedCount += isInitialized;
+    }
+}
+
+TEST_P(SubresourceStoragePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(SubresourceStoragePerf, NullBackend);
@@ -0,0 +1,248 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Constants.h"
+#include "common/Math.h"
+#include "tests/ParamGenerator.h"
+#include "utils/DawnHelpers.h"
+
+#include <cstring>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1;
+
+    // One 4x4 block less than 4K in width so that the tightly packed rows aren't 256-byte aligned
+    // for both RGBA8 and BC1.
+    constexpr uint32_t kTextureWidth = 3840 - 4;
+    constexpr uint32_t kTextureHeight = 2160;
+
+    enum class UploadFormat {
+        RGBA8,
+        BC1,
+    };
+
+    enum class UploadMethod {
+        // The data is written to a mapped buffer and copied to the texture with a command.
+        MapAndCopy,
+        // The data is written with Queue::WriteTexture.
+        WriteTexture,
+    };
+
+    enum class RowLayout {
+        // The application repacks the rows on the CPU so that the row pitch is 256-byte aligned.
+        Aligned,
+        // The application copies the tightly packed data as is.
+        TightlyPacked,
+    };
+
+    struct TextureUploadParams : DawnTestParam {
+        TextureUploadParams(const DawnTestParam& param,
+                            UploadFormat uploadFormat,
+                            UploadMethod uploadMethod,
+                            RowLayout rowLayout)
+            : DawnTestParam(param),
+              uploadFormat(uploadFormat),
+              uploadMethod(uploadMethod),
+              rowLayout(rowLayout) {
+        }
+
+        UploadFormat uploadFormat;
+        UploadMethod uploadMethod;
+        RowLayout rowLayout;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const TextureUploadParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.uploadFormat) {
+            case UploadFormat::RGBA8:
+                ostream << "_RGBA8";
+                break;
+            case UploadFormat::BC1:
+                ostream << "_BC1";
+                break;
+        }
+
+        switch (param.uploadMethod) {
+            case UploadMethod::MapAndCopy:
+                ostream << "_MapAndCopy";
+                break;
+            case UploadMethod::WriteTexture:
+                ostream << "_WriteTexture";
+                break;
+        }
+
+        switch (param.rowLayout) {
+            case RowLayout::Aligned:
+                ostream << "_Aligned";
+                break;
+            case RowLayout::TightlyPacked:
+                ostream << "_TightlyPacked";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test uploading a tightly packed 4K image to a texture, either through a mapped buffer and a
+// buffer-to-texture copy or with Queue::WriteTexture. The rows are either repacked to a 256-byte
+// aligned row pitch first or uploaded with the tightly packed row pitch.
+class TextureUploadPerf : public DawnPerfTestWithParams<TextureUploadParams> {
+  public:
+    TextureUploadPerf() : DawnPerfTestWithParams(kNumIterations) {
+    }
+    ~TextureUploadPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override;
+
+    bool mIsFormatSupported = true;
+
+  private:
+    void Step() override;
+    // Writes the image to |destination| with the given row pitch.
+    void WriteRows(uint8_t* destination, uint32_t rowPitch) const;
+
+    dawn::Texture mTexture;
+    // The tightly packed data of the image.
+    std::vector<uint8_t> mData;
+    // The data of the image repacked to an aligned row pitch, for WriteTexture.
+    std::vector<uint8_t> mAlignedData;
+    uint32_t mRowSize = 0;
+    uint32_t mRowCount = 0;
+};
+
+std::vector<const char*> TextureUploadPerf::GetRequiredExtensions() {
+    if (GetParam().uploadFormat != UploadFormat::BC1) {
+        return {};
+    }
+
+    mIsFormatSupported = SupportsExtensions({"texture_compression_bc"});
+    if (!mIsFormatSupported) {
+        return {};
+    }
+    return {"texture_compression_bc"};
+}
+
+void TextureUploadPerf::SetUp() {
+    DawnPerfTestWithParams<TextureUploadParams>::SetUp();
+    if (!mIsFormatSupported) {
+        return;
+    }
+
+    dawn::TextureDescriptor descriptor;
+    descriptor.size = {kTextureWidth, kTextureHeight, 1};
+    descriptor.usage = dawn::TextureUsage::CopyDst | dawn::TextureUsage::Sampled;
+
+    switch (GetParam().uploadFormat) {
+        case UploadFormat::RGBA8:
+            descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+            mRowSize = kTextureWidth * 4;
+            mRowCount = kTextureHeight;
+            break;
+        case UploadFormat::BC1:
+            descriptor.format = dawn::TextureFormat::BC1RGBAUnorm;
+            mRowSize = kTextureWidth / 4 * 8;
+            mRowCount = kTextureHeight / 4;
+            break;
+    }
+
+    mTexture = device.CreateTexture(&descriptor);
+
+    mData.resize(static_cast<size_t>(mRowSize) * mRowCount);
+    for (size_t i = 0; i < mData.size(); ++i) {
+        mData[i] = static_cast<uint8_t>(i);
+    }
+}
+
+void TextureUploadPerf::Step() {
+    uint32_t rowPitch = mRowSize;
+    if (GetParam().rowLayout == RowLayout::Aligned) {
+        rowPitch = Align(mRowSize, kTextureRowPitchAlignment);
+    }
+    uint64_t dataSize = static_cast<uint64_t>(rowPitch) * (mRowCount - 1) + mRowSize;
+
+    dawn::TextureCopyView textureCopyView =
+        utils::CreateTextureCopyView(mTexture, 0, 0, {0, 0, 0});
+    dawn::Extent3D copySize = {kTextureWidth, kTextureHeight, 1};
+
+    switch (GetParam().uploadMethod) {
+        case UploadMethod::MapAndCopy: {
+            dawn::BufferDescriptor descriptor;
+            descriptor.size = dataSize;
+            descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::MapWrite;
+            dawn::CreateBufferMappedResult result = device.CreateBufferMapped(&descriptor);
+            WriteRows(static_cast<uint8_t*>(result.data), rowPitch);
+            result.buffer.Unmap();
+
+            dawn::BufferCopyView bufferCopyView =
+                utils::CreateBufferCopyView(result.buffer, 0, rowPitch, 0);
+
+            dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+            encoder.CopyBufferToTexture(&bufferCopyView, &textureCopyView, &copySize);
+            dawn::CommandBuffer commands = encoder.Finish();
+            queue.Submit(1, &commands);
+        } break;
+
+        case UploadMethod::WriteTexture: {
+            const uint8_t* data = mData.data();
+            if (GetParam().rowLayout == RowLayout::Aligned) {
+                mAlignedData.resize(dataSize);
+                WriteRows(mAlignedData.data(), rowPitch);
+                data = mAlignedData.data();
+            }
+
+            dawn::TextureDataLayout dataLayout;
+            dataLayout.rowPitch = rowPitch;
+            queue.WriteTexture(&textureCopyView, data, dataSize, &dataLayout, &copySize);
+            // Make sure the write is flushed.
+            queue.Submit(0, nullptr);
+        } break;
+    }
+
+    // Wait for the GPU so that the repacking done by the backend, if any, is measured.
+    WaitForGPU();
+}
+
+void TextureUploadPerf::WriteRows(uint8_t* destination, uint32_t rowPitch) const {
+    if (rowPitch == mRowSize) {
+        memcpy(destination, mData.data(), mData.size());
+        return;
+    }
+
+    const uint8_t* source = mData.data();
+    for (uint32_t row = 0; row < mRowCount; ++row) {
+        memcpy(destination, source, mRowSize);
+        destination += rowPitch;
+        source += mRowSize;
+    }
+}
+
+TEST_P(TextureUploadPerf, Run) {
+    DAWN_SKIP_TEST_IF(!mIsFormatSupported);
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(TextureUploadPerf,
+                                   {D3D12Backend, MetalBackend, NullBackend, OpenGLBackend,
+                                    VulkanBackend},
+                                   {UploadFormat::RGBA8, UploadFormat::BC1},
+                                   {UploadMethod::MapAndCopy, UploadMethod::WriteTexture},
+                                   {RowLayout::Aligned, RowLayout::TightlyPacked});
@@ -0,0 +1,187 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1000;
+    constexpr uint32_t kRenderTargetSize = 4;
+    constexpr uint64_t kUniformSize = 256;
+
+    enum class Workload {
+        Draw,
+        BindGroup,
+        Submit,
+    };
+
+    struct ValidationOverheadParams : DawnTestParam {
+        ValidationOverheadParams(const DawnTestParam& param, Workload workload)
+            : DawnTestParam(param), workload(workload) {
+        }
+
+        Workload workload;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const ValidationOverheadParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.workload) {
+            case Workload::Draw:
+                ostream << "_Draw";
+                break;
+            case Workload::BindGroup:
+                ostream << "_BindGroup";
+                break;
+            case Workload::Submit:
+                ostream << "_Submit";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the cost of the API calls that are made the most often: a draw with its bind group, the
+// creation of a bind group and the submit of a small command buffer. Each workload is run on
+// devices with and without the skip_validation toggle to show the cost of the validation.
+class ValidationOverheadPerf : public DawnPerfTestWithParams<ValidationOverheadParams> {
+  public:
+    ValidationOverheadPerf() : DawnPerfTestWithParams(kNumIterations) {
+    }
+    ~ValidationOverheadPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    utils::BasicRenderPass mRenderPass;
+    dawn::RenderPipeline mPipeline;
+    dawn::BindGroupLayout mBindGroupLayout;
+    dawn::BindGroup mBindGroup;
+    dawn::Buffer mVertexBuffer;
+    dawn::Buffer mUniformBuffer;
+    dawn::Buffer mSourceBuffer;
+    dawn::Buffer mDestinationBuffer;
+};
+
+void ValidationOverheadPerf::SetUp() {
+    DawnPerfTestWithParams<ValidationOverheadParams>::SetUp();
+
+    mRenderPass = utils::CreateBasicRenderPass(device, kRenderTargetSize, kRenderTargetSize);
+
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = kUniformSize * 4;
+    bufferDesc.usage = dawn::BufferUsage::Uniform;
+    mUniformBuffer = device.CreateBuffer(&bufferDesc);
+
+    bufferDesc.size = 4 * 4 * sizeof(float);
+    bufferDesc.usage = dawn::BufferUsage::Vertex;
+    mVertexBuffer = device.CreateBuffer(&bufferDesc);
+
+    bufferDesc.size = 4;
+    bufferDesc.usage = dawn::BufferUsage::CopySrc;
+    mSourceBuffer = device.CreateBuffer(&bufferDesc);
+    bufferDesc.usage = dawn::BufferUsage::CopyDst;
+    mDestinationBuffer = device.CreateBuffer(&bufferDesc);
+
+    mBindGroupLayout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer, true}});
+    mBindGroup =
+        utils::MakeBindGroup(device, mBindGroupLayout, {{0, mUniformBuffer, 0, kUniformSize}});
+
+    dawn::ShaderModule vsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+        #version 450
+        layout(location = 0) in vec4 pos;
+        layout(set = 0, binding = 0) uniform Uniforms {
+            vec4 offset;
+        };
+        void main() {
+            gl_Position = pos + offset;
+        })");
+
+    dawn::ShaderModule fsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+        #version 450
+        layout(location = 0) out vec4 fragColor;
+        void main() {
+            fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+        })");
+
+    utils::ComboRenderPipelineDescriptor descriptor(device);
+    descriptor.layout = utils::MakeBasicPipelineLayout(device, &mBindGroupLayout);
+    descriptor.vertexStage.module = vsModule;
+    descriptor.cFragmentStage.module = fsModule;
+    descriptor.cVertexInput.bufferCount = 1;
+    descriptor.cVertexInput.cBuffers[0].stride = 4 * sizeof(float);
+    descriptor.cVertexInput.cBuffers[0].attributeCount = 1;
+    descriptor.cVertexInput.cAttributes[0].format = dawn::VertexFormat::Float4;
+    descriptor.cColorStates[0]->format = mRenderPass.colorFormat;
+    mPipeline = device.CreateRenderPipeline(&descriptor);
+}
+
+void ValidationOverheadPerf::Step() {
+    switch (GetParam().workload) {
+        case Workload::Draw: {
+            dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+            dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&mRenderPass.renderPassInfo);
+            pass.SetPipeline(mPipeline);
+            uint64_t zeroOffset = 0;
+            pass.SetVertexBuffers(0, 1, &mVertexBuffer, &zeroOffset);
+            for (unsigned int i = 0; i < kNumIterations; ++i) {
+                uint64_t dynamicOffset = (i % 4) * kUniformSize;
+                pass.SetBindGroup(0, mBindGroup, 1, &dynamicOffset);
+                pass.Draw(3, 1, 0, 0);
+            }
+            pass.EndPass();
+
+            dawn::CommandBuffer commands = encoder.Finish();
+            queue.Submit(1, &commands);
+        } break;
+
+        case Workload::BindGroup: {
+            for (unsigned int i = 0; i < kNumIterations; ++i) {
+                dawn::BindGroup bindGroup = utils::MakeBindGroup(
+                    device, mBindGroupLayout, {{0, mUniformBuffer, 0, kUniformSize}});
+            }
+        } break;
+
+        case Workload::Submit: {
+            for (unsigned int i = 0; i < kNumIterations; ++i) {
+                dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+                encoder.CopyBufferToBuffer(mSourceBuffer, 0, mDestinationBuffer, 0, 4);
+                dawn::CommandBuffer commands = encoder.Finish();
+                queue.Submit(1, &commands);
+            }
+        } break;
+    }
+
+    // Wait for the GPU so the command buffers are released before the next step.
+    WaitForGPU();
+}
+
+TEST_P(ValidationOverheadPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
+    ValidationOverheadPerf,
+    {NullBackend, ForceWorkarounds(NullBackend, {"skip_validation"})},
+    {Workload::Draw, Workload::BindGroup, Workload::Submit});
@@ -0,0 +1,73 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumSetSubData = 16;
+    constexpr uint64_t kDataSize = 64 * 1024;
+
+}  // namespace
+
+// Test uploading data with SetSubData through the wire. The server uses the data in place in the
+// command buffer, so the time is dominated by the copies of the data. The time is per SetSubData.
+class WireDeserializePerf : public DawnPerfTest {
+  public:
+    WireDeserializePerf() : DawnPerfTest(kNumSetSubData), mData(kDataSize, 1) {
+    }
+    ~WireDeserializePerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    dawn::Buffer mBuffer;
+    std::vector<uint8_t> mData;
+};
+
+void WireDeserializePerf::SetUp() {
+    DawnPerfTest::SetUp();
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = kDataSize;
+    descriptor.usage = dawn::BufferUsage::CopyDst;
+    mBuffer = device.CreateBuffer(&descriptor);
+}
+
+void WireDeserializePerf::Step() {
+    for (unsigned int i = 0; i < kNumSetSubData; ++i) {
+        mBuffer.SetSubData(0, kDataSize, mData.data());
+    }
+
+    // Wait for the GPU so the cost of the server deserializing the commands is included.
+    WaitForGPU();
+}
+
+TEST_P(WireDeserializePerf, Run) {
+    // Deserialization only happens when using the wire.
+    DAWN_SKIP_TEST_IF(!UsesWire());
+
+    RunTest();
+}
+
+DAWN_INSTANTIATE_TEST(WireDeserializePerf,
+                      D3D12Backend,
+                      MetalBackend,
+                      NullBackend,
+                      OpenGLBackend,
+                      VulkanBackend);
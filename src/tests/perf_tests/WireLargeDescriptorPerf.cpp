@@ -0,0 +1,210 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/Assert.h"
+#include "common/Constants.h"
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+
+#include <sstream>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumBindGroups = 10000;
+    constexpr unsigned int kNumRenderPipelines = 100;
+    constexpr uint64_t kBindingStride = 256;
+
+    enum class Workload {
+        // Bind groups with kMaxBindingsPerGroup bindings.
+        BindGroups,
+        // Render pipelines with kMaxVertexBuffers buffers of one attribute each.
+        RenderPipelines,
+    };
+
+    struct WireLargeDescriptorParams : DawnTestParam {
+        WireLargeDescriptorParams(const DawnTestParam& param, Workload workload)
+            : DawnTestParam(param), workload(workload) {
+        }
+
+        Workload workload;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireLargeDescriptorParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.workload) {
+            case Workload::BindGroups:
+                ostream << "_BindGroups";
+                break;
+            case Workload::RenderPipelines:
+                ostream << "_RenderPipelines";
+                break;
+        }
+        return ostream;
+    }
+
+    unsigned int GetIterationsPerStep(Workload workload) {
+        switch (workload) {
+            case Workload::BindGroups:
+                return kNumBindGroups;
+            case Workload::RenderPipelines:
+                return kNumRenderPipelines;
+        }
+        UNREACHABLE();
+    }
+
+}  // namespace
+
+// Test creating objects with large descriptors through the wire, so that each command needs a
+// lot of space to be deserialized on the server.
+class WireLargeDescriptorPerf : public DawnPerfTestWithParams<WireLargeDescriptorParams> {
+  public:
+    WireLargeDescriptorPerf()
+        : DawnPerfTestWithParams(GetIterationsPerStep(GetParam().workload)) {
+    }
+    ~WireLargeDescriptorPerf() override = default;
+
+    void SetUp() override;
+
+  private:
+    void Step() override;
+
+    void SetUpBindGroups();
+    void SetUpRenderPipelines();
+
+    // BindGroups
+    dawn::BindGroupLayout mBindGroupLayout;
+    std::vector<dawn::BindGroupBinding> mBindings;
+    dawn::BindGroupDescriptor mBindGroupDesc;
+
+    // RenderPipelines
+    dawn::ShaderModule mVsModule;
+    dawn::ShaderModule mFsModule;
+};
+
+void WireLargeDescriptorPerf::SetUp() {
+    DawnPerfTestWithParams<WireLargeDescriptorParams>::SetUp();
+
+    switch (GetParam().workload) {
+        case Workload::BindGroups:
+            SetUpBindGroups();
+            break;
+        case Workload::RenderPipelines:
+            SetUpRenderPipelines();
+            break;
+    }
+}
+
+void WireLargeDescriptorPerf::SetUpBindGroups() {
+    std::vector<dawn::BindGroupLayoutBinding> layoutBindings;
+    for (uint32_t i = 0; i < kMaxBindingsPerGroup; ++i) {
+        layoutBindings.push_back({i, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer});
+    }
+    dawn::BindGroupLayoutDescriptor layoutDesc;
+    layoutDesc.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+    layoutDesc.bindings = layoutBindings.data();
+    mBindGroupLayout = device.CreateBindGroupLayout(&layoutDesc);
+
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = kMaxBindingsPerGroup * kBindingStride;
+    bufferDesc.usage = dawn::BufferUsage::Uniform;
+    dawn::Buffer buffer = device.CreateBuffer(&bufferDesc);
+
+    for (uint32_t i = 0; i < kMaxBindingsPerGroup; ++i) {
+        dawn::BindGroupBinding binding;
+        binding.binding = i;
+        binding.buffer = buffer;
+        binding.offset = i * kBindingStride;
+        binding.size = 16;
+        mBindings.push_back(binding);
+    }
+    mBindGroupDesc.layout = mBindGroupLayout;
+    mBindGroupDesc.bindingCount = static_cast<uint32_t>(mBindings.size());
+    mBindGroupDesc.bindings = mBindings.data();
+}
+
+void WireLargeDescriptorPerf::SetUpRenderPipelines() {
+    // Use all the vertex attributes in the shader so that none of them can be ignored.
+    std::ostringstream vsSource;
+    vsSource << "#version 450\n";
+    for (uint32_t i = 0; i < kMaxVertexAttributes; ++i) {
+        vsSource << "layout(location = " << i << ") in vec4 a" << i << ";\n";
+    }
+    vsSource << "void main() {\n    gl_Position = vec4(0.f)";
+    for (uint32_t i = 0; i < kMaxVertexAttributes; ++i) {
+        vsSource << " + a" << i;
+    }
+    vsSource << ";\n}\n";
+    mVsModule = utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex,
+                                          vsSource.str().c_str());
+
+    mFsModule = utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+        #version 450
+        layout(location = 0) out vec4 fragColor;
+        void main() {
+            fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+        })");
+}
+
+void WireLargeDescriptorPerf::Step() {
+    switch (GetParam().workload) {
+        case Workload::BindGroups: {
+            for (unsigned int i = 0; i < kNumBindGroups; ++i) {
+                dawn::BindGroup bindGroup = device.CreateBindGroup(&mBindGroupDesc);
+            }
+            break;
+        }
+
+        case Workload::RenderPipelines: {
+            utils::ComboRenderPipelineDescriptor descriptor(device);
+            descriptor.vertexStage.module = mVsModule;
+            descriptor.cFragmentStage.module = mFsModule;
+
+            static_assert(kMaxVertexAttributes <= kMaxVertexBuffers,
+                          "Each attribute is in its own vertex buffer");
+            descriptor.cVertexInput.bufferCount = kMaxVertexAttributes;
+            for (uint32_t i = 0; i < kMaxVertexAttributes; ++i) {
+                descriptor.cVertexInput.cAttributes[i].shaderLocation = i;
+                descriptor.cVertexInput.cAttributes[i].format = dawn::VertexFormat::Float4;
+                descriptor.cVertexInput.cBuffers[i].stride = 4 * sizeof(float);
+                descriptor.cVertexInput.cBuffers[i].attributeCount = 1;
+                descriptor.cVertexInput.cBuffers[i].attributes =
+                    &descriptor.cVertexInput.cAttributes[i];
+            }
+
+            for (unsigned int i = 0; i < kNumRenderPipelines; ++i) {
+                dawn::RenderPipeline pipeline = device.CreateRenderPipeline(&descriptor);
+            }
+            break;
+        }
+    }
+
+    // Wait for the GPU so the cost of the server deserializing the commands is included.
+    WaitForGPU();
+}
+
+TEST_P(WireLargeDescriptorPerf, Run) {
+    // Deserialization only happens when using the wire.
+    DAWN_SKIP_TEST_IF(!UsesWire());
+
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireLargeDescriptorPerf,
+                                   {D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend},
+                                   {Workload::BindGroups, Workload::RenderPipelines});
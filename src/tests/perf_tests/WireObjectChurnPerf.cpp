@@ -0,0 +1,107 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kNumObjects = 100000;
+    constexpr size_t kLiveWindowSize = 4096;
+
+    enum class ChurnPattern {
+        // Each object is released before the next one is created.
+        OneAtATime,
+        // A window of live objects is kept, releasing objects in a scattered order so that free
+        // IDs are interleaved with live ones.
+        ScatteredWindow,
+    };
+
+    struct WireObjectChurnParams : DawnTestParam {
+        WireObjectChurnParams(const DawnTestParam& param, ChurnPattern churnPattern)
+            : DawnTestParam(param), churnPattern(churnPattern) {
+        }
+
+        ChurnPattern churnPattern;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WireObjectChurnParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.churnPattern) {
+            case ChurnPattern::OneAtATime:
+                ostream << "_OneAtATime";
+                break;
+            case ChurnPattern::ScatteredWindow:
+                ostream << "_ScatteredWindow";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test creating and releasing |kNumObjects| short-lived objects through the wire, which stresses
+// the ID allocation on the client and the object tracking on the server.
+class WireObjectChurnPerf : public DawnPerfTestWithParams<WireObjectChurnParams> {
+  public:
+    WireObjectChurnPerf() : DawnPerfTestWithParams(kNumObjects) {
+    }
+    ~WireObjectChurnPerf() override = default;
+
+  private:
+    void Step() override;
+
+    std::vector<dawn::CommandEncoder> mLiveObjects;
+};
+
+void WireObjectChurnPerf::Step() {
+    switch (GetParam().churnPattern) {
+        case ChurnPattern::OneAtATime: {
+            for (unsigned int i = 0; i < kNumObjects; ++i) {
+                dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+            }
+            break;
+        }
+
+        case ChurnPattern::ScatteredWindow: {
+            mLiveObjects.resize(kLiveWindowSize);
+            for (unsigned int i = 0; i < kNumObjects; ++i) {
+                // Replacing the slot releases the previous object in it. The multiplier is odd
+                // and the window size a power of two so all slots are visited, out of order.
+                size_t slot = (i * 2654435761u) % kLiveWindowSize;
+                mLiveObjects[slot] = device.CreateCommandEncoder();
+            }
+            mLiveObjects.clear();
+            break;
+        }
+    }
+
+    // Wait for the GPU so the cost of the server handling the commands is included.
+    WaitForGPU();
+}
+
+TEST_P(WireObjectChurnPerf, Run) {
+    // Object IDs only exist when using the wire.
+    DAWN_SKIP_TEST_IF(!UsesWire());
+
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WireObjectChurnPerf,
+                                   {D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend},
+                                   {ChurnPattern::OneAtATime, ChurnPattern::ScatteredWindow});
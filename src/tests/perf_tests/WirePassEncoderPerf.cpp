@@ -0,0 +1,151 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "tests/ParamGenerator.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+
+namespace {
+
+    constexpr unsigned int kNumDraws = 100000;
+    constexpr uint32_t kRTSize = 4;
+
+    enum class PassRecording {
+        Unbatched,
+        Batched,
+    };
+
+    struct WirePassEncoderParams : DawnTestParam {
+        WirePassEncoderParams(const DawnTestParam& param, PassRecording passRecording)
+            : DawnTestParam(param), passRecording(passRecording) {
+        }
+
+        PassRecording passRecording;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const WirePassEncoderParams& param) {
+        ostream << static_cast<const DawnTestParam&>(param);
+
+        switch (param.passRecording) {
+            case PassRecording::Unbatched:
+                ostream << "_Unbatched";
+                break;
+            case PassRecording::Batched:
+                ostream << "_Batched";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test recording |kNumDraws| SetBindGroup and Draw calls in a single render pass through the wire.
+class WirePassEncoderPerf : public DawnPerfTestWithParams<WirePassEncoderParams> {
+  public:
+    WirePassEncoderPerf() : DawnPerfTestWithParams(kNumDraws) {
+    }
+    ~WirePassEncoderPerf() override = default;
+
+    void SetUp() override;
+
+  protected:
+    bool BatchRenderPassCommandsOverWire() override;
+
+  private:
+    void Step() override;
+
+    utils::BasicRenderPass renderPass;
+    dawn::RenderPipeline pipeline;
+    dawn::BindGroup bindGroup;
+};
+
+bool WirePassEncoderPerf::BatchRenderPassCommandsOverWire() {
+    return GetParam().passRecording == PassRecording::Batched;
+}
+
+void WirePassEncoderPerf::SetUp() {
+    DawnPerfTestWithParams<WirePassEncoderParams>::SetUp();
+
+    renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+
+    dawn::ShaderModule vsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            layout (set = 0, binding = 0) uniform vertexUniformBuffer {
+                vec4 offset;
+            };
+            void main() {
+                const vec2 pos[3] = vec2[3](vec2(-1.f, -1.f), vec2(1.f, -1.f), vec2(-1.f, 1.f));
+                gl_Position = vec4(pos[gl_VertexIndex], 0.f, 1.f) + offset;
+            })");
+
+    dawn::ShaderModule fsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            void main() {
+                fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+            })");
+
+    dawn::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {
+                    {0, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer},
+                });
+    dawn::PipelineLayout pipelineLayout = utils::MakeBasicPipelineLayout(device, &bgl);
+
+    utils::ComboRenderPipelineDescriptor descriptor(device);
+    descriptor.layout = pipelineLayout;
+    descriptor.vertexStage.module = vsModule;
+    descriptor.cFragmentStage.module = fsModule;
+    descriptor.cColorStates[0]->format = renderPass.colorFormat;
+
+    pipeline = device.CreateRenderPipeline(&descriptor);
+
+    float offset[4] = {0.f, 0.f, 0.f, 0.f};
+    dawn::Buffer buffer =
+        utils::CreateBufferFromData(device, offset, sizeof(offset), dawn::BufferUsage::Uniform);
+    bindGroup = utils::MakeBindGroup(device, bgl, {{0, buffer, 0, sizeof(offset)}});
+}
+
+void WirePassEncoderPerf::Step() {
+    dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+    {
+        dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        for (unsigned int i = 0; i < kNumDraws; ++i) {
+            pass.SetBindGroup(0, bindGroup, 0, nullptr);
+            pass.Draw(3, 1, 0, 0);
+        }
+        pass.EndPass();
+    }
+
+    dawn::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    // Wait for the GPU so the cost of the server replaying the commands is included.
+    WaitForGPU();
+}
+
+TEST_P(WirePassEncoderPerf, Run) {
+    // Batching only changes how commands are serialized through the wire.
+    DAWN_SKIP_TEST_IF(!UsesWire());
+
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(WirePassEncoderPerf,
+                                   {D3D12Backend, MetalBackend, OpenGLBackend, VulkanBackend},
+                                   {PassRecording::Unbatched, PassRecording::Batched});
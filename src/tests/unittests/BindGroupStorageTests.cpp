@@ -0,0 +1,118 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "common/Constants.h"
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/Buffer.h"
+#include "utils/DawnHelpers.h"
+
+#include <string>
+#include <vector>
+
+using namespace dawn_native;
+
+// Tests for the storage of bind groups, which only have data for the bindings of their layout.
+class BindGroupStorageTests : public ValidationTest {
+  protected:
+    // Make a layout with uniform buffers at the given binding numbers.
+    dawn::BindGroupLayout MakeUniformBufferLayout(const std::vector<uint32_t>& bindings) {
+        std::vector<dawn::BindGroupLayoutBinding> layoutBindings;
+        for (uint32_t binding : bindings) {
+            layoutBindings.push_back(
+                {binding, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer});
+        }
+
+        dawn::BindGroupLayoutDescriptor descriptor;
+        descriptor.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+        descriptor.bindings = layoutBindings.data();
+        return device.CreateBindGroupLayout(&descriptor);
+    }
+
+    static size_t GetBindGroupAllocationSize(const dawn::BindGroupLayout& layout) {
+        return BindGroupBase::GetBindingDataOffset<BindGroupBase>() +
+               BindGroupBase::GetBindingDataSize(
+                   reinterpret_cast<BindGroupLayoutBase*>(layout.Get()));
+    }
+};
+
+// Report the bytes used by bind groups with various numbers of bindings, compared to when the
+// storage for kMaxBindingsPerGroup bindings was embedded in every bind group.
+TEST_F(BindGroupStorageTests, BytesPerBindGroup) {
+    // BindGroupBase used to have an array of kMaxBindingsPerGroup Refs and two arrays of
+    // kMaxBindingsPerGroup uint32_t offsets and sizes.
+    constexpr size_t kEmbeddedBindingStorageSize =
+        kMaxBindingsPerGroup * (sizeof(Ref<ObjectBase>) + 2 * sizeof(uint32_t));
+    const size_t embeddedStorageBindGroupSize =
+        sizeof(ObjectBase) + sizeof(Ref<BindGroupLayoutBase>) + kEmbeddedBindingStorageSize;
+    RecordProperty("BytesPerBindGroupBefore", static_cast<int>(embeddedStorageBindGroupSize));
+
+    size_t previousSize = 0;
+    for (uint32_t bindingCount : {1u, 4u, kMaxBindingsPerGroup}) {
+        std::vector<uint32_t> bindings;
+        for (uint32_t i = 0; i < bindingCount; ++i) {
+            bindings.push_back(i);
+        }
+
+        size_t size = GetBindGroupAllocationSize(MakeUniformBufferLayout(bindings));
+        RecordProperty("BytesPerBindGroupWith" + std::to_string(bindingCount) + "Bindings",
+                       static_cast<int>(size));
+
+        EXPECT_GT(size, previousSize);
+        previousSize = size;
+    }
+
+    // A bind group with a single binding is a fraction of what it was.
+    std::vector<uint32_t> singleBinding = {0};
+    EXPECT_LT(4 * GetBindGroupAllocationSize(MakeUniformBufferLayout(singleBinding)),
+              embeddedStorageBindGroupSize);
+}
+
+// Test that bindings are found in the packed storage when binding numbers are sparse.
+TEST_F(BindGroupStorageTests, SparseBindings) {
+    dawn::BindGroupLayout layout = MakeUniformBufferLayout({15, 0, 5});
+
+    dawn::BufferDescriptor bufferDesc;
+    bufferDesc.size = 1024;
+    bufferDesc.usage = dawn::BufferUsage::Uniform;
+    dawn::Buffer buffer0 = device.CreateBuffer(&bufferDesc);
+    dawn::Buffer buffer5 = device.CreateBuffer(&bufferDesc);
+    dawn::Buffer buffer15 = device.CreateBuffer(&bufferDesc);
+
+    dawn::BindGroup bindGroup = utils::MakeBindGroup(device, layout,
+                                                     {
+                                                         {5, buffer5, 256, 16},
+                                                         {15, buffer15, 512, 32},
+                                                         {0, buffer0, 0, 64},
+                                                     });
+
+    BindGroupBase* nativeBindGroup = reinterpret_cast<BindGroupBase*>(bindGroup.Get());
+
+    BufferBinding binding0 = nativeBindGroup->GetBindingAsBufferBinding(0);
+    EXPECT_EQ(reinterpret_cast<BufferBase*>(buffer0.Get()), binding0.buffer);
+    EXPECT_EQ(0u, binding0.offset);
+    EXPECT_EQ(64u, binding0.size);
+
+    BufferBinding binding5 = nativeBindGroup->GetBindingAsBufferBinding(5);
+    EXPECT_EQ(reinterpret_cast<BufferBase*>(buffer5.Get()), binding5.buffer);
+    EXPECT_EQ(256u, binding5.offset);
+    EXPECT_EQ(16u, binding5.size);
+
+    BufferBinding binding15 = nativeBindGroup->GetBindingAsBufferBinding(15);
+    EXPECT_EQ(reinterpret_cast<BufferBase*>(buffer15.Get()), binding15.buffer);
+    EXPECT_EQ(512u, binding15.offset);
+    EXPECT_EQ(32u, binding15.size);
+}
@@ -0,0 +1,334 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/ShaderModule.h"
+#include "dawn_native/null/ComputeProgramNull.h"
+#include "utils/DawnHelpers.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace dawn_native;
+using namespace dawn_native::null;
+
+// Tests for the SPIR-V interpreter of the null backend, run directly on the interpreter with
+// buffers in CPU memory. The shaders are compiled with the null device of ValidationTest.
+class ComputeProgramNullTests : public ValidationTest {
+  protected:
+    std::unique_ptr<ComputeProgram> CreateProgram(const char* source) {
+        dawn::ShaderModule module =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, source);
+        const std::vector<uint32_t>& spirv =
+            reinterpret_cast<ShaderModuleBase*>(module.Get())->GetSpirv();
+        return ComputeProgram::Create(spirv, "main");
+    }
+
+    // Runs the program with |data| bound at set 0, binding 0.
+    template <typename T>
+    void Dispatch(const ComputeProgram* program,
+                  std::vector<T>* data,
+                  uint32_t x,
+                  uint32_t y = 1,
+                  uint32_t z = 1) {
+        ComputeBindings bindings = {};
+        bindings[0][0].data = reinterpret_cast<uint8_t*>(data->data());
+        bindings[0][0].size = data->size() * sizeof(T);
+        program->Dispatch(bindings, x, y, z);
+    }
+};
+
+// Test the integer operations, including the wrapping of overflows and the rounding of signed
+// divisions.
+TEST_F(ComputeProgramNullTests, IntegerArithmetic) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(std430, set = 0, binding = 0) buffer Data {
+            int a;
+            int b;
+            uint c;
+            int results[14];
+        };
+        void main() {
+            results[0] = a + b;
+            results[1] = a - b;
+            results[2] = a * b;
+            results[3] = a / b;
+            results[4] = -a % b;
+            results[5] = -a;
+            results[6] = a << 3;
+            results[7] = a >> 1;
+            results[8] = int(c >> 28);
+            results[9] = a & b;
+            results[10] = a | b;
+            results[11] = a ^ b;
+            results[12] = ~a;
+            results[13] = int(c + 1u);
+        })");
+    ASSERT_NE(nullptr, program);
+
+    std::vector<int32_t> data(17, 0);
+    data[0] = -7;
+    data[1] = 2;
+    uint32_t c = std::numeric_limits<uint32_t>::max();
+    memcpy(&data[2], &c, sizeof(c));
+    Dispatch(program.get(), &data, 1);
+
+    std::vector<int32_t> expected = {-5, -9, -14, -3, 1, 7, -56, -4, 15, 0, -5, -5, 6, 0};
+    EXPECT_EQ(expected, std::vector<int32_t>(data.begin() + 3, data.end()));
+}
+
+// Test the floating-point operations and conversions.
+TEST_F(ComputeProgramNullTests, FloatArithmetic) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(std430, set = 0, binding = 0) buffer Data {
+            float a;
+            float b;
+            float results[10];
+        };
+        void main() {
+            results[0] = a + b;
+            results[1] = a - b;
+            results[2] = a * b;
+            results[3] = a / b;
+            results[4] = floor(a);
+            results[5] = abs(b);
+            results[6] = sqrt(16.0 * a * a);
+            results[7] = float(int(a));
+            results[8] = dot(vec2(a, b), vec2(2.0, 1.0));
+            results[9] = max(a, b);
+        })");
+    ASSERT_NE(nullptr, program);
+
+    std::vector<float> data(12, 0.0f);
+    data[0] = 2.5f;
+    data[1] = -0.5f;
+    Dispatch(program.get(), &data, 1);
+
+    std::vector<float> expected = {2.0f, 3.0f, -1.25f, -5.0f, 2.0f, 0.5f, 10.0f, 2.0f, 4.5f, 2.5f};
+    EXPECT_EQ(expected, std::vector<float>(data.begin() + 2, data.end()));
+}
+
+// Test branches and loops that diverge between the invocations of a workgroup, including
+// early exits from loops and function calls.
+TEST_F(ComputeProgramNullTests, DivergentControlFlow) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(local_size_x = 64) in;
+        layout(std430, set = 0, binding = 0) buffer Data {
+            uint results[];
+        };
+        uint Collatz(uint n) {
+            uint steps = 0u;
+            while (n != 1u) {
+                if (n % 2u == 0u) {
+                    n /= 2u;
+                } else {
+                    n = 3u * n + 1u;
+                }
+                steps++;
+            }
+            return steps;
+        }
+        void main() {
+            uint i = gl_LocalInvocationID.x;
+            uint result = 0u;
+            for (uint j = 0u; j < i; j++) {
+                if (j == 40u) {
+                    break;
+                }
+                if (j % 3u == 0u) {
+                    continue;
+                }
+                result += j;
+            }
+            switch (i % 3u) {
+                case 0u:
+                    result += 1000u * Collatz(i + 1u);
+                    break;
+                case 1u:
+                    result += 1000000u;
+                    break;
+                default:
+                    break;
+            }
+            results[i] = result;
+        })");
+    ASSERT_NE(nullptr, program);
+
+    auto Collatz = [](uint32_t n) {
+        uint32_t steps = 0;
+        while (n != 1) {
+            n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+            steps++;
+        }
+        return steps;
+    };
+    std::vector<uint32_t> expected(64);
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t result = 0;
+        for (uint32_t j = 0; j < i && j != 40; ++j) {
+            if (j % 3 != 0) {
+                result += j;
+            }
+        }
+        if (i % 3 == 0) {
+            result += 1000 * Collatz(i + 1);
+        } else if (i % 3 == 1) {
+            result += 1000000;
+        }
+        expected[i] = result;
+    }
+
+    std::vector<uint32_t> data(64, 0);
+    Dispatch(program.get(), &data, 1);
+    EXPECT_EQ(expected, data);
+}
+
+// Test that a barrier waits for all the invocations of the workgroup, including the ones that
+// took a different branch before it.
+TEST_F(ComputeProgramNullTests, WorkgroupBarrier) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(local_size_x = 32) in;
+        layout(std430, set = 0, binding = 0) buffer Data {
+            uint results[];
+        };
+        shared uint values[32];
+        void main() {
+            uint i = gl_LocalInvocationID.x;
+            if (i % 2u == 0u) {
+                values[i] = i * 10u;
+            } else {
+                values[i] = i;
+            }
+            barrier();
+            results[gl_WorkGroupID.x * 32u + i] = values[31u - i] + gl_WorkGroupID.x;
+        })");
+    ASSERT_NE(nullptr, program);
+
+    std::vector<uint32_t> data(64, 0);
+    Dispatch(program.get(), &data, 2);
+    for (uint32_t group = 0; group < 2; ++group) {
+        for (uint32_t i = 0; i < 32; ++i) {
+            uint32_t source = 31 - i;
+            uint32_t expected = (source % 2 == 0 ? source * 10 : source) + group;
+            EXPECT_EQ(expected, data[group * 32 + i]) << group << " " << i;
+        }
+    }
+}
+
+// Test that out of bounds loads return zero and out of bounds stores are discarded, including
+// for indices that would wrap around 32-bit offsets.
+TEST_F(ComputeProgramNullTests, OutOfBoundsBufferAccess) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(std430, set = 0, binding = 0) buffer Data {
+            uint values[];
+        };
+        void main() {
+            uint inBounds = values[0];
+            values[1] = values[4];
+            values[2] = values[0x40000001u];
+            values[4] = 42u;
+            values[0x40000000u] = 43u;
+            values[3] = inBounds + 1u;
+        })");
+    ASSERT_NE(nullptr, program);
+
+    // Only the first 4 values are bound, the rest checks that nothing is written after them.
+    std::vector<uint32_t> data = {7, 100, 100, 100, 5, 5, 5, 5};
+    ComputeBindings bindings = {};
+    bindings[0][0].data = reinterpret_cast<uint8_t*>(data.data());
+    bindings[0][0].size = 4 * sizeof(uint32_t);
+    program->Dispatch(bindings, 1, 1, 1);
+
+    EXPECT_EQ(std::vector<uint32_t>({7, 0, 0, 8, 5, 5, 5, 5}), data);
+}
+
+// Test that the workgroups of dispatches large enough to run on several threads all run, and
+// that atomics are atomic across threads.
+TEST_F(ComputeProgramNullTests, AtomicsAcrossWorkgroups) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(local_size_x = 64) in;
+        layout(std430, set = 0, binding = 0) buffer Data {
+            uint counter;
+            uint maxGroup;
+            uint groups[];
+        };
+        void main() {
+            atomicAdd(counter, 1u);
+            atomicMax(maxGroup, gl_WorkGroupID.x + gl_NumWorkGroups.x * gl_WorkGroupID.y);
+            if (gl_LocalInvocationID.x == 0u) {
+                groups[gl_WorkGroupID.x + gl_NumWorkGroups.x * gl_WorkGroupID.y] = 1u;
+            }
+        })");
+    ASSERT_NE(nullptr, program);
+
+    constexpr uint32_t kGroupsX = 32;
+    constexpr uint32_t kGroupsY = 16;
+    std::vector<uint32_t> data(2 + kGroupsX * kGroupsY, 0);
+    Dispatch(program.get(), &data, kGroupsX, kGroupsY);
+
+    EXPECT_EQ(kGroupsX * kGroupsY * 64, data[0]);
+    EXPECT_EQ(kGroupsX * kGroupsY - 1, data[1]);
+    for (uint32_t i = 0; i < kGroupsX * kGroupsY; ++i) {
+        EXPECT_EQ(1u, data[2 + i]) << i;
+    }
+}
+
+// Test that dispatches with no workgroups, or more invocations than fit in 64 bits, don't run.
+TEST_F(ComputeProgramNullTests, EmptyAndHugeDispatchesAreSkipped) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(local_size_x = 2) in;
+        layout(std430, set = 0, binding = 0) buffer Data {
+            uint value;
+        };
+        void main() {
+            value = 1u;
+        })");
+    ASSERT_NE(nullptr, program);
+
+    constexpr uint32_t kMax = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> data = {0};
+    Dispatch(program.get(), &data, 0, 1, 1);
+    Dispatch(program.get(), &data, 1, 1, 0);
+    // kMax^3 workgroups overflow 64 bits, and kMax^2 workgroups fit but their invocations don't.
+    Dispatch(program.get(), &data, kMax, kMax, kMax);
+    Dispatch(program.get(), &data, kMax, kMax, 1);
+    EXPECT_EQ(0u, data[0]);
+
+    Dispatch(program.get(), &data, 1);
+    EXPECT_EQ(1u, data[0]);
+}
+
+// Test that modules using features the interpreter doesn't support are rejected.
+TEST_F(ComputeProgramNullTests, UnsupportedFeatures) {
+    std::unique_ptr<ComputeProgram> program = CreateProgram(R"(
+        #version 450
+        layout(set = 0, binding = 0) uniform texture2D tex;
+        layout(set = 0, binding = 1) uniform sampler samp;
+        layout(std430, set = 0, binding = 2) buffer Data {
+            vec4 value;
+        };
+        void main() {
+            value = texture(sampler2D(tex, samp), vec2(0.0));
+        })");
+    EXPECT_EQ(nullptr, program);
+}
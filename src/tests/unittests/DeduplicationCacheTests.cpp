@@ -0,0 +1,160 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/DawnHelpers.h"
+
+// Tests for the deduplication of bind groups and texture views enabled by the
+// deduplicate_bind_groups_and_texture_views toggle.
+class DeduplicationCacheTests : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceEnabledToggles.push_back("deduplicate_bind_groups_and_texture_views");
+        mDedupDevice = dawn::Device::Acquire(adapter.CreateDevice(&descriptor));
+
+        mLayout = utils::MakeBindGroupLayout(
+            mDedupDevice, {{0, dawn::ShaderStage::Fragment, dawn::BindingType::UniformBuffer},
+                          {1, dawn::ShaderStage::Fragment, dawn::BindingType::SampledTexture}});
+        mBuffer = CreateUniformBuffer();
+        mTexture = CreateTexture(mDedupDevice);
+    }
+
+    dawn::Buffer CreateUniformBuffer() {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = 1024;
+        descriptor.usage = dawn::BufferUsage::Uniform;
+        return mDedupDevice.CreateBuffer(&descriptor);
+    }
+
+    dawn::Texture CreateTexture(const dawn::Device& textureDevice) {
+        dawn::TextureDescriptor descriptor;
+        descriptor.dimension = dawn::TextureDimension::e2D;
+        descriptor.size = {16, 16, 1};
+        descriptor.arrayLayerCount = 1;
+        descriptor.sampleCount = 1;
+        descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+        descriptor.mipLevelCount = 1;
+        descriptor.usage = dawn::TextureUsage::Sampled;
+        return textureDevice.CreateTexture(&descriptor);
+    }
+
+    dawn::BindGroup MakeBindGroup(const dawn::Buffer& buffer,
+                                  uint64_t offset,
+                                  const dawn::TextureView& view) {
+        return utils::MakeBindGroup(mDedupDevice, mLayout, {{0, buffer, offset, 256}, {1, view}});
+    }
+
+    dawn::Device mDedupDevice;
+    dawn::BindGroupLayout mLayout;
+    dawn::Buffer mBuffer;
+    dawn::Texture mTexture;
+};
+
+// Test that objects aren't deduplicated when the toggle isn't enabled.
+TEST_F(DeduplicationCacheTests, DisabledByDefault) {
+    dawn::Texture texture = CreateTexture(device);
+
+    dawn::TextureView view = texture.CreateView();
+    EXPECT_NE(view.Get(), texture.CreateView().Get());
+
+    dawn::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Fragment, dawn::BindingType::SampledTexture}});
+    dawn::BindGroup bindGroup = utils::MakeBindGroup(device, layout, {{0, view}});
+    EXPECT_NE(bindGroup.Get(), utils::MakeBindGroup(device, layout, {{0, view}}).Get());
+}
+
+// Test that texture views with the same content are deduplicated, including when the defaults of
+// the descriptor are filled in.
+TEST_F(DeduplicationCacheTests, TextureViewDeduplication) {
+    dawn::TextureView view = mTexture.CreateView();
+
+    dawn::TextureViewDescriptor sameDesc;
+    sameDesc.format = dawn::TextureFormat::RGBA8Unorm;
+    sameDesc.dimension = dawn::TextureViewDimension::e2D;
+    sameDesc.mipLevelCount = 1;
+    sameDesc.arrayLayerCount = 1;
+    dawn::TextureView sameView = mTexture.CreateView(&sameDesc);
+
+    dawn::TextureView otherTextureView = CreateTexture(mDedupDevice).CreateView();
+
+    EXPECT_EQ(view.Get(), sameView.Get());
+    EXPECT_NE(view.Get(), otherTextureView.Get());
+}
+
+// Test that bind groups with the same content are deduplicated, regardless of the order of their
+// bindings.
+TEST_F(DeduplicationCacheTests, BindGroupDeduplication) {
+    dawn::TextureView view = mTexture.CreateView();
+    dawn::BindGroup bindGroup = MakeBindGroup(mBuffer, 0, view);
+
+    dawn::BindGroup sameBindGroup =
+        utils::MakeBindGroup(mDedupDevice, mLayout, {{1, view}, {0, mBuffer, 0, 256}});
+    dawn::BindGroup otherOffsetBindGroup = MakeBindGroup(mBuffer, 256, view);
+    dawn::BindGroup otherBufferBindGroup = MakeBindGroup(CreateUniformBuffer(), 0, view);
+
+    EXPECT_EQ(bindGroup.Get(), sameBindGroup.Get());
+    EXPECT_NE(bindGroup.Get(), otherOffsetBindGroup.Get());
+    EXPECT_NE(bindGroup.Get(), otherBufferBindGroup.Get());
+}
+
+// Test that the device keeps the deduplicated objects alive so that recreating them after the
+// application released them returns the same objects.
+TEST_F(DeduplicationCacheTests, ObjectsAreKeptAlive) {
+    DawnBindGroup previousBindGroup = nullptr;
+    DawnTextureView previousView = nullptr;
+    for (int frame = 0; frame < 3; ++frame) {
+        dawn::TextureView view = mTexture.CreateView();
+        dawn::BindGroup bindGroup = MakeBindGroup(mBuffer, 0, view);
+
+        if (frame > 0) {
+            EXPECT_EQ(previousView, view.Get());
+            EXPECT_EQ(previousBindGroup, bindGroup.Get());
+        }
+        previousView = view.Get();
+        previousBindGroup = bindGroup.Get();
+    }
+}
+
+// Test that destroying a buffer evicts the bind groups using it.
+TEST_F(DeduplicationCacheTests, BufferDestroyEvictsBindGroups) {
+    dawn::TextureView view = mTexture.CreateView();
+    dawn::Buffer otherBuffer = CreateUniformBuffer();
+    dawn::BindGroup bindGroup = MakeBindGroup(mBuffer, 0, view);
+    dawn::BindGroup otherBindGroup = MakeBindGroup(otherBuffer, 0, view);
+
+    mBuffer.Destroy();
+
+    EXPECT_NE(bindGroup.Get(), MakeBindGroup(mBuffer, 0, view).Get());
+    EXPECT_EQ(otherBindGroup.Get(), MakeBindGroup(otherBuffer, 0, view).Get());
+}
+
+// Test that destroying a texture evicts its views and the bind groups using them.
+TEST_F(DeduplicationCacheTests, TextureDestroyEvictsViewsAndBindGroups) {
+    dawn::Texture otherTexture = CreateTexture(mDedupDevice);
+    dawn::TextureView view = mTexture.CreateView();
+    dawn::TextureView otherView = otherTexture.CreateView();
+    dawn::BindGroup bindGroup = MakeBindGroup(mBuffer, 0, view);
+    dawn::BindGroup otherBindGroup = MakeBindGroup(mBuffer, 0, otherView);
+
+    mTexture.Destroy();
+
+    EXPECT_NE(view.Get(), mTexture.CreateView().Get());
+    EXPECT_NE(bindGroup.Get(), MakeBindGroup(mBuffer, 0, view).Get());
+    EXPECT_EQ(otherView.Get(), otherTexture.CreateView().Get());
+    EXPECT_EQ(otherBindGroup.Get(), MakeBindGroup(mBuffer, 0, otherView).Get());
+}
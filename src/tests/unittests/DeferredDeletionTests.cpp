@@ -0,0 +1,162 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/Device.h"
+#include "utils/DawnHelpers.h"
+
+#include <thread>
+
+// Tests for deferring the deletion of objects to the next tick with the defer_object_deletion
+// toggle.
+class DeferredDeletionTests : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceEnabledToggles.push_back("defer_object_deletion");
+        mDeferringDevice = dawn::Device::Acquire(adapter.CreateDevice(&descriptor));
+        mNativeDevice = reinterpret_cast<dawn_native::DeviceBase*>(mDeferringDevice.Get());
+
+        mLayout = utils::MakeBindGroupLayout(
+            mDeferringDevice, {{0, dawn::ShaderStage::Compute, dawn::BindingType::UniformBuffer}});
+    }
+
+    void TearDown() override {
+        mLayout = dawn::BindGroupLayout();
+        mDeferringDevice = dawn::Device();
+        ValidationTest::TearDown();
+    }
+
+    dawn::Buffer CreateBuffer(const dawn::Device& device) {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = 256;
+        descriptor.usage = dawn::BufferUsage::Uniform;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    dawn::Texture CreateTexture(const dawn::Device& device) {
+        dawn::TextureDescriptor descriptor;
+        descriptor.dimension = dawn::TextureDimension::e2D;
+        descriptor.size = {4, 4, 1};
+        descriptor.arrayLayerCount = 1;
+        descriptor.sampleCount = 1;
+        descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+        descriptor.mipLevelCount = 1;
+        descriptor.usage = dawn::TextureUsage::Sampled;
+        return device.CreateTexture(&descriptor);
+    }
+
+    dawn::Device mDeferringDevice;
+    dawn_native::DeviceBase* mNativeDevice = nullptr;
+    dawn::BindGroupLayout mLayout;
+};
+
+// Test that buffers, textures and bind groups are only deleted at the next tick.
+TEST_F(DeferredDeletionTests, DeletionIsDeferredToTick) {
+    dawn::Buffer buffer = CreateBuffer(mDeferringDevice);
+    dawn::Texture texture = CreateTexture(mDeferringDevice);
+    dawn::BindGroup bindGroup = utils::MakeBindGroup(mDeferringDevice, mLayout,
+                                                     {{0, CreateBuffer(mDeferringDevice), 0, 256}});
+
+    buffer = dawn::Buffer();
+    texture = dawn::Texture();
+    bindGroup = dawn::BindGroup();
+    EXPECT_EQ(3u, mNativeDevice->GetDeferredDeletionCountForTesting());
+
+    // Deleting the bind group releases the last reference to its buffer, which is deleted in
+    // the same tick.
+    mDeferringDevice.Tick();
+    EXPECT_EQ(0u, mNativeDevice->GetDeferredDeletionCountForTesting());
+}
+
+// Test that objects are deleted immediately without the toggle, and that error objects are never
+// deferred.
+TEST_F(DeferredDeletionTests, OnlyDeferredWithTheToggle) {
+    dawn_native::DeviceBase* nativeDevice =
+        reinterpret_cast<dawn_native::DeviceBase*>(device.Get());
+    CreateBuffer(device);
+    CreateTexture(device);
+    EXPECT_EQ(0u, nativeDevice->GetDeferredDeletionCountForTesting());
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::MapWrite;
+    // The device has no error callback so the validation error is ignored.
+    mDeferringDevice.CreateBuffer(&descriptor);
+    EXPECT_EQ(0u, mNativeDevice->GetDeferredDeletionCountForTesting());
+}
+
+// Test that the objects still pending deletion are deleted when the device is destroyed.
+TEST_F(DeferredDeletionTests, PendingObjectsDeletedWithTheDevice) {
+    CreateBuffer(mDeferringDevice);
+    CreateTexture(mDeferringDevice);
+    utils::MakeBindGroup(mDeferringDevice, mLayout, {{0, CreateBuffer(mDeferringDevice), 0, 256}});
+    EXPECT_EQ(3u, mNativeDevice->GetDeferredDeletionCountForTesting());
+
+    mLayout = dawn::BindGroupLayout();
+    mDeferringDevice = dawn::Device();
+}
+
+// Stress test releasing the last references to objects from several threads while the device is
+// ticked.
+TEST_F(DeferredDeletionTests, ConcurrentReleases) {
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kObjectsPerThread = 500;
+
+    std::vector<std::vector<dawn::Buffer>> buffers(kThreadCount);
+    std::vector<std::vector<dawn::Texture>> textures(kThreadCount);
+    std::vector<std::vector<dawn::BindGroup>> bindGroups(kThreadCount);
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        for (uint32_t j = 0; j < kObjectsPerThread; ++j) {
+            // Half of the buffers are also referenced by a bind group released by another thread
+            // so that either thread can release the last reference.
+            dawn::Buffer buffer = CreateBuffer(mDeferringDevice);
+            if (j % 2 == 0) {
+                bindGroups[(i + 1) % kThreadCount].push_back(
+                    utils::MakeBindGroup(mDeferringDevice, mLayout, {{0, buffer, 0, 256}}));
+            }
+            buffers[i].push_back(std::move(buffer));
+            textures[i].push_back(CreateTexture(mDeferringDevice));
+        }
+    }
+
+    std::atomic<uint32_t> runningThreads(kThreadCount);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back([&, i]() {
+            for (uint32_t j = 0; j < kObjectsPerThread; ++j) {
+                buffers[i][j] = dawn::Buffer();
+                textures[i][j] = dawn::Texture();
+                if (j < bindGroups[i].size()) {
+                    bindGroups[i][j] = dawn::BindGroup();
+                }
+            }
+            runningThreads--;
+        });
+    }
+
+    // Delete the objects in batches while the other threads release them.
+    while (runningThreads > 0) {
+        mDeferringDevice.Tick();
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    mDeferringDevice.Tick();
+    EXPECT_EQ(0u, mNativeDevice->GetDeferredDeletionCountForTesting());
+}
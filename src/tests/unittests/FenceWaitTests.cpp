@@ -0,0 +1,237 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/Device.h"
+#include "dawn_native/NullBackend.h"
+#include "utils/DawnHelpers.h"
+
+#include <chrono>
+#include <limits>
+
+namespace {
+
+    constexpr uint64_t kInfiniteTimeout = std::numeric_limits<uint64_t>::max();
+
+    void SetBoolCallback(DawnFenceCompletionStatus status, void* userdata) {
+        EXPECT_EQ(DAWN_FENCE_COMPLETION_STATUS_SUCCESS, status);
+        *static_cast<bool*>(userdata) = true;
+    }
+
+}  // anonymous namespace
+
+// Tests for blocking on fences with dawn_native::WaitForFence, on devices with and without the
+// use_progress_thread toggle.
+class FenceWaitTests : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceEnabledToggles.push_back("use_progress_thread");
+        mThreadDevice = dawn::Device::Acquire(adapter.CreateDevice(&descriptor));
+    }
+
+    void TearDown() override {
+        mThreadDevice = dawn::Device();
+        ValidationTest::TearDown();
+    }
+
+    dawn::Fence CreateFence(const dawn::Queue& queue) {
+        dawn::FenceDescriptor descriptor;
+        descriptor.initialValue = 0;
+        return queue.CreateFence(&descriptor);
+    }
+
+    static dawn_native::DeviceBase* ToNative(const dawn::Device& device) {
+        return reinterpret_cast<dawn_native::DeviceBase*>(device.Get());
+    }
+
+    dawn::Device mThreadDevice;
+};
+
+// Test that waiting for a signaled value completes the fence and calls its callbacks.
+TEST_F(FenceWaitTests, WaitCompletesTheFence) {
+    for (const dawn::Device& testDevice : {device, mThreadDevice}) {
+        dawn::Queue queue = testDevice.CreateQueue();
+        dawn::Fence fence = CreateFence(queue);
+        queue.Signal(fence, 1);
+
+        bool completed = false;
+        fence.OnCompletion(1, SetBoolCallback, &completed);
+
+        EXPECT_TRUE(dawn_native::WaitForFence(fence.Get(), 1, kInfiniteTimeout));
+        EXPECT_TRUE(completed);
+        EXPECT_EQ(1u, fence.GetCompletedValue());
+
+        // Waiting for a value that already completed returns immediately.
+        EXPECT_TRUE(dawn_native::WaitForFence(fence.Get(), 1, 0));
+    }
+}
+
+// Test that waiting for a value that isn't signaled fails instead of blocking forever.
+TEST_F(FenceWaitTests, WaitForUnsignaledValue) {
+    for (const dawn::Device& testDevice : {device, mThreadDevice}) {
+        dawn::Queue queue = testDevice.CreateQueue();
+        dawn::Fence fence = CreateFence(queue);
+        queue.Signal(fence, 1);
+
+        EXPECT_FALSE(dawn_native::WaitForFence(fence.Get(), 2, kInfiniteTimeout));
+        EXPECT_TRUE(dawn_native::WaitForFence(fence.Get(), 1, kInfiniteTimeout));
+    }
+}
+
+// Test that the progress thread completes the serials without the device being ticked, but that
+// the callbacks are only called when the device is ticked.
+TEST_F(FenceWaitTests, ProgressThreadCompletesSerials) {
+    dawn::Queue queue = mThreadDevice.CreateQueue();
+    dawn::Fence fence = CreateFence(queue);
+    queue.Signal(fence, 1);
+
+    bool completed = false;
+    fence.OnCompletion(1, SetBoolCallback, &completed);
+
+    dawn_native::DeviceBase* nativeDevice = ToNative(mThreadDevice);
+    Serial serial = nativeDevice->GetLastSubmittedCommandSerial();
+    EXPECT_TRUE(nativeDevice->WaitForSerial(serial, kInfiniteTimeout));
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(0u, fence.GetCompletedValue());
+
+    mThreadDevice.Tick();
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(1u, fence.GetCompletedValue());
+}
+
+// Test that map callbacks are called once the progress thread completed the map operation.
+TEST_F(FenceWaitTests, ProgressThreadCompletesMapOperations) {
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst;
+    dawn::Buffer buffer = mThreadDevice.CreateBuffer(&descriptor);
+
+    bool mapped = false;
+    buffer.MapReadAsync(
+        [](DawnBufferMapAsyncStatus status, const void*, uint64_t, void* userdata) {
+            EXPECT_EQ(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, status);
+            *static_cast<bool*>(userdata) = true;
+        },
+        &mapped);
+
+    // Ticking submits the map operation, which is only executed after its serial completed. The
+    // progress thread may complete it before the end of that tick, so |mapped| can already be
+    // true here.
+    dawn_native::DeviceBase* nativeDevice = ToNative(mThreadDevice);
+    mThreadDevice.Tick();
+    Serial serial = nativeDevice->GetLastSubmittedCommandSerial();
+    EXPECT_TRUE(nativeDevice->WaitForSerial(serial, kInfiniteTimeout));
+
+    mThreadDevice.Tick();
+    EXPECT_TRUE(mapped);
+}
+
+// Test that destroying a texture doesn't free its storage before the progress thread completed
+// the copies to it that were submitted before.
+TEST_F(FenceWaitTests, DestroyTextureWithCopyInFlight) {
+    dawn::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size = 256 * 4;
+    bufferDescriptor.usage = dawn::BufferUsage::CopySrc;
+    dawn::Buffer buffer = mThreadDevice.CreateBuffer(&bufferDescriptor);
+
+    dawn::TextureDescriptor textureDescriptor;
+    textureDescriptor.dimension = dawn::TextureDimension::e2D;
+    textureDescriptor.size = {4, 4, 1};
+    textureDescriptor.arrayLayerCount = 1;
+    textureDescriptor.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDescriptor.mipLevelCount = 1;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.usage = dawn::TextureUsage::CopyDst;
+    dawn::Texture texture = mThreadDevice.CreateTexture(&textureDescriptor);
+
+    dawn::BufferCopyView bufferCopyView = utils::CreateBufferCopyView(buffer, 0, 256, 0);
+    dawn::TextureCopyView textureCopyView = utils::CreateTextureCopyView(texture, 0, 0, {0, 0, 0});
+    dawn::Extent3D copySize = {4, 4, 1};
+    dawn::CommandEncoder encoder = mThreadDevice.CreateCommandEncoder();
+    encoder.CopyBufferToTexture(&bufferCopyView, &textureCopyView, &copySize);
+    dawn::CommandBuffer commands = encoder.Finish();
+    mThreadDevice.CreateQueue().Submit(1, &commands);
+
+    // The copy is only executed by the tick after its serial completed, after the texture is
+    // destroyed.
+    texture.Destroy();
+    dawn_native::DeviceBase* nativeDevice = ToNative(mThreadDevice);
+    Serial serial = nativeDevice->GetLastSubmittedCommandSerial();
+    EXPECT_TRUE(nativeDevice->WaitForSerial(serial, kInfiniteTimeout));
+    mThreadDevice.Tick();
+
+    // The storage is freed by the operations of the next serial.
+    serial = nativeDevice->GetLastSubmittedCommandSerial();
+    EXPECT_TRUE(nativeDevice->WaitForSerial(serial, kInfiniteTimeout));
+    mThreadDevice.Tick();
+}
+
+// Test that the serials complete no earlier than the latency of the GPU timeline model.
+TEST_F(FenceWaitTests, GpuTimelineModelLatency) {
+    dawn_native::null::GpuTimelineModel model;
+    model.latencyNs = 50 * 1000 * 1000;
+    dawn_native::null::SetGpuTimelineModel(mThreadDevice.Get(), model);
+
+    dawn::Queue queue = mThreadDevice.CreateQueue();
+    dawn::Fence fence = CreateFence(queue);
+
+    // The fence is signaled when the serial of the submit completes.
+    auto start = std::chrono::steady_clock::now();
+    queue.Submit(0, nullptr);
+    queue.Signal(fence, 1);
+    mThreadDevice.Tick();
+    EXPECT_EQ(0u, fence.GetCompletedValue());
+
+    EXPECT_TRUE(dawn_native::WaitForFence(fence.Get(), 1, kInfiniteTimeout));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+// Test that the submits are executed one after the other, each taking the cost of the submit
+// plus the time to transfer its copies.
+TEST_F(FenceWaitTests, GpuTimelineModelThroughput) {
+    constexpr uint64_t kCopySize = 4 * 1024 * 1024;
+
+    dawn_native::null::GpuTimelineModel model;
+    model.costPerSubmitNs = 10 * 1000 * 1000;
+    model.bytesPerSecond = 200 * 1024 * 1024;
+    dawn_native::null::SetGpuTimelineModel(mThreadDevice.Get(), model);
+
+    dawn::BufferDescriptor descriptor;
+    descriptor.size = kCopySize;
+    descriptor.usage = dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst;
+    dawn::Buffer source = mThreadDevice.CreateBuffer(&descriptor);
+    dawn::Buffer destination = mThreadDevice.CreateBuffer(&descriptor);
+
+    dawn::Queue queue = mThreadDevice.CreateQueue();
+    dawn::Fence fence = CreateFence(queue);
+
+    // Each submit takes 10ms plus 20ms for its copy, so the second one completes after 60ms.
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 1; i <= 2; ++i) {
+        dawn::CommandEncoder encoder = mThreadDevice.CreateCommandEncoder();
+        encoder.CopyBufferToBuffer(source, 0, destination, 0, kCopySize);
+        dawn::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+        queue.Signal(fence, i);
+    }
+
+    EXPECT_TRUE(dawn_native::WaitForFence(fence.Get(), 1, kInfiniteTimeout));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(30));
+    EXPECT_TRUE(dawn_native::WaitForFence(fence.Get(), 2, kInfiniteTimeout));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(60));
+}
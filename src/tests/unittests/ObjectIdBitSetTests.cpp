@@ -0,0 +1,144 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_wire/ObjectIdBitSet.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace dawn_wire;
+
+namespace {
+
+    // Returns all the IDs in the set, in order, found with FindFirst.
+    std::vector<uint32_t> CollectIds(const ObjectIdBitSet& set) {
+        std::vector<uint32_t> ids;
+        uint32_t id = 0;
+        while (set.FindFirst(id, &id)) {
+            ids.push_back(id);
+            id++;
+        }
+        return ids;
+    }
+
+}  // anonymous namespace
+
+// Test that an empty set contains nothing.
+TEST(ObjectIdBitSet, Empty) {
+    ObjectIdBitSet set;
+    EXPECT_FALSE(set.Test(0));
+    EXPECT_FALSE(set.Test(1000));
+
+    uint32_t id;
+    EXPECT_FALSE(set.FindFirst(0, &id));
+}
+
+// Test Set and Reset of IDs on both sides of word boundaries.
+TEST(ObjectIdBitSet, SetResetAcrossWordBoundaries) {
+    ObjectIdBitSet set;
+    const std::vector<uint32_t> ids = {0, 31, 32, 33, 63, 64, 95, 96};
+
+    for (uint32_t id : ids) {
+        set.Set(id);
+    }
+    for (uint32_t id = 0; id < 128; ++id) {
+        bool expected = std::find(ids.begin(), ids.end(), id) != ids.end();
+        EXPECT_EQ(expected, set.Test(id)) << id;
+    }
+
+    set.Reset(31);
+    set.Reset(64);
+    EXPECT_FALSE(set.Test(31));
+    EXPECT_TRUE(set.Test(32));
+    EXPECT_TRUE(set.Test(63));
+    EXPECT_FALSE(set.Test(64));
+    EXPECT_EQ(std::vector<uint32_t>({0, 32, 33, 63, 95, 96}), CollectIds(set));
+}
+
+// Test that setting an ID twice or resetting an ID that isn't set doesn't change the others.
+TEST(ObjectIdBitSet, SetAndResetAreIdempotent) {
+    ObjectIdBitSet set;
+    set.Set(5);
+    set.Set(5);
+    set.Set(6);
+    set.Reset(7);
+    EXPECT_EQ(std::vector<uint32_t>({5, 6}), CollectIds(set));
+
+    set.Reset(5);
+    set.Reset(5);
+    EXPECT_EQ(std::vector<uint32_t>({6}), CollectIds(set));
+}
+
+// Test FindFirst from starts inside a word, on a set bit and past the last set bit.
+TEST(ObjectIdBitSet, FindFirst) {
+    ObjectIdBitSet set;
+    set.Set(3);
+    set.Set(40);
+    set.Set(200);
+
+    uint32_t id;
+    ASSERT_TRUE(set.FindFirst(0, &id));
+    EXPECT_EQ(3u, id);
+    ASSERT_TRUE(set.FindFirst(3, &id));
+    EXPECT_EQ(3u, id);
+    ASSERT_TRUE(set.FindFirst(4, &id));
+    EXPECT_EQ(40u, id);
+
+    // The words between 40 and 200 are all zero.
+    ASSERT_TRUE(set.FindFirst(41, &id));
+    EXPECT_EQ(200u, id);
+
+    EXPECT_FALSE(set.FindFirst(201, &id));
+    EXPECT_FALSE(set.FindFirst(100000, &id));
+}
+
+// Test that the set grows to hold large IDs and keeps the IDs set before growing.
+TEST(ObjectIdBitSet, Growth) {
+    ObjectIdBitSet set;
+    set.Set(1);
+    set.Set(30);
+
+    // Querying or resetting IDs past the storage doesn't grow it or set anything.
+    EXPECT_FALSE(set.Test(5000));
+    set.Reset(5000);
+    EXPECT_EQ(std::vector<uint32_t>({1, 30}), CollectIds(set));
+
+    set.Set(5000);
+    set.Set(100000);
+    EXPECT_TRUE(set.Test(1));
+    EXPECT_TRUE(set.Test(30));
+    EXPECT_TRUE(set.Test(5000));
+    EXPECT_TRUE(set.Test(100000));
+    EXPECT_FALSE(set.Test(4999));
+    EXPECT_FALSE(set.Test(100001));
+    EXPECT_EQ(std::vector<uint32_t>({1, 30, 5000, 100000}), CollectIds(set));
+
+    set.Reset(100000);
+    EXPECT_EQ(std::vector<uint32_t>({1, 30, 5000}), CollectIds(set));
+}
+
+// Test that iteration visits every ID of a densely populated set exactly once.
+TEST(ObjectIdBitSet, DenseIteration) {
+    ObjectIdBitSet set;
+    std::vector<uint32_t> expected;
+    for (uint32_t id = 0; id < 1000; ++id) {
+        if (id % 3 != 0) {
+            set.Set(id);
+            expected.push_back(id);
+        }
+    }
+    EXPECT_EQ(expected, CollectIds(set));
+}
@@ -0,0 +1,478 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/BindGroup.h"
+#include "dawn_native/Buffer.h"
+#include "dawn_native/Commands.h"
+#include "dawn_native/RedundantCommandElimination.h"
+#include "dawn_native/RenderBundle.h"
+#include "dawn_native/RenderPipeline.h"
+#include "utils/ComboRenderBundleEncoderDescriptor.h"
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    // The state that applies to a draw or a dispatch, or the label of a debug marker.
+    struct Event {
+        Command type;
+        const void* pipeline = nullptr;
+        std::vector<const void*> bindGroups;
+        std::vector<std::vector<uint64_t>> dynamicOffsets;
+        std::vector<const void*> vertexBuffers;
+        std::vector<uint64_t> vertexBufferOffsets;
+        const void* indexBuffer = nullptr;
+        std::vector<float> viewport;
+        std::vector<uint32_t> scissorRect;
+        std::vector<float> blendColor;
+        uint32_t stencilReference = 0;
+        std::string label;
+
+        bool operator==(const Event& other) const {
+            return type == other.type && pipeline == other.pipeline &&
+                   bindGroups == other.bindGroups && dynamicOffsets == other.dynamicOffsets &&
+                   vertexBuffers == other.vertexBuffers &&
+                   vertexBufferOffsets == other.vertexBufferOffsets &&
+                   indexBuffer == other.indexBuffer && viewport == other.viewport &&
+                   scissorRect == other.scissorRect && blendColor == other.blendColor &&
+                   stencilReference == other.stencilReference && label == other.label;
+        }
+    };
+
+    // Interprets the commands like a backend would, returning the events with the state they see.
+    // Like the backends that apply bind groups with the layout of the current pipeline, bind
+    // groups set before a pipeline change don't apply to the new pipeline.
+    std::vector<Event> Replay(CommandIterator* commands, size_t* commandCount) {
+        std::vector<Event> events;
+        Event state;
+        *commandCount = 0;
+
+        auto ResetState = [&state]() {
+            state = Event{};
+            state.bindGroups.resize(kMaxBindGroups);
+            state.dynamicOffsets.resize(kMaxBindGroups);
+            state.vertexBuffers.resize(kMaxVertexBuffers);
+            state.vertexBufferOffsets.resize(kMaxVertexBuffers);
+        };
+        auto SetPipeline = [&state](const void* pipeline) {
+            if (state.pipeline != pipeline) {
+                state.pipeline = pipeline;
+                state.bindGroups.assign(kMaxBindGroups, nullptr);
+                state.dynamicOffsets.assign(kMaxBindGroups, {});
+            }
+        };
+        auto AddEvent = [&](Command type) {
+            events.push_back(state);
+            events.back().type = type;
+        };
+        ResetState();
+
+        Command type;
+        while (commands->NextCommandId(&type)) {
+            (*commandCount)++;
+            switch (type) {
+                case Command::BeginComputePass:
+                    commands->NextCommand<BeginComputePassCmd>();
+                    ResetState();
+                    break;
+                case Command::BeginRenderPass:
+                    commands->NextCommand<BeginRenderPassCmd>();
+                    ResetState();
+                    break;
+                case Command::ExecuteBundles: {
+                    ExecuteBundlesCmd* cmd = commands->NextCommand<ExecuteBundlesCmd>();
+                    commands->NextData<Ref<RenderBundleBase>>(cmd->count);
+                    AddEvent(type);
+                    ResetState();
+                } break;
+                case Command::InsertDebugMarker: {
+                    InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
+                    AddEvent(type);
+                    events.back().label = commands->NextData<char>(cmd->length + 1);
+                } break;
+                case Command::SetComputePipeline:
+                    SetPipeline(commands->NextCommand<SetComputePipelineCmd>()->pipeline.Get());
+                    break;
+                case Command::SetRenderPipeline:
+                    SetPipeline(commands->NextCommand<SetRenderPipelineCmd>()->pipeline.Get());
+                    break;
+                case Command::SetBindGroup: {
+                    SetBindGroupCmd* cmd = commands->NextCommand<SetBindGroupCmd>();
+                    state.bindGroups[cmd->index] = cmd->group.Get();
+                    state.dynamicOffsets[cmd->index].clear();
+                    if (cmd->dynamicOffsetCount > 0) {
+                        uint64_t* offsets = commands->NextData<uint64_t>(cmd->dynamicOffsetCount);
+                        state.dynamicOffsets[cmd->index].assign(
+                            offsets, offsets + cmd->dynamicOffsetCount);
+                    }
+                } break;
+                case Command::SetVertexBuffers: {
+                    SetVertexBuffersCmd* cmd = commands->NextCommand<SetVertexBuffersCmd>();
+                    auto buffers = commands->NextData<Ref<BufferBase>>(cmd->count);
+                    auto offsets = commands->NextData<uint64_t>(cmd->count);
+                    for (uint32_t i = 0; i < cmd->count; ++i) {
+                        state.vertexBuffers[cmd->startSlot + i] = buffers[i].Get();
+                        state.vertexBufferOffsets[cmd->startSlot + i] = offsets[i];
+                    }
+                } break;
+                case Command::SetIndexBuffer:
+                    state.indexBuffer = commands->NextCommand<SetIndexBufferCmd>()->buffer.Get();
+                    break;
+                case Command::SetViewport: {
+                    SetViewportCmd* cmd = commands->NextCommand<SetViewportCmd>();
+                    state.viewport = {cmd->x,     cmd->y,        cmd->width,
+                                      cmd->height, cmd->minDepth, cmd->maxDepth};
+                } break;
+                case Command::SetScissorRect: {
+                    SetScissorRectCmd* cmd = commands->NextCommand<SetScissorRectCmd>();
+                    state.scissorRect = {cmd->x, cmd->y, cmd->width, cmd->height};
+                } break;
+                case Command::SetBlendColor: {
+                    SetBlendColorCmd* cmd = commands->NextCommand<SetBlendColorCmd>();
+                    state.blendColor = {cmd->color.r, cmd->color.g, cmd->color.b, cmd->color.a};
+                } break;
+                case Command::SetStencilReference:
+                    state.stencilReference =
+                        commands->NextCommand<SetStencilReferenceCmd>()->reference;
+                    break;
+                case Command::Dispatch:
+                case Command::Draw:
+                case Command::DrawIndexed:
+                case Command::EndComputePass:
+                case Command::EndRenderPass:
+                    SkipCommand(commands, type);
+                    AddEvent(type);
+                    break;
+                default:
+                    SkipCommand(commands, type);
+                    break;
+            }
+        }
+        return events;
+    }
+
+}  // anonymous namespace
+
+// Tests for EliminateRedundantCommands that check that the commands that are removed don't change
+// the state seen by draws and dispatches.
+class RedundantCommandEliminationTests : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        dawn::ShaderModule vsModule =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            void main() {
+                gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+            })");
+        dawn::ShaderModule fsModule =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            void main() {
+                fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+            })");
+
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        descriptor.vertexStage.module = vsModule;
+        descriptor.cFragmentStage.module = fsModule;
+        mPipelines[0] = device.CreateRenderPipeline(&descriptor);
+        descriptor.primitiveTopology = dawn::PrimitiveTopology::LineList;
+        mPipelines[1] = device.CreateRenderPipeline(&descriptor);
+
+        dawn::BufferDescriptor bufferDesc;
+        bufferDesc.size = 1024;
+        bufferDesc.usage = dawn::BufferUsage::Uniform | dawn::BufferUsage::Vertex |
+                           dawn::BufferUsage::Index;
+        mBuffers[0] = device.CreateBuffer(&bufferDesc);
+        mBuffers[1] = device.CreateBuffer(&bufferDesc);
+
+        dawn::BindGroupLayout layout = utils::MakeBindGroupLayout(
+            device, {{0, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer, true}});
+        mBindGroups[0] = utils::MakeBindGroup(device, layout, {{0, mBuffers[0], 0, 256}});
+        mBindGroups[1] = utils::MakeBindGroup(device, layout, {{0, mBuffers[1], 0, 256}});
+    }
+
+    void TearDown() override {
+        FreeCommands(&mCommands);
+        ValidationTest::TearDown();
+    }
+
+    RenderPipelineBase* GetPipeline(size_t i) {
+        return reinterpret_cast<RenderPipelineBase*>(mPipelines[i].Get());
+    }
+    BindGroupBase* GetBindGroup(size_t i) {
+        return reinterpret_cast<BindGroupBase*>(mBindGroups[i].Get());
+    }
+    BufferBase* GetBuffer(size_t i) {
+        return reinterpret_cast<BufferBase*>(mBuffers[i].Get());
+    }
+
+    void BeginRenderPass() {
+        mAllocator.Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
+    }
+    void EndRenderPass() {
+        mAllocator.Allocate<EndRenderPassCmd>(Command::EndRenderPass);
+    }
+    void Draw() {
+        mAllocator.Allocate<DrawCmd>(Command::Draw);
+    }
+    void SetPipeline(size_t i) {
+        mAllocator.Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline)->pipeline =
+            GetPipeline(i);
+    }
+    void SetBindGroup(uint32_t index, size_t i, uint64_t dynamicOffset) {
+        SetBindGroupCmd* cmd = mAllocator.Allocate<SetBindGroupCmd>(Command::SetBindGroup);
+        cmd->index = index;
+        cmd->group = GetBindGroup(i);
+        cmd->dynamicOffsetCount = 1;
+        *mAllocator.AllocateData<uint64_t>(1) = dynamicOffset;
+    }
+    void SetVertexBuffer(uint32_t slot, size_t i, uint64_t offset) {
+        SetVertexBuffersCmd* cmd =
+            mAllocator.Allocate<SetVertexBuffersCmd>(Command::SetVertexBuffers);
+        cmd->startSlot = slot;
+        cmd->count = 1;
+        *mAllocator.AllocateData<Ref<BufferBase>>(1) = GetBuffer(i);
+        *mAllocator.AllocateData<uint64_t>(1) = offset;
+    }
+    void SetIndexBuffer(size_t i) {
+        SetIndexBufferCmd* cmd = mAllocator.Allocate<SetIndexBufferCmd>(Command::SetIndexBuffer);
+        cmd->buffer = GetBuffer(i);
+        cmd->offset = 0;
+    }
+    void SetViewport(float width) {
+        *mAllocator.Allocate<SetViewportCmd>(Command::SetViewport) = {0, 0, width, 4, 0, 1};
+    }
+    void SetScissorRect(uint32_t width) {
+        *mAllocator.Allocate<SetScissorRectCmd>(Command::SetScissorRect) = {0, 0, width, 4};
+    }
+    void SetBlendColor(float r) {
+        mAllocator.Allocate<SetBlendColorCmd>(Command::SetBlendColor)->color = {r, 0, 0, 1};
+    }
+    void SetStencilReference(uint32_t reference) {
+        mAllocator.Allocate<SetStencilReferenceCmd>(Command::SetStencilReference)->reference =
+            reference;
+    }
+    void InsertDebugMarker(const char* label) {
+        InsertDebugMarkerCmd* cmd =
+            mAllocator.Allocate<InsertDebugMarkerCmd>(Command::InsertDebugMarker);
+        cmd->length = strlen(label);
+        memcpy(mAllocator.AllocateData<char>(cmd->length + 1), label, cmd->length + 1);
+    }
+
+    // Eliminates the redundant commands of the recorded commands and checks that draws see the
+    // same state. Returns the number of commands removed.
+    size_t EliminateAndCheckEquivalence() {
+        mCommands = std::move(mAllocator);
+
+        size_t removedCount = 0;
+        CommandIterator compacted = EliminateRedundantCommands(&mCommands, &removedCount);
+
+        size_t commandCount = 0;
+        size_t compactedCommandCount = 0;
+        std::vector<Event> events = Replay(&mCommands, &commandCount);
+        std::vector<Event> compactedEvents = Replay(&compacted, &compactedCommandCount);
+        FreeCommands(&compacted);
+
+        EXPECT_TRUE(events == compactedEvents);
+        EXPECT_EQ(commandCount, compactedCommandCount + removedCount);
+        return removedCount;
+    }
+
+    dawn::RenderPipeline mPipelines[2];
+    dawn::Buffer mBuffers[2];
+    dawn::BindGroup mBindGroups[2];
+
+    CommandAllocator mAllocator;
+    CommandIterator mCommands;
+};
+
+// Test that setting each piece of state again to the same value is removed.
+TEST_F(RedundantCommandEliminationTests, SameStateIsRemoved) {
+    BeginRenderPass();
+    for (int i = 0; i < 2; ++i) {
+        SetPipeline(0);
+        SetBindGroup(0, 0, 256);
+        SetVertexBuffer(0, 0, 0);
+        SetIndexBuffer(0);
+        SetViewport(4);
+        SetScissorRect(4);
+        SetBlendColor(1);
+        SetStencilReference(1);
+        Draw();
+    }
+    EndRenderPass();
+
+    EXPECT_EQ(8u, EliminateAndCheckEquivalence());
+}
+
+// Test that state changes are kept, including changes of only the dynamic offsets or the offset
+// of vertex buffers.
+TEST_F(RedundantCommandEliminationTests, StateChangesAreKept) {
+    BeginRenderPass();
+    SetPipeline(0);
+    SetBindGroup(0, 0, 0);
+    SetVertexBuffer(0, 0, 0);
+    SetIndexBuffer(0);
+    SetViewport(4);
+    SetScissorRect(4);
+    SetBlendColor(1);
+    SetStencilReference(1);
+    Draw();
+
+    SetPipeline(1);
+    SetBindGroup(0, 0, 256);
+    SetBindGroup(1, 0, 256);
+    SetVertexBuffer(0, 0, 4);
+    SetVertexBuffer(1, 0, 4);
+    SetIndexBuffer(1);
+    SetViewport(2);
+    SetScissorRect(2);
+    SetBlendColor(0);
+    SetStencilReference(0);
+    Draw();
+
+    SetBindGroup(0, 1, 256);
+    SetVertexBuffer(0, 1, 4);
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(0u, EliminateAndCheckEquivalence());
+}
+
+// Test that the same bind group set again after a pipeline change is kept, since the backends may
+// need to apply it again for the new pipeline.
+TEST_F(RedundantCommandEliminationTests, BindGroupsAreKeptAfterPipelineChange) {
+    BeginRenderPass();
+    SetPipeline(0);
+    SetBindGroup(0, 0, 0);
+    Draw();
+    SetPipeline(1);
+    SetBindGroup(0, 0, 0);
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(0u, EliminateAndCheckEquivalence());
+
+    // Check the commands directly too, in case the replay above doesn't model a backend.
+    size_t removedCount = 0;
+    CommandIterator compacted = EliminateRedundantCommands(&mCommands, &removedCount);
+    size_t setBindGroupCount = 0;
+    Command type;
+    while (compacted.NextCommandId(&type)) {
+        if (type == Command::SetBindGroup) {
+            setBindGroupCount++;
+        }
+        SkipCommand(&compacted, type);
+    }
+    FreeCommands(&compacted);
+    EXPECT_EQ(2u, setBindGroupCount);
+}
+
+// Test that bind groups are still removed when setting the same pipeline again.
+TEST_F(RedundantCommandEliminationTests, BindGroupsAreRemovedAfterSamePipeline) {
+    BeginRenderPass();
+    SetPipeline(0);
+    SetBindGroup(0, 0, 0);
+    Draw();
+    SetPipeline(0);
+    SetBindGroup(0, 0, 0);
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(2u, EliminateAndCheckEquivalence());
+}
+
+// Test that the state is forgotten at the start of passes, so it is set again in each pass.
+TEST_F(RedundantCommandEliminationTests, StateIsResetBetweenPasses) {
+    for (int i = 0; i < 2; ++i) {
+        BeginRenderPass();
+        SetPipeline(0);
+        SetBindGroup(0, 0, 0);
+        SetViewport(4);
+        Draw();
+        EndRenderPass();
+    }
+
+    EXPECT_EQ(0u, EliminateAndCheckEquivalence());
+}
+
+// Test that the state is forgotten after render bundles are executed, as they reset it.
+TEST_F(RedundantCommandEliminationTests, StateIsResetAfterExecuteBundles) {
+    utils::ComboRenderBundleEncoderDescriptor desc = {};
+    desc.colorFormatsCount = 1;
+    desc.cColorFormats[0] = dawn::TextureFormat::RGBA8Unorm;
+    dawn::RenderBundle bundle = device.CreateRenderBundleEncoder(&desc).Finish();
+
+    BeginRenderPass();
+    SetPipeline(0);
+    SetBindGroup(0, 0, 0);
+    Draw();
+
+    ExecuteBundlesCmd* cmd = mAllocator.Allocate<ExecuteBundlesCmd>(Command::ExecuteBundles);
+    cmd->count = 1;
+    *mAllocator.AllocateData<Ref<RenderBundleBase>>(1) =
+        reinterpret_cast<RenderBundleBase*>(bundle.Get());
+
+    SetPipeline(0);
+    SetBindGroup(0, 0, 0);
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(0u, EliminateAndCheckEquivalence());
+}
+
+// Test that commands with data, like debug markers, are copied with their data.
+TEST_F(RedundantCommandEliminationTests, CommandDataIsCopied) {
+    BeginRenderPass();
+    InsertDebugMarker("first");
+    SetPipeline(0);
+    SetPipeline(0);
+    InsertDebugMarker("second marker");
+    Draw();
+    EndRenderPass();
+
+    EXPECT_EQ(1u, EliminateAndCheckEquivalence());
+}
+
+// Test that the eliminate_redundant_commands toggle compacts the commands of command buffers.
+TEST_F(RedundantCommandEliminationTests, Toggle) {
+    dawn_native::DeviceDescriptor descriptor;
+    descriptor.forceEnabledToggles.push_back("eliminate_redundant_commands");
+    dawn::Device toggleDevice = dawn::Device::Acquire(adapter.CreateDevice(&descriptor));
+
+    DummyRenderPass renderPass(toggleDevice);
+    dawn::CommandEncoder encoder = toggleDevice.CreateCommandEncoder();
+    dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+    for (int i = 0; i < 3; ++i) {
+        pass.SetScissorRect(0, 0, 1, 1);
+        pass.SetStencilReference(1);
+    }
+    pass.EndPass();
+    dawn::CommandBuffer commands = encoder.Finish();
+    toggleDevice.CreateQueue().Submit(1, &commands);
+
+    EXPECT_EQ(4u, dawn_native::GetRemovedCommandCountForTesting(toggleDevice.Get()));
+    EXPECT_EQ(0u, dawn_native::GetRemovedCommandCountForTesting(device.Get()));
+}
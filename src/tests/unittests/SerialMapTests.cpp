@@ -162,3 +162,91 @@ TEST(SerialMap, FirstSerial) {
     map.Enqueue(vector1, 6);
     EXPECT_EQ(map.FirstSerial(), 6u);
 }
+
+// Test that values enqueued out of order are sorted when the storage wraps around.
+TEST(SerialMap, EnqueueOrderWrapAround) {
+    TestSerialMap map;
+
+    // Move the front of the storage so that the values wrap around.
+    for (int i = 0; i < 6; ++i) {
+        map.Enqueue(i, 0);
+    }
+    map.ClearUpTo(0);
+
+    map.Enqueue(5, 3);
+    map.Enqueue(6, 3);
+    map.Enqueue(1, 1);
+    map.Enqueue(7, 4);
+    map.Enqueue(3, 2);
+    map.Enqueue(2, 1);
+    map.Enqueue(8, 4);
+    map.Enqueue(4, 2);
+    map.Enqueue(0, 0);
+
+    std::vector<int> expectedValues = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    for (int value : map.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+    EXPECT_EQ(0u, map.FirstSerial());
+    EXPECT_EQ(4u, map.LastSerial());
+}
+
+// Test that values with a bigger serial can be enqueued while iterating, like fence callbacks
+// registering other callbacks do.
+TEST(SerialMap, EnqueueWhileIterating) {
+    TestSerialMap map;
+    map.Enqueue(1, 1);
+    map.Enqueue(3, 3);
+
+    std::vector<int> iteratedValues;
+    for (int value : map.IterateUpTo(1)) {
+        iteratedValues.push_back(value);
+        map.Enqueue(2, 2);
+    }
+    EXPECT_EQ(std::vector<int>({1}), iteratedValues);
+
+    map.ClearUpTo(1);
+    std::vector<int> expectedValues = {2, 3};
+    for (int value : map.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+}
+
+// Test that values are kept in order when the storage wraps around and grows while wrapped, and
+// that ClearUpTo removes values on both sides of the wrap.
+TEST(SerialMap, WrapAroundAndGrowth) {
+    TestSerialMap map;
+
+    int nextExpectedValue = 0;
+    for (Serial serial = 0; serial < 100; serial += 2) {
+        // Every other pair of values is enqueued out of order, and the number of serials in
+        // flight grows so that the storage grows while wrapped.
+        if (serial % 4 == 0) {
+            map.Enqueue(static_cast<int>(serial + 1), serial + 1);
+            map.Enqueue(static_cast<int>(serial), serial);
+        } else {
+            map.Enqueue(static_cast<int>(serial), serial);
+            map.Enqueue(static_cast<int>(serial + 1), serial + 1);
+        }
+
+        Serial inFlight = 3 + serial / 10;
+        if (serial >= inFlight) {
+            for (int value : map.IterateUpTo(serial - inFlight)) {
+                EXPECT_EQ(nextExpectedValue++, value);
+            }
+            map.ClearUpTo(serial - inFlight);
+            EXPECT_EQ(serial - inFlight + 1, map.FirstSerial());
+        }
+    }
+
+    for (int value : map.IterateAll()) {
+        EXPECT_EQ(nextExpectedValue++, value);
+    }
+    EXPECT_EQ(100, nextExpectedValue);
+}
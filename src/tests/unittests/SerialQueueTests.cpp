@@ -16,6 +16,8 @@
 
 #include "common/SerialQueue.h"
 
+#include <memory>
+
 using TestSerialQueue = SerialQueue<int>;
 
 // A number of basic tests for SerialQueue that are difficult to split from one another
@@ -153,4 +155,72 @@ TEST(SerialQueue, LastSerial) {
 
     queue.Enqueue({2}, 1);
     EXPECT_EQ(queue.LastSerial(), 1u);
-}
\ No newline at end of file
+}
+// Test that values are kept in order when the storage wraps around and grows while wrapped.
+TEST(SerialQueue, WrapAround) {
+    TestSerialQueue queue;
+
+    int nextValue = 0;
+    int nextExpectedValue = 0;
+    for (Serial serial = 0; serial < 100; ++serial) {
+        // Enqueue more values than are cleared so that the storage grows.
+        for (Serial i = 0; i < serial % 5 + 1; ++i) {
+            queue.Enqueue(nextValue++, serial);
+        }
+
+        if (serial >= 3) {
+            for (int value : queue.IterateUpTo(serial - 3)) {
+                EXPECT_EQ(nextExpectedValue++, value);
+            }
+            queue.ClearUpTo(serial - 3);
+            EXPECT_EQ(serial - 2, queue.FirstSerial());
+        }
+    }
+
+    for (int value : queue.IterateAll()) {
+        EXPECT_EQ(nextExpectedValue++, value);
+    }
+    EXPECT_EQ(nextValue, nextExpectedValue);
+}
+
+// Test that move-only values can be enqueued, including as vectors.
+TEST(SerialQueue, MoveOnlyValues) {
+    SerialQueue<std::unique_ptr<int>> queue;
+
+    queue.Enqueue(std::make_unique<int>(1), 0);
+
+    std::vector<std::unique_ptr<int>> values;
+    values.push_back(std::make_unique<int>(2));
+    values.push_back(std::make_unique<int>(3));
+    queue.Enqueue(std::move(values), 1);
+
+    int expectedValue = 1;
+    for (const std::unique_ptr<int>& value : queue.IterateAll()) {
+        EXPECT_EQ(expectedValue++, *value);
+    }
+    EXPECT_EQ(4, expectedValue);
+
+    queue.ClearUpTo(0);
+    EXPECT_EQ(1u, queue.FirstSerial());
+}
+
+// Test that values can be enqueued while iterating, like callbacks of completed serials do.
+TEST(SerialQueue, EnqueueWhileIterating) {
+    TestSerialQueue queue;
+    queue.Enqueue(0, 0);
+    queue.Enqueue(1, 1);
+
+    // Enqueue enough values to grow the storage in the middle of the iteration.
+    std::vector<int> iteratedValues;
+    for (int value : queue.IterateUpTo(1)) {
+        iteratedValues.push_back(value);
+        for (int i = 0; i < 20; ++i) {
+            queue.Enqueue(100 + i, 2);
+        }
+    }
+    EXPECT_EQ(std::vector<int>({0, 1}), iteratedValues);
+
+    queue.ClearUpTo(1);
+    EXPECT_EQ(2u, queue.FirstSerial());
+    EXPECT_EQ(100, *queue.IterateAll().begin());
+}
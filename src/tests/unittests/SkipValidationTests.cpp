@@ -0,0 +1,129 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "dawn_native/CommandBuffer.h"
+#include "dawn_native/PassResourceUsage.h"
+#include "utils/DawnHelpers.h"
+
+using namespace dawn_native;
+
+// Tests for devices created with the skip_validation toggle, for which API calls aren't
+// validated but resource usages are still tracked.
+class SkipValidationTests : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        dawn_native::DeviceDescriptor descriptor;
+        descriptor.forceEnabledToggles.push_back("skip_validation");
+        mTrustedDevice = dawn::Device::Acquire(adapter.CreateDevice(&descriptor));
+        mTrustedDevice.SetUncapturedErrorCallback(OnTrustedDeviceError, this);
+    }
+
+    dawn::Buffer CreateBuffer(dawn::BufferUsage usage) {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = 1024;
+        descriptor.usage = usage;
+        return mTrustedDevice.CreateBuffer(&descriptor);
+    }
+
+    static const CommandBufferResourceUsage& GetResourceUsages(
+        const dawn::CommandBuffer& commands) {
+        return reinterpret_cast<CommandBufferBase*>(commands.Get())->GetResourceUsages();
+    }
+
+    static void OnTrustedDeviceError(DawnErrorType, const char*, void* userdata) {
+        static_cast<SkipValidationTests*>(userdata)->mErrorCount++;
+    }
+
+    dawn::Device mTrustedDevice;
+    uint32_t mErrorCount = 0;
+};
+
+// Test that invalid calls don't produce errors, as they aren't validated.
+TEST_F(SkipValidationTests, CallsAreNotValidated) {
+    dawn::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        mTrustedDevice,
+        {{0, dawn::ShaderStage::Compute, dawn::BindingType::UniformBuffer, true}});
+    dawn::Buffer buffer = CreateBuffer(dawn::BufferUsage::Uniform);
+    dawn::BindGroup bindGroup = utils::MakeBindGroup(mTrustedDevice, layout, {{0, buffer, 0, 256}});
+
+    // The dynamic offset isn't aligned.
+    dawn::CommandEncoder encoder = mTrustedDevice.CreateCommandEncoder();
+    dawn::ComputePassEncoder pass = encoder.BeginComputePass();
+    uint64_t dynamicOffset = 1;
+    pass.SetBindGroup(0, bindGroup, 1, &dynamicOffset);
+    pass.EndPass();
+
+    // The buffer isn't CopySrc.
+    dawn::Buffer destination = CreateBuffer(dawn::BufferUsage::CopyDst);
+    encoder.CopyBufferToBuffer(buffer, 0, destination, 0, 4);
+
+    dawn::CommandBuffer commands = encoder.Finish();
+    mTrustedDevice.CreateQueue().Submit(1, &commands);
+
+    EXPECT_EQ(0u, mErrorCount);
+}
+
+// Test that errors in the encoding state are still reported.
+TEST_F(SkipValidationTests, EncodingStateIsValidated) {
+    dawn::CommandEncoder encoder = mTrustedDevice.CreateCommandEncoder();
+    encoder.BeginComputePass();
+    encoder.Finish();
+
+    EXPECT_EQ(1u, mErrorCount);
+}
+
+// Test that the resource usages of passes and copies are built like with validation.
+TEST_F(SkipValidationTests, ResourceUsagesAreTracked) {
+    dawn::BindGroupLayout layout = utils::MakeBindGroupLayout(
+        mTrustedDevice, {{0, dawn::ShaderStage::Compute, dawn::BindingType::UniformBuffer},
+                         {1, dawn::ShaderStage::Compute, dawn::BindingType::StorageBuffer}});
+    dawn::Buffer uniformBuffer = CreateBuffer(dawn::BufferUsage::Uniform);
+    dawn::Buffer storageBuffer = CreateBuffer(dawn::BufferUsage::Storage);
+    dawn::BindGroup bindGroup = utils::MakeBindGroup(
+        mTrustedDevice, layout, {{0, uniformBuffer, 0, 256}, {1, storageBuffer, 0, 256}});
+
+    dawn::Buffer source = CreateBuffer(dawn::BufferUsage::CopySrc);
+    dawn::Buffer destination = CreateBuffer(dawn::BufferUsage::CopyDst);
+
+    dawn::CommandEncoder encoder = mTrustedDevice.CreateCommandEncoder();
+    dawn::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.InsertDebugMarker("marker");
+    pass.SetBindGroup(0, bindGroup, 0, nullptr);
+    pass.Dispatch(1, 1, 1);
+    pass.EndPass();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 4);
+    dawn::CommandBuffer commands = encoder.Finish();
+
+    const CommandBufferResourceUsage& usages = GetResourceUsages(commands);
+    ASSERT_EQ(1u, usages.perPass.size());
+    const PassResourceUsage& passUsages = usages.perPass[0];
+    ASSERT_EQ(2u, passUsages.buffers.size());
+    for (size_t i = 0; i < passUsages.buffers.size(); ++i) {
+        if (passUsages.buffers[i] == reinterpret_cast<BufferBase*>(uniformBuffer.Get())) {
+            EXPECT_EQ(dawn::BufferUsage::Uniform, passUsages.bufferUsages[i]);
+        } else {
+            EXPECT_EQ(reinterpret_cast<BufferBase*>(storageBuffer.Get()), passUsages.buffers[i]);
+            EXPECT_EQ(dawn::BufferUsage::Storage, passUsages.bufferUsages[i]);
+        }
+    }
+
+    EXPECT_EQ(2u, usages.topLevelBuffers.size());
+    EXPECT_EQ(1u, usages.topLevelBuffers.count(reinterpret_cast<BufferBase*>(source.Get())));
+    EXPECT_EQ(1u, usages.topLevelBuffers.count(reinterpret_cast<BufferBase*>(destination.Get())));
+    EXPECT_EQ(0u, mErrorCount);
+}
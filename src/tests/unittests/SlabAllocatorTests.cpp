@@ -0,0 +1,125 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Math.h"
+#include "common/SlabAllocator.h"
+
+#include <set>
+#include <vector>
+
+namespace {
+
+    struct Foo {
+        Foo(int value, int* destroyedCount) : value(value), destroyedCount(destroyedCount) {
+        }
+        ~Foo() {
+            (*destroyedCount)++;
+        }
+
+        int value;
+        int* destroyedCount;
+        char padding[40];
+    };
+
+}  // anonymous namespace
+
+// Test that objects are constructed in blocks of the allocator and can be freed.
+TEST(SlabAllocatorTests, NewAndDeallocate) {
+    SlabAllocator allocator;
+    int destroyedCount = 0;
+
+    Foo* foo = allocator.New<Foo>(42, &destroyedCount);
+    EXPECT_EQ(42, foo->value);
+    EXPECT_GE(allocator.GetBlockSize(), sizeof(Foo));
+    EXPECT_TRUE(IsPtrAligned(foo, alignof(std::max_align_t)));
+    EXPECT_EQ(1u, allocator.GetAllocatedBlockCount());
+    EXPECT_EQ(1u, allocator.GetSlabCount());
+
+    foo->~Foo();
+    allocator.Deallocate(foo);
+    EXPECT_EQ(1, destroyedCount);
+    EXPECT_EQ(0u, allocator.GetAllocatedBlockCount());
+}
+
+// Test that live blocks don't overlap and are all aligned, across several slabs.
+TEST(SlabAllocatorTests, BlocksDontOverlap) {
+    SlabAllocator allocator;
+    constexpr size_t kBlockSize = 24;
+
+    std::set<char*> blocks;
+    for (int i = 0; i < 1000; ++i) {
+        char* block = static_cast<char*>(allocator.Allocate(kBlockSize));
+        EXPECT_TRUE(IsPtrAligned(block, alignof(std::max_align_t)));
+        blocks.insert(block);
+    }
+    EXPECT_EQ(1000u, blocks.size());
+    EXPECT_GT(allocator.GetSlabCount(), 1u);
+
+    // Blocks are sorted by address, each must end before the next one starts.
+    char* previous = nullptr;
+    for (char* block : blocks) {
+        if (previous != nullptr) {
+            EXPECT_LE(previous + kBlockSize, block);
+        }
+        previous = block;
+    }
+
+    for (char* block : blocks) {
+        allocator.Deallocate(block);
+    }
+}
+
+// Test that freed blocks are reused so that churning objects doesn't allocate new slabs.
+TEST(SlabAllocatorTests, FreedBlocksAreReused) {
+    SlabAllocator allocator;
+    int destroyedCount = 0;
+
+    // Warm up the allocator with a window of live objects.
+    std::vector<Foo*> live;
+    for (int i = 0; i < 100; ++i) {
+        live.push_back(allocator.New<Foo>(i, &destroyedCount));
+    }
+    size_t slabCount = allocator.GetSlabCount();
+
+    // Replace objects of the window many times, the slabs are enough to hold them.
+    for (int i = 0; i < 10000; ++i) {
+        Foo*& slot = live[(i * 7) % live.size()];
+        slot->~Foo();
+        allocator.Deallocate(slot);
+        slot = allocator.New<Foo>(i, &destroyedCount);
+    }
+    EXPECT_EQ(slabCount, allocator.GetSlabCount());
+    EXPECT_EQ(100u, allocator.GetAllocatedBlockCount());
+
+    for (Foo* foo : live) {
+        foo->~Foo();
+        allocator.Deallocate(foo);
+    }
+    EXPECT_EQ(10100, destroyedCount);
+}
+
+// Test that the last freed block is the next one to be allocated, which keeps it hot in caches.
+TEST(SlabAllocatorTests, LastFreedIsReusedFirst) {
+    SlabAllocator allocator;
+
+    void* a = allocator.Allocate(16);
+    void* b = allocator.Allocate(16);
+    allocator.Deallocate(a);
+    EXPECT_EQ(a, allocator.Allocate(16));
+
+    allocator.Deallocate(b);
+    allocator.Deallocate(a);
+}
@@ -0,0 +1,308 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/SubresourceStorage.h"
+
+#include <random>
+#include <vector>
+
+using namespace dawn_native;
+
+namespace {
+
+    // A storage without any compression, used as the reference for SubresourceStorage.
+    class FullStorage {
+      public:
+        FullStorage(uint32_t mipLevelCount, uint32_t arrayLayerCount, int initialValue)
+            : mMipLevelCount(mipLevelCount),
+              mData(static_cast<size_t>(mipLevelCount) * arrayLayerCount, initialValue) {
+        }
+
+        template <typename F>
+        void Update(const SubresourceRange& range, F&& updateFunc) {
+            for (uint32_t layer = range.baseArrayLayer;
+                 layer < range.baseArrayLayer + range.layerCount; ++layer) {
+                for (uint32_t level = range.baseMipLevel;
+                     level < range.baseMipLevel + range.levelCount; ++level) {
+                    updateFunc(SubresourceRange::SingleSubresource(level, layer),
+                               &mData[layer * mMipLevelCount + level]);
+                }
+            }
+        }
+
+        int Get(uint32_t mipLevel, uint32_t arrayLayer) const {
+            return mData[arrayLayer * mMipLevelCount + mipLevel];
+        }
+
+      private:
+        uint32_t mMipLevelCount;
+        std::vector<int> mData;
+    };
+
+    // Checks that the storage has the values of the reference, and that iterating over it visits
+    // each subresource exactly once with the value of the subresource.
+    void CheckStorage(const SubresourceStorage<int>& storage, const FullStorage& reference) {
+        uint32_t mipLevelCount = storage.GetMipLevelCount();
+        uint32_t arrayLayerCount = storage.GetArrayLayerCount();
+
+        std::vector<int> visitCounts(static_cast<size_t>(mipLevelCount) * arrayLayerCount, 0);
+        storage.Iterate([&](const SubresourceRange& range, const int& data) {
+            for (uint32_t layer = range.baseArrayLayer;
+                 layer < range.baseArrayLayer + range.layerCount; ++layer) {
+                for (uint32_t level = range.baseMipLevel;
+                     level < range.baseMipLevel + range.levelCount; ++level) {
+                    ASSERT_EQ(reference.Get(level, layer), data);
+                    visitCounts[layer * mipLevelCount + level]++;
+                }
+            }
+        });
+
+        for (uint32_t layer = 0; layer < arrayLayerCount; ++layer) {
+            for (uint32_t level = 0; level < mipLevelCount; ++level) {
+                ASSERT_EQ(reference.Get(level, layer), storage.Get(level, layer));
+                ASSERT_EQ(1, visitCounts[layer * mipLevelCount + level]);
+            }
+        }
+    }
+
+    // Applies the same update to the storage and its reference.
+    void SetValue(SubresourceStorage<int>* storage,
+                  FullStorage* reference,
+                  const SubresourceRange& range,
+                  int value) {
+        auto updateFunc = [&](const SubresourceRange&, int* data) { *data = value; };
+        storage->Update(range, updateFunc);
+        reference->Update(range, updateFunc);
+    }
+
+}  // anonymous namespace
+
+// Test that a new storage is uniform with the initial value.
+TEST(SubresourceStorage, InitialValue) {
+    SubresourceStorage<int> storage(3, 5, 42);
+    EXPECT_TRUE(storage.IsUniformForTesting());
+
+    uint32_t callCount = 0;
+    storage.Iterate([&](const SubresourceRange& range, const int& data) {
+        EXPECT_EQ(0u, range.baseMipLevel);
+        EXPECT_EQ(3u, range.levelCount);
+        EXPECT_EQ(0u, range.baseArrayLayer);
+        EXPECT_EQ(5u, range.layerCount);
+        EXPECT_EQ(42, data);
+        callCount++;
+    });
+    EXPECT_EQ(1u, callCount);
+
+    CheckStorage(storage, FullStorage(3, 5, 42));
+}
+
+// Test that updating all the subresources of a uniform storage calls the update once.
+TEST(SubresourceStorage, UpdateWholeIsSingleCall) {
+    SubresourceStorage<int> storage(12, 2048, 0);
+
+    uint32_t callCount = 0;
+    storage.Update(storage.GetAllSubresources(), [&](const SubresourceRange&, int* data) {
+        *data = 1;
+        callCount++;
+    });
+    EXPECT_EQ(1u, callCount);
+    EXPECT_TRUE(storage.IsUniformForTesting());
+    CheckStorage(storage, FullStorage(12, 2048, 1));
+}
+
+// Test that updating whole layers keeps them uniform, and that the storage is recompressed when
+// all the layers have the same value again.
+TEST(SubresourceStorage, UpdateLayers) {
+    SubresourceStorage<int> storage(4, 6, 0);
+    FullStorage reference(4, 6, 0);
+
+    uint32_t callCount = 0;
+    storage.Update({0, 4, 1, 2}, [&](const SubresourceRange& range, int* data) {
+        EXPECT_EQ(0u, range.baseMipLevel);
+        EXPECT_EQ(4u, range.levelCount);
+        EXPECT_EQ(1u, range.layerCount);
+        *data = 1;
+        callCount++;
+    });
+    reference.Update({0, 4, 1, 2}, [](const SubresourceRange&, int* data) { *data = 1; });
+    EXPECT_EQ(2u, callCount);
+    EXPECT_FALSE(storage.IsUniformForTesting());
+    for (uint32_t layer = 0; layer < 6; ++layer) {
+        EXPECT_TRUE(storage.IsLayerUniformForTesting(layer));
+    }
+    CheckStorage(storage, reference);
+
+    SetValue(&storage, &reference, {0, 4, 0, 1}, 1);
+    SetValue(&storage, &reference, {0, 4, 3, 3}, 1);
+    EXPECT_TRUE(storage.IsUniformForTesting());
+    CheckStorage(storage, reference);
+}
+
+// Test updating single subresources decompresses their layer, and that the layer and the storage
+// are recompressed when the subresources get the same value again.
+TEST(SubresourceStorage, UpdateSingleSubresources) {
+    SubresourceStorage<int> storage(4, 6, 0);
+    FullStorage reference(4, 6, 0);
+
+    SetValue(&storage, &reference, SubresourceRange::SingleSubresource(2, 3), 7);
+    EXPECT_FALSE(storage.IsUniformForTesting());
+    EXPECT_FALSE(storage.IsLayerUniformForTesting(3));
+    EXPECT_TRUE(storage.IsLayerUniformForTesting(2));
+    CheckStorage(storage, reference);
+
+    SetValue(&storage, &reference, {1, 2, 2, 2}, 5);
+    EXPECT_FALSE(storage.IsLayerUniformForTesting(2));
+    CheckStorage(storage, reference);
+
+    // Setting the remaining mip levels of layer 3 to 5 makes the layer uniform.
+    SetValue(&storage, &reference, {0, 1, 3, 1}, 5);
+    SetValue(&storage, &reference, {3, 1, 3, 1}, 5);
+    EXPECT_TRUE(storage.IsLayerUniformForTesting(3));
+    CheckStorage(storage, reference);
+
+    SetValue(&storage, &reference, {0, 4, 0, 6}, 3);
+    EXPECT_TRUE(storage.IsUniformForTesting());
+    CheckStorage(storage, reference);
+}
+
+// Test iterating over a range of the subresources.
+TEST(SubresourceStorage, IterateRange) {
+    SubresourceStorage<int> storage(4, 6, 0);
+    FullStorage reference(4, 6, 0);
+    SetValue(&storage, &reference, SubresourceRange::SingleSubresource(1, 2), 1);
+    SetValue(&storage, &reference, {0, 4, 4, 1}, 2);
+
+    const SubresourceRange range = {1, 2, 1, 4};
+    uint32_t visitedCount = 0;
+    storage.Iterate(range, [&](const SubresourceRange& iteratedRange, const int& data) {
+        EXPECT_GE(iteratedRange.baseMipLevel, range.baseMipLevel);
+        EXPECT_LE(iteratedRange.baseMipLevel + iteratedRange.levelCount,
+                  range.baseMipLevel + range.levelCount);
+        EXPECT_GE(iteratedRange.baseArrayLayer, range.baseArrayLayer);
+        EXPECT_LE(iteratedRange.baseArrayLayer + iteratedRange.layerCount,
+                  range.baseArrayLayer + range.layerCount);
+
+        for (uint32_t layer = iteratedRange.baseArrayLayer;
+             layer < iteratedRange.baseArrayLayer + iteratedRange.layerCount; ++layer) {
+            for (uint32_t level = iteratedRange.baseMipLevel;
+                 level < iteratedRange.baseMipLevel + iteratedRange.levelCount; ++level) {
+                EXPECT_EQ(reference.Get(level, layer), data);
+                visitedCount++;
+            }
+        }
+    });
+    EXPECT_EQ(range.levelCount * range.layerCount, visitedCount);
+}
+
+// Test merging uniform and non-uniform storages.
+TEST(SubresourceStorage, Merge) {
+    SubresourceStorage<int> storage(3, 4, 1);
+    FullStorage reference(3, 4, 1);
+    SetValue(&storage, &reference, SubresourceRange::SingleSubresource(0, 0), 2);
+
+    auto mergeFunc = [](const SubresourceRange&, int* data, const bool& add) {
+        if (add) {
+            *data += 10;
+        }
+    };
+
+    // Merging a uniform storage updates the ranges of this storage.
+    {
+        SubresourceStorage<bool> other(3, 4, true);
+        storage.Merge(other, mergeFunc);
+        reference.Update({0, 3, 0, 4}, [](const SubresourceRange&, int* data) { *data += 10; });
+        CheckStorage(storage, reference);
+    }
+
+    // Merging a non-uniform storage into a uniform one.
+    {
+        SubresourceStorage<int> uniformStorage(3, 4, 0);
+        FullStorage uniformReference(3, 4, 0);
+
+        SubresourceStorage<bool> other(3, 4, false);
+        other.Update({1, 2, 1, 2}, [](const SubresourceRange&, bool* data) { *data = true; });
+        other.Update({0, 3, 3, 1}, [](const SubresourceRange&, bool* data) { *data = true; });
+        uniformStorage.Merge(other, mergeFunc);
+        uniformReference.Update({1, 2, 1, 2},
+                                [](const SubresourceRange&, int* data) { *data += 10; });
+        uniformReference.Update({0, 3, 3, 1},
+                                [](const SubresourceRange&, int* data) { *data += 10; });
+        CheckStorage(uniformStorage, uniformReference);
+        EXPECT_TRUE(uniformStorage.IsLayerUniformForTesting(3));
+    }
+
+    // Merging a storage that makes all the subresources equal recompresses the storage.
+    {
+        SubresourceStorage<int> mergedStorage(3, 4, 0);
+        mergedStorage.Update(SubresourceRange::SingleSubresource(2, 1),
+                             [](const SubresourceRange&, int* data) { *data = 1; });
+
+        SubresourceStorage<bool> other(3, 4, false);
+        other.Update(SubresourceRange::SingleSubresource(2, 1),
+                     [](const SubresourceRange&, bool* data) { *data = true; });
+        mergedStorage.Merge(other, [](const SubresourceRange&, int* data, const bool& reset) {
+            if (reset) {
+                *data = 0;
+            }
+        });
+        EXPECT_TRUE(mergedStorage.IsUniformForTesting());
+        CheckStorage(mergedStorage, FullStorage(3, 4, 0));
+    }
+}
+
+// Test random updates and merges against the reference storage.
+TEST(SubresourceStorage, RandomOperations) {
+    constexpr uint32_t kMipLevelCount = 5;
+    constexpr uint32_t kArrayLayerCount = 7;
+
+    std::mt19937 generator(1234);
+    auto randomRange = [&]() {
+        std::uniform_int_distribution<uint32_t> levelDistribution(0, kMipLevelCount - 1);
+        std::uniform_int_distribution<uint32_t> layerDistribution(0, kArrayLayerCount - 1);
+        uint32_t level0 = levelDistribution(generator);
+        uint32_t level1 = levelDistribution(generator);
+        uint32_t layer0 = layerDistribution(generator);
+        uint32_t layer1 = layerDistribution(generator);
+        return SubresourceRange{std::min(level0, level1), std::max(level0, level1) -
+                                                              std::min(level0, level1) + 1,
+                                std::min(layer0, layer1),
+                                std::max(layer0, layer1) - std::min(layer0, layer1) + 1};
+    };
+    std::uniform_int_distribution<int> valueDistribution(0, 2);
+
+    SubresourceStorage<int> storage(kMipLevelCount, kArrayLayerCount, 0);
+    FullStorage reference(kMipLevelCount, kArrayLayerCount, 0);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        if (i % 3 == 2) {
+            SubresourceStorage<int> other(kMipLevelCount, kArrayLayerCount, 0);
+            FullStorage otherReference(kMipLevelCount, kArrayLayerCount, 0);
+            SetValue(&other, &otherReference, randomRange(), valueDistribution(generator));
+
+            storage.Merge(other, [](const SubresourceRange&, int* data, const int& otherData) {
+                *data = (*data + otherData) % 3;
+            });
+            reference.Update({0, kMipLevelCount, 0, kArrayLayerCount},
+                             [&](const SubresourceRange& range, int* data) {
+                                 int otherData =
+                                     otherReference.Get(range.baseMipLevel, range.baseArrayLayer);
+                                 *data = (*data + otherData) % 3;
+                             });
+        } else {
+            SetValue(&storage, &reference, randomRange(), valueDistribution(generator));
+        }
+        CheckStorage(storage, reference);
+    }
+}
@@ -0,0 +1,140 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_wire/WireDeserializeAllocator.h"
+
+#include <cstring>
+
+using namespace dawn_wire;
+
+// Test that small allocations fit in the inline storage and don't retain a chunk.
+TEST(WireDeserializeAllocator, SmallAllocationsAreInline) {
+    WireDeserializeAllocator allocator;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NE(nullptr, allocator.GetSpace(16));
+        EXPECT_NE(nullptr, allocator.GetSpace(100));
+        allocator.Reset();
+        EXPECT_EQ(0u, allocator.GetRetainedSize());
+    }
+}
+
+// Test that the space returned between Resets doesn't overlap.
+TEST(WireDeserializeAllocator, AllocationsDontOverlap) {
+    WireDeserializeAllocator allocator;
+    constexpr size_t kSizes[] = {1000, 1000, 5000, 100, 20000};
+    char* allocations[5];
+    for (size_t i = 0; i < 5; ++i) {
+        allocations[i] = static_cast<char*>(allocator.GetSpace(kSizes[i]));
+        ASSERT_NE(nullptr, allocations[i]);
+        memset(allocations[i], static_cast<int>(i), kSizes[i]);
+    }
+    for (size_t i = 0; i < 5; ++i) {
+        for (size_t j = 0; j < kSizes[i]; ++j) {
+            ASSERT_EQ(static_cast<char>(i), allocations[i][j]);
+        }
+    }
+}
+
+// Test that the largest chunk is kept across Resets and reused for the next large allocation.
+TEST(WireDeserializeAllocator, LargestChunkIsRetained) {
+    WireDeserializeAllocator allocator;
+    constexpr size_t kLargeSize = 64 * 1024;
+
+    void* first = allocator.GetSpace(kLargeSize);
+    ASSERT_NE(nullptr, first);
+    allocator.Reset();
+    EXPECT_EQ(kLargeSize, allocator.GetRetainedSize());
+
+    // The retained chunk is used once the inline storage is full.
+    void* second = allocator.GetSpace(kLargeSize);
+    EXPECT_EQ(first, second);
+    allocator.Reset();
+    EXPECT_EQ(kLargeSize, allocator.GetRetainedSize());
+}
+
+// Test that a larger chunk replaces the retained chunk, and that smaller allocations use the
+// retained chunk instead of allocating.
+TEST(WireDeserializeAllocator, RetainedChunkGrows) {
+    WireDeserializeAllocator allocator;
+
+    allocator.GetSpace(64 * 1024);
+    allocator.Reset();
+    EXPECT_EQ(64u * 1024, allocator.GetRetainedSize());
+
+    allocator.GetSpace(256 * 1024);
+    allocator.Reset();
+    EXPECT_EQ(256u * 1024, allocator.GetRetainedSize());
+
+    allocator.GetSpace(8 * 1024);
+    allocator.GetSpace(8 * 1024);
+    allocator.Reset();
+    EXPECT_EQ(256u * 1024, allocator.GetRetainedSize());
+
+    // Once the retained chunk is full, chunks keep doubling in size.
+    allocator.GetSpace(256 * 1024);
+    allocator.GetSpace(8 * 1024);
+    allocator.Reset();
+    EXPECT_EQ(512u * 1024, allocator.GetRetainedSize());
+}
+
+// Test that chunks larger than the maximum retained size are freed on Reset.
+TEST(WireDeserializeAllocator, MaxRetainedSize) {
+    constexpr size_t kMaxRetainedSize = 32 * 1024;
+    WireDeserializeAllocator allocator(kMaxRetainedSize);
+
+    allocator.GetSpace(kMaxRetainedSize + 1);
+    allocator.Reset();
+    EXPECT_EQ(0u, allocator.GetRetainedSize());
+
+    allocator.GetSpace(kMaxRetainedSize);
+    allocator.Reset();
+    EXPECT_EQ(kMaxRetainedSize, allocator.GetRetainedSize());
+
+    // A larger chunk over the maximum doesn't replace the retained one.
+    allocator.GetSpace(4 * kMaxRetainedSize);
+    allocator.Reset();
+    EXPECT_EQ(kMaxRetainedSize, allocator.GetRetainedSize());
+}
+
+// Test that a maximum retained size of zero frees everything on Reset.
+TEST(WireDeserializeAllocator, NoRetention) {
+    WireDeserializeAllocator allocator(0);
+    allocator.GetSpace(64 * 1024);
+    allocator.Reset();
+    EXPECT_EQ(0u, allocator.GetRetainedSize());
+}
+
+// Test that the high water mark is the largest amount of space requested between two Resets,
+// whether the space is inline, in the retained chunk or in new chunks.
+TEST(WireDeserializeAllocator, HighWaterMark) {
+    WireDeserializeAllocator allocator;
+    EXPECT_EQ(0u, allocator.GetHighWaterMark());
+
+    allocator.GetSpace(100);
+    allocator.GetSpace(200);
+    allocator.Reset();
+    EXPECT_EQ(300u, allocator.GetHighWaterMark());
+
+    allocator.GetSpace(64 * 1024);
+    allocator.GetSpace(1000);
+    allocator.Reset();
+    EXPECT_EQ(64u * 1024 + 1000, allocator.GetHighWaterMark());
+
+    // Smaller uses of the retained chunk don't lower the high water mark.
+    allocator.GetSpace(32 * 1024);
+    allocator.Reset();
+    EXPECT_EQ(64u * 1024 + 1000, allocator.GetHighWaterMark());
+}
@@ -235,6 +235,78 @@ TEST_F(BufferValidationTest, MapWriteWrongUsage) {
     ASSERT_DEVICE_ERROR(buf.MapWriteAsync(ToMockBufferMapWriteCallback, nullptr));
 }
 
+// Test the success case for mapping a range of a buffer for reading
+TEST_F(BufferValidationTest, MapReadRangeSuccess) {
+    dawn::Buffer buf = CreateMapReadBuffer(16);
+
+    buf.MapReadRangeAsync(4, 8, ToMockBufferMapReadCallback, nullptr);
+
+    EXPECT_CALL(*mockBufferMapReadCallback,
+                Call(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, Ne(nullptr), 8u, _))
+        .Times(1);
+    queue.Submit(0, nullptr);
+
+    buf.Unmap();
+}
+
+// Test the success case for mapping a range of a buffer for writing
+TEST_F(BufferValidationTest, MapWriteRangeSuccess) {
+    dawn::Buffer buf = CreateMapWriteBuffer(16);
+
+    buf.MapWriteRangeAsync(4, 8, ToMockBufferMapWriteCallback, nullptr);
+
+    EXPECT_CALL(*mockBufferMapWriteCallback,
+                Call(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, Ne(nullptr), 8u, _))
+        .Times(1);
+    queue.Submit(0, nullptr);
+
+    buf.Unmap();
+}
+
+// Test that the mapped range must be inside the buffer
+TEST_F(BufferValidationTest, MapRangeOutOfBounds) {
+    dawn::Buffer buf = CreateMapReadBuffer(16);
+
+    // Success, the range ends at the end of the buffer
+    {
+        buf.MapReadRangeAsync(8, 8, ToMockBufferMapReadCallback, nullptr);
+
+        EXPECT_CALL(*mockBufferMapReadCallback,
+                    Call(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, Ne(nullptr), 8u, _))
+            .Times(1);
+        queue.Submit(0, nullptr);
+
+        buf.Unmap();
+    }
+
+    // Error, the range goes past the end of the buffer
+    {
+        EXPECT_CALL(*mockBufferMapReadCallback,
+                    Call(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0u, _))
+            .Times(1);
+        ASSERT_DEVICE_ERROR(buf.MapReadRangeAsync(12, 8, ToMockBufferMapReadCallback, nullptr));
+    }
+
+    // Error, offset + size overflows
+    {
+        EXPECT_CALL(*mockBufferMapReadCallback,
+                    Call(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0u, _))
+            .Times(1);
+        ASSERT_DEVICE_ERROR(buf.MapReadRangeAsync(
+            8, std::numeric_limits<uint64_t>::max(), ToMockBufferMapReadCallback, nullptr));
+    }
+}
+
+// Test that the offset of the mapped range must be a multiple of 4
+TEST_F(BufferValidationTest, MapRangeUnalignedOffset) {
+    dawn::Buffer buf = CreateMapWriteBuffer(16);
+
+    EXPECT_CALL(*mockBufferMapWriteCallback,
+                Call(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0u, _))
+        .Times(1);
+    ASSERT_DEVICE_ERROR(buf.MapWriteRangeAsync(2, 4, ToMockBufferMapWriteCallback, nullptr));
+}
+
 // Test map reading a buffer that is already mapped
 TEST_F(BufferValidationTest, MapReadAlreadyMapped) {
     dawn::Buffer buf = CreateMapReadBuffer(4);
@@ -253,3 +253,54 @@ TEST_F(CommandBufferValidationTest, TextureWithReadAndWriteUsage) {
     pass.EndPass();
     ASSERT_DEVICE_ERROR(encoder.Finish());
 }
+
+// Test that different subresources of a texture can be used with different usages in a pass
+TEST_F(CommandBufferValidationTest, TextureSubresourcesWithDifferentUsages) {
+    // Create a texture with two mip levels and two array layers
+    dawn::TextureDescriptor textureDescriptor;
+    textureDescriptor.usage = dawn::TextureUsage::Sampled | dawn::TextureUsage::OutputAttachment;
+    textureDescriptor.format = dawn::TextureFormat::RGBA8Unorm;
+    textureDescriptor.dimension = dawn::TextureDimension::e2D;
+    textureDescriptor.size = {2, 2, 1};
+    textureDescriptor.arrayLayerCount = 2;
+    textureDescriptor.sampleCount = 1;
+    textureDescriptor.mipLevelCount = 2;
+    dawn::Texture texture = device.CreateTexture(&textureDescriptor);
+
+    auto CreateView = [&](uint32_t baseMipLevel, uint32_t mipLevelCount, uint32_t baseArrayLayer) {
+        dawn::TextureViewDescriptor descriptor;
+        descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+        descriptor.dimension = dawn::TextureViewDimension::e2D;
+        descriptor.baseMipLevel = baseMipLevel;
+        descriptor.mipLevelCount = mipLevelCount;
+        descriptor.baseArrayLayer = baseArrayLayer;
+        descriptor.arrayLayerCount = 1;
+        return texture.CreateView(&descriptor);
+    };
+
+    dawn::BindGroupLayout bgl = utils::MakeBindGroupLayout(
+        device, {{0, dawn::ShaderStage::Vertex, dawn::BindingType::SampledTexture}});
+
+    auto TestPass = [&](dawn::TextureView sampledView, dawn::TextureView renderView) {
+        dawn::BindGroup bg = utils::MakeBindGroup(device, bgl, {{0, sampledView}});
+        utils::ComboRenderPassDescriptor renderPass({renderView});
+
+        dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+        dawn::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.SetBindGroup(0, bg, 0, nullptr);
+        pass.EndPass();
+        return encoder;
+    };
+
+    // Sampling mip level 0 while rendering to mip level 1 is valid
+    TestPass(CreateView(0, 1, 0), CreateView(1, 1, 0)).Finish();
+
+    // Sampling array layer 0 while rendering to array layer 1 is valid
+    TestPass(CreateView(0, 1, 0), CreateView(0, 1, 1)).Finish();
+
+    // Sampling a view that contains the rendered mip level is an error
+    ASSERT_DEVICE_ERROR(TestPass(CreateView(0, 2, 0), CreateView(1, 1, 0)).Finish());
+
+    // Sampling the rendered array layer is an error
+    ASSERT_DEVICE_ERROR(TestPass(CreateView(1, 1, 1), CreateView(1, 1, 1)).Finish());
+}
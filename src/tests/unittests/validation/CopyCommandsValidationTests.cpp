@@ -420,12 +420,16 @@ TEST_F(CopyCommandTest_B2T, IncorrectRowPitch) {
     dawn::Texture destination = Create2DTexture(128, 16, 5, 1, dawn::TextureFormat::RGBA8Unorm,
                                                 dawn::TextureUsage::CopyDst);
 
-    // Default row pitch is not 256-byte aligned
-    TestB2TCopy(utils::Expectation::Failure, source, 0, 0, 0, destination, 0, 0, {0, 0, 0},
+    // Default row pitch is tightly packed, so it doesn't need to be 256-byte aligned
+    TestB2TCopy(utils::Expectation::Success, source, 0, 0, 0, destination, 0, 0, {0, 0, 0},
                 {3, 4, 1});
 
-    // Row pitch is not 256-byte aligned
-    TestB2TCopy(utils::Expectation::Failure, source, 0, 128, 0, destination, 0, 0, {0, 0, 0},
+    // Row pitch is a multiple of the texel size but isn't 256-byte aligned
+    TestB2TCopy(utils::Expectation::Success, source, 0, 20, 0, destination, 0, 0, {0, 0, 0},
+                {4, 4, 1});
+
+    // Row pitch is not a multiple of the texel size
+    TestB2TCopy(utils::Expectation::Failure, source, 0, 130, 0, destination, 0, 0, {0, 0, 0},
                 {4, 4, 1});
 
     // Row pitch is less than width * bytesPerPixel
@@ -1267,8 +1271,7 @@ TEST_F(CopyCommandTest_CompressedTextureFormats, BufferOffset) {
 // Tests to verify that RowPitch must not be smaller than (width / blockWidth) * blockSizeInBytes
 // and it is valid to use 0 as RowPitch in buffer-to-texture or texture-to-buffer copies with
 // compressed texture formats.
-// Note that in Dawn we require RowPitch be a multiple of 256, which ensures RowPitch will always be
-// the multiple of compressed texture block width in bytes.
+// RowPitch doesn't need to be a multiple of 256 but must be a multiple of the block size in bytes.
 TEST_F(CopyCommandTest_CompressedTextureFormats, RowPitch) {
     dawn::Buffer buffer =
         CreateBuffer(1024, dawn::BufferUsage::CopySrc | dawn::BufferUsage::CopyDst);
@@ -1287,24 +1290,24 @@ TEST_F(CopyCommandTest_CompressedTextureFormats, RowPitch) {
             }
         }
 
-        // Test it is not valid to use a RowPitch that is not a multiple of 256.
+        // Test it is not valid to use a RowPitch that is not a multiple of the block size.
         {
             for (dawn::TextureFormat bcFormat : kBCFormats) {
                 dawn::Texture texture = Create2DTexture(bcFormat, 1, kTestWidth, kTestHeight);
                 uint32_t inValidRowPitch =
-                    kTestWidth / 4 * CompressedFormatBlockSizeInBytes(bcFormat);
-                ASSERT_NE(0u, inValidRowPitch % 256);
+                    kTestWidth / 4 * CompressedFormatBlockSizeInBytes(bcFormat) + 4;
                 TestBothTBCopies(utils::Expectation::Failure, buffer, 0, inValidRowPitch, 4,
                                  texture, 0, 0, {0, 0, 0}, {kTestWidth, 4, 1});
             }
         }
 
-        // Test the smallest valid RowPitch should work.
+        // Test the smallest valid RowPitch, which isn't a multiple of 256, should work.
         {
             for (dawn::TextureFormat bcFormat : kBCFormats) {
                 dawn::Texture texture = Create2DTexture(bcFormat, 1, kTestWidth, kTestHeight);
                 uint32_t smallestValidRowPitch =
-                    Align(kTestWidth / 4 * CompressedFormatBlockSizeInBytes(bcFormat), 256);
+                    kTestWidth / 4 * CompressedFormatBlockSizeInBytes(bcFormat);
+                ASSERT_NE(0u, smallestValidRowPitch % 256);
                 TestBothTBCopies(utils::Expectation::Success, buffer, 0, smallestValidRowPitch, 4,
                                  texture, 0, 0, {0, 0, 0}, {kTestWidth, 4, 1});
             }
@@ -1325,12 +1328,13 @@ TEST_F(CopyCommandTest_CompressedTextureFormats, RowPitch) {
             }
         }
 
+        // The default RowPitch is tightly packed so it doesn't need to be a multiple of 256.
         {
-            constexpr uint32_t kInValidWidth = 16;
+            constexpr uint32_t kUnalignedWidth = 16;
             for (dawn::TextureFormat bcFormat : kBCFormats) {
-                dawn::Texture texture = Create2DTexture(bcFormat, 1, kInValidWidth, kTestHeight);
-                TestBothTBCopies(utils::Expectation::Failure, buffer, 0, kZeroRowPitch, 4, texture,
-                                 0, 0, {0, 0, 0}, {kInValidWidth, 4, 1});
+                dawn::Texture texture = Create2DTexture(bcFormat, 1, kUnalignedWidth, kTestHeight);
+                TestBothTBCopies(utils::Expectation::Success, buffer, 0, kZeroRowPitch, 4, texture,
+                                 0, 0, {0, 0, 0}, {kUnalignedWidth, 4, 1});
             }
         }
     }
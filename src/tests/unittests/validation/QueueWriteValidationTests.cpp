@@ -0,0 +1,229 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/DawnHelpers.h"
+
+#include <vector>
+
+namespace {
+
+class QueueWriteBufferValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        queue = device.CreateQueue();
+    }
+
+    dawn::Buffer CreateBuffer(uint64_t size,
+                              dawn::BufferUsage usage = dawn::BufferUsage::CopyDst) {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    dawn::Queue queue;
+};
+
+// Test the success case for WriteBuffer
+TEST_F(QueueWriteBufferValidationTest, Success) {
+    dawn::Buffer buffer = CreateBuffer(16);
+
+    uint32_t data[4] = {1, 2, 3, 4};
+    queue.WriteBuffer(buffer, 0, data, sizeof(data));
+    queue.WriteBuffer(buffer, 12, data, sizeof(uint32_t));
+
+    // Writing zero bytes at the end of the buffer is valid.
+    queue.WriteBuffer(buffer, 16, data, 0);
+}
+
+// Test that WriteBuffer fails when the write doesn't fit in the buffer
+TEST_F(QueueWriteBufferValidationTest, OutOfBounds) {
+    dawn::Buffer buffer = CreateBuffer(16);
+
+    uint32_t data[5] = {1, 2, 3, 4, 5};
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 0, data, sizeof(data)));
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 8, data, 12));
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 20, data, 0));
+
+    // An offset that makes the end of the write overflow is caught.
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, uint64_t(int64_t(-4)), data, 8));
+}
+
+// Test that the offset and size of WriteBuffer must be multiples of 4
+TEST_F(QueueWriteBufferValidationTest, Alignment) {
+    dawn::Buffer buffer = CreateBuffer(16);
+
+    uint32_t data[4] = {1, 2, 3, 4};
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 2, data, 4));
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 0, data, 6));
+}
+
+// Test that WriteBuffer requires the CopyDst usage
+TEST_F(QueueWriteBufferValidationTest, RequiresCopyDstUsage) {
+    dawn::Buffer buffer = CreateBuffer(16, dawn::BufferUsage::CopySrc);
+
+    uint32_t data[4] = {1, 2, 3, 4};
+    ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 0, data, sizeof(data)));
+}
+
+// Test that WriteBuffer fails on mapped and destroyed buffers
+TEST_F(QueueWriteBufferValidationTest, MappedOrDestroyedBuffer) {
+    uint32_t data[4] = {1, 2, 3, 4};
+
+    {
+        dawn::BufferDescriptor descriptor;
+        descriptor.size = 16;
+        descriptor.usage = dawn::BufferUsage::CopyDst;
+        dawn::CreateBufferMappedResult result = device.CreateBufferMapped(&descriptor);
+
+        ASSERT_DEVICE_ERROR(queue.WriteBuffer(result.buffer, 0, data, sizeof(data)));
+
+        result.buffer.Unmap();
+        queue.WriteBuffer(result.buffer, 0, data, sizeof(data));
+    }
+
+    {
+        dawn::Buffer buffer = CreateBuffer(16);
+        buffer.Destroy();
+        ASSERT_DEVICE_ERROR(queue.WriteBuffer(buffer, 0, data, sizeof(data)));
+    }
+}
+
+class QueueWriteTextureValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        queue = device.CreateQueue();
+    }
+
+    dawn::Texture CreateTexture(uint32_t width,
+                                uint32_t height,
+                                dawn::TextureUsage usage = dawn::TextureUsage::CopyDst,
+                                uint32_t sampleCount = 1,
+                                uint32_t arrayLayerCount = 1) {
+        dawn::TextureDescriptor descriptor;
+        descriptor.size = {width, height, 1};
+        descriptor.arrayLayerCount = arrayLayerCount;
+        descriptor.format = dawn::TextureFormat::RGBA8Unorm;
+        descriptor.usage = usage;
+        descriptor.sampleCount = sampleCount;
+        return device.CreateTexture(&descriptor);
+    }
+
+    void TestWriteTexture(const dawn::Texture& texture,
+                          uint64_t dataSize,
+                          uint64_t offset,
+                          uint32_t rowPitch,
+                          uint32_t imageHeight,
+                          dawn::Origin3D origin,
+                          dawn::Extent3D writeSize,
+                          uint32_t mipLevel = 0) {
+        std::vector<uint8_t> data(dataSize);
+
+        dawn::TextureCopyView textureCopyView =
+            utils::CreateTextureCopyView(texture, mipLevel, 0, origin);
+        dawn::TextureDataLayout dataLayout;
+        dataLayout.offset = offset;
+        dataLayout.rowPitch = rowPitch;
+        dataLayout.imageHeight = imageHeight;
+
+        queue.WriteTexture(&textureCopyView, data.data(), dataSize, &dataLayout, &writeSize);
+    }
+
+    dawn::Queue queue;
+};
+
+// Test the success case for WriteTexture
+TEST_F(QueueWriteTextureValidationTest, Success) {
+    dawn::Texture texture = CreateTexture(16, 16);
+
+    // Tightly packed data with the default row pitch and image height.
+    TestWriteTexture(texture, 16 * 16 * 4, 0, 0, 0, {0, 0, 0}, {16, 16, 1});
+    // Tightly packed data with an explicit row pitch that isn't 256-byte aligned.
+    TestWriteTexture(texture, 4 * 4 * 4, 0, 4 * 4, 4, {4, 4, 0}, {4, 4, 1});
+    // Padded rows and an offset that isn't aligned to the texel size.
+    TestWriteTexture(texture, 3 + 20 * 3 + 8, 3, 20, 0, {0, 0, 0}, {2, 4, 1});
+    // Empty writes are valid.
+    TestWriteTexture(texture, 0, 0, 0, 0, {16, 16, 0}, {0, 0, 1});
+}
+
+// Test that WriteTexture fails when the data is too small for the write
+TEST_F(QueueWriteTextureValidationTest, DataTooSmall) {
+    dawn::Texture texture = CreateTexture(16, 16);
+
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 16 * 16 * 4 - 1, 0, 0, 0, {0, 0, 0},
+                                         {16, 16, 1}));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 16 * 16 * 4, 4, 0, 0, {0, 0, 0},
+                                         {16, 16, 1}));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 16, 20, 0, 0, {0, 0, 0}, {1, 1, 1}));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 256 * 15 + 63, 0, 256, 0, {0, 0, 0},
+                                         {16, 16, 1}));
+}
+
+// Test the validation of the row pitch and image height of WriteTexture
+TEST_F(QueueWriteTextureValidationTest, DataLayout) {
+    dawn::Texture texture = CreateTexture(16, 16);
+
+    // The row pitch must not be less than the row size.
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 1024, 0, 60, 0, {0, 0, 0}, {16, 4, 1}));
+    // The row pitch must be a multiple of the texel size.
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 1024, 0, 66, 0, {0, 0, 0}, {16, 4, 1}));
+    // The image height must not be less than the write height.
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 1024, 0, 64, 3, {0, 0, 0}, {16, 4, 1}));
+}
+
+// Test that WriteTexture fails when the write doesn't fit in the texture
+TEST_F(QueueWriteTextureValidationTest, OutOfBounds) {
+    dawn::Texture texture = CreateTexture(16, 16);
+
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 4096, 0, 0, 0, {1, 0, 0}, {16, 16, 1}));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 4096, 0, 0, 0, {0, 0, 0}, {16, 17, 1}));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 4096, 0, 0, 0, {0, 0, 0}, {4, 4, 1}, 1));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 4096, 0, 0, 0, {0, 0, 0}, {4, 4, 2}));
+}
+
+// Test that WriteTexture only writes to a single array layer, even when the texture has enough
+// layers for the write
+TEST_F(QueueWriteTextureValidationTest, DepthGreaterThanOne) {
+    dawn::Texture texture = CreateTexture(16, 16, dawn::TextureUsage::CopyDst, 1, 4);
+
+    TestWriteTexture(texture, 4 * 4 * 4, 0, 0, 0, {0, 0, 0}, {4, 4, 1});
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 4 * 4 * 4 * 2, 0, 0, 0, {0, 0, 0}, {4, 4, 2}));
+    ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 4 * 4 * 4 * 4, 0, 0, 4, {0, 0, 0}, {4, 4, 4}));
+}
+
+// Test that WriteTexture requires the CopyDst usage and a single-sampled texture
+TEST_F(QueueWriteTextureValidationTest, TextureRequirements) {
+    {
+        dawn::Texture texture = CreateTexture(16, 16, dawn::TextureUsage::Sampled);
+        ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 64, 0, 0, 0, {0, 0, 0}, {4, 4, 1}));
+    }
+
+    {
+        dawn::Texture texture = CreateTexture(
+            16, 16, dawn::TextureUsage::CopyDst | dawn::TextureUsage::OutputAttachment, 4);
+        ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 64, 0, 0, 0, {0, 0, 0}, {4, 4, 1}));
+    }
+
+    {
+        dawn::Texture texture = CreateTexture(16, 16);
+        texture.Destroy();
+        ASSERT_DEVICE_ERROR(TestWriteTexture(texture, 64, 0, 0, 0, {0, 0, 0}, {4, 4, 1}));
+    }
+}
+
+}  // anonymous namespace
@@ -501,6 +501,104 @@ TEST_F(WireBufferMappingTests, DestroyInsideMapWriteCallback) {
     FlushClient();
 }
 
+// Ranged mapping tests
+
+// Check that mapping a range for reading only transfers the data of the range
+TEST_F(WireBufferMappingTests, MappingRangeForReadSuccess) {
+    DawnBufferDescriptor descriptor;
+    descriptor.nextInChain = nullptr;
+    descriptor.size = 1024;
+
+    DawnBuffer apiLargeBuffer = api.GetNewBuffer();
+    DawnBuffer largeBuffer = dawnDeviceCreateBuffer(device, &descriptor);
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiLargeBuffer));
+
+    dawnBufferMapReadRangeAsync(largeBuffer, 512, sizeof(uint32_t), ToMockBufferMapReadCallback,
+                                nullptr);
+
+    uint32_t bufferContent = 31337;
+    EXPECT_CALL(api, OnBufferMapReadRangeAsyncCallback(apiLargeBuffer, 512, sizeof(uint32_t), _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallMapReadCallback(apiLargeBuffer, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS,
+                                    &bufferContent, sizeof(uint32_t));
+        }));
+
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapReadCallback, Call(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS,
+                                                 Pointee(Eq(bufferContent)), sizeof(uint32_t), _))
+        .Times(1);
+
+    FlushServer();
+
+    dawnBufferUnmap(largeBuffer);
+    EXPECT_CALL(api, BufferUnmap(apiLargeBuffer)).Times(1);
+
+    FlushClient();
+}
+
+// Check that mapping a range for writing only flushes the data of the range
+TEST_F(WireBufferMappingTests, MappingRangeForWriteSuccess) {
+    DawnBufferDescriptor descriptor;
+    descriptor.nextInChain = nullptr;
+    descriptor.size = 1024;
+
+    DawnBuffer apiLargeBuffer = api.GetNewBuffer();
+    DawnBuffer largeBuffer = dawnDeviceCreateBuffer(device, &descriptor);
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiLargeBuffer));
+
+    dawnBufferMapWriteRangeAsync(largeBuffer, 512, sizeof(uint32_t), ToMockBufferMapWriteCallback,
+                                 nullptr);
+
+    uint32_t serverBufferContent = 31337;
+    uint32_t updatedContent = 4242;
+    uint32_t zero = 0;
+
+    EXPECT_CALL(api,
+                OnBufferMapWriteRangeAsyncCallback(apiLargeBuffer, 512, sizeof(uint32_t), _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallMapWriteCallback(apiLargeBuffer, DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS,
+                                     &serverBufferContent, sizeof(uint32_t));
+        }));
+
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapWriteCallback,
+                Call(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, Pointee(Eq(zero)), sizeof(uint32_t), _))
+        .Times(1);
+
+    FlushServer();
+
+    *lastMapWritePointer = updatedContent;
+
+    dawnBufferUnmap(largeBuffer);
+    EXPECT_CALL(api, BufferUnmap(apiLargeBuffer)).Times(1);
+
+    FlushClient();
+
+    // After the buffer is unmapped, the content of the range is updated on the server
+    ASSERT_EQ(serverBufferContent, updatedContent);
+}
+
+// Check that an out-of-bounds range is forwarded to the server, which produces the error
+TEST_F(WireBufferMappingTests, MappingRangeOutOfBounds) {
+    dawnBufferMapReadRangeAsync(buffer, 0, std::numeric_limits<uint64_t>::max(),
+                                ToMockBufferMapReadCallback, nullptr);
+
+    EXPECT_CALL(api, OnBufferMapReadRangeAsyncCallback(
+                         apiBuffer, 0, std::numeric_limits<uint64_t>::max(), _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallMapReadCallback(apiBuffer, DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0);
+        }));
+
+    FlushClient();
+
+    EXPECT_CALL(*mockBufferMapReadCallback, Call(DAWN_BUFFER_MAP_ASYNC_STATUS_ERROR, nullptr, 0, _))
+        .Times(1);
+
+    FlushServer();
+}
+
 // Test successful CreateBufferMapped
 TEST_F(WireBufferMappingTests, CreateBufferMappedSuccess) {
     DawnBufferDescriptor descriptor;
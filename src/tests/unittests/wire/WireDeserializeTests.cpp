@@ -0,0 +1,162 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include "dawn_wire/WireServer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace testing;
+using namespace dawn_wire;
+
+// Tests for the data pointed to by the commands, which the server uses in place in the command
+// buffer when its layout allows it.
+class WireDeserializeTests : public WireTest {
+  public:
+    WireDeserializeTests() {
+    }
+    ~WireDeserializeTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        DawnBufferDescriptor descriptor;
+        descriptor.nextInChain = nullptr;
+        descriptor.size = kBufferSize;
+        descriptor.usage = DAWN_BUFFER_USAGE_COPY_DST;
+
+        buffer = dawnDeviceCreateBuffer(device, &descriptor);
+        apiBuffer = api.GetNewBuffer();
+        EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+        FlushClient();
+    }
+
+  protected:
+    static constexpr uint64_t kBufferSize = 1024 * 1024;
+
+    DawnBuffer buffer;
+    DawnBuffer apiBuffer;
+};
+
+// Test that the data of a large SetSubData reaches the server intact.
+TEST_F(WireDeserializeTests, LargeSetSubData) {
+    std::vector<uint8_t> data(kBufferSize);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+    dawnBufferSetSubData(buffer, 0, data.size(), data.data());
+
+    EXPECT_CALL(api, BufferSetSubData(apiBuffer, 0, kBufferSize,
+                                      MatchesLambda([&data](const void* received) -> bool {
+                                          return memcmp(received, data.data(), data.size()) == 0;
+                                      })))
+        .Times(1);
+
+    FlushClient();
+}
+
+// Test that strings and arrays are deserialized correctly whatever their alignment in the command
+// buffer. The debug markers of varying length shift the position of the following commands.
+TEST_F(WireDeserializeTests, ArraysAtAllAlignments) {
+    DawnTextureFormat colorFormat = DAWN_TEXTURE_FORMAT_RGBA8_UNORM;
+    DawnRenderBundleEncoderDescriptor descriptor;
+    descriptor.nextInChain = nullptr;
+    descriptor.colorFormatsCount = 1;
+    descriptor.colorFormats = &colorFormat;
+    descriptor.depthStencilFormat = DAWN_TEXTURE_FORMAT_UNDEFINED;
+    descriptor.sampleCount = 1;
+
+    DawnRenderBundleEncoder encoder = dawnDeviceCreateRenderBundleEncoder(device, &descriptor);
+    DawnRenderBundleEncoder apiEncoder = api.GetNewRenderBundleEncoder();
+    EXPECT_CALL(api, DeviceCreateRenderBundleEncoder(apiDevice, _)).WillOnce(Return(apiEncoder));
+
+    constexpr size_t kMaxMarkerLength = 8;
+    std::array<DawnBuffer, 2> buffers = {buffer, buffer};
+    std::array<uint64_t, 2> offsets = {0x0123456789ABCDEFull, 42};
+    for (size_t markerLength = 0; markerLength < kMaxMarkerLength; ++markerLength) {
+        std::string marker(markerLength, 'a');
+        dawnRenderBundleEncoderInsertDebugMarker(encoder, marker.c_str());
+        dawnRenderBundleEncoderSetVertexBuffers(encoder, 0, 2, buffers.data(), offsets.data());
+
+        EXPECT_CALL(api, RenderBundleEncoderInsertDebugMarker(apiEncoder, StrEq(marker)))
+            .Times(1);
+    }
+
+    EXPECT_CALL(api, RenderBundleEncoderSetVertexBuffers(
+                         apiEncoder, 0, 2,
+                         MatchesLambda([this](const DawnBuffer* received) -> bool {
+                             return received[0] == apiBuffer && received[1] == apiBuffer;
+                         }),
+                         MatchesLambda([offsets](const uint64_t* received) -> bool {
+                             return memcmp(received, offsets.data(), sizeof(offsets)) == 0;
+                         })))
+        .Times(kMaxMarkerLength);
+
+    FlushClient();
+}
+
+// Test that the server reports the largest amount of memory used to deserialize a single command.
+// The descriptor of CreateBindGroup and its bindings, which contain objects, are deserialized in
+// space from the allocator.
+TEST_F(WireDeserializeTests, HighWaterMark) {
+    DawnBindGroupLayoutDescriptor bglDescriptor;
+    bglDescriptor.nextInChain = nullptr;
+    bglDescriptor.bindingCount = 0;
+    bglDescriptor.bindings = nullptr;
+    DawnBindGroupLayout bgl = dawnDeviceCreateBindGroupLayout(device, &bglDescriptor);
+    DawnBindGroupLayout apiBgl = api.GetNewBindGroupLayout();
+    EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _)).WillOnce(Return(apiBgl));
+    FlushClient();
+    size_t initialHighWaterMark = GetWireServer()->GetDeserializationHighWaterMark();
+
+    auto CreateBindGroup = [&](uint32_t bindingCount) {
+        std::vector<DawnBindGroupBinding> bindings(bindingCount);
+        for (uint32_t i = 0; i < bindingCount; ++i) {
+            bindings[i].binding = i;
+            bindings[i].buffer = buffer;
+            bindings[i].offset = 0;
+            bindings[i].size = 16;
+            bindings[i].sampler = nullptr;
+            bindings[i].textureView = nullptr;
+        }
+
+        DawnBindGroupDescriptor descriptor;
+        descriptor.nextInChain = nullptr;
+        descriptor.layout = bgl;
+        descriptor.bindingCount = bindingCount;
+        descriptor.bindings = bindings.data();
+        dawnDeviceCreateBindGroup(device, &descriptor);
+
+        EXPECT_CALL(api, DeviceCreateBindGroup(apiDevice, _))
+            .WillOnce(Return(api.GetNewBindGroup()));
+        FlushClient();
+    };
+    auto DeserializationSize = [](uint32_t bindingCount) -> size_t {
+        return sizeof(DawnBindGroupDescriptor) + bindingCount * sizeof(DawnBindGroupBinding);
+    };
+
+    CreateBindGroup(4);
+    EXPECT_EQ(std::max(initialHighWaterMark, DeserializationSize(4)),
+              GetWireServer()->GetDeserializationHighWaterMark());
+
+    // The high water mark is the size of the largest command, not the sum of the commands.
+    CreateBindGroup(64);
+    CreateBindGroup(16);
+    EXPECT_EQ(DeserializationSize(64), GetWireServer()->GetDeserializationHighWaterMark());
+}
@@ -82,3 +82,28 @@ TEST_F(WireInjectTextureTests, InjectedTextureLifetime) {
     DeleteServer();
     Mock::VerifyAndClearExpectations(&api);
 }
+
+// Test that a released ID can only be injected again with a newer generation.
+TEST_F(WireInjectTextureTests, InjectReusedIDRequiresNewerGeneration) {
+    ReservedTexture reservation = GetWireClient()->ReserveTexture(device);
+
+    DawnTexture apiTexture = api.GetNewTexture();
+    EXPECT_CALL(api, TextureReference(apiTexture));
+    ASSERT_TRUE(GetWireServer()->InjectTexture(apiTexture, reservation.id, reservation.generation));
+
+    dawnTextureRelease(reservation.texture);
+    EXPECT_CALL(api, TextureRelease(apiTexture));
+    FlushClient();
+
+    // The ID is reused by the client with the next generation.
+    ReservedTexture reuse = GetWireClient()->ReserveTexture(device);
+    ASSERT_EQ(reservation.id, reuse.id);
+    ASSERT_GT(reuse.generation, reservation.generation);
+
+    // Injecting with the stale generation fails.
+    ASSERT_FALSE(
+        GetWireServer()->InjectTexture(apiTexture, reservation.id, reservation.generation));
+
+    EXPECT_CALL(api, TextureReference(apiTexture));
+    ASSERT_TRUE(GetWireServer()->InjectTexture(apiTexture, reuse.id, reuse.generation));
+}
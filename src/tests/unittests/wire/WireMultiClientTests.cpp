@@ -0,0 +1,358 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Assert.h"
+#include "dawn/dawn.h"
+#include "dawn/dawncpp.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "utils/TerribleCommandBuffer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+    constexpr uint32_t kMaxCommandsPerTurn = 16;
+
+    // Queues the commands of a client on the server instead of handling them directly, the
+    // way a service receiving commands from several connections would.
+    class QueueingCommandHandler : public dawn_wire::CommandHandler {
+      public:
+        QueueingCommandHandler(dawn_wire::WireServer* server, uint32_t clientId)
+            : mServer(server), mClientId(clientId) {
+        }
+
+        const char* HandleCommands(const char* commands, size_t size) override {
+            mServer->QueueCommands(mClientId, commands, size);
+            return commands + size;
+        }
+
+      private:
+        dawn_wire::WireServer* mServer;
+        uint32_t mClientId;
+    };
+
+    struct ClientConnection {
+        uint32_t id;
+        std::unique_ptr<QueueingCommandHandler> handler;
+        std::unique_ptr<utils::TerribleCommandBuffer> c2sBuf;
+        std::unique_ptr<utils::TerribleCommandBuffer> s2cBuf;
+        std::unique_ptr<dawn_wire::WireClient> wireClient;
+        dawn::Device device;
+    };
+
+    // Records the order in which the server creates buffers for each native device.
+    std::vector<DawnDevice> gCreateBufferDevices;
+    DawnProcDeviceCreateBuffer gNativeCreateBuffer = nullptr;
+
+    DawnBuffer RecordingCreateBuffer(DawnDevice device, const DawnBufferDescriptor* descriptor) {
+        gCreateBufferDevices.push_back(device);
+        return gNativeCreateBuffer(device, descriptor);
+    }
+
+    void ToUint32MapReadCallback(DawnBufferMapAsyncStatus status,
+                                 const void* data,
+                                 uint64_t,
+                                 void* userdata) {
+        ASSERT_EQ(DAWN_BUFFER_MAP_ASYNC_STATUS_SUCCESS, status);
+        *static_cast<uint32_t*>(userdata) = *static_cast<const uint32_t*>(data);
+    }
+
+    void CountErrorCallback(DawnErrorType type, const char*, void* userdata) {
+        EXPECT_EQ(DAWN_ERROR_TYPE_VALIDATION, type);
+        ++*static_cast<uint32_t*>(userdata);
+    }
+
+}  // anonymous namespace
+
+// Tests for a WireServer hosting several clients, against the null backend.
+class WireMultiClientTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mInstance = std::make_unique<dawn_native::Instance>();
+        mInstance->DiscoverDefaultAdapters();
+
+        bool foundNullAdapter = false;
+        for (const dawn_native::Adapter& adapter : mInstance->GetAdapters()) {
+            if (adapter.GetBackendType() == dawn_native::BackendType::Null) {
+                mAdapter = adapter;
+                foundNullAdapter = true;
+                break;
+            }
+        }
+        ASSERT(foundNullAdapter);
+
+        mNativeProcs = dawn_native::GetProcs();
+        gCreateBufferDevices.clear();
+        gNativeCreateBuffer = mNativeProcs.deviceCreateBuffer;
+
+        DawnProcTable serverProcs = mNativeProcs;
+        serverProcs.deviceCreateBuffer = RecordingCreateBuffer;
+
+        dawn_wire::WireServerDescriptor serverDesc = {};
+        serverDesc.device = nullptr;
+        serverDesc.procs = &serverProcs;
+        serverDesc.maxCommandsPerTurn = kMaxCommandsPerTurn;
+        mWireServer = std::make_unique<dawn_wire::WireServer>(serverDesc);
+    }
+
+    void TearDown() override {
+        // Client objects must be released before the clients, and the server must be destroyed
+        // while the native devices are still alive.
+        for (auto& client : mClients) {
+            client->device = dawn::Device();
+        }
+        mClients.clear();
+        dawnSetProcs(nullptr);
+
+        mWireServer = nullptr;
+        for (DawnDevice device : mNativeDevices) {
+            mNativeProcs.deviceRelease(device);
+        }
+    }
+
+    DawnDevice CreateNativeDevice() {
+        DawnDevice device = mAdapter.CreateDevice();
+        mNativeDevices.push_back(device);
+        return device;
+    }
+
+    ClientConnection* AddClient(DawnDevice nativeDevice) {
+        auto client = std::make_unique<ClientConnection>();
+        client->s2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+
+        dawn_wire::WireServerClientDescriptor serverClientDesc = {};
+        serverClientDesc.device = nativeDevice;
+        serverClientDesc.serializer = client->s2cBuf.get();
+        client->id = mWireServer->AddClient(serverClientDesc);
+
+        client->handler = std::make_unique<QueueingCommandHandler>(mWireServer.get(), client->id);
+        client->c2sBuf = std::make_unique<utils::TerribleCommandBuffer>(client->handler.get());
+
+        dawn_wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = client->c2sBuf.get();
+        client->wireClient = std::make_unique<dawn_wire::WireClient>(clientDesc);
+        client->s2cBuf->SetHandler(client->wireClient.get());
+        client->device = dawn::Device::Acquire(client->wireClient->GetDevice());
+
+        // All wire clients share the same procs, they find their client through the objects.
+        DawnProcTable clientProcs = client->wireClient->GetProcs();
+        dawnSetProcs(&clientProcs);
+
+        mClients.push_back(std::move(client));
+        return mClients.back().get();
+    }
+
+    // Handles everything the clients queued and sends the results back to the clients.
+    bool ProcessCommands() {
+        bool success = mWireServer->ProcessQueuedCommands();
+        for (auto& client : mClients) {
+            EXPECT_TRUE(client->s2cBuf->Flush());
+        }
+        return success;
+    }
+
+    dawn::Buffer CreateMapReadBuffer(const dawn::Device& device, uint32_t value) {
+        dawn::BufferDescriptor descriptor = {};
+        descriptor.size = sizeof(value);
+        descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::CopyDst;
+
+        dawn::Buffer buffer = device.CreateBuffer(&descriptor);
+        buffer.SetSubData(0, sizeof(value), &value);
+        return buffer;
+    }
+
+    std::unique_ptr<dawn_wire::WireServer> mWireServer;
+    std::vector<std::unique_ptr<ClientConnection>> mClients;
+
+  private:
+    std::unique_ptr<dawn_native::Instance> mInstance;
+    dawn_native::Adapter mAdapter;
+    DawnProcTable mNativeProcs;
+    std::vector<DawnDevice> mNativeDevices;
+};
+
+// Test that clients use the same object ids without seeing each other's objects.
+TEST_F(WireMultiClientTests, ObjectNamespacesAreIsolated) {
+    ClientConnection* clientA = AddClient(CreateNativeDevice());
+    ClientConnection* clientB = AddClient(CreateNativeDevice());
+
+    // Both buffers get the same wire id, in different namespaces.
+    dawn::Buffer bufferA = CreateMapReadBuffer(clientA->device, 0xAAAAAAAA);
+    dawn::Buffer bufferB = CreateMapReadBuffer(clientB->device, 0xBBBBBBBB);
+
+    uint32_t valueA = 0;
+    uint32_t valueB = 0;
+    bufferA.MapReadAsync(ToUint32MapReadCallback, &valueA);
+    bufferB.MapReadAsync(ToUint32MapReadCallback, &valueB);
+
+    ASSERT_TRUE(clientA->c2sBuf->Flush());
+    ASSERT_TRUE(clientB->c2sBuf->Flush());
+    for (int i = 0; i < 10 && (valueA == 0 || valueB == 0); ++i) {
+        ASSERT_TRUE(ProcessCommands());
+    }
+
+    EXPECT_EQ(0xAAAAAAAAu, valueA);
+    EXPECT_EQ(0xBBBBBBBBu, valueB);
+}
+
+// Test that a client with a large backlog doesn't delay the commands of other clients until
+// its backlog is fully handled.
+TEST_F(WireMultiClientTests, RoundRobinBetweenClients) {
+    DawnDevice nativeDeviceA = CreateNativeDevice();
+    DawnDevice nativeDeviceB = CreateNativeDevice();
+    ClientConnection* clientA = AddClient(nativeDeviceA);
+    ClientConnection* clientB = AddClient(nativeDeviceB);
+    ASSERT_LT(clientA->id, clientB->id);
+
+    constexpr uint32_t kBacklogSize = 50 * kMaxCommandsPerTurn;
+    constexpr uint32_t kSmallWorkloadSize = kMaxCommandsPerTurn / 2;
+
+    dawn::BufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::CopyDst;
+    for (uint32_t i = 0; i < kBacklogSize; ++i) {
+        clientA->device.CreateBuffer(&descriptor);
+    }
+    for (uint32_t i = 0; i < kSmallWorkloadSize; ++i) {
+        clientB->device.CreateBuffer(&descriptor);
+    }
+    ASSERT_TRUE(clientA->c2sBuf->Flush());
+    ASSERT_TRUE(clientB->c2sBuf->Flush());
+
+    ASSERT_TRUE(ProcessCommands());
+
+    // All of client B's buffers are created in its first turn, after a single turn of client A.
+    ASSERT_EQ(kBacklogSize + kSmallWorkloadSize, gCreateBufferDevices.size());
+    auto lastB = std::find(gCreateBufferDevices.rbegin(), gCreateBufferDevices.rend(),
+                           nativeDeviceB);
+    size_t lastBIndex = gCreateBufferDevices.rend() - lastB - 1;
+    EXPECT_LT(lastBIndex, kMaxCommandsPerTurn + kSmallWorkloadSize);
+}
+
+// Test that several threads can record and queue commands for their clients concurrently.
+TEST_F(WireMultiClientTests, QueueFromSeveralThreads) {
+    constexpr uint32_t kNumClients = 3;
+    constexpr uint32_t kNumBuffers = 20;
+
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        AddClient(CreateNativeDevice());
+    }
+
+    std::vector<std::vector<dawn::Buffer>> buffers(kNumClients);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        threads.emplace_back([&, i]() {
+            for (uint32_t j = 0; j < kNumBuffers; ++j) {
+                buffers[i].push_back(CreateMapReadBuffer(mClients[i]->device, i * 1000 + j + 1));
+                EXPECT_TRUE(mClients[i]->c2sBuf->Flush());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<std::vector<uint32_t>> values(kNumClients,
+                                              std::vector<uint32_t>(kNumBuffers, 0));
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        for (uint32_t j = 0; j < kNumBuffers; ++j) {
+            buffers[i][j].MapReadAsync(ToUint32MapReadCallback, &values[i][j]);
+        }
+        ASSERT_TRUE(mClients[i]->c2sBuf->Flush());
+    }
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(ProcessCommands());
+    }
+
+    for (uint32_t i = 0; i < kNumClients; ++i) {
+        for (uint32_t j = 0; j < kNumBuffers; ++j) {
+            EXPECT_EQ(i * 1000 + j + 1, values[i][j]);
+        }
+    }
+}
+
+// Test that a client sending invalid commands is lost without affecting other clients.
+TEST_F(WireMultiClientTests, InvalidCommandsOnlyLoseTheirClient) {
+    ClientConnection* badClient = AddClient(CreateNativeDevice());
+    ClientConnection* goodClient = AddClient(CreateNativeDevice());
+
+    dawn::Buffer buffer = CreateMapReadBuffer(goodClient->device, 42);
+    uint32_t value = 0;
+    buffer.MapReadAsync(ToUint32MapReadCallback, &value);
+    ASSERT_TRUE(goodClient->c2sBuf->Flush());
+
+    const char garbage[] = {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F};
+    mWireServer->QueueCommands(badClient->id, garbage, sizeof(garbage));
+
+    ASSERT_FALSE(ProcessCommands());
+    EXPECT_TRUE(mWireServer->IsClientLost(badClient->id));
+    EXPECT_FALSE(mWireServer->IsClientLost(goodClient->id));
+
+    for (int i = 0; i < 10 && value == 0; ++i) {
+        ASSERT_TRUE(ProcessCommands());
+    }
+    EXPECT_EQ(42u, value);
+
+    // Further commands from the lost client are dropped.
+    EXPECT_EQ(nullptr, mWireServer->HandleCommands(badClient->id, garbage, 0));
+}
+
+// Test that clients sharing a device all receive its uncaptured errors.
+TEST_F(WireMultiClientTests, SharedDeviceErrorsAreSentToAllClients) {
+    DawnDevice nativeDevice = CreateNativeDevice();
+    ClientConnection* clientA = AddClient(nativeDevice);
+    ClientConnection* clientB = AddClient(nativeDevice);
+
+    uint32_t errorCountA = 0;
+    uint32_t errorCountB = 0;
+    clientA->device.SetUncapturedErrorCallback(CountErrorCallback, &errorCountA);
+    clientB->device.SetUncapturedErrorCallback(CountErrorCallback, &errorCountB);
+
+    // MapRead and MapWrite can't be used together.
+    dawn::BufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::MapRead | dawn::BufferUsage::MapWrite;
+    clientA->device.CreateBuffer(&descriptor);
+    ASSERT_TRUE(clientA->c2sBuf->Flush());
+
+    ASSERT_TRUE(ProcessCommands());
+    EXPECT_EQ(1u, errorCountA);
+    EXPECT_EQ(1u, errorCountB);
+}
+
+// Test that removed clients no longer have their commands handled.
+TEST_F(WireMultiClientTests, RemoveClient) {
+    ClientConnection* clientA = AddClient(CreateNativeDevice());
+    ClientConnection* clientB = AddClient(CreateNativeDevice());
+
+    dawn::BufferDescriptor descriptor = {};
+    descriptor.size = 4;
+    descriptor.usage = dawn::BufferUsage::CopyDst;
+    clientA->device.CreateBuffer(&descriptor);
+    clientB->device.CreateBuffer(&descriptor);
+    ASSERT_TRUE(clientA->c2sBuf->Flush());
+    ASSERT_TRUE(clientB->c2sBuf->Flush());
+
+    mWireServer->RemoveClient(clientA->id);
+    EXPECT_TRUE(mWireServer->IsClientLost(clientA->id));
+    EXPECT_FALSE(mWireServer->IsClientLost(clientB->id));
+
+    ASSERT_TRUE(ProcessCommands());
+    ASSERT_EQ(1u, gCreateBufferDevices.size());
+}
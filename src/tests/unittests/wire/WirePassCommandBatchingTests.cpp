@@ -0,0 +1,240 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include <array>
+
+using namespace testing;
+using namespace dawn_wire;
+
+class WirePassCommandBatchingTests : public WireTest {
+  public:
+    WirePassCommandBatchingTests() {
+    }
+    ~WirePassCommandBatchingTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        DawnCommandEncoder encoder = dawnDeviceCreateCommandEncoder(device, nullptr);
+        apiEncoder = api.GetNewCommandEncoder();
+        EXPECT_CALL(api, DeviceCreateCommandEncoder(apiDevice, nullptr))
+            .WillOnce(Return(apiEncoder));
+
+        DawnRenderPassDescriptor passDescriptor;
+        passDescriptor.colorAttachmentCount = 0;
+        passDescriptor.colorAttachments = nullptr;
+        passDescriptor.depthStencilAttachment = nullptr;
+
+        pass = dawnCommandEncoderBeginRenderPass(encoder, &passDescriptor);
+        apiPass = api.GetNewRenderPassEncoder();
+        EXPECT_CALL(api, CommandEncoderBeginRenderPass(apiEncoder, _)).WillOnce(Return(apiPass));
+
+        FlushClient();
+    }
+
+  protected:
+    DawnRenderPipeline CreateRenderPipeline(DawnRenderPipeline apiPipeline) {
+        DawnShaderModuleDescriptor moduleDescriptor;
+        moduleDescriptor.nextInChain = nullptr;
+        moduleDescriptor.codeSize = 0;
+        DawnShaderModule module = dawnDeviceCreateShaderModule(device, &moduleDescriptor);
+        EXPECT_CALL(api, DeviceCreateShaderModule(apiDevice, _))
+            .WillOnce(Return(api.GetNewShaderModule()));
+
+        DawnPipelineLayoutDescriptor layoutDescriptor;
+        layoutDescriptor.nextInChain = nullptr;
+        layoutDescriptor.bindGroupLayoutCount = 0;
+        layoutDescriptor.bindGroupLayouts = nullptr;
+        DawnPipelineLayout layout = dawnDeviceCreatePipelineLayout(device, &layoutDescriptor);
+        EXPECT_CALL(api, DeviceCreatePipelineLayout(apiDevice, _))
+            .WillOnce(Return(api.GetNewPipelineLayout()));
+
+        DawnRenderPipelineDescriptor pipelineDescriptor;
+        pipelineDescriptor.nextInChain = nullptr;
+        pipelineDescriptor.layout = layout;
+        pipelineDescriptor.vertexStage.nextInChain = nullptr;
+        pipelineDescriptor.vertexStage.module = module;
+        pipelineDescriptor.vertexStage.entryPoint = "main";
+        pipelineDescriptor.fragmentStage = nullptr;
+        pipelineDescriptor.vertexInput = nullptr;
+        pipelineDescriptor.primitiveTopology = DAWN_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        pipelineDescriptor.rasterizationState = nullptr;
+        pipelineDescriptor.sampleCount = 1;
+        pipelineDescriptor.depthStencilState = nullptr;
+        pipelineDescriptor.colorStateCount = 0;
+        pipelineDescriptor.colorStates = nullptr;
+        pipelineDescriptor.sampleMask = 0xFFFFFFFF;
+        pipelineDescriptor.alphaToCoverageEnabled = false;
+
+        DawnRenderPipeline pipeline = dawnDeviceCreateRenderPipeline(device, &pipelineDescriptor);
+        EXPECT_CALL(api, DeviceCreateRenderPipeline(apiDevice, _)).WillOnce(Return(apiPipeline));
+
+        return pipeline;
+    }
+
+    DawnBindGroup CreateBindGroup(DawnBindGroup apiBindGroup) {
+        DawnBindGroupLayoutDescriptor bglDescriptor;
+        bglDescriptor.nextInChain = nullptr;
+        bglDescriptor.bindingCount = 0;
+        bglDescriptor.bindings = nullptr;
+        DawnBindGroupLayout bgl = dawnDeviceCreateBindGroupLayout(device, &bglDescriptor);
+        EXPECT_CALL(api, DeviceCreateBindGroupLayout(apiDevice, _))
+            .WillOnce(Return(api.GetNewBindGroupLayout()));
+
+        DawnBindGroupDescriptor bindGroupDescriptor;
+        bindGroupDescriptor.nextInChain = nullptr;
+        bindGroupDescriptor.layout = bgl;
+        bindGroupDescriptor.bindingCount = 0;
+        bindGroupDescriptor.bindings = nullptr;
+        DawnBindGroup bindGroup = dawnDeviceCreateBindGroup(device, &bindGroupDescriptor);
+        EXPECT_CALL(api, DeviceCreateBindGroup(apiDevice, _)).WillOnce(Return(apiBindGroup));
+
+        return bindGroup;
+    }
+
+    DawnCommandEncoder apiEncoder;
+    DawnRenderPassEncoder pass;
+    DawnRenderPassEncoder apiPass;
+
+  private:
+    bool BatchRenderPassCommands() override {
+        return true;
+    }
+};
+
+// The same tests without batching, to check that batching doesn't change which commands are
+// errors.
+class WirePassCommandNoBatchingTests : public WirePassCommandBatchingTests {
+  private:
+    bool BatchRenderPassCommands() override {
+        return false;
+    }
+};
+
+// Test that batched commands are not sent until another command is serialized, and are then
+// replayed on the server in order.
+TEST_F(WirePassCommandBatchingTests, BatchedUntilNextCommand) {
+    dawnRenderPassEncoderDraw(pass, 3, 1, 0, 0);
+    dawnRenderPassEncoderDrawIndexed(pass, 6, 2, 1, -4, 3);
+
+    // Nothing reaches the server while the batch is pending.
+    FlushClient();
+
+    dawnRenderPassEncoderEndPass(pass);
+    {
+        InSequence s;
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 3, 1, 0, 0)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderDrawIndexed(apiPass, 6, 2, 1, -4, 3)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderEndPass(apiPass)).Times(1);
+    }
+    FlushClient();
+}
+
+// Test that non-batched pass commands interleaved with batched ones keep their order.
+TEST_F(WirePassCommandBatchingTests, InterleavedWithUnbatchedCommands) {
+    dawnRenderPassEncoderDraw(pass, 1, 1, 0, 0);
+    dawnRenderPassEncoderSetStencilReference(pass, 42);
+    dawnRenderPassEncoderDraw(pass, 2, 1, 0, 0);
+    dawnRenderPassEncoderEndPass(pass);
+    {
+        InSequence s;
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 1, 1, 0, 0)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderSetStencilReference(apiPass, 42)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 2, 1, 0, 0)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderEndPass(apiPass)).Times(1);
+    }
+    FlushClient();
+}
+
+// Test that object arguments and dynamic offsets are batched correctly.
+TEST_F(WirePassCommandBatchingTests, SetPipelineAndBindGroup) {
+    DawnRenderPipeline apiPipeline = api.GetNewRenderPipeline();
+    DawnRenderPipeline pipeline = CreateRenderPipeline(apiPipeline);
+    DawnBindGroup apiBindGroup = api.GetNewBindGroup();
+    DawnBindGroup bindGroup = CreateBindGroup(apiBindGroup);
+    FlushClient();
+
+    std::array<uint64_t, 3> testOffsets = {0, 256, 0xDEAD'BEEF'DEAD'BEEFu};
+
+    dawnRenderPassEncoderSetPipeline(pass, pipeline);
+    dawnRenderPassEncoderSetBindGroup(pass, 1, bindGroup, testOffsets.size(), testOffsets.data());
+    dawnRenderPassEncoderSetBindGroup(pass, 2, bindGroup, 0, nullptr);
+    dawnRenderPassEncoderDraw(pass, 3, 1, 0, 0);
+    dawnRenderPassEncoderEndPass(pass);
+    {
+        InSequence s;
+        EXPECT_CALL(api, RenderPassEncoderSetPipeline(apiPass, apiPipeline)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderSetBindGroup(
+                             apiPass, 1, apiBindGroup, testOffsets.size(),
+                             MatchesLambda([testOffsets](const uint64_t* offsets) -> bool {
+                                 for (size_t i = 0; i < testOffsets.size(); i++) {
+                                     if (offsets[i] != testOffsets[i]) {
+                                         return false;
+                                     }
+                                 }
+                                 return true;
+                             })))
+            .Times(1);
+        EXPECT_CALL(api, RenderPassEncoderSetBindGroup(apiPass, 2, apiBindGroup, 0, _)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderDraw(apiPass, 3, 1, 0, 0)).Times(1);
+        EXPECT_CALL(api, RenderPassEncoderEndPass(apiPass)).Times(1);
+    }
+    FlushClient();
+}
+
+// Test that releasing an object used by a pending batch is sent after the batch.
+TEST_F(WirePassCommandBatchingTests, ReleaseAfterUse) {
+    DawnRenderPipeline apiPipeline = api.GetNewRenderPipeline();
+    DawnRenderPipeline pipeline = CreateRenderPipeline(apiPipeline);
+    FlushClient();
+
+    dawnRenderPassEncoderSetPipeline(pass, pipeline);
+    dawnRenderPipelineRelease(pipeline);
+    {
+        InSequence s;
+        EXPECT_CALL(api, RenderPassEncoderSetPipeline(apiPass, apiPipeline)).Times(1);
+        EXPECT_CALL(api, RenderPipelineRelease(apiPipeline)).Times(1);
+    }
+    FlushClient();
+}
+
+// Test that a batch referencing a null pipeline is a fatal error for the server, like the
+// unbatched command.
+TEST_F(WirePassCommandBatchingTests, NullPipelineIsFatal) {
+    dawnRenderPassEncoderSetPipeline(pass, nullptr);
+    dawnRenderPassEncoderEndPass(pass);
+    FlushClient(false);
+}
+
+TEST_F(WirePassCommandNoBatchingTests, NullPipelineIsFatal) {
+    dawnRenderPassEncoderSetPipeline(pass, nullptr);
+    dawnRenderPassEncoderEndPass(pass);
+    FlushClient(false);
+}
+
+// Test that a batch referencing a null bind group is a fatal error for the server, like the
+// unbatched command.
+TEST_F(WirePassCommandBatchingTests, NullBindGroupIsFatal) {
+    dawnRenderPassEncoderSetBindGroup(pass, 0, nullptr, 0, nullptr);
+    dawnRenderPassEncoderEndPass(pass);
+    FlushClient(false);
+}
+
+TEST_F(WirePassCommandNoBatchingTests, NullBindGroupIsFatal) {
+    dawnRenderPassEncoderSetBindGroup(pass, 0, nullptr, 0, nullptr);
+    dawnRenderPassEncoderEndPass(pass);
+    FlushClient(false);
+}
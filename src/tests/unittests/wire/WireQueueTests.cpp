@@ -0,0 +1,125 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+#include <array>
+#include <cstring>
+
+using namespace testing;
+using namespace dawn_wire;
+
+class WireQueueTests : public WireTest {
+  public:
+    WireQueueTests() {
+    }
+    ~WireQueueTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        queue = dawnDeviceCreateQueue(device);
+        apiQueue = api.GetNewQueue();
+        EXPECT_CALL(api, DeviceCreateQueue(apiDevice)).WillOnce(Return(apiQueue));
+        FlushClient();
+    }
+
+  protected:
+    DawnQueue queue;
+    DawnQueue apiQueue;
+};
+
+// Test that WriteBuffer sends the data inline with the command
+TEST_F(WireQueueTests, WriteBuffer) {
+    DawnBufferDescriptor descriptor;
+    descriptor.nextInChain = nullptr;
+    descriptor.size = 16;
+    descriptor.usage = DAWN_BUFFER_USAGE_COPY_DST;
+
+    DawnBuffer buffer = dawnDeviceCreateBuffer(device, &descriptor);
+    DawnBuffer apiBuffer = api.GetNewBuffer();
+    EXPECT_CALL(api, DeviceCreateBuffer(apiDevice, _)).WillOnce(Return(apiBuffer));
+
+    std::array<uint32_t, 3> data = {1, 0xDEADBEEF, 3};
+    dawnQueueWriteBuffer(queue, buffer, 4, data.data(), sizeof(data));
+
+    EXPECT_CALL(api, QueueWriteBuffer(apiQueue, apiBuffer, 4,
+                                      MatchesLambda([data](const void* written) -> bool {
+                                          return memcmp(written, data.data(), sizeof(data)) == 0;
+                                      }),
+                                      sizeof(data)))
+        .Times(1);
+
+    FlushClient();
+}
+
+// Test that WriteTexture sends the data and the structures describing the write
+TEST_F(WireQueueTests, WriteTexture) {
+    DawnTextureDescriptor descriptor;
+    descriptor.nextInChain = nullptr;
+    descriptor.usage = DAWN_TEXTURE_USAGE_COPY_DST;
+    descriptor.dimension = DAWN_TEXTURE_DIMENSION_2D;
+    descriptor.size = {4, 4, 1};
+    descriptor.arrayLayerCount = 1;
+    descriptor.format = DAWN_TEXTURE_FORMAT_RGBA8_UNORM;
+    descriptor.mipLevelCount = 1;
+    descriptor.sampleCount = 1;
+
+    DawnTexture texture = dawnDeviceCreateTexture(device, &descriptor);
+    DawnTexture apiTexture = api.GetNewTexture();
+    EXPECT_CALL(api, DeviceCreateTexture(apiDevice, _)).WillOnce(Return(apiTexture));
+
+    DawnTextureCopyView textureCopyView;
+    textureCopyView.nextInChain = nullptr;
+    textureCopyView.texture = texture;
+    textureCopyView.mipLevel = 0;
+    textureCopyView.arrayLayer = 0;
+    textureCopyView.origin = {1, 2, 0};
+
+    DawnTextureDataLayout dataLayout;
+    dataLayout.nextInChain = nullptr;
+    dataLayout.offset = 4;
+    dataLayout.rowPitch = 12;
+    dataLayout.imageHeight = 0;
+
+    DawnExtent3D writeSize = {2, 2, 1};
+
+    std::array<uint8_t, 28> data;
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    dawnQueueWriteTexture(queue, &textureCopyView, data.data(), data.size(), &dataLayout,
+                          &writeSize);
+
+    EXPECT_CALL(
+        api,
+        QueueWriteTexture(
+            apiQueue, MatchesLambda([apiTexture](const DawnTextureCopyView* view) -> bool {
+                return view->texture == apiTexture && view->mipLevel == 0 &&
+                       view->arrayLayer == 0 && view->origin.x == 1 && view->origin.y == 2 &&
+                       view->origin.z == 0;
+            }),
+            MatchesLambda([data](const void* written) -> bool {
+                return memcmp(written, data.data(), data.size()) == 0;
+            }),
+            data.size(), MatchesLambda([](const DawnTextureDataLayout* layout) -> bool {
+                return layout->offset == 4 && layout->rowPitch == 12 && layout->imageHeight == 0;
+            }),
+            MatchesLambda([](const DawnExtent3D* size) -> bool {
+                return size->width == 2 && size->height == 2 && size->depth == 1;
+            })))
+        .Times(1);
+
+    FlushClient();
+}
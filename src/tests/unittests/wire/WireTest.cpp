@@ -35,6 +35,10 @@ server::MemoryTransferService* WireTest::GetServerMemoryTransferService() {
     return nullptr;
 }
 
+bool WireTest::BatchRenderPassCommands() {
+    return false;
+}
+
 void WireTest::SetUp() {
     DawnProcTable mockProcs;
     DawnDevice mockDevice;
@@ -59,6 +63,7 @@ void WireTest::SetUp() {
     WireClientDescriptor clientDesc = {};
     clientDesc.serializer = mC2sBuf.get();
     clientDesc.memoryTransferService = GetClientMemoryTransferService();
+    clientDesc.batchRenderPassCommands = BatchRenderPassCommands();
 
     mWireClient.reset(new WireClient(clientDesc));
     mS2cBuf->SetHandler(mWireClient.get());
@@ -106,6 +106,7 @@ class WireTest : public testing::Test {
 
     virtual dawn_wire::client::MemoryTransferService* GetClientMemoryTransferService();
     virtual dawn_wire::server::MemoryTransferService* GetServerMemoryTransferService();
+    virtual bool BatchRenderPassCommands();
 
     std::unique_ptr<dawn_wire::WireServer> mWireServer;
     std::unique_ptr<dawn_wire::WireClient> mWireClient;
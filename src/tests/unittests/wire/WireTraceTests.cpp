@@ -0,0 +1,297 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Assert.h"
+#include "dawn/dawn.h"
+#include "dawn/dawncpp.h"
+#include "dawn_native/DawnNative.h"
+#include "dawn_wire/WireClient.h"
+#include "dawn_wire/WireServer.h"
+#include "utils/TerribleCommandBuffer.h"
+#include "utils/WireTrace.h"
+
+#include <cstdio>
+
+namespace {
+
+    constexpr char kTraceFilename[] = "dawn_wire_trace_tests.trace";
+
+    // Keeps the commands sent by the server during the replay to check them against the trace.
+    class CollectingCommandHandler : public dawn_wire::CommandHandler {
+      public:
+        const char* HandleCommands(const char* commands, size_t size) override {
+            mCommands.insert(mCommands.end(), commands, commands + size);
+            return commands + size;
+        }
+
+        const std::vector<char>& GetCommands() const {
+            return mCommands;
+        }
+
+      private:
+        std::vector<char> mCommands;
+    };
+
+    // Counts the buffers created by the server during the replay.
+    uint32_t gCreatedBufferCount = 0;
+    DawnProcDeviceCreateBuffer gNativeCreateBuffer = nullptr;
+
+    DawnBuffer CountingCreateBuffer(DawnDevice device, const DawnBufferDescriptor* descriptor) {
+        gCreatedBufferCount++;
+        return gNativeCreateBuffer(device, descriptor);
+    }
+
+    void CountErrorCallback(DawnErrorType type, const char*, void* userdata) {
+        EXPECT_EQ(DAWN_ERROR_TYPE_VALIDATION, type);
+        ++*static_cast<uint32_t*>(userdata);
+    }
+
+}  // anonymous namespace
+
+// Tests for recording the commands of a wire session and replaying them, against the null
+// backend.
+class WireTraceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        mInstance = std::make_unique<dawn_native::Instance>();
+        mInstance->DiscoverDefaultAdapters();
+
+        bool foundNullAdapter = false;
+        for (const dawn_native::Adapter& adapter : mInstance->GetAdapters()) {
+            if (adapter.GetBackendType() == dawn_native::BackendType::Null) {
+                mAdapter = adapter;
+                foundNullAdapter = true;
+                break;
+            }
+        }
+        ASSERT(foundNullAdapter);
+
+        mNativeProcs = dawn_native::GetProcs();
+    }
+
+    void TearDown() override {
+        remove(kTraceFilename);
+    }
+
+    dawn::Buffer CreateBuffer(const dawn::Device& device, dawn::BufferUsage usage) {
+        dawn::BufferDescriptor descriptor = {};
+        descriptor.size = 4;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+
+    // Records two frames with a WireTraceSerializer on each side of the wire.
+    void RecordTrace() {
+        utils::WireTraceWriter writer;
+        ASSERT_TRUE(writer.Open(kTraceFilename));
+
+        DawnDevice nativeDevice = mAdapter.CreateDevice();
+        auto c2sBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        auto s2cBuf = std::make_unique<utils::TerribleCommandBuffer>();
+        utils::WireTraceSerializer c2sTrace(c2sBuf.get(), &writer,
+                                            utils::WireTraceChunkType::ClientCommands);
+        utils::WireTraceSerializer s2cTrace(s2cBuf.get(), &writer,
+                                            utils::WireTraceChunkType::ServerCommands);
+
+        dawn_wire::WireServerDescriptor serverDesc = {};
+        serverDesc.device = nativeDevice;
+        serverDesc.procs = &mNativeProcs;
+        serverDesc.serializer = &s2cTrace;
+        auto wireServer = std::make_unique<dawn_wire::WireServer>(serverDesc);
+        c2sBuf->SetHandler(wireServer.get());
+
+        dawn_wire::WireClientDescriptor clientDesc = {};
+        clientDesc.serializer = &c2sTrace;
+        auto wireClient = std::make_unique<dawn_wire::WireClient>(clientDesc);
+        s2cBuf->SetHandler(wireClient.get());
+
+        DawnProcTable clientProcs = wireClient->GetProcs();
+        dawnSetProcs(&clientProcs);
+        {
+            dawn::Device device = dawn::Device::Acquire(wireClient->GetDevice());
+            uint32_t errorCount = 0;
+            device.SetUncapturedErrorCallback(CountErrorCallback, &errorCount);
+
+            // The first frame creates an invalid buffer so that the server sends an error back.
+            uint32_t value = 0x01020304;
+            dawn::Buffer source = CreateBuffer(device, dawn::BufferUsage::CopySrc |
+                                                           dawn::BufferUsage::CopyDst);
+            source.SetSubData(0, sizeof(value), &value);
+            CreateBuffer(device, dawn::BufferUsage::MapRead | dawn::BufferUsage::MapWrite);
+            ASSERT_TRUE(c2sTrace.Flush());
+            ASSERT_TRUE(s2cTrace.Flush());
+            ASSERT_TRUE(writer.EndFrame());
+            EXPECT_EQ(1u, errorCount);
+
+            dawn::Buffer destination = CreateBuffer(device, dawn::BufferUsage::CopyDst);
+            dawn::CommandEncoder encoder = device.CreateCommandEncoder();
+            encoder.CopyBufferToBuffer(source, 0, destination, 0, sizeof(value));
+            dawn::CommandBuffer commands = encoder.Finish();
+            device.CreateQueue().Submit(1, &commands);
+            ASSERT_TRUE(c2sTrace.Flush());
+            ASSERT_TRUE(s2cTrace.Flush());
+            ASSERT_TRUE(writer.EndFrame());
+        }
+        ASSERT_TRUE(c2sTrace.Flush());
+        dawnSetProcs(nullptr);
+
+        // The server must be destroyed while the native device is still alive.
+        wireClient = nullptr;
+        wireServer = nullptr;
+        mNativeProcs.deviceRelease(nativeDevice);
+    }
+
+    dawn_native::Adapter mAdapter;
+    DawnProcTable mNativeProcs;
+
+  private:
+    std::unique_ptr<dawn_native::Instance> mInstance;
+};
+
+// Test that a recorded trace replays on a new device and makes the server send the same amount
+// of commands.
+TEST_F(WireTraceTests, RecordAndReplay) {
+    ASSERT_NO_FATAL_FAILURE(RecordTrace());
+
+    utils::WireTraceReader reader;
+    ASSERT_TRUE(reader.Open(kTraceFilename));
+
+    std::vector<std::vector<char>> clientCommands;
+    std::vector<char> serverCommands;
+    uint32_t frameCount = 0;
+    utils::WireTraceChunk chunk;
+    while (reader.ReadChunk(&chunk)) {
+        switch (chunk.type) {
+            case utils::WireTraceChunkType::ClientCommands:
+                clientCommands.push_back(chunk.data);
+                break;
+            case utils::WireTraceChunkType::ServerCommands:
+                serverCommands.insert(serverCommands.end(), chunk.data.begin(), chunk.data.end());
+                break;
+            case utils::WireTraceChunkType::EndOfFrame:
+                frameCount++;
+                break;
+        }
+    }
+    ASSERT_FALSE(reader.IsMalformed());
+    EXPECT_EQ(2u, frameCount);
+    EXPECT_GE(clientCommands.size(), 2u);
+    EXPECT_FALSE(serverCommands.empty());
+
+    // Replay the client commands on a new device.
+    DawnDevice nativeDevice = mAdapter.CreateDevice();
+    gCreatedBufferCount = 0;
+    gNativeCreateBuffer = mNativeProcs.deviceCreateBuffer;
+    DawnProcTable serverProcs = mNativeProcs;
+    serverProcs.deviceCreateBuffer = CountingCreateBuffer;
+
+    CollectingCommandHandler replayedServerCommands;
+    auto s2cBuf = std::make_unique<utils::TerribleCommandBuffer>(&replayedServerCommands);
+
+    dawn_wire::WireServerDescriptor serverDesc = {};
+    serverDesc.device = nativeDevice;
+    serverDesc.procs = &serverProcs;
+    serverDesc.serializer = s2cBuf.get();
+    {
+        dawn_wire::WireServer wireServer(serverDesc);
+        for (const std::vector<char>& commands : clientCommands) {
+            ASSERT_NE(nullptr, wireServer.HandleCommands(commands.data(), commands.size()));
+        }
+        ASSERT_TRUE(s2cBuf->Flush());
+    }
+    mNativeProcs.deviceRelease(nativeDevice);
+
+    EXPECT_EQ(3u, gCreatedBufferCount);
+    // The commands can't be compared byte for byte since they contain padding.
+    EXPECT_EQ(serverCommands.size(), replayedServerCommands.GetCommands().size());
+}
+
+// Test that files that aren't traces and truncated traces are rejected.
+TEST_F(WireTraceTests, MalformedTracesAreRejected) {
+    utils::WireTraceReader reader;
+
+    // A file that isn't a trace.
+    {
+        FILE* file = fopen(kTraceFilename, "wb");
+        ASSERT_NE(nullptr, file);
+        fputs("This is not a trace", file);
+        fclose(file);
+    }
+    EXPECT_FALSE(reader.Open(kTraceFilename));
+    EXPECT_TRUE(reader.IsMalformed());
+
+    // A trace from before strings were serialized with their null terminator.
+    {
+        FILE* file = fopen(kTraceFilename, "wb");
+        ASSERT_NE(nullptr, file);
+        uint32_t version = 1;
+        fputs("DAWNWIRE", file);
+        fwrite(&version, sizeof(version), 1, file);
+        fclose(file);
+    }
+    EXPECT_FALSE(reader.Open(kTraceFilename));
+    EXPECT_TRUE(reader.IsMalformed());
+
+    // A trace with a chunk that is shorter than its size.
+    {
+        utils::WireTraceWriter writer;
+        ASSERT_TRUE(writer.Open(kTraceFilename));
+        ASSERT_TRUE(writer.WriteChunk(utils::WireTraceChunkType::ClientCommands, "abcd", 4));
+        ASSERT_TRUE(writer.EndFrame());
+    }
+    {
+        FILE* file = fopen(kTraceFilename, "rb");
+        ASSERT_NE(nullptr, file);
+        fseek(file, 0, SEEK_END);
+        std::vector<char> data(static_cast<size_t>(ftell(file)));
+        fseek(file, 0, SEEK_SET);
+        ASSERT_EQ(data.size(), fread(data.data(), 1, data.size(), file));
+        fclose(file);
+
+        // Drop the end of frame and the last byte of the commands.
+        file = fopen(kTraceFilename, "wb");
+        size_t truncatedSize = data.size() - 12 - 1;
+        ASSERT_EQ(truncatedSize, fwrite(data.data(), 1, truncatedSize, file));
+        fclose(file);
+    }
+
+    ASSERT_TRUE(reader.Open(kTraceFilename));
+    EXPECT_FALSE(reader.IsMalformed());
+
+    utils::WireTraceChunk chunk;
+    EXPECT_FALSE(reader.ReadChunk(&chunk));
+    EXPECT_TRUE(reader.IsMalformed());
+}
+
+// Test that the last chunk of a trace is followed by the normal end of the trace.
+TEST_F(WireTraceTests, EndOfTrace) {
+    {
+        utils::WireTraceWriter writer;
+        ASSERT_TRUE(writer.Open(kTraceFilename));
+        ASSERT_TRUE(writer.WriteChunk(utils::WireTraceChunkType::ClientCommands, "abcd", 4));
+    }
+
+    utils::WireTraceReader reader;
+    ASSERT_TRUE(reader.Open(kTraceFilename));
+
+    utils::WireTraceChunk chunk;
+    ASSERT_TRUE(reader.ReadChunk(&chunk));
+    EXPECT_EQ(utils::WireTraceChunkType::ClientCommands, chunk.type);
+    EXPECT_EQ(std::vector<char>({'a', 'b', 'c', 'd'}), chunk.data);
+
+    EXPECT_FALSE(reader.ReadChunk(&chunk));
+    EXPECT_FALSE(reader.IsMalformed());
+}
@@ -0,0 +1,156 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the CPU cost of recording Draw and SetBindGroup with the dawn:: C++ API on the null
+// backend. It is built once against libdawn, where each call goes through the proc table, and
+// once against libdawn_native_cpp, where each call goes directly to dawn_native, so that the
+// cost of the dispatch can be compared. The direct dispatch build defines DAWN_DIRECT_DISPATCH.
+
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/DawnHelpers.h"
+#include "utils/Timer.h"
+
+#include <dawn/dawn.h>
+#include <dawn/dawncpp.h>
+#include <dawn_native/DawnNative.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+    constexpr unsigned int kCallsPerPass = 10000;
+    constexpr unsigned int kPassCount = 100;
+    constexpr uint32_t kRenderTargetSize = 16;
+
+    struct BenchmarkObjects {
+        dawn::Device device;
+        dawn::Queue queue;
+        utils::BasicRenderPass renderPass;
+        dawn::RenderPipeline pipeline;
+        dawn::BindGroup bindGroups[2];
+    };
+
+    BenchmarkObjects CreateObjects(dawn::Device device) {
+        BenchmarkObjects objects;
+        objects.device = device;
+        objects.queue = device.CreateQueue();
+        objects.renderPass =
+            utils::CreateBasicRenderPass(device, kRenderTargetSize, kRenderTargetSize);
+
+        dawn::BufferDescriptor bufferDesc;
+        bufferDesc.size = 256;
+        bufferDesc.usage = dawn::BufferUsage::Uniform;
+        dawn::Buffer uniformBuffer = device.CreateBuffer(&bufferDesc);
+
+        dawn::BindGroupLayout layout = utils::MakeBindGroupLayout(
+            device, {{0, dawn::ShaderStage::Vertex, dawn::BindingType::UniformBuffer}});
+        for (dawn::BindGroup& bindGroup : objects.bindGroups) {
+            bindGroup = utils::MakeBindGroup(device, layout, {{0, uniformBuffer, 0, 16}});
+        }
+
+        dawn::ShaderModule vsModule =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            layout(set = 0, binding = 0) uniform Frame {
+                vec4 offset;
+            };
+            void main() {
+                gl_Position = offset;
+            })");
+
+        dawn::ShaderModule fsModule =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            void main() {
+                fragColor = vec4(1.0);
+            })");
+
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        descriptor.layout = utils::MakeBasicPipelineLayout(device, &layout);
+        descriptor.vertexStage.module = vsModule;
+        descriptor.cFragmentStage.module = fsModule;
+        descriptor.cColorStates[0]->format = objects.renderPass.colorFormat;
+        objects.pipeline = device.CreateRenderPipeline(&descriptor);
+
+        return objects;
+    }
+
+    // Records kPassCount render passes of kCallsPerPass calls to recordCall and returns the
+    // average time of a call in nanoseconds. Only the recording of the calls is timed.
+    template <typename F>
+    double MeasureCall(const BenchmarkObjects& objects, F recordCall) {
+        std::unique_ptr<utils::Timer> timer(utils::CreateTimer());
+        double totalTime = 0;
+
+        for (unsigned int i = 0; i < kPassCount; ++i) {
+            dawn::CommandEncoder encoder = objects.device.CreateCommandEncoder();
+            dawn::RenderPassEncoder pass =
+                encoder.BeginRenderPass(&objects.renderPass.renderPassInfo);
+            pass.SetPipeline(objects.pipeline);
+            pass.SetBindGroup(0, objects.bindGroups[0], 0, nullptr);
+
+            timer->Start();
+            for (unsigned int j = 0; j < kCallsPerPass; ++j) {
+                recordCall(pass, j);
+            }
+            timer->Stop();
+            totalTime += timer->GetElapsedTime();
+
+            pass.EndPass();
+            dawn::CommandBuffer commands = encoder.Finish();
+            objects.queue.Submit(1, &commands);
+        }
+
+        return totalTime * 1e9 / (kPassCount * kCallsPerPass);
+    }
+
+}  // anonymous namespace
+
+int main() {
+    dawn_native::Instance instance;
+    instance.DiscoverDefaultAdapters();
+    std::vector<dawn_native::Adapter> adapters = instance.GetAdapters();
+    auto adapterIt = std::find_if(adapters.begin(), adapters.end(),
+                                  [](const dawn_native::Adapter adapter) -> bool {
+                                      return adapter.GetBackendType() ==
+                                             dawn_native::BackendType::Null;
+                                  });
+    if (adapterIt == adapters.end()) {
+        std::cerr << "No null adapter found" << std::endl;
+        return 1;
+    }
+
+#if !defined(DAWN_DIRECT_DISPATCH)
+    DawnProcTable procs = dawn_native::GetProcs();
+    dawnSetProcs(&procs);
+#endif
+    dawn::Device device = dawn::Device::Acquire(adapterIt->CreateDevice());
+    BenchmarkObjects objects = CreateObjects(device);
+
+    double drawTime = MeasureCall(objects, [](const dawn::RenderPassEncoder& pass, unsigned int) {
+        pass.Draw(3, 1, 0, 0);
+    });
+    double setBindGroupTime =
+        MeasureCall(objects, [&objects](const dawn::RenderPassEncoder& pass, unsigned int i) {
+            pass.SetBindGroup(0, objects.bindGroups[i % 2], 0, nullptr);
+        });
+
+    std::cout << "Draw: " << drawTime << " ns" << std::endl;
+    std::cout << "SetBindGroup: " << setBindGroupTime << " ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,242 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays a trace recorded with utils::WireTraceSerializer in a WireServer and reports the CPU
+// time spent handling each frame. The commands the server sends back are discarded, so traces
+// that wait on the results of the server (mapping, fences) replay as fast as the server handles
+// them.
+
+#include "utils/Timer.h"
+#include "utils/WireTrace.h"
+
+#include <dawn/dawn.h>
+#include <dawn_native/DawnNative.h>
+#include <dawn_wire/WireServer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+    class DiscardingSerializer : public dawn_wire::CommandSerializer {
+      public:
+        void* GetCmdSpace(size_t size) override {
+            if (mBuffer.size() < size) {
+                mBuffer.resize(size);
+            }
+            return mBuffer.data();
+        }
+
+        bool Flush() override {
+            return true;
+        }
+
+      private:
+        std::vector<char> mBuffer;
+    };
+
+    struct Frame {
+        std::vector<utils::WireTraceChunk> chunks;
+    };
+
+    bool LoadTrace(const char* filename, std::vector<Frame>* frames) {
+        utils::WireTraceReader reader;
+        if (!reader.Open(filename)) {
+            std::cerr << "Failed to open trace " << filename << std::endl;
+            return false;
+        }
+
+        Frame frame;
+        utils::WireTraceChunk chunk;
+        while (reader.ReadChunk(&chunk)) {
+            switch (chunk.type) {
+                case utils::WireTraceChunkType::ClientCommands:
+                    frame.chunks.push_back(std::move(chunk));
+                    chunk = {};
+                    break;
+
+                case utils::WireTraceChunkType::ServerCommands:
+                    break;
+
+                case utils::WireTraceChunkType::EndOfFrame:
+                    frames->push_back(std::move(frame));
+                    frame = {};
+                    break;
+            }
+        }
+
+        if (reader.IsMalformed()) {
+            std::cerr << "Malformed trace " << filename << std::endl;
+            return false;
+        }
+        // The commands after the last frame usually only release objects, which destroying the
+        // server does as well. They are only replayed when the trace has no frames at all.
+        if (frames->empty() && !frame.chunks.empty()) {
+            frames->push_back(std::move(frame));
+        }
+        return true;
+    }
+
+    bool ParseBackendType(const std::string& name, dawn_native::BackendType* backendType) {
+        if (name == "d3d12") {
+            *backendType = dawn_native::BackendType::D3D12;
+        } else if (name == "metal") {
+            *backendType = dawn_native::BackendType::Metal;
+        } else if (name == "null") {
+            *backendType = dawn_native::BackendType::Null;
+        } else if (name == "vulkan") {
+            *backendType = dawn_native::BackendType::Vulkan;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // Replays all the frames on a new device and appends the CPU time of each frame in
+    // milliseconds to |frameTimes|.
+    bool Replay(dawn_native::Adapter adapter,
+                const std::vector<Frame>& frames,
+                std::vector<double>* frameTimes) {
+        DawnDevice device = adapter.CreateDevice();
+        if (device == nullptr) {
+            std::cerr << "Failed to create the device" << std::endl;
+            return false;
+        }
+        DawnProcTable procs = dawn_native::GetProcs();
+
+        DiscardingSerializer serializer;
+        dawn_wire::WireServerDescriptor serverDesc = {};
+        serverDesc.device = device;
+        serverDesc.procs = &procs;
+        serverDesc.serializer = &serializer;
+
+        bool success = true;
+        {
+            dawn_wire::WireServer server(serverDesc);
+            std::unique_ptr<utils::Timer> timer(utils::CreateTimer());
+
+            for (size_t i = 0; i < frames.size() && success; ++i) {
+                timer->Start();
+                for (const utils::WireTraceChunk& chunk : frames[i].chunks) {
+                    if (server.HandleCommands(chunk.data.data(), chunk.data.size()) == nullptr) {
+                        std::cerr << "Failed to handle the commands of frame " << i << std::endl;
+                        success = false;
+                        break;
+                    }
+                }
+                procs.deviceTick(device);
+                timer->Stop();
+
+                frameTimes->push_back(timer->GetElapsedTime() * 1000.0);
+            }
+        }
+
+        procs.deviceRelease(device);
+        return success;
+    }
+
+    void PrintUsage() {
+        std::cout << "Usage: dawn_wire_replay [-b BACKEND] [--repeat N] [--per-frame] TRACE"
+                  << std::endl
+                  << "  BACKEND is one of d3d12, metal, null (the default) or vulkan."
+                  << std::endl;
+    }
+
+}  // anonymous namespace
+
+int main(int argc, const char** argv) {
+    dawn_native::BackendType backendType = dawn_native::BackendType::Null;
+    unsigned int repeatCount = 1;
+    bool printPerFrame = false;
+    const char* filename = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if ((strcmp("-b", argv[i]) == 0 || strcmp("--backend", argv[i]) == 0) && i + 1 < argc) {
+            if (!ParseBackendType(argv[++i], &backendType)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (strcmp("--repeat", argv[i]) == 0 && i + 1 < argc) {
+            repeatCount = static_cast<unsigned int>(std::max(1, atoi(argv[++i])));
+        } else if (strcmp("--per-frame", argv[i]) == 0) {
+            printPerFrame = true;
+        } else if (filename == nullptr && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (filename == nullptr) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<Frame> frames;
+    if (!LoadTrace(filename, &frames)) {
+        return 1;
+    }
+    if (frames.empty()) {
+        std::cerr << "The trace doesn't contain any frame" << std::endl;
+        return 1;
+    }
+
+    // OpenGL adapters need a GL context to be discovered so they aren't supported here.
+    dawn_native::Instance instance;
+    instance.DiscoverDefaultAdapters();
+    std::vector<dawn_native::Adapter> adapters = instance.GetAdapters();
+    auto adapterIt = std::find_if(adapters.begin(), adapters.end(),
+                                  [backendType](const dawn_native::Adapter adapter) -> bool {
+                                      return adapter.GetBackendType() == backendType;
+                                  });
+    if (adapterIt == adapters.end()) {
+        std::cerr << "No adapter found for the requested backend" << std::endl;
+        return 1;
+    }
+
+    // Each repetition uses a new device and server since the trace creates its objects with the
+    // ids the client allocated during the recording.
+    std::vector<double> frameTimes;
+    for (unsigned int i = 0; i < repeatCount; ++i) {
+        if (!Replay(*adapterIt, frames, &frameTimes)) {
+            return 1;
+        }
+    }
+
+    if (printPerFrame) {
+        for (size_t i = 0; i < frameTimes.size(); ++i) {
+            std::cout << "frame " << i % frames.size() << ": " << frameTimes[i] << " ms"
+                      << std::endl;
+        }
+    }
+
+    double totalTime = 0;
+    for (double frameTime : frameTimes) {
+        totalTime += frameTime;
+    }
+    std::vector<double> sortedTimes = frameTimes;
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+
+    std::cout << "frames: " << frames.size() << " x " << repeatCount << std::endl;
+    std::cout << "mean: " << totalTime / sortedTimes.size() << " ms" << std::endl;
+    std::cout << "median: " << sortedTimes[sortedTimes.size() / 2] << " ms" << std::endl;
+    std::cout << "min: " << sortedTimes.front() << " ms" << std::endl;
+    std::cout << "max: " << sortedTimes.back() << " ms" << std::endl;
+    return 0;
+}
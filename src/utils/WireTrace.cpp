@@ -0,0 +1,212 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utils/WireTrace.h"
+
+#include "common/Assert.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace utils {
+
+    namespace {
+
+        constexpr char kMagic[8] = {'D', 'A', 'W', 'N', 'W', 'I', 'R', 'E'};
+        constexpr uint32_t kVersion = 2;
+
+        struct ChunkHeader {
+            uint32_t type;
+            uint64_t size;
+        };
+
+        bool WriteBytes(FILE* file, const void* data, size_t size) {
+            return size == 0 || fwrite(data, 1, size, file) == size;
+        }
+
+        bool ReadBytes(FILE* file, void* data, size_t size) {
+            return size == 0 || fread(data, 1, size, file) == size;
+        }
+
+    }  // anonymous namespace
+
+    // WireTraceWriter
+
+    WireTraceWriter::WireTraceWriter() {
+    }
+
+    WireTraceWriter::~WireTraceWriter() {
+        Close();
+    }
+
+    bool WireTraceWriter::Open(const char* filename) {
+        Close();
+
+        mFile = fopen(filename, "wb");
+        if (mFile == nullptr) {
+            return false;
+        }
+        return WriteBytes(mFile, kMagic, sizeof(kMagic)) &&
+               WriteBytes(mFile, &kVersion, sizeof(kVersion));
+    }
+
+    void WireTraceWriter::Close() {
+        if (mFile != nullptr) {
+            fclose(mFile);
+            mFile = nullptr;
+        }
+    }
+
+    bool WireTraceWriter::WriteChunk(WireTraceChunkType type, const char* data, size_t size) {
+        if (mFile == nullptr) {
+            return false;
+        }
+
+        // The fields are written one by one so that the header doesn't contain padding.
+        ChunkHeader header = {static_cast<uint32_t>(type), size};
+        return WriteBytes(mFile, &header.type, sizeof(header.type)) &&
+               WriteBytes(mFile, &header.size, sizeof(header.size)) &&
+               WriteBytes(mFile, data, size);
+    }
+
+    bool WireTraceWriter::EndFrame() {
+        if (!WriteChunk(WireTraceChunkType::EndOfFrame, nullptr, 0)) {
+            return false;
+        }
+        return fflush(mFile) == 0;
+    }
+
+    // WireTraceReader
+
+    WireTraceReader::WireTraceReader() {
+    }
+
+    WireTraceReader::~WireTraceReader() {
+        Close();
+    }
+
+    bool WireTraceReader::Open(const char* filename) {
+        Close();
+        mMalformed = false;
+
+        mFile = fopen(filename, "rb");
+        if (mFile == nullptr) {
+            return false;
+        }
+
+        char magic[sizeof(kMagic)];
+        uint32_t version;
+        if (!ReadBytes(mFile, magic, sizeof(magic)) ||
+            !ReadBytes(mFile, &version, sizeof(version)) ||
+            memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+            mMalformed = true;
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void WireTraceReader::Close() {
+        if (mFile != nullptr) {
+            fclose(mFile);
+            mFile = nullptr;
+        }
+    }
+
+    bool WireTraceReader::ReadChunk(WireTraceChunk* chunk) {
+        if (mFile == nullptr) {
+            return false;
+        }
+
+        ChunkHeader header;
+        if (!ReadBytes(mFile, &header.type, sizeof(header.type))) {
+            // Running out of data between two chunks is the normal end of the trace.
+            mMalformed = ferror(mFile) != 0;
+            return false;
+        }
+        if (!ReadBytes(mFile, &header.size, sizeof(header.size)) ||
+            header.type > static_cast<uint32_t>(WireTraceChunkType::EndOfFrame)) {
+            mMalformed = true;
+            return false;
+        }
+
+        // Grow the data progressively so that a corrupted size doesn't allocate a huge buffer.
+        chunk->type = static_cast<WireTraceChunkType>(header.type);
+        chunk->data.clear();
+        constexpr size_t kMaxReadSize = 1 << 20;
+        while (chunk->data.size() < header.size) {
+            size_t offset = chunk->data.size();
+            size_t readSize = static_cast<size_t>(
+                std::min(header.size - offset, static_cast<uint64_t>(kMaxReadSize)));
+            chunk->data.resize(offset + readSize);
+            if (!ReadBytes(mFile, chunk->data.data() + offset, readSize)) {
+                mMalformed = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool WireTraceReader::IsMalformed() const {
+        return mMalformed;
+    }
+
+    // WireTraceSerializer
+
+    WireTraceSerializer::WireTraceSerializer(dawn_wire::CommandSerializer* serializer,
+                                             WireTraceWriter* writer,
+                                             WireTraceChunkType type)
+        : mSerializer(serializer), mWriter(writer), mType(type) {
+        ASSERT(type != WireTraceChunkType::EndOfFrame);
+    }
+
+    WireTraceSerializer::~WireTraceSerializer() = default;
+
+    void* WireTraceSerializer::GetCmdSpace(size_t size) {
+        // The previous space has been filled by now. Copy it before the wrapped serializer gets
+        // a chance to flush it to make room for the new space.
+        CapturePendingSpace();
+
+        void* space = mSerializer->GetCmdSpace(size);
+        if (space != nullptr) {
+            mPendingSpace = static_cast<const char*>(space);
+            mPendingSize = size;
+        }
+        return space;
+    }
+
+    bool WireTraceSerializer::Flush() {
+        CapturePendingSpace();
+
+        // Write the commands before flushing them so that they precede the server commands they
+        // trigger in the trace.
+        bool success = true;
+        if (!mCapturedCommands.empty()) {
+            success =
+                mWriter->WriteChunk(mType, mCapturedCommands.data(), mCapturedCommands.size());
+            mCapturedCommands.clear();
+        }
+        return mSerializer->Flush() && success;
+    }
+
+    void WireTraceSerializer::CapturePendingSpace() {
+        if (mPendingSpace != nullptr) {
+            mCapturedCommands.insert(mCapturedCommands.end(), mPendingSpace,
+                                     mPendingSpace + mPendingSize);
+            mPendingSpace = nullptr;
+            mPendingSize = 0;
+        }
+    }
+
+}  // namespace utils
@@ -0,0 +1,104 @@
+// Copyright 2019 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILS_WIRETRACE_H_
+#define UTILS_WIRETRACE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "dawn_wire/Wire.h"
+
+namespace utils {
+
+    // A wire trace is a capture of the commands exchanged by a WireClient and a WireServer. It
+    // starts with a header followed by chunks, each made of a uint32_t type, a uint64_t size and
+    // the bytes of the chunk. Client commands can be replayed in a WireServer to reproduce the
+    // session while server commands are only kept for reference. The data of mapped buffers is
+    // captured as long as the inline memory transfer service is used, but swap chains can't be
+    // replayed because their implementation is a pointer in the address space of the recorder.
+    enum class WireTraceChunkType : uint32_t {
+        ClientCommands = 0,
+        ServerCommands = 1,
+        EndOfFrame = 2,
+    };
+
+    struct WireTraceChunk {
+        WireTraceChunkType type;
+        std::vector<char> data;
+    };
+
+    class WireTraceWriter {
+      public:
+        WireTraceWriter();
+        ~WireTraceWriter();
+
+        bool Open(const char* filename);
+        void Close();
+
+        bool WriteChunk(WireTraceChunkType type, const char* data, size_t size);
+        // Marks the end of a frame so that the replay can report the time of each frame.
+        bool EndFrame();
+
+      private:
+        FILE* mFile = nullptr;
+    };
+
+    class WireTraceReader {
+      public:
+        WireTraceReader();
+        ~WireTraceReader();
+
+        bool Open(const char* filename);
+        void Close();
+
+        // Returns false at the end of the trace or if the trace is malformed, in which case
+        // IsMalformed() returns true.
+        bool ReadChunk(WireTraceChunk* chunk);
+        bool IsMalformed() const;
+
+      private:
+        FILE* mFile = nullptr;
+        bool mMalformed = false;
+    };
+
+    // A CommandSerializer that forwards everything to |serializer| and writes a copy of each
+    // flushed batch of commands to |writer|. Like for the wire client and server, the space
+    // returned by GetCmdSpace must be filled before the next call to GetCmdSpace or Flush.
+    class WireTraceSerializer : public dawn_wire::CommandSerializer {
+      public:
+        WireTraceSerializer(dawn_wire::CommandSerializer* serializer,
+                            WireTraceWriter* writer,
+                            WireTraceChunkType type);
+        ~WireTraceSerializer() override;
+
+        void* GetCmdSpace(size_t size) override;
+        bool Flush() override;
+
+      private:
+        void CapturePendingSpace();
+
+        dawn_wire::CommandSerializer* mSerializer;
+        WireTraceWriter* mWriter;
+        WireTraceChunkType mType;
+
+        const char* mPendingSpace = nullptr;
+        size_t mPendingSize = 0;
+        std::vector<char> mCapturedCommands;
+    };
+
+}  // namespace utils
+
+#endif  // UTILS_WIRETRACE_H_